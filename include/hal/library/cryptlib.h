@@ -176,6 +176,18 @@ void *sha256_new(void);
 **/
 void sha256_free(IN void *sha256_ctx);
 
+/**
+  Retrieves the size, in bytes, of a SHA-256 context that sha256_init() can initialize
+  in caller memory, instead of one allocated by sha256_new().
+
+  A context initialized in caller memory is not released by sha256_free().
+
+  @return  The size, in bytes, of the SHA-256 context,
+           or 0 if the context can only be allocated by sha256_new().
+
+**/
+uintn sha256_get_context_size(void);
+
 /**
   Initializes user-supplied memory pointed by sha256_context as SHA-256 hash context for
   subsequent use.
@@ -289,6 +301,18 @@ void *sha384_new(void);
 **/
 void sha384_free(IN void *sha384_ctx);
 
+/**
+  Retrieves the size, in bytes, of a SHA-384 context that sha384_init() can initialize
+  in caller memory, instead of one allocated by sha384_new().
+
+  A context initialized in caller memory is not released by sha384_free().
+
+  @return  The size, in bytes, of the SHA-384 context,
+           or 0 if the context can only be allocated by sha384_new().
+
+**/
+uintn sha384_get_context_size(void);
+
 /**
   Initializes user-supplied memory pointed by sha384_context as SHA-384 hash context for
   subsequent use.
@@ -402,6 +426,18 @@ void *sha512_new(void);
 **/
 void sha512_free(IN void *sha512_ctx);
 
+/**
+  Retrieves the size, in bytes, of a SHA-512 context that sha512_init() can initialize
+  in caller memory, instead of one allocated by sha512_new().
+
+  A context initialized in caller memory is not released by sha512_free().
+
+  @return  The size, in bytes, of the SHA-512 context,
+           or 0 if the context can only be allocated by sha512_new().
+
+**/
+uintn sha512_get_context_size(void);
+
 /**
   Initializes user-supplied memory pointed by sha512_context as SHA-512 hash context for
   subsequent use.
@@ -2001,6 +2037,98 @@ boolean aead_aes_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 			     IN const uint8 *tag, IN uintn tag_size,
 			     OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD AES-GCM context for subsequent keyed use.
+
+  @return  Pointer to the AEAD AES-GCM context that has been initialized.
+           If the allocations fails, aead_aes_gcm_new() returns NULL.
+           If this interface is not supported, aead_aes_gcm_new() returns NULL.
+
+**/
+void *aead_aes_gcm_new(void);
+
+/**
+  Release the specified AEAD AES-GCM context.
+
+  @param[in]  aead_ctx  Pointer to the AEAD AES-GCM context to be released.
+
+**/
+void aead_aes_gcm_free(IN void *aead_ctx);
+
+/**
+  Set the encryption key of an AEAD AES-GCM context. The key schedule is expanded
+  once here and reused by every subsequent aead_aes_gcm_seal() and aead_aes_gcm_open()
+  call, until the next aead_aes_gcm_set_key().
+
+  key_size must be 16, 24 or 32, otherwise FALSE is returned.
+
+  @param[in, out]  aead_ctx   Pointer to the AEAD AES-GCM context.
+  @param[in]       key        Pointer to the encryption key.
+  @param[in]       key_size    size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+  @retval FALSE  This interface is not supported.
+
+**/
+boolean aead_aes_gcm_set_key(IN OUT void *aead_ctx, IN const uint8 *key,
+			     IN uintn key_size);
+
+/**
+  Performs AEAD AES-GCM authenticated encryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD AES-GCM context keyed by aead_aes_gcm_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD AES-GCM authenticated encryption succeeded.
+  @retval FALSE  AEAD AES-GCM authenticated encryption failed.
+
+**/
+boolean aead_aes_gcm_seal(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD AES-GCM authenticated decryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 12, 13, 14, 15, 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD AES-GCM context keyed by aead_aes_gcm_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD AES-GCM authenticated decryption succeeded.
+  @retval FALSE  AEAD AES-GCM authenticated decryption failed.
+
+**/
+boolean aead_aes_gcm_open(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   Performs AEAD ChaCha20Poly1305 authenticated encryption on a data buffer and additional authenticated data (AAD).
 
@@ -2062,6 +2190,98 @@ boolean aead_chacha20_poly1305_decrypt(
 	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
 	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD ChaCha20Poly1305 context for subsequent keyed use.
+
+  @return  Pointer to the AEAD ChaCha20Poly1305 context that has been initialized.
+           If the allocations fails, aead_chacha20_poly1305_new() returns NULL.
+           If this interface is not supported, aead_chacha20_poly1305_new() returns NULL.
+
+**/
+void *aead_chacha20_poly1305_new(void);
+
+/**
+  Release the specified AEAD ChaCha20Poly1305 context.
+
+  @param[in]  aead_ctx  Pointer to the AEAD ChaCha20Poly1305 context to be released.
+
+**/
+void aead_chacha20_poly1305_free(IN void *aead_ctx);
+
+/**
+  Set the encryption key of an AEAD ChaCha20Poly1305 context. The key schedule is expanded
+  once here and reused by every subsequent aead_chacha20_poly1305_seal() and aead_chacha20_poly1305_open()
+  call, until the next aead_chacha20_poly1305_set_key().
+
+  key_size must be 32, otherwise FALSE is returned.
+
+  @param[in, out]  aead_ctx   Pointer to the AEAD ChaCha20Poly1305 context.
+  @param[in]       key        Pointer to the encryption key.
+  @param[in]       key_size    size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+  @retval FALSE  This interface is not supported.
+
+**/
+boolean aead_chacha20_poly1305_set_key(IN OUT void *aead_ctx,
+				       IN const uint8 *key, IN uintn key_size);
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated encryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD ChaCha20Poly1305 context keyed by aead_chacha20_poly1305_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated encryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated encryption failed.
+
+**/
+boolean aead_chacha20_poly1305_seal(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD ChaCha20Poly1305 authenticated decryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD ChaCha20Poly1305 context keyed by aead_chacha20_poly1305_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD ChaCha20Poly1305 authenticated decryption succeeded.
+  @retval FALSE  AEAD ChaCha20Poly1305 authenticated decryption failed.
+
+**/
+boolean aead_chacha20_poly1305_open(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   Performs AEAD SM4-GCM authenticated encryption on a data buffer and additional authenticated data (AAD).
 
@@ -2125,6 +2345,98 @@ boolean aead_sm4_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 			     IN const uint8 *tag, IN uintn tag_size,
 			     OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD SM4-GCM context for subsequent keyed use.
+
+  @return  Pointer to the AEAD SM4-GCM context that has been initialized.
+           If the allocations fails, aead_sm4_gcm_new() returns NULL.
+           If this interface is not supported, aead_sm4_gcm_new() returns NULL.
+
+**/
+void *aead_sm4_gcm_new(void);
+
+/**
+  Release the specified AEAD SM4-GCM context.
+
+  @param[in]  aead_ctx  Pointer to the AEAD SM4-GCM context to be released.
+
+**/
+void aead_sm4_gcm_free(IN void *aead_ctx);
+
+/**
+  Set the encryption key of an AEAD SM4-GCM context. The key schedule is expanded
+  once here and reused by every subsequent aead_sm4_gcm_seal() and aead_sm4_gcm_open()
+  call, until the next aead_sm4_gcm_set_key().
+
+  key_size must be 16, otherwise FALSE is returned.
+
+  @param[in, out]  aead_ctx   Pointer to the AEAD SM4-GCM context.
+  @param[in]       key        Pointer to the encryption key.
+  @param[in]       key_size    size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+  @retval FALSE  This interface is not supported.
+
+**/
+boolean aead_sm4_gcm_set_key(IN OUT void *aead_ctx, IN const uint8 *key,
+			     IN uintn key_size);
+
+/**
+  Performs AEAD SM4-GCM authenticated encryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD SM4-GCM context keyed by aead_sm4_gcm_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD SM4-GCM authenticated encryption succeeded.
+  @retval FALSE  AEAD SM4-GCM authenticated encryption failed.
+
+**/
+boolean aead_sm4_gcm_seal(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD SM4-GCM authenticated decryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD SM4-GCM context keyed by aead_sm4_gcm_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD SM4-GCM authenticated decryption succeeded.
+  @retval FALSE  AEAD SM4-GCM authenticated decryption failed.
+
+**/
+boolean aead_sm4_gcm_open(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
 //=====================================================================================
 //    Asymmetric Cryptography Primitive
 //=====================================================================================
@@ -3064,6 +3376,253 @@ void x509_stack_free(IN void *x509_stack);
 boolean x509_get_tbs_cert(IN const uint8 *cert, IN uintn cert_size,
 			  OUT uint8 **tbs_cert, OUT uintn *tbs_cert_size);
 
+//
+// The x509_object_* functions below query a X509 object generated by
+// x509_construct_certificate(), so that a certificate which is checked for
+// several attributes is only decoded once. Release the object with x509_free().
+//
+
+/**
+  Retrieve the subject bytes from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     cert_subject  Pointer to the retrieved certificate subject bytes.
+  @param[in, out] subject_size  The size in bytes of the cert_subject buffer on input,
+                               and the size of buffer returned cert_subject on output.
+
+  If x509_cert is NULL, then return FALSE.
+  If subject_size is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @retval  TRUE   The certificate subject retrieved successfully.
+  @retval  FALSE  Invalid certificate, or the subject_size is too small for the result.
+                  The subject_size will be updated with the required size.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_get_subject_name(IN void *x509_cert,
+				     OUT uint8 *cert_subject,
+				     IN OUT uintn *subject_size);
+
+/**
+  Retrieve the issuer bytes from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     cert_issuer  Pointer to the retrieved certificate issuer bytes.
+  @param[in, out] issuer_size  The size in bytes of the cert_issuer buffer on input,
+                               and the size of buffer returned cert_issuer on output.
+
+  If x509_cert is NULL, then return FALSE.
+  If issuer_size is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @retval  TRUE   The certificate issuer retrieved successfully.
+  @retval  FALSE  Invalid certificate, or the issuer_size is too small for the result.
+                  The issuer_size will be updated with the required size.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_get_issuer_name(IN void *x509_cert,
+				    OUT uint8 *cert_issuer,
+				    IN OUT uintn *issuer_size);
+
+/**
+  Retrieve the version from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     version      Pointer to the retrieved version integer.
+
+  @retval RETURN_SUCCESS           The certificate version retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert or version is NULL.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+
+**/
+return_status x509_object_get_version(IN void *x509_cert, OUT uintn *version);
+
+/**
+  Retrieve the serialNumber from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     serial_number  Pointer to the retrieved certificate serial_number bytes.
+  @param[in, out] serial_number_size  The size in bytes of the serial_number buffer on input,
+                               and the size of buffer returned serial_number on output.
+
+  @retval RETURN_SUCCESS           The certificate serialNumber retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If serial_number_size is NULL.
+  @retval RETURN_NOT_FOUND         If no serial_number exists.
+  @retval RETURN_BUFFER_TOO_SMALL  If the serial_number is NULL. The required buffer size
+                                   (including the final null) is returned in the
+                                   serial_number_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status
+x509_object_get_serial_number(IN void *x509_cert, OUT uint8 *serial_number,
+			      OPTIONAL IN OUT uintn *serial_number_size);
+
+/**
+  Retrieve the signature algorithm from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     oid              signature algorithm Object identifier buffer.
+  @param[in,out]  oid_size          signature algorithm Object identifier buffer size
+
+  @retval RETURN_SUCCESS           The certificate signature algorithm retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If oid_size is NULL.
+  @retval RETURN_NOT_FOUND         If no SignatureType.
+  @retval RETURN_BUFFER_TOO_SMALL  If the oid is NULL. The required buffer size
+                                   is returned in the oid_size.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_signature_algorithm(IN void *x509_cert,
+						  OUT uint8 *oid,
+						  OPTIONAL IN OUT uintn *oid_size);
+
+/**
+  Retrieve Extension data from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[in]      oid              Object identifier buffer
+  @param[in]      oid_size          Object identifier buffer size
+  @param[out]     extension_data    Extension bytes.
+  @param[in, out] extension_data_size Extension bytes size.
+
+  @retval RETURN_SUCCESS           The certificate Extension data retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If extension_data_size is NULL.
+  @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+  @retval RETURN_BUFFER_TOO_SMALL  If the extension_data is NULL. The required buffer size
+                                   is returned in the extension_data_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_extension_data(IN void *x509_cert,
+					     IN uint8 *oid, IN uintn oid_size,
+					     OUT uint8 *extension_data,
+					     IN OUT uintn *extension_data_size);
+
+/**
+  Retrieve the Validity from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     from         notBefore Pointer to date_time object.
+  @param[in,out]  from_size     notBefore date_time object size.
+  @param[out]     to           notAfter Pointer to date_time object.
+  @param[in,out]  to_size       notAfter date_time object size.
+
+  @retval  TRUE   The certificate Validity retrieved successfully.
+  @retval  FALSE  Invalid certificate, or Validity retrieve failed.
+  @retval  FALSE  This interface is not supported.
+**/
+boolean x509_object_get_validity(IN void *x509_cert, IN uint8 *from,
+				 IN OUT uintn *from_size, IN uint8 *to,
+				 IN OUT uintn *to_size);
+
+/**
+  Retrieve the key usage from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     usage            key usage (CRYPTO_X509_KU_*)
+
+  @retval  TRUE   The certificate key usage retrieved successfully.
+  @retval  FALSE  Invalid certificate, or usage is NULL
+  @retval  FALSE  This interface is not supported.
+**/
+boolean x509_object_get_key_usage(IN void *x509_cert, OUT uintn *usage);
+
+/**
+  Retrieve the Extended key usage from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     usage            key usage bytes.
+  @param[in, out] usage_size        key usage buffer sizs in bytes.
+
+  @retval RETURN_SUCCESS           The usage bytes retrieve successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If usage_size is NULL.
+  @retval RETURN_BUFFER_TOO_SMALL  If the usage is NULL. The required buffer size
+                                   is returned in the usage_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_extended_key_usage(IN void *x509_cert,
+						 OUT uint8 *usage,
+						 IN OUT uintn *usage_size);
+
+/**
+  Verify one X509 object was issued by the trusted CA X509 object.
+
+  @param[in]      x509_cert     The X509 object of the certificate to be verified.
+  @param[in]      ca_x509_cert  The X509 object of the trusted CA certificate.
+
+  @retval  TRUE   The certificate was issued by the trusted CA.
+  @retval  FALSE  Invalid certificate or the certificate was not issued by the given
+                  trusted CA.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_verify_cert(IN void *x509_cert, IN void *ca_x509_cert);
+
+/**
+  Retrieve the RSA public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] rsa_context   Pointer to new-generated RSA context which contain the retrieved
+                           RSA public key component. Use rsa_free() function to free the
+                           resource.
+
+  @retval  TRUE   RSA public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve RSA public key from X509 object.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean rsa_get_public_key_from_x509_object(IN void *x509_cert,
+					    OUT void **rsa_context);
+
+/**
+  Retrieve the EC public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] ec_context    Pointer to new-generated EC DSA context which contain the retrieved
+                           EC public key component. Use ec_free() function to free the
+                           resource.
+
+  @retval  TRUE   EC public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve EC public key from X509 object.
+
+**/
+boolean ec_get_public_key_from_x509_object(IN void *x509_cert,
+					   OUT void **ec_context);
+
+/**
+  Retrieve the Ed public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] ecd_context    Pointer to new-generated Ed DSA context which contain the retrieved
+                           Ed public key component. Use ecd_free() function to free the
+                           resource.
+
+  @retval  TRUE   Ed public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve Ed public key from X509 object.
+
+**/
+boolean ecd_get_public_key_from_x509_object(IN void *x509_cert,
+					    OUT void **ecd_context);
+
+/**
+  Retrieve the sm2 public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] sm2_context   Pointer to new-generated sm2 context which contain the retrieved
+                           sm2 public key component. Use sm2_free() function to free the
+                           resource.
+
+  @retval  TRUE   sm2 public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve sm2 public key from X509 object.
+
+**/
+boolean sm2_get_public_key_from_x509_object(IN void *x509_cert,
+					     OUT void **sm2_context);
+
 //=====================================================================================
 //    DH key Exchange Primitive
 //=====================================================================================
@@ -3971,6 +4530,63 @@ boolean hkdf_sha256_expand(IN const uint8 *prk, IN uintn prk_size,
 			   IN const uint8 *info, IN uintn info_size,
 			   OUT uint8 *out, IN uintn out_size);
 
+/**
+  Allocates one HKDF-SHA256 context for subsequent keyed expansion.
+
+  The context is keyed with a PRK by hkdf_sha256_set_prk(), and can then be used by
+  hkdf_sha256_keyed_expand() for any number of expansions from the same PRK.
+
+  @return  Pointer to the HKDF-SHA256 context that has been allocated.
+           If the allocations fails, hkdf_sha256_new() returns NULL.
+
+**/
+void *hkdf_sha256_new(void);
+
+/**
+  Release the specified HKDF-SHA256 context.
+
+  @param[in]  hkdf_sha256_ctx  Pointer to the HKDF-SHA256 context to be released.
+
+**/
+void hkdf_sha256_free(IN void *hkdf_sha256_ctx);
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF-SHA256 context for subsequent keyed expansion.
+  A context can be keyed again with another PRK.
+
+  If hkdf_sha256_ctx is NULL, then return FALSE.
+
+  @param[out]  hkdf_sha256_ctx  Pointer to the HKDF-SHA256 context.
+  @param[in]   prk              Pointer to the pseudorandom key.
+  @param[in]   prk_size          prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+
+**/
+boolean hkdf_sha256_set_prk(OUT void *hkdf_sha256_ctx, IN const uint8 *prk,
+			    IN uintn prk_size);
+
+/**
+  Derive SHA256 HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF-SHA256 context.
+
+  The result is the same as hkdf_sha256_expand() with the PRK of the context, but the
+  HMAC key setup is not repeated. The context is not modified.
+
+  @param[in]   hkdf_sha256_ctx  Pointer to the HKDF-SHA256 context keyed by hkdf_sha256_set_prk().
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_sha256_keyed_expand(IN const void *hkdf_sha256_ctx,
+				 IN const uint8 *info, IN uintn info_size,
+				 OUT uint8 *out, IN uintn out_size);
+
 /**
   Derive key data using HMAC-SHA384 based KDF.
 
@@ -4028,6 +4644,63 @@ boolean hkdf_sha384_expand(IN const uint8 *prk, IN uintn prk_size,
 			   IN const uint8 *info, IN uintn info_size,
 			   OUT uint8 *out, IN uintn out_size);
 
+/**
+  Allocates one HKDF-SHA384 context for subsequent keyed expansion.
+
+  The context is keyed with a PRK by hkdf_sha384_set_prk(), and can then be used by
+  hkdf_sha384_keyed_expand() for any number of expansions from the same PRK.
+
+  @return  Pointer to the HKDF-SHA384 context that has been allocated.
+           If the allocations fails, hkdf_sha384_new() returns NULL.
+
+**/
+void *hkdf_sha384_new(void);
+
+/**
+  Release the specified HKDF-SHA384 context.
+
+  @param[in]  hkdf_sha384_ctx  Pointer to the HKDF-SHA384 context to be released.
+
+**/
+void hkdf_sha384_free(IN void *hkdf_sha384_ctx);
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF-SHA384 context for subsequent keyed expansion.
+  A context can be keyed again with another PRK.
+
+  If hkdf_sha384_ctx is NULL, then return FALSE.
+
+  @param[out]  hkdf_sha384_ctx  Pointer to the HKDF-SHA384 context.
+  @param[in]   prk              Pointer to the pseudorandom key.
+  @param[in]   prk_size          prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+
+**/
+boolean hkdf_sha384_set_prk(OUT void *hkdf_sha384_ctx, IN const uint8 *prk,
+			    IN uintn prk_size);
+
+/**
+  Derive SHA384 HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF-SHA384 context.
+
+  The result is the same as hkdf_sha384_expand() with the PRK of the context, but the
+  HMAC key setup is not repeated. The context is not modified.
+
+  @param[in]   hkdf_sha384_ctx  Pointer to the HKDF-SHA384 context keyed by hkdf_sha384_set_prk().
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_sha384_keyed_expand(IN const void *hkdf_sha384_ctx,
+				 IN const uint8 *info, IN uintn info_size,
+				 OUT uint8 *out, IN uintn out_size);
+
 /**
   Derive key data using HMAC-SHA512 based KDF.
 
@@ -4085,6 +4758,63 @@ boolean hkdf_sha512_expand(IN const uint8 *prk, IN uintn prk_size,
 			   IN const uint8 *info, IN uintn info_size,
 			   OUT uint8 *out, IN uintn out_size);
 
+/**
+  Allocates one HKDF-SHA512 context for subsequent keyed expansion.
+
+  The context is keyed with a PRK by hkdf_sha512_set_prk(), and can then be used by
+  hkdf_sha512_keyed_expand() for any number of expansions from the same PRK.
+
+  @return  Pointer to the HKDF-SHA512 context that has been allocated.
+           If the allocations fails, hkdf_sha512_new() returns NULL.
+
+**/
+void *hkdf_sha512_new(void);
+
+/**
+  Release the specified HKDF-SHA512 context.
+
+  @param[in]  hkdf_sha512_ctx  Pointer to the HKDF-SHA512 context to be released.
+
+**/
+void hkdf_sha512_free(IN void *hkdf_sha512_ctx);
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF-SHA512 context for subsequent keyed expansion.
+  A context can be keyed again with another PRK.
+
+  If hkdf_sha512_ctx is NULL, then return FALSE.
+
+  @param[out]  hkdf_sha512_ctx  Pointer to the HKDF-SHA512 context.
+  @param[in]   prk              Pointer to the pseudorandom key.
+  @param[in]   prk_size          prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+
+**/
+boolean hkdf_sha512_set_prk(OUT void *hkdf_sha512_ctx, IN const uint8 *prk,
+			    IN uintn prk_size);
+
+/**
+  Derive SHA512 HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF-SHA512 context.
+
+  The result is the same as hkdf_sha512_expand() with the PRK of the context, but the
+  HMAC key setup is not repeated. The context is not modified.
+
+  @param[in]   hkdf_sha512_ctx  Pointer to the HKDF-SHA512 context keyed by hkdf_sha512_set_prk().
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_sha512_keyed_expand(IN const void *hkdf_sha512_ctx,
+				 IN const uint8 *info, IN uintn info_size,
+				 OUT uint8 *out, IN uintn out_size);
+
 /**
   Derive SHA3_256 HMAC-based Extract-and-Expand key Derivation Function (HKDF).
 
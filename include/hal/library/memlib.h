@@ -67,6 +67,24 @@ void *set_mem(OUT void *buffer, IN uintn length, IN uint8 value);
 **/
 void *zero_mem(OUT void *buffer, IN uintn length);
 
+/**
+  Fills a target buffer with zeros in a way that is not optimized away, and returns the
+  target buffer.
+
+  This function shall be used to clear secrets, such as keys, before the memory is released
+  or reused. Unlike zero_mem(), every byte is written through a volatile pointer.
+
+  If length > 0 and buffer is NULL, then ASSERT().
+  If length is greater than (MAX_ADDRESS - buffer + 1), then ASSERT().
+
+  @param  buffer      The pointer to the target buffer to fill with zeros.
+  @param  length      The number of bytes in buffer to fill with zeros.
+
+  @return buffer.
+
+**/
+void *secure_zero_mem(OUT void *buffer, IN uintn length);
+
 /**
   Compares the contents of two buffers in const time.
 
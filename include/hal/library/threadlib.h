@@ -0,0 +1,113 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Provides services to run worker threads, to serialize them and to measure elapsed time.
+
+  The services are only needed by the multi-threaded drivers built on top of the SPDM libraries.
+  The SPDM libraries themselves do not create threads.
+**/
+
+#ifndef __THREAD_LIB_H__
+#define __THREAD_LIB_H__
+
+/**
+  The entry point of a thread.
+
+  @param  context                      The context passed to thread_create.
+**/
+typedef void (*thread_start_func)(IN void *context);
+
+/**
+  Creates a thread and starts it.
+
+  @param  start_func                    The entry point of the thread.
+  @param  context                      The context passed to the entry point.
+
+  @return A handle of the thread, or NULL if the thread cannot be created.
+**/
+void *thread_create(IN thread_start_func start_func, IN void *context);
+
+/**
+  Waits for a thread to exit, and frees the handle of the thread.
+
+  @param  thread                       The handle of the thread.
+**/
+void thread_join(IN void *thread);
+
+/**
+  Creates a mutex.
+
+  @return A handle of the mutex, or NULL if the mutex cannot be created.
+**/
+void *mutex_create(void);
+
+/**
+  Frees a mutex. The mutex must not be owned.
+
+  @param  mutex                        The handle of the mutex.
+**/
+void mutex_free(IN void *mutex);
+
+/**
+  Waits until a mutex is owned by the calling thread.
+
+  @param  mutex                        The handle of the mutex.
+**/
+void mutex_acquire(IN void *mutex);
+
+/**
+  Releases a mutex owned by the calling thread.
+
+  @param  mutex                        The handle of the mutex.
+**/
+void mutex_release(IN void *mutex);
+
+/**
+  Creates an auto-reset event, initially not signaled.
+
+  @return A handle of the event, or NULL if the event cannot be created.
+**/
+void *event_create(void);
+
+/**
+  Frees an event. No thread may wait for the event.
+
+  @param  event                        The handle of the event.
+**/
+void event_free(IN void *event);
+
+/**
+  Waits until an event is signaled, and resets it.
+
+  @param  event                        The handle of the event.
+**/
+void event_wait(IN void *event);
+
+/**
+  Signals an event. The signal is kept until a thread waits for the event.
+
+  @param  event                        The handle of the event.
+**/
+void event_signal(IN void *event);
+
+/**
+  Returns the number of processors available to the process.
+
+  @return the number of processors, at least 1.
+**/
+uintn thread_get_processor_count(void);
+
+/**
+  Returns a monotonic time stamp in microseconds.
+
+  Only the difference of two time stamps is meaningful.
+
+  @return the time stamp in microseconds.
+**/
+uint64 get_time_stamp_us(void);
+
+#endif
@@ -90,6 +90,30 @@ typedef enum {
 	SPDM_DATA_BASIC_MUT_AUTH_REQUESTED,
 	SPDM_DATA_MUT_AUTH_REQUESTED,
 	//
+	// Verified certificate link cache used to validate the peer certificate chain,
+	// see spdm_cert_link_cache_init. It may be shared by several SPDM contexts.
+	//
+	SPDM_DATA_CERT_LINK_CACHE,
+	//
+	// Pool of pre-generated DHE key pairs used by KEY_EXCHANGE, see spdm_dhe_key_pool_init.
+	// It may be shared by several SPDM contexts.
+	//
+	SPDM_DATA_DHE_KEY_POOL,
+	//
+	// Number of requests spdm_get_measurement_batch may send before receiving the first response.
+	// 1 (default) waits for each response. Use a larger value only on a transport that queues requests.
+	//
+	SPDM_DATA_REQUEST_PIPELINE_DEPTH,
+	//
+	// How the requester retries a request answered with ERROR(Busy), see spdm_retry_policy_t.
+	//
+	SPDM_DATA_RETRY_POLICY,
+	//
+	// Time spent by the requester per phase, in the transport and per crypto operation,
+	// see spdm_requester_metrics_t. Set it to clear the metrics.
+	//
+	SPDM_DATA_REQUESTER_METRICS,
+	//
 	// Negotiated result
 	//
 	SPDM_DATA_LOCAL_USED_CERT_CHAIN_BUFFER,
@@ -133,6 +157,214 @@ typedef struct {
 	uint8 additional_data[4];
 } spdm_data_parameter_t;
 
+//
+// Retry policy of the requester for ERROR(Busy).
+// Each retry waits a backoff, doubled after every retry up to max_backoff_us,
+// plus a random jitter of up to jitter_percent of the backoff.
+// The waits are only done if a sleep function is registered, see spdm_register_timer_func.
+//
+typedef struct {
+	// Number of retries after the first attempt
+	uint8 retry_times;
+	// Percentage of the backoff added as random jitter, 0 to 100
+	uint8 jitter_percent;
+	// First backoff in microseconds, 0 to use the CT (2^CTExponent) of the responder
+	uint32 initial_backoff_us;
+	// Maximum backoff in microseconds
+	uint32 max_backoff_us;
+	// Maximum time in microseconds for one operation including all its retries and
+	// RESPOND_IF_READY polls, 0 for no limit. Only checked if a clock is registered.
+	uint64 deadline_us;
+} spdm_retry_policy_t;
+
+//
+// Phases of a responder request timed by the responder statistics.
+// The handler phase includes the signing done by the handler.
+// Secured messages report the transport decode and encode, which include the
+// AEAD decryption and encryption, as SPDM_RESPONDER_STATS_PHASE_AEAD.
+//
+typedef enum {
+	SPDM_RESPONDER_STATS_PHASE_DECODE,
+	SPDM_RESPONDER_STATS_PHASE_HANDLER,
+	SPDM_RESPONDER_STATS_PHASE_SIGN,
+	SPDM_RESPONDER_STATS_PHASE_AEAD,
+	SPDM_RESPONDER_STATS_PHASE_ENCODE,
+	SPDM_RESPONDER_STATS_PHASE_MAX,
+} spdm_responder_stats_phase_t;
+
+//
+// The request codes are 0x80 to 0xFF, the statistics of request code C are at index (C - 0x80).
+//
+#define SPDM_RESPONDER_STATS_REQUEST_CODE_NUM 0x80
+
+//
+// Statistics of one request code.
+// Bucket 0 of a histogram counts the phases shorter than 1us, bucket N (N > 0) the phases
+// from 2^(N-1)us to less than 2^N us. The last bucket also counts all longer phases.
+//
+typedef struct {
+	uint32 received;
+	uint32 errored;
+	uint32 latency_histogram[SPDM_RESPONDER_STATS_PHASE_MAX]
+				[SPDM_RESPONDER_STATS_HISTOGRAM_BUCKETS];
+} spdm_responder_request_stats_t;
+
+typedef struct {
+	spdm_responder_request_stats_t request[SPDM_RESPONDER_STATS_REQUEST_CODE_NUM];
+	// Number of ERROR responses per error code
+	uint32 error_code[256];
+	// Number of requests that failed to decode and got no response
+	uint32 decode_failed;
+} spdm_responder_stats_t;
+
+//
+// Timing of one responder request, reported to the sampling function.
+//
+typedef struct {
+	// Request code, 0 if the request could not be decoded
+	uint8 request_code;
+	// Error code of an ERROR response, 0 otherwise
+	uint8 error_code;
+	// Bit (1 << phase) is set for each phase that was timed
+	uint8 phase_mask;
+	uint64 phase_us[SPDM_RESPONDER_STATS_PHASE_MAX];
+} spdm_responder_stats_sample_t;
+
+/**
+  Receive the timing of one request processed by the responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sample                        The timing of the request.
+**/
+typedef void (*spdm_responder_stats_sample_func)(
+	IN void *spdm_context, IN spdm_responder_stats_sample_t *sample);
+
+//
+// Phases of the requester timed by the requester metrics.
+// Each phase covers the requester API calls of its requests, including the retries.
+//
+typedef enum {
+	// GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS
+	SPDM_REQUESTER_PHASE_VCA,
+	SPDM_REQUESTER_PHASE_DIGESTS,
+	SPDM_REQUESTER_PHASE_CERTIFICATE,
+	SPDM_REQUESTER_PHASE_CHALLENGE,
+	// KEY_EXCHANGE or PSK_EXCHANGE
+	SPDM_REQUESTER_PHASE_KEY_EXCHANGE,
+	// FINISH or PSK_FINISH
+	SPDM_REQUESTER_PHASE_FINISH,
+	SPDM_REQUESTER_PHASE_MAX,
+} spdm_requester_phase_t;
+
+//
+// Crypto operations counted by the requester metrics.
+// A signature or HMAC over a transcript includes hashing the transcript.
+// AEAD counts the transport encode and decode of secured messages.
+//
+typedef enum {
+	SPDM_CRYPTO_OP_HASH,
+	SPDM_CRYPTO_OP_HMAC,
+	SPDM_CRYPTO_OP_HKDF,
+	SPDM_CRYPTO_OP_DHE,
+	SPDM_CRYPTO_OP_ASYM_SIGN,
+	SPDM_CRYPTO_OP_ASYM_VERIFY,
+	SPDM_CRYPTO_OP_CERT_VERIFY,
+	SPDM_CRYPTO_OP_AEAD,
+	SPDM_CRYPTO_OP_MAX,
+} spdm_crypto_op_t;
+
+typedef struct {
+	uint32 count;
+	// Total time in microseconds, only added up if a clock is registered, see spdm_register_timer_func.
+	uint64 time_us;
+} spdm_metrics_counter_t;
+
+typedef struct {
+	spdm_metrics_counter_t phase[SPDM_REQUESTER_PHASE_MAX];
+	// Transport messages sent and received, and the time spent in send_message and receive_message
+	spdm_metrics_counter_t send;
+	spdm_metrics_counter_t receive;
+	uint64 bytes_sent;
+	uint64 bytes_received;
+	spdm_metrics_counter_t crypto[SPDM_CRYPTO_OP_MAX];
+} spdm_requester_metrics_t;
+
+//
+// Binary trace of the messages sent and received by a context, see spdm_register_trace_buffer.
+// The trace buffer starts with spdm_trace_buffer_header_t, followed by event_count events
+// of event_size bytes. Event N is stored at index (N % event_count), so the buffer keeps the
+// last event_count events. The events are only formatted when the trace is decoded.
+//
+#define SPDM_TRACE_BUFFER_SIGNATURE SIGNATURE_32('S', 'T', 'R', 'C')
+// Sequence number of an event that was never written, or whose write did not complete
+#define SPDM_TRACE_INVALID_SEQUENCE MAX_UINT64
+
+typedef enum {
+	SPDM_TRACE_DIRECTION_SEND,
+	SPDM_TRACE_DIRECTION_RECEIVE,
+} spdm_trace_direction_t;
+
+// Copy the leading bytes of the messages outside of a session, see spdm_register_trace_buffer
+#define SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD 0x1
+
+// The message is an application message
+#define SPDM_TRACE_EVENT_FLAG_APP_MESSAGE 0x1
+
+//
+// One message recorded in the trace buffer.
+// The SPDM header fields are 0 for an application message.
+//
+typedef struct {
+	uint64 sequence;
+	// Time stamp in microseconds, 0 if no clock is registered, see spdm_register_timer_func.
+	uint64 timestamp_us;
+	// Session ID, 0 for a message outside of a session
+	uint32 session_id;
+	uint32 message_size;
+	uint8 direction;
+	uint8 flags;
+	uint8 spdm_version;
+	uint8 request_response_code;
+	uint8 param1;
+	uint8 param2;
+	// Number of leading message bytes copied into payload, 0 unless
+	// SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD is set and the message is outside of a session
+	uint16 payload_size;
+	uint8 payload[SPDM_TRACE_PAYLOAD_SIZE];
+} spdm_trace_event_t;
+
+typedef struct {
+	uint32 signature;
+	// sizeof(spdm_trace_event_t) and SPDM_TRACE_PAYLOAD_SIZE of the library that wrote the trace
+	uint16 event_size;
+	uint16 payload_size;
+	// Number of events in the buffer, a power of two
+	uint32 event_count;
+	uint32 reserved;
+	// Sequence number of the next event
+	uint64 next_sequence;
+} spdm_trace_buffer_header_t;
+
+#define SPDM_CONNECTION_SNAPSHOT_SIGNATURE SIGNATURE_32('S', 'C', 'O', 'N')
+#define SPDM_CONNECTION_SNAPSHOT_VERSION 2
+
+//
+// Negotiated state of a connection, see spdm_export_connection_snapshot.
+// The snapshot is written field by field, so it does not depend on the compiler or on the
+// build configuration. Integers are little endian, and the SPDM versions are encoded as in
+// the VERSION response. The header is:
+//   uint32 signature, uint16 snapshot_version,
+//   uint16 version, uint16 secured_message_version,
+//   uint8 ct_exponent, uint8 measurement_spec, uint32 capability_flags,
+//   uint32 measurement_hash_algo, uint32 base_asym_algo, uint32 base_hash_algo,
+//   uint16 dhe_named_group, uint16 aead_cipher_suite, uint16 req_base_asym_alg,
+//   uint16 key_schedule, uint16 message_a_size, uint32 cert_chain_size
+// It is followed by the digest of the peer certificate chain with base_hash_algo (zeroes
+// if cert_chain_size is 0), by message_a_size bytes of message A (VCA), then by
+// cert_chain_size bytes of the peer certificate chain.
+//
+#define SPDM_CONNECTION_SNAPSHOT_HEADER_SIZE 42
+
 typedef enum {
 	//
 	// Before GET_VERSION/VERSION
@@ -275,6 +507,21 @@ void spdm_set_last_spdm_error_struct(IN void *spdm_context,
 */
 void spdm_init_context(IN void *spdm_context);
 
+/**
+  Initialize an SPDM context with a given session capacity.
+
+  The size in bytes of the spdm_context can be returned by spdm_get_context_size_ex.
+  spdm_init_context is equivalent to a session capacity of MAX_SPDM_SESSION_COUNT.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of sessions at the same time.
+
+  @retval RETURN_SUCCESS               The SPDM context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The session count is out of range.
+*/
+return_status spdm_init_context_ex(IN void *spdm_context,
+				   IN uintn max_session_count);
+
 /**
   Reset an SPDM context.
 
@@ -284,6 +531,17 @@ void spdm_init_context(IN void *spdm_context);
 */
 void spdm_reset_context(IN void *context);
 
+/**
+  Release the resources held by an SPDM context, such as the cached peer public key,
+  and the keyed AEAD contexts and the transcript hash and HMAC contexts of the sessions.
+
+  The SPDM context buffer itself is owned by the caller. spdm_init_context must be called
+  before the SPDM context is used again.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+*/
+void spdm_deinit_context(IN void *context);
+
 /**
   Return the size in bytes of the SPDM context.
 
@@ -291,6 +549,15 @@ void spdm_reset_context(IN void *context);
 **/
 uintn spdm_get_context_size(void);
 
+/**
+  Return the size in bytes of the SPDM context with a given session capacity.
+
+  @param  max_session_count             The maximum number of sessions at the same time.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_context_size_ex(IN uintn max_session_count);
+
 /**
   Send an SPDM transport layer message to a device.
 
@@ -447,6 +714,222 @@ void spdm_register_transport_layer_func(
 	IN spdm_transport_encode_message_func transport_encode_message,
 	IN spdm_transport_decode_message_func transport_decode_message);
 
+/**
+  Encode an SPDM or APP message to a transport layer message in place.
+
+  The message is located inside a larger buffer, with at least the registered
+  transport header size of writable room in front of it and the registered
+  transport tail size of writable room behind it. The transport layer writes
+  its headers, the secured message headers, padding and AEAD tag into that room,
+  and encrypts the message in place. No copy of the message is made.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message, with head room and tail room around it.
+  @param  transport_message_size         size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to the start of the encoded transport message, inside the same buffer.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_UNSUPPORTED           The message cannot be encoded.
+**/
+typedef return_status (*spdm_transport_encode_message_in_place_func)(
+	IN void *spdm_context, IN uint32 *session_id, IN boolean is_app_message,
+	IN boolean is_requester, IN uintn message_size, IN OUT void *message,
+	OUT uintn *transport_message_size, OUT void **transport_message);
+
+/**
+  Decode an SPDM or APP message from a transport layer message in place.
+
+  The transport message is verified and decrypted inside its own buffer, and
+  message is returned as a pointer into that buffer. No copy is made.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to the transport message. It is decrypted in place.
+  @param  message_size                  size in bytes of the decoded message.
+  @param  message                      A pointer to the decoded message inside transport_message.
+
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+typedef return_status (*spdm_transport_decode_message_in_place_func)(
+	IN void *spdm_context, OUT uint32 **session_id,
+	OUT boolean *is_app_message, IN boolean is_requester,
+	IN uintn transport_message_size, IN OUT void *transport_message,
+	OUT uintn *message_size, OUT void **message);
+
+/**
+  Register SPDM transport layer in-place encode/decode functions for SPDM or APP messages.
+
+  This function is optional. It may be called in addition to spdm_register_transport_layer_func.
+  Once registered, the requester and responder build messages at an offset of transport_header_size
+  inside their send buffers and let the transport layer add headers and tails in place.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  transport_header_size          The maximum size in bytes the transport layer writes in front of a message.
+                                       It shall be no greater than MAX_SPDM_TRANSPORT_HEADER_SIZE.
+  @param  transport_tail_size            The maximum size in bytes the transport layer writes behind a message.
+                                       It shall be no greater than MAX_SPDM_TRANSPORT_TAIL_SIZE.
+  @param  transport_encode_message_in_place The fuction to encode an SPDM or APP message to a transport layer message in place.
+  @param  transport_decode_message_in_place The fuction to decode an SPDM or APP message from a transport layer message in place.
+**/
+void spdm_register_transport_layer_in_place_func(
+	IN void *spdm_context, IN uintn transport_header_size,
+	IN uintn transport_tail_size,
+	IN spdm_transport_encode_message_in_place_func
+		transport_encode_message_in_place,
+	IN spdm_transport_decode_message_in_place_func
+		transport_decode_message_in_place);
+
+/**
+  Wait for a duration before the requester sends a request again.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  duration_us                   The time to wait in microseconds.
+**/
+typedef void (*spdm_sleep_func)(IN void *spdm_context, IN uint64 duration_us);
+
+/**
+  Return a monotonic time stamp in microseconds.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The current time stamp in microseconds.
+**/
+typedef uint64 (*spdm_get_time_us_func)(IN void *spdm_context);
+
+/**
+  Register the functions used by the requester to pace the retries of a request.
+
+  Without a sleep function, the retries are sent immediately.
+  Without a clock, the deadline of the retry policy is not checked, and the responder
+  statistics and the requester metrics only count the requests.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sleep                         The function to wait for a duration, or NULL.
+  @param  get_time_us                   The function to return a monotonic time stamp, or NULL.
+**/
+void spdm_register_timer_func(IN void *spdm_context,
+			      IN spdm_sleep_func sleep OPTIONAL,
+			      IN spdm_get_time_us_func get_time_us OPTIONAL);
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+  Return the size of a trace buffer that holds a number of events.
+
+  @param  event_count                   The number of events, a power of two.
+
+  @return The size in bytes of the trace buffer.
+**/
+uintn spdm_get_trace_buffer_size(IN uintn event_count);
+
+/**
+  Register a buffer to record the messages sent and received by a context.
+
+  Each message is recorded as a fixed size spdm_trace_event_t, instead of being dumped
+  in hex at DEBUG_INFO. The buffer holds as many events as fit, rounded down to a power
+  of two, and the oldest events are overwritten. The buffer can be saved as is and
+  decoded offline.
+
+  The events are written by the thread processing the context, without a lock or a
+  memory barrier. The buffer must not be read while that thread may write to it: read
+  it from the same thread between two messages, or after tracing is stopped by
+  registering a NULL trace buffer.
+
+  The leading bytes of a message are only copied into the event if
+  SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD is set, and never for a message in a session or an
+  application message, because those are recorded after decryption.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  trace_buffer                  The trace buffer, 8 byte aligned, or NULL to stop tracing.
+  @param  trace_buffer_size             The size in bytes of the trace buffer.
+  @param  flags                         SPDM_TRACE_BUFFER_FLAG_* bits.
+
+  @retval RETURN_SUCCESS                The trace buffer is registered.
+  @retval RETURN_BUFFER_TOO_SMALL       The trace buffer cannot hold one event.
+**/
+return_status spdm_register_trace_buffer(IN void *spdm_context,
+					 IN void *trace_buffer OPTIONAL,
+					 IN uintn trace_buffer_size,
+					 IN uint32 flags);
+#endif
+
+/**
+  Export the negotiated state of a connection, so that a later connection to the same
+  peer can skip GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS and GET_CERTIFICATE.
+
+  The snapshot holds the negotiated version, capabilities and algorithms, message A and,
+  once GET_CERTIFICATE is done, the peer certificate chain with its digest.
+  The snapshot is not confidential but must be kept from tampering, see
+  spdm_import_connection_snapshot.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      The buffer to store the snapshot.
+  @param  snapshot_size                 On input, the size in bytes of the snapshot buffer.
+                                       On output, the size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS                The snapshot is exported.
+  @retval RETURN_NOT_READY              The algorithms are not negotiated.
+  @retval RETURN_BUFFER_TOO_SMALL       The snapshot buffer is too small. snapshot_size holds the required size.
+  @retval RETURN_DEVICE_ERROR           The certificate chain digest cannot be computed.
+**/
+return_status spdm_export_connection_snapshot(IN void *spdm_context,
+					      OUT void *snapshot,
+					      IN OUT uintn *snapshot_size);
+
+/**
+  Import the negotiated state of a connection exported by spdm_export_connection_snapshot.
+
+  The connection state becomes SPDM_CONNECTION_STATE_NEGOTIATED. If the snapshot holds a
+  peer certificate chain, it is cached in the SPDM context but is trusted only after
+  spdm_resume_connection confirms it with GET_DIGESTS.
+
+  The snapshot is rejected if its version, base hash, base asymmetric, DHE, AEAD or key
+  schedule algorithm, or its secured message version, is not in the local configuration,
+  since a new negotiation with this configuration could not select it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      The snapshot.
+  @param  snapshot_size                 The size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS                The snapshot is imported.
+  @retval RETURN_INVALID_PARAMETER      The snapshot is malformed.
+  @retval RETURN_UNSUPPORTED            The negotiated version or algorithms are not supported locally.
+  @retval RETURN_ACCESS_DENIED          The connection is already started.
+  @retval RETURN_SECURITY_VIOLATION     The certificate chain does not match its digest.
+**/
+return_status spdm_import_connection_snapshot(IN void *spdm_context,
+					      IN void *snapshot,
+					      IN uintn snapshot_size);
+
+/**
+  Return the size of the room to reserve in front of a message for in-place transport encoding.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The registered transport header size. 0 if no in-place transport function is registered.
+**/
+uintn spdm_get_transport_header_size(IN void *spdm_context);
+
+/**
+  Return the size of the room to reserve behind a message for in-place transport encoding.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The registered transport tail size. 0 if no in-place transport function is registered.
+**/
+uintn spdm_get_transport_tail_size(IN void *spdm_context);
+
 /**
   Verify a SPDM cert chain in a slot.
 
@@ -922,6 +1405,21 @@ boolean spdm_get_local_cert_chain_data(IN void *spdm_context,
 				       OUT void **cert_chain_data,
 				       OUT uintn *cert_chain_data_size);
 
+/**
+  Mark a device measurement block as changed.
+
+  The responder caches the measurement record and the measurement summary hash.
+  The integrator shall call this function whenever a measurement changes, for example
+  after a firmware update, so that the cache is refreshed before its next use.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_index             The index of the measurement block that changed.
+                                       SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS
+                                       invalidates the whole measurement cache.
+**/
+void spdm_set_measurement_dirty(IN void *spdm_context,
+				IN uint8 measurement_index);
+
 /**
   Reads a 24-bit value from memory that may be unaligned.
 
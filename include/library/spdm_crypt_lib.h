@@ -20,6 +20,7 @@
 #define MAX_HASH_SIZE 64
 #define MAX_AEAD_KEY_SIZE 32
 #define MAX_AEAD_IV_SIZE 12
+#define MAX_AEAD_TAG_SIZE 16
 
 /**
   Allocates and initializes one HASH_CTX context for subsequent hash use.
@@ -36,6 +37,13 @@ typedef void * (*hash_new_func)();
 **/
 typedef void (*hash_free_func)(IN void *hash_context);
 
+/**
+  Return the size in bytes of a hash context that hash_init_func can initialize in caller memory.
+
+  @return  The size of the hash context, or 0 if the hash context can only be allocated by hash_new_func.
+**/
+typedef uintn (*hash_get_context_size_func)();
+
 /**
   Initializes user-supplied memory pointed by hash_context as hash context for
   subsequent use.
@@ -243,6 +251,51 @@ typedef boolean (*hkdf_expand_func)(IN const uint8 *prk, IN uintn prk_size,
 				    IN const uint8 *info, IN uintn info_size,
 				    OUT uint8 *out, IN uintn out_size);
 
+/**
+  Allocates one HKDF context for subsequent keyed expansion.
+
+  @return  Pointer to the HKDF context that has been allocated.
+           If the allocations fails, hkdf_new_func() returns NULL.
+**/
+typedef void * (*hkdf_new_func)();
+
+/**
+  Release the specified HKDF context.
+
+  @param  hkdf_ctx                      Pointer to the HKDF context to be released.
+**/
+typedef void (*hkdf_free_func)(IN void *hkdf_ctx);
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF context for subsequent keyed expansion.
+
+  @param  hkdf_ctx                      Pointer to the HKDF context.
+  @param  prk                          Pointer to the pseudorandom key.
+  @param  prk_size                      prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+**/
+typedef boolean (*hkdf_set_prk_func)(OUT void *hkdf_ctx, IN const uint8 *prk,
+				     IN uintn prk_size);
+
+/**
+  Derive HMAC-based Expand key Derivation Function (HKDF) Expand from a keyed HKDF context.
+
+  @param  hkdf_ctx                      Pointer to the HKDF context keyed with the PRK.
+  @param  info                         Pointer to the application specific info.
+  @param  info_size                     info size in bytes.
+  @param  out                          Pointer to buffer to receive hkdf value.
+  @param  out_size                      size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+**/
+typedef boolean (*hkdf_keyed_expand_func)(IN const void *hkdf_ctx,
+					  IN const uint8 *info,
+					  IN uintn info_size, OUT uint8 *out,
+					  IN uintn out_size);
+
 /**
   Retrieve the asymmetric public key from one DER-encoded X509 certificate.
 
@@ -258,6 +311,19 @@ typedef boolean (*asym_get_public_key_from_x509_func)(IN const uint8 *cert,
 						      IN uintn cert_size,
 						      OUT void **context);
 
+/**
+  Retrieve the asymmetric public key from one X509 object.
+
+  @param  x509_cert                     The X509 object generated by x509_construct_certificate().
+  @param  context                      Pointer to new-generated asymmetric context which contain the retrieved public key component.
+                                       Use spdm_asym_free() function to free the resource.
+
+  @retval  TRUE   public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve public key from X509 object.
+**/
+typedef boolean (*asym_get_public_key_from_x509_object_func)(
+	IN void *x509_cert, OUT void **context);
+
 /**
   Release the specified asymmetric context.
 
@@ -433,6 +499,82 @@ typedef boolean (*aead_decrypt_func)(
 	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
 	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD context for subsequent keyed use.
+
+  @return  Pointer to the AEAD context that has been initialized.
+           If the allocations fails, aead_new_func() returns NULL.
+**/
+typedef void * (*aead_new_func)();
+
+/**
+  Release the specified AEAD context.
+
+  @param  aead_ctx                      Pointer to the AEAD context to be released.
+**/
+typedef void (*aead_free_func)(IN void *aead_ctx);
+
+/**
+  Set the encryption key of an AEAD context.
+
+  @param  aead_ctx                      Pointer to the AEAD context.
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+**/
+typedef boolean (*aead_set_key_func)(IN OUT void *aead_ctx,
+				     IN const uint8 *key, IN uintn key_size);
+
+/**
+  Performs AEAD authenticated encryption with a keyed AEAD context.
+
+  @param  aead_ctx                      Pointer to the AEAD context.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be encrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag_out                       Pointer to a buffer that receives the authentication tag output.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the encryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated encryption succeeded.
+  @retval FALSE  AEAD authenticated encryption failed.
+**/
+typedef boolean (*aead_seal_func)(
+	IN void *aead_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, OUT uint8 *tag_out, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD authenticated decryption with a keyed AEAD context.
+
+  @param  aead_ctx                      Pointer to the AEAD context.
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be decrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag                          Pointer to a buffer that contains the authentication tag.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the decryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated decryption succeeded.
+  @retval FALSE  AEAD authenticated decryption failed.
+**/
+typedef boolean (*aead_open_func)(
+	IN void *aead_ctx, IN const uint8 *iv, IN uintn iv_size,
+	IN const uint8 *a_data, IN uintn a_data_size, IN const uint8 *data_in,
+	IN uintn data_in_size, IN const uint8 *tag, IN uintn tag_size,
+	OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   This function returns the SPDM hash algorithm size.
 
@@ -460,6 +602,16 @@ void *spdm_hash_new(IN uint32 base_hash_algo);
 **/
 void spdm_hash_free(IN uint32 base_hash_algo, IN void *hash_context);
 
+/**
+  Return the size in bytes of a hash context that spdm_hash_init can initialize in caller memory,
+  instead of one allocated by spdm_hash_new. Such a context is not released by spdm_hash_free.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return  The size of the hash context, or 0 if the hash context can only be allocated by spdm_hash_new.
+**/
+uintn spdm_hash_get_context_size(IN uint32 base_hash_algo);
+
 /**
   Initializes user-supplied memory pointed by hash_context as hash context for
   subsequent use.
@@ -701,6 +853,61 @@ boolean spdm_hkdf_expand(IN uint32 base_hash_algo, IN const uint8 *prk,
 			 IN uintn prk_size, IN const uint8 *info,
 			 IN uintn info_size, OUT uint8 *out, IN uintn out_size);
 
+/**
+  Allocates one HKDF context for subsequent keyed expansion, based upon the negotiated HKDF algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return  Pointer to the HKDF context that has been allocated.
+           If the allocations fails, spdm_hkdf_new() returns NULL.
+**/
+void *spdm_hkdf_new(IN uint32 base_hash_algo);
+
+/**
+  Release the specified HKDF context.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hkdf_ctx                      Pointer to the HKDF context to be released.
+**/
+void spdm_hkdf_free(IN uint32 base_hash_algo, IN void *hkdf_ctx);
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF context for subsequent keyed expansion,
+  based upon the negotiated HKDF algorithm. A context can be keyed again with another PRK.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hkdf_ctx                      Pointer to the HKDF context.
+  @param  prk                          Pointer to the pseudorandom key.
+  @param  prk_size                      prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+**/
+boolean spdm_hkdf_set_prk(IN uint32 base_hash_algo, OUT void *hkdf_ctx,
+			  IN const uint8 *prk, IN uintn prk_size);
+
+/**
+  Derive HMAC-based Expand key Derivation Function (HKDF) Expand from a keyed HKDF context,
+  based upon the negotiated HKDF algorithm.
+
+  The result is the same as spdm_hkdf_expand() with the PRK of the context, but the
+  HMAC key setup is done once for all the expansions from the same PRK.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hkdf_ctx                      Pointer to the HKDF context keyed by spdm_hkdf_set_prk().
+  @param  info                         Pointer to the application specific info.
+  @param  info_size                     info size in bytes.
+  @param  out                          Pointer to buffer to receive hkdf value.
+  @param  out_size                      size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+**/
+boolean spdm_hkdf_keyed_expand(IN uint32 base_hash_algo,
+			       IN const void *hkdf_ctx, IN const uint8 *info,
+			       IN uintn info_size, OUT uint8 *out,
+			       IN uintn out_size);
+
 /**
   This function returns the SPDM asymmetric algorithm size.
 
@@ -728,6 +935,22 @@ boolean spdm_asym_get_public_key_from_x509(IN uint32 base_asym_algo,
 					   IN uintn cert_size,
 					   OUT void **context);
 
+/**
+  Retrieve the asymmetric public key from one X509 object,
+  based upon negotiated asymmetric algorithm.
+
+  @param  base_asym_algo                 SPDM base_asym_algo
+  @param  x509_cert                     The X509 object generated by x509_construct_certificate().
+  @param  context                      Pointer to new-generated asymmetric context which contain the retrieved public key component.
+                                       Use spdm_asym_free() function to free the resource.
+
+  @retval  TRUE   public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve public key from X509 object.
+**/
+boolean spdm_asym_get_public_key_from_x509_object(IN uint32 base_asym_algo,
+						  IN void *x509_cert,
+						  OUT void **context);
+
 /**
   Release the specified asymmetric context,
   based upon negotiated asymmetric algorithm.
@@ -879,6 +1102,21 @@ boolean spdm_req_asym_get_public_key_from_x509(IN uint16 req_base_asym_alg,
 					       IN uintn cert_size,
 					       OUT void **context);
 
+/**
+  Retrieve the asymmetric public key from one X509 object,
+  based upon negotiated requester asymmetric algorithm.
+
+  @param  req_base_asym_alg               SPDM req_base_asym_alg
+  @param  x509_cert                     The X509 object generated by x509_construct_certificate().
+  @param  context                      Pointer to new-generated asymmetric context which contain the retrieved public key component.
+                                       Use spdm_req_asym_free() function to free the resource.
+
+  @retval  TRUE   public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve public key from X509 object.
+**/
+boolean spdm_req_asym_get_public_key_from_x509_object(
+	IN uint16 req_base_asym_alg, IN void *x509_cert, OUT void **context);
+
 /**
   Release the specified asymmetric context,
   based upon negotiated requester asymmetric algorithm.
@@ -1165,6 +1403,101 @@ boolean spdm_aead_decryption(IN spdm_version_number_t secured_message_version,
 			     IN uintn tag_size, OUT uint8 *data_out,
 			     OUT uintn *data_out_size);
 
+/**
+  Allocates and initializes one AEAD context for subsequent keyed use,
+  based upon negotiated AEAD algorithm.
+
+  The context is keyed by spdm_aead_set_key() and can then be used by
+  spdm_aead_seal() and spdm_aead_open() without expanding the key again.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return  Pointer to the AEAD context that has been initialized.
+           If the allocations fails or the algorithm does not support keyed
+           contexts, spdm_aead_new() returns NULL.
+**/
+void *spdm_aead_new(IN uint16 aead_cipher_suite);
+
+/**
+  Release the specified AEAD context,
+  based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context to be released.
+**/
+void spdm_aead_free(IN uint16 aead_cipher_suite, IN void *aead_ctx);
+
+/**
+  Set the encryption key of an AEAD context,
+  based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context.
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+**/
+boolean spdm_aead_set_key(IN uint16 aead_cipher_suite, IN OUT void *aead_ctx,
+			  IN const uint8 *key, IN uintn key_size);
+
+/**
+  Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD)
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context keyed by spdm_aead_set_key().
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be encrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag_out                       Pointer to a buffer that receives the authentication tag output.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the encryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated encryption succeeded.
+  @retval FALSE  AEAD authenticated encryption failed.
+**/
+boolean spdm_aead_seal(IN spdm_version_number_t secured_message_version,
+		       IN uint16 aead_cipher_suite, IN void *aead_ctx,
+		       IN const uint8 *iv, IN uintn iv_size,
+		       IN const uint8 *a_data, IN uintn a_data_size,
+		       IN const uint8 *data_in, IN uintn data_in_size,
+		       OUT uint8 *tag_out, IN uintn tag_size,
+		       OUT uint8 *data_out, OUT uintn *data_out_size);
+
+/**
+  Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD)
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context keyed by spdm_aead_set_key().
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be decrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag                          Pointer to a buffer that contains the authentication tag.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the decryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated decryption succeeded.
+  @retval FALSE  AEAD authenticated decryption failed.
+**/
+boolean spdm_aead_open(IN spdm_version_number_t secured_message_version,
+		       IN uint16 aead_cipher_suite, IN void *aead_ctx,
+		       IN const uint8 *iv, IN uintn iv_size,
+		       IN const uint8 *a_data, IN uintn a_data_size,
+		       IN const uint8 *data_in, IN uintn data_in_size,
+		       IN const uint8 *tag, IN uintn tag_size,
+		       OUT uint8 *data_out, OUT uintn *data_out_size);
+
 /**
   Generates a random byte stream of the specified size.
 
@@ -1185,6 +1518,16 @@ void spdm_get_random_number(IN uintn size, OUT uint8 *rand);
 **/
 boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size);
 
+/**
+  Certificate Check for SPDM leaf cert, on a certificate which is already decoded.
+
+  @param[in]  x509_cert        The X509 object generated by x509_construct_certificate().
+
+  @retval  TRUE   Success.
+  @retval  FALSE  Certificate is not valid
+**/
+boolean spdm_x509_object_certificate_check(IN void *x509_cert);
+
 /**
   Return certificate is root cert or not.
   Certificate is considered as a root certificate if the subjectname equal issuername.
@@ -1288,4 +1631,158 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 					     IN void *cert_chain_buffer,
 					     IN uintn cert_chain_buffer_size);
 
+/**
+  This function verifies the integrity of certificate chain buffer including spdm_cert_chain_t header,
+  skipping the signature check of the certificate links found in a verified certificate link cache.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  cert_chain_buffer              The certificate chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certificate chain buffer.
+  @param  cert_link_cache                The verified certificate link cache, or NULL to verify every link.
+
+  @retval TRUE  certificate chain buffer integrity verification pass.
+  @retval FALSE certificate chain buffer integrity verification fail.
+**/
+boolean spdm_verify_certificate_chain_buffer_ex(IN uint32 base_hash_algo,
+						IN void *cert_chain_buffer,
+						IN uintn cert_chain_buffer_size,
+						IN void *cert_link_cache OPTIONAL);
+
+//
+// Size of a date_time string like YYYYMMDDhhmmssZ, including the final null.
+//
+#define SPDM_CERT_LINK_CACHE_DATE_TIME_STR_SIZE 16
+
+/**
+  Acquire or release the lock serializing the access to a verified certificate link cache.
+
+  @param  lock_context                  The lock context registered with the cache.
+**/
+typedef void (*spdm_cert_link_cache_lock_func)(IN void *lock_context);
+
+/**
+  Return the current UTC time, used to expire the cached certificate links.
+
+  @param  date_time_str                 The buffer of SPDM_CERT_LINK_CACHE_DATE_TIME_STR_SIZE bytes
+                                       to receive the date_time string like YYYYMMDDhhmmssZ.
+
+  @retval TRUE  the current time is returned.
+  @retval FALSE the current time is not available.
+**/
+typedef boolean (*spdm_cert_link_cache_get_time_func)(OUT char8 *date_time_str);
+
+/**
+  Return the size in bytes of a verified certificate link cache.
+
+  A certificate link is a certificate and the certificate that issued it. Once the signature
+  of a link is verified, the link is identified by the hash of both certificates, so a
+  repeated chain validation only costs one hash per certificate.
+
+  @param  entry_count                   The maximum number of links in the cache.
+
+  @return the size in bytes of the cache.
+**/
+uintn spdm_cert_link_cache_get_size(IN uintn entry_count);
+
+/**
+  Initialize a verified certificate link cache.
+
+  The least recently used link is evicted when the cache is full. The cache can be shared
+  by the SPDM contexts of several threads once a lock is registered.
+
+  @param  cert_link_cache                The buffer of spdm_cert_link_cache_get_size(entry_count) bytes.
+  @param  entry_count                   The maximum number of links in the cache.
+
+  @retval RETURN_SUCCESS               The cache is initialized.
+  @retval RETURN_INVALID_PARAMETER     The entry_count is 0.
+**/
+return_status spdm_cert_link_cache_init(OUT void *cert_link_cache,
+					IN uintn entry_count);
+
+/**
+  Register the lock serializing the access to a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache.
+  @param  acquire_lock                  The function to acquire the lock, or NULL for a single thread.
+  @param  release_lock                  The function to release the lock, or NULL for a single thread.
+  @param  lock_context                  The lock context passed to the functions.
+**/
+void spdm_cert_link_cache_register_lock_func(
+	IN void *cert_link_cache,
+	IN spdm_cert_link_cache_lock_func acquire_lock OPTIONAL,
+	IN spdm_cert_link_cache_lock_func release_lock OPTIONAL,
+	IN void *lock_context OPTIONAL);
+
+/**
+  Register the clock used to expire the links of a verified certificate link cache.
+
+  A link expires when either certificate reaches the end of its validity period.
+  Without a clock, links are only evicted when the cache is full.
+
+  @param  cert_link_cache                The verified certificate link cache.
+  @param  get_time                      The function to return the current UTC time, or NULL.
+**/
+void spdm_cert_link_cache_register_get_time_func(
+	IN void *cert_link_cache,
+	IN spdm_cert_link_cache_get_time_func get_time OPTIONAL);
+
+/**
+  Remove all links from a verified certificate link cache, for example when a root certificate is revoked.
+
+  @param  cert_link_cache                The verified certificate link cache.
+**/
+void spdm_cert_link_cache_flush(IN void *cert_link_cache);
+
+/**
+  Return the number of link lookups answered and missed by a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache.
+  @param  hit_count                     The number of links found in the cache.
+  @param  miss_count                    The number of links verified with a signature check.
+**/
+void spdm_cert_link_cache_get_statistics(IN void *cert_link_cache,
+					 OUT uint64 *hit_count,
+					 OUT uint64 *miss_count);
+
+/**
+  Verify one X509 certificate was issued by the trusted CA, using a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache, or NULL to always verify.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  cert                         Pointer to the DER-encoded X509 certificate to be verified.
+  @param  cert_size                     size of the X509 certificate in bytes.
+  @param  ca_cert                       Pointer to the DER-encoded trusted CA certificate.
+  @param  ca_cert_size                   size of the CA Certificate in bytes.
+
+  @retval TRUE  The certificate was issued by the trusted CA.
+  @retval FALSE Invalid certificate or the certificate was not issued by the given trusted CA.
+**/
+boolean spdm_x509_verify_cert_with_cache(IN void *cert_link_cache OPTIONAL,
+					 IN uint32 base_hash_algo,
+					 IN const uint8 *cert, IN uintn cert_size,
+					 IN const uint8 *ca_cert,
+					 IN uintn ca_cert_size);
+
+/**
+  Verify a X509 certificate chain, using a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache, or NULL to always verify.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  root_cert                     Trusted Root Certificate buffer.
+  @param  root_cert_length               Trusted Root Certificate buffer length.
+  @param  cert_chain                    One or more ASN.1 DER-encoded X.509 certificates where the first
+                                       certificate is signed by the Root Certificate and subsequent
+                                       certificate is signed by the preceding certificate.
+  @param  cert_chain_length              Total length of the certificate chain, in bytes.
+
+  @retval TRUE  All cerificates was issued by the first certificate in X509Certchain.
+  @retval FALSE Invalid certificate or the certificate was not issued by the given trusted CA.
+**/
+boolean spdm_x509_verify_cert_chain_with_cache(IN void *cert_link_cache OPTIONAL,
+					       IN uint32 base_hash_algo,
+					       IN uint8 *root_cert,
+					       IN uintn root_cert_length,
+					       IN uint8 *cert_chain,
+					       IN uintn cert_chain_length);
+
 #endif
\ No newline at end of file
@@ -37,6 +37,48 @@ typedef boolean (*spdm_measurement_collection_func)(
 	OUT uint8 *device_measurement_count, OUT void *device_measurement,
 	IN OUT uintn *device_measurement_size);
 
+/**
+  Query the count of the device measurement blocks.
+
+  @param  measurement_specification     Indicates the measurement specification.
+                                       It must align with measurement_specification (SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_*)
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+                                       It must align with measurement_hash_algo (SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_*)
+  @param  device_measurement_count       The count of the device measurement block.
+
+  @retval RETURN_SUCCESS               The count of the device measurement block is returned.
+  @retval RETURN_UNSUPPORTED           The count query is not provided. The caller shall use spdm_measurement_collection.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+typedef return_status (*spdm_measurement_collection_count_func)(
+	IN spdm_version_number_t spdm_version,
+	IN uint8 measurement_specification, IN uint32 measurement_hash_algo,
+	OUT uint8 *device_measurement_count);
+
+/**
+  Collect one device measurement block.
+
+  @param  measurement_specification     Indicates the measurement specification.
+                                       It must align with measurement_specification (SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_*)
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+                                       It must align with measurement_hash_algo (SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_*)
+  @param  measurement_index             The index of the measurement block (1 ~ 0xFE).
+  @param  device_measurement            A pointer to a destination buffer to store the device measurement block.
+  @param  device_measurement_size        On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the device measurement block in the buffer.
+
+  @retval RETURN_SUCCESS               The device measurement block is returned.
+  @retval RETURN_NOT_FOUND             The device has no measurement block with this index.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the device measurement block.
+  @retval RETURN_UNSUPPORTED           Per-index collection is not provided. The caller shall use spdm_measurement_collection.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+typedef return_status (*spdm_measurement_collection_by_index_func)(
+	IN spdm_version_number_t spdm_version,
+	IN uint8 measurement_specification, IN uint32 measurement_hash_algo,
+	IN uint8 measurement_index, OUT void *device_measurement,
+	IN OUT uintn *device_measurement_size);
+
 /**
   Sign an SPDM message data.
 
@@ -127,6 +169,48 @@ boolean spdm_measurement_collection(
 				    OUT void *device_measurement,
 				    IN OUT uintn *device_measurement_size);
 
+/**
+  Query the count of the device measurement blocks.
+
+  @param  measurement_specification     Indicates the measurement specification.
+                                       It must align with measurement_specification (SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_*)
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+                                       It must align with measurement_hash_algo (SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_*)
+  @param  device_measurement_count       The count of the device measurement block.
+
+  @retval RETURN_SUCCESS               The count of the device measurement block is returned.
+  @retval RETURN_UNSUPPORTED           The count query is not provided. The caller shall use spdm_measurement_collection.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+return_status spdm_measurement_collection_count(
+	IN spdm_version_number_t spdm_version,
+	IN uint8 measurement_specification, IN uint32 measurement_hash_algo,
+	OUT uint8 *device_measurement_count);
+
+/**
+  Collect one device measurement block.
+
+  @param  measurement_specification     Indicates the measurement specification.
+                                       It must align with measurement_specification (SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_*)
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+                                       It must align with measurement_hash_algo (SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_*)
+  @param  measurement_index             The index of the measurement block (1 ~ 0xFE).
+  @param  device_measurement            A pointer to a destination buffer to store the device measurement block.
+  @param  device_measurement_size        On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the device measurement block in the buffer.
+
+  @retval RETURN_SUCCESS               The device measurement block is returned.
+  @retval RETURN_NOT_FOUND             The device has no measurement block with this index.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the device measurement block.
+  @retval RETURN_UNSUPPORTED           Per-index collection is not provided. The caller shall use spdm_measurement_collection.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+return_status spdm_measurement_collection_by_index(
+	IN spdm_version_number_t spdm_version,
+	IN uint8 measurement_specification, IN uint32 measurement_hash_algo,
+	IN uint8 measurement_index, OUT void *device_measurement,
+	IN OUT uintn *device_measurement_size);
+
 /**
   Sign an SPDM message data.
 
@@ -173,6 +257,96 @@ boolean spdm_responder_data_sign(
 				 IN const uint8 *message, IN uintn message_size,
 				 OUT uint8 *signature, IN OUT uintn *sig_size);
 
+/**
+  Load the responder private key of a slot into the private key cache.
+
+  The key is read and parsed once, and reused by every subsequent
+  spdm_responder_data_sign() until it is unloaded or invalidated.
+  Loading a key that is already cached is a no-op.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+
+  @retval TRUE  the private key is loaded.
+  @retval FALSE the private key cannot be loaded.
+**/
+boolean spdm_responder_private_key_load(IN uint32 base_asym_algo,
+					IN uint8 slot_id);
+
+/**
+  Unload the responder private key of a slot from the private key cache.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+**/
+void spdm_responder_private_key_unload(IN uint32 base_asym_algo,
+				       IN uint8 slot_id);
+
+/**
+  Load the requester private key of a slot into the private key cache.
+
+  The key is read and parsed once, and reused by every subsequent
+  spdm_requester_data_sign() until it is unloaded or invalidated.
+  Loading a key that is already cached is a no-op.
+
+  @param  req_base_asym_alg               Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+
+  @retval TRUE  the private key is loaded.
+  @retval FALSE the private key cannot be loaded.
+**/
+boolean spdm_requester_private_key_load(IN uint16 req_base_asym_alg,
+					IN uint8 slot_id);
+
+/**
+  Unload the requester private key of a slot from the private key cache.
+
+  @param  req_base_asym_alg               Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+**/
+void spdm_requester_private_key_unload(IN uint16 req_base_asym_alg,
+				       IN uint8 slot_id);
+
+/**
+  Release all the cached private keys.
+
+  It must be called when the provisioned private keys change, so that the next
+  signing operation reloads them.
+**/
+void spdm_private_key_cache_invalidate(void);
+
+/**
+  Acquire or release the lock serializing the access to the private key cache.
+
+  @param  lock_context                  The lock context registered with the cache.
+**/
+typedef void (*spdm_private_key_cache_lock_func)(IN void *lock_context);
+
+/**
+  Register the lock serializing the access to the private key cache.
+
+  The cache is shared by all the SPDM contexts of the process. The lock must be registered
+  before the SPDM contexts of several threads sign with the cached keys, and must not be
+  changed while a key is in use.
+
+  @param  acquire_lock                  The function to acquire the lock, or NULL for a single thread.
+  @param  release_lock                  The function to release the lock, or NULL for a single thread.
+  @param  lock_context                  The lock context passed to the functions.
+**/
+void spdm_private_key_cache_register_lock_func(
+	IN spdm_private_key_cache_lock_func acquire_lock OPTIONAL,
+	IN spdm_private_key_cache_lock_func release_lock OPTIONAL,
+	IN void *lock_context OPTIONAL);
+
+/**
+  Return the number of private key lookups answered and missed by the private key cache.
+
+  @param  hit_count                     The number of keys found in the cache.
+  @param  miss_count                    The number of keys read and parsed.
+**/
+void spdm_private_key_cache_get_stats(OUT uintn *hit_count,
+				      OUT uintn *miss_count);
+
 /**
   Derive HMAC-based Expand key Derivation Function (HKDF) Expand, based upon the negotiated HKDF algorithm.
 
@@ -0,0 +1,190 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __SPDM_FLEET_LIB_H__
+#define __SPDM_FLEET_LIB_H__
+
+#include <library/spdm_requester_lib.h>
+
+//
+// A fleet owns one SPDM requester context per device, and attests all devices
+// on a pool of worker threads. Device i is always attested by worker
+// (i % worker_count), so one SPDM context is only used by one thread.
+//
+// All SPDM contexts share one verified certificate link cache, so the
+// certificates common to the devices are only verified once. The fleet locks
+// it while the workers run.
+//
+// The SPDM contexts still share the process-global state of the device secret
+// library, such as its private key cache, which the fleet does not lock. The
+// integrator registers a lock with spdm_private_key_cache_register_lock_func
+// before spdm_fleet_run, if a signing operation can run on the workers.
+//
+
+//
+// Number of certificate links in the verified certificate link cache of a fleet.
+//
+#define SPDM_FLEET_CERT_LINK_CACHE_ENTRY_COUNT 32
+
+typedef enum {
+	SPDM_FLEET_PHASE_INIT_CONNECTION,
+	SPDM_FLEET_PHASE_GET_DIGEST,
+	SPDM_FLEET_PHASE_GET_CERTIFICATE,
+	SPDM_FLEET_PHASE_CHALLENGE,
+	SPDM_FLEET_PHASE_GET_MEASUREMENT,
+	SPDM_FLEET_PHASE_MAX,
+} spdm_fleet_phase_t;
+
+//
+// The attestation flow run for each device.
+//
+#define SPDM_FLEET_FLOW_GET_DIGEST BIT0
+#define SPDM_FLEET_FLOW_GET_CERTIFICATE BIT1
+#define SPDM_FLEET_FLOW_CHALLENGE BIT2
+#define SPDM_FLEET_FLOW_GET_MEASUREMENT BIT3
+
+typedef struct {
+	uint32 flags;
+	uint8 slot_id;
+	uint8 measurement_hash_type;
+	uint8 request_attribute;
+	uint8 measurement_operation;
+} spdm_fleet_flow_t;
+
+typedef struct {
+	//
+	// status is the result of the first failed phase, and failed_phase is the phase,
+	// or SPDM_FLEET_PHASE_MAX if all phases succeed.
+	//
+	return_status status;
+	spdm_fleet_phase_t failed_phase;
+	uintn worker_index;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+	uintn cert_chain_size;
+	uint8 cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint8 number_of_blocks;
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	//
+	// Time in microseconds spent in each phase.
+	//
+	uint64 phase_time_us[SPDM_FLEET_PHASE_MAX];
+	uint64 total_time_us;
+} spdm_fleet_device_report_t;
+
+typedef struct {
+	uintn device_count;
+	uintn worker_count;
+	uintn success_count;
+	//
+	// Wall clock time in microseconds of the whole run, and the sum of the phase time of all devices.
+	//
+	uint64 elapsed_time_us;
+	uint64 phase_time_us[SPDM_FLEET_PHASE_MAX];
+	//
+	// Lookups answered and missed by the verified certificate link cache since the fleet context is initialized.
+	//
+	uint64 cert_link_cache_hit_count;
+	uint64 cert_link_cache_miss_count;
+	spdm_fleet_device_report_t *device_report;
+} spdm_fleet_report_t;
+
+/**
+  Return the size in bytes of a fleet context.
+
+  @param  device_count                  The number of devices of the fleet.
+
+  @return the size in bytes of the fleet context, including the SPDM contexts and the device reports.
+**/
+uintn spdm_fleet_get_context_size(IN uintn device_count);
+
+/**
+  Initialize a fleet context.
+
+  Each SPDM context of the fleet is initialized by spdm_init_context. The integrator
+  registers the device IO and transport layer functions and sets the local data of
+  each context via spdm_fleet_get_spdm_context before spdm_fleet_run.
+
+  @param  fleet_context                 A pointer to the fleet context of spdm_fleet_get_context_size bytes.
+  @param  device_count                  The number of devices of the fleet.
+  @param  worker_count                  The number of worker threads. 0 means one per processor.
+                                       It is capped to device_count.
+
+  @retval RETURN_SUCCESS               The fleet context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The device_count is 0.
+**/
+return_status spdm_fleet_init_context(IN void *fleet_context,
+				      IN uintn device_count,
+				      IN uintn worker_count);
+
+/**
+  Release the resources held by the SPDM contexts of a fleet.
+
+  The fleet context buffer itself is owned by the caller. spdm_fleet_init_context must be
+  called before it is used again.
+
+  @param  fleet_context                 A pointer to the fleet context.
+**/
+void spdm_fleet_deinit_context(IN void *fleet_context);
+
+/**
+  Return the SPDM context of a device of a fleet.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  device_index                  The index of the device.
+
+  @return the SPDM context, or NULL if the index is out of range.
+**/
+void *spdm_fleet_get_spdm_context(IN void *fleet_context,
+				  IN uintn device_index);
+
+/**
+  Return the index of the device whose SPDM context is given.
+
+  It can be used in the device IO functions to find the device of an SPDM context.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  spdm_context                  A pointer to an SPDM context of the fleet.
+
+  @return the index of the device, or (uintn)-1 if the SPDM context is not in the fleet.
+**/
+uintn spdm_fleet_get_device_index(IN void *fleet_context,
+				  IN void *spdm_context);
+
+/**
+  Set the attestation flow run for each device.
+
+  The default flow is GET_DIGEST, GET_CERTIFICATE, CHALLENGE of slot 0 without measurement
+  summary hash, and GET_MEASUREMENT of all measurements without signature.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  flow                         The attestation flow.
+**/
+void spdm_fleet_set_flow(IN void *fleet_context,
+			 IN const spdm_fleet_flow_t *flow);
+
+/**
+  Attest all devices of a fleet.
+
+  Each device runs spdm_init_connection, then the phases of the flow in order, and stops
+  at the first failed phase. The workers run in parallel, and this function returns when
+  all devices are attested. A worker whose thread cannot be created runs on the calling thread.
+  The verified certificate link cache is locked by a mutex while the workers run. The lock of
+  the private key cache of the device secret library must be registered by the integrator.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  report                       The report of the run. The device reports are owned by the fleet
+                                       context and are valid until the next run.
+
+  @retval RETURN_SUCCESS               All devices are attested successfully.
+  @retval RETURN_DEVICE_ERROR          At least one device fails. The report tells which.
+**/
+return_status spdm_fleet_run(IN void *fleet_context,
+			     OUT spdm_fleet_report_t *report);
+
+#endif
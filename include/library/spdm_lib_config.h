@@ -22,12 +22,35 @@
 #define MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE 0x100  // to hold message_a before negotiate
 #define MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE 0x300 // to hold message_k before finished_key is ready
 
+// Maximum room reserved in front of and behind an SPDM message for in-place transport encoding
+#define MAX_SPDM_TRANSPORT_HEADER_SIZE 64
+#define MAX_SPDM_TRANSPORT_TAIL_SIZE 64
+
 #define MAX_SPDM_REQUEST_RETRY_TIMES 3
+// Default upper bound and jitter of the wait between retries of a request answered with BUSY
+#define MAX_SPDM_REQUEST_RETRY_BACKOFF_US 1000000
+#define SPDM_REQUEST_RETRY_JITTER_PERCENT 25
+// Maximum number of GET_MEASUREMENTS requests a batched requester keeps outstanding
+#define MAX_SPDM_REQUEST_PIPELINE_DEPTH 8
 #define MAX_SPDM_SESSION_STATE_CALLBACK_NUM 4
 #define MAX_SPDM_CONNECTION_STATE_CALLBACK_NUM 4
 
 // If cache transcript data or transcript hash
 #define LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT 0
+// Size of the per-session storage for transcript hash contexts the crypto library can initialize in place
+#define SPDM_SESSION_HASH_CONTEXT_STORAGE_SIZE 0x400
+
+// If the responder keeps per request code counters and latency histograms, see the RESPONDER_STATS build option
+#ifndef LIBSPDM_RESPONDER_STATS_SUPPORT
+#define LIBSPDM_RESPONDER_STATS_SUPPORT 0
+#endif
+// Number of log2 microsecond buckets in each responder latency histogram
+#define SPDM_RESPONDER_STATS_HISTOGRAM_BUCKETS 24
+
+// If sent and received messages can be recorded in a binary trace buffer, see spdm_register_trace_buffer
+#define LIBSPDM_TRACE_SUPPORT 1
+// Maximum number of leading message bytes copied into a trace event, see SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD
+#define SPDM_TRACE_PAYLOAD_SIZE 16
 
 //
 // Crypto Configuation
@@ -51,6 +51,60 @@ return_status spdm_receive_response(IN void *spdm_context,
 				    IN OUT uintn *response_size,
 				    OUT void *response);
 
+/**
+  Send an SPDM or an APP request to a device, encoding the transport message in place.
+
+  The request shall be located inside a larger buffer, with spdm_get_transport_header_size bytes
+  of writable room in front of it and spdm_get_transport_tail_size bytes of writable room behind it.
+  The transport layer writes its headers, padding and AEAD tag into that room. No copy is made.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the request is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  request_size                  size in bytes of the request data buffer.
+  @param  request                      A pointer to the request, with head room and tail room around it.
+                                       The content is overwritten by the encoded message.
+
+  @retval RETURN_SUCCESS               The SPDM request is sent successfully.
+  @retval RETURN_UNSUPPORTED           No in-place transport layer function is registered.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
+**/
+return_status spdm_send_request_in_place(IN void *spdm_context,
+					 IN uint32 *session_id,
+					 IN boolean is_app_message,
+					 IN uintn request_size,
+					 IN OUT void *request);
+
+/**
+  Receive an SPDM or an APP response from a device, decoding the transport message in place.
+
+  The transport message is received into the caller buffer and decrypted there.
+  response is returned as a pointer into that buffer. No copy is made.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message_size                  size in bytes of the receive buffer.
+  @param  message                      A pointer to the receive buffer.
+  @param  response_size                 size in bytes of the decoded response.
+  @param  response                     A pointer to the decoded response inside message.
+
+  @retval RETURN_SUCCESS               The SPDM response is received successfully.
+  @retval RETURN_UNSUPPORTED           No in-place transport layer function is registered.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM response is received from the device.
+**/
+return_status spdm_receive_response_in_place(IN void *spdm_context,
+					     IN uint32 *session_id,
+					     IN boolean is_app_message,
+					     IN uintn message_size,
+					     IN OUT void *message,
+					     OUT uintn *response_size,
+					     OUT void **response);
+
 /**
   This function sends GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS
   to initialize the connection with SPDM responder.
@@ -67,6 +121,38 @@ return_status spdm_receive_response(IN void *spdm_context,
 return_status spdm_init_connection(IN void *spdm_context,
 				   IN boolean get_version_only);
 
+/**
+  This function resumes a connection whose negotiated state was imported by
+  spdm_import_connection_snapshot, instead of calling spdm_init_connection.
+
+  GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS are skipped, so the responder
+  must have kept the negotiated state of the connection (CACHE_CAP). A libspdm responder
+  that kept it accepts GET_DIGESTS in any state after NEGOTIATE_ALGORITHMS, and restarts
+  message B and C from message A, see spdm_get_response_digests. A responder that lost it
+  answers GET_DIGESTS with an ERROR, then the caller resets the context and falls back to
+  spdm_init_connection.
+
+  If the snapshot holds a peer certificate chain, this function sends one GET_DIGESTS.
+  If a slot reports the digest of the cached certificate chain, the chain is verified
+  again locally and GET_CERTIFICATE is skipped.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The slot holding the cached certificate chain, if not NULL.
+
+  @retval RETURN_SUCCESS               The connection is resumed. The connection state is
+                                       SPDM_CONNECTION_STATE_AFTER_CERTIFICATE if the certificate
+                                       chain is confirmed, SPDM_CONNECTION_STATE_NEGOTIATED if
+                                       the snapshot holds no certificate chain.
+  @retval RETURN_NOT_READY             No snapshot is imported.
+  @retval RETURN_NOT_FOUND             No slot holds the cached certificate chain. The cached chain
+                                       is dropped and spdm_get_certificate can be called.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device,
+                                       or the responder lost the negotiated state.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_resume_connection(IN void *spdm_context,
+				     OUT uint8 *slot_id OPTIONAL);
+
 /**
   This function sends GET_DIGEST
   to get all digest of the certificate chains from device.
@@ -313,6 +399,195 @@ return_status spdm_get_measurement_ex(IN void *context, IN uint32 *session_id,
 				   OUT void *requester_nonce OPTIONAL,
 				   OUT void *responder_nonce OPTIONAL);
 
+/**
+  This function sends one GET_MEASUREMENT per index in index_list
+  to get these measurements from the device.
+
+  Up to request_pipeline_depth requests (SPDM_DATA_REQUEST_PIPELINE_DEPTH) are sent before the
+  first response is received. The responses are processed in request order.
+  Only the request for the last index carries request_attribute, so that the signature covers
+  the whole batch.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the last request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  index_count                   The number of measurement indices in index_list.
+  @param  index_list                    The measurement indices to get, in order.
+                                       The index 0xFF gets all the measurement blocks.
+  @param  number_of_blocks               The number of blocks of the measurement record, the sum of the
+                                       blocks of all the responses.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+                                       The blocks are stored in index_list order.
+
+  @retval RETURN_SUCCESS               The measurements are got successfully.
+  @retval RETURN_INVALID_PARAMETER     index_list is empty or contains the index 0.
+  @retval RETURN_BUFFER_TOO_SMALL      The blocks do not fit in measurement_record or number_of_blocks.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_get_measurement_batch(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 slot_id_param, IN uintn index_count, IN const uint8 *index_list,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record);
+
+//
+// Asynchronous requester operations.
+//
+// An operation object runs one requester flow without blocking on the device.
+// spdm_op_start() sends the first request. The integrator receives the transport
+// message from the device in its own event loop, and hands it to
+// spdm_op_on_message_received(), which processes it and sends the next request if any.
+// The flow is complete when SPDM_OP_STATUS_DONE is returned, and spdm_op_poll() returns
+// the result. Only the send_message function of the SPDM context is used.
+//
+// When the device answers BUSY or RESPONSE_NOT_READY, the next request must not be sent
+// before the retry backoff or the RDT of the device. SPDM_OP_STATUS_WAIT is returned instead,
+// spdm_op_poll() reports the time left to wait, and sends the request once the wait is over.
+//
+typedef enum {
+	SPDM_OP_STATUS_WOULD_BLOCK,
+	SPDM_OP_STATUS_DONE,
+	SPDM_OP_STATUS_WAIT,
+} spdm_op_status_t;
+
+/**
+  Return the size in bytes of an SPDM operation object.
+
+  @return the size in bytes of an SPDM operation object.
+**/
+uintn spdm_op_get_size(void);
+
+/**
+  Initialize an operation that sends GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHM.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_version_only              If TRUE, only GET_VERSION is sent.
+**/
+void spdm_op_init_connection(IN OUT void *op, IN void *spdm_context,
+			     IN boolean get_version_only);
+
+/**
+  Initialize an operation that sends GET_DIGEST.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+**/
+void spdm_op_init_get_digest(IN OUT void *op, IN void *spdm_context,
+			     OUT uint8 *slot_mask,
+			     OUT void *total_digest_buffer);
+
+/**
+  Initialize an operation that sends GET_CERTIFICATE for the whole certificate chain.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+**/
+void spdm_op_init_get_certificate(IN OUT void *op, IN void *spdm_context,
+				  IN uint8 slot_id,
+				  IN OUT uintn *cert_chain_size,
+				  OUT void *cert_chain);
+
+/**
+  Initialize an operation that sends CHALLENGE.
+
+  Basic mutual authentication is not supported by the operation. If the responder requests it,
+  the operation completes with RETURN_UNSUPPORTED.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+**/
+void spdm_op_init_challenge(IN OUT void *op, IN void *spdm_context,
+			    IN uint8 slot_id, IN uint8 measurement_hash_type,
+			    OUT void *measurement_hash);
+
+/**
+  Initialize an operation that sends GET_MEASUREMENT.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+**/
+void spdm_op_init_get_measurement(IN OUT void *op, IN void *spdm_context,
+				  IN uint32 *session_id OPTIONAL,
+				  IN uint8 request_attribute,
+				  IN uint8 measurement_operation,
+				  IN uint8 slot_id, OUT uint8 *number_of_blocks,
+				  IN OUT uint32 *measurement_record_length,
+				  OUT void *measurement_record);
+
+/**
+  Start an operation by sending its first request.
+
+  @param  op                           A pointer to the operation object.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The request is sent and the operation waits for the response.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete. The result can be got via spdm_op_poll.
+**/
+spdm_op_status_t spdm_op_start(IN OUT void *op);
+
+/**
+  Deliver a transport message received from the device to an operation.
+
+  The message is processed, and the next request of the flow is sent if there is one.
+  A message delivered to a complete operation is ignored.
+
+  @param  op                           A pointer to the operation object.
+  @param  message_size                  size in bytes of the transport message.
+  @param  message                      A pointer to the transport message.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The next request is sent and the operation waits for the response.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete. The result can be got via spdm_op_poll.
+  @retval SPDM_OP_STATUS_WAIT          The next request is sent by spdm_op_poll after a wait.
+**/
+spdm_op_status_t spdm_op_on_message_received(IN OUT void *op,
+					     IN uintn message_size,
+					     IN void *message);
+
+/**
+  Get the progress of an operation, and send the next request of an operation once its wait is over.
+
+  With a clock registered by spdm_register_timer_func, the wait is over when the time is reached.
+  Without a clock, the wait is reported once, and is considered over at the next poll,
+  so the integrator must wait wait_us before it polls again.
+
+  @param  op                           A pointer to the operation object.
+  @param  status                       The result of the operation, if it is complete.
+  @param  wait_us                      The time in microseconds to wait before the next poll, if the
+                                       operation waits. Otherwise 0.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The operation waits for a response.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete, and status holds the result.
+  @retval SPDM_OP_STATUS_WAIT          The operation waits before the next request, and wait_us holds the time left.
+**/
+spdm_op_status_t spdm_op_poll(IN OUT void *op,
+			      OUT return_status *status OPTIONAL,
+			      OUT uint64 *wait_us OPTIONAL);
+
 /**
   This function sends KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
   to start an SPDM Session.
@@ -466,6 +741,29 @@ return_status spdm_heartbeat(IN void *spdm_context, IN uint32 session_id);
 return_status spdm_key_update(IN void *spdm_context, IN uint32 session_id,
 			      IN boolean single_direction);
 
+/**
+  This function applies the data key update policy of an SPDM Session at an idle point.
+
+  If a data key crossed a limit of the policy set by spdm_secured_message_set_key_update_policy,
+  this function sends KEY_UPDATE, with UPDATE_KEY if only the request direction crossed a limit,
+  and UPDATE_ALL_KEYS otherwise. Then it derives the next data keys, so that the next key update
+  does not derive them.
+
+  The age limit is only checked if a timer is registered by spdm_register_timer_func.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The session ID of the session.
+  @param  key_updated                   TRUE if KEY_UPDATE is sent, if not NULL.
+
+  @retval RETURN_SUCCESS               The policy is applied.
+  @retval RETURN_UNSUPPORTED           KEY_UPDATE is not supported, or the session is not established.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_key_update_on_idle(IN void *spdm_context,
+				      IN uint32 session_id,
+				      OUT boolean *key_updated OPTIONAL);
+
 /**
   This function executes a series of SPDM encapsulated requests and receives SPDM encapsulated responses.
 
@@ -244,4 +244,248 @@ return_status spdm_register_connection_state_callback_func(
 **/
 void spdm_init_key_update_encap_state(IN void *spdm_context);
 
+/**
+  Send an SPDM transport layer message to one peer of a multi-peer responder.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer, such as an MCTP EID or a PCI BDF.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to a destination buffer to store the message.
+  @param  timeout                      The timeout, in 100ns units, to use for the execution
+                                       of the message. A timeout value of 0
+                                       means that this function will wait indefinitely for the
+                                       message to execute.
+
+  @retval RETURN_SUCCESS               The SPDM message is sent successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM message is sent to the device.
+  @retval RETURN_TIMEOUT               A timeout occurred while waiting for the SPDM message
+                                       to execute.
+**/
+typedef return_status (*spdm_multi_peer_send_message_func)(
+	IN void *multi_peer_context, IN uint64 endpoint_id,
+	IN uintn message_size, IN void *message, IN uint64 timeout);
+
+/**
+  Receive an SPDM transport layer message from any peer of a multi-peer responder.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer that sent the message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to a destination buffer to store the message.
+  @param  timeout                      The timeout, in 100ns units, to use for the execution
+                                       of the message. A timeout value of 0
+                                       means that this function will wait indefinitely for the
+                                       message to execute.
+
+  @retval RETURN_SUCCESS               The SPDM message is received successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM message is received from the device.
+  @retval RETURN_TIMEOUT               A timeout occurred while waiting for the SPDM message
+                                       to execute.
+**/
+typedef return_status (*spdm_multi_peer_receive_message_func)(
+	IN void *multi_peer_context, OUT uint64 *endpoint_id,
+	IN OUT uintn *message_size, OUT void *message, IN uint64 timeout);
+
+/**
+  Return the size in bytes of a multi-peer responder context.
+
+  The multi-peer responder context holds the connection table, the session table and
+  one SPDM context for each connection in a single buffer. The SPDM context of a
+  connection only holds the connection and session state of the peer.
+
+  @param  max_connection_count          The maximum number of peers served at the same time.
+  @param  max_session_count             The maximum number of secured sessions across all peers.
+  @param  max_connection_session_count  The maximum number of secured sessions of one peer.
+
+  @return the size in bytes of the multi-peer responder context.
+**/
+uintn spdm_multi_peer_get_context_size(IN uintn max_connection_count,
+				       IN uintn max_session_count,
+				       IN uintn max_connection_session_count);
+
+/**
+  Initialize a multi-peer responder context.
+
+  The template SPDM context holds the local provisioning shared by all connections:
+  the local capabilities and algorithms, certificate chains, PSK hint, opaque data and
+  responder policy, and the measurement cache. The connections use them in place.
+  The transport layer functions and registered callbacks of the template SPDM context
+  are copied into each connection when the first message from a new endpoint is received,
+  so they must be registered before then.
+  The template SPDM context must stay valid for the lifetime of the multi-peer context.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  max_connection_count          The maximum number of peers served at the same time.
+  @param  max_session_count             The maximum number of secured sessions across all peers.
+  @param  max_connection_session_count  The maximum number of secured sessions of one peer.
+  @param  template_spdm_context         A pointer to the provisioned template SPDM context.
+
+  @retval RETURN_SUCCESS               The multi-peer responder context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The connection count or session count is out of range.
+**/
+return_status spdm_multi_peer_init_context(IN void *multi_peer_context,
+					   IN uintn max_connection_count,
+					   IN uintn max_session_count,
+					   IN uintn max_connection_session_count,
+					   IN void *template_spdm_context);
+
+/**
+  Register the device IO functions of a multi-peer responder.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  send_message                  The function to send an SPDM transport layer message to a peer.
+  @param  receive_message               The function to receive an SPDM transport layer message from any peer.
+**/
+void spdm_multi_peer_register_device_io_func(
+	IN void *multi_peer_context,
+	IN spdm_multi_peer_send_message_func send_message,
+	IN spdm_multi_peer_receive_message_func receive_message);
+
+/**
+  Get the SPDM context of the connection with a peer.
+
+  The returned SPDM context can be used with spdm_get_data and spdm_set_data.
+  Setting local data on it changes the provisioning shared by all connections.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @return the SPDM context of the connection, or NULL if there is no connection with this peer.
+**/
+void *spdm_multi_peer_get_connection(IN void *multi_peer_context,
+				     IN uint64 endpoint_id);
+
+/**
+  Get the SPDM context of the connection that owns a secured session.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  session_id                    The SPDM session ID.
+  @param  endpoint_id                   The transport endpoint of the peer that owns the session.
+
+  @return the SPDM context of the connection, or NULL if no connection owns this session.
+**/
+void *spdm_multi_peer_get_connection_via_session_id(
+	IN void *multi_peer_context, IN uint32 session_id,
+	OUT uint64 *endpoint_id OPTIONAL);
+
+/**
+  Remove the connection with a peer, and release its sessions.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @retval RETURN_SUCCESS               The connection is removed.
+  @retval RETURN_NOT_FOUND             There is no connection with this peer.
+**/
+return_status spdm_multi_peer_remove_connection(IN void *multi_peer_context,
+						IN uint64 endpoint_id);
+
+/**
+  Release the resources held by the SPDM contexts of all connections of a multi-peer responder.
+
+  The multi-peer responder context buffer itself is owned by the caller.
+  spdm_multi_peer_init_context must be called before it is used again.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+**/
+void spdm_multi_peer_deinit_context(IN void *multi_peer_context);
+
+/**
+  Process a transport layer message from one peer of a multi-peer responder.
+
+  The message is routed to the connection of the peer. A new connection is created
+  from the template SPDM context for a peer that has no connection yet.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer that sent the request.
+  @param  request                      A pointer to the request data.
+  @param  request_size                  size in bytes of the request data.
+  @param  response                     A pointer to the response data.
+  @param  response_size                 size in bytes of the response data.
+                                       On input, it means the size in bytes of response data buffer.
+                                       On output, it means the size in bytes of copied response data buffer if RETURN_SUCCESS is returned,
+                                       and means the size in bytes of desired response data buffer if RETURN_BUFFER_TOO_SMALL is returned.
+
+  @retval RETURN_SUCCESS               The SPDM request is processed successfully.
+  @retval RETURN_OUT_OF_RESOURCES      The connection table is full, or the session table is full
+                                       and the session created by the request is freed.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the data.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_multi_peer_process_message(IN void *multi_peer_context,
+					      IN uint64 endpoint_id,
+					      IN void *request,
+					      IN uintn request_size,
+					      OUT void *response,
+					      IN OUT uintn *response_size);
+
+/**
+  This is the main dispatch function of a multi-peer responder.
+
+  It receives one request message from any peer, processes it in the connection of
+  that peer and sends the response message back to the same peer.
+
+  It should be called in a while loop or an timer/interrupt handler.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+
+  @retval RETURN_SUCCESS               One SPDM request message is processed.
+  @retval RETURN_OUT_OF_RESOURCES      The connection table is full.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_UNSUPPORTED           One request message is not supported.
+**/
+return_status spdm_multi_peer_dispatch_message(IN void *multi_peer_context);
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+/**
+  Copy the request statistics of an SPDM responder.
+
+  The copy is not synchronized with a request being processed in the same SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  stats                         A pointer to a destination buffer to store the statistics.
+**/
+void spdm_responder_stats_snapshot(IN void *spdm_context,
+				   OUT spdm_responder_stats_t *stats);
+
+/**
+  Clear the request statistics of an SPDM responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_reset(IN void *spdm_context);
+
+/**
+  Register a function to receive the timing of the requests processed by an SPDM responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sample_func                   The function to receive the timing, or NULL to stop sampling.
+  @param  sample_interval               The function is called once every sample_interval requests.
+                                       0 and 1 mean every request.
+**/
+void spdm_register_responder_stats_sample_func(
+	IN void *spdm_context,
+	IN spdm_responder_stats_sample_func sample_func OPTIONAL,
+	IN uint32 sample_interval);
+
+/**
+  Return a latency percentile of one phase of one request code.
+
+  The latency is only known to the precision of the histogram, so the upper
+  bound of the histogram bucket that holds the percentile is returned.
+
+  @param  stats                         A pointer to the statistics.
+  @param  request_code                  The request code, 0x80 to 0xFF.
+  @param  phase                         The phase of the request.
+  @param  percent                       The percentile, 1 to 100.
+
+  @return The latency in microseconds, 0 if the phase was never timed for the request code.
+**/
+uint64 spdm_responder_stats_get_percentile(IN spdm_responder_stats_t *stats,
+					   IN uint8 request_code,
+					   IN spdm_responder_stats_phase_t phase,
+					   IN uint8 percent);
+#endif
+
 #endif
\ No newline at end of file
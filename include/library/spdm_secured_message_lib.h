@@ -287,6 +287,147 @@ boolean spdm_secured_message_dhe_compute_key(
 	IN const uint8 *peer_public, IN uintn peer_public_size,
 	IN OUT void *spdm_secured_message_context);
 
+//
+// A DHE key pool keeps ephemeral key pairs generated ahead of the handshake, so
+// KEY_EXCHANGE only computes the shared secret. Each key pair is handed out once.
+//
+
+/**
+  Acquire or release the lock serializing the access to a DHE key pool.
+
+  @param  lock_context                  The lock context registered with the pool.
+**/
+typedef void (*spdm_dhe_key_pool_lock_func)(IN void *lock_context);
+
+/**
+  Wait for or signal the event waking up the worker of a DHE key pool.
+
+  The event is signaled when a key pair is taken from the pool or the worker is stopped.
+  A signal without a waiter is kept until the next wait.
+
+  @param  event_context                 The event context registered with the pool.
+**/
+typedef void (*spdm_dhe_key_pool_event_func)(IN void *event_context);
+
+/**
+  Return the size in bytes of a DHE key pool.
+
+  @param  dhe_named_group_mask            The SPDM dhe_named_group of each group to pre-generate key pairs for.
+  @param  key_count                     The number of key pairs kept ready per group.
+
+  @return the size in bytes of the pool.
+**/
+uintn spdm_dhe_key_pool_get_size(IN uint16 dhe_named_group_mask,
+				 IN uintn key_count);
+
+/**
+  Initialize a DHE key pool. The pool is empty until it is refilled.
+
+  @param  dhe_key_pool                   The buffer of spdm_dhe_key_pool_get_size(dhe_named_group_mask, key_count) bytes.
+  @param  dhe_named_group_mask            The SPDM dhe_named_group of each group to pre-generate key pairs for.
+  @param  key_count                     The number of key pairs kept ready per group.
+
+  @retval RETURN_SUCCESS               The pool is initialized.
+  @retval RETURN_INVALID_PARAMETER     The key_count is 0 or no supported group is in dhe_named_group_mask.
+**/
+return_status spdm_dhe_key_pool_init(OUT void *dhe_key_pool,
+				     IN uint16 dhe_named_group_mask,
+				     IN uintn key_count);
+
+/**
+  Register the lock serializing the access to a DHE key pool.
+
+  @param  dhe_key_pool                   The DHE key pool.
+  @param  acquire_lock                  The function to acquire the lock, or NULL for a single thread.
+  @param  release_lock                  The function to release the lock, or NULL for a single thread.
+  @param  lock_context                  The lock context passed to the functions.
+**/
+void spdm_dhe_key_pool_register_lock_func(
+	IN void *dhe_key_pool,
+	IN spdm_dhe_key_pool_lock_func acquire_lock OPTIONAL,
+	IN spdm_dhe_key_pool_lock_func release_lock OPTIONAL,
+	IN void *lock_context OPTIONAL);
+
+/**
+  Register the event waking up the worker of a DHE key pool.
+
+  @param  dhe_key_pool                   The DHE key pool.
+  @param  wait_event                    The function to wait for the event.
+  @param  signal_event                  The function to signal the event.
+  @param  event_context                 The event context passed to the functions.
+**/
+void spdm_dhe_key_pool_register_event_func(
+	IN void *dhe_key_pool, IN spdm_dhe_key_pool_event_func wait_event,
+	IN spdm_dhe_key_pool_event_func signal_event,
+	IN void *event_context OPTIONAL);
+
+/**
+  Generate a key pair for each empty slot of a DHE key pool.
+
+  The key pairs are generated without holding the lock, so the handshake can take
+  key pairs from the pool meanwhile.
+
+  @param  dhe_key_pool                   The DHE key pool.
+
+  @return the number of key pairs generated.
+**/
+uintn spdm_dhe_key_pool_refill(IN void *dhe_key_pool);
+
+/**
+  Run the worker of a DHE key pool until spdm_dhe_key_pool_stop is called.
+
+  The worker refills the pool, then waits for the event until a key pair is taken.
+  It is intended to be the entry point of an idle thread, and requires the lock and
+  the event to be registered.
+
+  @param  dhe_key_pool                   The DHE key pool.
+**/
+void spdm_dhe_key_pool_worker(IN void *dhe_key_pool);
+
+/**
+  Stop the worker of a DHE key pool. The worker returns once its current refill is done.
+
+  @param  dhe_key_pool                   The DHE key pool.
+**/
+void spdm_dhe_key_pool_stop(IN void *dhe_key_pool);
+
+/**
+  Free the key pairs left in a DHE key pool. The worker must be stopped first.
+
+  @param  dhe_key_pool                   The DHE key pool.
+**/
+void spdm_dhe_key_pool_free(IN void *dhe_key_pool);
+
+/**
+  Return the number of key pairs taken from and missed in a DHE key pool.
+
+  @param  dhe_key_pool                   The DHE key pool.
+  @param  hit_count                     The number of key pairs taken from the pool.
+  @param  miss_count                    The number of key pairs generated in the handshake because the pool was empty.
+**/
+void spdm_dhe_key_pool_get_statistics(IN void *dhe_key_pool,
+				      OUT uint64 *hit_count,
+				      OUT uint64 *miss_count);
+
+/**
+  Allocates a DHE context with a generated key pair, based upon negotiated DHE algorithm.
+
+  The key pair is taken from the DHE key pool if one is ready, or generated otherwise.
+  The caller owns the DHE context and frees it with spdm_secured_message_dhe_free.
+
+  @param  dhe_key_pool                   The DHE key pool, or NULL to always generate the key pair.
+  @param  dhe_named_group                SPDM dhe_named_group
+  @param  public_key                    Pointer to the buffer to receive the public key.
+  @param  public_key_size                On input, the size of public_key buffer in bytes.
+                                       On output, the size of data returned in public_key buffer in bytes.
+
+  @return Pointer to the DHE context, or NULL if the key pair cannot be generated.
+**/
+void *spdm_secured_message_dhe_new_key(IN void *dhe_key_pool OPTIONAL,
+				       IN uint16 dhe_named_group,
+				       OUT uint8 *public_key,
+				       IN OUT uintn *public_key_size);
+
 /**
   This function used to clear handshake secret.
 
@@ -554,6 +695,61 @@ spdm_activate_update_session_data_key(IN void *spdm_secured_message_context,
 				      IN spdm_key_update_action_t action,
 				      IN boolean use_new_key);
 
+/**
+  This function derives the next SPDM DataKey of a session ahead of the key update.
+
+  spdm_create_update_session_data_key then uses the derived keys instead of deriving them,
+  so calling this function at an idle point keeps the key derivation out of the key update.
+  The keys already derived are kept.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  action                       Indicate of the key update action.
+
+  @retval RETURN_SUCCESS  The next SPDM DataKey is derived.
+  @retval RETURN_OUT_OF_RESOURCES  The HKDF context cannot be allocated.
+**/
+return_status
+spdm_prepare_update_session_data_key(IN void *spdm_secured_message_context,
+				     IN spdm_key_update_action_t action);
+
+//
+// Data key update policy of a session. A limit of 0 is not checked.
+//
+typedef struct {
+	// Records protected by the data key of one direction
+	uint64 max_records;
+	// Application message bytes protected by the data key of one direction
+	uint64 max_bytes;
+	// Age in microseconds of the data key of one direction
+	uint64 max_age_us;
+} spdm_key_update_policy_t;
+
+/**
+  Set the data key update policy of an SPDM secured message context.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  policy                        The data key update policy.
+**/
+void spdm_secured_message_set_key_update_policy(
+	IN void *spdm_secured_message_context,
+	IN spdm_key_update_policy_t *policy);
+
+/**
+  Return if the data keys of a session crossed a limit of the key update policy.
+
+  The age of a data key counts from the first call after the key is activated.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  now_us                        The current time in microseconds, 0 to skip the age check.
+  @param  action                       The directions whose data key crossed a limit.
+
+  @retval TRUE  A data key crossed a limit of the key update policy.
+  @retval FALSE No data key crossed a limit of the key update policy.
+**/
+boolean spdm_secured_message_is_key_update_due(
+	IN void *spdm_secured_message_context, IN uint64 now_us,
+	OUT spdm_key_update_action_t *action);
+
 /**
   Get sequence number in an SPDM secure message.
 
@@ -639,6 +835,78 @@ return_status spdm_decode_secured_message(
 	OUT void *app_message,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
 
+/**
+  Return the room an in-place encoded secured message needs around the application message.
+
+  The head room covers the record header (session ID, sequence number, length) and,
+  for an encrypted session, the cipher header.
+  The tail room covers the random padding and the AEAD tag.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+  @param  head_room_size                 size in bytes required in front of the application message.
+  @param  tail_room_size                 size in bytes required behind the application message.
+**/
+void spdm_secured_message_get_room_size(
+	IN void *spdm_secured_message_context,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t,
+	OUT uintn *head_room_size, OUT uintn *tail_room_size);
+
+/**
+  Encode an application message to a secured message in place.
+
+  The record header (and cipher header) are written in front of the application message,
+  the random padding and the AEAD tag behind it, and the payload is encrypted in place.
+  No copy of the application message is made.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  head_room_size                 size in bytes of the writable room in front of app_message.
+  @param  app_message_size               size in bytes of the application message data buffer.
+  @param  app_message                   A pointer to the application message inside a larger buffer.
+  @param  tail_room_size                 size in bytes of the writable room behind app_message.
+  @param  secured_message_size           size in bytes of the encoded secured message.
+  @param  secured_message               A pointer to the start of the encoded secured message, inside the same buffer.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      The head room or tail room is too small.
+**/
+return_status spdm_encode_secured_message_in_place(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn head_room_size,
+	IN uintn app_message_size, IN OUT void *app_message,
+	IN uintn tail_room_size, OUT uintn *secured_message_size,
+	OUT void **secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
+/**
+  Decode an application message from a secured message in place.
+
+  The payload is verified and decrypted inside the secured message buffer, and
+  app_message is returned as a pointer into that buffer. No copy is made.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to the secured message. It is decrypted in place.
+  @param  app_message_size               size in bytes of the decoded application message.
+  @param  app_message                   A pointer to the decoded application message inside secured_message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_SECURITY_VIOLATION    The secured_message fails verification.
+  @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+**/
+return_status spdm_decode_secured_message_in_place(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn secured_message_size,
+	IN OUT void *secured_message, OUT uintn *app_message_size,
+	OUT void **app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t);
+
 /**
   Get the last SPDM error struct of an SPDM secured message context.
 
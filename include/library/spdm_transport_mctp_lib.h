@@ -8,6 +8,31 @@
 #define __SPDM_MCTP_TRANSPORT_LIB_H__
 
 #include <library/spdm_common_lib.h>
+#include <industry_standard/mctp.h>
+
+#define SPDM_MCTP_ALIGNMENT 1
+#define SPDM_MCTP_SEQUENCE_NUMBER_COUNT 2
+#define SPDM_MCTP_MAX_RANDOM_NUMBER_COUNT 32
+
+//
+// Room reserved in front of an SPDM message for in-place encoding:
+// MCTP header + secured message record header + cipher header + inner MCTP header of the APP message.
+//
+#define SPDM_MCTP_TRANSPORT_HEADER_SIZE                                        \
+	(sizeof(mctp_message_header_t) +                                       \
+	 sizeof(spdm_secured_message_a_data_header1_t) +                       \
+	 SPDM_MCTP_SEQUENCE_NUMBER_COUNT +                                     \
+	 sizeof(spdm_secured_message_a_data_header2_t) +                       \
+	 sizeof(spdm_secured_message_cipher_header_t) +                        \
+	 sizeof(mctp_message_header_t))
+
+//
+// Room reserved behind an SPDM message for in-place encoding:
+// random padding + AEAD tag + alignment padding of the APP message and of the MCTP message.
+//
+#define SPDM_MCTP_TRANSPORT_TAIL_SIZE                                          \
+	(SPDM_MCTP_MAX_RANDOM_NUMBER_COUNT + MAX_AEAD_TAG_SIZE +               \
+	 2 * (SPDM_MCTP_ALIGNMENT - 1))
 
 /**
   Encode an SPDM or APP message to a transport layer message.
@@ -71,6 +96,65 @@ return_status spdm_transport_mctp_decode_message(
 	IN uintn transport_message_size, IN void *transport_message,
 	IN OUT uintn *message_size, OUT void *message);
 
+/**
+  Encode an SPDM or APP message to a transport layer message in place.
+
+  For normal SPDM message, it adds the transport layer wrapper.
+  For secured SPDM message, it encrypts a secured message then adds the transport layer wrapper.
+  For secured APP message, it encrypts a secured message then adds the transport layer wrapper.
+
+  The message shall have SPDM_MCTP_TRANSPORT_HEADER_SIZE bytes of writable room in front of it
+  and SPDM_MCTP_TRANSPORT_TAIL_SIZE bytes of writable room behind it.
+  All headers, padding and the AEAD tag are written into that room. No copy is made.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message, with head room and tail room around it.
+  @param  transport_message_size         size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to the start of the encoded transport message, inside the same buffer.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_UNSUPPORTED           The message cannot be encoded.
+**/
+return_status spdm_transport_mctp_encode_message_in_place(
+	IN void *spdm_context, IN uint32 *session_id, IN boolean is_app_message,
+	IN boolean is_requester, IN uintn message_size, IN OUT void *message,
+	OUT uintn *transport_message_size, OUT void **transport_message);
+
+/**
+  Decode an SPDM or APP message from a transport layer message in place.
+
+  For normal SPDM message, it removes the transport layer wrapper,
+  For secured SPDM message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+  For secured APP message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+
+  The transport message is decrypted inside its own buffer and message points into it. No copy is made.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to the transport message. It is decrypted in place.
+  @param  message_size                  size in bytes of the decoded message.
+  @param  message                      A pointer to the decoded message inside transport_message.
+
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+return_status spdm_transport_mctp_decode_message_in_place(
+	IN void *spdm_context, OUT uint32 **session_id,
+	OUT boolean *is_app_message, IN boolean is_requester,
+	IN uintn transport_message_size, IN OUT void *transport_message,
+	OUT uintn *message_size, OUT void **message);
+
 /**
   Get sequence number in an SPDM secure message.
 
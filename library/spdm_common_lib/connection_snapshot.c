@@ -0,0 +1,392 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_common_lib_internal.h"
+
+/**
+  Write a 16-bit little endian value to a connection snapshot.
+
+  @param  ptr                           A pointer to the snapshot position.
+  @param  value                         The value to write.
+
+  @return The snapshot position after the value.
+**/
+static uint8 *spdm_snapshot_write_uint16(IN uint8 *ptr, IN uint16 value)
+{
+	ptr[0] = (uint8)(value & 0xFF);
+	ptr[1] = (uint8)((value >> 8) & 0xFF);
+	return ptr + sizeof(uint16);
+}
+
+/**
+  Write a 32-bit little endian value to a connection snapshot.
+
+  @param  ptr                           A pointer to the snapshot position.
+  @param  value                         The value to write.
+
+  @return The snapshot position after the value.
+**/
+static uint8 *spdm_snapshot_write_uint32(IN uint8 *ptr, IN uint32 value)
+{
+	ptr = spdm_snapshot_write_uint16(ptr, (uint16)(value & 0xFFFF));
+	return spdm_snapshot_write_uint16(ptr, (uint16)(value >> 16));
+}
+
+/**
+  Read a 16-bit little endian value from a connection snapshot.
+
+  @param  ptr                           On input, a pointer to the snapshot position.
+                                       On output, the snapshot position after the value.
+
+  @return The value read.
+**/
+static uint16 spdm_snapshot_read_uint16(IN OUT uint8 **ptr)
+{
+	uint16 value;
+
+	value = (uint16)((*ptr)[0] | ((*ptr)[1] << 8));
+	*ptr += sizeof(uint16);
+	return value;
+}
+
+/**
+  Read a 32-bit little endian value from a connection snapshot.
+
+  @param  ptr                           On input, a pointer to the snapshot position.
+                                       On output, the snapshot position after the value.
+
+  @return The value read.
+**/
+static uint32 spdm_snapshot_read_uint32(IN OUT uint8 **ptr)
+{
+	uint32 value;
+
+	value = spdm_snapshot_read_uint16(ptr);
+	value |= (uint32)spdm_snapshot_read_uint16(ptr) << 16;
+	return value;
+}
+
+/**
+  Encode an SPDM version as in the VERSION response.
+
+  @param  version                       The SPDM version.
+
+  @return The encoded version.
+**/
+static uint16 spdm_snapshot_encode_version(IN spdm_version_number_t version)
+{
+	return (uint16)((version.major_version << 12) |
+			(version.minor_version << 8) |
+			(version.update_version_number << 4) |
+			version.alpha);
+}
+
+/**
+  Decode an SPDM version encoded by spdm_snapshot_encode_version.
+
+  @param  value                         The encoded version.
+
+  @return The SPDM version.
+**/
+static spdm_version_number_t spdm_snapshot_decode_version(IN uint16 value)
+{
+	spdm_version_number_t version;
+
+	version.major_version = (value >> 12) & 0xF;
+	version.minor_version = (value >> 8) & 0xF;
+	version.update_version_number = (value >> 4) & 0xF;
+	version.alpha = value & 0xF;
+	return version;
+}
+
+/**
+  Check if an SPDM version is in a list of local versions.
+
+  @param  local_version                 The local versions.
+  @param  version                       The SPDM version.
+
+  @retval TRUE  the major and minor versions are in the list.
+  @retval FALSE the major and minor versions are not in the list.
+**/
+static boolean
+spdm_snapshot_is_version_supported(IN spdm_device_version_t *local_version,
+				   IN spdm_version_number_t version)
+{
+	uintn index;
+
+	for (index = 0; index < local_version->spdm_version_count; index++) {
+		if ((local_version->spdm_version[index].major_version ==
+		     version.major_version) &&
+		    (local_version->spdm_version[index].minor_version ==
+		     version.minor_version)) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+  Export the negotiated state of a connection, so that a later connection to the same
+  peer can skip GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS and GET_CERTIFICATE.
+
+  The snapshot holds the negotiated version, capabilities and algorithms, message A and,
+  once GET_CERTIFICATE is done, the peer certificate chain with its digest.
+  The snapshot is not confidential but must be kept from tampering, see
+  spdm_import_connection_snapshot.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      The buffer to store the snapshot.
+  @param  snapshot_size                 On input, the size in bytes of the snapshot buffer.
+                                       On output, the size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS                The snapshot is exported.
+  @retval RETURN_NOT_READY              The algorithms are not negotiated.
+  @retval RETURN_BUFFER_TOO_SMALL       The snapshot buffer is too small. snapshot_size holds the required size.
+  @retval RETURN_DEVICE_ERROR           The certificate chain digest cannot be computed.
+**/
+return_status spdm_export_connection_snapshot(IN void *context,
+					      OUT void *snapshot,
+					      IN OUT uintn *snapshot_size)
+{
+	spdm_context_t *spdm_context;
+	spdm_connection_info_t *connection_info;
+	uintn message_a_size;
+	uintn cert_chain_size;
+	uint32 hash_size;
+	uintn required_size;
+	uint8 *ptr;
+
+	spdm_context = context;
+	connection_info = &spdm_context->connection_info;
+
+	if (connection_info->connection_state <
+	    SPDM_CONNECTION_STATE_NEGOTIATED) {
+		return RETURN_NOT_READY;
+	}
+
+	message_a_size = get_managed_buffer_size(&spdm_context->transcript.message_a);
+	//
+	// Only a chain verified by GET_CERTIFICATE is exported.
+	//
+	cert_chain_size = 0;
+	if (connection_info->connection_state >=
+	    SPDM_CONNECTION_STATE_AFTER_CERTIFICATE) {
+		cert_chain_size =
+			connection_info->peer_used_cert_chain_buffer_size;
+	}
+	hash_size = spdm_get_hash_size(connection_info->algorithm.base_hash_algo);
+
+	required_size = SPDM_CONNECTION_SNAPSHOT_HEADER_SIZE + hash_size +
+			message_a_size + cert_chain_size;
+	if (*snapshot_size < required_size) {
+		*snapshot_size = required_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+	ptr = snapshot;
+	ptr = spdm_snapshot_write_uint32(ptr, SPDM_CONNECTION_SNAPSHOT_SIGNATURE);
+	ptr = spdm_snapshot_write_uint16(ptr, SPDM_CONNECTION_SNAPSHOT_VERSION);
+	ptr = spdm_snapshot_write_uint16(
+		ptr, spdm_snapshot_encode_version(connection_info->version));
+	ptr = spdm_snapshot_write_uint16(
+		ptr, spdm_snapshot_encode_version(
+			     connection_info->secured_message_version));
+	*ptr++ = connection_info->capability.ct_exponent;
+	*ptr++ = connection_info->algorithm.measurement_spec;
+	ptr = spdm_snapshot_write_uint32(ptr, connection_info->capability.flags);
+	ptr = spdm_snapshot_write_uint32(
+		ptr, connection_info->algorithm.measurement_hash_algo);
+	ptr = spdm_snapshot_write_uint32(
+		ptr, connection_info->algorithm.base_asym_algo);
+	ptr = spdm_snapshot_write_uint32(
+		ptr, connection_info->algorithm.base_hash_algo);
+	ptr = spdm_snapshot_write_uint16(
+		ptr, connection_info->algorithm.dhe_named_group);
+	ptr = spdm_snapshot_write_uint16(
+		ptr, connection_info->algorithm.aead_cipher_suite);
+	ptr = spdm_snapshot_write_uint16(
+		ptr, connection_info->algorithm.req_base_asym_alg);
+	ptr = spdm_snapshot_write_uint16(
+		ptr, connection_info->algorithm.key_schedule);
+	ptr = spdm_snapshot_write_uint16(ptr, (uint16)message_a_size);
+	ptr = spdm_snapshot_write_uint32(ptr, (uint32)cert_chain_size);
+
+	if (cert_chain_size != 0) {
+		if (!spdm_hash_cert_chain_buffer(
+			    spdm_context,
+			    connection_info->peer_used_cert_chain_buffer,
+			    cert_chain_size, ptr)) {
+			return RETURN_DEVICE_ERROR;
+		}
+	} else {
+		zero_mem(ptr, hash_size);
+	}
+	ptr += hash_size;
+	copy_mem(ptr, get_managed_buffer(&spdm_context->transcript.message_a),
+		 message_a_size);
+	ptr += message_a_size;
+	copy_mem(ptr, connection_info->peer_used_cert_chain_buffer,
+		 cert_chain_size);
+
+	*snapshot_size = required_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Import the negotiated state of a connection exported by spdm_export_connection_snapshot.
+
+  The connection state becomes SPDM_CONNECTION_STATE_NEGOTIATED. If the snapshot holds a
+  peer certificate chain, it is cached in the SPDM context but is trusted only after
+  spdm_resume_connection confirms it with GET_DIGESTS.
+
+  The snapshot is rejected if its version, base hash, base asymmetric, DHE, AEAD or key
+  schedule algorithm, or its secured message version, is not in the local configuration,
+  since a new negotiation with this configuration could not select it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      The snapshot.
+  @param  snapshot_size                 The size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS                The snapshot is imported.
+  @retval RETURN_INVALID_PARAMETER      The snapshot is malformed.
+  @retval RETURN_UNSUPPORTED            The negotiated version or algorithms are not supported locally.
+  @retval RETURN_ACCESS_DENIED          The connection is already started.
+  @retval RETURN_SECURITY_VIOLATION     The certificate chain does not match its digest.
+**/
+return_status spdm_import_connection_snapshot(IN void *context,
+					      IN void *snapshot,
+					      IN uintn snapshot_size)
+{
+	spdm_context_t *spdm_context;
+	spdm_connection_info_t *connection_info;
+	spdm_device_algorithm_t *local_algorithm;
+	spdm_version_number_t version;
+	spdm_version_number_t secured_message_version;
+	uint8 ct_exponent;
+	uint32 capability_flags;
+	spdm_device_algorithm_t algorithm;
+	uint16 message_a_size;
+	uint32 cert_chain_size;
+	uint8 *ptr;
+	uint8 *message_a;
+	uint8 *cert_chain;
+	uint8 *expected_cert_chain_digest;
+	uint8 cert_chain_digest[MAX_HASH_SIZE];
+	uint32 hash_size;
+
+	spdm_context = context;
+	connection_info = &spdm_context->connection_info;
+	local_algorithm = &spdm_context->local_context->algorithm;
+
+	if (snapshot_size < SPDM_CONNECTION_SNAPSHOT_HEADER_SIZE) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	ptr = snapshot;
+	if ((spdm_snapshot_read_uint32(&ptr) !=
+	     SPDM_CONNECTION_SNAPSHOT_SIGNATURE) ||
+	    (spdm_snapshot_read_uint16(&ptr) !=
+	     SPDM_CONNECTION_SNAPSHOT_VERSION)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	zero_mem(&algorithm, sizeof(algorithm));
+	version = spdm_snapshot_decode_version(spdm_snapshot_read_uint16(&ptr));
+	secured_message_version =
+		spdm_snapshot_decode_version(spdm_snapshot_read_uint16(&ptr));
+	ct_exponent = *ptr++;
+	algorithm.measurement_spec = *ptr++;
+	capability_flags = spdm_snapshot_read_uint32(&ptr);
+	algorithm.measurement_hash_algo = spdm_snapshot_read_uint32(&ptr);
+	algorithm.base_asym_algo = spdm_snapshot_read_uint32(&ptr);
+	algorithm.base_hash_algo = spdm_snapshot_read_uint32(&ptr);
+	algorithm.dhe_named_group = spdm_snapshot_read_uint16(&ptr);
+	algorithm.aead_cipher_suite = spdm_snapshot_read_uint16(&ptr);
+	algorithm.req_base_asym_alg = spdm_snapshot_read_uint16(&ptr);
+	algorithm.key_schedule = spdm_snapshot_read_uint16(&ptr);
+	message_a_size = spdm_snapshot_read_uint16(&ptr);
+	cert_chain_size = spdm_snapshot_read_uint32(&ptr);
+
+	hash_size = spdm_get_hash_size(algorithm.base_hash_algo);
+	if ((hash_size == 0) ||
+	    (message_a_size > MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE) ||
+	    (cert_chain_size > MAX_SPDM_CERT_CHAIN_SIZE) ||
+	    (snapshot_size < SPDM_CONNECTION_SNAPSHOT_HEADER_SIZE + hash_size +
+				     message_a_size + cert_chain_size)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	expected_cert_chain_digest = ptr;
+	message_a = expected_cert_chain_digest + hash_size;
+	cert_chain = message_a + message_a_size;
+
+	//
+	// Each negotiated value must be one the local configuration still offers.
+	//
+	if (!spdm_snapshot_is_version_supported(
+		    &spdm_context->local_context->version, version) ||
+	    (((secured_message_version.major_version != 0) ||
+	      (secured_message_version.minor_version != 0)) &&
+	     !spdm_snapshot_is_version_supported(
+		     &spdm_context->local_context->secured_message_version,
+		     secured_message_version)) ||
+	    ((local_algorithm->base_hash_algo & algorithm.base_hash_algo) ==
+	     0) ||
+	    ((algorithm.base_asym_algo & ~local_algorithm->base_asym_algo) !=
+	     0) ||
+	    ((algorithm.dhe_named_group & ~local_algorithm->dhe_named_group) !=
+	     0) ||
+	    ((algorithm.aead_cipher_suite &
+	      ~local_algorithm->aead_cipher_suite) != 0) ||
+	    ((algorithm.key_schedule & ~local_algorithm->key_schedule) != 0)) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	if (connection_info->connection_state !=
+	    SPDM_CONNECTION_STATE_NOT_STARTED) {
+		return RETURN_ACCESS_DENIED;
+	}
+
+	if (cert_chain_size != 0) {
+		if (!spdm_hash_all(algorithm.base_hash_algo, cert_chain,
+				   cert_chain_size, cert_chain_digest)) {
+			return RETURN_DEVICE_ERROR;
+		}
+		if (const_compare_mem(cert_chain_digest,
+				      expected_cert_chain_digest,
+				      hash_size) != 0) {
+			DEBUG((DEBUG_INFO,
+			       "!!! import_connection_snapshot - cert chain digest mismatch !!!\n"));
+			return RETURN_SECURITY_VIOLATION;
+		}
+	}
+
+	connection_info->version = version;
+	connection_info->secured_message_version = secured_message_version;
+	connection_info->capability.ct_exponent = ct_exponent;
+	connection_info->capability.flags = capability_flags;
+	copy_mem(&connection_info->algorithm, &algorithm, sizeof(algorithm));
+
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_append_message_a(spdm_context, message_a, message_a_size);
+
+	//
+	// The digest is computed with the restored base hash algorithm.
+	//
+	connection_info->peer_used_cert_chain_buffer_size = cert_chain_size;
+	copy_mem(connection_info->peer_used_cert_chain_buffer, cert_chain,
+		 cert_chain_size);
+	spdm_register_cert_chain_digest(
+		spdm_context,
+		(cert_chain_size != 0) ?
+			connection_info->peer_used_cert_chain_buffer :
+			NULL,
+		cert_chain_size,
+		&connection_info->peer_used_cert_chain_digest);
+	spdm_free_peer_public_key(spdm_context);
+
+	connection_info->connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
+	return RETURN_SUCCESS;
+}
@@ -87,13 +87,13 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 				 data,
 				 sizeof(spdm_version_number_t));
 		} else {
-			spdm_context->local_context.version.spdm_version_count =
+			spdm_context->local_context->version.spdm_version_count =
 				(uint8)(data_size /
 					sizeof(spdm_version_number_t));
 			copy_mem(
-				spdm_context->local_context.version.spdm_version,
+				spdm_context->local_context->version.spdm_version,
 				data,
-				spdm_context->local_context.version
+				spdm_context->local_context->version
 						.spdm_version_count *
 					sizeof(spdm_version_number_t));
 		}
@@ -113,14 +113,14 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 				 data,
 				 sizeof(spdm_version_number_t));
 		} else {
-			spdm_context->local_context.secured_message_version
+			spdm_context->local_context->secured_message_version
 				.spdm_version_count = (uint8)(
 				data_size / sizeof(spdm_version_number_t));
 			copy_mem(spdm_context->local_context
-					 .secured_message_version.spdm_version,
+					 ->secured_message_version.spdm_version,
 				 data,
 				 spdm_context->local_context
-						 .secured_message_version
+						 ->secured_message_version
 						 .spdm_version_count *
 					 sizeof(spdm_version_number_t));
 		}
@@ -133,7 +133,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.capability.flags =
 				*(uint32 *)data;
 		} else {
-			spdm_context->local_context.capability.flags =
+			spdm_context->local_context->capability.flags =
 				*(uint32 *)data;
 		}
 		break;
@@ -141,7 +141,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (data_size != sizeof(uint8)) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.capability.ct_exponent =
+		spdm_context->local_context->capability.ct_exponent =
 			*(uint8 *)data;
 		break;
 	case SPDM_DATA_MEASUREMENT_SPEC:
@@ -152,7 +152,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.measurement_spec = *(uint8 *)data;
 		} else {
-			spdm_context->local_context.algorithm.measurement_spec =
+			spdm_context->local_context->algorithm.measurement_spec =
 				*(uint8 *)data;
 		}
 		break;
@@ -164,7 +164,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.measurement_hash_algo = *(uint32 *)data;
 		} else {
-			spdm_context->local_context.algorithm
+			spdm_context->local_context->algorithm
 				.measurement_hash_algo = *(uint32 *)data;
 		}
 		break;
@@ -176,7 +176,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.base_asym_algo =
 				*(uint32 *)data;
 		} else {
-			spdm_context->local_context.algorithm.base_asym_algo =
+			spdm_context->local_context->algorithm.base_asym_algo =
 				*(uint32 *)data;
 		}
 		break;
@@ -188,7 +188,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.base_hash_algo =
 				*(uint32 *)data;
 		} else {
-			spdm_context->local_context.algorithm.base_hash_algo =
+			spdm_context->local_context->algorithm.base_hash_algo =
 				*(uint32 *)data;
 		}
 		break;
@@ -200,7 +200,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.dhe_named_group =
 				*(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.dhe_named_group =
+			spdm_context->local_context->algorithm.dhe_named_group =
 				*(uint16 *)data;
 		}
 		break;
@@ -212,7 +212,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.aead_cipher_suite = *(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.aead_cipher_suite =
+			spdm_context->local_context->algorithm.aead_cipher_suite =
 				*(uint16 *)data;
 		}
 		break;
@@ -224,7 +224,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg = *(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.req_base_asym_alg =
+			spdm_context->local_context->algorithm.req_base_asym_alg =
 				*(uint16 *)data;
 		}
 		break;
@@ -236,7 +236,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 			spdm_context->connection_info.algorithm.key_schedule =
 				*(uint16 *)data;
 		} else {
-			spdm_context->local_context.algorithm.key_schedule =
+			spdm_context->local_context->algorithm.key_schedule =
 				*(uint16 *)data;
 		}
 		break;
@@ -254,15 +254,19 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		spdm_context->response_state = *(uint32 *)data;
 		break;
 	case SPDM_DATA_PEER_PUBLIC_ROOT_CERT:
-		spdm_context->local_context.peer_root_cert_provision_size =
+		spdm_context->local_context->peer_root_cert_provision_size =
 			data_size;
-		spdm_context->local_context.peer_root_cert_provision =
+		spdm_context->local_context->peer_root_cert_provision =
 			data;
 		break;
 	case SPDM_DATA_PEER_PUBLIC_CERT_CHAIN:
-		spdm_context->local_context.peer_cert_chain_provision_size =
+		spdm_context->local_context->peer_cert_chain_provision_size =
 			data_size;
-		spdm_context->local_context.peer_cert_chain_provision = data;
+		spdm_context->local_context->peer_cert_chain_provision = data;
+		spdm_register_cert_chain_digest(
+			spdm_context, data, data_size,
+			&spdm_context->local_context->peer_cert_chain_digest);
+		spdm_free_peer_public_key(spdm_context);
 		break;
 	case SPDM_DATA_LOCAL_SLOT_COUNT:
 		if (data_size != sizeof(uint8)) {
@@ -272,17 +276,21 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (slot_id > MAX_SPDM_SLOT_COUNT) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.slot_count = slot_id;
+		spdm_context->local_context->slot_count = slot_id;
 		break;
 	case SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN:
 		slot_id = parameter->additional_data[0];
-		if (slot_id >= spdm_context->local_context.slot_count) {
+		if (slot_id >= spdm_context->local_context->slot_count) {
 			return RETURN_INVALID_PARAMETER;
 		}
 		spdm_context->local_context
-			.local_cert_chain_provision_size[slot_id] = data_size;
-		spdm_context->local_context.local_cert_chain_provision[slot_id] =
+			->local_cert_chain_provision_size[slot_id] = data_size;
+		spdm_context->local_context->local_cert_chain_provision[slot_id] =
 			data;
+		spdm_register_cert_chain_digest(
+			spdm_context, data, data_size,
+			&spdm_context->local_context
+				 ->local_cert_chain_digest[slot_id]);
 		break;
 	case SPDM_DATA_LOCAL_USED_CERT_CHAIN_BUFFER:
 		if (data_size > MAX_SPDM_CERT_CHAIN_SIZE) {
@@ -302,6 +310,13 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		copy_mem(spdm_context->connection_info
 				 .peer_used_cert_chain_buffer,
 			 data, data_size);
+		spdm_register_cert_chain_digest(
+			spdm_context,
+			spdm_context->connection_info.peer_used_cert_chain_buffer,
+			data_size,
+			&spdm_context->connection_info
+				 .peer_used_cert_chain_digest);
+		spdm_free_peer_public_key(spdm_context);
 		break;
 	case SPDM_DATA_BASIC_MUT_AUTH_REQUESTED:
 		if (data_size != sizeof(boolean)) {
@@ -311,7 +326,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (((mut_auth_requested != 0) && (mut_auth_requested != 1))) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.basic_mut_auth_requested =
+		spdm_context->local_context->basic_mut_auth_requested =
 			mut_auth_requested;
 		spdm_context->encap_context.error_state = 0;
 		spdm_context->encap_context.request_id = 0;
@@ -332,7 +347,7 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		      SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_GET_DIGESTS))) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.mut_auth_requested =
+		spdm_context->local_context->mut_auth_requested =
 			mut_auth_requested;
 		spdm_context->encap_context.error_state = 0;
 		spdm_context->encap_context.request_id = 0;
@@ -343,8 +358,8 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		if (data_size > MAX_SPDM_PSK_HINT_LENGTH) {
 			return RETURN_INVALID_PARAMETER;
 		}
-		spdm_context->local_context.psk_hint_size = data_size;
-		spdm_context->local_context.psk_hint = data;
+		spdm_context->local_context->psk_hint_size = data_size;
+		spdm_context->local_context->psk_hint = data;
 		break;
 	case SPDM_DATA_SESSION_USE_PSK:
 		if (data_size != sizeof(boolean)) {
@@ -370,6 +385,46 @@ return_status spdm_set_data(IN void *context, IN spdm_data_type_t data_type,
 		}
 		spdm_context->opaque_context_data_ptr = *(void **)data;
 		break;
+	case SPDM_DATA_CERT_LINK_CACHE:
+		if (data_size != sizeof(void *)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		spdm_context->local_context->cert_link_cache = *(void **)data;
+		break;
+	case SPDM_DATA_DHE_KEY_POOL:
+		if (data_size != sizeof(void *)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		spdm_context->local_context->dhe_key_pool = *(void **)data;
+		break;
+	case SPDM_DATA_REQUEST_PIPELINE_DEPTH:
+		if (data_size != sizeof(uint8)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		if ((*(uint8 *)data == 0) ||
+		    (*(uint8 *)data > MAX_SPDM_REQUEST_PIPELINE_DEPTH)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		spdm_context->local_context->request_pipeline_depth =
+			*(uint8 *)data;
+		break;
+	case SPDM_DATA_RETRY_POLICY:
+		if (data_size != sizeof(spdm_retry_policy_t)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		if (((spdm_retry_policy_t *)data)->jitter_percent > 100) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		copy_mem(&spdm_context->retry_policy, data,
+			 sizeof(spdm_retry_policy_t));
+		break;
+	case SPDM_DATA_REQUESTER_METRICS:
+		if (data_size != sizeof(spdm_requester_metrics_t)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		copy_mem(&spdm_context->requester_metrics, data,
+			 sizeof(spdm_requester_metrics_t));
+		break;
 	default:
 		return RETURN_UNSUPPORTED;
 		break;
@@ -451,7 +506,7 @@ return_status spdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 				&spdm_context->connection_info.capability.flags;
 		} else {
 			target_data =
-				&spdm_context->local_context.capability.flags;
+				&spdm_context->local_context->capability.flags;
 		}
 		break;
 	case SPDM_DATA_CAPABILITY_CT_EXPONENT:
@@ -460,7 +515,7 @@ return_status spdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 			target_data = &spdm_context->connection_info.capability
 					       .ct_exponent;
 		} else {
-			target_data = &spdm_context->local_context.capability
+			target_data = &spdm_context->local_context->capability
 					       .ct_exponent;
 		}
 		break;
@@ -555,6 +610,27 @@ return_status spdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 		target_data_size = sizeof(void *);
 		target_data = &spdm_context->opaque_context_data_ptr;
 		break;
+	case SPDM_DATA_CERT_LINK_CACHE:
+		target_data_size = sizeof(void *);
+		target_data = &spdm_context->local_context->cert_link_cache;
+		break;
+	case SPDM_DATA_DHE_KEY_POOL:
+		target_data_size = sizeof(void *);
+		target_data = &spdm_context->local_context->dhe_key_pool;
+		break;
+	case SPDM_DATA_REQUEST_PIPELINE_DEPTH:
+		target_data_size = sizeof(uint8);
+		target_data =
+			&spdm_context->local_context->request_pipeline_depth;
+		break;
+	case SPDM_DATA_RETRY_POLICY:
+		target_data_size = sizeof(spdm_retry_policy_t);
+		target_data = &spdm_context->retry_policy;
+		break;
+	case SPDM_DATA_REQUESTER_METRICS:
+		target_data_size = sizeof(spdm_requester_metrics_t);
+		target_data = &spdm_context->requester_metrics;
+		break;
 	default:
 		return RETURN_UNSUPPORTED;
 		break;
@@ -697,7 +773,7 @@ void spdm_reset_message_m(IN void *context, IN void *session_info)
 	}
 	} else {
 		if (spdm_session_info->session_transcript.digest_context_l1l2 != NULL) {
-			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
+			spdm_release_session_hash_context (spdm_session_info,
 				spdm_session_info->session_transcript.digest_context_l1l2);
 			spdm_session_info->session_transcript.digest_context_l1l2 = NULL;
 		}
@@ -719,47 +795,39 @@ void spdm_reset_message_k(IN void *context, IN void *session_info)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_session_info->session_transcript.message_k);
 #else
-	{
-		spdm_context_t *spdm_context;
-		void *secured_message_context;
-	
-		spdm_context = context;
-		secured_message_context = spdm_get_secured_message_context_via_session_info (session_info);
+	reset_managed_buffer(&spdm_session_info->session_transcript.temp_message_k);
 
-		reset_managed_buffer(&spdm_session_info->session_transcript.temp_message_k);
-
-		if (spdm_session_info->session_transcript.digest_context_th != NULL) {
-			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-				spdm_session_info->session_transcript.digest_context_th);
-			spdm_session_info->session_transcript.digest_context_th = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th);
-			spdm_session_info->session_transcript.hmac_rsp_context_th = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
-			spdm_hmac_free_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th);
-			spdm_session_info->session_transcript.hmac_req_context_th = NULL;
-		}
-		if (spdm_session_info->session_transcript.digest_context_th_backup != NULL) {
-			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-				spdm_session_info->session_transcript.digest_context_th_backup);
-			spdm_session_info->session_transcript.digest_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th_backup != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
-			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_req_context_th_backup != NULL) {
-			spdm_hmac_free_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th_backup);
-			spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
-		}
-		spdm_session_info->session_transcript.finished_key_ready = FALSE;
+	if (spdm_session_info->session_transcript.digest_context_th != NULL) {
+		spdm_release_session_hash_context (spdm_session_info,
+			spdm_session_info->session_transcript.digest_context_th);
+		spdm_session_info->session_transcript.digest_context_th = NULL;
+	}
+	if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
+		spdm_release_session_hmac_context (spdm_session_info,
+			spdm_session_info->session_transcript.hmac_rsp_context_th);
+		spdm_session_info->session_transcript.hmac_rsp_context_th = NULL;
+	}
+	if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
+		spdm_release_session_hmac_context (spdm_session_info,
+			spdm_session_info->session_transcript.hmac_req_context_th);
+		spdm_session_info->session_transcript.hmac_req_context_th = NULL;
 	}
+	if (spdm_session_info->session_transcript.digest_context_th_backup != NULL) {
+		spdm_release_session_hash_context (spdm_session_info,
+			spdm_session_info->session_transcript.digest_context_th_backup);
+		spdm_session_info->session_transcript.digest_context_th_backup = NULL;
+	}
+	if (spdm_session_info->session_transcript.hmac_rsp_context_th_backup != NULL) {
+		spdm_release_session_hmac_context (spdm_session_info,
+			spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
+		spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
+	}
+	if (spdm_session_info->session_transcript.hmac_req_context_th_backup != NULL) {
+		spdm_release_session_hmac_context (spdm_session_info,
+			spdm_session_info->session_transcript.hmac_req_context_th_backup);
+		spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
+	}
+	spdm_session_info->session_transcript.finished_key_ready = FALSE;
 #endif
 }
 
@@ -777,33 +845,25 @@ void spdm_reset_message_f(IN void *context, IN void *session_info)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_session_info->session_transcript.message_f);
 #else
-	{
-		spdm_context_t *spdm_context;
-		void *secured_message_context;
-	
-		spdm_context = context;
-		secured_message_context = spdm_get_secured_message_context_via_session_info (session_info);
-
-		if (spdm_session_info->session_transcript.digest_context_th != NULL) {
-			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-				spdm_session_info->session_transcript.digest_context_th);
-			spdm_session_info->session_transcript.digest_context_th = spdm_session_info->session_transcript.digest_context_th_backup;
-			spdm_session_info->session_transcript.digest_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th);
-			spdm_session_info->session_transcript.hmac_rsp_context_th = spdm_session_info->session_transcript.hmac_rsp_context_th_backup;
-			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th);
-			spdm_session_info->session_transcript.hmac_req_context_th = spdm_session_info->session_transcript.hmac_req_context_th_backup;
-			spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
-		}
-		spdm_session_info->session_transcript.message_f_initialized = FALSE;
+	if (spdm_session_info->session_transcript.digest_context_th != NULL) {
+		spdm_release_session_hash_context (spdm_session_info,
+			spdm_session_info->session_transcript.digest_context_th);
+		spdm_session_info->session_transcript.digest_context_th = spdm_session_info->session_transcript.digest_context_th_backup;
+		spdm_session_info->session_transcript.digest_context_th_backup = NULL;
+	}
+	if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
+		spdm_release_session_hmac_context (spdm_session_info,
+			spdm_session_info->session_transcript.hmac_rsp_context_th);
+		spdm_session_info->session_transcript.hmac_rsp_context_th = spdm_session_info->session_transcript.hmac_rsp_context_th_backup;
+		spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
 	}
+	if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
+		spdm_release_session_hmac_context (spdm_session_info,
+			spdm_session_info->session_transcript.hmac_req_context_th);
+		spdm_session_info->session_transcript.hmac_req_context_th = spdm_session_info->session_transcript.hmac_req_context_th_backup;
+		spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
+	}
+	spdm_session_info->session_transcript.message_f_initialized = FALSE;
 #endif
 }
 
@@ -1059,8 +1119,8 @@ return_status spdm_append_message_m(IN void *context, IN void *session_info,
 			RETURN_SUCCESS : RETURN_DEVICE_ERROR;
 	} else {
 		if (spdm_session_info->session_transcript.digest_context_l1l2 == NULL) {
-			spdm_session_info->session_transcript.digest_context_l1l2 = spdm_hash_new (
-				spdm_context->connection_info.algorithm.base_hash_algo);
+			spdm_session_info->session_transcript.digest_context_l1l2 = spdm_acquire_session_hash_context (
+				spdm_context, spdm_session_info);
 			spdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
 				spdm_session_info->session_transcript.digest_context_l1l2);
 		}
@@ -1122,10 +1182,12 @@ return_status spdm_append_message_k(IN void *context, IN void *session_info,
 				}
 				hash_size = spdm_get_hash_size(
 					spdm_context->connection_info.algorithm.base_hash_algo);
-				spdm_hash_all(
-					spdm_context->connection_info.algorithm.base_hash_algo,
-					cert_chain_buffer, cert_chain_buffer_size,
-					cert_chain_buffer_hash);
+				result = spdm_hash_cert_chain_buffer(
+					spdm_context, cert_chain_buffer,
+					cert_chain_buffer_size, cert_chain_buffer_hash);
+				if (!result) {
+					return RETURN_SECURITY_VIOLATION;
+				}
 			}
 		}
 
@@ -1133,8 +1195,8 @@ return_status spdm_append_message_k(IN void *context, IN void *session_info,
 		// prepare digest_context_th
 		//
 		if (spdm_session_info->session_transcript.digest_context_th == NULL) {
-			spdm_session_info->session_transcript.digest_context_th = spdm_hash_new (
-				spdm_context->connection_info.algorithm.base_hash_algo);
+			spdm_session_info->session_transcript.digest_context_th = spdm_acquire_session_hash_context (
+				spdm_context, spdm_session_info);
 			spdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
 				spdm_session_info->session_transcript.digest_context_th);
 			spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
@@ -1179,8 +1241,8 @@ return_status spdm_append_message_k(IN void *context, IN void *session_info,
 		// prepare hmac_rsp_context_th
 		//
 		if (spdm_session_info->session_transcript.hmac_rsp_context_th == NULL) {
-			spdm_session_info->session_transcript.hmac_rsp_context_th = spdm_hmac_new_with_response_finished_key (
-				secured_message_context);
+			spdm_session_info->session_transcript.hmac_rsp_context_th = spdm_acquire_session_hmac_context (
+				spdm_context, spdm_session_info);
 			spdm_hmac_init_with_response_finished_key (secured_message_context,
 				spdm_session_info->session_transcript.hmac_rsp_context_th);
 			spdm_hmac_update_with_response_finished_key (secured_message_context,
@@ -1195,8 +1257,8 @@ return_status spdm_append_message_k(IN void *context, IN void *session_info,
 		// prepare hmac_req_context_th
 		//
 		if (spdm_session_info->session_transcript.hmac_req_context_th == NULL) {
-			spdm_session_info->session_transcript.hmac_req_context_th = spdm_hmac_new_with_request_finished_key (
-				secured_message_context);
+			spdm_session_info->session_transcript.hmac_req_context_th = spdm_acquire_session_hmac_context (
+				spdm_context, spdm_session_info);
 			spdm_hmac_init_with_request_finished_key (secured_message_context,
 				spdm_session_info->session_transcript.hmac_req_context_th);
 			spdm_hmac_update_with_request_finished_key (secured_message_context,
@@ -1281,10 +1343,13 @@ return_status spdm_append_message_f(IN void *context, IN void *session_info,
 
 				hash_size = spdm_get_hash_size(
 					spdm_context->connection_info.algorithm.base_hash_algo);
-				spdm_hash_all(
-					spdm_context->connection_info.algorithm.base_hash_algo,
-					mut_cert_chain_buffer, mut_cert_chain_buffer_size,
+				result = spdm_hash_cert_chain_buffer(
+					spdm_context, mut_cert_chain_buffer,
+					mut_cert_chain_buffer_size,
 					mut_cert_chain_buffer_hash);
+				if (!result) {
+					return RETURN_SECURITY_VIOLATION;
+				}
 			}
 
 			//
@@ -1292,22 +1357,22 @@ return_status spdm_append_message_f(IN void *context, IN void *session_info,
 			// this backup will be used in reset_message_f.
 			//
 			ASSERT (spdm_session_info->session_transcript.digest_context_th != NULL);
-			spdm_session_info->session_transcript.digest_context_th_backup = spdm_hash_new (
-				spdm_context->connection_info.algorithm.base_hash_algo);
+			spdm_session_info->session_transcript.digest_context_th_backup = spdm_acquire_session_hash_context (
+				spdm_context, spdm_session_info);
 			spdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
 				spdm_session_info->session_transcript.digest_context_th,
 				spdm_session_info->session_transcript.digest_context_th_backup);
 
 			ASSERT (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL);
-			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = spdm_hmac_new_with_response_finished_key (
-				secured_message_context);
+			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = spdm_acquire_session_hmac_context (
+				spdm_context, spdm_session_info);
 			spdm_hmac_duplicate_with_response_finished_key (secured_message_context,
 				spdm_session_info->session_transcript.hmac_rsp_context_th,
 				spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
 
 			ASSERT (spdm_session_info->session_transcript.hmac_req_context_th != NULL);
-			spdm_session_info->session_transcript.hmac_req_context_th_backup = spdm_hmac_new_with_request_finished_key (
-				secured_message_context);
+			spdm_session_info->session_transcript.hmac_req_context_th_backup = spdm_acquire_session_hmac_context (
+				spdm_context, spdm_session_info);
 			spdm_hmac_duplicate_with_request_finished_key (secured_message_context,
 				spdm_session_info->session_transcript.hmac_req_context_th,
 				spdm_session_info->session_transcript.hmac_req_context_th_backup);
@@ -1408,14 +1473,14 @@ spdm_is_capabilities_flag_supported(IN spdm_context_t *spdm_context,
 
 	if (is_requester) {
 		negotiated_requester_capabilities_flag =
-			spdm_context->local_context.capability.flags;
+			spdm_context->local_context->capability.flags;
 		negotiated_responder_capabilities_flag =
 			spdm_context->connection_info.capability.flags;
 	} else {
 		negotiated_requester_capabilities_flag =
 			spdm_context->connection_info.capability.flags;
 		negotiated_responder_capabilities_flag =
-			spdm_context->local_context.capability.flags;
+			spdm_context->local_context->capability.flags;
 	}
 
 	if (((requester_capabilities_flag == 0) ||
@@ -1473,6 +1538,208 @@ void spdm_register_transport_layer_func(
 	return;
 }
 
+/**
+  Register SPDM transport layer in-place encode/decode functions for SPDM or APP messages.
+
+  This function is optional. It may be called in addition to spdm_register_transport_layer_func.
+  Once registered, the requester and responder build messages at an offset of transport_header_size
+  inside their send buffers and let the transport layer add headers and tails in place.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  transport_header_size          The maximum size in bytes the transport layer writes in front of a message.
+                                       It shall be no greater than MAX_SPDM_TRANSPORT_HEADER_SIZE.
+  @param  transport_tail_size            The maximum size in bytes the transport layer writes behind a message.
+                                       It shall be no greater than MAX_SPDM_TRANSPORT_TAIL_SIZE.
+  @param  transport_encode_message_in_place The fuction to encode an SPDM or APP message to a transport layer message in place.
+  @param  transport_decode_message_in_place The fuction to decode an SPDM or APP message from a transport layer message in place.
+**/
+void spdm_register_transport_layer_in_place_func(
+	IN void *context, IN uintn transport_header_size,
+	IN uintn transport_tail_size,
+	IN spdm_transport_encode_message_in_place_func
+		transport_encode_message_in_place,
+	IN spdm_transport_decode_message_in_place_func
+		transport_decode_message_in_place)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	ASSERT(transport_header_size <= MAX_SPDM_TRANSPORT_HEADER_SIZE);
+	ASSERT(transport_tail_size <= MAX_SPDM_TRANSPORT_TAIL_SIZE);
+	if ((transport_header_size > MAX_SPDM_TRANSPORT_HEADER_SIZE) ||
+	    (transport_tail_size > MAX_SPDM_TRANSPORT_TAIL_SIZE)) {
+		return;
+	}
+	spdm_context->transport_header_size = transport_header_size;
+	spdm_context->transport_tail_size = transport_tail_size;
+	spdm_context->transport_encode_message_in_place =
+		transport_encode_message_in_place;
+	spdm_context->transport_decode_message_in_place =
+		transport_decode_message_in_place;
+	return;
+}
+
+/**
+  Register the functions used by the requester to pace the retries of a request.
+
+  Without a sleep function, the retries are sent immediately.
+  Without a clock, the deadline of the retry policy is not checked, and the responder
+  statistics and the requester metrics only count the requests.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sleep                         The function to wait for a duration, or NULL.
+  @param  get_time_us                   The function to return a monotonic time stamp, or NULL.
+**/
+void spdm_register_timer_func(IN void *context,
+			      IN spdm_sleep_func sleep OPTIONAL,
+			      IN spdm_get_time_us_func get_time_us OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->sleep = sleep;
+	spdm_context->get_time_us = get_time_us;
+	return;
+}
+
+/**
+  Return the time stamp at the start of an operation counted in the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The time stamp to pass to spdm_metrics_phase_end or spdm_metrics_crypto_end,
+          0 if no clock is registered.
+**/
+uint64 spdm_metrics_begin(IN spdm_context_t *spdm_context)
+{
+	if (spdm_context->get_time_us == NULL) {
+		return 0;
+	}
+	return spdm_context->get_time_us(spdm_context);
+}
+
+/**
+  Count an operation in a counter of the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  counter                       The counter of the operation.
+  @param  begin                         The time stamp returned by spdm_metrics_begin.
+**/
+void spdm_metrics_end(IN spdm_context_t *spdm_context,
+		      IN OUT spdm_metrics_counter_t *counter, IN uint64 begin)
+{
+	uint64 now;
+
+	counter->count++;
+	if (spdm_context->get_time_us == NULL) {
+		return;
+	}
+	now = spdm_context->get_time_us(spdm_context);
+	if (now > begin) {
+		counter->time_us += now - begin;
+	}
+}
+
+/**
+  Count a phase of the requester in the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase.
+  @param  begin                         The time stamp returned by spdm_metrics_begin.
+**/
+void spdm_metrics_phase_end(IN spdm_context_t *spdm_context,
+			    IN spdm_requester_phase_t phase, IN uint64 begin)
+{
+	spdm_metrics_end(spdm_context,
+			 &spdm_context->requester_metrics.phase[phase], begin);
+}
+
+/**
+  Count a crypto operation in the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  op                            The crypto operation.
+  @param  begin                         The time stamp returned by spdm_metrics_begin.
+**/
+void spdm_metrics_crypto_end(IN spdm_context_t *spdm_context,
+			     IN spdm_crypto_op_t op, IN uint64 begin)
+{
+	spdm_metrics_end(spdm_context,
+			 &spdm_context->requester_metrics.crypto[op], begin);
+}
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+/**
+  Start timing a phase of the request processed by the responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The time stamp to pass to spdm_responder_stats_phase_end, 0 if no clock is registered.
+**/
+uint64 spdm_responder_stats_phase_begin(IN spdm_context_t *spdm_context)
+{
+	if (spdm_context->get_time_us == NULL) {
+		return 0;
+	}
+	return spdm_context->get_time_us(spdm_context);
+}
+
+/**
+  Add the time elapsed since spdm_responder_stats_phase_begin to a phase of the
+  request processed by the responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase being timed.
+  @param  begin                         The time stamp returned by spdm_responder_stats_phase_begin.
+**/
+void spdm_responder_stats_phase_end(IN spdm_context_t *spdm_context,
+				    IN spdm_responder_stats_phase_t phase,
+				    IN uint64 begin)
+{
+	uint64 now;
+
+	if (spdm_context->get_time_us == NULL) {
+		return;
+	}
+	now = spdm_context->get_time_us(spdm_context);
+	if (now > begin) {
+		spdm_context->responder_stats_sample.phase_us[phase] +=
+			now - begin;
+	}
+	spdm_context->responder_stats_sample.phase_mask |= (uint8)(1 << phase);
+}
+#endif
+
+/**
+  Return the size of the room to reserve in front of a message for in-place transport encoding.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The registered transport header size. 0 if no in-place transport function is registered.
+**/
+uintn spdm_get_transport_header_size(IN void *context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	return spdm_context->transport_header_size;
+}
+
+/**
+  Return the size of the room to reserve behind a message for in-place transport encoding.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The registered transport tail size. 0 if no in-place transport function is registered.
+**/
+uintn spdm_get_transport_tail_size(IN void *context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	return spdm_context->transport_tail_size;
+}
+
 /**
   Get the last error of an SPDM context.
 
@@ -1528,12 +1795,67 @@ void spdm_set_last_spdm_error_struct(IN void *context,
   @param  spdm_context                  A pointer to the SPDM context.
 */
 void spdm_init_context(IN void *context)
+{
+	spdm_init_context_ex(context, MAX_SPDM_SESSION_COUNT);
+}
+
+/**
+  Initialize an SPDM context with a given session capacity.
+
+  The local provisioning, the measurement cache, the session info pool, the session index
+  table and the secured message contexts are placed after the SPDM context in the same buffer.
+  The size in bytes of the spdm_context can be returned by spdm_get_context_size_ex.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of sessions at the same time.
+
+  @retval RETURN_SUCCESS               The SPDM context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The session count is out of range.
+*/
+return_status spdm_init_context_ex(IN void *context,
+				   IN uintn max_session_count)
+{
+	return spdm_init_connection_context(context, max_session_count, NULL);
+}
+
+/**
+  Initialize an SPDM context with a given session capacity, which uses the local provisioning
+  and the measurement cache of another SPDM context instead of its own.
+
+  The session info pool, the session index table and the secured message contexts are placed
+  after the SPDM context in the same buffer. If provisioning_context is NULL, the SPDM context
+  owns its local provisioning and measurement cache, as with spdm_init_context_ex.
+  The size in bytes of the spdm_context can be returned by spdm_get_connection_context_size,
+  or by spdm_get_context_size_ex if provisioning_context is NULL.
+
+  spdm_set_data of local data on the SPDM context changes the provisioning_context too.
+  The provisioning_context must stay valid for the lifetime of the SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of sessions at the same time.
+  @param  provisioning_context          A pointer to the SPDM context holding the local provisioning.
+
+  @retval RETURN_SUCCESS               The SPDM context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The session count is out of range.
+*/
+return_status spdm_init_connection_context(IN void *context,
+					   IN uintn max_session_count,
+					   IN void *provisioning_context OPTIONAL)
 {
 	spdm_context_t *spdm_context;
+	spdm_context_t *shared_context;
+	uint8 *ptr;
 	void *secured_message_context;
 	uintn SecuredMessageContextSize;
 	uintn index;
 
+	//
+	// Each half of a session ID is allocated as 0xFFFF minus the pool index.
+	//
+	if (max_session_count > 0xFFFF) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
 	spdm_context = context;
 	zero_mem(spdm_context, sizeof(spdm_context_t));
 	spdm_context->version = spdm_context_struct_VERSION;
@@ -1551,36 +1873,83 @@ void spdm_init_context(IN void *context)
 	spdm_context->transcript.message_m.max_buffer_size =
 		sizeof(spdm_context->transcript.message_m.buffer);
 #endif
-	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	spdm_context->retry_policy.retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	spdm_context->retry_policy.jitter_percent =
+		SPDM_REQUEST_RETRY_JITTER_PERCENT;
+	spdm_context->retry_policy.initial_backoff_us = 0;
+	spdm_context->retry_policy.max_backoff_us =
+		MAX_SPDM_REQUEST_RETRY_BACKOFF_US;
+	spdm_context->retry_policy.deadline_us = 0;
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->current_token = 0;
-	spdm_context->local_context.version.spdm_version_count = 2;
-	spdm_context->local_context.version.spdm_version[0].major_version = 1;
-	spdm_context->local_context.version.spdm_version[0].minor_version = 0;
-	spdm_context->local_context.version.spdm_version[0].alpha = 0;
-	spdm_context->local_context.version.spdm_version[0]
-		.update_version_number = 0;
-	spdm_context->local_context.version.spdm_version[1].major_version = 1;
-	spdm_context->local_context.version.spdm_version[1].minor_version = 1;
-	spdm_context->local_context.version.spdm_version[1].alpha = 0;
-	spdm_context->local_context.version.spdm_version[1]
-		.update_version_number = 0;
-	spdm_context->local_context.secured_message_version.spdm_version_count =
-		1;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.major_version = 1;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.minor_version = 1;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.alpha = 0;
-	spdm_context->local_context.secured_message_version.spdm_version[0]
-		.update_version_number = 0;
 	spdm_context->encap_context.certificate_chain_buffer.max_buffer_size =
 		sizeof(spdm_context->encap_context.certificate_chain_buffer.buffer);
 
-	secured_message_context = (void *)((uintn)(spdm_context + 1));
+	ptr = (uint8 *)context + ALIGN_VALUE(sizeof(spdm_context_t),
+					     sizeof(uint64));
+	if (provisioning_context != NULL) {
+		shared_context = provisioning_context;
+		spdm_context->local_context = shared_context->local_context;
+		spdm_context->measurement_cache =
+			shared_context->measurement_cache;
+	} else {
+		spdm_context->local_context = (void *)ptr;
+		ptr += ALIGN_VALUE(sizeof(spdm_local_context_t),
+				   sizeof(uint64));
+		spdm_context->measurement_cache = (void *)ptr;
+		ptr += ALIGN_VALUE(sizeof(spdm_measurement_cache_t),
+				   sizeof(uint64));
+		zero_mem(spdm_context->local_context,
+			 sizeof(spdm_local_context_t));
+		zero_mem(spdm_context->measurement_cache,
+			 sizeof(spdm_measurement_cache_t));
+		spdm_context->local_context->request_pipeline_depth = 1;
+		spdm_context->local_context->version.spdm_version_count = 2;
+		spdm_context->local_context->version.spdm_version[0].major_version = 1;
+		spdm_context->local_context->version.spdm_version[0].minor_version = 0;
+		spdm_context->local_context->version.spdm_version[0].alpha = 0;
+		spdm_context->local_context->version.spdm_version[0]
+			.update_version_number = 0;
+		spdm_context->local_context->version.spdm_version[1].major_version = 1;
+		spdm_context->local_context->version.spdm_version[1].minor_version = 1;
+		spdm_context->local_context->version.spdm_version[1].alpha = 0;
+		spdm_context->local_context->version.spdm_version[1]
+			.update_version_number = 0;
+		spdm_context->local_context->secured_message_version.spdm_version_count =
+			1;
+		spdm_context->local_context->secured_message_version.spdm_version[0]
+			.major_version = 1;
+		spdm_context->local_context->secured_message_version.spdm_version[0]
+			.minor_version = 1;
+		spdm_context->local_context->secured_message_version.spdm_version[0]
+			.alpha = 0;
+		spdm_context->local_context->secured_message_version.spdm_version[0]
+			.update_version_number = 0;
+	}
+
+	spdm_context->max_session_count = max_session_count;
+	spdm_context->session_index_table_size =
+		spdm_get_session_index_table_size(max_session_count);
+	spdm_context->session_info = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(spdm_session_info_t) * max_session_count,
+			   sizeof(uint64));
+	spdm_context->session_index_table = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(uintn) *
+				   spdm_context->session_index_table_size,
+			   sizeof(uint64));
+	secured_message_context = ptr;
+
+	zero_mem(spdm_context->session_info,
+		 sizeof(spdm_session_info_t) * max_session_count);
+	for (index = 0; index < spdm_context->session_index_table_size;
+	     index++) {
+		spdm_context->session_index_table[index] =
+			SPDM_SESSION_INDEX_EMPTY;
+	}
 	SecuredMessageContextSize = spdm_secured_message_get_context_size();
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
+	zero_mem(secured_message_context,
+		 SecuredMessageContextSize * max_session_count);
+	for (index = 0; index < max_session_count; index++) {
 		spdm_context->session_info[index].secured_message_context =
 			(void *)((uintn)secured_message_context +
 				 SecuredMessageContextSize * index);
@@ -1588,9 +1957,10 @@ void spdm_init_context(IN void *context)
 			spdm_context->session_info[index]
 				.secured_message_context);
 	}
+	spdm_init_session_free_list(spdm_context);
 
 	random_seed(NULL, 0);
-	return;
+	return RETURN_SUCCESS;
 }
 
 /**
@@ -1607,6 +1977,7 @@ void spdm_reset_context(IN void *context)
 
 	spdm_context = context;
 	//Clear all info about last connection
+	spdm_free_peer_public_key(spdm_context);
 	zero_mem(&spdm_context->connection_info.capability, sizeof(spdm_device_capability_t));
 	zero_mem(&spdm_context->connection_info.algorithm, sizeof(spdm_device_algorithm_t));
 	zero_mem(&spdm_context->last_spdm_error, sizeof(spdm_error_struct_t));
@@ -1614,7 +1985,6 @@ void spdm_reset_context(IN void *context)
 	spdm_context->connection_info.local_used_cert_chain_buffer_size = 0;
 	spdm_context->connection_info.local_used_cert_chain_buffer = NULL;
 	spdm_context->cache_spdm_request_size = 0;
-	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->current_token = 0;
 	spdm_context->last_spdm_request_session_id = INVALID_SESSION_ID;
@@ -1622,13 +1992,40 @@ void spdm_reset_context(IN void *context)
 	spdm_context->last_spdm_request_size = 0;
 	spdm_context->encap_context.certificate_chain_buffer.max_buffer_size =
 		sizeof(spdm_context->encap_context.certificate_chain_buffer.buffer);
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++)
+	for (index = 0; index < spdm_context->max_session_count; index++)
 	{
 		spdm_session_info_init(spdm_context,
 							&spdm_context->session_info[index],
 							INVALID_SESSION_ID,
 							FALSE);
 	}
+	spdm_init_session_free_list(spdm_context);
+}
+
+/**
+  Release the resources held by an SPDM context, such as the cached peer public key,
+  and the keyed AEAD contexts and the transcript hash and HMAC contexts of the sessions.
+
+  The SPDM context buffer itself is owned by the caller. spdm_init_context must be called
+  before the SPDM context is used again.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+*/
+void spdm_deinit_context(IN void *context)
+{
+	spdm_context_t *spdm_context;
+	uintn index;
+
+	spdm_context = context;
+	spdm_free_peer_public_key(spdm_context);
+	for (index = 0; index < spdm_context->max_session_count; index++) {
+		spdm_session_info_init(spdm_context,
+				       &spdm_context->session_info[index],
+				       INVALID_SESSION_ID, FALSE);
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+		spdm_free_session_context_arena(&spdm_context->session_info[index]);
+#endif
+	}
 }
 /**
   Return the size in bytes of the SPDM context.
@@ -1637,8 +2034,40 @@ void spdm_reset_context(IN void *context)
 **/
 uintn spdm_get_context_size(void)
 {
-	return sizeof(spdm_context_t) +
-	       spdm_secured_message_get_context_size() * MAX_SPDM_SESSION_COUNT;
+	return spdm_get_context_size_ex(MAX_SPDM_SESSION_COUNT);
+}
+
+/**
+  Return the size in bytes of the SPDM context with a given session capacity.
+
+  @param  max_session_count             The maximum number of sessions at the same time.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_context_size_ex(IN uintn max_session_count)
+{
+	return spdm_get_connection_context_size(max_session_count) +
+	       ALIGN_VALUE(sizeof(spdm_local_context_t), sizeof(uint64)) +
+	       ALIGN_VALUE(sizeof(spdm_measurement_cache_t), sizeof(uint64));
+}
+
+/**
+  Return the size in bytes of an SPDM context with a given session capacity, which uses
+  the local provisioning and the measurement cache of another SPDM context.
+
+  @param  max_session_count             The maximum number of sessions at the same time.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_connection_context_size(IN uintn max_session_count)
+{
+	return ALIGN_VALUE(sizeof(spdm_context_t), sizeof(uint64)) +
+	       ALIGN_VALUE(sizeof(spdm_session_info_t) * max_session_count,
+			   sizeof(uint64)) +
+	       ALIGN_VALUE(sizeof(uintn) * spdm_get_session_index_table_size(
+						   max_session_count),
+			   sizeof(uint64)) +
+	       spdm_secured_message_get_context_size() * max_session_count;
 }
 
 /**
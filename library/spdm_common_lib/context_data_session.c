@@ -6,6 +6,216 @@
 
 #include "spdm_common_lib_internal.h"
 
+/**
+  Return the number of slots in the session index table for a session count.
+
+  The size is a power of two, and at least twice the number of sessions, so that
+  a probe sequence always ends at an empty slot.
+
+  @param  max_session_count             The number of entries in the session info pool.
+
+  @return the number of slots in the session index table, a power of two.
+**/
+uintn spdm_get_session_index_table_size(IN uintn max_session_count)
+{
+	uintn table_size;
+
+	table_size = 2;
+	while (table_size < max_session_count * 2) {
+		table_size <<= 1;
+	}
+	return table_size;
+}
+
+/**
+  Return the home slot of a session ID in the session index table.
+
+  @param  session_id                    The SPDM session ID.
+  @param  table_size                    The number of slots in the table, a power of two.
+
+  @return the home slot of the session ID.
+**/
+uintn spdm_session_index_hash(IN uint32 session_id, IN uintn table_size)
+{
+	return (uintn)(((uint64)session_id * 0x9E3779B97F4A7C15ull) >> 32) &
+	       (table_size - 1);
+}
+
+/**
+  Return the slot of a session ID in the session index table.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The SPDM session ID.
+
+  @return the slot holding the session ID, or SPDM_SESSION_INDEX_EMPTY if not found.
+**/
+uintn spdm_find_session_index_slot(IN spdm_context_t *spdm_context,
+				   IN uint32 session_id)
+{
+	uintn slot;
+	uintn pool_index;
+
+	slot = spdm_session_index_hash(session_id,
+				       spdm_context->session_index_table_size);
+	while (spdm_context->session_index_table[slot] !=
+	       SPDM_SESSION_INDEX_EMPTY) {
+		pool_index = spdm_context->session_index_table[slot];
+		if (spdm_context->session_info[pool_index].session_id ==
+		    session_id) {
+			return slot;
+		}
+		slot = (slot + 1) & (spdm_context->session_index_table_size - 1);
+	}
+	return SPDM_SESSION_INDEX_EMPTY;
+}
+
+/**
+  Add a session info pool entry to the session index table, keyed by its session ID.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  pool_index                    The index of the entry in the session info pool.
+**/
+void spdm_insert_session_index(IN spdm_context_t *spdm_context,
+			       IN uintn pool_index)
+{
+	uintn slot;
+
+	slot = spdm_session_index_hash(
+		spdm_context->session_info[pool_index].session_id,
+		spdm_context->session_index_table_size);
+	while (spdm_context->session_index_table[slot] !=
+	       SPDM_SESSION_INDEX_EMPTY) {
+		slot = (slot + 1) & (spdm_context->session_index_table_size - 1);
+	}
+	spdm_context->session_index_table[slot] = pool_index;
+}
+
+/**
+  Remove a session info pool entry from the session index table.
+
+  The entries following the removed slot in the probe sequence are shifted back,
+  so that lookups never need tombstones.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  pool_index                    The index of the entry in the session info pool.
+**/
+void spdm_remove_session_index(IN spdm_context_t *spdm_context,
+			       IN uintn pool_index)
+{
+	uintn mask;
+	uintn slot;
+	uintn next;
+	uintn home;
+
+	mask = spdm_context->session_index_table_size - 1;
+	slot = spdm_session_index_hash(
+		spdm_context->session_info[pool_index].session_id,
+		spdm_context->session_index_table_size);
+	while (spdm_context->session_index_table[slot] != pool_index) {
+		if (spdm_context->session_index_table[slot] ==
+		    SPDM_SESSION_INDEX_EMPTY) {
+			return;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	spdm_context->session_index_table[slot] = SPDM_SESSION_INDEX_EMPTY;
+	next = (slot + 1) & mask;
+	while (spdm_context->session_index_table[next] !=
+	       SPDM_SESSION_INDEX_EMPTY) {
+		home = spdm_session_index_hash(
+			spdm_context
+				->session_info[spdm_context
+						       ->session_index_table[next]]
+				.session_id,
+			spdm_context->session_index_table_size);
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			spdm_context->session_index_table[slot] =
+				spdm_context->session_index_table[next];
+			spdm_context->session_index_table[next] =
+				SPDM_SESSION_INDEX_EMPTY;
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+}
+
+/**
+  Chain all session info pool entries without a session ID in the free list, in pool order.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_init_session_free_list(IN spdm_context_t *spdm_context)
+{
+	uintn last_index;
+	uintn index;
+
+	spdm_context->first_free_session_index = SPDM_SESSION_INDEX_EMPTY;
+	last_index = SPDM_SESSION_INDEX_EMPTY;
+	for (index = 0; index < spdm_context->max_session_count; index++) {
+		if (spdm_context->session_info[index].session_id !=
+		    INVALID_SESSION_ID) {
+			continue;
+		}
+		spdm_context->session_info[index].prev_free_index = last_index;
+		spdm_context->session_info[index].next_free_index =
+			SPDM_SESSION_INDEX_EMPTY;
+		if (last_index == SPDM_SESSION_INDEX_EMPTY) {
+			spdm_context->first_free_session_index = index;
+		} else {
+			spdm_context->session_info[last_index].next_free_index =
+				index;
+		}
+		last_index = index;
+	}
+}
+
+/**
+  Take a session info pool entry out of the free list.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  pool_index                    The index of the entry in the session info pool.
+**/
+void spdm_unlink_free_session(IN spdm_context_t *spdm_context,
+			      IN uintn pool_index)
+{
+	spdm_session_info_t *session_info;
+
+	session_info = &spdm_context->session_info[pool_index];
+	if (session_info->prev_free_index == SPDM_SESSION_INDEX_EMPTY) {
+		spdm_context->first_free_session_index =
+			session_info->next_free_index;
+	} else {
+		spdm_context->session_info[session_info->prev_free_index]
+			.next_free_index = session_info->next_free_index;
+	}
+	if (session_info->next_free_index != SPDM_SESSION_INDEX_EMPTY) {
+		spdm_context->session_info[session_info->next_free_index]
+			.prev_free_index = session_info->prev_free_index;
+	}
+}
+
+/**
+  Put a session info pool entry at the head of the free list.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  pool_index                    The index of the entry in the session info pool.
+**/
+void spdm_push_free_session(IN spdm_context_t *spdm_context,
+			    IN uintn pool_index)
+{
+	spdm_session_info_t *session_info;
+
+	session_info = &spdm_context->session_info[pool_index];
+	session_info->prev_free_index = SPDM_SESSION_INDEX_EMPTY;
+	session_info->next_free_index = spdm_context->first_free_session_index;
+	if (session_info->next_free_index != SPDM_SESSION_INDEX_EMPTY) {
+		spdm_context->session_info[session_info->next_free_index]
+			.prev_free_index = pool_index;
+	}
+	spdm_context->first_free_session_index = pool_index;
+}
+
 /**
   This function initializes the session info.
 
@@ -18,9 +228,10 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 {
 	spdm_session_type_t session_type;
 	uint32 capabilities_flag;
+	uintn pool_index;
 
 	capabilities_flag = spdm_context->connection_info.capability.flags &
-			    spdm_context->local_context.capability.flags;
+			    spdm_context->local_context->capability.flags;
 	switch (capabilities_flag &
 		(SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
 		 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP)) {
@@ -40,12 +251,30 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 		break;
 	}
 
+	//
+	// Keep the session index table and the free list in sync with the session ID
+	// of the pool entry.
+	//
+	pool_index = session_info - spdm_context->session_info;
+	ASSERT(pool_index < spdm_context->max_session_count);
+	if (session_info->session_id != INVALID_SESSION_ID) {
+		spdm_remove_session_index(spdm_context, pool_index);
+		if (session_id == INVALID_SESSION_ID) {
+			spdm_push_free_session(spdm_context, pool_index);
+		}
+	} else if (session_id != INVALID_SESSION_ID) {
+		spdm_unlink_free_session(spdm_context, pool_index);
+	}
+
 	zero_mem(session_info,
 		 OFFSET_OF(spdm_session_info_t, secured_message_context));
 	spdm_secured_message_init_context(
 		session_info->secured_message_context);
 	session_info->session_id = session_id;
 	session_info->use_psk = use_psk;
+	if (session_id != INVALID_SESSION_ID) {
+		spdm_insert_session_index(spdm_context, pool_index);
+	}
 	spdm_secured_message_set_use_psk(session_info->secured_message_context,
 					 use_psk);
 	spdm_secured_message_set_session_type(
@@ -60,8 +289,8 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.key_schedule);
 	spdm_secured_message_set_psk_hint(
 		session_info->secured_message_context,
-		spdm_context->local_context.psk_hint,
-		spdm_context->local_context.psk_hint_size);
+		spdm_context->local_context->psk_hint,
+		spdm_context->local_context->psk_hint_size);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	session_info->session_transcript.message_k.max_buffer_size =
 		sizeof(session_info->session_transcript.message_k.buffer);
@@ -72,9 +301,218 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 #else
 	session_info->session_transcript.temp_message_k.max_buffer_size =
 		sizeof(session_info->session_transcript.temp_message_k.buffer);
+	//
+	// The transcript of the previous session is cleared, its contexts are free for reuse.
+	//
+	session_info->context_arena.hash_context_in_use = 0;
+	session_info->context_arena.hmac_context_in_use = 0;
 #endif
 }
 
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+  Free the hash and HMAC contexts held by the context arena of a session.
+
+  @param  session_info                  A pointer to the SPDM session context.
+**/
+void spdm_free_session_context_arena(IN spdm_session_info_t *session_info)
+{
+	spdm_session_context_arena_t *arena;
+	uintn index;
+
+	arena = &session_info->context_arena;
+	for (index = 0; index < SPDM_SESSION_HASH_CONTEXT_COUNT; index++) {
+		if (arena->hash_context[index] != NULL &&
+		    arena->hash_context_size == 0) {
+			spdm_hash_free(arena->base_hash_algo,
+				       arena->hash_context[index]);
+		}
+		arena->hash_context[index] = NULL;
+	}
+	for (index = 0; index < SPDM_SESSION_HMAC_CONTEXT_COUNT; index++) {
+		if (arena->hmac_context[index] != NULL) {
+			spdm_hmac_free(arena->base_hash_algo,
+				       arena->hmac_context[index]);
+		}
+		arena->hmac_context[index] = NULL;
+	}
+	zero_mem(arena->hash_context_storage,
+		 sizeof(arena->hash_context_storage));
+	arena->base_hash_algo = 0;
+	arena->hash_context_size = 0;
+	arena->hash_context_in_use = 0;
+	arena->hmac_context_in_use = 0;
+}
+
+/**
+  Prepare the context arena of a session for the negotiated hash algorithm.
+
+  The contexts created for another hash algorithm are freed, and the stride of
+  the hash contexts in the storage is derived from the new hash algorithm.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context.
+
+  @return the context arena of the session.
+**/
+static spdm_session_context_arena_t *
+spdm_prepare_session_context_arena(IN spdm_context_t *spdm_context,
+				   IN spdm_session_info_t *session_info)
+{
+	spdm_session_context_arena_t *arena;
+	uint32 base_hash_algo;
+	uintn hash_context_size;
+
+	arena = &session_info->context_arena;
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	if (arena->base_hash_algo == base_hash_algo) {
+		return arena;
+	}
+
+	ASSERT(arena->hash_context_in_use == 0 &&
+	       arena->hmac_context_in_use == 0);
+	spdm_free_session_context_arena(session_info);
+	arena->base_hash_algo = base_hash_algo;
+
+	hash_context_size = ALIGN_VALUE(spdm_hash_get_context_size(base_hash_algo),
+					sizeof(uint64));
+	if (hash_context_size * SPDM_SESSION_HASH_CONTEXT_COUNT >
+	    sizeof(arena->hash_context_storage)) {
+		hash_context_size = 0;
+	}
+	arena->hash_context_size = hash_context_size;
+	return arena;
+}
+
+/**
+  Take a hash context of the session from its context arena.
+
+  The hash context must be initialized with spdm_hash_init or spdm_hash_duplicate.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context.
+
+  @return the hash context, or NULL if no hash context is available.
+**/
+void *spdm_acquire_session_hash_context(IN spdm_context_t *spdm_context,
+					IN spdm_session_info_t *session_info)
+{
+	spdm_session_context_arena_t *arena;
+	uintn index;
+
+	arena = spdm_prepare_session_context_arena(spdm_context, session_info);
+	for (index = 0; index < SPDM_SESSION_HASH_CONTEXT_COUNT; index++) {
+		if ((arena->hash_context_in_use & (1 << index)) != 0) {
+			continue;
+		}
+		if (arena->hash_context[index] == NULL) {
+			if (arena->hash_context_size != 0) {
+				arena->hash_context[index] =
+					(uint8 *)arena->hash_context_storage +
+					arena->hash_context_size * index;
+			} else {
+				arena->hash_context[index] =
+					spdm_hash_new(arena->base_hash_algo);
+				if (arena->hash_context[index] == NULL) {
+					return NULL;
+				}
+			}
+		}
+		arena->hash_context_in_use |= (uint8)(1 << index);
+		return arena->hash_context[index];
+	}
+
+	DEBUG((DEBUG_ERROR, "spdm_acquire_session_hash_context - no hash context\n"));
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Give a hash context back to the context arena of the session.
+
+  @param  session_info                  A pointer to the SPDM session context.
+  @param  hash_context                  The hash context from spdm_acquire_session_hash_context.
+**/
+void spdm_release_session_hash_context(IN spdm_session_info_t *session_info,
+				       IN void *hash_context)
+{
+	spdm_session_context_arena_t *arena;
+	uintn index;
+
+	arena = &session_info->context_arena;
+	for (index = 0; index < SPDM_SESSION_HASH_CONTEXT_COUNT; index++) {
+		if (arena->hash_context[index] == hash_context) {
+			arena->hash_context_in_use &= (uint8)~(1 << index);
+			return;
+		}
+	}
+	ASSERT(FALSE);
+}
+
+/**
+  Take an HMAC context of the session from its context arena.
+
+  The HMAC context must be initialized with a finished_key or duplicated.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context.
+
+  @return the HMAC context, or NULL if no HMAC context is available.
+**/
+void *spdm_acquire_session_hmac_context(IN spdm_context_t *spdm_context,
+					IN spdm_session_info_t *session_info)
+{
+	spdm_session_context_arena_t *arena;
+	uintn index;
+
+	arena = spdm_prepare_session_context_arena(spdm_context, session_info);
+	for (index = 0; index < SPDM_SESSION_HMAC_CONTEXT_COUNT; index++) {
+		if ((arena->hmac_context_in_use & (1 << index)) != 0) {
+			continue;
+		}
+		//
+		// The crypto library keeps the HMAC key in the context, so an HMAC
+		// context is always allocated, once, and only re-keyed afterwards.
+		//
+		if (arena->hmac_context[index] == NULL) {
+			arena->hmac_context[index] =
+				spdm_hmac_new(arena->base_hash_algo);
+			if (arena->hmac_context[index] == NULL) {
+				return NULL;
+			}
+		}
+		arena->hmac_context_in_use |= (uint8)(1 << index);
+		return arena->hmac_context[index];
+	}
+
+	DEBUG((DEBUG_ERROR, "spdm_acquire_session_hmac_context - no HMAC context\n"));
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Give an HMAC context back to the context arena of the session.
+
+  @param  session_info                  A pointer to the SPDM session context.
+  @param  hmac_context                  The HMAC context from spdm_acquire_session_hmac_context.
+**/
+void spdm_release_session_hmac_context(IN spdm_session_info_t *session_info,
+				       IN void *hmac_context)
+{
+	spdm_session_context_arena_t *arena;
+	uintn index;
+
+	arena = &session_info->context_arena;
+	for (index = 0; index < SPDM_SESSION_HMAC_CONTEXT_COUNT; index++) {
+		if (arena->hmac_context[index] == hmac_context) {
+			arena->hmac_context_in_use &= (uint8)~(1 << index);
+			return;
+		}
+	}
+	ASSERT(FALSE);
+}
+#endif
+
 /**
   This function gets the session info via session ID.
 
@@ -87,8 +525,7 @@ void *spdm_get_session_info_via_session_id(IN void *context,
 					   IN uint32 session_id)
 {
 	spdm_context_t *spdm_context;
-	spdm_session_info_t *session_info;
-	uintn index;
+	uintn slot;
 
 	if (session_id == INVALID_SESSION_ID) {
 		DEBUG((DEBUG_ERROR,
@@ -99,11 +536,10 @@ void *spdm_get_session_info_via_session_id(IN void *context,
 
 	spdm_context = context;
 
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if (session_info[index].session_id == session_id) {
-			return &session_info[index];
-		}
+	slot = spdm_find_session_index_slot(spdm_context, session_id);
+	if (slot != SPDM_SESSION_INDEX_EMPTY) {
+		return &spdm_context
+				->session_info[spdm_context->session_index_table[slot]];
 	}
 
 	DEBUG((DEBUG_ERROR,
@@ -166,7 +602,7 @@ void *spdm_assign_session_id(IN void *context, IN uint32 session_id,
 {
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
-	uintn index;
+	uintn pool_index;
 
 	spdm_context = context;
 
@@ -177,81 +613,69 @@ void *spdm_assign_session_id(IN void *context, IN uint32 session_id,
 		return NULL;
 	}
 
-	session_info = spdm_context->session_info;
-
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if (session_info[index].session_id == session_id) {
-			DEBUG((DEBUG_ERROR,
-			       "spdm_assign_session_id - Duplicated session_id\n"));
-			ASSERT(FALSE);
-			return NULL;
-		}
+	if (spdm_find_session_index_slot(spdm_context, session_id) !=
+	    SPDM_SESSION_INDEX_EMPTY) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_assign_session_id - Duplicated session_id\n"));
+		ASSERT(FALSE);
+		return NULL;
 	}
 
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if (session_info[index].session_id == INVALID_SESSION_ID) {
-			spdm_session_info_init(spdm_context,
-					       &session_info[index], session_id,
-					       use_psk);
-			spdm_context->latest_session_id = session_id;
-			return &session_info[index];
-		}
+	//
+	// Take the head of the free list, the entry whose index the last allocated
+	// half session ID encodes.
+	//
+	pool_index = spdm_context->first_free_session_index;
+	if (pool_index == SPDM_SESSION_INDEX_EMPTY) {
+		DEBUG((DEBUG_ERROR, "spdm_assign_session_id - MAX session_id\n"));
+		return NULL;
 	}
-
-	DEBUG((DEBUG_ERROR, "spdm_assign_session_id - MAX session_id\n"));
-	return NULL;
+	session_info = &spdm_context->session_info[pool_index];
+	spdm_session_info_init(spdm_context, session_info, session_id, use_psk);
+	spdm_context->latest_session_id = session_id;
+	return session_info;
 }
 
 /**
   This function allocates half of session ID for a requester.
 
+  The half session ID encodes the pool index of the entry that spdm_assign_session_id
+  gives to the next session.
+
   @param  spdm_context                  A pointer to the SPDM context.
 
   @return half of session ID for a requester.
 **/
 uint16 spdm_allocate_req_session_id(IN spdm_context_t *spdm_context)
 {
-	uint16 req_session_id;
-	spdm_session_info_t *session_info;
-	uintn index;
-
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if ((session_info[index].session_id & 0xFFFF0000) ==
-		    (INVALID_SESSION_ID & 0xFFFF0000)) {
-			req_session_id = (uint16)(0xFFFF - index);
-			return req_session_id;
-		}
+	if (spdm_context->first_free_session_index ==
+	    SPDM_SESSION_INDEX_EMPTY) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_allocate_req_session_id - MAX session_id\n"));
+		return (INVALID_SESSION_ID & 0xFFFF0000) >> 16;
 	}
-
-	DEBUG((DEBUG_ERROR, "spdm_allocate_req_session_id - MAX session_id\n"));
-	return (INVALID_SESSION_ID & 0xFFFF0000) >> 16;
+	return (uint16)(0xFFFF - spdm_context->first_free_session_index);
 }
 
 /**
   This function allocates half of session ID for a responder.
 
+  The half session ID encodes the pool index of the entry that spdm_assign_session_id
+  gives to the next session.
+
   @param  spdm_context                  A pointer to the SPDM context.
 
   @return half of session ID for a responder.
 **/
 uint16 spdm_allocate_rsp_session_id(IN spdm_context_t *spdm_context)
 {
-	uint16 rsp_session_id;
-	spdm_session_info_t *session_info;
-	uintn index;
-
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if ((session_info[index].session_id & 0xFFFF) ==
-		    (INVALID_SESSION_ID & 0xFFFF)) {
-			rsp_session_id = (uint16)(0xFFFF - index);
-			return rsp_session_id;
-		}
+	if (spdm_context->first_free_session_index ==
+	    SPDM_SESSION_INDEX_EMPTY) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_allocate_rsp_session_id - MAX session_id\n"));
+		return (INVALID_SESSION_ID & 0xFFFF);
 	}
-
-	DEBUG((DEBUG_ERROR, "spdm_allocate_rsp_session_id - MAX session_id\n"));
-	return (INVALID_SESSION_ID & 0xFFFF);
+	return (uint16)(0xFFFF - spdm_context->first_free_session_index);
 }
 
 /**
@@ -266,7 +690,7 @@ void *spdm_free_session_id(IN void *context, IN uint32 session_id)
 {
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
-	uintn index;
+	uintn slot;
 
 	spdm_context = context;
 
@@ -277,14 +701,13 @@ void *spdm_free_session_id(IN void *context, IN uint32 session_id)
 		return NULL;
 	}
 
-	session_info = spdm_context->session_info;
-	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
-		if (session_info[index].session_id == session_id) {
-			spdm_session_info_init(spdm_context,
-					       &session_info[index],
-					       INVALID_SESSION_ID, FALSE);
-			return &session_info[index];
-		}
+	slot = spdm_find_session_index_slot(spdm_context, session_id);
+	if (slot != SPDM_SESSION_INDEX_EMPTY) {
+		session_info = &spdm_context->session_info
+					[spdm_context->session_index_table[slot]];
+		spdm_session_info_init(spdm_context, session_info,
+				       INVALID_SESSION_ID, FALSE);
+		return session_info;
 	}
 
 	DEBUG((DEBUG_ERROR, "spdm_free_session_id - MAX session_id\n"));
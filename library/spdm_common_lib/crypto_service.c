@@ -32,12 +32,12 @@ boolean spdm_get_peer_cert_chain_buffer(IN void *context,
 				.peer_used_cert_chain_buffer_size;
 		return TRUE;
 	}
-	if (spdm_context->local_context.peer_cert_chain_provision_size != 0) {
+	if (spdm_context->local_context->peer_cert_chain_provision_size != 0) {
 		*cert_chain_buffer =
-			spdm_context->local_context.peer_cert_chain_provision;
+			spdm_context->local_context->peer_cert_chain_provision;
 		*cert_chain_buffer_size =
 			spdm_context->local_context
-				.peer_cert_chain_provision_size;
+				->peer_cert_chain_provision_size;
 		return TRUE;
 	}
 	return FALSE;
@@ -430,13 +430,152 @@ boolean spdm_calculate_l1l2_hash(IN void *context, IN void *session_info,
 boolean spdm_generate_cert_chain_hash(IN spdm_context_t *spdm_context,
 				      IN uintn slot_id, OUT uint8 *hash)
 {
-	ASSERT(slot_id < spdm_context->local_context.slot_count);
-	spdm_hash_all(
-		spdm_context->connection_info.algorithm.base_hash_algo,
-		spdm_context->local_context.local_cert_chain_provision[slot_id],
+	ASSERT(slot_id < spdm_context->local_context->slot_count);
+	return spdm_hash_cert_chain_buffer(
+		spdm_context,
+		spdm_context->local_context->local_cert_chain_provision[slot_id],
 		spdm_context->local_context
-			.local_cert_chain_provision_size[slot_id],
+			->local_cert_chain_provision_size[slot_id],
 		hash);
+}
+
+/**
+  This function returns the digest cache entry of a certificate chain buffer held by the SPDM context.
+
+  The local provisioned certificate chain of each slot, the peer provisioned certificate chain
+  and the peer used certificate chain buffer each own one entry.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+
+  @return the digest cache entry, or NULL if the buffer is not registered in the SPDM context.
+**/
+spdm_cert_chain_digest_t *
+spdm_get_cert_chain_digest_entry(IN spdm_context_t *spdm_context,
+				 IN void *cert_chain_buffer,
+				 IN uintn cert_chain_buffer_size)
+{
+	spdm_cert_chain_digest_t *digest_entry;
+	uintn slot_id;
+
+	if (cert_chain_buffer == NULL) {
+		return NULL;
+	}
+
+	digest_entry = &spdm_context->connection_info.peer_used_cert_chain_digest;
+	if (cert_chain_buffer == digest_entry->cert_chain_buffer &&
+	    cert_chain_buffer_size == digest_entry->cert_chain_buffer_size) {
+		return digest_entry;
+	}
+	digest_entry = &spdm_context->local_context->peer_cert_chain_digest;
+	if (cert_chain_buffer == digest_entry->cert_chain_buffer &&
+	    cert_chain_buffer_size == digest_entry->cert_chain_buffer_size) {
+		return digest_entry;
+	}
+	for (slot_id = 0; slot_id < MAX_SPDM_SLOT_COUNT; slot_id++) {
+		digest_entry = &spdm_context->local_context
+					->local_cert_chain_digest[slot_id];
+		if (cert_chain_buffer == digest_entry->cert_chain_buffer &&
+		    cert_chain_buffer_size ==
+			    digest_entry->cert_chain_buffer_size) {
+			return digest_entry;
+		}
+	}
+	return NULL;
+}
+
+/**
+  This function registers a certificate chain buffer in its digest cache entry, replacing the previous one.
+
+  The digest is computed with the negotiated base hash algorithm, or with the local base hash
+  algorithm if only one is configured before negotiation. Otherwise it is computed on first use.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+  @param  digest_entry                   The digest cache entry of the certificate chain buffer.
+**/
+void spdm_register_cert_chain_digest(IN spdm_context_t *spdm_context,
+				     IN void *cert_chain_buffer OPTIONAL,
+				     IN uintn cert_chain_buffer_size,
+				     OUT spdm_cert_chain_digest_t *digest_entry)
+{
+	uint32 base_hash_algo;
+
+	digest_entry->digest_valid = FALSE;
+	if ((cert_chain_buffer == NULL) || (cert_chain_buffer_size == 0)) {
+		digest_entry->cert_chain_buffer = NULL;
+		digest_entry->cert_chain_buffer_size = 0;
+		return;
+	}
+	digest_entry->cert_chain_buffer = cert_chain_buffer;
+	digest_entry->cert_chain_buffer_size = cert_chain_buffer_size;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	if (base_hash_algo == 0) {
+		base_hash_algo =
+			spdm_context->local_context->algorithm.base_hash_algo;
+		if ((base_hash_algo & (base_hash_algo - 1)) != 0) {
+			return;
+		}
+	}
+	if (spdm_get_hash_size(base_hash_algo) == 0) {
+		return;
+	}
+
+	if (!spdm_hash_all(base_hash_algo, cert_chain_buffer,
+			   cert_chain_buffer_size, digest_entry->digest)) {
+		return;
+	}
+	digest_entry->base_hash_algo = base_hash_algo;
+	digest_entry->digest_valid = TRUE;
+}
+
+/**
+  This function returns the hash of a certificate chain buffer with the negotiated base hash algorithm.
+
+  If the buffer is registered in the SPDM context, the hash is read from the digest cache
+  and only computed when the cached one is missing or uses another hash algorithm.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+  @param  hash                         The buffer to store the certificate chain hash.
+
+  @retval TRUE  certificate chain hash is returned.
+  @retval FALSE certificate chain hash is not returned.
+**/
+boolean spdm_hash_cert_chain_buffer(IN spdm_context_t *spdm_context,
+				    IN void *cert_chain_buffer,
+				    IN uintn cert_chain_buffer_size,
+				    OUT uint8 *hash)
+{
+	spdm_cert_chain_digest_t *digest_entry;
+	uint32 base_hash_algo;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+
+	digest_entry = spdm_get_cert_chain_digest_entry(
+		spdm_context, cert_chain_buffer, cert_chain_buffer_size);
+	if (digest_entry == NULL) {
+		return spdm_hash_all(base_hash_algo, cert_chain_buffer,
+				     cert_chain_buffer_size, hash);
+	}
+
+	if (!digest_entry->digest_valid ||
+	    digest_entry->base_hash_algo != base_hash_algo) {
+		if (!spdm_hash_all(base_hash_algo, cert_chain_buffer,
+				   cert_chain_buffer_size,
+				   digest_entry->digest)) {
+			digest_entry->digest_valid = FALSE;
+			return FALSE;
+		}
+		digest_entry->base_hash_algo = base_hash_algo;
+		digest_entry->digest_valid = TRUE;
+	}
+	copy_mem(hash, digest_entry->digest,
+		 spdm_get_hash_size(base_hash_algo));
 	return TRUE;
 }
 
@@ -461,18 +600,19 @@ boolean spdm_verify_peer_digests(IN spdm_context_t *spdm_context,
 	uintn index;
 
 	cert_chain_buffer =
-		spdm_context->local_context.peer_cert_chain_provision;
+		spdm_context->local_context->peer_cert_chain_provision;
 	cert_chain_buffer_size =
-		spdm_context->local_context.peer_cert_chain_provision_size;
+		spdm_context->local_context->peer_cert_chain_provision_size;
 	if ((cert_chain_buffer != NULL) && (cert_chain_buffer_size != 0)) {
 		hash_size = spdm_get_hash_size(
 			spdm_context->connection_info.algorithm.base_hash_algo);
 		hash_buffer = digest;
 
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			cert_chain_buffer, cert_chain_buffer_size,
-			cert_chain_buffer_hash);
+		if (!spdm_hash_cert_chain_buffer(spdm_context, cert_chain_buffer,
+						 cert_chain_buffer_size,
+						 cert_chain_buffer_hash)) {
+			return FALSE;
+		}
 
 		for (index = 0; index < digest_count; index++)
 		{
@@ -520,19 +660,20 @@ boolean spdm_verify_peer_cert_chain_buffer(IN spdm_context_t *spdm_context,
 	uintn received_root_cert_size;
 	boolean result;
 
-	result = spdm_verify_certificate_chain_buffer(
+	result = spdm_verify_certificate_chain_buffer_ex(
 		spdm_context->connection_info.algorithm.base_hash_algo,
-		cert_chain_buffer, cert_chain_buffer_size);
+		cert_chain_buffer, cert_chain_buffer_size,
+		spdm_context->local_context->cert_link_cache);
 	if (!result) {
 		return FALSE;
 	}
 
-	root_cert = spdm_context->local_context.peer_root_cert_provision;
+	root_cert = spdm_context->local_context->peer_root_cert_provision;
 	root_cert_size =
-		spdm_context->local_context.peer_root_cert_provision_size;
-	cert_chain_data = spdm_context->local_context.peer_cert_chain_provision;
+		spdm_context->local_context->peer_root_cert_provision_size;
+	cert_chain_data = spdm_context->local_context->peer_cert_chain_provision;
 	cert_chain_data_size =
-		spdm_context->local_context.peer_cert_chain_provision_size;
+		spdm_context->local_context->peer_cert_chain_provision_size;
 
 	if ((root_cert != NULL) && (root_cert_size != 0)) {
 		root_cert_hash_size = spdm_get_hash_size(
@@ -559,7 +700,10 @@ boolean spdm_verify_peer_cert_chain_buffer(IN spdm_context_t *spdm_context,
 				return FALSE;
 			}
 		} else {
-			if (!x509_verify_cert(received_root_cert, received_root_cert_size,
+			if (!spdm_x509_verify_cert_with_cache(
+					spdm_context->local_context->cert_link_cache,
+					spdm_context->connection_info.algorithm.base_hash_algo,
+					received_root_cert, received_root_cert_size,
 					root_cert, root_cert_size)) {
 				DEBUG((DEBUG_INFO,
 					"!!! verify_peer_cert_chain_buffer - FAIL (received root cert verify failed)!!!\n"));
@@ -616,6 +760,7 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 {
 	boolean result;
 	uintn signature_size;
+	uint64 stats_begin;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 m1m2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn m1m2_buffer_size;
@@ -661,6 +806,7 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 	} else {
 		signature_size = spdm_get_asym_signature_size(
 			spdm_context->connection_info.algorithm.base_asym_algo);
+		stats_begin = spdm_responder_stats_phase_begin(spdm_context);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_responder_data_sign(
 			spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
@@ -676,6 +822,9 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			TRUE, m1m2_hash, m1m2_hash_size, signature,
 			&signature_size);
 #endif
+		spdm_responder_stats_phase_end(spdm_context,
+					       SPDM_RESPONDER_STATS_PHASE_SIGN,
+					       stats_begin);
 	}
 
 	return result;
@@ -711,9 +860,12 @@ boolean spdm_verify_certificate_chain_hash(IN spdm_context_t *spdm_context,
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
 
-	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
-		      cert_chain_buffer, cert_chain_buffer_size,
-		      cert_chain_buffer_hash);
+	result = spdm_hash_cert_chain_buffer(spdm_context, cert_chain_buffer,
+					     cert_chain_buffer_size,
+					     cert_chain_buffer_hash);
+	if (!result) {
+		return FALSE;
+	}
 
 	if (hash_size != certificate_chain_hash_size) {
 		DEBUG((DEBUG_INFO,
@@ -730,6 +882,130 @@ boolean spdm_verify_certificate_chain_hash(IN spdm_context_t *spdm_context,
 	return TRUE;
 }
 
+/**
+  This function releases the cached public key of the peer certificate chain.
+
+  It must be called whenever the peer certificate chain buffer changes.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_free_peer_public_key(IN spdm_context_t *spdm_context)
+{
+	spdm_peer_public_key_cache_t *key_cache;
+
+	key_cache = &spdm_context->connection_info.peer_public_key_cache;
+	if (key_cache->context != NULL) {
+		if (key_cache->is_requester) {
+			spdm_asym_free(key_cache->asym_algo, key_cache->context);
+		} else {
+			spdm_req_asym_free((uint16)key_cache->asym_algo,
+					   key_cache->context);
+		}
+	}
+	zero_mem(key_cache, sizeof(spdm_peer_public_key_cache_t));
+}
+
+/**
+  This function retrieves the public key of the leaf certificate in the peer certificate chain.
+
+  The key is cached in the SPDM context and reused while the peer certificate chain buffer
+  stays registered, so the leaf certificate is only decoded once per certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_requester                  Indicate of the key retrieval for a requester or a responder.
+  @param  context                      Pointer to the asymmetric context which contain the retrieved public key component.
+                                       The context is owned by the SPDM context and must not be freed by the caller.
+
+  @retval TRUE  public key was retrieved successfully.
+  @retval FALSE Fail to retrieve the public key.
+**/
+boolean spdm_get_peer_public_key(IN spdm_context_t *spdm_context,
+				 IN boolean is_requester, OUT void **context)
+{
+	boolean result;
+	spdm_peer_public_key_cache_t *key_cache;
+	void *cert_chain_buffer;
+	uintn cert_chain_buffer_size;
+	uint8 *cert_chain_data;
+	uintn cert_chain_data_size;
+	uint8 *cert_buffer;
+	uintn cert_buffer_size;
+	uint32 asym_algo;
+	void *x509_cert;
+
+	result = spdm_get_peer_cert_chain_buffer(
+		spdm_context, &cert_chain_buffer, &cert_chain_buffer_size);
+	if (!result) {
+		return FALSE;
+	}
+	if (is_requester) {
+		asym_algo = spdm_context->connection_info.algorithm
+				    .base_asym_algo;
+	} else {
+		asym_algo = spdm_context->connection_info.algorithm
+				    .req_base_asym_alg;
+	}
+
+	key_cache = &spdm_context->connection_info.peer_public_key_cache;
+	if ((key_cache->context != NULL) &&
+	    (key_cache->cert_chain_buffer == cert_chain_buffer) &&
+	    (key_cache->cert_chain_buffer_size == cert_chain_buffer_size) &&
+	    (key_cache->is_requester == is_requester) &&
+	    (key_cache->asym_algo == asym_algo)) {
+		*context = key_cache->context;
+		return TRUE;
+	}
+	spdm_free_peer_public_key(spdm_context);
+
+	result = spdm_get_peer_cert_chain_data(
+		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
+	if (!result) {
+		return FALSE;
+	}
+
+	//
+	// Get leaf cert from cert chain
+	//
+	result = x509_get_cert_from_cert_chain(cert_chain_data,
+					       cert_chain_data_size, -1,
+					       &cert_buffer, &cert_buffer_size);
+	if (!result) {
+		return FALSE;
+	}
+
+	x509_cert = NULL;
+	result = x509_construct_certificate(cert_buffer, cert_buffer_size,
+					    (uint8 **)&x509_cert);
+	if (result) {
+		if (is_requester) {
+			result = spdm_asym_get_public_key_from_x509_object(
+				asym_algo, x509_cert, context);
+		} else {
+			result = spdm_req_asym_get_public_key_from_x509_object(
+				(uint16)asym_algo, x509_cert, context);
+		}
+	}
+	x509_free(x509_cert);
+	if (!result) {
+		return FALSE;
+	}
+
+	//
+	// The key is always owned by the cache, but only a certificate chain buffer
+	// registered through spdm_set_data or GET_CERTIFICATE can be matched again.
+	//
+	key_cache->context = *context;
+	key_cache->is_requester = is_requester;
+	key_cache->asym_algo = asym_algo;
+	if (spdm_get_cert_chain_digest_entry(spdm_context, cert_chain_buffer,
+					     cert_chain_buffer_size) != NULL) {
+		key_cache->cert_chain_buffer = cert_chain_buffer;
+		key_cache->cert_chain_buffer_size = cert_chain_buffer_size;
+	}
+
+	return TRUE;
+}
+
 /**
   This function verifies the challenge signature based upon m1m2.
 
@@ -747,11 +1023,7 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 					     IN uintn sign_data_size)
 {
 	boolean result;
-	uint8 *cert_buffer;
-	uintn cert_buffer_size;
 	void *context;
-	uint8 *cert_chain_data;
-	uintn cert_chain_data_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 m1m2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn m1m2_buffer_size;
@@ -773,29 +1045,12 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	result = spdm_get_peer_cert_chain_data(
-		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	//
-	// Get leaf cert from cert chain
-	//
-	result = x509_get_cert_from_cert_chain(cert_chain_data,
-					       cert_chain_data_size, -1,
-					       &cert_buffer, &cert_buffer_size);
+	result = spdm_get_peer_public_key(spdm_context, is_requester, &context);
 	if (!result) {
 		return FALSE;
 	}
 
 	if (is_requester) {
-		result = spdm_asym_get_public_key_from_x509(
-			spdm_context->connection_info.algorithm.base_asym_algo,
-			cert_buffer, cert_buffer_size, &context);
-		if (!result) {
-			return FALSE;
-		}
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_asym_verify(
@@ -812,18 +1067,7 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			context, m1m2_hash, m1m2_hash_size, sign_data,
 			sign_data_size);
 #endif
-		spdm_asym_free(
-			spdm_context->connection_info.algorithm.base_asym_algo,
-			context);
 	} else {
-		result = spdm_req_asym_get_public_key_from_x509(
-			spdm_context->connection_info.algorithm
-				.req_base_asym_alg,
-			cert_buffer, cert_buffer_size, &context);
-		if (!result) {
-			return FALSE;
-		}
-
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_req_asym_verify(
 			spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
@@ -841,9 +1085,6 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			context, m1m2_hash, m1m2_hash_size, sign_data,
 			sign_data_size);
 #endif
-		spdm_req_asym_free(spdm_context->connection_info.algorithm
-					   .req_base_asym_alg,
-				   context);
 	}
 
 	if (!result) {
@@ -914,10 +1155,13 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 	spdm_measurement_block_dmtf_t *cached_measurment_block;
 	uintn measurment_data_size;
 	uintn measurment_block_size;
-	uint8 device_measurement[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 *device_measurement;
 	uint8 device_measurement_count;
 	uintn device_measurement_size;
 	boolean ret;
+	spdm_measurement_cache_t *measurement_cache;
+	uintn summary_hash_index;
+	uintn hash_size;
 
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, is_requester, 0,
@@ -932,18 +1176,35 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 	case SPDM_CHALLENGE_REQUEST_TCB_COMPONENT_MEASUREMENT_HASH:
 	case SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH:
 		// get all measurement data
-		device_measurement_size = sizeof(device_measurement);
-		ret = spdm_measurement_collection(
-			spdm_context->connection_info.version,
-			spdm_context->connection_info.algorithm.measurement_spec,
-			spdm_context->connection_info.algorithm
-				.measurement_hash_algo,
-			&device_measurement_count, device_measurement,
-			&device_measurement_size);
+		ret = spdm_measurement_cache_get_record(
+			spdm_context, &device_measurement_count,
+			&device_measurement, &device_measurement_size);
 		if (!ret) {
 			return ret;
 		}
 
+		// reuse the precomputed summary hash if the record did not change
+		measurement_cache = spdm_get_measurement_cache(spdm_context);
+		if (measurement_summary_hash_type ==
+		    SPDM_CHALLENGE_REQUEST_TCB_COMPONENT_MEASUREMENT_HASH) {
+			summary_hash_index =
+				SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_TCB;
+		} else {
+			summary_hash_index =
+				SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_ALL;
+		}
+		hash_size = spdm_get_hash_size(
+			spdm_context->connection_info.algorithm.base_hash_algo);
+		if (measurement_cache->summary_hash_valid[summary_hash_index] &&
+		    (measurement_cache->summary_hash_algo[summary_hash_index] ==
+		     spdm_context->connection_info.algorithm.base_hash_algo)) {
+			copy_mem(measurement_summary_hash,
+				 measurement_cache
+					 ->summary_hash[summary_hash_index],
+				 hash_size);
+			break;
+		}
+
 		ASSERT(device_measurement_count <=
 		       MAX_SPDM_MEASUREMENT_BLOCK_COUNT);
 
@@ -1013,10 +1274,19 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 				(void *)((uintn)cached_measurment_block +
 					 measurment_block_size);
 		}
-		spdm_hash_all(
+		ret = spdm_hash_all(
 			spdm_context->connection_info.algorithm.base_hash_algo,
 			measurement_data, measurment_data_size,
 			measurement_summary_hash);
+		if (!ret) {
+			return ret;
+		}
+
+		copy_mem(measurement_cache->summary_hash[summary_hash_index],
+			 measurement_summary_hash, hash_size);
+		measurement_cache->summary_hash_algo[summary_hash_index] =
+			spdm_context->connection_info.algorithm.base_hash_algo;
+		measurement_cache->summary_hash_valid[summary_hash_index] = TRUE;
 		break;
 	default:
 		return FALSE;
@@ -1043,6 +1313,7 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 {
 	uintn signature_size;
 	boolean result;
+	uint64 stats_begin;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 l1l2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn l1l2_buffer_size;
@@ -1066,6 +1337,7 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 
 	signature_size = spdm_get_asym_signature_size(
 		spdm_context->connection_info.algorithm.base_asym_algo);
+	stats_begin = spdm_responder_stats_phase_begin(spdm_context);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_responder_data_sign(
 		spdm_context->connection_info.version, SPDM_MEASUREMENTS,
@@ -1079,6 +1351,8 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		TRUE, l1l2_hash, l1l2_hash_size, signature, &signature_size);
 #endif
+	spdm_responder_stats_phase_end(spdm_context,
+				       SPDM_RESPONDER_STATS_PHASE_SIGN, stats_begin);
 	return result;
 }
 
@@ -1101,11 +1375,7 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 					  IN uintn sign_data_size)
 {
 	boolean result;
-	uint8 *cert_buffer;
-	uintn cert_buffer_size;
 	void *context;
-	uint8 *cert_chain_data;
-	uintn cert_chain_data_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 l1l2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn l1l2_buffer_size;
@@ -1127,25 +1397,7 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
-	result = spdm_get_peer_cert_chain_data(
-		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	//
-	// Get leaf cert from cert chain
-	//
-	result = x509_get_cert_from_cert_chain(cert_chain_data,
-					       cert_chain_data_size, -1,
-					       &cert_buffer, &cert_buffer_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_asym_get_public_key_from_x509(
-		spdm_context->connection_info.algorithm.base_asym_algo,
-		cert_buffer, cert_buffer_size, &context);
+	result = spdm_get_peer_public_key(spdm_context, TRUE, &context);
 	if (!result) {
 		return FALSE;
 	}
@@ -1163,8 +1415,6 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		l1l2_hash, l1l2_hash_size, sign_data, sign_data_size);
 #endif
-	spdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo,
-		       context);
 	if (!result) {
 		DEBUG((DEBUG_INFO,
 		       "!!! verify_measurement_signature - FAIL !!!\n"));
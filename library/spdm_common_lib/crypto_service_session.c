@@ -55,10 +55,11 @@ boolean spdm_calculate_th_for_exchange(
 	if (cert_chain_buffer != NULL) {
 		DEBUG((DEBUG_INFO, "th_message_ct data :\n"));
 		internal_dump_hex(cert_chain_buffer, cert_chain_buffer_size);
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			cert_chain_buffer, cert_chain_buffer_size,
-			cert_chain_buffer_hash);
+		if (!spdm_hash_cert_chain_buffer(spdm_context, cert_chain_buffer,
+						 cert_chain_buffer_size,
+						 cert_chain_buffer_hash)) {
+			return FALSE;
+		}
 		status = append_managed_buffer(&th_curr, cert_chain_buffer_hash,
 					       hash_size);
 		if (RETURN_ERROR(status)) {
@@ -115,13 +116,12 @@ boolean spdm_calculate_th_hash_for_exchange(
 	ASSERT(*th_hash_buffer_size >= hash_size);
 
 	// duplicate the th context, because we still need use original context to continue.
-	digest_context_th = spdm_hash_new (
-		spdm_context->connection_info.algorithm.base_hash_algo);
+	digest_context_th = spdm_acquire_session_hash_context (spdm_context, session_info);
 	spdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
 		session_info->session_transcript.digest_context_th, digest_context_th);
 	spdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
 		digest_context_th, th_hash_buffer);
-	spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
+	spdm_release_session_hash_context (session_info, digest_context_th);
 
 	*th_hash_buffer_size = hash_size;
 
@@ -164,12 +164,12 @@ boolean spdm_calculate_th_hmac_for_exchange_rsp(
 	}
 
 	// duplicate the th context, because we still need use original context to continue.
-	hmac_context_th = spdm_hmac_new_with_response_finished_key (secured_message_context);
+	hmac_context_th = spdm_acquire_session_hmac_context (spdm_context, session_info);
 	spdm_hmac_duplicate_with_response_finished_key (secured_message_context,
 		session_info->session_transcript.hmac_rsp_context_th, hmac_context_th);
 	spdm_hmac_final_with_response_finished_key (secured_message_context,
 		hmac_context_th, th_hmac_buffer);
-	spdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
+	spdm_release_session_hmac_context (session_info, hmac_context_th);
 
 	*th_hmac_buffer_size = hash_size;
 
@@ -233,10 +233,11 @@ boolean spdm_calculate_th_for_finish(IN void *context,
 	if (cert_chain_buffer != NULL) {
 		DEBUG((DEBUG_INFO, "th_message_ct data :\n"));
 		internal_dump_hex(cert_chain_buffer, cert_chain_buffer_size);
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			cert_chain_buffer, cert_chain_buffer_size,
-			cert_chain_buffer_hash);
+		if (!spdm_hash_cert_chain_buffer(spdm_context, cert_chain_buffer,
+						 cert_chain_buffer_size,
+						 cert_chain_buffer_hash)) {
+			return FALSE;
+		}
 		status = append_managed_buffer(&th_curr, cert_chain_buffer_hash,
 					       hash_size);
 		if (RETURN_ERROR(status)) {
@@ -262,10 +263,11 @@ boolean spdm_calculate_th_for_finish(IN void *context,
 		DEBUG((DEBUG_INFO, "th_message_cm data :\n"));
 		internal_dump_hex(mut_cert_chain_buffer,
 				  mut_cert_chain_buffer_size);
-		spdm_hash_all(
-			spdm_context->connection_info.algorithm.base_hash_algo,
-			mut_cert_chain_buffer, mut_cert_chain_buffer_size,
-			mut_cert_chain_buffer_hash);
+		if (!spdm_hash_cert_chain_buffer(spdm_context, mut_cert_chain_buffer,
+						 mut_cert_chain_buffer_size,
+						 mut_cert_chain_buffer_hash)) {
+			return FALSE;
+		}
 		status = append_managed_buffer(&th_curr, mut_cert_chain_buffer_hash,
 					       hash_size);
 		if (RETURN_ERROR(status)) {
@@ -323,13 +325,12 @@ boolean spdm_calculate_th_hash_for_finish(IN void *context,
 	ASSERT(*th_hash_buffer_size >= hash_size);
 
 	// duplicate the th context, because we still need use original context to continue.
-	digest_context_th = spdm_hash_new (
-		spdm_context->connection_info.algorithm.base_hash_algo);
+	digest_context_th = spdm_acquire_session_hash_context (spdm_context, session_info);
 	spdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
 		session_info->session_transcript.digest_context_th, digest_context_th);
 	spdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
 		digest_context_th, th_hash_buffer);
-	spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
+	spdm_release_session_hash_context (session_info, digest_context_th);
 
 	*th_hash_buffer_size = hash_size;
 
@@ -369,12 +370,12 @@ boolean spdm_calculate_th_hmac_for_finish_rsp(IN void *context,
 	ASSERT(session_info->session_transcript.hmac_rsp_context_th != NULL);
 
 	// duplicate the th context, because we still need use original context to continue.
-	hmac_context_th = spdm_hmac_new_with_response_finished_key (secured_message_context);
+	hmac_context_th = spdm_acquire_session_hmac_context (spdm_context, session_info);
 	spdm_hmac_duplicate_with_response_finished_key (secured_message_context,
 		session_info->session_transcript.hmac_rsp_context_th, hmac_context_th);
 	spdm_hmac_final_with_response_finished_key (secured_message_context,
 		hmac_context_th, th_hmac_buffer);
-	spdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
+	spdm_release_session_hmac_context (session_info, hmac_context_th);
 
 	*th_hmac_buffer_size = hash_size;
 
@@ -414,12 +415,12 @@ boolean spdm_calculate_th_hmac_for_finish_req(IN void *context,
 	ASSERT(session_info->session_transcript.hmac_req_context_th != NULL);
 
 	// duplicate the th context, because we still need use original context to continue.
-	hmac_context_th = spdm_hmac_new_with_request_finished_key (secured_message_context);
+	hmac_context_th = spdm_acquire_session_hmac_context (spdm_context, session_info);
 	spdm_hmac_duplicate_with_request_finished_key (secured_message_context,
 		session_info->session_transcript.hmac_req_context_th, hmac_context_th);
 	spdm_hmac_final_with_request_finished_key (secured_message_context,
 		hmac_context_th, th_hmac_buffer);
-	spdm_hmac_free_with_request_finished_key (secured_message_context, hmac_context_th);
+	spdm_release_session_hmac_context (session_info, hmac_context_th);
 
 	*th_hmac_buffer_size = hash_size;
 
@@ -448,6 +449,7 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 	boolean result;
 	uintn signature_size;
 	uintn hash_size;
+	uint64 stats_begin;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
@@ -487,6 +489,7 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 	internal_dump_data(hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
+	stats_begin = spdm_responder_stats_phase_begin(spdm_context);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_responder_data_sign(
 		spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
@@ -500,6 +503,8 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		TRUE, hash_data, hash_size, signature, &signature_size);
 #endif
+	spdm_responder_stats_phase_end(spdm_context,
+				       SPDM_RESPONDER_STATS_PHASE_SIGN, stats_begin);
 	if (result) {
 		DEBUG((DEBUG_INFO, "signature - "));
 		internal_dump_data(signature, signature_size);
@@ -587,12 +592,8 @@ boolean spdm_verify_key_exchange_rsp_signature(
 	uintn hash_size;
 	uint8 hash_data[MAX_HASH_SIZE];
 	boolean result;
-	uint8 *cert_chain_data;
-	uintn cert_chain_data_size;
 	uint8 *cert_chain_buffer;
 	uintn cert_chain_buffer_size;
-	uint8 *cert_buffer;
-	uintn cert_buffer_size;
 	void *context;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
@@ -635,24 +636,7 @@ boolean spdm_verify_key_exchange_rsp_signature(
 	internal_dump_data(sign_data, sign_data_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	//
-	// Get leaf cert from cert chain
-	//
-	result = spdm_get_peer_cert_chain_data(
-		spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-	if (!result) {
-		return FALSE;
-	}
-	result = x509_get_cert_from_cert_chain(cert_chain_data,
-					       cert_chain_data_size, -1,
-					       &cert_buffer, &cert_buffer_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_asym_get_public_key_from_x509(
-		spdm_context->connection_info.algorithm.base_asym_algo,
-		cert_buffer, cert_buffer_size, &context);
+	result = spdm_get_peer_public_key(spdm_context, TRUE, &context);
 	if (!result) {
 		return FALSE;
 	}
@@ -670,8 +654,6 @@ boolean spdm_verify_key_exchange_rsp_signature(
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		hash_data, hash_size, sign_data, sign_data_size);
 #endif
-	spdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo,
-		       context);
 	if (!result) {
 		DEBUG((DEBUG_INFO,
 		       "!!! verify_key_exchange_signature - FAIL !!!\n"));
@@ -939,12 +921,8 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 	boolean result;
 	uint8 *cert_chain_buffer;
 	uintn cert_chain_buffer_size;
-	uint8 *mut_cert_chain_data;
-	uintn mut_cert_chain_data_size;
 	uint8 *mut_cert_chain_buffer;
 	uintn mut_cert_chain_buffer_size;
-	uint8 *mut_cert_buffer;
-	uintn mut_cert_buffer_size;
 	void *context;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
@@ -995,26 +973,7 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 	internal_dump_data(sign_data, sign_data_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	//
-	// Get leaf cert from cert chain
-	//
-	result = spdm_get_peer_cert_chain_data(spdm_context,
-					       (void **)&mut_cert_chain_data,
-					       &mut_cert_chain_data_size);
-	if (!result) {
-		return FALSE;
-	}
-	result = x509_get_cert_from_cert_chain(mut_cert_chain_data,
-					       mut_cert_chain_data_size, -1,
-					       &mut_cert_buffer,
-					       &mut_cert_buffer_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_req_asym_get_public_key_from_x509(
-		spdm_context->connection_info.algorithm.req_base_asym_alg,
-		mut_cert_buffer, mut_cert_buffer_size, &context);
+	result = spdm_get_peer_public_key(spdm_context, FALSE, &context);
 	if (!result) {
 		return FALSE;
 	}
@@ -1032,9 +991,6 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		hash_data, hash_size, sign_data, sign_data_size);
 #endif
-	spdm_req_asym_free(
-		spdm_context->connection_info.algorithm.req_base_asym_alg,
-		context);
 	if (!result) {
 		DEBUG((DEBUG_INFO, "!!! VerifyFinishSignature - FAIL !!!\n"));
 		return FALSE;
@@ -0,0 +1,447 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_common_lib_internal.h"
+
+/**
+  This function invalidates all precomputed measurement summary hashes.
+
+  @param  measurement_cache             A pointer to the measurement cache.
+**/
+void spdm_measurement_cache_reset_summary_hash(
+	IN OUT spdm_measurement_cache_t *measurement_cache)
+{
+	uintn index;
+
+	for (index = 0; index < SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_COUNT;
+	     index++) {
+		measurement_cache->summary_hash_valid[index] = FALSE;
+	}
+}
+
+/**
+  This function returns the measurement cache used by an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return the measurement cache of the SPDM context, or the one it shares.
+**/
+spdm_measurement_cache_t *
+spdm_get_measurement_cache(IN spdm_context_t *spdm_context)
+{
+	return spdm_context->measurement_cache;
+}
+
+/**
+  Mark a device measurement block as changed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_index             The index of the measurement block that changed.
+                                       SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS
+                                       invalidates the whole measurement cache.
+**/
+void spdm_set_measurement_dirty(IN void *context, IN uint8 measurement_index)
+{
+	spdm_context_t *spdm_context;
+	spdm_measurement_cache_t *measurement_cache;
+
+	spdm_context = context;
+	measurement_cache = spdm_get_measurement_cache(spdm_context);
+
+	if (measurement_index ==
+	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
+		measurement_cache->record_valid = FALSE;
+		zero_mem(measurement_cache->dirty_bitmap,
+			 sizeof(measurement_cache->dirty_bitmap));
+		spdm_measurement_cache_reset_summary_hash(measurement_cache);
+		return;
+	}
+	if (measurement_index == 0) {
+		return;
+	}
+
+	measurement_cache->dirty_bitmap[measurement_index / 8] |=
+		(uint8)(1 << (measurement_index % 8));
+}
+
+/**
+  This function checks if any measurement index is marked dirty.
+
+  @param  measurement_cache             A pointer to the measurement cache.
+
+  @retval TRUE  at least one measurement index is dirty.
+  @retval FALSE no measurement index is dirty.
+**/
+boolean spdm_measurement_cache_is_dirty(
+	IN spdm_measurement_cache_t *measurement_cache)
+{
+	uintn index;
+
+	for (index = 0; index < sizeof(measurement_cache->dirty_bitmap);
+	     index++) {
+		if (measurement_cache->dirty_bitmap[index] != 0) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+  This function drops the cached measurement record if the negotiated measurement
+  algorithms no longer match the ones it was collected for.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_measurement_cache_check_algo(IN spdm_context_t *spdm_context)
+{
+	spdm_measurement_cache_t *measurement_cache;
+
+	measurement_cache = spdm_get_measurement_cache(spdm_context);
+	if (!measurement_cache->record_valid) {
+		return;
+	}
+	if (const_compare_mem(&measurement_cache->spdm_version,
+			      &spdm_context->connection_info.version,
+			      sizeof(spdm_version_number_t)) != 0 ||
+	    measurement_cache->measurement_spec !=
+		    spdm_context->connection_info.algorithm.measurement_spec ||
+	    measurement_cache->measurement_hash_algo !=
+		    spdm_context->connection_info.algorithm
+			    .measurement_hash_algo) {
+		measurement_cache->record_valid = FALSE;
+		spdm_measurement_cache_reset_summary_hash(measurement_cache);
+	}
+}
+
+/**
+  This function finds a measurement block in a measurement record.
+
+  @param  device_measurement_count       The count of the device measurement block.
+  @param  device_measurement            The concatenation of all device measurement blocks.
+  @param  measurement_index             The index of the measurement block.
+  @param  measurement_block_size         The size in bytes of the measurement block found.
+
+  @return the measurement block, or NULL if the index is not in the record.
+**/
+spdm_measurement_block_dmtf_t *
+spdm_measurement_cache_find_block(IN uint8 device_measurement_count,
+				  IN uint8 *device_measurement,
+				  IN uint8 measurement_index,
+				  OUT uintn *measurement_block_size)
+{
+	spdm_measurement_block_dmtf_t *cached_measurment_block;
+	uintn index;
+
+	cached_measurment_block = (void *)device_measurement;
+	for (index = 0; index < device_measurement_count; index++) {
+		*measurement_block_size =
+			sizeof(spdm_measurement_block_dmtf_t) +
+			cached_measurment_block->Measurement_block_dmtf_header
+				.dmtf_spec_measurement_value_size;
+		if (cached_measurment_block->Measurement_block_common_header
+			    .index == measurement_index) {
+			return cached_measurment_block;
+		}
+		cached_measurment_block =
+			(void *)((uintn)cached_measurment_block +
+				 *measurement_block_size);
+	}
+	return NULL;
+}
+
+/**
+  This function rebuilds the cached measurement record into new_measurement, fetching
+  only the dirty measurement blocks through spdm_measurement_collection_by_index.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  new_measurement               A pointer to a destination buffer to store the new record.
+  @param  new_measurement_size           On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the new record.
+
+  @retval TRUE  the record is rebuilt.
+  @retval FALSE the record cannot be rebuilt per index. The caller shall collect all blocks.
+**/
+boolean spdm_measurement_cache_refresh_dirty_block(
+	IN spdm_context_t *spdm_context, OUT uint8 *new_measurement,
+	IN OUT uintn *new_measurement_size)
+{
+	spdm_measurement_cache_t *measurement_cache;
+	spdm_measurement_block_dmtf_t *cached_measurment_block;
+	uint8 dirty_bitmap[sizeof(measurement_cache->dirty_bitmap)];
+	uintn measurment_block_size;
+	uintn record_size;
+	uintn block_size;
+	uintn index;
+	uint8 measurement_index;
+	return_status status;
+
+	measurement_cache = spdm_get_measurement_cache(spdm_context);
+	copy_mem(dirty_bitmap, measurement_cache->dirty_bitmap,
+		 sizeof(dirty_bitmap));
+
+	record_size = 0;
+	cached_measurment_block = (void *)measurement_cache->device_measurement;
+	for (index = 0; index < measurement_cache->device_measurement_count;
+	     index++) {
+		measurment_block_size =
+			sizeof(spdm_measurement_block_dmtf_t) +
+			cached_measurment_block->Measurement_block_dmtf_header
+				.dmtf_spec_measurement_value_size;
+		measurement_index = cached_measurment_block
+					    ->Measurement_block_common_header
+					    .index;
+		if ((dirty_bitmap[measurement_index / 8] &
+		     (1 << (measurement_index % 8))) != 0) {
+			block_size = *new_measurement_size - record_size;
+			status = spdm_measurement_collection_by_index(
+				spdm_context->connection_info.version,
+				spdm_context->connection_info.algorithm
+					.measurement_spec,
+				spdm_context->connection_info.algorithm
+					.measurement_hash_algo,
+				measurement_index,
+				new_measurement + record_size, &block_size);
+			if (RETURN_ERROR(status)) {
+				return FALSE;
+			}
+			dirty_bitmap[measurement_index / 8] &=
+				(uint8)~(1 << (measurement_index % 8));
+		} else {
+			block_size = measurment_block_size;
+			if (*new_measurement_size - record_size < block_size) {
+				return FALSE;
+			}
+			copy_mem(new_measurement + record_size,
+				 cached_measurment_block, block_size);
+		}
+		record_size += block_size;
+		cached_measurment_block =
+			(void *)((uintn)cached_measurment_block +
+				 measurment_block_size);
+	}
+
+	//
+	// A dirty index that is not in the record means the block count changed.
+	//
+	for (index = 0; index < sizeof(dirty_bitmap); index++) {
+		if (dirty_bitmap[index] != 0) {
+			return FALSE;
+		}
+	}
+
+	*new_measurement_size = record_size;
+	return TRUE;
+}
+
+/**
+  This function returns the device measurement record from the measurement cache.
+
+  The record is collected through spdm_measurement_collection on first use, or when the
+  negotiated measurement algorithms change. Measurement indexes marked dirty are collected
+  again through spdm_measurement_collection_by_index, and the whole record is collected
+  again if the device does not provide it.
+  The returned buffer is owned by the SPDM context and remains valid until the next
+  cache refresh.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  device_measurement_count       The count of the device measurement block.
+  @param  device_measurement            The pointer to the concatenation of all device measurement blocks.
+  @param  device_measurement_size        The size in bytes of all device measurement blocks.
+
+  @retval TRUE  the device measurement record is returned.
+  @retval FALSE the device measurement collection fail.
+**/
+boolean spdm_measurement_cache_get_record(IN spdm_context_t *spdm_context,
+					  OUT uint8 *device_measurement_count,
+					  OUT uint8 **device_measurement,
+					  OUT uintn *device_measurement_size)
+{
+	spdm_measurement_cache_t *measurement_cache;
+	uint8 new_measurement[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 new_measurement_count;
+	uintn new_measurement_size;
+	boolean ret;
+
+	measurement_cache = spdm_get_measurement_cache(spdm_context);
+	spdm_measurement_cache_check_algo(spdm_context);
+
+	if (!measurement_cache->record_valid ||
+	    spdm_measurement_cache_is_dirty(measurement_cache)) {
+		ret = FALSE;
+		if (measurement_cache->record_valid) {
+			new_measurement_count =
+				measurement_cache->device_measurement_count;
+			new_measurement_size = sizeof(new_measurement);
+			ret = spdm_measurement_cache_refresh_dirty_block(
+				spdm_context, new_measurement,
+				&new_measurement_size);
+		}
+		if (!ret) {
+			new_measurement_size = sizeof(new_measurement);
+			ret = spdm_measurement_collection(
+				spdm_context->connection_info.version,
+				spdm_context->connection_info.algorithm
+					.measurement_spec,
+				spdm_context->connection_info.algorithm
+					.measurement_hash_algo,
+				&new_measurement_count, new_measurement,
+				&new_measurement_size);
+			if (!ret) {
+				return FALSE;
+			}
+		}
+		ASSERT(new_measurement_count <=
+		       MAX_SPDM_MEASUREMENT_BLOCK_COUNT);
+		ASSERT(new_measurement_size <= MAX_SPDM_MEASUREMENT_RECORD_SIZE);
+
+		//
+		// The summary hashes survive a dirty mark if the record did not change.
+		//
+		if (!measurement_cache->record_valid ||
+		    measurement_cache->device_measurement_count !=
+			    new_measurement_count ||
+		    measurement_cache->device_measurement_size !=
+			    new_measurement_size ||
+		    const_compare_mem(measurement_cache->device_measurement,
+				      new_measurement,
+				      new_measurement_size) != 0) {
+			copy_mem(measurement_cache->device_measurement,
+				 new_measurement, new_measurement_size);
+			measurement_cache->device_measurement_count =
+				new_measurement_count;
+			measurement_cache->device_measurement_size =
+				new_measurement_size;
+			spdm_measurement_cache_reset_summary_hash(
+				measurement_cache);
+		}
+
+		copy_mem(&measurement_cache->spdm_version,
+			 &spdm_context->connection_info.version,
+			 sizeof(spdm_version_number_t));
+		measurement_cache->measurement_spec =
+			spdm_context->connection_info.algorithm.measurement_spec;
+		measurement_cache->measurement_hash_algo =
+			spdm_context->connection_info.algorithm
+				.measurement_hash_algo;
+		zero_mem(measurement_cache->dirty_bitmap,
+			 sizeof(measurement_cache->dirty_bitmap));
+		measurement_cache->record_valid = TRUE;
+	}
+
+	*device_measurement_count = measurement_cache->device_measurement_count;
+	*device_measurement = measurement_cache->device_measurement;
+	*device_measurement_size = measurement_cache->device_measurement_size;
+	return TRUE;
+}
+
+/**
+  This function returns the count of the device measurement blocks.
+
+  If the measurement record is not cached, the count is queried through
+  spdm_measurement_collection_count, and the whole record is collected if the device
+  does not provide it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  device_measurement_count       The count of the device measurement block.
+
+  @retval TRUE  the count of the device measurement block is returned.
+  @retval FALSE the device measurement collection fail.
+**/
+boolean spdm_measurement_cache_get_count(IN spdm_context_t *spdm_context,
+					 OUT uint8 *device_measurement_count)
+{
+	uint8 *device_measurement;
+	uintn device_measurement_size;
+	return_status status;
+
+	spdm_measurement_cache_check_algo(spdm_context);
+
+	if (!spdm_get_measurement_cache(spdm_context)->record_valid) {
+		status = spdm_measurement_collection_count(
+			spdm_context->connection_info.version,
+			spdm_context->connection_info.algorithm.measurement_spec,
+			spdm_context->connection_info.algorithm
+				.measurement_hash_algo,
+			device_measurement_count);
+		if (status != RETURN_UNSUPPORTED) {
+			return !RETURN_ERROR(status);
+		}
+	}
+
+	return spdm_measurement_cache_get_record(spdm_context,
+						 device_measurement_count,
+						 &device_measurement,
+						 &device_measurement_size);
+}
+
+/**
+  This function copies one device measurement block.
+
+  If the measurement record is not cached, only the requested block is collected through
+  spdm_measurement_collection_by_index, and the whole record is collected if the device
+  does not provide it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_index             The index of the measurement block (1 ~ 0xFE).
+  @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+  @param  measurement_block_size         On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the measurement block.
+
+  @retval RETURN_SUCCESS               The measurement block is returned.
+  @retval RETURN_NOT_FOUND             The device has no measurement block with this index.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the measurement block.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+return_status spdm_measurement_cache_get_block(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_index,
+	OUT void *measurement_block, IN OUT uintn *measurement_block_size)
+{
+	spdm_measurement_block_dmtf_t *cached_measurment_block;
+	uintn measurment_block_size;
+	uint8 *device_measurement;
+	uint8 device_measurement_count;
+	uintn device_measurement_size;
+	return_status status;
+	boolean ret;
+
+	spdm_measurement_cache_check_algo(spdm_context);
+
+	if (!spdm_get_measurement_cache(spdm_context)->record_valid) {
+		status = spdm_measurement_collection_by_index(
+			spdm_context->connection_info.version,
+			spdm_context->connection_info.algorithm.measurement_spec,
+			spdm_context->connection_info.algorithm
+				.measurement_hash_algo,
+			measurement_index, measurement_block,
+			measurement_block_size);
+		if (status != RETURN_UNSUPPORTED) {
+			return status;
+		}
+	}
+
+	ret = spdm_measurement_cache_get_record(spdm_context,
+						&device_measurement_count,
+						&device_measurement,
+						&device_measurement_size);
+	if (!ret) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	cached_measurment_block = spdm_measurement_cache_find_block(
+		device_measurement_count, device_measurement,
+		measurement_index, &measurment_block_size);
+	if (cached_measurment_block == NULL) {
+		return RETURN_NOT_FOUND;
+	}
+	if (*measurement_block_size < measurment_block_size) {
+		*measurement_block_size = measurment_block_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem(measurement_block, cached_measurment_block,
+		 measurment_block_size);
+	*measurement_block_size = measurment_block_size;
+	return RETURN_SUCCESS;
+}
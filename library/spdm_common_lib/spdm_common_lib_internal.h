@@ -33,6 +33,34 @@ typedef struct {
 	uint16 key_schedule;
 } spdm_device_algorithm_t;
 
+//
+// Digest of a certificate chain buffer, keyed by the base hash algorithm used to compute it.
+// The slot is implied by where the entry is stored. Only a buffer registered through
+// spdm_set_data or GET_CERTIFICATE is cached; cert_chain_buffer is NULL otherwise.
+//
+typedef struct {
+	void *cert_chain_buffer;
+	uintn cert_chain_buffer_size;
+	boolean digest_valid;
+	uint32 base_hash_algo;
+	uint8 digest[MAX_HASH_SIZE];
+} spdm_cert_chain_digest_t;
+
+//
+// Public key imported from the leaf certificate of the peer certificate chain, owned by the
+// SPDM context. It is keyed by the certificate chain buffer it was imported from, the role
+// (is_requester) and the asymmetric algorithm used to import it. It is only reused while the
+// certificate chain buffer is registered in its digest cache entry, and is released when the
+// peer certificate chain changes, by spdm_reset_context or by spdm_deinit_context.
+//
+typedef struct {
+	void *context;
+	void *cert_chain_buffer;
+	uintn cert_chain_buffer_size;
+	boolean is_requester;
+	uint32 asym_algo;
+} spdm_peer_public_key_cache_t;
+
 typedef struct {
 	//
 	// Local device info
@@ -46,6 +74,7 @@ typedef struct {
 	//
 	void *local_cert_chain_provision[MAX_SPDM_SLOT_COUNT];
 	uintn local_cert_chain_provision_size[MAX_SPDM_SLOT_COUNT];
+	spdm_cert_chain_digest_t local_cert_chain_digest[MAX_SPDM_SLOT_COUNT];
 	uint8 slot_count;
 	// My provisioned certificate (for slot_id - 0xFF, default 0)
 	uint8 provisioned_slot_id;
@@ -61,8 +90,15 @@ typedef struct {
 	//
 	void *peer_cert_chain_provision;
 	uintn peer_cert_chain_provision_size;
+	spdm_cert_chain_digest_t peer_cert_chain_digest;
 	// Peer Cert verify
 	spdm_verify_spdm_cert_chain_func verify_peer_spdm_cert_chain;
+	// Verified certificate link cache, NULL to verify every link
+	void *cert_link_cache;
+	// Pre-generated DHE key pairs, NULL to generate them in KEY_EXCHANGE
+	void *dhe_key_pool;
+	// Outstanding requests allowed by spdm_get_measurement_batch, 1 to disable pipelining
+	uint8 request_pipeline_depth;
 	//
 	// PSK provision locally
 	//
@@ -82,6 +118,40 @@ typedef struct {
 	uint8 mut_auth_requested;
 } spdm_local_context_t;
 
+//
+// Measurement summary hash slots in the measurement cache.
+//
+#define SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_TCB 0
+#define SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_ALL 1
+#define SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_COUNT 2
+
+typedef struct {
+	//
+	// Serialized measurement blocks, as returned by spdm_measurement_collection.
+	// The record is keyed by the negotiated version, measurement specification
+	// and measurement hash algorithm it was collected for.
+	//
+	boolean record_valid;
+	spdm_version_number_t spdm_version;
+	uint8 measurement_spec;
+	uint32 measurement_hash_algo;
+	uint8 device_measurement_count;
+	uintn device_measurement_size;
+	uint8 device_measurement[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	//
+	// One bit per measurement index (1 ~ 0xFE), set by spdm_set_measurement_dirty.
+	//
+	uint8 dirty_bitmap[256 / 8];
+	//
+	// Precomputed measurement summary hash for TCB_COMPONENT and ALL_MEASUREMENTS,
+	// keyed by the base hash algorithm used to compute it.
+	//
+	boolean summary_hash_valid[SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_COUNT];
+	uint32 summary_hash_algo[SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_COUNT];
+	uint8 summary_hash[SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_COUNT]
+			  [MAX_HASH_SIZE];
+} spdm_measurement_cache_t;
+
 typedef struct {
 	//
 	// Connection State
@@ -99,6 +169,8 @@ typedef struct {
 	//
 	uint8 peer_used_cert_chain_buffer[MAX_SPDM_CERT_CHAIN_SIZE];
 	uintn peer_used_cert_chain_buffer_size;
+	spdm_cert_chain_digest_t peer_used_cert_chain_digest;
+	spdm_peer_public_key_cache_t peer_public_key_cache;
 	//
 	// Local Used CertificateChain (for responder, or requester in mut auth)
 	//
@@ -236,6 +308,39 @@ typedef struct {
 #endif
 } spdm_session_transcript_t;
 
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+//
+// Hash contexts of a session: TH, TH backup, L1L2 and a TH copy to finalize.
+//
+#define SPDM_SESSION_HASH_CONTEXT_COUNT 4
+//
+// HMAC contexts of a session: TH with the response and the request finished_key,
+// their backups and a TH copy to finalize.
+//
+#define SPDM_SESSION_HMAC_CONTEXT_COUNT 5
+
+//
+// The hash and HMAC contexts of a session transcript.
+//
+// A context is created the first time a session of the slot needs it, and kept
+// when the session ends, so that the next sessions in the slot do not allocate.
+// If the crypto library can initialize a hash context in caller memory, the
+// hash contexts are carved from hash_context_storage instead of allocated.
+// The contexts are recreated if the negotiated hash algorithm changes, and
+// released by spdm_deinit_context.
+//
+typedef struct {
+	uint32 base_hash_algo;
+	// The stride of the hash contexts in hash_context_storage, 0 if they are allocated.
+	uintn hash_context_size;
+	uint8 hash_context_in_use;
+	uint8 hmac_context_in_use;
+	void *hash_context[SPDM_SESSION_HASH_CONTEXT_COUNT];
+	void *hmac_context[SPDM_SESSION_HMAC_CONTEXT_COUNT];
+	uint64 hash_context_storage[SPDM_SESSION_HASH_CONTEXT_STORAGE_SIZE / sizeof(uint64)];
+} spdm_session_context_arena_t;
+#endif
+
 typedef struct {
 	uint32 session_id;
 	boolean use_psk;
@@ -243,6 +348,16 @@ typedef struct {
 	uint8 end_session_attributes;
 	spdm_session_transcript_t session_transcript;
 	void *secured_message_context;
+	//
+	// Links of the free list of the session info pool, only valid while session_id is
+	// INVALID_SESSION_ID. Not cleared by spdm_session_info_init.
+	//
+	uintn prev_free_index;
+	uintn next_free_index;
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	// Not cleared by spdm_session_info_init, the next session reuses the contexts.
+	spdm_session_context_arena_t context_arena;
+#endif
 } spdm_session_info_t;
 
 #define MAX_ENCAP_REQUEST_OP_CODE_SEQUENCE_COUNT 3
@@ -263,6 +378,8 @@ typedef struct {
 
 #define spdm_context_struct_VERSION 0x1
 
+#define SPDM_SESSION_INDEX_EMPTY ((uintn)-1)
+
 typedef struct {
 	uint32 version;
 	//
@@ -275,6 +392,22 @@ typedef struct {
 	//
 	spdm_transport_encode_message_func transport_encode_message;
 	spdm_transport_decode_message_func transport_decode_message;
+	//
+	// Optional in-place transport layer functions, and the room they need
+	// in front of and behind a message.
+	//
+	spdm_transport_encode_message_in_place_func
+		transport_encode_message_in_place;
+	spdm_transport_decode_message_in_place_func
+		transport_decode_message_in_place;
+	uintn transport_header_size;
+	uintn transport_tail_size;
+	//
+	// Optional timer functions to pace the retries (requester) and to time the
+	// requests for the statistics (responder)
+	//
+	spdm_sleep_func sleep;
+	spdm_get_time_us_func get_time_us;
 
 	//
 	// command status
@@ -317,12 +450,28 @@ typedef struct {
 	uintn spdm_connection_state_callback
 		[MAX_SPDM_CONNECTION_STATE_CALLBACK_NUM];
 
-	spdm_local_context_t local_context;
+	//
+	// Local provisioning, placed after the SPDM context in the same buffer, or shared
+	// by all connections of a multi-peer responder.
+	//
+	spdm_local_context_t *local_context;
 
 	spdm_connection_info_t connection_info;
 	spdm_transcript_t transcript;
 
-	spdm_session_info_t session_info[MAX_SPDM_SESSION_COUNT];
+	//
+	// Session info pool of max_session_count entries, placed after the SPDM context
+	// in the same buffer, and an open-addressed hash index of the pool keyed by
+	// session ID. Each index slot holds a pool index or SPDM_SESSION_INDEX_EMPTY.
+	// The free entries of the pool are chained from first_free_session_index, most
+	// recently freed first, and the local half of a session ID is 0xFFFF minus the
+	// pool index of the entry it gets.
+	//
+	uintn max_session_count;
+	spdm_session_info_t *session_info;
+	uintn session_index_table_size;
+	uintn *session_index_table;
+	uintn first_free_session_index;
 	//
 	// Cache lastest session ID for HANDSHAKE_IN_THE_CLEAR
 	//
@@ -339,9 +488,15 @@ typedef struct {
 	uintn cache_spdm_request_size;
 	uint8 current_token;
 	//
-	// Register for the retry times when receive "BUSY" Error response (requester only)
+	// Retry policy when receive "BUSY" Error response (requester only), and the
+	// time stamp after which the current operation stops retrying, 0 for none.
+	//
+	spdm_retry_policy_t retry_policy;
+	uint64 retry_deadline;
+	//
+	// Time spent per phase, in the transport and per crypto operation (requester only)
 	//
-	uint8 retry_times;
+	spdm_requester_metrics_t requester_metrics;
 
 	//
 	// Opaque context data for use by application
@@ -352,6 +507,38 @@ typedef struct {
 	// Register for the last KEY_UPDATE token and operation (responder only)
 	//
 	uint8 last_update_request[4];
+
+	//
+	// Measurement record and summary hash cache (responder only), placed after the
+	// SPDM context in the same buffer, or shared by all connections of a multi-peer responder.
+	//
+	spdm_measurement_cache_t *measurement_cache;
+
+	//
+	// Owning multi-peer responder context, NULL for a standalone context (responder only)
+	//
+	void *multi_peer_context;
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+	//
+	// Request statistics, timing of the request being processed and the
+	// optional sampling function called every responder_stats_sample_interval requests (responder only)
+	//
+	spdm_responder_stats_t responder_stats;
+	spdm_responder_stats_sample_t responder_stats_sample;
+	spdm_responder_stats_sample_func responder_stats_sample_func;
+	uint32 responder_stats_sample_interval;
+	uint32 responder_stats_sample_count;
+#endif
+
+#if LIBSPDM_TRACE_SUPPORT
+	//
+	// Binary trace of the sent and received messages, NULL if not registered
+	//
+	spdm_trace_buffer_header_t *trace_buffer;
+	// SPDM_TRACE_BUFFER_FLAG_* bits of the registered trace buffer
+	uint32 trace_buffer_flags;
+#endif
 } spdm_context_t;
 
 /**
@@ -448,6 +635,142 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 			    IN spdm_session_info_t *session_info,
 			    IN uint32 session_id, IN boolean use_psk);
 
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+  Take a hash context of the session from its context arena.
+
+  The hash context must be initialized with spdm_hash_init or spdm_hash_duplicate.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context.
+
+  @return the hash context, or NULL if no hash context is available.
+**/
+void *spdm_acquire_session_hash_context(IN spdm_context_t *spdm_context,
+					IN spdm_session_info_t *session_info);
+
+/**
+  Give a hash context back to the context arena of the session.
+
+  @param  session_info                  A pointer to the SPDM session context.
+  @param  hash_context                  The hash context from spdm_acquire_session_hash_context.
+**/
+void spdm_release_session_hash_context(IN spdm_session_info_t *session_info,
+				       IN void *hash_context);
+
+/**
+  Take an HMAC context of the session from its context arena.
+
+  The HMAC context must be initialized with a finished_key or duplicated.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context.
+
+  @return the HMAC context, or NULL if no HMAC context is available.
+**/
+void *spdm_acquire_session_hmac_context(IN spdm_context_t *spdm_context,
+					IN spdm_session_info_t *session_info);
+
+/**
+  Give an HMAC context back to the context arena of the session.
+
+  @param  session_info                  A pointer to the SPDM session context.
+  @param  hmac_context                  The HMAC context from spdm_acquire_session_hmac_context.
+**/
+void spdm_release_session_hmac_context(IN spdm_session_info_t *session_info,
+				       IN void *hmac_context);
+
+/**
+  Free the hash and HMAC contexts held by the context arena of a session.
+
+  @param  session_info                  A pointer to the SPDM session context.
+**/
+void spdm_free_session_context_arena(IN spdm_session_info_t *session_info);
+#endif
+
+/**
+  Return the number of slots in the session index table for a session count.
+
+  @param  max_session_count             The number of entries in the session info pool.
+
+  @return the number of slots in the session index table, a power of two.
+**/
+uintn spdm_get_session_index_table_size(IN uintn max_session_count);
+
+/**
+  Return the size in bytes of an SPDM context with a given session capacity, which uses
+  the local provisioning and the measurement cache of another SPDM context.
+
+  @param  max_session_count             The maximum number of sessions at the same time.
+
+  @return the size in bytes of the SPDM context.
+**/
+uintn spdm_get_connection_context_size(IN uintn max_session_count);
+
+/**
+  Initialize an SPDM context with a given session capacity, which uses the local provisioning
+  and the measurement cache of another SPDM context instead of its own.
+
+  The size in bytes of the spdm_context can be returned by spdm_get_connection_context_size,
+  or by spdm_get_context_size_ex if provisioning_context is NULL.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_session_count             The maximum number of sessions at the same time.
+  @param  provisioning_context          A pointer to the SPDM context holding the local provisioning.
+
+  @retval RETURN_SUCCESS               The SPDM context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The session count is out of range.
+**/
+return_status spdm_init_connection_context(IN void *context,
+					   IN uintn max_session_count,
+					   IN void *provisioning_context OPTIONAL);
+
+/**
+  Return the home slot of a session ID in the session index table.
+
+  @param  session_id                    The SPDM session ID.
+  @param  table_size                    The number of slots in the table, a power of two.
+
+  @return the home slot of the session ID.
+**/
+uintn spdm_session_index_hash(IN uint32 session_id, IN uintn table_size);
+
+/**
+  Return the slot of a session ID in the session index table.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The SPDM session ID.
+
+  @return the slot holding the session ID, or SPDM_SESSION_INDEX_EMPTY if not found.
+**/
+uintn spdm_find_session_index_slot(IN spdm_context_t *spdm_context,
+				   IN uint32 session_id);
+
+/**
+  Add a session info pool entry to the session index table, keyed by its session ID.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  pool_index                    The index of the entry in the session info pool.
+**/
+void spdm_insert_session_index(IN spdm_context_t *spdm_context,
+			       IN uintn pool_index);
+
+/**
+  Remove a session info pool entry from the session index table.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  pool_index                    The index of the entry in the session info pool.
+**/
+void spdm_remove_session_index(IN spdm_context_t *spdm_context,
+			       IN uintn pool_index);
+
+/**
+  Chain all session info pool entries without a session ID in the free list, in pool order.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_init_session_free_list(IN spdm_context_t *spdm_context);
+
 /**
   This function allocates half of session ID for a requester.
 
@@ -570,6 +893,58 @@ boolean spdm_calculate_l1l2_hash(IN void *context, IN void *session_info,
 boolean spdm_generate_cert_chain_hash(IN spdm_context_t *spdm_context,
 				      IN uintn slot_id, OUT uint8 *hash);
 
+/**
+  This function returns the digest cache entry of a certificate chain buffer held by the SPDM context.
+
+  The local provisioned certificate chain of each slot, the peer provisioned certificate chain
+  and the peer used certificate chain buffer each own one entry.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+
+  @return the digest cache entry, or NULL if the buffer is not registered in the SPDM context.
+**/
+spdm_cert_chain_digest_t *
+spdm_get_cert_chain_digest_entry(IN spdm_context_t *spdm_context,
+				 IN void *cert_chain_buffer,
+				 IN uintn cert_chain_buffer_size);
+
+/**
+  This function registers a certificate chain buffer in its digest cache entry, replacing the previous one.
+
+  The digest is computed with the negotiated base hash algorithm, or with the local base hash
+  algorithm if only one is configured before negotiation. Otherwise it is computed on first use.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+  @param  digest_entry                   The digest cache entry of the certificate chain buffer.
+**/
+void spdm_register_cert_chain_digest(IN spdm_context_t *spdm_context,
+				     IN void *cert_chain_buffer OPTIONAL,
+				     IN uintn cert_chain_buffer_size,
+				     OUT spdm_cert_chain_digest_t *digest_entry);
+
+/**
+  This function returns the hash of a certificate chain buffer with the negotiated base hash algorithm.
+
+  If the buffer is held by the SPDM context, the hash is read from the digest cache
+  and only computed on a cache miss.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+  @param  hash                         The buffer to store the certificate chain hash.
+
+  @retval TRUE  certificate chain hash is returned.
+  @retval FALSE certificate chain hash is not returned.
+**/
+boolean spdm_hash_cert_chain_buffer(IN spdm_context_t *spdm_context,
+				    IN void *cert_chain_buffer,
+				    IN uintn cert_chain_buffer_size,
+				    OUT uint8 *hash);
+
 /**
   This function verifies the digest.
 
@@ -630,6 +1005,32 @@ spdm_verify_certificate_chain_hash(IN spdm_context_t *spdm_context,
 				   IN void *certificate_chain_hash,
 				   IN uintn certificate_chain_hash_size);
 
+/**
+  This function releases the cached public key of the peer certificate chain.
+
+  It must be called whenever the peer certificate chain buffer changes.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_free_peer_public_key(IN spdm_context_t *spdm_context);
+
+/**
+  This function retrieves the public key of the leaf certificate in the peer certificate chain.
+
+  The key is cached in the SPDM context and reused while the peer certificate chain buffer
+  stays registered, so the leaf certificate is only decoded once per certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_requester                  Indicate of the key retrieval for a requester or a responder.
+  @param  context                      Pointer to the asymmetric context which contain the retrieved public key component.
+                                       The context is owned by the SPDM context and must not be freed by the caller.
+
+  @retval TRUE  public key was retrieved successfully.
+  @retval FALSE Fail to retrieve the public key.
+**/
+boolean spdm_get_peer_public_key(IN spdm_context_t *spdm_context,
+				 IN boolean is_requester, OUT void **context);
+
 /**
   This function verifies the challenge signature based upon m1m2.
 
@@ -678,6 +1079,77 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 				       IN uint8 measurement_summary_hash_type,
 				       OUT uint8 *measurement_summary_hash);
 
+/**
+  This function returns the measurement cache used by an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return the measurement cache of the SPDM context, or the one it shares.
+**/
+spdm_measurement_cache_t *
+spdm_get_measurement_cache(IN spdm_context_t *spdm_context);
+
+/**
+  This function returns the device measurement record from the measurement cache.
+
+  The record is collected through spdm_measurement_collection on first use, or when the
+  negotiated measurement algorithms change. Measurement indexes marked dirty are collected
+  again through spdm_measurement_collection_by_index, and the whole record is collected
+  again if the device does not provide it.
+  The returned buffer is owned by the SPDM context and remains valid until the next
+  cache refresh.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  device_measurement_count       The count of the device measurement block.
+  @param  device_measurement            The pointer to the concatenation of all device measurement blocks.
+  @param  device_measurement_size        The size in bytes of all device measurement blocks.
+
+  @retval TRUE  the device measurement record is returned.
+  @retval FALSE the device measurement collection fail.
+**/
+boolean spdm_measurement_cache_get_record(IN spdm_context_t *spdm_context,
+					  OUT uint8 *device_measurement_count,
+					  OUT uint8 **device_measurement,
+					  OUT uintn *device_measurement_size);
+
+/**
+  This function returns the count of the device measurement blocks.
+
+  If the measurement record is not cached, the count is queried through
+  spdm_measurement_collection_count, and the whole record is collected if the device
+  does not provide it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  device_measurement_count       The count of the device measurement block.
+
+  @retval TRUE  the count of the device measurement block is returned.
+  @retval FALSE the device measurement collection fail.
+**/
+boolean spdm_measurement_cache_get_count(IN spdm_context_t *spdm_context,
+					 OUT uint8 *device_measurement_count);
+
+/**
+  This function copies one device measurement block.
+
+  If the measurement record is not cached, only the requested block is collected through
+  spdm_measurement_collection_by_index, and the whole record is collected if the device
+  does not provide it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_index             The index of the measurement block (1 ~ 0xFE).
+  @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+  @param  measurement_block_size         On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the measurement block.
+
+  @retval RETURN_SUCCESS               The measurement block is returned.
+  @retval RETURN_NOT_FOUND             The device has no measurement block with this index.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the measurement block.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+return_status spdm_measurement_cache_get_block(
+	IN spdm_context_t *spdm_context, IN uint8 measurement_index,
+	OUT void *measurement_block, IN OUT uintn *measurement_block_size);
+
 /**
   This function generates the measurement signature to response message based upon l1l2.
   If session_info is NULL, this function will use M cache of SPDM context,
@@ -1021,4 +1493,94 @@ spdm_process_opaque_data_supported_version_data(IN spdm_context_t *spdm_context,
   @return the SPDMversion of the version number struct.
 **/
 uint8 spdm_get_version_from_version_number(IN spdm_version_number_t ver);
+/**
+  Return the time stamp at the start of an operation counted in the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The time stamp to pass to spdm_metrics_phase_end or spdm_metrics_crypto_end,
+          0 if no clock is registered.
+**/
+uint64 spdm_metrics_begin(IN spdm_context_t *spdm_context);
+
+/**
+  Count an operation in a counter of the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  counter                       The counter of the operation.
+  @param  begin                         The time stamp returned by spdm_metrics_begin.
+**/
+void spdm_metrics_end(IN spdm_context_t *spdm_context,
+		      IN OUT spdm_metrics_counter_t *counter, IN uint64 begin);
+
+/**
+  Count a phase of the requester in the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase.
+  @param  begin                         The time stamp returned by spdm_metrics_begin.
+**/
+void spdm_metrics_phase_end(IN spdm_context_t *spdm_context,
+			    IN spdm_requester_phase_t phase, IN uint64 begin);
+
+/**
+  Count a crypto operation in the requester metrics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  op                            The crypto operation.
+  @param  begin                         The time stamp returned by spdm_metrics_begin.
+**/
+void spdm_metrics_crypto_end(IN spdm_context_t *spdm_context,
+			     IN spdm_crypto_op_t op, IN uint64 begin);
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+/**
+  Start timing a phase of the request processed by the responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The time stamp to pass to spdm_responder_stats_phase_end, 0 if no clock is registered.
+**/
+uint64 spdm_responder_stats_phase_begin(IN spdm_context_t *spdm_context);
+
+/**
+  Add the time elapsed since spdm_responder_stats_phase_begin to a phase of the
+  request processed by the responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase being timed.
+  @param  begin                         The time stamp returned by spdm_responder_stats_phase_begin.
+**/
+void spdm_responder_stats_phase_end(IN spdm_context_t *spdm_context,
+				    IN spdm_responder_stats_phase_t phase,
+				    IN uint64 begin);
+#else
+#define spdm_responder_stats_phase_begin(spdm_context) 0
+#define spdm_responder_stats_phase_end(spdm_context, phase, begin) ((void)(begin))
+#endif
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+  Record a message in the trace buffer of a context.
+
+  If no trace buffer is registered, the message is dumped in hex at DEBUG_INFO.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  direction                     If the message is sent or received.
+  @param  session_id                    The session ID of the message, NULL outside of a session.
+  @param  is_app_message                If the message is an application message.
+  @param  message                       A pointer to the message.
+  @param  message_size                  The size in bytes of the message.
+**/
+void spdm_trace_message(IN spdm_context_t *spdm_context,
+			IN spdm_trace_direction_t direction,
+			IN uint32 *session_id OPTIONAL,
+			IN boolean is_app_message, IN void *message,
+			IN uintn message_size);
+#else
+#define spdm_trace_message(spdm_context, direction, session_id,                \
+			   is_app_message, message, message_size)              \
+	internal_dump_hex((uint8 *)(message), message_size)
+#endif
+
 #endif
@@ -0,0 +1,180 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_common_lib_internal.h"
+
+#if LIBSPDM_TRACE_SUPPORT
+
+/**
+  Return the size of a trace buffer that holds a number of events.
+
+  @param  event_count                   The number of events, a power of two.
+
+  @return The size in bytes of the trace buffer.
+**/
+uintn spdm_get_trace_buffer_size(IN uintn event_count)
+{
+	ASSERT((event_count & (event_count - 1)) == 0);
+	return sizeof(spdm_trace_buffer_header_t) +
+	       event_count * sizeof(spdm_trace_event_t);
+}
+
+/**
+  Register a buffer to record the messages sent and received by a context.
+
+  Each message is recorded as a fixed size spdm_trace_event_t, instead of being dumped
+  in hex at DEBUG_INFO. The buffer holds as many events as fit, rounded down to a power
+  of two, and the oldest events are overwritten. The buffer can be saved as is and
+  decoded offline.
+
+  The events are written by the thread processing the context, without a lock or a
+  memory barrier. The buffer must not be read while that thread may write to it: read
+  it from the same thread between two messages, or after tracing is stopped by
+  registering a NULL trace buffer.
+
+  The leading bytes of a message are only copied into the event if
+  SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD is set, and never for a message in a session or an
+  application message, because those are recorded after decryption.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  trace_buffer                  The trace buffer, 8 byte aligned, or NULL to stop tracing.
+  @param  trace_buffer_size             The size in bytes of the trace buffer.
+  @param  flags                         SPDM_TRACE_BUFFER_FLAG_* bits.
+
+  @retval RETURN_SUCCESS                The trace buffer is registered.
+  @retval RETURN_BUFFER_TOO_SMALL       The trace buffer cannot hold one event.
+**/
+return_status spdm_register_trace_buffer(IN void *context,
+					 IN void *trace_buffer OPTIONAL,
+					 IN uintn trace_buffer_size,
+					 IN uint32 flags)
+{
+	spdm_context_t *spdm_context;
+	spdm_trace_buffer_header_t *header;
+	spdm_trace_event_t *event;
+	uintn event_count;
+	uintn index;
+
+	spdm_context = context;
+
+	if (trace_buffer == NULL) {
+		spdm_context->trace_buffer = NULL;
+		spdm_context->trace_buffer_flags = 0;
+		return RETURN_SUCCESS;
+	}
+	ASSERT(((uintn)trace_buffer & (sizeof(uint64) - 1)) == 0);
+
+	if (trace_buffer_size < spdm_get_trace_buffer_size(1)) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	event_count = (trace_buffer_size - sizeof(spdm_trace_buffer_header_t)) /
+		      sizeof(spdm_trace_event_t);
+	if (event_count > MAX_UINT32) {
+		event_count = (uintn)MAX_UINT32;
+	}
+	while ((event_count & (event_count - 1)) != 0) {
+		event_count &= event_count - 1;
+	}
+
+	header = trace_buffer;
+	header->signature = SPDM_TRACE_BUFFER_SIGNATURE;
+	header->event_size = (uint16)sizeof(spdm_trace_event_t);
+	header->payload_size = SPDM_TRACE_PAYLOAD_SIZE;
+	header->event_count = (uint32)event_count;
+	header->reserved = 0;
+	header->next_sequence = 0;
+	event = (spdm_trace_event_t *)(header + 1);
+	for (index = 0; index < event_count; index++) {
+		event[index].sequence = SPDM_TRACE_INVALID_SEQUENCE;
+	}
+
+	spdm_context->trace_buffer = header;
+	spdm_context->trace_buffer_flags = flags;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Record a message in the trace buffer of a context.
+
+  If no trace buffer is registered, the message is dumped in hex at DEBUG_INFO.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  direction                     If the message is sent or received.
+  @param  session_id                    The session ID of the message, NULL outside of a session.
+  @param  is_app_message                If the message is an application message.
+  @param  message                       A pointer to the message.
+  @param  message_size                  The size in bytes of the message.
+**/
+void spdm_trace_message(IN spdm_context_t *spdm_context,
+			IN spdm_trace_direction_t direction,
+			IN uint32 *session_id OPTIONAL,
+			IN boolean is_app_message, IN void *message,
+			IN uintn message_size)
+{
+	spdm_trace_buffer_header_t *header;
+	spdm_trace_event_t *event;
+	spdm_message_header_t *spdm_header;
+	uint64 sequence;
+
+	header = spdm_context->trace_buffer;
+	if (header == NULL) {
+		internal_dump_hex(message, message_size);
+		return;
+	}
+
+	sequence = header->next_sequence++;
+	event = (spdm_trace_event_t *)(header + 1) +
+		(uintn)(sequence & (header->event_count - 1));
+
+	//
+	// Invalidate the slot first, so that a buffer saved while the event is half
+	// written, such as in a crash dump, does not show it as the old event.
+	// This does not make concurrent reads safe, see spdm_register_trace_buffer.
+	//
+	event->sequence = SPDM_TRACE_INVALID_SEQUENCE;
+	event->timestamp_us = (spdm_context->get_time_us != NULL) ?
+				      spdm_context->get_time_us(spdm_context) :
+				      0;
+	event->session_id =
+		(session_id != NULL) ? *session_id : INVALID_SESSION_ID;
+	event->message_size = (uint32)message_size;
+	event->direction = (uint8)direction;
+	if (is_app_message || message_size < sizeof(spdm_message_header_t)) {
+		event->flags = is_app_message ?
+				       SPDM_TRACE_EVENT_FLAG_APP_MESSAGE :
+				       0;
+		event->spdm_version = 0;
+		event->request_response_code = 0;
+		event->param1 = 0;
+		event->param2 = 0;
+	} else {
+		spdm_header = message;
+		event->flags = 0;
+		event->spdm_version = spdm_header->spdm_version;
+		event->request_response_code =
+			spdm_header->request_response_code;
+		event->param1 = spdm_header->param1;
+		event->param2 = spdm_header->param2;
+	}
+	//
+	// A message in a session or an application message is traced after decryption,
+	// so its bytes are never kept in the buffer.
+	//
+	if (((spdm_context->trace_buffer_flags &
+	      SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD) == 0) ||
+	    (session_id != NULL) || is_app_message) {
+		event->payload_size = 0;
+	} else {
+		event->payload_size =
+			(uint16)((message_size < SPDM_TRACE_PAYLOAD_SIZE) ?
+					 message_size :
+					 SPDM_TRACE_PAYLOAD_SIZE);
+		copy_mem(event->payload, message, event->payload_size);
+	}
+	event->sequence = sequence;
+}
+
+#endif
@@ -0,0 +1,521 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <library/spdm_crypt_lib.h>
+
+//
+// Size of a date_time object returned by x509_get_validity.
+//
+#define SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE 64
+
+typedef struct {
+	boolean valid;
+	uint32 base_hash_algo;
+	uint8 cert_hash[MAX_HASH_SIZE];
+	uint8 ca_cert_hash[MAX_HASH_SIZE];
+	//
+	// The earlier notAfter of both certificates.
+	//
+	uint8 not_after[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	//
+	// Value of use_counter when the link was last found or inserted.
+	//
+	uint64 last_use;
+} spdm_cert_link_cache_entry_t;
+
+typedef struct {
+	uintn entry_count;
+	uint64 use_counter;
+	uint64 hit_count;
+	uint64 miss_count;
+	spdm_cert_link_cache_lock_func acquire_lock;
+	spdm_cert_link_cache_lock_func release_lock;
+	void *lock_context;
+	spdm_cert_link_cache_get_time_func get_time;
+	//spdm_cert_link_cache_entry_t entry[entry_count];
+} spdm_cert_link_cache_t;
+
+/**
+  Return the size in bytes of a verified certificate link cache.
+
+  A certificate link is a certificate and the certificate that issued it. Once the signature
+  of a link is verified, the link is identified by the hash of both certificates, so a
+  repeated chain validation only costs one hash per certificate.
+
+  @param  entry_count                   The maximum number of links in the cache.
+
+  @return the size in bytes of the cache.
+**/
+uintn spdm_cert_link_cache_get_size(IN uintn entry_count)
+{
+	return sizeof(spdm_cert_link_cache_t) +
+	       entry_count * sizeof(spdm_cert_link_cache_entry_t);
+}
+
+/**
+  Initialize a verified certificate link cache.
+
+  The least recently used link is evicted when the cache is full. The cache can be shared
+  by the SPDM contexts of several threads once a lock is registered.
+
+  @param  cert_link_cache                The buffer of spdm_cert_link_cache_get_size(entry_count) bytes.
+  @param  entry_count                   The maximum number of links in the cache.
+
+  @retval RETURN_SUCCESS               The cache is initialized.
+  @retval RETURN_INVALID_PARAMETER     The entry_count is 0.
+**/
+return_status spdm_cert_link_cache_init(OUT void *cert_link_cache,
+					IN uintn entry_count)
+{
+	spdm_cert_link_cache_t *cache;
+
+	if (entry_count == 0) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	cache = cert_link_cache;
+	zero_mem(cache, spdm_cert_link_cache_get_size(entry_count));
+	cache->entry_count = entry_count;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Register the lock serializing the access to a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache.
+  @param  acquire_lock                  The function to acquire the lock, or NULL for a single thread.
+  @param  release_lock                  The function to release the lock, or NULL for a single thread.
+  @param  lock_context                  The lock context passed to the functions.
+**/
+void spdm_cert_link_cache_register_lock_func(
+	IN void *cert_link_cache,
+	IN spdm_cert_link_cache_lock_func acquire_lock OPTIONAL,
+	IN spdm_cert_link_cache_lock_func release_lock OPTIONAL,
+	IN void *lock_context OPTIONAL)
+{
+	spdm_cert_link_cache_t *cache;
+
+	cache = cert_link_cache;
+	cache->acquire_lock = acquire_lock;
+	cache->release_lock = release_lock;
+	cache->lock_context = lock_context;
+}
+
+/**
+  Register the clock used to expire the links of a verified certificate link cache.
+
+  A link expires when either certificate reaches the end of its validity period.
+  Without a clock, links are only evicted when the cache is full.
+
+  @param  cert_link_cache                The verified certificate link cache.
+  @param  get_time                      The function to return the current UTC time, or NULL.
+**/
+void spdm_cert_link_cache_register_get_time_func(
+	IN void *cert_link_cache,
+	IN spdm_cert_link_cache_get_time_func get_time OPTIONAL)
+{
+	spdm_cert_link_cache_t *cache;
+
+	cache = cert_link_cache;
+	cache->get_time = get_time;
+}
+
+/**
+  Acquire the lock of a verified certificate link cache, if any.
+
+  @param  cache                         The verified certificate link cache.
+**/
+static void spdm_cert_link_cache_lock(IN spdm_cert_link_cache_t *cache)
+{
+	if (cache->acquire_lock != NULL) {
+		cache->acquire_lock(cache->lock_context);
+	}
+}
+
+/**
+  Release the lock of a verified certificate link cache, if any.
+
+  @param  cache                         The verified certificate link cache.
+**/
+static void spdm_cert_link_cache_unlock(IN spdm_cert_link_cache_t *cache)
+{
+	if (cache->release_lock != NULL) {
+		cache->release_lock(cache->lock_context);
+	}
+}
+
+/**
+  Remove all links from a verified certificate link cache, for example when a root certificate is revoked.
+
+  @param  cert_link_cache                The verified certificate link cache.
+**/
+void spdm_cert_link_cache_flush(IN void *cert_link_cache)
+{
+	spdm_cert_link_cache_t *cache;
+	spdm_cert_link_cache_entry_t *entry;
+	uintn index;
+
+	cache = cert_link_cache;
+	entry = (void *)(cache + 1);
+	spdm_cert_link_cache_lock(cache);
+	for (index = 0; index < cache->entry_count; index++) {
+		entry[index].valid = FALSE;
+	}
+	spdm_cert_link_cache_unlock(cache);
+}
+
+/**
+  Return the number of link lookups answered and missed by a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache.
+  @param  hit_count                     The number of links found in the cache.
+  @param  miss_count                    The number of links verified with a signature check.
+**/
+void spdm_cert_link_cache_get_statistics(IN void *cert_link_cache,
+					 OUT uint64 *hit_count,
+					 OUT uint64 *miss_count)
+{
+	spdm_cert_link_cache_t *cache;
+
+	cache = cert_link_cache;
+	spdm_cert_link_cache_lock(cache);
+	*hit_count = cache->hit_count;
+	*miss_count = cache->miss_count;
+	spdm_cert_link_cache_unlock(cache);
+}
+
+/**
+  Return the current time of the clock registered with a verified certificate link cache.
+
+  @param  cache                         The verified certificate link cache.
+  @param  now                           The buffer of SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE bytes
+                                       to receive the date_time object.
+
+  @retval TRUE  the current time is returned.
+  @retval FALSE no clock is registered, or the current time is not available.
+**/
+static boolean spdm_cert_link_cache_get_time(IN spdm_cert_link_cache_t *cache,
+					     OUT uint8 *now)
+{
+	char8 date_time_str[SPDM_CERT_LINK_CACHE_DATE_TIME_STR_SIZE];
+	uintn now_size;
+
+	if (cache->get_time == NULL) {
+		return FALSE;
+	}
+	if (!cache->get_time(date_time_str)) {
+		return FALSE;
+	}
+	now_size = SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE;
+	return (boolean)!RETURN_ERROR(
+		x509_set_date_time(date_time_str, now, &now_size));
+}
+
+/**
+  Look up a link in a verified certificate link cache, and mark it as the most recently used.
+
+  @param  cache                         The verified certificate link cache.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  cert_hash                     The hash of the certificate.
+  @param  ca_cert_hash                   The hash of the issuer certificate.
+
+  @retval TRUE  the link is found and not expired.
+  @retval FALSE the link is not found.
+**/
+static boolean spdm_cert_link_cache_lookup(IN spdm_cert_link_cache_t *cache,
+					   IN uint32 base_hash_algo,
+					   IN uint8 *cert_hash, IN uint8 *ca_cert_hash)
+{
+	spdm_cert_link_cache_entry_t *entry;
+	uint8 now[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	boolean now_valid;
+	uintn hash_size;
+	uintn index;
+	boolean found;
+
+	hash_size = spdm_get_hash_size(base_hash_algo);
+	entry = (void *)(cache + 1);
+	found = FALSE;
+	now_valid = spdm_cert_link_cache_get_time(cache, now);
+
+	spdm_cert_link_cache_lock(cache);
+	for (index = 0; index < cache->entry_count; index++) {
+		if (!entry[index].valid ||
+		    entry[index].base_hash_algo != base_hash_algo) {
+			continue;
+		}
+		if (const_compare_mem(entry[index].cert_hash, cert_hash,
+				      hash_size) != 0 ||
+		    const_compare_mem(entry[index].ca_cert_hash, ca_cert_hash,
+				      hash_size) != 0) {
+			continue;
+		}
+		if (now_valid &&
+		    x509_compare_date_time(now, entry[index].not_after) > 0) {
+			entry[index].valid = FALSE;
+			break;
+		}
+		cache->use_counter++;
+		entry[index].last_use = cache->use_counter;
+		found = TRUE;
+		break;
+	}
+	if (found) {
+		cache->hit_count++;
+	} else {
+		cache->miss_count++;
+	}
+	spdm_cert_link_cache_unlock(cache);
+
+	return found;
+}
+
+/**
+  Insert a verified link in a verified certificate link cache, evicting the least recently used link if full.
+
+  @param  cache                         The verified certificate link cache.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  cert_hash                     The hash of the certificate.
+  @param  ca_cert_hash                   The hash of the issuer certificate.
+  @param  expiry_cert                   The certificate of the link whose validity period ends first.
+  @param  expiry_cert_size               size of the certificate in bytes.
+**/
+static void spdm_cert_link_cache_insert(IN spdm_cert_link_cache_t *cache,
+					IN uint32 base_hash_algo,
+					IN uint8 *cert_hash, IN uint8 *ca_cert_hash,
+					IN const uint8 *expiry_cert,
+					IN uintn expiry_cert_size)
+{
+	spdm_cert_link_cache_entry_t *entry;
+	spdm_cert_link_cache_entry_t *victim;
+	uint8 not_before[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	uintn not_before_size;
+	uintn not_after_size;
+	uintn hash_size;
+	uintn index;
+
+	hash_size = spdm_get_hash_size(base_hash_algo);
+	entry = (void *)(cache + 1);
+
+	spdm_cert_link_cache_lock(cache);
+	victim = &entry[0];
+	for (index = 0; index < cache->entry_count; index++) {
+		if (!entry[index].valid) {
+			victim = &entry[index];
+			break;
+		}
+		if (entry[index].base_hash_algo == base_hash_algo &&
+		    const_compare_mem(entry[index].cert_hash, cert_hash,
+				      hash_size) == 0 &&
+		    const_compare_mem(entry[index].ca_cert_hash, ca_cert_hash,
+				      hash_size) == 0) {
+			//
+			// Inserted by another thread meanwhile.
+			//
+			victim = &entry[index];
+			break;
+		}
+		if (entry[index].last_use < victim->last_use) {
+			victim = &entry[index];
+		}
+	}
+
+	//
+	// The date_time object may refer to its own storage, so it is
+	// retrieved in place rather than copied.
+	//
+	not_before_size = sizeof(not_before);
+	not_after_size = sizeof(victim->not_after);
+	victim->valid = x509_get_validity(expiry_cert, expiry_cert_size,
+					  not_before, &not_before_size,
+					  victim->not_after, &not_after_size);
+	if (victim->valid) {
+		victim->base_hash_algo = base_hash_algo;
+		copy_mem(victim->cert_hash, cert_hash, hash_size);
+		copy_mem(victim->ca_cert_hash, ca_cert_hash, hash_size);
+		cache->use_counter++;
+		victim->last_use = cache->use_counter;
+	}
+	spdm_cert_link_cache_unlock(cache);
+}
+
+/**
+  Verify one X509 certificate link, using the certificate hashes to look up the link in the cache.
+
+  @param  cache                         The verified certificate link cache.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  cert                         Pointer to the DER-encoded X509 certificate to be verified.
+  @param  cert_size                     size of the X509 certificate in bytes.
+  @param  cert_hash                     The hash of the certificate.
+  @param  ca_cert                       Pointer to the DER-encoded trusted CA certificate.
+  @param  ca_cert_size                   size of the CA Certificate in bytes.
+  @param  ca_cert_hash                   The hash of the CA certificate.
+
+  @retval TRUE  The certificate was issued by the trusted CA.
+  @retval FALSE Invalid certificate or the certificate was not issued by the given trusted CA.
+**/
+static boolean spdm_cert_link_cache_verify_link(IN spdm_cert_link_cache_t *cache,
+						IN uint32 base_hash_algo,
+						IN const uint8 *cert, IN uintn cert_size,
+						IN uint8 *cert_hash,
+						IN const uint8 *ca_cert,
+						IN uintn ca_cert_size,
+						IN uint8 *ca_cert_hash)
+{
+	uint8 cert_not_before[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	uint8 cert_not_after[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	uint8 ca_cert_not_before[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	uint8 ca_cert_not_after[SPDM_CERT_LINK_CACHE_DATE_TIME_SIZE];
+	uintn not_before_size;
+	uintn not_after_size;
+	const uint8 *expiry_cert;
+	uintn expiry_cert_size;
+
+	if (spdm_cert_link_cache_lookup(cache, base_hash_algo, cert_hash,
+					ca_cert_hash)) {
+		return TRUE;
+	}
+
+	if (!x509_verify_cert(cert, cert_size, ca_cert, ca_cert_size)) {
+		return FALSE;
+	}
+
+	not_before_size = sizeof(cert_not_before);
+	not_after_size = sizeof(cert_not_after);
+	if (!x509_get_validity(cert, cert_size, cert_not_before,
+			       &not_before_size, cert_not_after,
+			       &not_after_size)) {
+		return TRUE;
+	}
+	not_before_size = sizeof(ca_cert_not_before);
+	not_after_size = sizeof(ca_cert_not_after);
+	if (!x509_get_validity(ca_cert, ca_cert_size, ca_cert_not_before,
+			       &not_before_size, ca_cert_not_after,
+			       &not_after_size)) {
+		return TRUE;
+	}
+	if (x509_compare_date_time(ca_cert_not_after, cert_not_after) < 0) {
+		expiry_cert = ca_cert;
+		expiry_cert_size = ca_cert_size;
+	} else {
+		expiry_cert = cert;
+		expiry_cert_size = cert_size;
+	}
+
+	spdm_cert_link_cache_insert(cache, base_hash_algo, cert_hash,
+				    ca_cert_hash, expiry_cert,
+				    expiry_cert_size);
+	return TRUE;
+}
+
+/**
+  Verify one X509 certificate was issued by the trusted CA, using a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache, or NULL to always verify.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  cert                         Pointer to the DER-encoded X509 certificate to be verified.
+  @param  cert_size                     size of the X509 certificate in bytes.
+  @param  ca_cert                       Pointer to the DER-encoded trusted CA certificate.
+  @param  ca_cert_size                   size of the CA Certificate in bytes.
+
+  @retval TRUE  The certificate was issued by the trusted CA.
+  @retval FALSE Invalid certificate or the certificate was not issued by the given trusted CA.
+**/
+boolean spdm_x509_verify_cert_with_cache(IN void *cert_link_cache OPTIONAL,
+					 IN uint32 base_hash_algo,
+					 IN const uint8 *cert, IN uintn cert_size,
+					 IN const uint8 *ca_cert,
+					 IN uintn ca_cert_size)
+{
+	uint8 cert_hash[MAX_HASH_SIZE];
+	uint8 ca_cert_hash[MAX_HASH_SIZE];
+
+	if ((cert_link_cache == NULL) ||
+	    (spdm_get_hash_size(base_hash_algo) == 0)) {
+		return x509_verify_cert(cert, cert_size, ca_cert, ca_cert_size);
+	}
+
+	if (!spdm_hash_all(base_hash_algo, cert, cert_size, cert_hash) ||
+	    !spdm_hash_all(base_hash_algo, ca_cert, ca_cert_size,
+			   ca_cert_hash)) {
+		return FALSE;
+	}
+	return spdm_cert_link_cache_verify_link(cert_link_cache,
+						base_hash_algo, cert, cert_size,
+						cert_hash, ca_cert,
+						ca_cert_size, ca_cert_hash);
+}
+
+/**
+  Verify a X509 certificate chain, using a verified certificate link cache.
+
+  @param  cert_link_cache                The verified certificate link cache, or NULL to always verify.
+  @param  base_hash_algo                 SPDM base_hash_algo used to identify the certificates.
+  @param  root_cert                     Trusted Root Certificate buffer.
+  @param  root_cert_length               Trusted Root Certificate buffer length.
+  @param  cert_chain                    One or more ASN.1 DER-encoded X.509 certificates where the first
+                                       certificate is signed by the Root Certificate and subsequent
+                                       certificate is signed by the preceding certificate.
+  @param  cert_chain_length              Total length of the certificate chain, in bytes.
+
+  @retval TRUE  All cerificates was issued by the first certificate in X509Certchain.
+  @retval FALSE Invalid certificate or the certificate was not issued by the given trusted CA.
+**/
+boolean spdm_x509_verify_cert_chain_with_cache(IN void *cert_link_cache OPTIONAL,
+					       IN uint32 base_hash_algo,
+					       IN uint8 *root_cert,
+					       IN uintn root_cert_length,
+					       IN uint8 *cert_chain,
+					       IN uintn cert_chain_length)
+{
+	uint8 *preceding_cert;
+	uintn preceding_cert_len;
+	uint8 preceding_cert_hash[MAX_HASH_SIZE];
+	uint8 *current_cert;
+	uintn current_cert_len;
+	uint8 current_cert_hash[MAX_HASH_SIZE];
+	uintn hash_size;
+	intn index;
+
+	hash_size = spdm_get_hash_size(base_hash_algo);
+	if ((cert_link_cache == NULL) || (hash_size == 0)) {
+		return x509_verify_cert_chain(root_cert, root_cert_length,
+					      cert_chain, cert_chain_length);
+	}
+
+	preceding_cert = root_cert;
+	preceding_cert_len = root_cert_length;
+	if (!spdm_hash_all(base_hash_algo, preceding_cert, preceding_cert_len,
+			   preceding_cert_hash)) {
+		return FALSE;
+	}
+
+	for (index = 0;; index++) {
+		if (!x509_get_cert_from_cert_chain(cert_chain,
+						   cert_chain_length, index,
+						   &current_cert,
+						   &current_cert_len)) {
+			break;
+		}
+		if (!spdm_hash_all(base_hash_algo, current_cert,
+				   current_cert_len, current_cert_hash)) {
+			return FALSE;
+		}
+		if (!spdm_cert_link_cache_verify_link(
+			    cert_link_cache, base_hash_algo, current_cert,
+			    current_cert_len, current_cert_hash, preceding_cert,
+			    preceding_cert_len, preceding_cert_hash)) {
+			return FALSE;
+		}
+		preceding_cert = current_cert;
+		preceding_cert_len = current_cert_len;
+		copy_mem(preceding_cert_hash, current_cert_hash, hash_size);
+	}
+
+	//
+	// As x509_verify_cert_chain, an empty chain is not verified.
+	//
+	return (boolean)(index != 0);
+}
@@ -137,6 +137,47 @@ hash_free_func get_spdm_hash_free_func(IN uint32 base_hash_algo)
 	return NULL;
 }
 
+/**
+  Return hash get_context_size function, based upon the negotiated hash algorithm.
+
+  @param  base_hash_algo                  SPDM base_hash_algo
+
+  @return hash get_context_size function
+**/
+hash_get_context_size_func get_spdm_hash_get_context_size_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if LIBSPDM_SHA256_SUPPORT == 1
+		return sha256_get_context_size;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if LIBSPDM_SHA384_SUPPORT == 1
+		return sha384_get_context_size;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if LIBSPDM_SHA512_SUPPORT == 1
+		return sha512_get_context_size;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
 /**
   Return hash init function, based upon the negotiated hash algorithm.
 
@@ -376,6 +417,24 @@ void spdm_hash_free(IN uint32 base_hash_algo, IN void *hash_context)
 	hash_function(hash_context);
 }
 
+/**
+  Return the size in bytes of a hash context that spdm_hash_init can initialize in caller memory,
+  instead of one allocated by spdm_hash_new. Such a context is not released by spdm_hash_free.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return  The size of the hash context, or 0 if the hash context can only be allocated by spdm_hash_new.
+**/
+uintn spdm_hash_get_context_size(IN uint32 base_hash_algo)
+{
+	hash_get_context_size_func hash_function;
+	hash_function = get_spdm_hash_get_context_size_func(base_hash_algo);
+	if (hash_function == NULL) {
+		return 0;
+	}
+	return hash_function();
+}
+
 /**
   Initializes user-supplied memory pointed by hash_context as hash context for
   subsequent use.
@@ -1116,6 +1175,257 @@ boolean spdm_hkdf_expand(IN uint32 base_hash_algo, IN const uint8 *prk,
 				    out_size);
 }
 
+/**
+  Return HKDF new function, based upon the negotiated HKDF algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HKDF new function
+**/
+hkdf_new_func get_spdm_hkdf_new_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if LIBSPDM_SHA256_SUPPORT == 1
+		return hkdf_sha256_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if LIBSPDM_SHA384_SUPPORT == 1
+		return hkdf_sha384_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if LIBSPDM_SHA512_SUPPORT == 1
+		return hkdf_sha512_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Allocates one HKDF context for subsequent keyed expansion, based upon the negotiated HKDF algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return  Pointer to the HKDF context that has been allocated.
+           If the allocations fails, spdm_hkdf_new() returns NULL.
+**/
+void *spdm_hkdf_new(IN uint32 base_hash_algo)
+{
+	hkdf_new_func hkdf_function;
+	hkdf_function = get_spdm_hkdf_new_func(base_hash_algo);
+	if (hkdf_function == NULL) {
+		return NULL;
+	}
+	return hkdf_function();
+}
+
+/**
+  Return HKDF free function, based upon the negotiated HKDF algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HKDF free function
+**/
+hkdf_free_func get_spdm_hkdf_free_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if LIBSPDM_SHA256_SUPPORT == 1
+		return hkdf_sha256_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if LIBSPDM_SHA384_SUPPORT == 1
+		return hkdf_sha384_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if LIBSPDM_SHA512_SUPPORT == 1
+		return hkdf_sha512_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Release the specified HKDF context.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hkdf_ctx                      Pointer to the HKDF context to be released.
+**/
+void spdm_hkdf_free(IN uint32 base_hash_algo, IN void *hkdf_ctx)
+{
+	hkdf_free_func hkdf_function;
+	hkdf_function = get_spdm_hkdf_free_func(base_hash_algo);
+	if (hkdf_function == NULL) {
+		return;
+	}
+	hkdf_function(hkdf_ctx);
+}
+
+/**
+  Return HKDF set PRK function, based upon the negotiated HKDF algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HKDF set PRK function
+**/
+hkdf_set_prk_func get_spdm_hkdf_set_prk_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if LIBSPDM_SHA256_SUPPORT == 1
+		return hkdf_sha256_set_prk;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if LIBSPDM_SHA384_SUPPORT == 1
+		return hkdf_sha384_set_prk;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if LIBSPDM_SHA512_SUPPORT == 1
+		return hkdf_sha512_set_prk;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF context for subsequent keyed expansion,
+  based upon the negotiated HKDF algorithm. A context can be keyed again with another PRK.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hkdf_ctx                      Pointer to the HKDF context.
+  @param  prk                          Pointer to the pseudorandom key.
+  @param  prk_size                      prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+**/
+boolean spdm_hkdf_set_prk(IN uint32 base_hash_algo, OUT void *hkdf_ctx,
+			  IN const uint8 *prk, IN uintn prk_size)
+{
+	hkdf_set_prk_func hkdf_function;
+	hkdf_function = get_spdm_hkdf_set_prk_func(base_hash_algo);
+	if (hkdf_function == NULL) {
+		return FALSE;
+	}
+	return hkdf_function(hkdf_ctx, prk, prk_size);
+}
+
+/**
+  Return HKDF keyed expand function, based upon the negotiated HKDF algorithm.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+
+  @return HKDF keyed expand function
+**/
+hkdf_keyed_expand_func get_spdm_hkdf_keyed_expand_func(IN uint32 base_hash_algo)
+{
+	switch (base_hash_algo) {
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+#if LIBSPDM_SHA256_SUPPORT == 1
+		return hkdf_sha256_keyed_expand;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+#if LIBSPDM_SHA384_SUPPORT == 1
+		return hkdf_sha384_keyed_expand;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+#if LIBSPDM_SHA512_SUPPORT == 1
+		return hkdf_sha512_keyed_expand;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+	case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+		ASSERT(FALSE);
+		break;
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Derive HMAC-based Expand key Derivation Function (HKDF) Expand from a keyed HKDF context,
+  based upon the negotiated HKDF algorithm.
+
+  The result is the same as spdm_hkdf_expand() with the PRK of the context, but the
+  HMAC key setup is done once for all the expansions from the same PRK.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  hkdf_ctx                      Pointer to the HKDF context keyed by spdm_hkdf_set_prk().
+  @param  info                         Pointer to the application specific info.
+  @param  info_size                     info size in bytes.
+  @param  out                          Pointer to buffer to receive hkdf value.
+  @param  out_size                      size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+**/
+boolean spdm_hkdf_keyed_expand(IN uint32 base_hash_algo,
+			       IN const void *hkdf_ctx, IN const uint8 *info,
+			       IN uintn info_size, OUT uint8 *out,
+			       IN uintn out_size)
+{
+	hkdf_keyed_expand_func hkdf_function;
+	hkdf_function = get_spdm_hkdf_keyed_expand_func(base_hash_algo);
+	if (hkdf_function == NULL) {
+		return FALSE;
+	}
+	return hkdf_function(hkdf_ctx, info, info_size, out, out_size);
+}
+
 /**
   This function returns the SPDM asymmetric algorithm size.
 
@@ -1210,13 +1520,14 @@ boolean spdm_asym_get_public_key_from_x509(IN uint32 base_asym_algo,
 }
 
 /**
-  Return asymmetric free function, based upon the negotiated asymmetric algorithm.
+  Return asymmetric GET_PUBLIC_KEY_FROM_X509_OBJECT function, based upon the negotiated asymmetric algorithm.
 
   @param  base_asym_algo                 SPDM base_asym_algo
 
-  @return asymmetric free function
+  @return asymmetric GET_PUBLIC_KEY_FROM_X509_OBJECT function
 **/
-asym_free_func get_spdm_asym_free(IN uint32 base_asym_algo)
+asym_get_public_key_from_x509_object_func
+get_spdm_asym_get_public_key_from_x509_object(IN uint32 base_asym_algo)
 {
 	switch (base_asym_algo) {
 	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048:
@@ -1226,7 +1537,7 @@ asym_free_func get_spdm_asym_free(IN uint32 base_asym_algo)
 	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072:
 	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_4096:
 #if (LIBSPDM_RSA_SSA_SUPPORT == 1) || (LIBSPDM_RSA_PSS_SUPPORT == 1)
-		return rsa_free;
+		return rsa_get_public_key_from_x509_object;
 #else
 		ASSERT(FALSE);
 		break;
@@ -1235,7 +1546,7 @@ asym_free_func get_spdm_asym_free(IN uint32 base_asym_algo)
 	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384:
 	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521:
 #if LIBSPDM_ECDSA_SUPPORT == 1
-		return ec_free;
+		return ec_get_public_key_from_x509_object;
 #else
 		ASSERT(FALSE);
 		break;
@@ -1246,29 +1557,91 @@ asym_free_func get_spdm_asym_free(IN uint32 base_asym_algo)
 }
 
 /**
-  Release the specified asymmetric context,
+  Retrieve the asymmetric public key from one X509 object,
   based upon negotiated asymmetric algorithm.
 
   @param  base_asym_algo                 SPDM base_asym_algo
-  @param  context                      Pointer to the asymmetric context to be released.
+  @param  x509_cert                     The X509 object generated by x509_construct_certificate().
+  @param  context                      Pointer to new-generated asymmetric context which contain the retrieved public key component.
+                                       Use spdm_asym_free() function to free the resource.
+
+  @retval  TRUE   public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve public key from X509 object.
 **/
-void spdm_asym_free(IN uint32 base_asym_algo, IN void *context)
+boolean spdm_asym_get_public_key_from_x509_object(IN uint32 base_asym_algo,
+						  IN void *x509_cert,
+						  OUT void **context)
 {
-	asym_free_func free_function;
-	free_function = get_spdm_asym_free(base_asym_algo);
-	if (free_function == NULL) {
-		return;
+	asym_get_public_key_from_x509_object_func
+		get_public_key_from_x509_object_function;
+	get_public_key_from_x509_object_function =
+		get_spdm_asym_get_public_key_from_x509_object(base_asym_algo);
+	if (get_public_key_from_x509_object_function == NULL) {
+		return FALSE;
 	}
-	free_function(context);
+	return get_public_key_from_x509_object_function(x509_cert, context);
 }
 
 /**
-  Return if asymmetric function need message hash.
+  Return asymmetric free function, based upon the negotiated asymmetric algorithm.
 
-  @param  base_asym_algo               SPDM base_asym_algo
+  @param  base_asym_algo                 SPDM base_asym_algo
 
-  @retval TRUE  asymmetric function need message hash
-  @retval FALSE asymmetric function need raw message
+  @return asymmetric free function
+**/
+asym_free_func get_spdm_asym_free(IN uint32 base_asym_algo)
+{
+	switch (base_asym_algo) {
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_4096:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_4096:
+#if (LIBSPDM_RSA_SSA_SUPPORT == 1) || (LIBSPDM_RSA_PSS_SUPPORT == 1)
+		return rsa_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384:
+	case SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521:
+#if LIBSPDM_ECDSA_SUPPORT == 1
+		return ec_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Release the specified asymmetric context,
+  based upon negotiated asymmetric algorithm.
+
+  @param  base_asym_algo                 SPDM base_asym_algo
+  @param  context                      Pointer to the asymmetric context to be released.
+**/
+void spdm_asym_free(IN uint32 base_asym_algo, IN void *context)
+{
+	asym_free_func free_function;
+	free_function = get_spdm_asym_free(base_asym_algo);
+	if (free_function == NULL) {
+		return;
+	}
+	free_function(context);
+}
+
+/**
+  Return if asymmetric function need message hash.
+
+  @param  base_asym_algo               SPDM base_asym_algo
+
+  @retval TRUE  asymmetric function need message hash
+  @retval FALSE asymmetric function need raw message
 **/
 boolean spdm_asym_func_need_hash(IN uint32 base_asym_algo)
 {
@@ -1687,6 +2060,25 @@ boolean spdm_req_asym_get_public_key_from_x509(IN uint16 req_base_asym_alg,
 	return get_public_key_from_x509_function(cert, cert_size, context);
 }
 
+/**
+  Retrieve the asymmetric public key from one X509 object,
+  based upon negotiated requester asymmetric algorithm.
+
+  @param  req_base_asym_alg               SPDM req_base_asym_alg
+  @param  x509_cert                     The X509 object generated by x509_construct_certificate().
+  @param  context                      Pointer to new-generated asymmetric context which contain the retrieved public key component.
+                                       Use spdm_req_asym_free() function to free the resource.
+
+  @retval  TRUE   public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve public key from X509 object.
+**/
+boolean spdm_req_asym_get_public_key_from_x509_object(
+	IN uint16 req_base_asym_alg, IN void *x509_cert, OUT void **context)
+{
+	return spdm_asym_get_public_key_from_x509_object(req_base_asym_alg,
+							 x509_cert, context);
+}
+
 /**
   Return requester asymmetric free function, based upon the negotiated requester asymmetric algorithm.
 
@@ -2492,6 +2884,328 @@ boolean spdm_aead_decryption(IN spdm_version_number_t secured_message_version,
 				 tag_size, data_out, data_out_size);
 }
 
+/**
+  Return AEAD new function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD new function
+**/
+aead_new_func get_spdm_aead_new_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_new;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Allocates and initializes one AEAD context for subsequent keyed use,
+  based upon negotiated AEAD algorithm.
+
+  The context is keyed by spdm_aead_set_key() and can then be used by
+  spdm_aead_seal() and spdm_aead_open() without expanding the key again.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return  Pointer to the AEAD context that has been initialized.
+           If the allocations fails or the algorithm does not support keyed
+           contexts, spdm_aead_new() returns NULL.
+**/
+void *spdm_aead_new(IN uint16 aead_cipher_suite)
+{
+	aead_new_func aead_function;
+	aead_function = get_spdm_aead_new_func(aead_cipher_suite);
+	if (aead_function == NULL) {
+		return NULL;
+	}
+	return aead_function();
+}
+
+/**
+  Return AEAD free function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD free function
+**/
+aead_free_func get_spdm_aead_free_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_free;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Release the specified AEAD context,
+  based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context to be released.
+**/
+void spdm_aead_free(IN uint16 aead_cipher_suite, IN void *aead_ctx)
+{
+	aead_free_func aead_function;
+	if (aead_ctx == NULL) {
+		return ;
+	}
+	aead_function = get_spdm_aead_free_func(aead_cipher_suite);
+	if (aead_function == NULL) {
+		return ;
+	}
+	aead_function(aead_ctx);
+}
+
+/**
+  Return AEAD set_key function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD set_key function
+**/
+aead_set_key_func get_spdm_aead_set_key_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_set_key;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_set_key;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_set_key;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Set the encryption key of an AEAD context,
+  based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context.
+  @param  key                          Pointer to the encryption key.
+  @param  key_size                      size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+**/
+boolean spdm_aead_set_key(IN uint16 aead_cipher_suite, IN OUT void *aead_ctx,
+			  IN const uint8 *key, IN uintn key_size)
+{
+	aead_set_key_func aead_function;
+	aead_function = get_spdm_aead_set_key_func(aead_cipher_suite);
+	if (aead_function == NULL) {
+		return FALSE;
+	}
+	return aead_function(aead_ctx, key, key_size);
+}
+
+/**
+  Return AEAD seal function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD seal function
+**/
+aead_seal_func get_spdm_aead_seal_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_seal;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_seal;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_seal;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Performs AEAD authenticated encryption on a data buffer and additional authenticated data (AAD)
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context keyed by spdm_aead_set_key().
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be encrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag_out                       Pointer to a buffer that receives the authentication tag output.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the encryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated encryption succeeded.
+  @retval FALSE  AEAD authenticated encryption failed.
+**/
+boolean spdm_aead_seal(IN spdm_version_number_t secured_message_version,
+		       IN uint16 aead_cipher_suite, IN void *aead_ctx,
+		       IN const uint8 *iv, IN uintn iv_size,
+		       IN const uint8 *a_data, IN uintn a_data_size,
+		       IN const uint8 *data_in, IN uintn data_in_size,
+		       OUT uint8 *tag_out, IN uintn tag_size,
+		       OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	aead_seal_func aead_function;
+	aead_function = get_spdm_aead_seal_func(aead_cipher_suite);
+	if (aead_function == NULL) {
+		return FALSE;
+	}
+	return aead_function(aead_ctx, iv, iv_size, a_data, a_data_size,
+			     data_in, data_in_size, tag_out, tag_size,
+			     data_out, data_out_size);
+}
+
+/**
+  Return AEAD open function, based upon the negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+
+  @return AEAD open function
+**/
+aead_open_func get_spdm_aead_open_func(IN uint16 aead_cipher_suite)
+{
+	switch (aead_cipher_suite) {
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_open;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM:
+#if LIBSPDM_AEAD_GCM_SUPPORT == 1
+		return aead_aes_gcm_open;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	case SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305:
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT == 1
+		return aead_chacha20_poly1305_open;
+#else
+		ASSERT(FALSE);
+		break;
+#endif
+	}
+	ASSERT(FALSE);
+	return NULL;
+}
+
+/**
+  Performs AEAD authenticated decryption on a data buffer and additional authenticated data (AAD)
+  with a keyed AEAD context, based upon negotiated AEAD algorithm.
+
+  @param  aead_cipher_suite              SPDM aead_cipher_suite
+  @param  aead_ctx                      Pointer to the AEAD context keyed by spdm_aead_set_key().
+  @param  iv                           Pointer to the IV value.
+  @param  iv_size                       size of the IV value in bytes.
+  @param  a_data                        Pointer to the additional authenticated data (AAD).
+  @param  a_data_size                    size of the additional authenticated data (AAD) in bytes.
+  @param  data_in                       Pointer to the input data buffer to be decrypted.
+  @param  data_in_size                   size of the input data buffer in bytes.
+  @param  tag                          Pointer to a buffer that contains the authentication tag.
+  @param  tag_size                      size of the authentication tag in bytes.
+  @param  data_out                      Pointer to a buffer that receives the decryption output.
+  @param  data_out_size                  size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD authenticated decryption succeeded.
+  @retval FALSE  AEAD authenticated decryption failed.
+**/
+boolean spdm_aead_open(IN spdm_version_number_t secured_message_version,
+		       IN uint16 aead_cipher_suite, IN void *aead_ctx,
+		       IN const uint8 *iv, IN uintn iv_size,
+		       IN const uint8 *a_data, IN uintn a_data_size,
+		       IN const uint8 *data_in, IN uintn data_in_size,
+		       IN const uint8 *tag, IN uintn tag_size,
+		       OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	aead_open_func aead_function;
+	aead_function = get_spdm_aead_open_func(aead_cipher_suite);
+	if (aead_function == NULL) {
+		return FALSE;
+	}
+	return aead_function(aead_ctx, iv, iv_size, a_data, a_data_size,
+			     data_in, data_in_size, tag, tag_size,
+			     data_out, data_out_size);
+}
+
 /**
   Generates a random byte stream of the specified size.
 
@@ -2568,6 +3282,34 @@ static boolean internal_spdm_x509_date_time_check(IN uint8 *from,
   @retval  FALSE  Certificate is not valid
 **/
 boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
+{
+	boolean status;
+	void *x509_cert;
+
+	if (cert == NULL || cert_size == 0) {
+		return FALSE;
+	}
+
+	x509_cert = NULL;
+	status = x509_construct_certificate(cert, cert_size,
+					    (uint8 **)&x509_cert);
+	if (status) {
+		status = spdm_x509_object_certificate_check(x509_cert);
+	}
+	x509_free(x509_cert);
+
+	return status;
+}
+
+/**
+  Certificate Check for SPDM leaf cert, on a certificate which is already decoded.
+
+  @param[in]  x509_cert        The X509 object generated by x509_construct_certificate().
+
+  @retval  TRUE   Success.
+  @retval  FALSE  Certificate is not valid
+**/
+boolean spdm_x509_object_certificate_check(IN void *x509_cert)
 {
 	uint8 end_cert_from[64];
 	uintn end_cert_from_len;
@@ -2581,7 +3323,7 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 	void *rsa_context;
 	void *ec_context;
 
-	if (cert == NULL || cert_size == 0) {
+	if (x509_cert == NULL) {
 		return FALSE;
 	}
 
@@ -2593,7 +3335,7 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 
 	// 1. version
 	cert_version = 0;
-	ret = x509_get_version(cert, cert_size, &cert_version);
+	ret = x509_object_get_version(x509_cert, &cert_version);
 	if (RETURN_ERROR(ret)) {
 		status = FALSE;
 		goto cleanup;
@@ -2605,7 +3347,8 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 
 	// 2. serial_number
 	asn1_buffer_len = 0;
-	ret = x509_get_serial_number(cert, cert_size, NULL, &asn1_buffer_len);
+	ret = x509_object_get_serial_number(x509_cert, NULL,
+					    &asn1_buffer_len);
 	if (ret != RETURN_BUFFER_TOO_SMALL) {
 		status = FALSE;
 		goto cleanup;
@@ -2613,7 +3356,7 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 
 	// 3. sinature_algorithem
 	value = 0;
-	ret = x509_get_signature_algorithm(cert, cert_size, NULL, &value);
+	ret = x509_object_get_signature_algorithm(x509_cert, NULL, &value);
 	if (ret != RETURN_BUFFER_TOO_SMALL || value == 0) {
 		status = FALSE;
 		goto cleanup;
@@ -2621,7 +3364,8 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 
 	// 4. issuer_name
 	asn1_buffer_len = 0;
-	status = x509_get_issuer_name(cert, cert_size, NULL, &asn1_buffer_len);
+	status = x509_object_get_issuer_name(x509_cert, NULL,
+					     &asn1_buffer_len);
 	if (asn1_buffer_len <= 0) {
 		status = FALSE;
 		goto cleanup;
@@ -2629,16 +3373,17 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 
 	// 5. subject_name
 	asn1_buffer_len = 0;
-	status = x509_get_subject_name(cert, cert_size, NULL, &asn1_buffer_len);
+	status = x509_object_get_subject_name(x509_cert, NULL,
+					      &asn1_buffer_len);
 	if (asn1_buffer_len <= 0) {
 		status = FALSE;
 		goto cleanup;
 	}
 
 	// 6. validaity
-	status = x509_get_validity(cert, cert_size, end_cert_from,
-				   &end_cert_from_len, end_cert_to,
-				   &end_cert_to_len);
+	status = x509_object_get_validity(x509_cert, end_cert_from,
+					  &end_cert_from_len, end_cert_to,
+					  &end_cert_to_len);
 	if (!status) {
 		goto cleanup;
 	}
@@ -2650,10 +3395,10 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 	}
 
 	// 7. subject_public_key
-	status = rsa_get_public_key_from_x509(cert, cert_size, &rsa_context);
+	status = rsa_get_public_key_from_x509_object(x509_cert, &rsa_context);
 	if (!status) {
-		status = ec_get_public_key_from_x509(cert, cert_size,
-						     &ec_context);
+		status = ec_get_public_key_from_x509_object(x509_cert,
+							    &ec_context);
 	}
 	if (!status) {
 		goto cleanup;
@@ -2661,14 +3406,14 @@ boolean spdm_x509_certificate_check(IN const uint8 *cert, IN uintn cert_size)
 
 	// 8. extended_key_usage
 	value = 0;
-	ret = x509_get_extended_key_usage(cert, cert_size, NULL, &value);
+	ret = x509_object_get_extended_key_usage(x509_cert, NULL, &value);
 	if (ret != RETURN_BUFFER_TOO_SMALL || value == 0) {
 		status = FALSE;
 		goto cleanup;
 	}
 
 	// 9. key_usage
-	status = x509_get_key_usage(cert, cert_size, &value);
+	status = x509_object_get_key_usage(x509_cert, &value);
 	if (!status) {
 		goto cleanup;
 	}
@@ -2704,18 +3449,28 @@ boolean spdm_is_root_certificate(IN const uint8 *cert, IN uintn cert_size)
 	uintn issuer_name_len;
 	uint8 subject_name[MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE];
 	uintn subject_name_len;
+	void *x509_cert;
 
 	if (cert == NULL || cert_size == 0) {
 		return FALSE;
 	}
 
+	x509_cert = NULL;
+	if (!x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert)) {
+		x509_free(x509_cert);
+		return FALSE;
+	}
+
 	// 1. issuer_name
 	issuer_name_len = MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
-	x509_get_issuer_name(cert, cert_size, issuer_name, &issuer_name_len);
+	x509_object_get_issuer_name(x509_cert, issuer_name, &issuer_name_len);
 
 	// 2. subject_name
 	subject_name_len = MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE;
-	x509_get_subject_name(cert, cert_size, subject_name, &subject_name_len);
+	x509_object_get_subject_name(x509_cert, subject_name,
+				     &subject_name_len);
+
+	x509_free(x509_cert);
 
 	if (issuer_name_len != subject_name_len) {
 		return FALSE;
@@ -2894,10 +3649,12 @@ spdm_get_dmtf_subject_alt_name(IN const uint8 *cert, IN intn cert_size,
 boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 				    IN uintn cert_chain_data_size)
 {
-	uint8 *root_cert_buffer;
-	uintn root_cert_buffer_size;
-	uint8 *leaf_cert_buffer;
-	uintn leaf_cert_buffer_size;
+	uint8 *cert_buffer;
+	uintn cert_buffer_size;
+	uintn offset;
+	void *preceding_x509_cert;
+	void *current_x509_cert;
+	boolean result;
 
 	if (cert_chain_data_size >
 	    MAX_UINT16 - (sizeof(spdm_cert_chain_t) + MAX_HASH_SIZE)) {
@@ -2907,30 +3664,63 @@ boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 	}
 
 	if (!x509_get_cert_from_cert_chain(
-		    cert_chain_data, cert_chain_data_size, 0, &root_cert_buffer,
-		    &root_cert_buffer_size)) {
+		    cert_chain_data, cert_chain_data_size, 0, &cert_buffer,
+		    &cert_buffer_size)) {
 		DEBUG((DEBUG_INFO,
 		       "!!! VerifyCertificateChainData - FAIL (get root certificate failed)!!!\n"));
 		return FALSE;
 	}
 
-	if (!x509_verify_cert_chain(root_cert_buffer, root_cert_buffer_size,
-				    cert_chain_data, cert_chain_data_size)) {
+	//
+	// Decode every certificate once. The root certificate verifies itself, each
+	// following certificate is verified by the preceding one, and the last
+	// decoded certificate is the leaf certificate to be checked.
+	//
+	preceding_x509_cert = NULL;
+	offset = 0;
+	result = TRUE;
+	while (offset < cert_chain_data_size) {
+		if (!x509_get_cert_from_cert_chain(
+			    cert_chain_data + offset,
+			    cert_chain_data_size - offset, 0, &cert_buffer,
+			    &cert_buffer_size)) {
+			break;
+		}
+		current_x509_cert = NULL;
+		result = x509_construct_certificate(
+			cert_buffer, cert_buffer_size,
+			(uint8 **)&current_x509_cert);
+		if (result) {
+			result = x509_object_verify_cert(
+				current_x509_cert,
+				(preceding_x509_cert != NULL) ?
+					preceding_x509_cert :
+					current_x509_cert);
+		}
+		x509_free(preceding_x509_cert);
+		preceding_x509_cert = current_x509_cert;
+		if (!result) {
+			break;
+		}
+		offset += cert_buffer_size;
+	}
+
+	if (!result) {
+		x509_free(preceding_x509_cert);
 		DEBUG((DEBUG_INFO,
 		       "!!! VerifyCertificateChainData - FAIL (cert chain verify failed)!!!\n"));
 		return FALSE;
 	}
 
-	if (!x509_get_cert_from_cert_chain(
-		    cert_chain_data, cert_chain_data_size, -1,
-		    &leaf_cert_buffer, &leaf_cert_buffer_size)) {
+	if (preceding_x509_cert == NULL) {
 		DEBUG((DEBUG_INFO,
 		       "!!! VerifyCertificateChainData - FAIL (get leaf certificate failed)!!!\n"));
 		return FALSE;
 	}
 
-	if (!spdm_x509_certificate_check(leaf_cert_buffer,
-					 leaf_cert_buffer_size)) {
+	result = spdm_x509_object_certificate_check(preceding_x509_cert);
+	x509_free(preceding_x509_cert);
+	if (!result) {
 		DEBUG((DEBUG_INFO,
 		       "!!! VerifyCertificateChainData - FAIL (leaf certificate check failed)!!!\n"));
 		return FALSE;
@@ -2952,6 +3742,27 @@ boolean spdm_verify_cert_chain_data(IN uint8 *cert_chain_data,
 boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 					     IN void *cert_chain_buffer,
 					     IN uintn cert_chain_buffer_size)
+{
+	return spdm_verify_certificate_chain_buffer_ex(
+		base_hash_algo, cert_chain_buffer, cert_chain_buffer_size, NULL);
+}
+
+/**
+  This function verifies the integrity of certificate chain buffer including spdm_cert_chain_t header,
+  skipping the signature check of the certificate links found in a verified certificate link cache.
+
+  @param  base_hash_algo                 SPDM base_hash_algo
+  @param  cert_chain_buffer              The certificate chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certificate chain buffer.
+  @param  cert_link_cache                The verified certificate link cache, or NULL to verify every link.
+
+  @retval TRUE  certificate chain buffer integrity verification pass.
+  @retval FALSE certificate chain buffer integrity verification fail.
+**/
+boolean spdm_verify_certificate_chain_buffer_ex(IN uint32 base_hash_algo,
+						IN void *cert_chain_buffer,
+						IN uintn cert_chain_buffer_size,
+						IN void *cert_link_cache OPTIONAL)
 {
 	uint8 *cert_chain_data;
 	uintn cert_chain_data_size;
@@ -3004,7 +3815,8 @@ boolean spdm_verify_certificate_chain_buffer(IN uint32 base_hash_algo,
 	//If the number of certificates in the certificate chain is more than 1,
 	//other certificates need to be verified. 
 	if (cert_chain_data_size > first_cert_buffer_size) {
-		if (!x509_verify_cert_chain(first_cert_buffer, first_cert_buffer_size,
+		if (!spdm_x509_verify_cert_chain_with_cache(cert_link_cache, base_hash_algo,
+						first_cert_buffer, first_cert_buffer_size,
 						cert_chain_data + first_cert_buffer_size,
 						cert_chain_data_size - first_cert_buffer_size)) {
 			DEBUG((DEBUG_INFO,
@@ -0,0 +1,429 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_fleet_lib_internal.h"
+
+/**
+  Return the size in bytes of a fleet context.
+
+  @param  device_count                  The number of devices of the fleet.
+
+  @return the size in bytes of the fleet context, including the SPDM contexts and the device reports.
+**/
+uintn spdm_fleet_get_context_size(IN uintn device_count)
+{
+	uintn size;
+
+	size = ALIGN_VALUE(sizeof(spdm_fleet_context_t), sizeof(uint64));
+	size += ALIGN_VALUE(sizeof(spdm_fleet_worker_t) * device_count,
+			    sizeof(uint64));
+	size += ALIGN_VALUE(sizeof(spdm_fleet_device_report_t) * device_count,
+			    sizeof(uint64));
+	size += ALIGN_VALUE(spdm_cert_link_cache_get_size(
+				    SPDM_FLEET_CERT_LINK_CACHE_ENTRY_COUNT),
+			    sizeof(uint64));
+	size += ALIGN_VALUE(spdm_get_context_size(), sizeof(uint64)) *
+		device_count;
+	return size;
+}
+
+/**
+  Initialize a fleet context.
+
+  Each SPDM context of the fleet is initialized by spdm_init_context, and uses the verified
+  certificate link cache of the fleet. The integrator
+  registers the device IO and transport layer functions and sets the local data of
+  each context via spdm_fleet_get_spdm_context before spdm_fleet_run.
+
+  @param  fleet_context                 A pointer to the fleet context of spdm_fleet_get_context_size bytes.
+  @param  device_count                  The number of devices of the fleet.
+  @param  worker_count                  The number of worker threads. 0 means one per processor.
+                                       It is capped to device_count.
+
+  @retval RETURN_SUCCESS               The fleet context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The device_count is 0.
+**/
+return_status spdm_fleet_init_context(IN void *fleet_context,
+				      IN uintn device_count,
+				      IN uintn worker_count)
+{
+	spdm_fleet_context_t *fleet;
+	void *spdm_context;
+	uint8 *ptr;
+	uintn index;
+
+	if (device_count == 0) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	if (worker_count == 0) {
+		worker_count = thread_get_processor_count();
+	}
+	if (worker_count > device_count) {
+		worker_count = device_count;
+	}
+
+	fleet = fleet_context;
+	zero_mem(fleet, sizeof(spdm_fleet_context_t));
+	fleet->device_count = device_count;
+	fleet->worker_count = worker_count;
+	fleet->flow.flags = SPDM_FLEET_FLOW_GET_DIGEST |
+			    SPDM_FLEET_FLOW_GET_CERTIFICATE |
+			    SPDM_FLEET_FLOW_CHALLENGE |
+			    SPDM_FLEET_FLOW_GET_MEASUREMENT;
+	fleet->flow.slot_id = 0;
+	fleet->flow.measurement_hash_type =
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH;
+	fleet->flow.request_attribute = 0;
+	fleet->flow.measurement_operation =
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS;
+	fleet->spdm_context_size =
+		ALIGN_VALUE(spdm_get_context_size(), sizeof(uint64));
+
+	ptr = (uint8 *)fleet_context +
+	      ALIGN_VALUE(sizeof(spdm_fleet_context_t), sizeof(uint64));
+	fleet->worker = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(spdm_fleet_worker_t) * device_count,
+			   sizeof(uint64));
+	fleet->device_report = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(spdm_fleet_device_report_t) * device_count,
+			   sizeof(uint64));
+	fleet->cert_link_cache = ptr;
+	ptr += ALIGN_VALUE(spdm_cert_link_cache_get_size(
+				   SPDM_FLEET_CERT_LINK_CACHE_ENTRY_COUNT),
+			   sizeof(uint64));
+	fleet->spdm_context_buffer = ptr;
+
+	zero_mem(fleet->worker, sizeof(spdm_fleet_worker_t) * device_count);
+	zero_mem(fleet->device_report,
+		 sizeof(spdm_fleet_device_report_t) * device_count);
+	spdm_cert_link_cache_init(fleet->cert_link_cache,
+				  SPDM_FLEET_CERT_LINK_CACHE_ENTRY_COUNT);
+	for (index = 0; index < device_count; index++) {
+		spdm_context = fleet->spdm_context_buffer +
+			       fleet->spdm_context_size * index;
+		spdm_init_context(spdm_context);
+		spdm_set_data(spdm_context, SPDM_DATA_CERT_LINK_CACHE, NULL,
+			      &fleet->cert_link_cache, sizeof(void *));
+	}
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Release the resources held by the SPDM contexts of a fleet.
+
+  The fleet context buffer itself is owned by the caller. spdm_fleet_init_context must be
+  called before it is used again.
+
+  @param  fleet_context                 A pointer to the fleet context.
+**/
+void spdm_fleet_deinit_context(IN void *fleet_context)
+{
+	spdm_fleet_context_t *fleet;
+	uintn index;
+
+	fleet = fleet_context;
+	for (index = 0; index < fleet->device_count; index++) {
+		spdm_deinit_context(fleet->spdm_context_buffer +
+				    fleet->spdm_context_size * index);
+	}
+}
+
+/**
+  Return the SPDM context of a device of a fleet.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  device_index                  The index of the device.
+
+  @return the SPDM context, or NULL if the index is out of range.
+**/
+void *spdm_fleet_get_spdm_context(IN void *fleet_context,
+				  IN uintn device_index)
+{
+	spdm_fleet_context_t *fleet;
+
+	fleet = fleet_context;
+	if (device_index >= fleet->device_count) {
+		return NULL;
+	}
+	return fleet->spdm_context_buffer +
+	       fleet->spdm_context_size * device_index;
+}
+
+/**
+  Return the index of the device whose SPDM context is given.
+
+  It can be used in the device IO functions to find the device of an SPDM context.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  spdm_context                  A pointer to an SPDM context of the fleet.
+
+  @return the index of the device, or (uintn)-1 if the SPDM context is not in the fleet.
+**/
+uintn spdm_fleet_get_device_index(IN void *fleet_context,
+				  IN void *spdm_context)
+{
+	spdm_fleet_context_t *fleet;
+	uintn offset;
+
+	fleet = fleet_context;
+	if ((uint8 *)spdm_context < fleet->spdm_context_buffer) {
+		return (uintn)-1;
+	}
+	offset = (uint8 *)spdm_context - fleet->spdm_context_buffer;
+	if ((offset % fleet->spdm_context_size != 0) ||
+	    (offset / fleet->spdm_context_size >= fleet->device_count)) {
+		return (uintn)-1;
+	}
+	return offset / fleet->spdm_context_size;
+}
+
+/**
+  Set the attestation flow run for each device.
+
+  The default flow is GET_DIGEST, GET_CERTIFICATE, CHALLENGE of slot 0 without measurement
+  summary hash, and GET_MEASUREMENT of all measurements without signature.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  flow                         The attestation flow.
+**/
+void spdm_fleet_set_flow(IN void *fleet_context,
+			 IN const spdm_fleet_flow_t *flow)
+{
+	spdm_fleet_context_t *fleet;
+
+	fleet = fleet_context;
+	copy_mem(&fleet->flow, flow, sizeof(spdm_fleet_flow_t));
+}
+
+/**
+  Run one phase of the attestation flow for a device.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  spdm_context                  A pointer to the SPDM context of the device.
+  @param  phase                        The phase to run.
+  @param  device_report                 The report of the device.
+
+  @return the status of the phase.
+**/
+return_status spdm_fleet_run_phase(IN spdm_fleet_context_t *fleet_context,
+				   IN void *spdm_context,
+				   IN spdm_fleet_phase_t phase,
+				   IN OUT spdm_fleet_device_report_t *device_report)
+{
+	spdm_fleet_flow_t *flow;
+
+	flow = &fleet_context->flow;
+	switch (phase) {
+	case SPDM_FLEET_PHASE_INIT_CONNECTION:
+		return spdm_init_connection(spdm_context, FALSE);
+	case SPDM_FLEET_PHASE_GET_DIGEST:
+		return spdm_get_digest(spdm_context, &device_report->slot_mask,
+				       device_report->total_digest_buffer);
+	case SPDM_FLEET_PHASE_GET_CERTIFICATE:
+		device_report->cert_chain_size =
+			sizeof(device_report->cert_chain);
+		return spdm_get_certificate(spdm_context, flow->slot_id,
+					    &device_report->cert_chain_size,
+					    device_report->cert_chain);
+	case SPDM_FLEET_PHASE_CHALLENGE:
+		return spdm_challenge(spdm_context, flow->slot_id,
+				      flow->measurement_hash_type,
+				      device_report->measurement_hash);
+	case SPDM_FLEET_PHASE_GET_MEASUREMENT:
+		device_report->measurement_record_length =
+			sizeof(device_report->measurement_record);
+		return spdm_get_measurement(
+			spdm_context, NULL, flow->request_attribute,
+			flow->measurement_operation, flow->slot_id,
+			&device_report->number_of_blocks,
+			&device_report->measurement_record_length,
+			device_report->measurement_record);
+	default:
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
+	}
+}
+
+/**
+  Attest one device of a fleet, and fill its device report.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  device_index                  The index of the device.
+  @param  worker_index                  The index of the worker attesting the device.
+**/
+void spdm_fleet_attest_device(IN spdm_fleet_context_t *fleet_context,
+			      IN uintn device_index, IN uintn worker_index)
+{
+	spdm_fleet_device_report_t *device_report;
+	void *spdm_context;
+	spdm_fleet_phase_t phase;
+	return_status status;
+	uint64 start_time;
+	uint64 phase_start_time;
+	uint32 phase_flag[SPDM_FLEET_PHASE_MAX] = {
+		0,
+		SPDM_FLEET_FLOW_GET_DIGEST,
+		SPDM_FLEET_FLOW_GET_CERTIFICATE,
+		SPDM_FLEET_FLOW_CHALLENGE,
+		SPDM_FLEET_FLOW_GET_MEASUREMENT,
+	};
+
+	device_report = &fleet_context->device_report[device_index];
+	spdm_context = spdm_fleet_get_spdm_context(fleet_context, device_index);
+
+	zero_mem(device_report, sizeof(spdm_fleet_device_report_t));
+	device_report->status = RETURN_SUCCESS;
+	device_report->failed_phase = SPDM_FLEET_PHASE_MAX;
+	device_report->worker_index = worker_index;
+
+	start_time = get_time_stamp_us();
+	for (phase = SPDM_FLEET_PHASE_INIT_CONNECTION;
+	     phase < SPDM_FLEET_PHASE_MAX; phase++) {
+		if ((phase_flag[phase] != 0) &&
+		    ((fleet_context->flow.flags & phase_flag[phase]) == 0)) {
+			continue;
+		}
+		phase_start_time = get_time_stamp_us();
+		status = spdm_fleet_run_phase(fleet_context, spdm_context,
+					      phase, device_report);
+		device_report->phase_time_us[phase] =
+			get_time_stamp_us() - phase_start_time;
+		if (RETURN_ERROR(status)) {
+			DEBUG((DEBUG_INFO,
+			       "spdm_fleet_attest_device[%x] phase %x - %p\n",
+			       device_index, phase, status));
+			device_report->status = status;
+			device_report->failed_phase = phase;
+			break;
+		}
+	}
+	device_report->total_time_us = get_time_stamp_us() - start_time;
+}
+
+/**
+  The entry point of a fleet worker.
+
+  A worker attests the devices whose index is the worker index modulo the worker count,
+  so each SPDM context is only used by one worker.
+
+  @param  context                      A pointer to the worker.
+**/
+void spdm_fleet_worker_entry(IN void *context)
+{
+	spdm_fleet_worker_t *worker;
+	spdm_fleet_context_t *fleet;
+	uintn device_index;
+
+	worker = context;
+	fleet = worker->fleet_context;
+	for (device_index = worker->worker_index;
+	     device_index < fleet->device_count;
+	     device_index += fleet->worker_count) {
+		spdm_fleet_attest_device(fleet, device_index,
+					 worker->worker_index);
+	}
+}
+
+/**
+  Attest all devices of a fleet.
+
+  Each device runs spdm_init_connection, then the phases of the flow in order, and stops
+  at the first failed phase. The workers run in parallel, and this function returns when
+  all devices are attested. A worker whose thread cannot be created runs on the calling thread.
+  The verified certificate link cache is locked by a mutex while the workers run. The lock of
+  the private key cache of the device secret library must be registered by the integrator.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  report                       The report of the run. The device reports are owned by the fleet
+                                       context and are valid until the next run.
+
+  @retval RETURN_SUCCESS               All devices are attested successfully.
+  @retval RETURN_DEVICE_ERROR          At least one device fails. The report tells which.
+**/
+return_status spdm_fleet_run(IN void *fleet_context,
+			     OUT spdm_fleet_report_t *report)
+{
+	spdm_fleet_context_t *fleet;
+	spdm_fleet_worker_t *worker;
+	spdm_fleet_device_report_t *device_report;
+	void *cert_link_cache_mutex;
+	uint64 start_time;
+	uintn index;
+	uintn phase;
+
+	fleet = fleet_context;
+	start_time = get_time_stamp_us();
+
+	//
+	// Without the mutex, all workers run on the calling thread.
+	//
+	cert_link_cache_mutex = NULL;
+	if (fleet->worker_count > 1) {
+		cert_link_cache_mutex = mutex_create();
+	}
+	if (cert_link_cache_mutex != NULL) {
+		spdm_cert_link_cache_register_lock_func(
+			fleet->cert_link_cache, mutex_acquire, mutex_release,
+			cert_link_cache_mutex);
+	}
+
+	//
+	// Worker 0 runs on the calling thread.
+	//
+	for (index = 0; index < fleet->worker_count; index++) {
+		worker = &fleet->worker[index];
+		worker->fleet_context = fleet;
+		worker->worker_index = index;
+		worker->thread = NULL;
+		if ((index != 0) && (cert_link_cache_mutex != NULL)) {
+			worker->thread = thread_create(spdm_fleet_worker_entry,
+						       worker);
+		}
+	}
+	for (index = 0; index < fleet->worker_count; index++) {
+		worker = &fleet->worker[index];
+		if (worker->thread == NULL) {
+			spdm_fleet_worker_entry(worker);
+		}
+	}
+	for (index = 0; index < fleet->worker_count; index++) {
+		worker = &fleet->worker[index];
+		if (worker->thread != NULL) {
+			thread_join(worker->thread);
+			worker->thread = NULL;
+		}
+	}
+	if (cert_link_cache_mutex != NULL) {
+		spdm_cert_link_cache_register_lock_func(fleet->cert_link_cache,
+							NULL, NULL, NULL);
+		mutex_free(cert_link_cache_mutex);
+	}
+
+	zero_mem(report, sizeof(spdm_fleet_report_t));
+	report->elapsed_time_us = get_time_stamp_us() - start_time;
+	report->device_count = fleet->device_count;
+	report->worker_count = fleet->worker_count;
+	report->device_report = fleet->device_report;
+	spdm_cert_link_cache_get_statistics(fleet->cert_link_cache,
+					    &report->cert_link_cache_hit_count,
+					    &report->cert_link_cache_miss_count);
+	for (index = 0; index < fleet->device_count; index++) {
+		device_report = &fleet->device_report[index];
+		if (!RETURN_ERROR(device_report->status)) {
+			report->success_count++;
+		}
+		for (phase = 0; phase < SPDM_FLEET_PHASE_MAX; phase++) {
+			report->phase_time_us[phase] +=
+				device_report->phase_time_us[phase];
+		}
+	}
+
+	if (report->success_count != report->device_count) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return RETURN_SUCCESS;
+}
@@ -0,0 +1,47 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __SPDM_FLEET_LIB_INTERNAL_H__
+#define __SPDM_FLEET_LIB_INTERNAL_H__
+
+#include <library/spdm_fleet_lib.h>
+#include <library/threadlib.h>
+#include "spdm_common_lib_internal.h"
+
+typedef struct {
+	void *fleet_context;
+	uintn worker_index;
+	void *thread;
+} spdm_fleet_worker_t;
+
+typedef struct {
+	uintn device_count;
+	uintn worker_count;
+	spdm_fleet_flow_t flow;
+	spdm_fleet_worker_t *worker;
+	spdm_fleet_device_report_t *device_report;
+	//
+	// Verified certificate link cache shared by all SPDM contexts.
+	//
+	void *cert_link_cache;
+	//
+	// SPDM contexts of all devices, spdm_context_size bytes each.
+	//
+	uintn spdm_context_size;
+	uint8 *spdm_context_buffer;
+} spdm_fleet_context_t;
+
+/**
+  Attest one device of a fleet, and fill its device report.
+
+  @param  fleet_context                 A pointer to the fleet context.
+  @param  device_index                  The index of the device.
+  @param  worker_index                  The index of the worker attesting the device.
+**/
+void spdm_fleet_attest_device(IN spdm_fleet_context_t *fleet_context,
+			      IN uintn device_index, IN uintn worker_index);
+
+#endif
@@ -0,0 +1,695 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_requester_lib_internal.h"
+
+/**
+  Return the size in bytes of an SPDM operation object.
+
+  @return the size in bytes of an SPDM operation object.
+**/
+uintn spdm_op_get_size(void)
+{
+	return sizeof(spdm_op_context_t);
+}
+
+/**
+  Initialize the common part of an operation object.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  op_type                       The type of the operation.
+**/
+void spdm_op_init_common(IN OUT spdm_op_context_t *op,
+			 IN spdm_context_t *spdm_context,
+			 IN spdm_op_type_t op_type)
+{
+	zero_mem(op, sizeof(spdm_op_context_t));
+	op->spdm_context = spdm_context;
+	op->op_type = op_type;
+	op->op_status = SPDM_OP_STATUS_DONE;
+	op->status = RETURN_NOT_STARTED;
+}
+
+/**
+  Initialize an operation that sends GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHM.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_version_only              If TRUE, only GET_VERSION is sent.
+**/
+void spdm_op_init_connection(IN OUT void *op, IN void *spdm_context,
+			     IN boolean get_version_only)
+{
+	spdm_op_context_t *spdm_op;
+
+	spdm_op = op;
+	spdm_op_init_common(spdm_op, spdm_context,
+			    SPDM_OP_TYPE_INIT_CONNECTION);
+	spdm_op->get_version_only = get_version_only;
+}
+
+/**
+  Initialize an operation that sends GET_DIGEST.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_mask                     The slots which deploy the CertificateChain.
+  @param  total_digest_buffer            A pointer to a destination buffer to store the digest buffer.
+**/
+void spdm_op_init_get_digest(IN OUT void *op, IN void *spdm_context,
+			     OUT uint8 *slot_mask,
+			     OUT void *total_digest_buffer)
+{
+	spdm_op_context_t *spdm_op;
+
+	spdm_op = op;
+	spdm_op_init_common(spdm_op, spdm_context, SPDM_OP_TYPE_GET_DIGEST);
+	spdm_op->slot_mask = slot_mask;
+	spdm_op->total_digest_buffer = total_digest_buffer;
+}
+
+/**
+  Initialize an operation that sends GET_CERTIFICATE for the whole certificate chain.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+**/
+void spdm_op_init_get_certificate(IN OUT void *op, IN void *spdm_context,
+				  IN uint8 slot_id,
+				  IN OUT uintn *cert_chain_size,
+				  OUT void *cert_chain)
+{
+	spdm_op_context_t *spdm_op;
+
+	spdm_op = op;
+	spdm_op_init_common(spdm_op, spdm_context,
+			    SPDM_OP_TYPE_GET_CERTIFICATE);
+	spdm_op->slot_id = slot_id;
+	spdm_op->cert_chain_size = cert_chain_size;
+	spdm_op->cert_chain = cert_chain;
+}
+
+/**
+  Initialize an operation that sends CHALLENGE.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+**/
+void spdm_op_init_challenge(IN OUT void *op, IN void *spdm_context,
+			    IN uint8 slot_id, IN uint8 measurement_hash_type,
+			    OUT void *measurement_hash)
+{
+	spdm_op_context_t *spdm_op;
+
+	spdm_op = op;
+	spdm_op_init_common(spdm_op, spdm_context, SPDM_OP_TYPE_CHALLENGE);
+	spdm_op->slot_id = slot_id;
+	spdm_op->measurement_hash_type = measurement_hash_type;
+	spdm_op->measurement_hash = measurement_hash;
+}
+
+/**
+  Initialize an operation that sends GET_MEASUREMENT.
+
+  @param  op                           A pointer to the operation object.
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+**/
+void spdm_op_init_get_measurement(IN OUT void *op, IN void *spdm_context,
+				  IN uint32 *session_id OPTIONAL,
+				  IN uint8 request_attribute,
+				  IN uint8 measurement_operation,
+				  IN uint8 slot_id, OUT uint8 *number_of_blocks,
+				  IN OUT uint32 *measurement_record_length,
+				  OUT void *measurement_record)
+{
+	spdm_op_context_t *spdm_op;
+
+	spdm_op = op;
+	spdm_op_init_common(spdm_op, spdm_context,
+			    SPDM_OP_TYPE_GET_MEASUREMENT);
+	if (session_id != NULL) {
+		spdm_op->use_session = TRUE;
+		spdm_op->session_id = *session_id;
+	}
+	spdm_op->request_attribute = request_attribute;
+	spdm_op->measurement_operation = measurement_operation;
+	spdm_op->slot_id = slot_id;
+	spdm_op->number_of_blocks = number_of_blocks;
+	spdm_op->measurement_record_length = measurement_record_length;
+	spdm_op->measurement_record = measurement_record;
+}
+
+/**
+  Complete an operation.
+
+  @param  op                           A pointer to the operation object.
+  @param  status                       The result of the operation.
+
+  @return SPDM_OP_STATUS_DONE
+**/
+spdm_op_status_t spdm_op_complete(IN OUT spdm_op_context_t *op,
+				  IN return_status status)
+{
+	DEBUG((DEBUG_INFO, "spdm_op_complete - (0x%x) %p\n", op->op_type,
+	       status));
+	op->op_status = SPDM_OP_STATUS_DONE;
+	op->status = status;
+	return SPDM_OP_STATUS_DONE;
+}
+
+/**
+  Return the session ID of an operation, or NULL if the operation is not in a session.
+**/
+uint32 *spdm_op_get_session_id(IN spdm_op_context_t *op)
+{
+	return op->use_session ? &op->session_id : NULL;
+}
+
+/**
+  Build a request of an operation and send it to the device.
+
+  For GET_CERTIFICATE, the next portion of the certificate chain is requested.
+
+  @param  op                           A pointer to the operation object.
+  @param  request_code                  The request to send.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The request is sent.
+  @retval SPDM_OP_STATUS_DONE          The request cannot be built or sent, and the operation is complete.
+**/
+spdm_op_status_t spdm_op_send_request(IN OUT spdm_op_context_t *op,
+				      IN uint8 request_code)
+{
+	return_status status;
+	spdm_context_t *spdm_context;
+
+	spdm_context = op->spdm_context;
+	switch (request_code) {
+	case SPDM_GET_VERSION:
+		status = spdm_build_get_version_request(
+			spdm_context, op->request, &op->request_size);
+		break;
+	case SPDM_GET_CAPABILITIES:
+		status = spdm_build_get_capabilities_request(
+			spdm_context, op->request, &op->request_size);
+		break;
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		status = spdm_build_negotiate_algorithms_request(
+			spdm_context, op->request, &op->request_size);
+		break;
+	case SPDM_GET_DIGESTS:
+		status = spdm_build_get_digest_request(
+			spdm_context, op->request, &op->request_size);
+		break;
+	case SPDM_GET_CERTIFICATE:
+		status = spdm_build_get_certificate_request(
+			spdm_context, op->slot_id,
+			MAX_SPDM_CERT_CHAIN_BLOCK_LEN,
+			&op->certificate_chain_buffer, op->request,
+			&op->request_size);
+		break;
+	case SPDM_CHALLENGE:
+		status = spdm_build_challenge_request(
+			spdm_context, op->slot_id, op->measurement_hash_type,
+			NULL, NULL, op->request, &op->request_size);
+		break;
+	case SPDM_GET_MEASUREMENTS:
+		status = spdm_build_get_measurement_request(
+			spdm_context, spdm_op_get_session_id(op),
+			op->request_attribute, op->measurement_operation,
+			op->slot_id, NULL, NULL, op->request,
+			&op->request_size);
+		break;
+	default:
+		ASSERT(FALSE);
+		status = RETURN_UNSUPPORTED;
+		break;
+	}
+	if (RETURN_ERROR(status)) {
+		return spdm_op_complete(op, status);
+	}
+
+	op->request_code = request_code;
+	status = spdm_send_spdm_request(spdm_context,
+					spdm_op_get_session_id(op),
+					op->request_size, op->request);
+	if (RETURN_ERROR(status)) {
+		return spdm_op_complete(op, RETURN_DEVICE_ERROR);
+	}
+	return SPDM_OP_STATUS_WOULD_BLOCK;
+}
+
+/**
+  Send the first request of the current step of an operation.
+
+  The step is restarted from the beginning, the same as the blocking API does on retry.
+
+  @param  op                           A pointer to the operation object.
+  @param  request_code                  The first request of the step.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The request is sent.
+  @retval SPDM_OP_STATUS_DONE          The request cannot be built or sent, and the operation is complete.
+**/
+spdm_op_status_t spdm_op_start_step(IN OUT spdm_op_context_t *op,
+				    IN uint8 request_code)
+{
+	return_status status;
+
+	if (request_code == SPDM_GET_CERTIFICATE) {
+		status = spdm_begin_get_certificate(op->spdm_context,
+						    op->slot_id);
+		if (RETURN_ERROR(status)) {
+			return spdm_op_complete(op, status);
+		}
+		init_managed_buffer(&op->certificate_chain_buffer,
+				    MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	}
+	return spdm_op_send_request(op, request_code);
+}
+
+/**
+  Send RESPOND_IF_READY for the request which got RESPONSE_NOT_READY.
+
+  The original request is kept in the operation object for the response processing.
+
+  @param  op                           A pointer to the operation object.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The RESPOND_IF_READY is sent.
+  @retval SPDM_OP_STATUS_DONE          The request cannot be sent.
+**/
+spdm_op_status_t spdm_op_send_respond_if_ready(IN OUT spdm_op_context_t *op)
+{
+	return_status status;
+	spdm_context_t *spdm_context;
+	spdm_response_if_ready_request_t spdm_request;
+
+	spdm_context = op->spdm_context;
+	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
+		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	} else {
+		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	}
+	spdm_request.header.request_response_code = SPDM_RESPOND_IF_READY;
+	spdm_request.header.param1 = spdm_context->error_data.request_code;
+	spdm_request.header.param2 = spdm_context->error_data.token;
+	status = spdm_send_spdm_request(spdm_context,
+					spdm_op_get_session_id(op),
+					sizeof(spdm_request), &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return spdm_op_complete(op, RETURN_DEVICE_ERROR);
+	}
+	op->respond_if_ready = TRUE;
+	op->respond_if_ready_count++;
+	return SPDM_OP_STATUS_WOULD_BLOCK;
+}
+
+/**
+  Defer the next request of an operation until a wait is over.
+
+  The request is sent by spdm_op_poll once the wait is over, or now if there is no wait.
+
+  @param  op                           A pointer to the operation object.
+  @param  wait_us                       The time to wait in microseconds.
+  @param  respond_if_ready              TRUE to send RESPOND_IF_READY, FALSE to retry request_code.
+
+  @retval SPDM_OP_STATUS_WAIT          The request is sent by spdm_op_poll after the wait.
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   There is no wait, and the request is sent.
+  @retval SPDM_OP_STATUS_DONE          There is no wait, and the request cannot be sent.
+**/
+spdm_op_status_t spdm_op_wait(IN OUT spdm_op_context_t *op,
+			      IN uint64 wait_us, IN boolean respond_if_ready)
+{
+	spdm_context_t *spdm_context;
+	uint64 now;
+
+	if (wait_us == 0) {
+		if (respond_if_ready) {
+			return spdm_op_send_respond_if_ready(op);
+		}
+		return spdm_op_start_step(op, op->request_code);
+	}
+
+	spdm_context = op->spdm_context;
+	op->op_status = SPDM_OP_STATUS_WAIT;
+	op->wait_respond_if_ready = respond_if_ready;
+	op->wait_reported = FALSE;
+	op->wait_us = wait_us;
+	if (spdm_context->get_time_us != NULL) {
+		now = spdm_context->get_time_us(spdm_context);
+		if (wait_us > MAX_UINT64 - now) {
+			op->wait_until_us = MAX_UINT64;
+		} else {
+			op->wait_until_us = now + wait_us;
+		}
+	}
+	return SPDM_OP_STATUS_WAIT;
+}
+
+/**
+  Handle RESPONSE_NOT_READY for the request in flight or for RESPOND_IF_READY.
+
+  RESPOND_IF_READY is sent after the RDT of the responder, and sent again while the
+  responder answers RESPONSE_NOT_READY, up to RDTM times, the same as the blocking API.
+
+  @param  op                           A pointer to the operation object.
+  @param  response_size                 The size in bytes of the ERROR response.
+
+  @retval SPDM_OP_STATUS_WAIT          The RESPOND_IF_READY is sent by spdm_op_poll after the RDT.
+  @retval SPDM_OP_STATUS_DONE          The ERROR response is invalid, the responder is not ready
+                                       after RDTM polls, or the deadline would be passed.
+**/
+spdm_op_status_t spdm_op_respond_if_ready(IN OUT spdm_op_context_t *op,
+					  IN uintn response_size)
+{
+	spdm_context_t *spdm_context;
+	spdm_error_data_response_not_ready_t *extend_error_data;
+	uint64 rdt_us;
+
+	spdm_context = op->spdm_context;
+	if (response_size < sizeof(spdm_error_response_t) +
+				    sizeof(spdm_error_data_response_not_ready_t)) {
+		return spdm_op_complete(op, RETURN_DEVICE_ERROR);
+	}
+	extend_error_data =
+		(spdm_error_data_response_not_ready_t
+			 *)(op->response + sizeof(spdm_error_response_t));
+	if (extend_error_data->request_code != op->request_code) {
+		return spdm_op_complete(op, RETURN_DEVICE_ERROR);
+	}
+	if (!op->respond_if_ready) {
+		spdm_context->error_data.rd_exponent =
+			extend_error_data->rd_exponent;
+		spdm_context->error_data.request_code =
+			extend_error_data->request_code;
+		spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
+		op->respond_if_ready_count = 0;
+	} else if (op->respond_if_ready_count >=
+		   spdm_context->error_data.rd_tm) {
+		return spdm_op_complete(op, RETURN_DEVICE_ERROR);
+	}
+	spdm_context->error_data.token = extend_error_data->token;
+	op->respond_if_ready = FALSE;
+
+	rdt_us = spdm_exponent_to_us(spdm_context->error_data.rd_exponent);
+	if (spdm_retry_deadline_passed(spdm_context, rdt_us)) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_op RESPOND_IF_READY - deadline passed\n"));
+		return spdm_op_complete(op, RETURN_DEVICE_ERROR);
+	}
+	return spdm_op_wait(op, rdt_us, TRUE);
+}
+
+/**
+  Process the response of the current request, and send the next request of the operation.
+
+  @param  op                           A pointer to the operation object.
+  @param  response_size                 The size in bytes of the response.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The next request is sent.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete.
+**/
+spdm_op_status_t spdm_op_process_response(IN OUT spdm_op_context_t *op,
+					  IN uintn response_size)
+{
+	return_status status;
+	spdm_context_t *spdm_context;
+	boolean basic_mut_auth_req;
+	uint64 wait_us;
+
+	spdm_context = op->spdm_context;
+	switch (op->request_code) {
+	case SPDM_GET_VERSION:
+		status = spdm_process_version_response(
+			spdm_context, op->request, op->request_size,
+			response_size, op->response);
+		break;
+	case SPDM_GET_CAPABILITIES:
+		status = spdm_process_capabilities_response(
+			spdm_context, op->request, op->request_size,
+			response_size, op->response);
+		break;
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		status = spdm_process_algorithms_response(
+			spdm_context, op->request, op->request_size,
+			response_size, op->response);
+		break;
+	case SPDM_GET_DIGESTS:
+		status = spdm_process_digests_response(
+			spdm_context, op->request, op->request_size,
+			response_size, op->response, op->slot_mask,
+			op->total_digest_buffer);
+		break;
+	case SPDM_GET_CERTIFICATE:
+		status = spdm_process_certificate_response(
+			spdm_context, op->slot_id, op->request,
+			op->request_size, response_size, op->response,
+			&op->certificate_chain_buffer);
+		break;
+	case SPDM_CHALLENGE:
+		status = spdm_process_challenge_auth_response(
+			spdm_context, op->slot_id, op->measurement_hash_type,
+			op->request, op->request_size, response_size,
+			op->response, op->measurement_hash, NULL,
+			&basic_mut_auth_req);
+		break;
+	case SPDM_GET_MEASUREMENTS:
+		status = spdm_process_measurements_response(
+			spdm_context, spdm_op_get_session_id(op),
+			op->request_attribute, op->measurement_operation,
+			op->slot_id, op->request, op->request_size,
+			response_size, op->response, op->number_of_blocks,
+			op->measurement_record_length, op->measurement_record,
+			NULL);
+		break;
+	default:
+		ASSERT(FALSE);
+		status = RETURN_UNSUPPORTED;
+		break;
+	}
+
+	if (status == RETURN_NO_RESPONSE) {
+		//
+		// BUSY: retry the step after the backoff, the same as the blocking API.
+		// The operation never blocks, so spdm_op_poll sends the retry once the
+		// backoff is over.
+		//
+		if (!spdm_retry_next(spdm_context, &op->retry_state, &wait_us)) {
+			return spdm_op_complete(op, status);
+		}
+		return spdm_op_wait(op, wait_us, FALSE);
+	}
+	if (RETURN_ERROR(status)) {
+		return spdm_op_complete(op, status);
+	}
+
+	spdm_retry_start(spdm_context, &op->retry_state);
+	switch (op->request_code) {
+	case SPDM_GET_VERSION:
+		if (op->get_version_only) {
+			break;
+		}
+		return spdm_op_start_step(op, SPDM_GET_CAPABILITIES);
+	case SPDM_GET_CAPABILITIES:
+		return spdm_op_start_step(op, SPDM_NEGOTIATE_ALGORITHMS);
+	case SPDM_GET_CERTIFICATE:
+		if (((spdm_certificate_response_t *)op->response)
+			    ->remainder_length != 0) {
+			return spdm_op_send_request(op, SPDM_GET_CERTIFICATE);
+		}
+		status = spdm_end_get_certificate(
+			spdm_context, op->slot_id,
+			&op->certificate_chain_buffer, op->cert_chain_size,
+			op->cert_chain, NULL, NULL);
+		return spdm_op_complete(op, status);
+	case SPDM_CHALLENGE:
+		if (basic_mut_auth_req) {
+			//
+			// The encapsulated flow is only supported by the blocking API.
+			//
+			spdm_reset_message_c(spdm_context);
+			return spdm_op_complete(op, RETURN_UNSUPPORTED);
+		}
+		break;
+	default:
+		break;
+	}
+	return spdm_op_complete(op, RETURN_SUCCESS);
+}
+
+/**
+  Start an operation by sending its first request.
+
+  @param  op                           A pointer to the operation object.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The request is sent and the operation waits for the response.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete. The result can be got via spdm_op_poll.
+**/
+spdm_op_status_t spdm_op_start(IN OUT void *op)
+{
+	spdm_op_context_t *spdm_op;
+	uint8 request_code;
+
+	spdm_op = op;
+	switch (spdm_op->op_type) {
+	case SPDM_OP_TYPE_INIT_CONNECTION:
+		request_code = SPDM_GET_VERSION;
+		break;
+	case SPDM_OP_TYPE_GET_DIGEST:
+		request_code = SPDM_GET_DIGESTS;
+		break;
+	case SPDM_OP_TYPE_GET_CERTIFICATE:
+		request_code = SPDM_GET_CERTIFICATE;
+		break;
+	case SPDM_OP_TYPE_CHALLENGE:
+		request_code = SPDM_CHALLENGE;
+		break;
+	case SPDM_OP_TYPE_GET_MEASUREMENT:
+		request_code = SPDM_GET_MEASUREMENTS;
+		break;
+	default:
+		ASSERT(FALSE);
+		return spdm_op_complete(spdm_op, RETURN_UNSUPPORTED);
+	}
+
+	spdm_op->op_status = SPDM_OP_STATUS_WOULD_BLOCK;
+	spdm_op->status = RETURN_NOT_READY;
+	spdm_op->respond_if_ready = FALSE;
+	spdm_op->respond_if_ready_count = 0;
+	spdm_retry_start(spdm_op->spdm_context, &spdm_op->retry_state);
+	return spdm_op_start_step(spdm_op, request_code);
+}
+
+/**
+  Deliver a transport message received from the device to an operation.
+
+  The message is processed, and the next request of the flow is sent if there is one.
+  A message delivered to a complete operation is ignored.
+
+  @param  op                           A pointer to the operation object.
+  @param  message_size                  size in bytes of the transport message.
+  @param  message                      A pointer to the transport message.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The next request is sent and the operation waits for the response.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete. The result can be got via spdm_op_poll.
+**/
+spdm_op_status_t spdm_op_on_message_received(IN OUT void *op,
+					     IN uintn message_size,
+					     IN void *message)
+{
+	spdm_op_context_t *spdm_op;
+	return_status status;
+	spdm_message_header_t *spdm_response;
+	uintn response_size;
+
+	spdm_op = op;
+	if (spdm_op->op_status != SPDM_OP_STATUS_WOULD_BLOCK) {
+		return spdm_op->op_status;
+	}
+
+	response_size = sizeof(spdm_op->response);
+	zero_mem(spdm_op->response, sizeof(spdm_op->response));
+	status = spdm_decode_response(spdm_op->spdm_context,
+				      spdm_op_get_session_id(spdm_op), FALSE,
+				      message_size, message, &response_size,
+				      spdm_op->response);
+	if (RETURN_ERROR(status)) {
+		return spdm_op_complete(spdm_op, RETURN_DEVICE_ERROR);
+	}
+	if (response_size < sizeof(spdm_message_header_t)) {
+		return spdm_op_complete(spdm_op, RETURN_DEVICE_ERROR);
+	}
+	spdm_response = (void *)spdm_op->response;
+
+	if ((spdm_response->request_response_code == SPDM_ERROR) &&
+	    (spdm_response->param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY)) {
+		return spdm_op_respond_if_ready(spdm_op, response_size);
+	}
+	if (spdm_op->respond_if_ready) {
+		spdm_op->respond_if_ready = FALSE;
+		if (spdm_response->request_response_code !=
+		    (spdm_op->request_code & 0x7F)) {
+			return spdm_op_complete(spdm_op, RETURN_DEVICE_ERROR);
+		}
+	}
+
+	return spdm_op_process_response(spdm_op, response_size);
+}
+
+/**
+  Get the progress of an operation, and send the next request of an operation once its wait is over.
+
+  With a clock registered by spdm_register_timer_func, the wait is over when the time is reached.
+  Without a clock, the wait is reported once, and is considered over at the next poll,
+  so the integrator must wait wait_us before it polls again.
+
+  @param  op                           A pointer to the operation object.
+  @param  status                       The result of the operation, if it is complete.
+  @param  wait_us                      The time in microseconds to wait before the next poll, if the
+                                       operation waits. Otherwise 0.
+
+  @retval SPDM_OP_STATUS_WOULD_BLOCK   The operation waits for a response.
+  @retval SPDM_OP_STATUS_DONE          The operation is complete, and status holds the result.
+  @retval SPDM_OP_STATUS_WAIT          The operation waits before the next request, and wait_us holds the time left.
+**/
+spdm_op_status_t spdm_op_poll(IN OUT void *op,
+			      OUT return_status *status OPTIONAL,
+			      OUT uint64 *wait_us OPTIONAL)
+{
+	spdm_op_context_t *spdm_op;
+	spdm_context_t *spdm_context;
+	uint64 left_us;
+	uint64 now;
+
+	spdm_op = op;
+	spdm_context = spdm_op->spdm_context;
+	left_us = 0;
+	if (spdm_op->op_status == SPDM_OP_STATUS_WAIT) {
+		if (spdm_context->get_time_us != NULL) {
+			now = spdm_context->get_time_us(spdm_context);
+			if (now < spdm_op->wait_until_us) {
+				left_us = spdm_op->wait_until_us - now;
+			}
+		} else if (!spdm_op->wait_reported) {
+			left_us = spdm_op->wait_us;
+		}
+		spdm_op->wait_reported = TRUE;
+
+		if (left_us == 0) {
+			spdm_op->op_status = SPDM_OP_STATUS_WOULD_BLOCK;
+			if (spdm_op->wait_respond_if_ready) {
+				spdm_op_send_respond_if_ready(spdm_op);
+			} else {
+				spdm_op_start_step(spdm_op,
+						   spdm_op->request_code);
+			}
+		}
+	}
+
+	if (wait_us != NULL) {
+		*wait_us = left_us;
+	}
+	if ((status != NULL) && (spdm_op->op_status == SPDM_OP_STATUS_DONE)) {
+		*status = spdm_op->status;
+	}
+	return spdm_op->op_status;
+}
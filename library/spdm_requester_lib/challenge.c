@@ -23,51 +23,31 @@ typedef struct {
 #if SPDM_ENABLE_CAPABILITY_CHAL_CAP
 
 /**
-  This function sends CHALLENGE
-  to authenticate the device based upon the key in one slot.
-
-  This function verifies the signature in the challenge auth.
-
-  If basic mutual authentication is requested from the responder,
-  this function also perform the basic mutual authentication.
+  This function builds CHALLENGE.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  slot_id                      The number of slot for the challenge.
   @param  measurement_hash_type          The type of the measurement hash.
-  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
   @param  requester_nonce_in            A buffer to hold the requester nonce (32 bytes) as input, if not NULL.
   @param  requester_nonce               A buffer to hold the requester nonce (32 bytes), if not NULL.
-  @param  responder_nonce               A buffer to hold the responder nonce (32 bytes), if not NULL.
+  @param  request                      A pointer to a destination buffer to store the request.
+  @param  request_size                  On output, the size in bytes of the request.
 
-  @retval RETURN_SUCCESS               The challenge auth is got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               The CHALLENGE is built.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow CHALLENGE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is out of range.
 **/
-return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
-				 IN uint8 measurement_hash_type,
-				 OUT void *measurement_hash,
-			     IN void *requester_nonce_in OPTIONAL,
-				 OUT void *requester_nonce OPTIONAL,
-				 OUT void *responder_nonce OPTIONAL)
+return_status spdm_build_challenge_request(IN void *context, IN uint8 slot_id,
+					   IN uint8 measurement_hash_type,
+					   IN void *requester_nonce_in OPTIONAL,
+					   OUT void *requester_nonce OPTIONAL,
+					   OUT void *request,
+					   OUT uintn *request_size)
 {
-	return_status status;
-	boolean result;
-	spdm_challenge_request_t spdm_request;
-	spdm_challenge_auth_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint8 *ptr;
-	void *cert_chain_hash;
-	uintn hash_size;
-	uintn measurement_summary_hash_size;
-	void *nonce;
-	void *measurement_summary_hash;
-	uint16 opaque_length;
-	void *opaque;
-	void *signature;
-	uintn signature_size;
+	spdm_challenge_request_t *spdm_request;
 	spdm_context_t *spdm_context;
-	spdm_challenge_auth_response_attribute_t auth_attribute;
 
+	spdm_request = request;
 	spdm_context = context;
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 									SPDM_CHALLENGE);
@@ -85,84 +65,126 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 		return RETURN_INVALID_PARAMETER;
 	}
 	if ((slot_id == 0xFF) &&
-	    (spdm_context->local_context.peer_cert_chain_provision_size == 0)) {
+	    (spdm_context->local_context->peer_cert_chain_provision_size == 0)) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
 	}
-	spdm_request.header.request_response_code = SPDM_CHALLENGE;
-	spdm_request.header.param1 = slot_id;
-	spdm_request.header.param2 = measurement_hash_type;
+	spdm_request->header.request_response_code = SPDM_CHALLENGE;
+	spdm_request->header.param1 = slot_id;
+	spdm_request->header.param2 = measurement_hash_type;
 	if (requester_nonce_in == NULL) {
-		spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request.nonce);
+		spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request->nonce);
 	} else {
-		copy_mem (spdm_request.nonce, requester_nonce_in, SPDM_NONCE_SIZE);
+		copy_mem (spdm_request->nonce, requester_nonce_in, SPDM_NONCE_SIZE);
 	}
 	DEBUG((DEBUG_INFO, "ClientNonce - "));
-	internal_dump_data(spdm_request.nonce, SPDM_NONCE_SIZE);
+	internal_dump_data(spdm_request->nonce, SPDM_NONCE_SIZE);
 	DEBUG((DEBUG_INFO, "\n"));
 	if (requester_nonce != NULL) {
-		copy_mem (requester_nonce, spdm_request.nonce, SPDM_NONCE_SIZE);
+		copy_mem (requester_nonce, spdm_request->nonce, SPDM_NONCE_SIZE);
 	}
 
-	status = spdm_send_spdm_request(spdm_context, NULL,
-					sizeof(spdm_request), &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	*request_size = sizeof(spdm_challenge_request_t);
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes CHALLENGE_AUTH received for CHALLENGE.
+
+  This function verifies the signature in the challenge auth.
+  The basic mutual authentication, if requested from the responder, is left to the caller.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  request                      The CHALLENGE sent to the device.
+  @param  request_size                  The size in bytes of the request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     The response received from the device.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+  @param  responder_nonce               A buffer to hold the responder nonce (32 bytes), if not NULL.
+  @param  basic_mut_auth_req            On output, indicates if basic mutual authentication is requested.
+
+  @retval RETURN_SUCCESS               The CHALLENGE_AUTH is processed.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_process_challenge_auth_response(
+	IN void *context, IN uint8 slot_id, IN uint8 measurement_hash_type,
+	IN void *request, IN uintn request_size, IN uintn response_size,
+	IN OUT void *response, OUT void *measurement_hash,
+	OUT void *responder_nonce OPTIONAL, OUT boolean *basic_mut_auth_req)
+{
+	return_status status;
+	boolean result;
+	spdm_challenge_request_t *spdm_request;
+	spdm_challenge_auth_response_max_t *spdm_response;
+	uintn spdm_response_size;
+	uint8 *ptr;
+	void *cert_chain_hash;
+	uintn hash_size;
+	uintn measurement_summary_hash_size;
+	void *nonce;
+	void *measurement_summary_hash;
+	uint16 opaque_length;
+	void *opaque;
+	void *signature;
+	uintn signature_size;
+	spdm_context_t *spdm_context;
+	spdm_challenge_auth_response_attribute_t auth_attribute;
+	uint64 metrics_begin;
+
+	spdm_context = context;
+	spdm_request = request;
+	spdm_response = response;
+	spdm_response_size = response_size;
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.spdm_version != spdm_request.header.spdm_version) {
+	if (spdm_response->header.spdm_version != spdm_request->header.spdm_version) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, NULL, 
 			&spdm_response_size,
-			&spdm_response, SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH,
+			spdm_response, SPDM_CHALLENGE, SPDM_CHALLENGE_AUTH,
 			sizeof(spdm_challenge_auth_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_CHALLENGE_AUTH) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_challenge_auth_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_challenge_auth_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	*(uint8 *)&auth_attribute = spdm_response.header.param1;
-	if (spdm_response.header.spdm_version == SPDM_MESSAGE_VERSION_11 && slot_id == 0xFF) {
+	*(uint8 *)&auth_attribute = spdm_response->header.param1;
+	if (spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_11 && slot_id == 0xFF) {
 		if (auth_attribute.slot_id != 0xF) {
 			return RETURN_DEVICE_ERROR;
 		}
-		if (spdm_response.header.param2 != 0) {
+		if (spdm_response->header.param2 != 0) {
 			return RETURN_DEVICE_ERROR;
 		}
 	} else {
-		if ((spdm_response.header.spdm_version == SPDM_MESSAGE_VERSION_11 && auth_attribute.slot_id != slot_id) ||
-		    (spdm_response.header.spdm_version == SPDM_MESSAGE_VERSION_10 && *(uint8 *)&auth_attribute != slot_id)) {
+		if ((spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_11 && auth_attribute.slot_id != slot_id) ||
+		    (spdm_response->header.spdm_version == SPDM_MESSAGE_VERSION_10 && *(uint8 *)&auth_attribute != slot_id)) {
 			return RETURN_DEVICE_ERROR;
 		}
-		if (spdm_response.header.param2 != (1 << slot_id)) {
+		if (spdm_response->header.param2 != (1 << slot_id)) {
 			return RETURN_DEVICE_ERROR;
 		}
 	}
@@ -188,15 +210,18 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 		return RETURN_DEVICE_ERROR;
 	}
 
-	ptr = spdm_response.cert_chain_hash;
+	ptr = spdm_response->cert_chain_hash;
 
 	cert_chain_hash = ptr;
 	ptr += hash_size;
 	DEBUG((DEBUG_INFO, "cert_chain_hash (0x%x) - ", hash_size));
 	internal_dump_data(cert_chain_hash, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	result = spdm_verify_certificate_chain_hash(spdm_context,
 						    cert_chain_hash, hash_size);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HASH,
+				metrics_begin);
 	if (!result) {
 		spdm_context->error_state =
 			SPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
@@ -228,8 +253,8 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 	//
 	// Cache data
 	//
-	status = spdm_append_message_c(spdm_context, &spdm_request,
-				       sizeof(spdm_request));
+	status = spdm_append_message_c(spdm_context, spdm_request,
+				       request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -243,7 +268,7 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 			     hash_size + SPDM_NONCE_SIZE +
 			     measurement_summary_hash_size + sizeof(uint16) +
 			     opaque_length + signature_size;
-	status = spdm_append_message_c(spdm_context, &spdm_response,
+	status = spdm_append_message_c(spdm_context, spdm_response,
 				       spdm_response_size - signature_size);
 	if (RETURN_ERROR(status)) {
 		spdm_reset_message_c(spdm_context);
@@ -258,8 +283,11 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 	signature = ptr;
 	DEBUG((DEBUG_INFO, "signature (0x%x):\n", signature_size));
 	internal_dump_hex(signature, signature_size);
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	result = spdm_verify_challenge_auth_signature(
 		spdm_context, TRUE, signature, signature_size);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_ASYM_VERIFY,
+				metrics_begin);
 	if (!result) {
 		spdm_reset_message_c(spdm_context);
 		spdm_context->error_state =
@@ -274,7 +302,84 @@ return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
 			 measurement_summary_hash_size);
 	}
 
-	if (auth_attribute.basic_mut_auth_req == 1) {
+	*basic_mut_auth_req = (boolean)(auth_attribute.basic_mut_auth_req == 1);
+	if (!*basic_mut_auth_req) {
+		spdm_context->connection_info.connection_state =
+			SPDM_CONNECTION_STATE_AUTHENTICATED;
+	}
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function sends CHALLENGE
+  to authenticate the device based upon the key in one slot.
+
+  This function verifies the signature in the challenge auth.
+
+  If basic mutual authentication is requested from the responder,
+  this function also perform the basic mutual authentication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the challenge.
+  @param  measurement_hash_type          The type of the measurement hash.
+  @param  measurement_hash              A pointer to a destination buffer to store the measurement hash.
+  @param  requester_nonce_in            A buffer to hold the requester nonce (32 bytes) as input, if not NULL.
+  @param  requester_nonce               A buffer to hold the requester nonce (32 bytes), if not NULL.
+  @param  responder_nonce               A buffer to hold the responder nonce (32 bytes), if not NULL.
+
+  @retval RETURN_SUCCESS               The challenge auth is got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_challenge(IN void *context, IN uint8 slot_id,
+				 IN uint8 measurement_hash_type,
+				 OUT void *measurement_hash,
+			     IN void *requester_nonce_in OPTIONAL,
+				 OUT void *requester_nonce OPTIONAL,
+				 OUT void *responder_nonce OPTIONAL)
+{
+	return_status status;
+	spdm_challenge_request_t spdm_request;
+	uintn spdm_request_size;
+	spdm_challenge_auth_response_max_t spdm_response;
+	uintn spdm_response_size;
+	boolean basic_mut_auth_req;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_build_challenge_request(spdm_context, slot_id,
+					      measurement_hash_type,
+					      requester_nonce_in,
+					      requester_nonce, &spdm_request,
+					      &spdm_request_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	status = spdm_process_challenge_auth_response(
+		spdm_context, slot_id, measurement_hash_type, &spdm_request,
+		spdm_request_size, spdm_response_size, &spdm_response,
+		measurement_hash, responder_nonce, &basic_mut_auth_req);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	if (basic_mut_auth_req) {
 		DEBUG((DEBUG_INFO, "BasicMutAuth :\n"));
 		status = spdm_encapsulated_request(spdm_context, NULL, 0, NULL);
 		DEBUG((DEBUG_INFO,
@@ -317,19 +422,23 @@ return_status spdm_challenge(IN void *context, IN uint8 slot_id,
 			     OUT void *measurement_hash)
 {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_challenge(spdm_context, slot_id,
 					    measurement_hash_type,
 					    measurement_hash, NULL, NULL, NULL);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_CHALLENGE,
+			       metrics_begin);
 
 	return status;
 }
@@ -363,11 +472,13 @@ return_status spdm_challenge_ex(IN void *context, IN uint8 slot_id,
 			     OUT void *responder_nonce OPTIONAL)
 {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_challenge(spdm_context, slot_id,
 					    measurement_hash_type,
@@ -375,9 +486,11 @@ return_status spdm_challenge_ex(IN void *context, IN uint8 slot_id,
 						requester_nonce_in,
 						requester_nonce, responder_nonce);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_CHALLENGE,
+			       metrics_begin);
 
 	return status;
 }
@@ -44,6 +44,134 @@ return_status spdm_init_connection(IN void *context,
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function resumes a connection whose negotiated state was imported by
+  spdm_import_connection_snapshot, instead of calling spdm_init_connection.
+
+  GET_VERSION, GET_CAPABILITIES and NEGOTIATE_ALGORITHMS are skipped, so the responder
+  must have kept the negotiated state of the connection (CACHE_CAP). A libspdm responder
+  that kept it accepts GET_DIGESTS in any state after NEGOTIATE_ALGORITHMS, and restarts
+  message B and C from message A, see spdm_get_response_digests. A responder that lost it
+  answers GET_DIGESTS with an ERROR, then the caller resets the context and falls back to
+  spdm_init_connection.
+
+  If the snapshot holds a peer certificate chain, this function sends one GET_DIGESTS.
+  If a slot reports the digest of the cached certificate chain, the chain is verified
+  again locally and GET_CERTIFICATE is skipped.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The slot holding the cached certificate chain, if not NULL.
+
+  @retval RETURN_SUCCESS               The connection is resumed. The connection state is
+                                       SPDM_CONNECTION_STATE_AFTER_CERTIFICATE if the certificate
+                                       chain is confirmed, SPDM_CONNECTION_STATE_NEGOTIATED if
+                                       the snapshot holds no certificate chain.
+  @retval RETURN_NOT_READY             No snapshot is imported.
+  @retval RETURN_NOT_FOUND             No slot holds the cached certificate chain. The cached chain
+                                       is dropped and spdm_get_certificate can be called.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device,
+                                       or the responder lost the negotiated state.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_resume_connection(IN void *context,
+				     OUT uint8 *slot_id OPTIONAL)
+{
+	return_status status;
+	spdm_context_t *spdm_context;
+	spdm_connection_info_t *connection_info;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+	uint8 cert_chain_digest[MAX_HASH_SIZE];
+	uintn digest_size;
+	uintn digest_index;
+	uint8 index;
+	boolean result;
+	uint64 metrics_begin;
+
+	spdm_context = context;
+	connection_info = &spdm_context->connection_info;
+
+	if (connection_info->connection_state !=
+	    SPDM_CONNECTION_STATE_NEGOTIATED) {
+		return RETURN_NOT_READY;
+	}
+	if (connection_info->peer_used_cert_chain_buffer_size == 0) {
+		return RETURN_SUCCESS;
+	}
+
+	if (!spdm_hash_cert_chain_buffer(
+		    spdm_context, connection_info->peer_used_cert_chain_buffer,
+		    connection_info->peer_used_cert_chain_buffer_size,
+		    cert_chain_digest)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	status = spdm_get_digest(spdm_context, &slot_mask, total_digest_buffer);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	//
+	// DIGESTS only holds the digests of the slots set in slot_mask.
+	//
+	digest_size = spdm_get_hash_size(connection_info->algorithm.base_hash_algo);
+	digest_index = 0;
+	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
+		if ((slot_mask & (1 << index)) == 0) {
+			continue;
+		}
+		if (const_compare_mem(&total_digest_buffer[digest_size *
+							   digest_index],
+				      cert_chain_digest, digest_size) == 0) {
+			break;
+		}
+		digest_index++;
+	}
+	if (index == MAX_SPDM_SLOT_COUNT) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_resume_connection - cert chain changed\n"));
+		connection_info->peer_used_cert_chain_buffer_size = 0;
+		spdm_register_cert_chain_digest(
+			spdm_context, NULL, 0,
+			&connection_info->peer_used_cert_chain_digest);
+		spdm_free_peer_public_key(spdm_context);
+		return RETURN_NOT_FOUND;
+	}
+
+	//
+	// The snapshot may have been stored outside of the trust boundary.
+	//
+	if (spdm_context->local_context->verify_peer_spdm_cert_chain != NULL) {
+		status = spdm_context->local_context->verify_peer_spdm_cert_chain(
+			spdm_context, index,
+			connection_info->peer_used_cert_chain_buffer_size,
+			connection_info->peer_used_cert_chain_buffer, NULL,
+			NULL);
+		result = !RETURN_ERROR(status);
+	} else {
+		metrics_begin = spdm_metrics_begin(spdm_context);
+		result = spdm_verify_peer_cert_chain_buffer(
+			spdm_context,
+			connection_info->peer_used_cert_chain_buffer,
+			connection_info->peer_used_cert_chain_buffer_size,
+			NULL, NULL);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_CERT_VERIFY,
+					metrics_begin);
+	}
+	if (!result) {
+		spdm_context->error_state =
+			SPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
+		return RETURN_SECURITY_VIOLATION;
+	}
+
+	connection_info->connection_state =
+		SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+	if (slot_id != NULL) {
+		*slot_id = index;
+	}
+	return RETURN_SUCCESS;
+}
+
 /**
   This function sends KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
   to start an SPDM Session.
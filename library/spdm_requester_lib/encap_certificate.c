@@ -61,7 +61,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 
 	slot_id = spdm_request->header.param1;
 
-	if (slot_id >= spdm_context->local_context.slot_count) {
+	if (slot_id >= spdm_context->local_context->slot_count) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 			response_size, response);
@@ -69,7 +69,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 	}
 
 	if (spdm_context->local_context
-					  .local_cert_chain_provision[slot_id] == NULL) {
+					  ->local_cert_chain_provision[slot_id] == NULL) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
 			0, response_size, response);
@@ -83,7 +83,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 	}
 
 	if (offset >= spdm_context->local_context
-			      .local_cert_chain_provision_size[slot_id]) {
+			      ->local_cert_chain_provision_size[slot_id]) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 			response_size, response);
@@ -92,14 +92,14 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 
 	if ((uintn)(offset + length) >
 	    spdm_context->local_context
-		    .local_cert_chain_provision_size[slot_id]) {
+		    ->local_cert_chain_provision_size[slot_id]) {
 		length = (uint16)(
 			spdm_context->local_context
-				.local_cert_chain_provision_size[slot_id] -
+				->local_cert_chain_provision_size[slot_id] -
 			offset);
 	}
 	remainder_length = spdm_context->local_context
-				   .local_cert_chain_provision_size[slot_id] -
+				   ->local_cert_chain_provision_size[slot_id] -
 			   (length + offset);
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
@@ -122,7 +122,7 @@ return_status spdm_get_encap_response_certificate(IN void *context,
 	spdm_response->remainder_length = (uint16)remainder_length;
 	copy_mem(spdm_response + 1,
 		 (uint8 *)spdm_context->local_context
-				 .local_cert_chain_provision[slot_id] +
+				 ->local_cert_chain_provision[slot_id] +
 			 offset,
 		 length);
 	//
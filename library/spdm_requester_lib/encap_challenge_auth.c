@@ -41,6 +41,7 @@ return_status spdm_get_encap_response_challenge_auth(
 	spdm_context_t *spdm_context;
 	spdm_challenge_auth_response_attribute_t auth_attribute;
 	return_status status;
+	uint64 metrics_begin;
 
 	spdm_context = context;
 	spdm_request = request;
@@ -64,7 +65,7 @@ return_status spdm_get_encap_response_challenge_auth(
 	slot_id = spdm_request->header.param1;
 
 	if ((slot_id != 0xFF) &&
-	    (slot_id >= spdm_context->local_context.slot_count)) {
+	    (slot_id >= spdm_context->local_context->slot_count)) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 			response_size, response);
@@ -84,7 +85,7 @@ return_status spdm_get_encap_response_challenge_auth(
 		sizeof(spdm_challenge_auth_response_t) + hash_size +
 		SPDM_NONCE_SIZE + measurement_summary_hash_size +
 		sizeof(uint16) +
-		spdm_context->local_context.opaque_challenge_auth_rsp_size +
+		spdm_context->local_context->opaque_challenge_auth_rsp_size +
 		signature_size;
 
 	ASSERT(*response_size >= total_size);
@@ -106,7 +107,7 @@ return_status spdm_get_encap_response_challenge_auth(
 	if (slot_id == 0xFF) {
 		spdm_response->header.param2 = 0;
 
-		slot_id = spdm_context->local_context.provisioned_slot_id;
+		slot_id = spdm_context->local_context->provisioned_slot_id;
 	}
 
 	ptr = (void *)(spdm_response + 1);
@@ -119,11 +120,11 @@ return_status spdm_get_encap_response_challenge_auth(
 	ptr += measurement_summary_hash_size;
 
 	*(uint16 *)ptr = (uint16)spdm_context->local_context
-				 .opaque_challenge_auth_rsp_size;
+				 ->opaque_challenge_auth_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_challenge_auth_rsp,
-		 spdm_context->local_context.opaque_challenge_auth_rsp_size);
-	ptr += spdm_context->local_context.opaque_challenge_auth_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_challenge_auth_rsp,
+		 spdm_context->local_context->opaque_challenge_auth_rsp_size);
+	ptr += spdm_context->local_context->opaque_challenge_auth_rsp_size;
 
 	//
 	// Calc Sign
@@ -147,7 +148,10 @@ return_status spdm_get_encap_response_challenge_auth(
 		return RETURN_SUCCESS;
 	}
 	result =
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		spdm_generate_challenge_auth_signature(spdm_context, TRUE, ptr);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_ASYM_SIGN,
+					metrics_begin);
 	if (!result) {
 		spdm_generate_encap_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
@@ -66,9 +66,9 @@ return_status spdm_get_encap_response_digest(IN void *context,
 
 	ASSERT(*response_size >=
 	       sizeof(spdm_digest_response_t) +
-		       hash_size * spdm_context->local_context.slot_count);
+		       hash_size * spdm_context->local_context->slot_count);
 	*response_size = sizeof(spdm_digest_response_t) +
-			 hash_size * spdm_context->local_context.slot_count;
+			 hash_size * spdm_context->local_context->slot_count;
 	zero_mem(response, *response_size);
 	spdm_response = response;
 
@@ -82,10 +82,10 @@ return_status spdm_get_encap_response_digest(IN void *context,
 	spdm_response->header.param2 = 0;
 
 	digest = (void *)(spdm_response + 1);
-	for (index = 0; index < spdm_context->local_context.slot_count;
+	for (index = 0; index < spdm_context->local_context->slot_count;
 	     index++) {
 		if (spdm_context->local_context
-						  .local_cert_chain_provision[index] == NULL) {
+						  ->local_cert_chain_provision[index] == NULL) {
 			spdm_generate_encap_error_response(
 				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
 				0, response_size, response);
@@ -355,7 +355,7 @@ return_status spdm_encapsulated_request(IN spdm_context_t *spdm_context,
 							 1);
 					if (*req_slot_id_param >=
 					    spdm_context->local_context
-						    .slot_count) {
+						    ->slot_count) {
 						return RETURN_DEVICE_ERROR;
 					}
 				}
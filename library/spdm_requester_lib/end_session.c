@@ -118,17 +118,17 @@ return_status spdm_send_receive_end_session(IN spdm_context_t *spdm_context,
 					    IN uint32 session_id,
 					    IN uint8 end_session_attributes)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
 
-	retry = spdm_context->retry_times;
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_end_session(
 			spdm_context, session_id, end_session_attributes);
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
 
 	return status;
 }
@@ -47,6 +47,7 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 	boolean result;
 	uint8 th2_hash_data[64];
 	spdm_session_state_t session_state;
+	uint64 metrics_begin;
 
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
@@ -74,7 +75,7 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 
 	if (session_info->mut_auth_requested != 0) {
 		if ((req_slot_id_param >=
-		     spdm_context->local_context.slot_count) &&
+		     spdm_context->local_context->slot_count) &&
 		    (req_slot_id_param != 0xFF)) {
 			return RETURN_INVALID_PARAMETER;
 		}
@@ -103,16 +104,16 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 
 	if (req_slot_id_param == 0xFF) {
 		req_slot_id_param =
-			spdm_context->local_context.provisioned_slot_id;
+			spdm_context->local_context->provisioned_slot_id;
 	}
 
 	if (session_info->mut_auth_requested) {
 		spdm_context->connection_info.local_used_cert_chain_buffer =
 			spdm_context->local_context
-				.local_cert_chain_provision[req_slot_id_param];
+				->local_cert_chain_provision[req_slot_id_param];
 		spdm_context->connection_info.local_used_cert_chain_buffer_size =
 			spdm_context->local_context
-				.local_cert_chain_provision_size
+				->local_cert_chain_provision_size
 					[req_slot_id_param];
 	}
 
@@ -128,8 +129,11 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		return RETURN_SECURITY_VIOLATION;
 	}
 	if (session_info->mut_auth_requested) {
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		result = spdm_generate_finish_req_signature(spdm_context,
 							    session_info, ptr);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_ASYM_SIGN,
+					metrics_begin);
 		if (!result) {
 			return RETURN_SECURITY_VIOLATION;
 		}
@@ -141,7 +145,10 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		ptr += signature_size;
 	}
 
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	result = spdm_generate_finish_req_hmac(spdm_context, session_info, ptr);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HMAC,
+				metrics_begin);
 	if (!result) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -210,9 +217,12 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP)) {
 		DEBUG((DEBUG_INFO, "verify_data (0x%x):\n", hmac_size));
 		internal_dump_hex(spdm_response.verify_data, hmac_size);
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		result = spdm_verify_finish_rsp_hmac(spdm_context, session_info,
 						     spdm_response.verify_data,
 						     hmac_size);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HMAC,
+					metrics_begin);
 		if (!result) {
 			return RETURN_SECURITY_VIOLATION;
 		}
@@ -228,13 +238,19 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 	}
 
 	DEBUG((DEBUG_INFO, "spdm_generate_session_data_key[%x]\n", session_id));
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_calculate_th2_hash(spdm_context, session_info, TRUE,
 					 th2_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HASH,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_generate_session_data_key(
 		session_info->secured_message_context, th2_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -251,17 +267,21 @@ return_status spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 				       IN uint32 session_id,
 				       IN uint8 req_slot_id_param)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_finish(spdm_context, session_id,
 						      req_slot_id_param);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_FINISH,
+			       metrics_begin);
 
 	return status;
 }
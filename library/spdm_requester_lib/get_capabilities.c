@@ -89,20 +89,22 @@ boolean spdm_check_response_flag_compability(IN uint32 capabilities_flag,
 }
 
 /**
-  This function sends GET_CAPABILITIES and receives CAPABILITIES.
+  This function builds GET_CAPABILITIES.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the request.
+  @param  request_size                  On output, the size in bytes of the request.
 
-  @retval RETURN_SUCCESS               The GET_CAPABILITIES is sent and the CAPABILITIES is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The GET_CAPABILITIES is built.
+  @retval RETURN_UNSUPPORTED           The connection state does not allow GET_CAPABILITIES.
 **/
-return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
+return_status spdm_build_get_capabilities_request(IN spdm_context_t *spdm_context,
+						  OUT void *request,
+						  OUT uintn *request_size)
 {
-	return_status status;
-	spdm_get_capabilities_request spdm_request;
-	uintn spdm_request_size;
-	spdm_capabilities_response spdm_response;
-	uintn spdm_response_size;
+	spdm_get_capabilities_request *spdm_request;
+
+	spdm_request = request;
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 								SPDM_GET_CAPABILITIES);
@@ -111,82 +113,99 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 		return RETURN_UNSUPPORTED;
 	}
 
-	zero_mem(&spdm_request, sizeof(spdm_request));
+	zero_mem(spdm_request, sizeof(spdm_get_capabilities_request));
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-		spdm_request_size = sizeof(spdm_request);
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		*request_size = sizeof(spdm_get_capabilities_request);
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-		spdm_request_size = sizeof(spdm_request.header);
-	}
-	spdm_request.header.request_response_code = SPDM_GET_CAPABILITIES;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
-	spdm_request.ct_exponent =
-		spdm_context->local_context.capability.ct_exponent;
-	spdm_request.flags = spdm_context->local_context.capability.flags;
-	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
-					&spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		*request_size = sizeof(spdm_request->header);
 	}
+	spdm_request->header.request_response_code = SPDM_GET_CAPABILITIES;
+	spdm_request->header.param1 = 0;
+	spdm_request->header.param2 = 0;
+	spdm_request->ct_exponent =
+		spdm_context->local_context->capability.ct_exponent;
+	spdm_request->flags = spdm_context->local_context->capability.flags;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes CAPABILITIES received for GET_CAPABILITIES.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      The GET_CAPABILITIES sent to the device.
+  @param  request_size                  The size in bytes of the request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     The response received from the device.
+
+  @retval RETURN_SUCCESS               The CAPABILITIES is processed.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status spdm_process_capabilities_response(IN spdm_context_t *spdm_context,
+						 IN void *request,
+						 IN uintn request_size,
+						 IN uintn response_size,
+						 IN OUT void *response)
+{
+	return_status status;
+	spdm_get_capabilities_request *spdm_request;
+	spdm_capabilities_response *spdm_response;
+	uintn spdm_response_size;
+
+	spdm_request = request;
+	spdm_response = response;
+	spdm_response_size = response_size;
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_simple_error_response(
-			spdm_context, spdm_response.header.param1);
+			spdm_context, spdm_response->header.param1);
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_CAPABILITIES) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_capabilities_response)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_capabilities_response)) {
 		return RETURN_DEVICE_ERROR;
 	}
 	//Check if received message version matches sent message version
-	if (spdm_request.header.spdm_version !=
-	    spdm_response.header.spdm_version) {
+	if (spdm_request->header.spdm_version !=
+	    spdm_response->header.spdm_version) {
 		return RETURN_DEVICE_ERROR;
 	}
 	spdm_response_size = sizeof(spdm_capabilities_response);
 
 	if (!spdm_check_response_flag_compability(
-		    spdm_response.flags, spdm_response.header.spdm_version)) {
+		    spdm_response->flags, spdm_response->header.spdm_version)) {
 		return RETURN_DEVICE_ERROR;
 	}
 
 	//
 	// Cache data
 	//
-	status = spdm_append_message_a(spdm_context, &spdm_request,
-				       spdm_request_size);
+	status = spdm_append_message_a(spdm_context, spdm_request,
+				       request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_a(spdm_context, &spdm_response,
+	status = spdm_append_message_a(spdm_context, spdm_response,
 				       spdm_response_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
 	spdm_context->connection_info.capability.ct_exponent =
-		spdm_response.ct_exponent;
-	spdm_context->connection_info.capability.flags = spdm_response.flags;
+		spdm_response->ct_exponent;
+	spdm_context->connection_info.capability.flags = spdm_response->flags;
 
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
@@ -194,6 +213,48 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_CAPABILITIES and receives CAPABILITIES.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The GET_CAPABILITIES is sent and the CAPABILITIES is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_get_capabilities_request spdm_request;
+	uintn spdm_request_size;
+	spdm_capabilities_response spdm_response;
+	uintn spdm_response_size;
+
+	status = spdm_build_get_capabilities_request(spdm_context, &spdm_request,
+						     &spdm_request_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_capabilities_response(spdm_context, &spdm_request,
+						  spdm_request_size,
+						  spdm_response_size,
+						  &spdm_response);
+}
+
 /**
   This function sends GET_CAPABILITIES and receives CAPABILITIES.
 
@@ -204,16 +265,20 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 **/
 return_status spdm_get_capabilities(IN spdm_context_t *spdm_context)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_get_capabilities(spdm_context);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_VCA,
+			       metrics_begin);
 
 	return status;
 }
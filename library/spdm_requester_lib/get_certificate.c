@@ -20,41 +20,18 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends GET_CERTIFICATE
-  to get certificate chain in one slot from device.
-
-  This function verify the integrity of the certificate chain.
-  root_hash -> Root certificate -> Intermediate certificate -> Leaf certificate.
-
-  If the peer root certificate hash is deployed,
-  this function also verifies the digest with the root hash in the certificate chain.
+  This function checks that GET_CERTIFICATE may be sent, before the first block
+  of a certificate chain is requested.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  slot_id                      The number of slot for the certificate chain.
-  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
-  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
-                                       On output, indicate the size in bytes of the certificate chain.
-  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
-  @param  trust_anchor                  A buffer to hold the trust_anchor which is used to validate the peer certificate, if not NULL.
-  @param  trust_anchor_size             A buffer to hold the trust_anchor_size, if not NULL.
 
-  @retval RETURN_SUCCESS               The certificate chain is got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               GET_CERTIFICATE may be sent.
+  @retval RETURN_UNSUPPORTED           The capabilities or the connection state do not allow GET_CERTIFICATE.
+  @retval RETURN_INVALID_PARAMETER     The slot_id is out of range.
 **/
-return_status try_spdm_get_certificate(IN void *context, IN uint8 slot_id,
-				       IN uint16 length,
-				       IN OUT uintn *cert_chain_size,
-				       OUT void *cert_chain,
-				       OUT void **trust_anchor OPTIONAL,
-				       OUT uintn *trust_anchor_size OPTIONAL)
+return_status spdm_begin_get_certificate(IN void *context, IN uint8 slot_id)
 {
-	boolean result;
-	return_status status;
-	spdm_get_certificate_request_t spdm_request;
-	spdm_certificate_response_max_t spdm_response;
-	uintn spdm_response_size;
-	large_managed_buffer_t certificate_chain_buffer;
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
@@ -74,180 +51,322 @@ return_status try_spdm_get_certificate(IN void *context, IN uint8 slot_id,
 		return RETURN_UNSUPPORTED;
 	}
 
-	init_managed_buffer(&certificate_chain_buffer,
-			    MAX_SPDM_MESSAGE_BUFFER_SIZE);
-	length = MIN(length, MAX_SPDM_CERT_CHAIN_BLOCK_LEN);
-
 	if (slot_id >= MAX_SPDM_SLOT_COUNT) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
 	spdm_context->error_state = SPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
+	return RETURN_SUCCESS;
+}
 
-	do {
-		if (spdm_is_version_supported(spdm_context,
-					      SPDM_MESSAGE_VERSION_11)) {
-			spdm_request.header.spdm_version =
-				SPDM_MESSAGE_VERSION_11;
-		} else {
-			spdm_request.header.spdm_version =
-				SPDM_MESSAGE_VERSION_10;
-		}
-		spdm_request.header.request_response_code =
-			SPDM_GET_CERTIFICATE;
-		spdm_request.header.param1 = slot_id;
-		spdm_request.header.param2 = 0;
-		spdm_request.offset = (uint16)get_managed_buffer_size(
-			&certificate_chain_buffer);
-		spdm_request.length = length;
-		DEBUG((DEBUG_INFO, "request (offset 0x%x, size 0x%x):\n",
-		       spdm_request.offset, spdm_request.length));
+/**
+  This function builds GET_CERTIFICATE for the next block of a certificate chain.
 
-		status = spdm_send_spdm_request(spdm_context, NULL,
-						sizeof(spdm_request),
-						&spdm_request);
-		if (RETURN_ERROR(status)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
+  @param  certificate_chain_buffer       The blocks of the certificate chain received so far.
+  @param  request                      A pointer to a destination buffer to store the request.
+  @param  request_size                  On output, the size in bytes of the request.
 
-		spdm_response_size = sizeof(spdm_response);
-		zero_mem(&spdm_response, sizeof(spdm_response));
-		status = spdm_receive_spdm_response(spdm_context, NULL,
-						    &spdm_response_size,
-						    &spdm_response);
-		if (RETURN_ERROR(status)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size < sizeof(spdm_message_header_t)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response.header.request_response_code == SPDM_ERROR) {
-			status = spdm_handle_error_response_main(
-				spdm_context, NULL,
-				&spdm_response_size,
-				&spdm_response, SPDM_GET_CERTIFICATE,
-				SPDM_CERTIFICATE,
-				sizeof(spdm_certificate_response_max_t));
-			if (RETURN_ERROR(status)) {
-				goto done;
-			}
-		} else if (spdm_response.header.request_response_code !=
-			   SPDM_CERTIFICATE) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size < sizeof(spdm_certificate_response_t)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size > sizeof(spdm_response)) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response.portion_length >
-		    MAX_SPDM_CERT_CHAIN_BLOCK_LEN) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response.header.param1 != slot_id) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		if (spdm_response_size < sizeof(spdm_certificate_response_t) +
-						 spdm_response.portion_length) {
-			status = RETURN_DEVICE_ERROR;
-			goto done;
-		}
-		spdm_response_size = sizeof(spdm_certificate_response_t) +
-				     spdm_response.portion_length;
-		//
-		// Cache data
-		//
-		status = spdm_append_message_b(spdm_context, &spdm_request,
-					       sizeof(spdm_request));
-		if (RETURN_ERROR(status)) {
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
-		}
-		status = spdm_append_message_b(spdm_context, &spdm_response,
-					       spdm_response_size);
-		if (RETURN_ERROR(status)) {
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
-		}
+  @retval RETURN_SUCCESS               The GET_CERTIFICATE is built.
+**/
+return_status spdm_build_get_certificate_request(
+	IN void *context, IN uint8 slot_id, IN uint16 length,
+	IN large_managed_buffer_t *certificate_chain_buffer, OUT void *request,
+	OUT uintn *request_size)
+{
+	spdm_get_certificate_request_t *spdm_request;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_request = request;
+
+	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	} else {
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	}
+	spdm_request->header.request_response_code = SPDM_GET_CERTIFICATE;
+	spdm_request->header.param1 = slot_id;
+	spdm_request->header.param2 = 0;
+	spdm_request->offset =
+		(uint16)get_managed_buffer_size(certificate_chain_buffer);
+	spdm_request->length = MIN(length, MAX_SPDM_CERT_CHAIN_BLOCK_LEN);
+	DEBUG((DEBUG_INFO, "request (offset 0x%x, size 0x%x):\n",
+	       spdm_request->offset, spdm_request->length));
+	*request_size = sizeof(spdm_get_certificate_request_t);
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes CERTIFICATE received for GET_CERTIFICATE,
+  and appends the block to the certificate chain.
 
-		DEBUG((DEBUG_INFO, "Certificate (offset 0x%x, size 0x%x):\n",
-		       spdm_request.offset, spdm_response.portion_length));
-		internal_dump_hex(spdm_response.cert_chain,
-				  spdm_response.portion_length);
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  request                      The GET_CERTIFICATE sent to the device.
+  @param  request_size                  The size in bytes of the request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     The response received from the device.
+  @param  certificate_chain_buffer       The blocks of the certificate chain received so far.
 
-		status = append_managed_buffer(&certificate_chain_buffer,
-					       spdm_response.cert_chain,
-					       spdm_response.portion_length);
+  @retval RETURN_SUCCESS               The CERTIFICATE is processed.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_process_certificate_response(
+	IN void *context, IN uint8 slot_id, IN void *request,
+	IN uintn request_size, IN uintn response_size, IN OUT void *response,
+	IN OUT large_managed_buffer_t *certificate_chain_buffer)
+{
+	return_status status;
+	spdm_get_certificate_request_t *spdm_request;
+	spdm_certificate_response_max_t *spdm_response;
+	uintn spdm_response_size;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_request = request;
+	spdm_response = response;
+	spdm_response_size = response_size;
+
+	if (spdm_response_size < sizeof(spdm_message_header_t)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
+		status = spdm_handle_error_response_main(
+			spdm_context, NULL,
+			&spdm_response_size,
+			spdm_response, SPDM_GET_CERTIFICATE,
+			SPDM_CERTIFICATE,
+			sizeof(spdm_certificate_response_max_t));
 		if (RETURN_ERROR(status)) {
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
+			return status;
 		}
-		spdm_context->connection_info.connection_state =
-			SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+	} else if (spdm_response->header.request_response_code !=
+		   SPDM_CERTIFICATE) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response_size < sizeof(spdm_certificate_response_t)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response_size > sizeof(spdm_certificate_response_max_t)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response->portion_length > MAX_SPDM_CERT_CHAIN_BLOCK_LEN) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response->header.param1 != slot_id) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (spdm_response_size < sizeof(spdm_certificate_response_t) +
+					 spdm_response->portion_length) {
+		return RETURN_DEVICE_ERROR;
+	}
+	spdm_response_size = sizeof(spdm_certificate_response_t) +
+			     spdm_response->portion_length;
+	//
+	// Cache data
+	//
+	status = spdm_append_message_b(spdm_context, spdm_request,
+				       request_size);
+	if (RETURN_ERROR(status)) {
+		return RETURN_SECURITY_VIOLATION;
+	}
+	status = spdm_append_message_b(spdm_context, spdm_response,
+				       spdm_response_size);
+	if (RETURN_ERROR(status)) {
+		return RETURN_SECURITY_VIOLATION;
+	}
 
-	} while (spdm_response.remainder_length != 0);
+	DEBUG((DEBUG_INFO, "Certificate (offset 0x%x, size 0x%x):\n",
+	       spdm_request->offset, spdm_response->portion_length));
+	internal_dump_hex(spdm_response->cert_chain,
+			  spdm_response->portion_length);
+
+	status = append_managed_buffer(certificate_chain_buffer,
+				       spdm_response->cert_chain,
+				       spdm_response->portion_length);
+	if (RETURN_ERROR(status)) {
+		return RETURN_SECURITY_VIOLATION;
+	}
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function verifies the certificate chain once all blocks are received,
+  and returns it to the caller.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  certificate_chain_buffer       The received certificate chain.
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+  @param  trust_anchor                  A buffer to hold the trust_anchor which is used to validate the peer certificate, if not NULL.
+  @param  trust_anchor_size             A buffer to hold the trust_anchor_size, if not NULL.
+
+  @retval RETURN_SUCCESS               The certificate chain is verified.
+  @retval RETURN_BUFFER_TOO_SMALL      The cert_chain buffer is too small.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_end_get_certificate(
+	IN void *context, IN uint8 slot_id,
+	IN large_managed_buffer_t *certificate_chain_buffer,
+	IN OUT uintn *cert_chain_size, OUT void *cert_chain,
+	OUT void **trust_anchor OPTIONAL, OUT uintn *trust_anchor_size OPTIONAL)
+{
+	boolean result;
+	return_status status;
+	spdm_context_t *spdm_context;
+	uint64 metrics_begin;
 
-	if (spdm_context->local_context.verify_peer_spdm_cert_chain != NULL) {
-		status = spdm_context->local_context.verify_peer_spdm_cert_chain (
-			spdm_context, slot_id, get_managed_buffer_size(&certificate_chain_buffer),
-			get_managed_buffer(&certificate_chain_buffer),
+	spdm_context = context;
+	if (spdm_context->local_context->verify_peer_spdm_cert_chain != NULL) {
+		status = spdm_context->local_context->verify_peer_spdm_cert_chain (
+			spdm_context, slot_id, get_managed_buffer_size(certificate_chain_buffer),
+			get_managed_buffer(certificate_chain_buffer),
 			trust_anchor, trust_anchor_size);
 		if (RETURN_ERROR(status)) {
 			spdm_context->error_state =
 				SPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
+			return RETURN_SECURITY_VIOLATION;
 		}
 	} else {
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		result = spdm_verify_peer_cert_chain_buffer(
-			spdm_context, get_managed_buffer(&certificate_chain_buffer),
-			get_managed_buffer_size(&certificate_chain_buffer),
+			spdm_context, get_managed_buffer(certificate_chain_buffer),
+			get_managed_buffer_size(certificate_chain_buffer),
 			trust_anchor, trust_anchor_size);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_CERT_VERIFY,
+					metrics_begin);
 		if (!result) {
 			spdm_context->error_state =
 				SPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
-			status = RETURN_SECURITY_VIOLATION;
-			goto done;
+			return RETURN_SECURITY_VIOLATION;
 		}
 	}
 
 	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
-		get_managed_buffer_size(&certificate_chain_buffer);
+		get_managed_buffer_size(certificate_chain_buffer);
 	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
-		 get_managed_buffer(&certificate_chain_buffer),
-		 get_managed_buffer_size(&certificate_chain_buffer));
+		 get_managed_buffer(certificate_chain_buffer),
+		 get_managed_buffer_size(certificate_chain_buffer));
+	spdm_register_cert_chain_digest(
+		spdm_context,
+		spdm_context->connection_info.peer_used_cert_chain_buffer,
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		&spdm_context->connection_info.peer_used_cert_chain_digest);
+	spdm_free_peer_public_key(spdm_context);
 
 	spdm_context->error_state = SPDM_STATUS_SUCCESS;
 
 	if (cert_chain_size != NULL) {
 		if (*cert_chain_size <
-		    get_managed_buffer_size(&certificate_chain_buffer)) {
+		    get_managed_buffer_size(certificate_chain_buffer)) {
 			*cert_chain_size = get_managed_buffer_size(
-				&certificate_chain_buffer);
+				certificate_chain_buffer);
 			return RETURN_BUFFER_TOO_SMALL;
 		}
 		*cert_chain_size =
-			get_managed_buffer_size(&certificate_chain_buffer);
+			get_managed_buffer_size(certificate_chain_buffer);
 		if (cert_chain != NULL) {
 			copy_mem(cert_chain,
-				 get_managed_buffer(&certificate_chain_buffer),
+				 get_managed_buffer(certificate_chain_buffer),
 				 get_managed_buffer_size(
-					 &certificate_chain_buffer));
+					 certificate_chain_buffer));
 		}
 	}
 
-	status = RETURN_SUCCESS;
-done:
-	return status;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function sends GET_CERTIFICATE
+  to get certificate chain in one slot from device.
+
+  This function verify the integrity of the certificate chain.
+  root_hash -> Root certificate -> Intermediate certificate -> Leaf certificate.
+
+  If the peer root certificate hash is deployed,
+  this function also verifies the digest with the root hash in the certificate chain.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  length                       length parameter in the get_certificate message (limited by MAX_SPDM_CERT_CHAIN_BLOCK_LEN).
+  @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
+                                       On output, indicate the size in bytes of the certificate chain.
+  @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
+  @param  trust_anchor                  A buffer to hold the trust_anchor which is used to validate the peer certificate, if not NULL.
+  @param  trust_anchor_size             A buffer to hold the trust_anchor_size, if not NULL.
+
+  @retval RETURN_SUCCESS               The certificate chain is got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_get_certificate(IN void *context, IN uint8 slot_id,
+				       IN uint16 length,
+				       IN OUT uintn *cert_chain_size,
+				       OUT void *cert_chain,
+				       OUT void **trust_anchor OPTIONAL,
+				       OUT uintn *trust_anchor_size OPTIONAL)
+{
+	return_status status;
+	spdm_get_certificate_request_t spdm_request;
+	uintn spdm_request_size;
+	spdm_certificate_response_max_t spdm_response;
+	uintn spdm_response_size;
+	large_managed_buffer_t certificate_chain_buffer;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_begin_get_certificate(spdm_context, slot_id);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	init_managed_buffer(&certificate_chain_buffer,
+			    MAX_SPDM_MESSAGE_BUFFER_SIZE);
+
+	do {
+		spdm_build_get_certificate_request(spdm_context, slot_id,
+						   length,
+						   &certificate_chain_buffer,
+						   &spdm_request,
+						   &spdm_request_size);
+
+		status = spdm_send_spdm_request(spdm_context, NULL,
+						spdm_request_size,
+						&spdm_request);
+		if (RETURN_ERROR(status)) {
+			return RETURN_DEVICE_ERROR;
+		}
+
+		spdm_response_size = sizeof(spdm_response);
+		zero_mem(&spdm_response, sizeof(spdm_response));
+		status = spdm_receive_spdm_response(spdm_context, NULL,
+						    &spdm_response_size,
+						    &spdm_response);
+		if (RETURN_ERROR(status)) {
+			return RETURN_DEVICE_ERROR;
+		}
+
+		status = spdm_process_certificate_response(
+			spdm_context, slot_id, &spdm_request,
+			spdm_request_size, spdm_response_size, &spdm_response,
+			&certificate_chain_buffer);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	} while (spdm_response.remainder_length != 0);
+
+	return spdm_end_get_certificate(spdm_context, slot_id,
+					&certificate_chain_buffer,
+					cert_chain_size, cert_chain,
+					trust_anchor, trust_anchor_size);
 }
 
 /**
@@ -341,18 +460,22 @@ return_status spdm_get_certificate_choose_length(IN void *context,
 						 OUT void *cert_chain)
 {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_get_certificate(spdm_context, slot_id, length,
 						  cert_chain_size, cert_chain, NULL, NULL);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_CERTIFICATE,
+			       metrics_begin);
 
 	return status;
 }
@@ -389,18 +512,22 @@ return_status spdm_get_certificate_choose_length_ex(IN void *context,
 						 OUT uintn *trust_anchor_size)
 {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_get_certificate(spdm_context, slot_id, length,
 						  cert_chain_size, cert_chain, trust_anchor, trust_anchor_size);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_CERTIFICATE,
+			       metrics_begin);
 
 	return status;
 }
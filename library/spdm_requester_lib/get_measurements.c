@@ -24,10 +24,7 @@ typedef struct {
 #if SPDM_ENABLE_CAPABILITY_MEAS_CAP
 
 /**
-  This function sends GET_MEASUREMENT
-  to get measurement from the device.
-
-  If the signature is requested, this function verifies the signature of the measurement.
+  This function builds GET_MEASUREMENT.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
@@ -36,50 +33,27 @@ typedef struct {
   @param  request_attribute             The request attribute of the request message.
   @param  measurement_operation         The measurement operation of the request message.
   @param  slot_id                      The number of slot for the certificate chain.
-  @param  number_of_blocks               The number of blocks of the measurement record.
-  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
-                                       On output, indicate the size in bytes of the measurement record.
-  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
   @param  requester_nonce_in            A buffer to hold the requester nonce (32 bytes) as input, if not NULL.
   @param  requester_nonce               A buffer to hold the requester nonce (32 bytes), if not NULL.
-  @param  responder_nonce               A buffer to hold the responder nonce (32 bytes), if not NULL.
+  @param  request                      A pointer to a destination buffer to store the request.
+  @param  request_size                  On output, the size in bytes of the request.
 
-  @retval RETURN_SUCCESS               The measurement is got successfully.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
-  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+  @retval RETURN_SUCCESS               The GET_MEASUREMENT is built.
+  @retval RETURN_UNSUPPORTED           The capabilities, the connection state or the session state do not allow GET_MEASUREMENT.
+  @retval RETURN_INVALID_PARAMETER     The slot_id or the request attribute is invalid.
 **/
-return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
-				       IN uint8 request_attribute,
-				       IN uint8 measurement_operation,
-				       IN uint8 slot_id_param,
-				       OUT uint8 *number_of_blocks,
-				       IN OUT uint32 *measurement_record_length,
-				       OUT void *measurement_record,
-				       IN void *requester_nonce_in OPTIONAL,
-				       OUT void *requester_nonce OPTIONAL,
-				       OUT void *responder_nonce OPTIONAL)
+return_status spdm_build_get_measurement_request(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 measurement_operation, IN uint8 slot_id_param,
+	IN void *requester_nonce_in OPTIONAL, OUT void *requester_nonce OPTIONAL,
+	OUT void *request, OUT uintn *request_size)
 {
-	boolean result;
-	return_status status;
-	spdm_get_measurements_request_t spdm_request;
-	uintn spdm_request_size;
-	spdm_measurements_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint32 measurement_record_data_length;
-	uint8 *measurement_record_data;
-	spdm_measurement_block_common_header_t *measurement_block_header;
-	uint32 measurement_block_size;
-	uint8 measurement_block_count;
-	uint8 *ptr;
-	void *nonce;
-	uint16 opaque_length;
-	void *opaque;
-	void *signature;
-	uintn signature_size;
+	spdm_get_measurements_request_t *spdm_request;
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
 	spdm_session_state_t session_state;
 
+	spdm_request = request;
 	spdm_context = context;
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE, 0,
@@ -116,7 +90,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		return RETURN_INVALID_PARAMETER;
 	}
 	if ((slot_id_param == 0xF) &&
-	    (spdm_context->local_context.peer_cert_chain_provision_size == 0)) {
+	    (spdm_context->local_context->peer_cert_chain_provision_size == 0)) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
@@ -129,78 +103,136 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	if (request_attribute ==
-	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
-		signature_size = spdm_get_asym_signature_size(
-			spdm_context->connection_info.algorithm.base_asym_algo);
-	} else {
-		signature_size = 0;
-	}
-
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
 	}
-	spdm_request.header.request_response_code = SPDM_GET_MEASUREMENTS;
-	spdm_request.header.param1 = request_attribute;
-	spdm_request.header.param2 = measurement_operation;
+	spdm_request->header.request_response_code = SPDM_GET_MEASUREMENTS;
+	spdm_request->header.param1 = request_attribute;
+	spdm_request->header.param2 = measurement_operation;
 	if (request_attribute ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
 		if (spdm_is_version_supported(spdm_context,
 					      SPDM_MESSAGE_VERSION_11)) {
-			spdm_request_size = sizeof(spdm_request);
+			*request_size = sizeof(spdm_get_measurements_request_t);
 		} else {
-			spdm_request_size = sizeof(spdm_request) -
-					    sizeof(spdm_request.SlotIDParam);
+			*request_size = sizeof(spdm_get_measurements_request_t) -
+					    sizeof(spdm_request->SlotIDParam);
 		}
 
 		if (requester_nonce_in == NULL) {
-			spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request.nonce);
+			spdm_get_random_number(SPDM_NONCE_SIZE, spdm_request->nonce);
 		} else {
-			copy_mem (spdm_request.nonce, requester_nonce_in, SPDM_NONCE_SIZE);
+			copy_mem (spdm_request->nonce, requester_nonce_in, SPDM_NONCE_SIZE);
 		}
 		DEBUG((DEBUG_INFO, "ClientNonce - "));
-		internal_dump_data(spdm_request.nonce, SPDM_NONCE_SIZE);
+		internal_dump_data(spdm_request->nonce, SPDM_NONCE_SIZE);
 		DEBUG((DEBUG_INFO, "\n"));
-		spdm_request.SlotIDParam = slot_id_param;
+		spdm_request->SlotIDParam = slot_id_param;
 
 		if (requester_nonce != NULL) {
-			copy_mem (requester_nonce, spdm_request.nonce, SPDM_NONCE_SIZE);
+			copy_mem (requester_nonce, spdm_request->nonce, SPDM_NONCE_SIZE);
 		}
 	} else {
-		spdm_request_size = sizeof(spdm_request.header);
+		*request_size = sizeof(spdm_request->header);
 
 		if (requester_nonce != NULL) {
 			zero_mem (requester_nonce, SPDM_NONCE_SIZE);
 		}
 	}
-	status = spdm_send_spdm_request(spdm_context, session_id,
-					spdm_request_size, &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes MEASUREMENTS received for GET_MEASUREMENT.
+
+  If the signature is requested, this function verifies the signature of the measurement.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  request                      The GET_MEASUREMENT sent to the device.
+  @param  request_size                  The size in bytes of the request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     The response received from the device.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+  @param  responder_nonce               A buffer to hold the responder nonce (32 bytes), if not NULL.
+
+  @retval RETURN_SUCCESS               The MEASUREMENTS is processed.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_process_measurements_response(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 measurement_operation, IN uint8 slot_id_param, IN void *request,
+	IN uintn request_size, IN uintn response_size, IN OUT void *response,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record, OUT void *responder_nonce OPTIONAL)
+{
+	boolean result;
+	return_status status;
+	spdm_get_measurements_request_t *spdm_request;
+	spdm_measurements_response_max_t *spdm_response;
+	uintn spdm_response_size;
+	uint32 measurement_record_data_length;
+	uint8 *measurement_record_data;
+	spdm_measurement_block_common_header_t *measurement_block_header;
+	uint32 measurement_block_size;
+	uint8 measurement_block_count;
+	uint8 *ptr;
+	void *nonce;
+	uint16 opaque_length;
+	void *opaque;
+	void *signature;
+	uintn signature_size;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint64 metrics_begin;
+
+	spdm_context = context;
+	spdm_request = request;
+	spdm_response = response;
+	spdm_response_size = response_size;
+
+	if (session_id == NULL) {
+		session_info = NULL;
+	} else {
+		session_info = spdm_get_session_info_via_session_id(
+			spdm_context, *session_id);
+		if (session_info == NULL) {
+			return RETURN_UNSUPPORTED;
+		}
 	}
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, session_id, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
+	if (request_attribute ==
+	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
+		signature_size = spdm_get_asym_signature_size(
+			spdm_context->connection_info.algorithm.base_asym_algo);
+	} else {
+		signature_size = 0;
 	}
+
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_error_response_main(
 			spdm_context, session_id,
-			&spdm_response_size, &spdm_response,
+			&spdm_response_size, spdm_response,
 			SPDM_GET_MEASUREMENTS, SPDM_MEASUREMENTS,
 			sizeof(spdm_measurements_response_max_t));
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_MEASUREMENTS) {
 		spdm_reset_message_m(spdm_context, session_info);
 		return RETURN_DEVICE_ERROR;
@@ -208,29 +240,29 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 	if (spdm_response_size < sizeof(spdm_measurements_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_measurements_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
 
 	if (measurement_operation ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
-		if (spdm_response.number_of_blocks != 0) {
+		if (spdm_response->number_of_blocks != 0) {
 			spdm_reset_message_m(spdm_context, session_info);
 			return RETURN_DEVICE_ERROR;
 		}
 	} else if (measurement_operation ==
 		   SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
-		if (spdm_response.number_of_blocks == 0) {
+		if (spdm_response->number_of_blocks == 0) {
 			return RETURN_DEVICE_ERROR;
 		}
 	} else {
-		if (spdm_response.number_of_blocks != 1) {
+		if (spdm_response->number_of_blocks != 1) {
 			return RETURN_DEVICE_ERROR;
 		}
 	}
 
 	measurement_record_data_length =
-		spdm_read_uint24(spdm_response.measurement_record_length);
+		spdm_read_uint24(spdm_response->measurement_record_length);
 	if (measurement_operation ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
 		if (measurement_record_data_length != 0) {
@@ -244,14 +276,14 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 			return RETURN_DEVICE_ERROR;
 		}
 		if (measurement_record_data_length >=
-		    sizeof(spdm_response.measurement_record)) {
+		    sizeof(spdm_response->measurement_record)) {
 			return RETURN_DEVICE_ERROR;
 		}
 		DEBUG((DEBUG_INFO, "measurement_record_length - 0x%06x\n",
 		       measurement_record_data_length));
 	}
 
-	measurement_record_data = spdm_response.measurement_record;
+	measurement_record_data = spdm_response->measurement_record;
 
 	if (request_attribute ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
@@ -264,7 +296,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		}
 		if (spdm_is_version_supported(spdm_context,
 					      SPDM_MESSAGE_VERSION_11) &&
-		    spdm_response.header.param2 != slot_id_param) {
+		    spdm_response->header.param2 != slot_id_param) {
 			spdm_reset_message_m(spdm_context, session_info);
 			return RETURN_SECURITY_VIOLATION;
 		}
@@ -297,13 +329,13 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		//
 		// Cache data
 		//
-		status = spdm_append_message_m(spdm_context, session_info, &spdm_request,
-						spdm_request_size);
+		status = spdm_append_message_m(spdm_context, session_info, spdm_request,
+						request_size);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		status = spdm_append_message_m(spdm_context, session_info, &spdm_response,
+		status = spdm_append_message_m(spdm_context, session_info, spdm_response,
 					       spdm_response_size -
 						       signature_size);
 		if (RETURN_ERROR(status)) {
@@ -320,8 +352,11 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		DEBUG((DEBUG_INFO, "signature (0x%x):\n", signature_size));
 		internal_dump_hex(signature, signature_size);
 
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		result = spdm_verify_measurement_signature(
 			spdm_context, session_info, signature, signature_size);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_ASYM_VERIFY,
+					metrics_begin);
 		if (!result) {
 			spdm_context->error_state =
 				SPDM_STATUS_ERROR_MEASUREMENT_AUTH_FAILURE;
@@ -366,13 +401,13 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		//
 		// Cache data
 		//
-		status = spdm_append_message_m(spdm_context, session_info, &spdm_request,
-						spdm_request_size);
+		status = spdm_append_message_m(spdm_context, session_info, spdm_request,
+						request_size);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		status = spdm_append_message_m(spdm_context, session_info, &spdm_response,
+		status = spdm_append_message_m(spdm_context, session_info, spdm_response,
 					       spdm_response_size);
 		if (RETURN_ERROR(status)) {
 			spdm_reset_message_m(spdm_context, session_info);
@@ -382,7 +417,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 
 	if (measurement_operation ==
 	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
-		*number_of_blocks = spdm_response.header.param1;
+		*number_of_blocks = spdm_response->header.param1;
 		if (*number_of_blocks == 0xFF) {
 			// the number of block cannot be 0xFF, because index 0xFF will brings confusing.
 			return RETURN_DEVICE_ERROR;
@@ -392,7 +427,7 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 			return RETURN_DEVICE_ERROR;
 		}
 	} else {
-		*number_of_blocks = spdm_response.number_of_blocks;
+		*number_of_blocks = spdm_response->number_of_blocks;
 		if (*measurement_record_length <
 		    measurement_record_data_length) {
 			return RETURN_BUFFER_TOO_SMALL;
@@ -459,6 +494,80 @@ return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_MEASUREMENT
+  to get measurement from the device.
+
+  If the signature is requested, this function verifies the signature of the measurement.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the request message.
+  @param  measurement_operation         The measurement operation of the request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  number_of_blocks               The number of blocks of the measurement record.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+  @param  requester_nonce_in            A buffer to hold the requester nonce (32 bytes) as input, if not NULL.
+  @param  requester_nonce               A buffer to hold the requester nonce (32 bytes), if not NULL.
+  @param  responder_nonce               A buffer to hold the responder nonce (32 bytes), if not NULL.
+
+  @retval RETURN_SUCCESS               The measurement is got successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_get_measurement(IN void *context, IN uint32 *session_id,
+				       IN uint8 request_attribute,
+				       IN uint8 measurement_operation,
+				       IN uint8 slot_id_param,
+				       OUT uint8 *number_of_blocks,
+				       IN OUT uint32 *measurement_record_length,
+				       OUT void *measurement_record,
+				       IN void *requester_nonce_in OPTIONAL,
+				       OUT void *requester_nonce OPTIONAL,
+				       OUT void *responder_nonce OPTIONAL)
+{
+	return_status status;
+	spdm_get_measurements_request_t spdm_request;
+	uintn spdm_request_size;
+	spdm_measurements_response_max_t spdm_response;
+	uintn spdm_response_size;
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	status = spdm_build_get_measurement_request(
+		spdm_context, session_id, request_attribute,
+		measurement_operation, slot_id_param, requester_nonce_in,
+		requester_nonce, &spdm_request, &spdm_request_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, session_id,
+					spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, session_id, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_measurements_response(
+		spdm_context, session_id, request_attribute,
+		measurement_operation, slot_id_param, &spdm_request,
+		spdm_request_size, spdm_response_size, &spdm_response,
+		number_of_blocks, measurement_record_length,
+		measurement_record, responder_nonce);
+}
+
 /**
   This function sends GET_MEASUREMENT
   to get measurement from the device.
@@ -490,11 +599,11 @@ return_status spdm_get_measurement(IN void *context, IN uint32 *session_id,
 				   OUT void *measurement_record)
 {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_get_measurement(
 			spdm_context, session_id, request_attribute,
@@ -503,7 +612,7 @@ return_status spdm_get_measurement(IN void *context, IN uint32 *session_id,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
 
 	return status;
 }
@@ -544,11 +653,11 @@ return_status spdm_get_measurement_ex(IN void *context, IN uint32 *session_id,
 				   OUT void *requester_nonce OPTIONAL,
 				   OUT void *responder_nonce OPTIONAL) {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_get_measurement(
 			spdm_context, session_id, request_attribute,
@@ -559,7 +668,253 @@ return_status spdm_get_measurement_ex(IN void *context, IN uint32 *session_id,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+
+	return status;
+}
+
+/**
+  This function sends one GET_MEASUREMENT per index in index_list
+  to get these measurements from the device.
+
+  Up to request_pipeline_depth requests (SPDM_DATA_REQUEST_PIPELINE_DEPTH) are sent before the
+  first response is received. The responses are processed in request order.
+  Only the request for the last index carries request_attribute, so that the signature covers
+  the whole batch.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the last request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  index_count                   The number of measurement indices in index_list.
+  @param  index_list                    The measurement indices to get, in order.
+                                       The index 0xFF gets all the measurement blocks.
+  @param  number_of_blocks               The number of blocks of the measurement record, the sum of the
+                                       blocks of all the responses.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+                                       The blocks are stored in index_list order.
+
+  @retval RETURN_SUCCESS               The measurements are got successfully.
+  @retval RETURN_INVALID_PARAMETER     index_list is empty or contains the index 0.
+  @retval RETURN_BUFFER_TOO_SMALL      The blocks do not fit in measurement_record or number_of_blocks.
+  @retval RETURN_NO_RESPONSE           The device is busy.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status try_spdm_get_measurement_batch(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 slot_id_param, IN uintn index_count, IN const uint8 *index_list,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record)
+{
+	return_status status;
+	return_status batch_status;
+	spdm_get_measurements_request_t
+		spdm_request[MAX_SPDM_REQUEST_PIPELINE_DEPTH];
+	uintn spdm_request_size[MAX_SPDM_REQUEST_PIPELINE_DEPTH];
+	spdm_measurements_response_max_t spdm_response;
+	uintn spdm_response_size;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uintn pipeline_depth;
+	uintn send_index;
+	uintn receive_index;
+	uintn slot;
+	uint8 attribute;
+	uint8 block_count;
+	uintn total_block_count;
+	uint32 record_size;
+	uint32 block_record_length;
+
+	spdm_context = context;
+	if ((index_count == 0) || (index_count > 0xFE)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	for (send_index = 0; send_index < index_count; send_index++) {
+		if (index_list[send_index] == 0) {
+			return RETURN_INVALID_PARAMETER;
+		}
+	}
+	if (session_id == NULL) {
+		session_info = NULL;
+	} else {
+		session_info = spdm_get_session_info_via_session_id(
+			spdm_context, *session_id);
+		if (session_info == NULL) {
+			return RETURN_UNSUPPORTED;
+		}
+	}
+
+	pipeline_depth = spdm_context->local_context->request_pipeline_depth;
+	ASSERT((pipeline_depth != 0) &&
+	       (pipeline_depth <= MAX_SPDM_REQUEST_PIPELINE_DEPTH));
+	spdm_reset_message_m(spdm_context, session_info);
+
+	//
+	// Once a request fails, the outstanding responses are still received
+	// and dropped, so that the transport holds no stale response.
+	//
+	batch_status = RETURN_SUCCESS;
+	total_block_count = 0;
+	record_size = 0;
+	send_index = 0;
+	receive_index = 0;
+	while (receive_index < index_count) {
+		while ((send_index < index_count) &&
+		       (send_index - receive_index < pipeline_depth) &&
+		       !RETURN_ERROR(batch_status)) {
+			slot = send_index % pipeline_depth;
+			attribute = (send_index == index_count - 1) ?
+					    request_attribute :
+					    0;
+			status = spdm_build_get_measurement_request(
+				spdm_context, session_id, attribute,
+				index_list[send_index], slot_id_param, NULL,
+				NULL, &spdm_request[slot],
+				&spdm_request_size[slot]);
+			if (RETURN_ERROR(status)) {
+				batch_status = status;
+				break;
+			}
+			status = spdm_send_spdm_request(spdm_context,
+							session_id,
+							spdm_request_size[slot],
+							&spdm_request[slot]);
+			if (RETURN_ERROR(status)) {
+				batch_status = RETURN_DEVICE_ERROR;
+				break;
+			}
+			send_index++;
+		}
+		if (receive_index == send_index) {
+			break;
+		}
+
+		spdm_response_size = sizeof(spdm_response);
+		zero_mem(&spdm_response, sizeof(spdm_response));
+		status = spdm_receive_spdm_response(spdm_context, session_id,
+						    &spdm_response_size,
+						    &spdm_response);
+		if (RETURN_ERROR(status)) {
+			batch_status = RETURN_DEVICE_ERROR;
+			break;
+		}
+		slot = receive_index % pipeline_depth;
+		receive_index++;
+		if (RETURN_ERROR(batch_status)) {
+			continue;
+		}
+
+		//
+		// An ERROR may need a retry of its own request, which cannot be done
+		// while later requests are outstanding.
+		//
+		if ((send_index != receive_index) &&
+		    (spdm_response_size >= sizeof(spdm_message_header_t)) &&
+		    (spdm_response.header.request_response_code ==
+		     SPDM_ERROR)) {
+			DEBUG((DEBUG_INFO,
+			       "spdm_get_measurement_batch - ERROR 0x%x in pipeline\n",
+			       spdm_response.header.param1));
+			if (spdm_response.header.param1 ==
+			    SPDM_ERROR_CODE_BUSY) {
+				batch_status = RETURN_NO_RESPONSE;
+			} else {
+				batch_status = RETURN_DEVICE_ERROR;
+			}
+			continue;
+		}
+
+		attribute = (receive_index == index_count) ? request_attribute :
+							     0;
+		block_record_length = *measurement_record_length - record_size;
+		status = spdm_process_measurements_response(
+			spdm_context, session_id, attribute,
+			index_list[receive_index - 1], slot_id_param,
+			&spdm_request[slot], spdm_request_size[slot],
+			spdm_response_size, &spdm_response, &block_count,
+			&block_record_length,
+			(uint8 *)measurement_record + record_size, NULL);
+		if (RETURN_ERROR(status)) {
+			batch_status = status;
+			continue;
+		}
+		// The index 0xFF returns all the blocks in one response.
+		total_block_count += block_count;
+		if (total_block_count > MAX_UINT8) {
+			batch_status = RETURN_BUFFER_TOO_SMALL;
+			continue;
+		}
+		record_size += block_record_length;
+	}
+
+	if (RETURN_ERROR(batch_status)) {
+		spdm_reset_message_m(spdm_context, session_info);
+		return batch_status;
+	}
+
+	*number_of_blocks = (uint8)total_block_count;
+	*measurement_record_length = record_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function sends one GET_MEASUREMENT per index in index_list
+  to get these measurements from the device.
+
+  Up to request_pipeline_depth requests (SPDM_DATA_REQUEST_PIPELINE_DEPTH) are sent before the
+  first response is received. The responses are processed in request order.
+  Only the request for the last index carries request_attribute, so that the signature covers
+  the whole batch.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the last request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  index_count                   The number of measurement indices in index_list.
+  @param  index_list                    The measurement indices to get, in order.
+                                       The index 0xFF gets all the measurement blocks.
+  @param  number_of_blocks               The number of blocks of the measurement record, the sum of the
+                                       blocks of all the responses.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+                                       The blocks are stored in index_list order.
+
+  @retval RETURN_SUCCESS               The measurements are got successfully.
+  @retval RETURN_INVALID_PARAMETER     index_list is empty or contains the index 0.
+  @retval RETURN_BUFFER_TOO_SMALL      The blocks do not fit in measurement_record or number_of_blocks.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_get_measurement_batch(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 slot_id_param, IN uintn index_count, IN const uint8 *index_list,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record)
+{
+	spdm_context_t *spdm_context;
+	spdm_retry_state_t retry_state;
+	return_status status;
+
+	spdm_context = context;
+	spdm_retry_start(spdm_context, &retry_state);
+	do {
+		status = try_spdm_get_measurement_batch(
+			spdm_context, session_id, request_attribute,
+			slot_id_param, index_count, index_list,
+			number_of_blocks, measurement_record_length,
+			measurement_record);
+		if (RETURN_NO_RESPONSE != status) {
+			return status;
+		}
+	} while (spdm_retry_wait(spdm_context, &retry_state));
 
 	return status;
 }
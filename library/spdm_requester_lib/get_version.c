@@ -132,97 +132,116 @@ boolean spdm_negotiate_connection_version(IN OUT void *context, IN spdm_version_
 }
 
 /**
-  This function sends GET_VERSION and receives VERSION.
+  This function builds GET_VERSION, and resets the connection state for a new connection.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the request.
+  @param  request_size                  On output, the size in bytes of the request.
 
-  @retval RETURN_SUCCESS               The GET_VERSION is sent and the VERSION is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The GET_VERSION is built.
 **/
-return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
+return_status spdm_build_get_version_request(IN spdm_context_t *spdm_context,
+					     OUT void *request,
+					     OUT uintn *request_size)
 {
-	return_status status;
-	boolean result;
-	spdm_get_version_request_t spdm_request;
-	spdm_version_response_max_t spdm_response;
-	uintn spdm_response_size;
+	spdm_get_version_request_t *spdm_request;
+
+	spdm_request = request;
 
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-	spdm_request.header.request_response_code = SPDM_GET_VERSION;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
-
-	spdm_reset_context(spdm_context);
+	spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_request->header.request_response_code = SPDM_GET_VERSION;
+	spdm_request->header.param1 = 0;
+	spdm_request->header.param2 = 0;
+	*request_size = sizeof(spdm_get_version_request_t);
 
+	//
+	// Free the transcript hash contexts before spdm_reset_context() clears
+	// the negotiated hash algorithm of the previous connection.
+	//
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
-						spdm_request.header.request_response_code);
-
-	status = spdm_send_spdm_request(spdm_context, NULL,
-					sizeof(spdm_request), &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
-
+						spdm_request->header.request_response_code);
 	spdm_reset_message_a(spdm_context);
 	spdm_reset_message_b(spdm_context);
 	spdm_reset_message_c(spdm_context);
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	spdm_reset_context(spdm_context);
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes VERSION received for GET_VERSION.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      The GET_VERSION sent to the device.
+  @param  request_size                  The size in bytes of the request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     The response received from the device.
+
+  @retval RETURN_SUCCESS               The VERSION is processed.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status spdm_process_version_response(IN spdm_context_t *spdm_context,
+					    IN void *request,
+					    IN uintn request_size,
+					    IN uintn response_size,
+					    IN OUT void *response)
+{
+	return_status status;
+	boolean result;
+	spdm_version_response_max_t *spdm_response;
+	uintn spdm_response_size;
+
+	spdm_response = response;
+	spdm_response_size = response_size;
+
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.spdm_version != SPDM_MESSAGE_VERSION_10) {
+	if (spdm_response->header.spdm_version != SPDM_MESSAGE_VERSION_10) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_simple_error_response(
-			spdm_context, spdm_response.header.param1);
+			spdm_context, spdm_response->header.param1);
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code != SPDM_VERSION) {
+	} else if (spdm_response->header.request_response_code != SPDM_VERSION) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_version_response)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_version_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.version_number_entry_count > MAX_SPDM_VERSION_COUNT) {
+	if (spdm_response->version_number_entry_count > MAX_SPDM_VERSION_COUNT) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.version_number_entry_count == 0) {
+	if (spdm_response->version_number_entry_count == 0) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size <
 	    sizeof(spdm_version_response) +
-		    spdm_response.version_number_entry_count *
+		    spdm_response->version_number_entry_count *
 			    sizeof(spdm_version_number_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
 	spdm_response_size = sizeof(spdm_version_response) +
-			     spdm_response.version_number_entry_count *
+			     spdm_response->version_number_entry_count *
 				     sizeof(spdm_version_number_t);
 
 	//
 	// Cache data
 	//
-	status = spdm_append_message_a(spdm_context, &spdm_request,
-				       sizeof(spdm_request));
+	status = spdm_append_message_a(spdm_context, request, request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
-	status = spdm_append_message_a(spdm_context, &spdm_response,
+	status = spdm_append_message_a(spdm_context, spdm_response,
 				       spdm_response_size);
 	if (RETURN_ERROR(status)) {
 		spdm_reset_message_a(spdm_context);
@@ -233,10 +252,10 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 	// spdm_negotiate_connection_version will change the spdm_response.
 	// It must be done after append_message_a.
 	//
-	result = spdm_negotiate_connection_version(spdm_context, spdm_context->local_context.version.spdm_version,
-									spdm_context->local_context.version.spdm_version_count,
-									spdm_response.version_number_entry,
-									spdm_response.version_number_entry_count);
+	result = spdm_negotiate_connection_version(spdm_context, spdm_context->local_context->version.spdm_version,
+									spdm_context->local_context->version.spdm_version_count,
+									spdm_response->version_number_entry,
+									spdm_response->version_number_entry_count);
 	if (result != TRUE) {
 		spdm_reset_message_a(spdm_context);
 		return RETURN_DEVICE_ERROR;
@@ -247,6 +266,45 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_VERSION and receives VERSION.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The GET_VERSION is sent and the VERSION is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_get_version_request_t spdm_request;
+	uintn spdm_request_size;
+	spdm_version_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	spdm_build_get_version_request(spdm_context, &spdm_request,
+				       &spdm_request_size);
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_version_response(spdm_context, &spdm_request,
+					     spdm_request_size,
+					     spdm_response_size,
+					     &spdm_response);
+}
+
 /**
   This function sends GET_VERSION and receives VERSION.
 
@@ -259,16 +317,20 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 **/
 return_status spdm_get_version(IN spdm_context_t *spdm_context)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_get_version(spdm_context);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_VCA,
+			       metrics_begin);
 
 	return status;
 }
@@ -6,6 +6,161 @@
 
 #include "spdm_requester_lib_internal.h"
 
+/**
+  Return the time in microseconds encoded as a power of 2, as CTExponent and RDTExponent.
+
+  @param  exponent                      The exponent.
+
+  @return 2^exponent, or MAX_UINT64 if it does not fit.
+**/
+uint64 spdm_exponent_to_us(IN uint8 exponent)
+{
+	if (exponent >= 64) {
+		return MAX_UINT64;
+	}
+	return (uint64)1 << exponent;
+}
+
+/**
+  Wait for a duration with the registered sleep function, if any.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  duration_us                   The time to wait in microseconds.
+**/
+static void spdm_retry_sleep(IN spdm_context_t *spdm_context,
+			     IN uint64 duration_us)
+{
+	if ((spdm_context->sleep != NULL) && (duration_us != 0)) {
+		spdm_context->sleep(spdm_context, duration_us);
+	}
+}
+
+/**
+  This function starts the retries of a request.
+
+  The deadline of the retry policy, if any, starts from now.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry_state                   The retry state of the request.
+**/
+void spdm_retry_start(IN spdm_context_t *spdm_context,
+		      OUT spdm_retry_state_t *retry_state)
+{
+	spdm_retry_policy_t *retry_policy;
+
+	retry_policy = &spdm_context->retry_policy;
+	retry_state->retry_count = 0;
+	if (retry_policy->initial_backoff_us != 0) {
+		retry_state->backoff_us = retry_policy->initial_backoff_us;
+	} else {
+		retry_state->backoff_us = spdm_exponent_to_us(
+			spdm_context->connection_info.capability.ct_exponent);
+	}
+	if (retry_state->backoff_us > retry_policy->max_backoff_us) {
+		retry_state->backoff_us = retry_policy->max_backoff_us;
+	}
+
+	if ((retry_policy->deadline_us != 0) &&
+	    (spdm_context->get_time_us != NULL)) {
+		spdm_context->retry_deadline =
+			spdm_context->get_time_us(spdm_context) +
+			retry_policy->deadline_us;
+	} else {
+		spdm_context->retry_deadline = 0;
+	}
+}
+
+/**
+  This function checks if the deadline of the current request is passed after a wait.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  wait_us                       The time to wait in microseconds.
+
+  @retval TRUE                         The deadline is passed after the wait.
+  @retval FALSE                        There is no deadline, or it is not passed after the wait.
+**/
+boolean spdm_retry_deadline_passed(IN spdm_context_t *spdm_context,
+				   IN uint64 wait_us)
+{
+	uint64 now;
+
+	if ((spdm_context->retry_deadline == 0) ||
+	    (spdm_context->get_time_us == NULL)) {
+		return FALSE;
+	}
+	now = spdm_context->get_time_us(spdm_context);
+	if (now >= spdm_context->retry_deadline) {
+		return TRUE;
+	}
+	return (wait_us > spdm_context->retry_deadline - now);
+}
+
+/**
+  This function decides if a request answered with BUSY is retried, and how long to wait before.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry_state                   The retry state of the request.
+  @param  wait_us                       The time to wait in microseconds before the retry.
+
+  @retval TRUE                         The request is retried after wait_us.
+  @retval FALSE                        The retries are exhausted or the deadline would be passed.
+**/
+boolean spdm_retry_next(IN spdm_context_t *spdm_context,
+			IN OUT spdm_retry_state_t *retry_state,
+			OUT uint64 *wait_us)
+{
+	spdm_retry_policy_t *retry_policy;
+	uint64 jitter;
+	uint32 random;
+
+	retry_policy = &spdm_context->retry_policy;
+	if (retry_state->retry_count >= retry_policy->retry_times) {
+		return FALSE;
+	}
+
+	*wait_us = retry_state->backoff_us;
+	//
+	// The jitter spreads the retries of requesters which got BUSY at the same time.
+	// It is useless if the retries are not delayed.
+	//
+	if ((spdm_context->sleep != NULL) &&
+	    (retry_policy->jitter_percent != 0) && (*wait_us != 0)) {
+		jitter = *wait_us * retry_policy->jitter_percent / 100;
+		spdm_get_random_number(sizeof(random), (uint8 *)&random);
+		*wait_us += random % (jitter + 1);
+	}
+	if (spdm_retry_deadline_passed(spdm_context, *wait_us)) {
+		DEBUG((DEBUG_INFO, "spdm retry - deadline passed\n"));
+		return FALSE;
+	}
+
+	retry_state->retry_count++;
+	retry_state->backoff_us =
+		MIN(retry_state->backoff_us * 2, retry_policy->max_backoff_us);
+	return TRUE;
+}
+
+/**
+  This function decides if a request answered with BUSY is retried, and waits before the retry.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry_state                   The retry state of the request.
+
+  @retval TRUE                         The request can be sent again.
+  @retval FALSE                        The retries are exhausted or the deadline would be passed.
+**/
+boolean spdm_retry_wait(IN spdm_context_t *spdm_context,
+			IN OUT spdm_retry_state_t *retry_state)
+{
+	uint64 wait_us;
+
+	if (!spdm_retry_next(spdm_context, retry_state, &wait_us)) {
+		return FALSE;
+	}
+	spdm_retry_sleep(spdm_context, wait_us);
+	return TRUE;
+}
+
 /**
   This function sends RESPOND_IF_READY and receives an expected SPDM response.
 
@@ -18,6 +173,7 @@
   @param  expected_response_size         Indicate the expected response size.
 
   @retval RETURN_SUCCESS               The RESPOND_IF_READY is sent and an expected SPDM response is received.
+  @retval RETURN_NOT_READY             The RESPOND_IF_READY is answered with RESPONSE_NOT_READY again.
   @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
 **/
 return_status spdm_requester_respond_if_ready(IN spdm_context_t *spdm_context,
@@ -30,6 +186,7 @@ return_status spdm_requester_respond_if_ready(IN spdm_context_t *spdm_context,
 	return_status status;
 	spdm_response_if_ready_request_t spdm_request;
 	spdm_message_header_t *spdm_response;
+	spdm_error_data_response_not_ready_t *extend_error_data;
 
 	spdm_response = response;
 
@@ -57,6 +214,21 @@ return_status spdm_requester_respond_if_ready(IN spdm_context_t *spdm_context,
 	if (*response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
+	if ((spdm_response->request_response_code == SPDM_ERROR) &&
+	    (spdm_response->param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY) &&
+	    (*response_size ==
+	     sizeof(spdm_error_response_data_response_not_ready_t))) {
+		extend_error_data =
+			&((spdm_error_response_data_response_not_ready_t *)
+				  response)
+				 ->extend_error_data;
+		if (extend_error_data->request_code !=
+		    spdm_context->error_data.request_code) {
+			return RETURN_DEVICE_ERROR;
+		}
+		spdm_context->error_data.token = extend_error_data->token;
+		return RETURN_NOT_READY;
+	}
 	if (spdm_response->request_response_code != expected_response_code) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -106,6 +278,9 @@ return_status spdm_handle_simple_error_response(IN void *context,
 /**
   This function handles RESPONSE_NOT_READY error code.
 
+  RESPOND_IF_READY is sent after the RDT of the responder, and sent again while the
+  responder answers RESPONSE_NOT_READY, up to RDTM times.
+
   @param  spdm_context                  A pointer to the SPDM context.
   @param  response_size                 The size of the response.
                                        On input, it means the size in bytes of response data buffer.
@@ -116,6 +291,7 @@ return_status spdm_handle_simple_error_response(IN void *context,
   @param  expected_response_size         Indicate the expected response size.
 
   @retval RETURN_SUCCESS               The RESPOND_IF_READY is sent and an expected SPDM response is received.
+  @retval RETURN_DEVICE_ERROR          The responder is not ready after RDTM polls, or the deadline is passed.
   @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
 **/
 return_status spdm_handle_response_not_ready(IN spdm_context_t *spdm_context,
@@ -128,6 +304,9 @@ return_status spdm_handle_response_not_ready(IN spdm_context_t *spdm_context,
 {
 	spdm_error_response_t *spdm_response;
 	spdm_error_data_response_not_ready_t *extend_error_data;
+	return_status status;
+	uint64 rdt_us;
+	uintn poll_count;
 
 	spdm_response = response;
 	extend_error_data =
@@ -145,10 +324,30 @@ return_status spdm_handle_response_not_ready(IN spdm_context_t *spdm_context,
 	spdm_context->error_data.token = extend_error_data->token;
 	spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
 
-	return spdm_requester_respond_if_ready(spdm_context, session_id,
-					       response_size, response,
-					       expected_response_code,
-					       expected_response_size);
+	//
+	// The responder is ready after RDT (2^RDTExponent us), and gives up
+	// after RDT * RDTM. So poll every RDT, up to RDTM times.
+	//
+	rdt_us = spdm_exponent_to_us(spdm_context->error_data.rd_exponent);
+	poll_count = 0;
+	do {
+		if (spdm_retry_deadline_passed(spdm_context, rdt_us)) {
+			DEBUG((DEBUG_INFO,
+			       "spdm RESPOND_IF_READY - deadline passed\n"));
+			return RETURN_DEVICE_ERROR;
+		}
+		spdm_retry_sleep(spdm_context, rdt_us);
+		status = spdm_requester_respond_if_ready(
+			spdm_context, session_id, response_size, response,
+			expected_response_code, expected_response_size);
+		poll_count++;
+	} while ((status == RETURN_NOT_READY) &&
+		 (poll_count < spdm_context->error_data.rd_tm));
+
+	if (status == RETURN_NOT_READY) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return status;
 }
 
 /**
@@ -104,18 +104,18 @@ return_status try_spdm_heartbeat(IN void *context, IN uint32 session_id)
 
 return_status spdm_heartbeat(IN void *context, IN uint32 session_id)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
-	retry = spdm_context->retry_times;
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_heartbeat(spdm_context, session_id);
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
 
 	return status;
 }
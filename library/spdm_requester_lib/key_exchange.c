@@ -80,6 +80,7 @@ return_status try_spdm_send_receive_key_exchange(
 	spdm_session_info_t *session_info;
 	uintn opaque_key_exchange_req_size;
 	uint8 th1_hash_data[64];
+	uint64 metrics_begin;
 
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
@@ -98,7 +99,7 @@ return_status try_spdm_send_receive_key_exchange(
 		return RETURN_INVALID_PARAMETER;
 	}
 	if ((slot_id == 0xFF) &&
-	    (spdm_context->local_context.peer_cert_chain_provision_size == 0)) {
+	    (spdm_context->local_context->peer_cert_chain_provision_size == 0)) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
@@ -128,11 +129,16 @@ return_status try_spdm_send_receive_key_exchange(
 	ptr = spdm_request.exchange_data;
 	dhe_key_size = spdm_get_dhe_pub_key_size(
 		spdm_context->connection_info.algorithm.dhe_named_group);
-	dhe_context = spdm_secured_message_dhe_new(
-		spdm_context->connection_info.algorithm.dhe_named_group);
-	spdm_secured_message_dhe_generate_key(
-		spdm_context->connection_info.algorithm.dhe_named_group,
-		dhe_context, ptr, &dhe_key_size);
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	dhe_context = spdm_secured_message_dhe_new_key(
+		spdm_context->local_context->dhe_key_pool,
+		spdm_context->connection_info.algorithm.dhe_named_group, ptr,
+		&dhe_key_size);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_DHE,
+				metrics_begin);
+	if (dhe_context == NULL) {
+		return RETURN_DEVICE_ERROR;
+	}
 	DEBUG((DEBUG_INFO, "ClientKey (0x%x):\n", dhe_key_size));
 	internal_dump_hex(ptr, dhe_key_size);
 	ptr += dhe_key_size;
@@ -233,7 +239,7 @@ return_status try_spdm_send_receive_key_exchange(
 		}
 		if ((*req_slot_id_param != 0xF) &&
 		    (*req_slot_id_param >=
-		     spdm_context->local_context.slot_count)) {
+		     spdm_context->local_context->slot_count)) {
 			spdm_secured_message_dhe_free(
 				spdm_context->connection_info.algorithm
 					.dhe_named_group,
@@ -367,8 +373,11 @@ return_status try_spdm_send_receive_key_exchange(
 	DEBUG((DEBUG_INFO, "signature (0x%x):\n", signature_size));
 	internal_dump_hex(signature, signature_size);
 	ptr += signature_size;
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	result = spdm_verify_key_exchange_rsp_signature(
 		spdm_context, session_info, signature, signature_size);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_ASYM_VERIFY,
+				metrics_begin);
 	if (!result) {
 		spdm_free_session_id(spdm_context, *session_id);
 		spdm_secured_message_dhe_free(
@@ -391,10 +400,13 @@ return_status try_spdm_send_receive_key_exchange(
 	//
 	// Fill data to calc Secret for HMAC verification
 	//
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	result = spdm_secured_message_dhe_compute_key(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context, spdm_response.exchange_data, dhe_key_size,
 		session_info->secured_message_context);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_DHE,
+				metrics_begin);
 	spdm_secured_message_dhe_free(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context);
@@ -405,14 +417,20 @@ return_status try_spdm_send_receive_key_exchange(
 
 	DEBUG((DEBUG_INFO, "spdm_generate_session_handshake_key[%x]\n",
 	       *session_id));
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_calculate_th1_hash(spdm_context, session_info, TRUE,
 					 th1_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HASH,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
 	}
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_generate_session_handshake_key(
 		session_info->secured_message_context, th1_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
@@ -425,8 +443,11 @@ return_status try_spdm_send_receive_key_exchange(
 		verify_data = ptr;
 		DEBUG((DEBUG_INFO, "verify_data (0x%x):\n", hmac_size));
 		internal_dump_hex(verify_data, hmac_size);
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		result = spdm_verify_key_exchange_rsp_hmac(
 			spdm_context, session_info, verify_data, hmac_size);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HMAC,
+					metrics_begin);
 		if (!result) {
 			spdm_free_session_id(spdm_context, *session_id);
 			spdm_context->error_state =
@@ -476,19 +497,23 @@ return_status spdm_send_receive_key_exchange(
 	IN uint8 slot_id, OUT uint32 *session_id, OUT uint8 *heartbeat_period,
 	OUT uint8 *req_slot_id_param, OUT void *measurement_hash)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_key_exchange(
 			spdm_context, measurement_hash_type, slot_id,
 			session_id, heartbeat_period, req_slot_id_param,
 			measurement_hash, NULL, NULL, NULL);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_KEY_EXCHANGE,
+			       metrics_begin);
 
 	return status;
 }
@@ -518,10 +543,12 @@ return_status spdm_send_receive_key_exchange_ex(
 	OUT void *requester_random OPTIONAL,
 	OUT void *responder_random OPTIONAL)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_key_exchange(
 			spdm_context, measurement_hash_type, slot_id,
@@ -529,9 +556,11 @@ return_status spdm_send_receive_key_exchange_ex(
 			measurement_hash, requester_random_in,
 			requester_random, responder_random);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_KEY_EXCHANGE,
+			       metrics_begin);
 
 	return status;
 }
\ No newline at end of file
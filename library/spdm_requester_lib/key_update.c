@@ -43,6 +43,7 @@ return_status try_spdm_key_update(IN void *context, IN uint32 session_id,
 	spdm_context_t *spdm_context;
 	spdm_session_info_t *session_info;
 	spdm_session_state_t session_state;
+	uint64 metrics_begin;
 
 	spdm_context = context;
 	if (!spdm_is_capabilities_flag_supported(
@@ -99,9 +100,12 @@ return_status try_spdm_key_update(IN void *context, IN uint32 session_id,
 			DEBUG((DEBUG_INFO,
 			       "spdm_create_update_session_data_key[%x] Responder\n",
 			       session_id));
+			metrics_begin = spdm_metrics_begin(spdm_context);
 			spdm_create_update_session_data_key(
 				session_info->secured_message_context,
 				SPDM_KEY_UPDATE_ACTION_RESPONDER);
+			spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+						metrics_begin);
 		}
 
 		status = spdm_send_spdm_request(spdm_context, &session_id,
@@ -174,9 +178,12 @@ return_status try_spdm_key_update(IN void *context, IN uint32 session_id,
 		DEBUG((DEBUG_INFO,
 		       "spdm_create_update_session_data_key[%x] Requester\n",
 		       session_id));
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		spdm_create_update_session_data_key(
 			session_info->secured_message_context,
 			SPDM_KEY_UPDATE_ACTION_REQUESTER);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+					metrics_begin);
 		DEBUG((DEBUG_INFO,
 		       "spdm_activate_update_session_data_key[%x] Requester new\n",
 		       session_id));
@@ -243,20 +250,94 @@ return_status spdm_key_update(IN void *context, IN uint32 session_id,
 			      IN boolean single_direction)
 {
 	spdm_context_t *spdm_context;
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
 	boolean key_updated;
 
 	spdm_context = context;
 	key_updated = FALSE;
-	retry = spdm_context->retry_times;
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_key_update(context, session_id,
 						      single_direction, &key_updated);
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
 
 	return status;
 }
+
+/**
+  This function applies the data key update policy of an SPDM Session at an idle point.
+
+  If a data key crossed a limit of the policy set by spdm_secured_message_set_key_update_policy,
+  this function sends KEY_UPDATE, with UPDATE_KEY if only the request direction crossed a limit,
+  and UPDATE_ALL_KEYS otherwise. Then it derives the next data keys, so that the next key update
+  does not derive them.
+
+  The age limit is only checked if a timer is registered by spdm_register_timer_func.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The session ID of the session.
+  @param  key_updated                   TRUE if KEY_UPDATE is sent, if not NULL.
+
+  @retval RETURN_SUCCESS               The policy is applied.
+  @retval RETURN_UNSUPPORTED           KEY_UPDATE is not supported, or the session is not established.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_key_update_on_idle(IN void *context,
+				      IN uint32 session_id,
+				      OUT boolean *key_updated OPTIONAL)
+{
+	return_status status;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	spdm_key_update_action_t action;
+	uint64 now_us;
+
+	spdm_context = context;
+	if (key_updated != NULL) {
+		*key_updated = FALSE;
+	}
+	if (!spdm_is_capabilities_flag_supported(
+		    spdm_context, TRUE,
+		    SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP,
+		    SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP)) {
+		return RETURN_UNSUPPORTED;
+	}
+	session_info =
+		spdm_get_session_info_via_session_id(spdm_context, session_id);
+	if (session_info == NULL) {
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
+	}
+	if (spdm_secured_message_get_session_state(
+		    session_info->secured_message_context) !=
+	    SPDM_SESSION_STATE_ESTABLISHED) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	now_us = (spdm_context->get_time_us != NULL) ?
+			 spdm_context->get_time_us(spdm_context) :
+			 0;
+	if (spdm_secured_message_is_key_update_due(
+		    session_info->secured_message_context, now_us, &action)) {
+		DEBUG((DEBUG_INFO, "spdm_key_update_on_idle[%x] action 0x%x\n",
+		       session_id, action));
+		status = spdm_key_update(
+			spdm_context, session_id,
+			(boolean)(action == SPDM_KEY_UPDATE_ACTION_REQUESTER));
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		if (key_updated != NULL) {
+			*key_updated = TRUE;
+		}
+	}
+
+	return spdm_prepare_update_session_data_key(
+		session_info->secured_message_context,
+		SPDM_KEY_UPDATE_ACTION_ALL);
+}
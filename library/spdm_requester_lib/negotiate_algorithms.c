@@ -46,24 +46,22 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
+  This function builds NEGOTIATE_ALGORITHMS.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      A pointer to a destination buffer to store the request.
+  @param  request_size                  On output, the size in bytes of the request.
 
-  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is sent and the ALGORITHMS is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is built.
+  @retval RETURN_UNSUPPORTED           The connection state does not allow NEGOTIATE_ALGORITHMS.
 **/
-return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
+return_status spdm_build_negotiate_algorithms_request(IN spdm_context_t *spdm_context,
+						      OUT void *request,
+						      OUT uintn *request_size)
 {
-	return_status status;
-	spdm_negotiate_algorithms_request_mine_t spdm_request;
-	spdm_algorithms_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint32 algo_size;
-	uintn index;
-	spdm_negotiate_algorithms_common_struct_table_t *struct_table;
-	uint8 fixed_alg_size;
-	uint8 ext_alg_count;
+	spdm_negotiate_algorithms_request_mine_t *spdm_request;
+
+	spdm_request = request;
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 									SPDM_NEGOTIATE_ALGORITHMS);
@@ -73,110 +71,133 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 		return RETURN_UNSUPPORTED;
 	}
 
-	zero_mem(&spdm_request, sizeof(spdm_request));
+	zero_mem(spdm_request, sizeof(spdm_negotiate_algorithms_request_mine_t));
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-		spdm_request.length = sizeof(spdm_request);
-		spdm_request.header.param1 =
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+		spdm_request->length = sizeof(spdm_negotiate_algorithms_request_mine_t);
+		spdm_request->header.param1 =
 			4; // Number of Algorithms Structure Tables
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-		spdm_request.length = sizeof(spdm_request) -
-				      sizeof(spdm_request.struct_table);
-		spdm_request.header.param1 = 0;
+		spdm_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_request->length = sizeof(spdm_negotiate_algorithms_request_mine_t) -
+				      sizeof(spdm_request->struct_table);
+		spdm_request->header.param1 = 0;
 	}
-	spdm_request.header.request_response_code = SPDM_NEGOTIATE_ALGORITHMS;
-	spdm_request.header.param2 = 0;
-	spdm_request.measurement_specification =
-		spdm_context->local_context.algorithm.measurement_spec;
-	spdm_request.base_asym_algo =
-		spdm_context->local_context.algorithm.base_asym_algo;
-	spdm_request.base_hash_algo =
-		spdm_context->local_context.algorithm.base_hash_algo;
-	spdm_request.ext_asym_count = 0;
-	spdm_request.ext_hash_count = 0;
-	spdm_request.struct_table[0].alg_type =
+	spdm_request->header.request_response_code = SPDM_NEGOTIATE_ALGORITHMS;
+	spdm_request->header.param2 = 0;
+	spdm_request->measurement_specification =
+		spdm_context->local_context->algorithm.measurement_spec;
+	spdm_request->base_asym_algo =
+		spdm_context->local_context->algorithm.base_asym_algo;
+	spdm_request->base_hash_algo =
+		spdm_context->local_context->algorithm.base_hash_algo;
+	spdm_request->ext_asym_count = 0;
+	spdm_request->ext_hash_count = 0;
+	spdm_request->struct_table[0].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_DHE;
-	spdm_request.struct_table[0].alg_count = 0x20;
-	spdm_request.struct_table[0].alg_supported =
-		spdm_context->local_context.algorithm.dhe_named_group;
-	spdm_request.struct_table[1].alg_type =
+	spdm_request->struct_table[0].alg_count = 0x20;
+	spdm_request->struct_table[0].alg_supported =
+		spdm_context->local_context->algorithm.dhe_named_group;
+	spdm_request->struct_table[1].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_AEAD;
-	spdm_request.struct_table[1].alg_count = 0x20;
-	spdm_request.struct_table[1].alg_supported =
-		spdm_context->local_context.algorithm.aead_cipher_suite;
-	spdm_request.struct_table[2].alg_type =
+	spdm_request->struct_table[1].alg_count = 0x20;
+	spdm_request->struct_table[1].alg_supported =
+		spdm_context->local_context->algorithm.aead_cipher_suite;
+	spdm_request->struct_table[2].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_REQ_BASE_ASYM_ALG;
-	spdm_request.struct_table[2].alg_count = 0x20;
-	spdm_request.struct_table[2].alg_supported =
-		spdm_context->local_context.algorithm.req_base_asym_alg;
-	spdm_request.struct_table[3].alg_type =
+	spdm_request->struct_table[2].alg_count = 0x20;
+	spdm_request->struct_table[2].alg_supported =
+		spdm_context->local_context->algorithm.req_base_asym_alg;
+	spdm_request->struct_table[3].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_KEY_SCHEDULE;
-	spdm_request.struct_table[3].alg_count = 0x20;
-	spdm_request.struct_table[3].alg_supported =
-		spdm_context->local_context.algorithm.key_schedule;
+	spdm_request->struct_table[3].alg_count = 0x20;
+	spdm_request->struct_table[3].alg_supported =
+		spdm_context->local_context->algorithm.key_schedule;
 
-	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request.length,
-					&spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	*request_size = spdm_request->length;
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes ALGORITHMS received for NEGOTIATE_ALGORITHMS.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request                      The NEGOTIATE_ALGORITHMS sent to the device.
+  @param  request_size                  The size in bytes of the request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     The response received from the device.
+
+  @retval RETURN_SUCCESS               The ALGORITHMS is processed.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status spdm_process_algorithms_response(IN spdm_context_t *spdm_context,
+						IN void *request,
+						IN uintn request_size,
+						IN uintn response_size,
+						IN OUT void *response)
+{
+	return_status status;
+	spdm_negotiate_algorithms_request_mine_t *spdm_request;
+	spdm_algorithms_response_max_t *spdm_response;
+	uintn spdm_response_size;
+	uint32 algo_size;
+	uintn index;
+	spdm_negotiate_algorithms_common_struct_table_t *struct_table;
+	uint8 fixed_alg_size;
+	uint8 ext_alg_count;
+
+	spdm_request = request;
+	spdm_response = response;
+	spdm_response_size = response_size;
 
-	spdm_response_size = sizeof(spdm_response);
-	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.request_response_code == SPDM_ERROR) {
+	if (spdm_response->header.request_response_code == SPDM_ERROR) {
 		status = spdm_handle_simple_error_response(
-			spdm_context, spdm_response.header.param1);
+			spdm_context, spdm_response->header.param1);
 		if (RETURN_ERROR(status)) {
 			return status;
 		}
-	} else if (spdm_response.header.request_response_code !=
+	} else if (spdm_response->header.request_response_code !=
 		   SPDM_ALGORITHMS) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size < sizeof(spdm_algorithms_response_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response_size > sizeof(spdm_response)) {
+	if (spdm_response_size > sizeof(spdm_algorithms_response_max_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.spdm_version != spdm_request.header.spdm_version){
+	if (spdm_response->header.spdm_version != spdm_request->header.spdm_version){
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.ext_asym_sel_count > 1) {
+	if (spdm_response->ext_asym_sel_count > 1) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.ext_hash_sel_count > 1) {
+	if (spdm_response->ext_hash_sel_count > 1) {
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response_size <
 	    sizeof(spdm_algorithms_response_t) +
-		    sizeof(uint32) * spdm_response.ext_asym_sel_count +
-		    sizeof(uint32) * spdm_response.ext_hash_sel_count +
+		    sizeof(uint32) * spdm_response->ext_asym_sel_count +
+		    sizeof(uint32) * spdm_response->ext_hash_sel_count +
 		    sizeof(spdm_negotiate_algorithms_common_struct_table_t) *
-			    spdm_response.header.param1) {
+			    spdm_response->header.param1) {
 		return RETURN_DEVICE_ERROR;
 	}
 	struct_table =
-		(void *)((uintn)&spdm_response +
+		(void *)((uintn)spdm_response +
 			 sizeof(spdm_algorithms_response_t) +
-			 sizeof(uint32) * spdm_response.ext_asym_sel_count +
-			 sizeof(uint32) * spdm_response.ext_hash_sel_count);
-	if (spdm_response.header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
-		for (index = 0; index < spdm_response.header.param1; index++) {
-			if ((uintn)&spdm_response + spdm_response_size <
+			 sizeof(uint32) * spdm_response->ext_asym_sel_count +
+			 sizeof(uint32) * spdm_response->ext_hash_sel_count);
+	if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
+		for (index = 0; index < spdm_response->header.param1; index++) {
+			if ((uintn)spdm_response + spdm_response_size <
 			    (uintn)struct_table) {
 				return RETURN_DEVICE_ERROR;
 			}
-			if ((uintn)&spdm_response + spdm_response_size -
+			if ((uintn)spdm_response + spdm_response_size -
 				    (uintn)struct_table <
 			    sizeof(spdm_negotiate_algorithms_common_struct_table_t)) {
 				return RETURN_DEVICE_ERROR;
@@ -189,7 +210,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 			if (ext_alg_count > 1) {
 				return RETURN_DEVICE_ERROR;
 			}
-			if ((uintn)&spdm_response + spdm_response_size -
+			if ((uintn)spdm_response + spdm_response_size -
 				    (uintn)struct_table -
 				    sizeof(spdm_negotiate_algorithms_common_struct_table_t) <
 			    sizeof(uint32) * ext_alg_count) {
@@ -201,34 +222,34 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 					 sizeof(uint32) * ext_alg_count);
 		}
 	}
-	spdm_response_size = (uintn)struct_table - (uintn)&spdm_response;
-	if (spdm_response_size != spdm_response.length) {
+	spdm_response_size = (uintn)struct_table - (uintn)spdm_response;
+	if (spdm_response_size != spdm_response->length) {
 		return RETURN_DEVICE_ERROR;
 	}
 
 	//
 	// Cache data
 	//
-	status = spdm_append_message_a(spdm_context, &spdm_request,
-				       spdm_request.length);
+	status = spdm_append_message_a(spdm_context, spdm_request,
+				       request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
-	status = spdm_append_message_a(spdm_context, &spdm_response,
+	status = spdm_append_message_a(spdm_context, spdm_response,
 				       spdm_response_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 
 	spdm_context->connection_info.algorithm.measurement_spec =
-		spdm_response.measurement_specification_sel;
+		spdm_response->measurement_specification_sel;
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
-		spdm_response.measurement_hash_algo;
+		spdm_response->measurement_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
-		spdm_response.base_asym_sel;
+		spdm_response->base_asym_sel;
 	spdm_context->connection_info.algorithm.base_hash_algo =
-		spdm_response.base_hash_sel;
+		spdm_response->base_hash_sel;
 
 	if (spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE, 0,
@@ -249,7 +270,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 	if (algo_size == 0) {
 		return RETURN_SECURITY_VIOLATION;
 	}
-	if ((spdm_context->connection_info.algorithm.base_hash_algo & spdm_context->local_context.algorithm.base_hash_algo) == 0) {
+	if ((spdm_context->connection_info.algorithm.base_hash_algo & spdm_context->local_context->algorithm.base_hash_algo) == 0) {
 		return RETURN_SECURITY_VIOLATION;
 	}
 	if (spdm_is_capabilities_flag_supported(
@@ -260,20 +281,20 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 		if (algo_size == 0) {
 			return RETURN_SECURITY_VIOLATION;
 		}
-		if ((spdm_context->connection_info.algorithm.base_asym_algo & spdm_context->local_context.algorithm.base_asym_algo) == 0) {
+		if ((spdm_context->connection_info.algorithm.base_asym_algo & spdm_context->local_context->algorithm.base_asym_algo) == 0) {
 			return RETURN_SECURITY_VIOLATION;
 		}
 	}
 
-	if (spdm_response.header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
+	if (spdm_response->header.spdm_version >= SPDM_MESSAGE_VERSION_11) {
 		struct_table =
-			(void *)((uintn)&spdm_response +
+			(void *)((uintn)spdm_response +
 				 sizeof(spdm_algorithms_response_t) +
 				 sizeof(uint32) *
-					 spdm_response.ext_asym_sel_count +
+					 spdm_response->ext_asym_sel_count +
 				 sizeof(uint32) *
-					 spdm_response.ext_hash_sel_count);
-		for (index = 0; index < spdm_response.header.param1; index++) {
+					 spdm_response->ext_hash_sel_count);
+		for (index = 0; index < spdm_response->header.param1; index++) {
 			switch (struct_table->alg_type) {
 			case SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_DHE:
 				spdm_context->connection_info.algorithm
@@ -313,7 +334,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 			if (algo_size == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
-			if ((spdm_context->connection_info.algorithm.dhe_named_group & spdm_context->local_context.algorithm.dhe_named_group) == 0) {
+			if ((spdm_context->connection_info.algorithm.dhe_named_group & spdm_context->local_context->algorithm.dhe_named_group) == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
 		}
@@ -331,7 +352,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 			if (algo_size == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
-			if ((spdm_context->connection_info.algorithm.aead_cipher_suite & spdm_context->local_context.algorithm.aead_cipher_suite) == 0) {
+			if ((spdm_context->connection_info.algorithm.aead_cipher_suite & spdm_context->local_context->algorithm.aead_cipher_suite) == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
 		}
@@ -345,7 +366,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 			if (algo_size == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
-			if ((spdm_context->connection_info.algorithm.req_base_asym_alg & spdm_context->local_context.algorithm.req_base_asym_alg) == 0) {
+			if ((spdm_context->connection_info.algorithm.req_base_asym_alg & spdm_context->local_context->algorithm.req_base_asym_alg) == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
 		}
@@ -362,7 +383,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 			    SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH) {
 				return RETURN_SECURITY_VIOLATION;
 			}
-			if ((spdm_context->connection_info.algorithm.key_schedule & spdm_context->local_context.algorithm.key_schedule) == 0) {
+			if ((spdm_context->connection_info.algorithm.key_schedule & spdm_context->local_context->algorithm.key_schedule) == 0) {
 				return RETURN_SECURITY_VIOLATION;
 			}
 		}
@@ -378,6 +399,48 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is sent and the ALGORITHMS is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_negotiate_algorithms_request_mine_t spdm_request;
+	uintn spdm_request_size;
+	spdm_algorithms_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	status = spdm_build_negotiate_algorithms_request(
+		spdm_context, &spdm_request, &spdm_request_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_algorithms_response(spdm_context, &spdm_request,
+						spdm_request_size,
+						spdm_response_size,
+						&spdm_response);
+}
+
 /**
   This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
 
@@ -388,16 +451,20 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 **/
 return_status spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_negotiate_algorithms(spdm_context);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_VCA,
+			       metrics_begin);
 
 	return status;
 }
@@ -85,6 +85,7 @@ return_status try_spdm_send_receive_psk_exchange(
 	uint8 th1_hash_data[64];
 	uint8 th2_hash_data[64];
 	uint32 algo_size;
+	uint64 metrics_begin;
 
 	// Check capabilities even if GET_CAPABILITIES is not sent.
 	// Assuming capabilities are provisioned.
@@ -136,7 +137,7 @@ return_status try_spdm_send_receive_psk_exchange(
 	spdm_request.header.param1 = measurement_hash_type;
 	spdm_request.header.param2 = 0;
 	spdm_request.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	if (requester_context_in == NULL) {
 		spdm_request.context_length = DEFAULT_CONTEXT_LENGTH;
 	} else {
@@ -151,8 +152,8 @@ return_status try_spdm_send_receive_psk_exchange(
 	spdm_request.req_session_id = req_session_id;
 
 	ptr = spdm_request.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	DEBUG((DEBUG_INFO, "psk_hint (0x%x) - ", spdm_request.psk_hint_length));
 	internal_dump_data(ptr, spdm_request.psk_hint_length);
 	DEBUG((DEBUG_INFO, "\n"));
@@ -305,14 +306,20 @@ return_status try_spdm_send_receive_psk_exchange(
 
 	DEBUG((DEBUG_INFO, "spdm_generate_session_handshake_key[%x]\n",
 	       *session_id));
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_calculate_th1_hash(spdm_context, session_info, TRUE,
 					 th1_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HASH,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
 	}
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_generate_session_handshake_key(
 		session_info->secured_message_context, th1_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		spdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
@@ -321,8 +328,11 @@ return_status try_spdm_send_receive_psk_exchange(
 	verify_data = ptr;
 	DEBUG((DEBUG_INFO, "verify_data (0x%x):\n", hmac_size));
 	internal_dump_hex(verify_data, hmac_size);
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	result = spdm_verify_psk_exchange_rsp_hmac(spdm_context, session_info,
 						   verify_data, hmac_size);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HMAC,
+				metrics_begin);
 	if (!result) {
 		spdm_free_session_id(spdm_context, *session_id);
 		spdm_context->error_state =
@@ -353,13 +363,19 @@ return_status try_spdm_send_receive_psk_exchange(
 
 		DEBUG((DEBUG_INFO, "spdm_generate_session_data_key[%x]\n",
 		       session_id));
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		status = spdm_calculate_th2_hash(spdm_context, session_info,
 						 TRUE, th2_hash_data);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HASH,
+					metrics_begin);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
+		metrics_begin = spdm_metrics_begin(spdm_context);
 		status = spdm_generate_session_data_key(
 			session_info->secured_message_context, th2_hash_data);
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+					metrics_begin);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
@@ -390,19 +406,23 @@ return_status spdm_send_receive_psk_exchange(IN spdm_context_t *spdm_context,
 					     OUT uint8 *heartbeat_period,
 					     OUT void *measurement_hash)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_psk_exchange(
 			spdm_context, measurement_hash_type, session_id,
 			heartbeat_period, measurement_hash,
 			NULL, 0, NULL, NULL, NULL, NULL);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_KEY_EXCHANGE,
+			       metrics_begin);
 
 	return status;
 }
@@ -442,10 +462,12 @@ return_status spdm_send_receive_psk_exchange_ex(IN spdm_context_t *spdm_context,
 					     OUT void *responder_context OPTIONAL,
 					     OUT uintn *responder_context_size OPTIONAL)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_psk_exchange(
 			spdm_context, measurement_hash_type, session_id,
@@ -454,9 +476,11 @@ return_status spdm_send_receive_psk_exchange_ex(IN spdm_context_t *spdm_context,
 			requester_context, requester_context_size,
 			responder_context, responder_context_size);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_KEY_EXCHANGE,
+			       metrics_begin);
 
 	return status;
 }
@@ -41,6 +41,7 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 	spdm_session_info_t *session_info;
 	uint8 th2_hash_data[64];
 	spdm_session_state_t session_state;
+	uint64 metrics_begin;
 
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, TRUE,
@@ -83,8 +84,11 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 		return RETURN_SECURITY_VIOLATION;
 	}
 
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	spdm_generate_psk_exchange_req_hmac(spdm_context, session_info,
 					    spdm_request.verify_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HMAC,
+				metrics_begin);
 
 	status = spdm_append_message_f(spdm_context, session_info, TRUE,
 				       (uint8 *)&spdm_request +
@@ -137,13 +141,19 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 	}
 
 	DEBUG((DEBUG_INFO, "spdm_generate_session_data_key[%x]\n", session_id));
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_calculate_th2_hash(spdm_context, session_info, TRUE,
 					 th2_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HASH,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_generate_session_data_key(
 		session_info->secured_message_context, th2_hash_data);
+	spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_HKDF,
+				metrics_begin);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -159,17 +169,21 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 return_status spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 					   IN uint32 session_id)
 {
-	uintn retry;
+	spdm_retry_state_t retry_state;
 	return_status status;
+	uint64 metrics_begin;
 
-	retry = spdm_context->retry_times;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	spdm_retry_start(spdm_context, &retry_state);
 	do {
 		status = try_spdm_send_receive_psk_finish(spdm_context,
 							  session_id);
 		if (RETURN_NO_RESPONSE != status) {
-			return status;
+			break;
 		}
-	} while (retry-- != 0);
+	} while (spdm_retry_wait(spdm_context, &retry_state));
+	spdm_metrics_phase_end(spdm_context, SPDM_REQUESTER_PHASE_FINISH,
+			       metrics_begin);
 
 	return status;
 }
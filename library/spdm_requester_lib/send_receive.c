@@ -6,9 +6,83 @@
 
 #include "spdm_requester_lib_internal.h"
 
+/**
+  Send an SPDM or an APP request to a device, encoding the transport message in place.
+
+  The request shall be located inside a larger buffer, with spdm_get_transport_header_size bytes
+  of writable room in front of it and spdm_get_transport_tail_size bytes of writable room behind it.
+  The transport layer writes its headers, padding and AEAD tag into that room. No copy is made.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the request is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  request_size                  size in bytes of the request data buffer.
+  @param  request                      A pointer to the request, with head room and tail room around it.
+                                       The content is overwritten by the encoded message.
+
+  @retval RETURN_SUCCESS               The SPDM request is sent successfully.
+  @retval RETURN_UNSUPPORTED           No in-place transport layer function is registered.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
+**/
+return_status spdm_send_request_in_place(IN void *context, IN uint32 *session_id,
+					 IN boolean is_app_message,
+					 IN uintn request_size,
+					 IN OUT void *request)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+	void *message;
+	uintn message_size;
+	uint64 metrics_begin;
+
+	spdm_context = context;
+
+	if (spdm_context->transport_encode_message_in_place == NULL) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] (0x%x): \n",
+	       (session_id != NULL) ? *session_id : 0x0, request_size));
+	spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_SEND, session_id,
+			   is_app_message, request, request_size);
+
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	status = spdm_context->transport_encode_message_in_place(
+		spdm_context, session_id, is_app_message, TRUE, request_size,
+		request, &message_size, &message);
+	if (session_id != NULL) {
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_AEAD,
+					metrics_begin);
+	}
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_INFO, "transport_encode_message status - %p\n",
+		       status));
+		return status;
+	}
+
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	status = spdm_context->send_message(spdm_context, message_size, message,
+					    0);
+	spdm_metrics_end(spdm_context, &spdm_context->requester_metrics.send,
+			 metrics_begin);
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] status - %p\n",
+		       (session_id != NULL) ? *session_id : 0x0, status));
+	} else {
+		spdm_context->requester_metrics.bytes_sent += message_size;
+	}
+
+	return status;
+}
+
 /**
   Send an SPDM or an APP request to a device.
 
+  If an in-place transport layer function is registered, the request is copied once behind
+  the transport header room and encoded in place. Otherwise the copy transport function is used.
+
   @param  spdm_context                  The SPDM context for the device.
   @param  session_id                    Indicate if the request is a secured message.
                                        If session_id is NULL, it is a normal message.
@@ -28,30 +102,55 @@ return_status spdm_send_request(IN void *context, IN uint32 *session_id,
 {
 	spdm_context_t *spdm_context;
 	return_status status;
-	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 message[MAX_SPDM_TRANSPORT_HEADER_SIZE +
+		      MAX_SPDM_MESSAGE_BUFFER_SIZE +
+		      MAX_SPDM_TRANSPORT_TAIL_SIZE];
 	uintn message_size;
+	uint64 metrics_begin;
 
 	spdm_context = context;
 
+	if (spdm_context->transport_encode_message_in_place != NULL) {
+		if (request_size > MAX_SPDM_MESSAGE_BUFFER_SIZE) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		copy_mem(message + spdm_context->transport_header_size, request,
+			 request_size);
+		return spdm_send_request_in_place(
+			spdm_context, session_id, is_app_message, request_size,
+			message + spdm_context->transport_header_size);
+	}
+
 	DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] (0x%x): \n",
 	       (session_id != NULL) ? *session_id : 0x0, request_size));
-	internal_dump_hex(request, request_size);
+	spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_SEND, session_id,
+			   is_app_message, request, request_size);
 
 	message_size = sizeof(message);
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_context->transport_encode_message(
 		spdm_context, session_id, is_app_message, TRUE, request_size,
 		request, &message_size, message);
+	if (session_id != NULL) {
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_AEAD,
+					metrics_begin);
+	}
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_encode_message status - %p\n",
 		       status));
 		return status;
 	}
 
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_context->send_message(spdm_context, message_size, message,
 					    0);
+	spdm_metrics_end(spdm_context, &spdm_context->requester_metrics.send,
+			 metrics_begin);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] status - %p\n",
 		       (session_id != NULL) ? *session_id : 0x0, status));
+	} else {
+		spdm_context->requester_metrics.bytes_sent += message_size;
 	}
 
 	return status;
@@ -82,28 +181,185 @@ return_status spdm_receive_response(IN void *context, IN uint32 *session_id,
 	return_status status;
 	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn message_size;
-	uint32 *message_session_id;
-	boolean is_message_app_message;
+	uint64 metrics_begin;
 
 	spdm_context = context;
 
 	ASSERT(*response_size <= MAX_SPDM_MESSAGE_BUFFER_SIZE);
 
 	message_size = sizeof(message);
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_context->receive_message(spdm_context, &message_size,
 					       message, 0);
+	spdm_metrics_end(spdm_context, &spdm_context->requester_metrics.receive,
+			 metrics_begin);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO,
 		       "spdm_receive_spdm_response[%x] status - %p\n",
 		       (session_id != NULL) ? *session_id : 0x0, status));
 		return status;
 	}
+	spdm_context->requester_metrics.bytes_received += message_size;
+
+	return spdm_decode_response(spdm_context, session_id, is_app_message,
+				    message_size, message, response_size,
+				    response);
+}
+
+/**
+  Decode an SPDM or an APP response from a transport message received from a device.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message_size                  size in bytes of the transport message.
+  @param  message                      A pointer to the transport message.
+  @param  response_size                 size in bytes of the response data buffer.
+  @param  response                     A pointer to a destination buffer to store the response.
+                                       The caller is responsible for having
+                                       either implicit or explicit ownership of the buffer.
+
+  @retval RETURN_SUCCESS               The SPDM response is decoded successfully.
+  @retval RETURN_DEVICE_ERROR          The transport message is not the expected SPDM response.
+**/
+return_status spdm_decode_response(IN void *context, IN uint32 *session_id,
+				   IN boolean is_app_message,
+				   IN uintn message_size, IN void *message,
+				   IN OUT uintn *response_size,
+				   OUT void *response)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+	uint32 *message_session_id;
+	boolean is_message_app_message;
+	uint64 metrics_begin;
+
+	spdm_context = context;
 
 	message_session_id = NULL;
 	is_message_app_message = FALSE;
+	metrics_begin = spdm_metrics_begin(spdm_context);
 	status = spdm_context->transport_decode_message(
 		spdm_context, &message_session_id, &is_message_app_message,
 		FALSE, message_size, message, response_size, response);
+	if (message_session_id != NULL) {
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_AEAD,
+					metrics_begin);
+	}
+
+	if (session_id != NULL) {
+		if (message_session_id == NULL) {
+			DEBUG((DEBUG_INFO,
+			       "spdm_receive_spdm_response[%x] GetSessionId - NULL\n",
+			       (session_id != NULL) ? *session_id : 0x0));
+			return RETURN_DEVICE_ERROR;
+		}
+		if (*message_session_id != *session_id) {
+			DEBUG((DEBUG_INFO,
+			       "spdm_receive_spdm_response[%x] GetSessionId - %x\n",
+			       (session_id != NULL) ? *session_id : 0x0,
+			       *message_session_id));
+			return RETURN_DEVICE_ERROR;
+		}
+	} else {
+		if (message_session_id != NULL) {
+			DEBUG((DEBUG_INFO,
+			       "spdm_receive_spdm_response[%x] GetSessionId - %x\n",
+			       (session_id != NULL) ? *session_id : 0x0,
+			       *message_session_id));
+			return RETURN_DEVICE_ERROR;
+		}
+	}
+
+	if ((is_app_message && !is_message_app_message) ||
+	    (!is_app_message && is_message_app_message)) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_receive_spdm_response[%x] app_message mismatch\n",
+		       (session_id != NULL) ? *session_id : 0x0));
+		return RETURN_DEVICE_ERROR;
+	}
+
+	DEBUG((DEBUG_INFO, "spdm_receive_spdm_response[%x] (0x%x): \n",
+	       (session_id != NULL) ? *session_id : 0x0, *response_size));
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_receive_spdm_response[%x] status - %p\n",
+		       (session_id != NULL) ? *session_id : 0x0, status));
+	} else {
+		spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_RECEIVE,
+				   session_id, is_app_message, response,
+				   *response_size);
+	}
+	return status;
+}
+
+/**
+  Receive an SPDM or an APP response from a device, decoding the transport message in place.
+
+  The transport message is received into the caller buffer and decrypted there.
+  response is returned as a pointer into that buffer. No copy is made.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message_size                  size in bytes of the receive buffer.
+  @param  message                      A pointer to the receive buffer.
+  @param  response_size                 size in bytes of the decoded response.
+  @param  response                     A pointer to the decoded response inside message.
+
+  @retval RETURN_SUCCESS               The SPDM response is received successfully.
+  @retval RETURN_UNSUPPORTED           No in-place transport layer function is registered.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM response is received from the device.
+**/
+return_status spdm_receive_response_in_place(IN void *context,
+					     IN uint32 *session_id,
+					     IN boolean is_app_message,
+					     IN uintn message_size,
+					     IN OUT void *message,
+					     OUT uintn *response_size,
+					     OUT void **response)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+	uint32 *message_session_id;
+	boolean is_message_app_message;
+	uint64 metrics_begin;
+
+	spdm_context = context;
+
+	if (spdm_context->transport_decode_message_in_place == NULL) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	status = spdm_context->receive_message(spdm_context, &message_size,
+					       message, 0);
+	spdm_metrics_end(spdm_context, &spdm_context->requester_metrics.receive,
+			 metrics_begin);
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_INFO,
+		       "spdm_receive_spdm_response[%x] status - %p\n",
+		       (session_id != NULL) ? *session_id : 0x0, status));
+		return status;
+	}
+	spdm_context->requester_metrics.bytes_received += message_size;
+
+	message_session_id = NULL;
+	is_message_app_message = FALSE;
+	*response_size = 0;
+	*response = NULL;
+	metrics_begin = spdm_metrics_begin(spdm_context);
+	status = spdm_context->transport_decode_message_in_place(
+		spdm_context, &message_session_id, &is_message_app_message,
+		FALSE, message_size, message, response_size, response);
+	if (message_session_id != NULL) {
+		spdm_metrics_crypto_end(spdm_context, SPDM_CRYPTO_OP_AEAD,
+					metrics_begin);
+	}
 
 	if (session_id != NULL) {
 		if (message_session_id == NULL) {
@@ -144,7 +400,9 @@ return_status spdm_receive_response(IN void *context, IN uint32 *session_id,
 		       "spdm_receive_spdm_response[%x] status - %p\n",
 		       (session_id != NULL) ? *session_id : 0x0, status));
 	} else {
-		internal_dump_hex(response, *response_size);
+		spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_RECEIVE,
+				   session_id, is_app_message, *response,
+				   *response_size);
 	}
 	return status;
 }
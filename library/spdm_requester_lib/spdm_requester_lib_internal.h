@@ -52,6 +52,72 @@ return_status spdm_handle_error_response_main(
 	IN uint8 original_request_code, IN uint8 expected_response_code,
 	IN uintn expected_response_size);
 
+//
+// Retries of one request answered with BUSY, following spdm_context->retry_policy.
+//
+typedef struct {
+	uintn retry_count;
+	uint64 backoff_us;
+} spdm_retry_state_t;
+
+/**
+  Return the time in microseconds encoded as a power of 2, as CTExponent and RDTExponent.
+
+  @param  exponent                      The exponent.
+
+  @return 2^exponent, or MAX_UINT64 if it does not fit.
+**/
+uint64 spdm_exponent_to_us(IN uint8 exponent);
+
+/**
+  This function starts the retries of a request.
+
+  The deadline of the retry policy, if any, starts from now.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry_state                   The retry state of the request.
+**/
+void spdm_retry_start(IN spdm_context_t *spdm_context,
+		      OUT spdm_retry_state_t *retry_state);
+
+/**
+  This function checks if the deadline of the current request is passed after a wait.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  wait_us                       The time to wait in microseconds.
+
+  @retval TRUE                         The deadline is passed after the wait.
+  @retval FALSE                        There is no deadline, or it is not passed after the wait.
+**/
+boolean spdm_retry_deadline_passed(IN spdm_context_t *spdm_context,
+				   IN uint64 wait_us);
+
+/**
+  This function decides if a request answered with BUSY is retried, and how long to wait before.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry_state                   The retry state of the request.
+  @param  wait_us                       The time to wait in microseconds before the retry.
+
+  @retval TRUE                         The request is retried after wait_us.
+  @retval FALSE                        The retries are exhausted or the deadline would be passed.
+**/
+boolean spdm_retry_next(IN spdm_context_t *spdm_context,
+			IN OUT spdm_retry_state_t *retry_state,
+			OUT uint64 *wait_us);
+
+/**
+  This function decides if a request answered with BUSY is retried, and waits before the retry.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry_state                   The retry state of the request.
+
+  @retval TRUE                         The request can be sent again.
+  @retval FALSE                        The retries are exhausted or the deadline would be passed.
+**/
+boolean spdm_retry_wait(IN spdm_context_t *spdm_context,
+			IN OUT spdm_retry_state_t *retry_state);
+
 /**
   This function sends GET_VERSION and receives VERSION.
 
@@ -377,4 +443,177 @@ return_status spdm_receive_spdm_response(IN spdm_context_t *spdm_context,
 					 IN OUT uintn *response_size,
 					 OUT void *response);
 
+/**
+  Decode an SPDM response received from a device.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message_size                  size in bytes of the transport message.
+  @param  message                      A pointer to the transport message.
+  @param  response_size                 size in bytes of the response data buffer.
+  @param  response                     A pointer to a destination buffer to store the response.
+
+  @retval RETURN_SUCCESS               The SPDM response is decoded successfully.
+  @retval RETURN_DEVICE_ERROR          The message cannot be decoded or does not match the session.
+**/
+return_status spdm_decode_response(IN void *context, IN uint32 *session_id,
+				   IN boolean is_app_message,
+				   IN uintn message_size, IN void *message,
+				   IN OUT uintn *response_size,
+				   OUT void *response);
+
+//
+// The build/process halves of each requester flow.
+// The blocking APIs send the built request, receive the response and process it,
+// the asynchronous operations (async_op.c) do the same from an event loop.
+//
+
+return_status spdm_build_get_version_request(IN spdm_context_t *spdm_context,
+					     OUT void *request,
+					     OUT uintn *request_size);
+
+return_status spdm_process_version_response(IN spdm_context_t *spdm_context,
+					    IN void *request,
+					    IN uintn request_size,
+					    IN uintn response_size,
+					    IN OUT void *response);
+
+return_status spdm_build_get_capabilities_request(IN spdm_context_t *spdm_context,
+						  OUT void *request,
+						  OUT uintn *request_size);
+
+return_status spdm_process_capabilities_response(IN spdm_context_t *spdm_context,
+						 IN void *request,
+						 IN uintn request_size,
+						 IN uintn response_size,
+						 IN OUT void *response);
+
+return_status spdm_build_negotiate_algorithms_request(IN spdm_context_t *spdm_context,
+						      OUT void *request,
+						      OUT uintn *request_size);
+
+return_status spdm_process_algorithms_response(IN spdm_context_t *spdm_context,
+						IN void *request,
+						IN uintn request_size,
+						IN uintn response_size,
+						IN OUT void *response);
+
+return_status spdm_build_get_digest_request(IN void *context,
+					    OUT void *request,
+					    OUT uintn *request_size);
+
+return_status spdm_process_digests_response(IN void *context,
+					    IN void *request,
+					    IN uintn request_size,
+					    IN uintn response_size,
+					    IN OUT void *response,
+					    OUT uint8 *slot_mask,
+					    OUT void *total_digest_buffer);
+
+return_status spdm_begin_get_certificate(IN void *context, IN uint8 slot_id);
+
+return_status spdm_build_get_certificate_request(
+	IN void *context, IN uint8 slot_id, IN uint16 length,
+	IN large_managed_buffer_t *certificate_chain_buffer, OUT void *request,
+	OUT uintn *request_size);
+
+return_status spdm_process_certificate_response(
+	IN void *context, IN uint8 slot_id, IN void *request,
+	IN uintn request_size, IN uintn response_size, IN OUT void *response,
+	IN OUT large_managed_buffer_t *certificate_chain_buffer);
+
+return_status spdm_end_get_certificate(
+	IN void *context, IN uint8 slot_id,
+	IN large_managed_buffer_t *certificate_chain_buffer,
+	IN OUT uintn *cert_chain_size, OUT void *cert_chain,
+	OUT void **trust_anchor OPTIONAL, OUT uintn *trust_anchor_size OPTIONAL);
+
+return_status spdm_build_challenge_request(IN void *context, IN uint8 slot_id,
+					   IN uint8 measurement_hash_type,
+					   IN void *requester_nonce_in OPTIONAL,
+					   OUT void *requester_nonce OPTIONAL,
+					   OUT void *request,
+					   OUT uintn *request_size);
+
+return_status spdm_process_challenge_auth_response(
+	IN void *context, IN uint8 slot_id, IN uint8 measurement_hash_type,
+	IN void *request, IN uintn request_size, IN uintn response_size,
+	IN OUT void *response, OUT void *measurement_hash,
+	OUT void *responder_nonce OPTIONAL, OUT boolean *basic_mut_auth_req);
+
+return_status spdm_build_get_measurement_request(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 measurement_operation, IN uint8 slot_id_param,
+	IN void *requester_nonce_in OPTIONAL, OUT void *requester_nonce OPTIONAL,
+	OUT void *request, OUT uintn *request_size);
+
+return_status spdm_process_measurements_response(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 measurement_operation, IN uint8 slot_id_param, IN void *request,
+	IN uintn request_size, IN uintn response_size, IN OUT void *response,
+	OUT uint8 *number_of_blocks, IN OUT uint32 *measurement_record_length,
+	OUT void *measurement_record, OUT void *responder_nonce OPTIONAL);
+
+typedef enum {
+	SPDM_OP_TYPE_INIT_CONNECTION,
+	SPDM_OP_TYPE_GET_DIGEST,
+	SPDM_OP_TYPE_GET_CERTIFICATE,
+	SPDM_OP_TYPE_CHALLENGE,
+	SPDM_OP_TYPE_GET_MEASUREMENT,
+} spdm_op_type_t;
+
+typedef struct {
+	spdm_context_t *spdm_context;
+	spdm_op_type_t op_type;
+	//
+	// Progress of the operation.
+	// request_code is the request in flight, and request holds it.
+	// respond_if_ready is set while RESPOND_IF_READY is sent for it, and
+	// respond_if_ready_count counts the RESPOND_IF_READY sent for it.
+	//
+	spdm_op_status_t op_status;
+	return_status status;
+	uint8 request_code;
+	boolean respond_if_ready;
+	uintn respond_if_ready_count;
+	spdm_retry_state_t retry_state;
+	//
+	// Wait before the next request, while op_status is SPDM_OP_STATUS_WAIT.
+	// wait_respond_if_ready tells if the next request is RESPOND_IF_READY or
+	// the retry of request_code. wait_until_us is only used if a clock is registered.
+	//
+	boolean wait_respond_if_ready;
+	boolean wait_reported;
+	uint64 wait_us;
+	uint64 wait_until_us;
+	boolean use_session;
+	uint32 session_id;
+	uintn request_size;
+	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	//
+	// Parameters of the operation
+	//
+	boolean get_version_only;
+	uint8 slot_id;
+	uint8 measurement_hash_type;
+	uint8 request_attribute;
+	uint8 measurement_operation;
+	//
+	// Output of the operation
+	//
+	uint8 *slot_mask;
+	void *total_digest_buffer;
+	uintn *cert_chain_size;
+	void *cert_chain;
+	void *measurement_hash;
+	uint8 *number_of_blocks;
+	uint32 *measurement_record_length;
+	void *measurement_record;
+	large_managed_buffer_t certificate_chain_buffer;
+} spdm_op_context_t;
+
 #endif
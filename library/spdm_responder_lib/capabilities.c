@@ -23,10 +23,10 @@ boolean spdm_check_request_version_compability(IN spdm_context_t *spdm_context,
 	uintn index;
 
 	for (index = 0; 
-		index < spdm_context->local_context.version.spdm_version_count; 
+		index < spdm_context->local_context->version.spdm_version_count; 
 		index++) {
 		local_ver = spdm_get_version_from_version_number(
-						spdm_context->local_context.version.spdm_version[index]);
+						spdm_context->local_context->version.spdm_version[index]);
 		if (local_ver == version) {
 			spdm_context->connection_info.version.major_version = version >> 4;
 			spdm_context->connection_info.version.minor_version = version;
@@ -220,8 +220,8 @@ return_status spdm_get_response_capabilities(IN void *context,
 	spdm_response->header.param1 = 0;
 	spdm_response->header.param2 = 0;
 	spdm_response->ct_exponent =
-		spdm_context->local_context.capability.ct_exponent;
-	spdm_response->flags = spdm_context->local_context.capability.flags;
+		spdm_context->local_context->capability.ct_exponent;
+	spdm_response->flags = spdm_context->local_context->capability.flags;
 	//
 	// Cache
 	//
@@ -79,7 +79,7 @@ return_status spdm_get_response_certificate(IN void *context,
 
 	slot_id = spdm_request->header.param1;
 
-	if (slot_id >= spdm_context->local_context.slot_count) {
+	if (slot_id >= spdm_context->local_context->slot_count) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -87,7 +87,7 @@ return_status spdm_get_response_certificate(IN void *context,
 	}
 
 	if (spdm_context->local_context
-					  .local_cert_chain_provision[slot_id] == NULL) {
+					  ->local_cert_chain_provision[slot_id] == NULL) {
 		spdm_generate_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
 			0, response_size, response);
@@ -101,7 +101,7 @@ return_status spdm_get_response_certificate(IN void *context,
 	}
 
 	if (offset >= spdm_context->local_context
-			      .local_cert_chain_provision_size[slot_id]) {
+			      ->local_cert_chain_provision_size[slot_id]) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -113,14 +113,14 @@ return_status spdm_get_response_certificate(IN void *context,
 
 	if ((uintn)(offset + length) >
 	    spdm_context->local_context
-		    .local_cert_chain_provision_size[slot_id]) {
+		    ->local_cert_chain_provision_size[slot_id]) {
 		length = (uint16)(
 			spdm_context->local_context
-				.local_cert_chain_provision_size[slot_id] -
+				->local_cert_chain_provision_size[slot_id] -
 			offset);
 	}
 	remainder_length = spdm_context->local_context
-				   .local_cert_chain_provision_size[slot_id] -
+				   ->local_cert_chain_provision_size[slot_id] -
 			   (length + offset);
 
 	ASSERT(*response_size >= sizeof(spdm_certificate_response_t) + length);
@@ -140,7 +140,7 @@ return_status spdm_get_response_certificate(IN void *context,
 	spdm_response->remainder_length = (uint16)remainder_length;
 	copy_mem(spdm_response + 1,
 		 (uint8 *)spdm_context->local_context
-				 .local_cert_chain_provision[slot_id] +
+				 ->local_cert_chain_provision[slot_id] +
 			 offset,
 		 length);
 	//
@@ -11,6 +11,18 @@
 /**
   Process the SPDM GET_DIGESTS request and return the response.
 
+  GET_DIGESTS is accepted in any state after NEGOTIATE_ALGORITHMS. A requester resuming a
+  connection with spdm_resume_connection skips VCA and starts with GET_DIGESTS, while this
+  responder may have kept the state of the previous connection. If GET_DIGESTS comes after
+  DIGESTS, message B and C are restarted from message A, so that a following CHALLENGE is
+  signed over the transcript of the resumed connection, and the state goes back to
+  SPDM_CONNECTION_STATE_AFTER_DIGESTS, so that GET_CERTIFICATE is accepted again.
+
+  This deliberately deviates from the original check, which only accepted GET_DIGESTS in
+  SPDM_CONNECTION_STATE_NEGOTIATED and answered UnexpectedRequest afterwards. An
+  authenticated responder now drops its B, C, mut B and mut C transcripts on GET_DIGESTS,
+  and must be authenticated again with CHALLENGE.
+
   @param  spdm_context                  A pointer to the SPDM context.
   @param  request_size                  size in bytes of the request data.
   @param  request                      A pointer to the request data.
@@ -57,7 +69,7 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 			SPDM_GET_DIGESTS, response_size, response);
 		return RETURN_SUCCESS;
 	}
-	if (spdm_context->connection_info.connection_state !=
+	if (spdm_context->connection_info.connection_state <
 	    SPDM_CONNECTION_STATE_NEGOTIATED) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_UNEXPECTED_REQUEST,
@@ -74,13 +86,21 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 						spdm_request->header.request_response_code);
+	// GET_DIGESTS after DIGESTS restarts the transcript, see the function description.
+	if (spdm_context->connection_info.connection_state >=
+	    SPDM_CONNECTION_STATE_AFTER_DIGESTS) {
+		spdm_reset_message_b(spdm_context);
+		spdm_reset_message_c(spdm_context);
+		spdm_reset_message_mut_b(spdm_context);
+		spdm_reset_message_mut_c(spdm_context);
+	}
 
 	spdm_request_size = request_size;
 
 	no_local_cert_chain = TRUE;
 	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
 		if (spdm_context->local_context
-			    .local_cert_chain_provision[index] != NULL) {
+			    ->local_cert_chain_provision[index] != NULL) {
 			no_local_cert_chain = FALSE;
 		}
 	}
@@ -96,9 +116,9 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 
 	ASSERT(*response_size >=
 	       sizeof(spdm_digest_response_t) +
-		       hash_size * spdm_context->local_context.slot_count);
+		       hash_size * spdm_context->local_context->slot_count);
 	*response_size = sizeof(spdm_digest_response_t) +
-			 hash_size * spdm_context->local_context.slot_count;
+			 hash_size * spdm_context->local_context->slot_count;
 	zero_mem(response, *response_size);
 	spdm_response = response;
 
@@ -112,10 +132,10 @@ return_status spdm_get_response_digests(IN void *context, IN uintn request_size,
 	spdm_response->header.param2 = 0;
 
 	digest = (void *)(spdm_response + 1);
-	for (index = 0; index < spdm_context->local_context.slot_count;
+	for (index = 0; index < spdm_context->local_context->slot_count;
 	     index++) {
 		if (spdm_context->local_context
-						  .local_cert_chain_provision[index] == NULL) {
+						  ->local_cert_chain_provision[index] == NULL) {
 			spdm_generate_error_response(
 				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
 				0, response_size, response);
@@ -163,8 +163,8 @@ return_status spdm_process_encap_response_certificate(
 
 	*need_continue = FALSE;
 
-	if (spdm_context->local_context.verify_peer_spdm_cert_chain != NULL) {
-		status = spdm_context->local_context.verify_peer_spdm_cert_chain (
+	if (spdm_context->local_context->verify_peer_spdm_cert_chain != NULL) {
+		status = spdm_context->local_context->verify_peer_spdm_cert_chain (
 			spdm_context, spdm_context->encap_context.req_slot_id, 
 			get_managed_buffer_size(
 				&spdm_context->encap_context.certificate_chain_buffer),
@@ -200,6 +200,12 @@ return_status spdm_process_encap_response_certificate(
 			&spdm_context->encap_context.certificate_chain_buffer),
 		get_managed_buffer_size(
 			&spdm_context->encap_context.certificate_chain_buffer));
+	spdm_register_cert_chain_digest(
+		spdm_context,
+		spdm_context->connection_info.peer_used_cert_chain_buffer,
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		&spdm_context->connection_info.peer_used_cert_chain_digest);
+	spdm_free_peer_public_key(spdm_context);
 
 	spdm_context->encap_context.error_state = SPDM_STATUS_SUCCESS;
 
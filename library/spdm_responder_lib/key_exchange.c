@@ -102,7 +102,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 
 	slot_id = spdm_request->header.param2;
 	if ((slot_id != 0xFF) &&
-	    (slot_id >= spdm_context->local_context.slot_count)) {
+	    (slot_id >= spdm_context->local_context->slot_count)) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -110,7 +110,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	}
 
 	if (slot_id == 0xFF) {
-		slot_id = spdm_context->local_context.provisioned_slot_id;
+		slot_id = spdm_context->local_context->provisioned_slot_id;
 	}
 
 	signature_size = spdm_get_asym_signature_size(
@@ -186,7 +186,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	spdm_response->header.param1 = 0;
 
 	req_session_id = spdm_request->req_session_id;
-	rsp_session_id = spdm_allocate_rsp_session_id(spdm_context);
+	rsp_session_id = spdm_multi_peer_allocate_rsp_session_id(spdm_context);
 	if (rsp_session_id == (INVALID_SESSION_ID & 0xFFFF)) {
 		spdm_generate_error_response(
 			spdm_context, SPDM_ERROR_CODE_SESSION_LIMIT_EXCEEDED, 0,
@@ -216,7 +216,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 		     spdm_context, FALSE,
 		     SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PUB_KEY_ID_CAP, 0))) {
 		spdm_response->mut_auth_requested =
-			spdm_context->local_context.mut_auth_requested;
+			spdm_context->local_context->mut_auth_requested;
 	}
 	if (spdm_response->mut_auth_requested != 0) {
 		spdm_init_mut_auth_encap_state(
@@ -231,11 +231,17 @@ return_status spdm_get_response_key_exchange(IN void *context,
 			       spdm_response->random_data);
 
 	ptr = (void *)(spdm_response + 1);
-	dhe_context = spdm_secured_message_dhe_new(
-		spdm_context->connection_info.algorithm.dhe_named_group);
-	spdm_secured_message_dhe_generate_key(
-		spdm_context->connection_info.algorithm.dhe_named_group,
-		dhe_context, ptr, &dhe_key_size);
+	dhe_context = spdm_secured_message_dhe_new_key(
+		spdm_context->local_context->dhe_key_pool,
+		spdm_context->connection_info.algorithm.dhe_named_group, ptr,
+		&dhe_key_size);
+	if (dhe_context == NULL) {
+		spdm_free_session_id(spdm_context, session_id);
+		spdm_generate_error_response(spdm_context,
+					     SPDM_ERROR_CODE_UNSPECIFIED, 0,
+					     response_size, response);
+		return RETURN_SUCCESS;
+	}
 	DEBUG((DEBUG_INFO, "Calc SelfKey (0x%x):\n", dhe_key_size));
 	internal_dump_hex(ptr, dhe_key_size);
 
@@ -281,10 +287,10 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	ptr += opaque_key_exchange_rsp_size;
 
 	spdm_context->connection_info.local_used_cert_chain_buffer =
-		spdm_context->local_context.local_cert_chain_provision[slot_id];
+		spdm_context->local_context->local_cert_chain_provision[slot_id];
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		spdm_context->local_context
-			.local_cert_chain_provision_size[slot_id];
+			->local_cert_chain_provision_size[slot_id];
 
 	status = spdm_append_message_k(spdm_context, session_info, FALSE, request, request_size);
 	if (RETURN_ERROR(status)) {
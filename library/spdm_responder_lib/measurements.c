@@ -36,7 +36,7 @@ boolean spdm_create_measurement_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_asym_algo);
 	measurment_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size +
+		spdm_context->local_context->opaque_measurement_rsp_size +
 		signature_size;
 	ASSERT(response_message_size > measurment_sig_size);
 	ptr = (void *)((uint8 *)response_message + response_message_size -
@@ -46,11 +46,11 @@ boolean spdm_create_measurement_signature(IN spdm_context_t *spdm_context,
 	ptr += SPDM_NONCE_SIZE;
 
 	*(uint16 *)ptr =
-		(uint16)spdm_context->local_context.opaque_measurement_rsp_size;
+		(uint16)spdm_context->local_context->opaque_measurement_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_measurement_rsp,
-		 spdm_context->local_context.opaque_measurement_rsp_size);
-	ptr += spdm_context->local_context.opaque_measurement_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_measurement_rsp,
+		 spdm_context->local_context->opaque_measurement_rsp_size);
+	ptr += spdm_context->local_context->opaque_measurement_rsp_size;
 
 	status = spdm_append_message_m(spdm_context, session_info, response_message,
 				       response_message_size - signature_size);
@@ -78,7 +78,7 @@ void spdm_create_measurement_opaque(IN spdm_context_t *spdm_context,
 
 	measurment_no_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size;
+		spdm_context->local_context->opaque_measurement_rsp_size;
 	ASSERT(response_message_size > measurment_no_sig_size);
 	ptr = (void *)((uint8 *)response_message + response_message_size -
 		       measurment_no_sig_size);
@@ -87,11 +87,11 @@ void spdm_create_measurement_opaque(IN spdm_context_t *spdm_context,
 	ptr += SPDM_NONCE_SIZE;
 	
 	*(uint16 *)ptr =
-		(uint16)spdm_context->local_context.opaque_measurement_rsp_size;
+		(uint16)spdm_context->local_context->opaque_measurement_rsp_size;
 	ptr += sizeof(uint16);
-	copy_mem(ptr, spdm_context->local_context.opaque_measurement_rsp,
-		 spdm_context->local_context.opaque_measurement_rsp_size);
-	ptr += spdm_context->local_context.opaque_measurement_rsp_size;
+	copy_mem(ptr, spdm_context->local_context->opaque_measurement_rsp,
+		 spdm_context->local_context->opaque_measurement_rsp_size);
+	ptr += spdm_context->local_context->opaque_measurement_rsp_size;
 
 	return;
 }
@@ -133,7 +133,7 @@ return_status spdm_get_response_measurements(IN void *context,
 	spdm_measurement_block_dmtf_t *cached_measurment_block;
 	spdm_context_t *spdm_context;
 	uint8 slot_id_param;
-	uint8 device_measurement[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 *device_measurement;
 	uint8 device_measurement_count;
 	uintn device_measurement_size;
 	boolean ret;
@@ -246,33 +246,27 @@ return_status spdm_get_response_measurements(IN void *context,
 		}
 	}
 
-	device_measurement_size = sizeof(device_measurement);
-	ret = spdm_measurement_collection(
-		spdm_context->connection_info.version,
-		spdm_context->connection_info.algorithm.measurement_spec,
-		spdm_context->connection_info.algorithm.measurement_hash_algo,
-		&device_measurement_count, device_measurement,
-		&device_measurement_size);
-	if (!ret) {
-		spdm_generate_error_response(spdm_context,
-					     SPDM_ERROR_CODE_UNSPECIFIED,
-					     0, response_size, response);
-		return RETURN_SUCCESS;
-	}
-	ASSERT(device_measurement_count <= MAX_SPDM_MEASUREMENT_BLOCK_COUNT);
-
 	signature_size = spdm_get_asym_signature_size(
 		spdm_context->connection_info.algorithm.base_asym_algo);
 	measurment_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size +
+		spdm_context->local_context->opaque_measurement_rsp_size +
 		signature_size;
 	measurment_no_sig_size =
 		SPDM_NONCE_SIZE + sizeof(uint16) +
-		spdm_context->local_context.opaque_measurement_rsp_size;
+		spdm_context->local_context->opaque_measurement_rsp_size;
 
 	switch (spdm_request->header.param2) {
 	case SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS:
+		ret = spdm_measurement_cache_get_count(
+			spdm_context, &device_measurement_count);
+		if (!ret) {
+			spdm_generate_error_response(
+				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED, 0,
+				response_size, response);
+			return RETURN_SUCCESS;
+		}
+
 		spdm_response_size = sizeof(spdm_measurements_response_t);
 		if ((spdm_request->header.param1 &
 		     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
@@ -309,7 +303,7 @@ return_status spdm_get_response_measurements(IN void *context,
 				slot_id_param = spdm_request->SlotIDParam;
 				if ((slot_id_param != 0xF) &&
 				    (slot_id_param >=
-				     spdm_context->local_context.slot_count)) {
+				     spdm_context->local_context->slot_count)) {
 					spdm_generate_error_response(
 						spdm_context,
 						SPDM_ERROR_CODE_INVALID_REQUEST,
@@ -326,6 +320,18 @@ return_status spdm_get_response_measurements(IN void *context,
 		break;
 
 	case SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS:
+		ret = spdm_measurement_cache_get_record(
+			spdm_context, &device_measurement_count,
+			&device_measurement, &device_measurement_size);
+		if (!ret) {
+			spdm_generate_error_response(
+				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED, 0,
+				response_size, response);
+			return RETURN_SUCCESS;
+		}
+		ASSERT(device_measurement_count <=
+		       MAX_SPDM_MEASUREMENT_BLOCK_COUNT);
+
 		measurment_record_size = 0;
 		cached_measurment_block = (void *)device_measurement;
 		for (index = 0; index < device_measurement_count; index++) {
@@ -395,7 +401,7 @@ return_status spdm_get_response_measurements(IN void *context,
 				slot_id_param = spdm_request->SlotIDParam;
 				if ((slot_id_param != 0xF) &&
 				    (slot_id_param >=
-				     spdm_context->local_context.slot_count)) {
+				     spdm_context->local_context->slot_count)) {
 					spdm_generate_error_response(
 						spdm_context,
 						SPDM_ERROR_CODE_INVALID_REQUEST,
@@ -412,97 +418,85 @@ return_status spdm_get_response_measurements(IN void *context,
 		break;
 
 	default:
-		measurment_record_size = 0;
-		cached_measurment_block = (void *)device_measurement;
-		for (index = 0; index < device_measurement_count;
-				index++) {
-			measurment_block_size =
-				sizeof(spdm_measurement_block_dmtf_t) +
-				cached_measurment_block
-					->Measurement_block_dmtf_header
-					.dmtf_spec_measurement_value_size;
-			if (cached_measurment_block->Measurement_block_common_header.index == 
-				spdm_request->header.param2) {
-				measurment_record_size =
-					measurment_block_size;
-				break;
-			}
-			cached_measurment_block =
-				(void *)((uintn)cached_measurment_block +
-						measurment_block_size);
-		}
-		if (index != device_measurement_count ) {
-			spdm_response_size =
-				sizeof(spdm_measurements_response_t) +
-				measurment_record_size;
-			if ((spdm_request->header.param1 &
-			     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
-			    0) {
-				spdm_response_size += measurment_sig_size;
-			} else {
-				spdm_response_size += measurment_no_sig_size;
-			}
-
-			ASSERT(*response_size >= spdm_response_size);
-			*response_size = spdm_response_size;
-			zero_mem(response, *response_size);
-			spdm_response = response;
-
-			if (spdm_is_version_supported(
-				    spdm_context, SPDM_MESSAGE_VERSION_11)) {
-				spdm_response->header.spdm_version =
-					SPDM_MESSAGE_VERSION_11;
-			} else {
-				spdm_response->header.spdm_version =
-					SPDM_MESSAGE_VERSION_10;
-			}
-			spdm_response->header.request_response_code =
-				SPDM_MEASUREMENTS;
-			spdm_response->header.param1 = 0;
-			spdm_response->header.param2 = 0;
-			spdm_response->number_of_blocks = 1;
-			spdm_write_uint24(
-				spdm_response->measurement_record_length,
-				(uint32)measurment_record_size);
-
-			measurment_block = (void *)(spdm_response + 1);
-			copy_mem(measurment_block,
-					cached_measurment_block,
-					measurment_block_size);
-
-			if ((spdm_request->header.param1 &
-			     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
-			    0) {
-				if (spdm_response->header.spdm_version >=
-				    SPDM_MESSAGE_VERSION_11) {
-					slot_id_param =
-						spdm_request->SlotIDParam;
-					if ((slot_id_param != 0xF) &&
-					    (slot_id_param >=
-					     spdm_context->local_context
-						     .slot_count)) {
-						spdm_generate_error_response(
-							spdm_context,
-							SPDM_ERROR_CODE_INVALID_REQUEST,
-							0, response_size,
-							response);
-						return RETURN_SUCCESS;
-					}
-					spdm_response->header.param2 =
-						slot_id_param;
-				}
-			} else {
-				spdm_create_measurement_opaque(
-					spdm_context, spdm_response,
-					spdm_response_size);
-			}
-		} else {
+		// collect the requested block straight into the response
+		ASSERT(*response_size >= sizeof(spdm_measurements_response_t));
+		spdm_response = response;
+		measurment_block = (void *)(spdm_response + 1);
+		measurment_block_size =
+			*response_size - sizeof(spdm_measurements_response_t);
+		status = spdm_measurement_cache_get_block(
+			spdm_context, spdm_request->header.param2,
+			measurment_block, &measurment_block_size);
+		if (status == RETURN_NOT_FOUND) {
 			//Block not found
 			spdm_generate_error_response(
 				spdm_context, SPDM_ERROR_CODE_INVALID_REQUEST,
 				0, response_size, response);
 			return RETURN_SUCCESS;
 		}
+		if (RETURN_ERROR(status)) {
+			spdm_generate_error_response(
+				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED, 0,
+				response_size, response);
+			return RETURN_SUCCESS;
+		}
+		measurment_record_size = measurment_block_size;
+
+		spdm_response_size = sizeof(spdm_measurements_response_t) +
+				     measurment_record_size;
+		if ((spdm_request->header.param1 &
+		     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
+		    0) {
+			spdm_response_size += measurment_sig_size;
+		} else {
+			spdm_response_size += measurment_no_sig_size;
+		}
+
+		ASSERT(*response_size >= spdm_response_size);
+		*response_size = spdm_response_size;
+		zero_mem(response, sizeof(spdm_measurements_response_t));
+		zero_mem((uint8 *)measurment_block + measurment_record_size,
+			 spdm_response_size -
+				 sizeof(spdm_measurements_response_t) -
+				 measurment_record_size);
+
+		if (spdm_is_version_supported(spdm_context,
+					      SPDM_MESSAGE_VERSION_11)) {
+			spdm_response->header.spdm_version =
+				SPDM_MESSAGE_VERSION_11;
+		} else {
+			spdm_response->header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+		}
+		spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+		spdm_response->header.param1 = 0;
+		spdm_response->header.param2 = 0;
+		spdm_response->number_of_blocks = 1;
+		spdm_write_uint24(spdm_response->measurement_record_length,
+				  (uint32)measurment_record_size);
+
+		if ((spdm_request->header.param1 &
+		     SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) !=
+		    0) {
+			if (spdm_response->header.spdm_version >=
+			    SPDM_MESSAGE_VERSION_11) {
+				slot_id_param = spdm_request->SlotIDParam;
+				if ((slot_id_param != 0xF) &&
+				    (slot_id_param >=
+				     spdm_context->local_context->slot_count)) {
+					spdm_generate_error_response(
+						spdm_context,
+						SPDM_ERROR_CODE_INVALID_REQUEST,
+						0, response_size, response);
+					return RETURN_SUCCESS;
+				}
+				spdm_response->header.param2 = slot_id_param;
+			}
+		} else {
+			spdm_create_measurement_opaque(spdm_context,
+						       spdm_response,
+						       spdm_response_size);
+		}
 		break;
 	}
 
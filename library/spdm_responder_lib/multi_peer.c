@@ -0,0 +1,796 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_responder_lib_internal.h"
+
+/**
+  Return the size of an open-addressed hash table for a number of entries.
+
+  The size is a power of two, and at least twice the number of entries.
+
+  @param  entry_count                   The maximum number of entries in the table.
+
+  @return the number of slots in the table.
+**/
+uintn spdm_multi_peer_get_table_size(IN uintn entry_count)
+{
+	uintn table_size;
+
+	table_size = 2;
+	while (table_size < entry_count * 2) {
+		table_size <<= 1;
+	}
+	return table_size;
+}
+
+/**
+  Return the home slot of a key in an open-addressed hash table.
+
+  @param  key                           The key of the entry.
+  @param  table_size                    The number of slots in the table, a power of two.
+
+  @return the home slot of the key.
+**/
+uintn spdm_multi_peer_hash(IN uint64 key, IN uintn table_size)
+{
+	return (uintn)((key * 0x9E3779B97F4A7C15ull) >> 32) & (table_size - 1);
+}
+
+/**
+  Return the size in bytes of a multi-peer responder context.
+
+  The multi-peer responder context holds the connection table, the session table and
+  one SPDM context for each connection in a single buffer. The SPDM context of a
+  connection only holds the connection and session state of the peer.
+
+  @param  max_connection_count          The maximum number of peers served at the same time.
+  @param  max_session_count             The maximum number of secured sessions across all peers.
+  @param  max_connection_session_count  The maximum number of secured sessions of one peer.
+
+  @return the size in bytes of the multi-peer responder context.
+**/
+uintn spdm_multi_peer_get_context_size(IN uintn max_connection_count,
+				       IN uintn max_session_count,
+				       IN uintn max_connection_session_count)
+{
+	uintn size;
+
+	size = ALIGN_VALUE(sizeof(spdm_multi_peer_context_t), sizeof(uint64));
+	size += ALIGN_VALUE(sizeof(spdm_multi_peer_connection_t) *
+				    max_connection_count,
+			    sizeof(uint64));
+	size += ALIGN_VALUE(sizeof(uint32) * max_connection_session_count *
+				    max_connection_count,
+			    sizeof(uint64));
+	size += ALIGN_VALUE(sizeof(uintn) * spdm_multi_peer_get_table_size(
+						    max_connection_count),
+			    sizeof(uint64));
+	size += ALIGN_VALUE(sizeof(spdm_multi_peer_session_t) *
+				    spdm_multi_peer_get_table_size(
+					    max_session_count),
+			    sizeof(uint64));
+	size += ALIGN_VALUE(spdm_get_connection_context_size(
+				    max_connection_session_count),
+			    sizeof(uint64)) *
+		max_connection_count;
+	return size;
+}
+
+/**
+  Initialize a multi-peer responder context.
+
+  The template SPDM context holds the local provisioning shared by all connections:
+  the local capabilities and algorithms, certificate chains, PSK hint, opaque data and
+  responder policy, and the measurement cache. The connections use them in place.
+  The transport layer functions and registered callbacks of the template SPDM context
+  are copied into each connection when the first message from a new endpoint is received,
+  so they must be registered before then.
+  The template SPDM context must stay valid for the lifetime of the multi-peer context.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  max_connection_count          The maximum number of peers served at the same time.
+  @param  max_session_count             The maximum number of secured sessions across all peers.
+  @param  max_connection_session_count  The maximum number of secured sessions of one peer.
+  @param  template_spdm_context         A pointer to the provisioned template SPDM context.
+
+  @retval RETURN_SUCCESS               The multi-peer responder context is initialized.
+  @retval RETURN_INVALID_PARAMETER     The connection count or session count is out of range.
+**/
+return_status spdm_multi_peer_init_context(IN void *multi_peer_context,
+					   IN uintn max_connection_count,
+					   IN uintn max_session_count,
+					   IN uintn max_connection_session_count,
+					   IN void *template_spdm_context)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	uint8 *ptr;
+	uint32 *session_id;
+	uintn index;
+
+	//
+	// The responder half of a session ID is unique across all connections.
+	//
+	if ((max_connection_count == 0) || (max_session_count > 0xFFFF) ||
+	    (max_connection_session_count > max_session_count)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	multi_peer = multi_peer_context;
+	zero_mem(multi_peer, sizeof(spdm_multi_peer_context_t));
+	multi_peer->template_context = template_spdm_context;
+	multi_peer->max_connection_count = max_connection_count;
+	multi_peer->max_session_count = max_session_count;
+	multi_peer->max_connection_session_count = max_connection_session_count;
+	multi_peer->next_rsp_session_id = (INVALID_SESSION_ID & 0xFFFF) + 1;
+	multi_peer->connection_table_size =
+		spdm_multi_peer_get_table_size(max_connection_count);
+	multi_peer->session_table_size =
+		spdm_multi_peer_get_table_size(max_session_count);
+	multi_peer->spdm_context_size = ALIGN_VALUE(
+		spdm_get_connection_context_size(max_connection_session_count),
+		sizeof(uint64));
+
+	ptr = (uint8 *)multi_peer_context +
+	      ALIGN_VALUE(sizeof(spdm_multi_peer_context_t), sizeof(uint64));
+	multi_peer->connection = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(spdm_multi_peer_connection_t) *
+				   max_connection_count,
+			   sizeof(uint64));
+	session_id = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(uint32) * max_connection_session_count *
+				   max_connection_count,
+			   sizeof(uint64));
+	multi_peer->connection_table = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(uintn) * multi_peer->connection_table_size,
+			   sizeof(uint64));
+	multi_peer->session_table = (void *)ptr;
+	ptr += ALIGN_VALUE(sizeof(spdm_multi_peer_session_t) *
+				   multi_peer->session_table_size,
+			   sizeof(uint64));
+	multi_peer->spdm_context_buffer = ptr;
+
+	//
+	// Chain all connections in the free list. The SPDM context of a connection
+	// is initialized when the connection is created.
+	//
+	zero_mem(multi_peer->connection,
+		 sizeof(spdm_multi_peer_connection_t) * max_connection_count);
+	for (index = 0; index < max_connection_count; index++) {
+		multi_peer->connection[index].next_free_index = index + 1;
+		multi_peer->connection[index].session_id =
+			session_id + max_connection_session_count * index;
+		multi_peer->connection[index].spdm_context =
+			(void *)(multi_peer->spdm_context_buffer +
+				 multi_peer->spdm_context_size * index);
+	}
+	multi_peer->connection[max_connection_count - 1].next_free_index =
+		SPDM_MULTI_PEER_EMPTY_SLOT;
+	multi_peer->first_free_index = 0;
+
+	for (index = 0; index < multi_peer->connection_table_size; index++) {
+		multi_peer->connection_table[index] =
+			SPDM_MULTI_PEER_EMPTY_SLOT;
+	}
+	for (index = 0; index < multi_peer->session_table_size; index++) {
+		multi_peer->session_table[index].session_id =
+			INVALID_SESSION_ID;
+	}
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Register the device IO functions of a multi-peer responder.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  send_message                  The function to send an SPDM transport layer message to a peer.
+  @param  receive_message               The function to receive an SPDM transport layer message from any peer.
+**/
+void spdm_multi_peer_register_device_io_func(
+	IN void *multi_peer_context,
+	IN spdm_multi_peer_send_message_func send_message,
+	IN spdm_multi_peer_receive_message_func receive_message)
+{
+	spdm_multi_peer_context_t *multi_peer;
+
+	multi_peer = multi_peer_context;
+	multi_peer->send_message = send_message;
+	multi_peer->receive_message = receive_message;
+}
+
+/**
+  Find the slot of a peer in the connection hash table.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @return the slot holding the connection of the peer, or SPDM_MULTI_PEER_EMPTY_SLOT if there is none.
+**/
+uintn spdm_multi_peer_find_connection_slot(
+	IN spdm_multi_peer_context_t *multi_peer, IN uint64 endpoint_id)
+{
+	uintn mask;
+	uintn slot;
+	uintn connection_index;
+
+	mask = multi_peer->connection_table_size - 1;
+	slot = spdm_multi_peer_hash(endpoint_id,
+				    multi_peer->connection_table_size);
+	while (TRUE) {
+		connection_index = multi_peer->connection_table[slot];
+		if (connection_index == SPDM_MULTI_PEER_EMPTY_SLOT) {
+			return SPDM_MULTI_PEER_EMPTY_SLOT;
+		}
+		if (multi_peer->connection[connection_index].endpoint_id ==
+		    endpoint_id) {
+			return slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+}
+
+/**
+  Remove a slot from the connection hash table, and move the following
+  entries of the probe sequence back into the hole.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  slot                          The slot to remove.
+**/
+void spdm_multi_peer_remove_connection_slot(
+	IN spdm_multi_peer_context_t *multi_peer, IN uintn slot)
+{
+	uintn mask;
+	uintn next;
+	uintn home;
+	uintn connection_index;
+
+	mask = multi_peer->connection_table_size - 1;
+	multi_peer->connection_table[slot] = SPDM_MULTI_PEER_EMPTY_SLOT;
+	next = (slot + 1) & mask;
+	while (multi_peer->connection_table[next] !=
+	       SPDM_MULTI_PEER_EMPTY_SLOT) {
+		connection_index = multi_peer->connection_table[next];
+		home = spdm_multi_peer_hash(
+			multi_peer->connection[connection_index].endpoint_id,
+			multi_peer->connection_table_size);
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			multi_peer->connection_table[slot] = connection_index;
+			multi_peer->connection_table[next] =
+				SPDM_MULTI_PEER_EMPTY_SLOT;
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+}
+
+/**
+  Find the slot of a secured session in the session hash table.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  rsp_session_id                The responder half of the session ID.
+
+  @return the slot holding the session, or SPDM_MULTI_PEER_EMPTY_SLOT if there is none.
+**/
+uintn spdm_multi_peer_find_session_slot(
+	IN spdm_multi_peer_context_t *multi_peer, IN uint16 rsp_session_id)
+{
+	uintn mask;
+	uintn slot;
+	uint32 session_id;
+
+	mask = multi_peer->session_table_size - 1;
+	slot = spdm_multi_peer_hash(rsp_session_id,
+				    multi_peer->session_table_size);
+	while (TRUE) {
+		session_id = multi_peer->session_table[slot].session_id;
+		if (session_id == INVALID_SESSION_ID) {
+			return SPDM_MULTI_PEER_EMPTY_SLOT;
+		}
+		if ((session_id & 0xFFFF) == rsp_session_id) {
+			return slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+}
+
+/**
+  Record a secured session of a connection in the session hash table.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  session_id                    The SPDM session ID.
+  @param  connection_index              The index of the connection that owns the session.
+
+  @retval TRUE  the session is recorded.
+  @retval FALSE the session table is full, or the responder half of the session ID is in use.
+**/
+boolean spdm_multi_peer_insert_session(IN spdm_multi_peer_context_t *multi_peer,
+				       IN uint32 session_id,
+				       IN uintn connection_index)
+{
+	uintn mask;
+	uintn slot;
+
+	if (multi_peer->session_count >= multi_peer->max_session_count) {
+		return FALSE;
+	}
+	if (spdm_multi_peer_find_session_slot(
+		    multi_peer, (uint16)(session_id & 0xFFFF)) !=
+	    SPDM_MULTI_PEER_EMPTY_SLOT) {
+		return FALSE;
+	}
+
+	mask = multi_peer->session_table_size - 1;
+	slot = spdm_multi_peer_hash((uint16)(session_id & 0xFFFF),
+				    multi_peer->session_table_size);
+	while (multi_peer->session_table[slot].session_id !=
+	       INVALID_SESSION_ID) {
+		slot = (slot + 1) & mask;
+	}
+	multi_peer->session_table[slot].session_id = session_id;
+	multi_peer->session_table[slot].connection_index = connection_index;
+	multi_peer->session_count++;
+	return TRUE;
+}
+
+/**
+  Remove a secured session from the session hash table, and move the following
+  entries of the probe sequence back into the hole.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  session_id                    The SPDM session ID.
+**/
+void spdm_multi_peer_remove_session(IN spdm_multi_peer_context_t *multi_peer,
+				    IN uint32 session_id)
+{
+	uintn mask;
+	uintn slot;
+	uintn next;
+	uintn home;
+
+	slot = spdm_multi_peer_find_session_slot(
+		multi_peer, (uint16)(session_id & 0xFFFF));
+	if (slot == SPDM_MULTI_PEER_EMPTY_SLOT) {
+		return;
+	}
+
+	mask = multi_peer->session_table_size - 1;
+	multi_peer->session_table[slot].session_id = INVALID_SESSION_ID;
+	multi_peer->session_count--;
+	next = (slot + 1) & mask;
+	while (multi_peer->session_table[next].session_id !=
+	       INVALID_SESSION_ID) {
+		home = spdm_multi_peer_hash(
+			(uint16)(multi_peer->session_table[next].session_id &
+				 0xFFFF),
+			multi_peer->session_table_size);
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			copy_mem(&multi_peer->session_table[slot],
+				 &multi_peer->session_table[next],
+				 sizeof(spdm_multi_peer_session_t));
+			multi_peer->session_table[next].session_id =
+				INVALID_SESSION_ID;
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+}
+
+/**
+  Bring the session table in line with the sessions of one connection,
+  after the connection processed a message.
+
+  A new session of the connection that cannot be recorded is freed.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  connection_index              The index of the connection.
+
+  @retval RETURN_SUCCESS               All sessions of the connection are recorded.
+  @retval RETURN_OUT_OF_RESOURCES      A new session cannot be recorded and is freed.
+**/
+return_status
+spdm_multi_peer_sync_sessions(IN spdm_multi_peer_context_t *multi_peer,
+			      IN uintn connection_index)
+{
+	spdm_multi_peer_connection_t *connection;
+	return_status status;
+	uint32 session_id;
+	uintn index;
+
+	status = RETURN_SUCCESS;
+	connection = &multi_peer->connection[connection_index];
+	for (index = 0; index < multi_peer->max_connection_session_count;
+	     index++) {
+		session_id =
+			connection->spdm_context->session_info[index].session_id;
+		if (connection->session_id[index] == session_id) {
+			continue;
+		}
+		if (connection->session_id[index] != INVALID_SESSION_ID) {
+			spdm_multi_peer_remove_session(
+				multi_peer, connection->session_id[index]);
+		}
+		connection->session_id[index] = INVALID_SESSION_ID;
+		if (session_id != INVALID_SESSION_ID) {
+			if (spdm_multi_peer_insert_session(multi_peer,
+							   session_id,
+							   connection_index)) {
+				connection->session_id[index] = session_id;
+			} else {
+				DEBUG((DEBUG_ERROR,
+				       "spdm_multi_peer_sync_sessions - session 0x%x is not recorded\n",
+				       session_id));
+				spdm_free_session_id(connection->spdm_context,
+						     session_id);
+				status = RETURN_OUT_OF_RESOURCES;
+			}
+		}
+	}
+	return status;
+}
+
+/**
+  This function allocates half of session ID for a responder.
+
+  If the SPDM context is a connection of a multi-peer responder, the half session ID is
+  unique across all connections, and none is allocated once the multi-peer session table is full.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return half of session ID for a responder.
+**/
+uint16 spdm_multi_peer_allocate_rsp_session_id(IN spdm_context_t *spdm_context)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	uint16 rsp_session_id;
+
+	rsp_session_id = spdm_allocate_rsp_session_id(spdm_context);
+	multi_peer = spdm_context->multi_peer_context;
+	if ((multi_peer == NULL) ||
+	    (rsp_session_id == (INVALID_SESSION_ID & 0xFFFF))) {
+		return rsp_session_id;
+	}
+
+	if (multi_peer->session_count >= multi_peer->max_session_count) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_multi_peer_allocate_rsp_session_id - MAX session_id\n"));
+		return (INVALID_SESSION_ID & 0xFFFF);
+	}
+
+	do {
+		rsp_session_id = multi_peer->next_rsp_session_id;
+		multi_peer->next_rsp_session_id++;
+		if (multi_peer->next_rsp_session_id ==
+		    (INVALID_SESSION_ID & 0xFFFF)) {
+			multi_peer->next_rsp_session_id++;
+		}
+	} while (spdm_multi_peer_find_session_slot(multi_peer,
+						   rsp_session_id) !=
+		 SPDM_MULTI_PEER_EMPTY_SLOT);
+
+	return rsp_session_id;
+}
+
+/**
+  Create the connection with a new peer, and initialize its SPDM context with
+  the local provisioning of the template SPDM context.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @return the index of the connection, or SPDM_MULTI_PEER_EMPTY_SLOT if the connection table is full.
+**/
+uintn spdm_multi_peer_add_connection(IN spdm_multi_peer_context_t *multi_peer,
+				     IN uint64 endpoint_id)
+{
+	spdm_multi_peer_connection_t *connection;
+	spdm_context_t *template_context;
+	spdm_context_t *spdm_context;
+	uintn connection_index;
+	uintn mask;
+	uintn slot;
+	uintn index;
+
+	connection_index = multi_peer->first_free_index;
+	if (connection_index == SPDM_MULTI_PEER_EMPTY_SLOT) {
+		DEBUG((DEBUG_ERROR,
+		       "spdm_multi_peer_add_connection - MAX connection\n"));
+		return SPDM_MULTI_PEER_EMPTY_SLOT;
+	}
+	connection = &multi_peer->connection[connection_index];
+	multi_peer->first_free_index = connection->next_free_index;
+
+	connection->in_use = TRUE;
+	connection->endpoint_id = endpoint_id;
+	connection->next_free_index = SPDM_MULTI_PEER_EMPTY_SLOT;
+	for (index = 0; index < multi_peer->max_connection_session_count;
+	     index++) {
+		connection->session_id[index] = INVALID_SESSION_ID;
+	}
+
+	template_context = multi_peer->template_context;
+	spdm_context = connection->spdm_context;
+	spdm_init_connection_context(spdm_context,
+				     multi_peer->max_connection_session_count,
+				     template_context);
+	spdm_context->send_message = template_context->send_message;
+	spdm_context->receive_message = template_context->receive_message;
+	spdm_context->transport_encode_message =
+		template_context->transport_encode_message;
+	spdm_context->transport_decode_message =
+		template_context->transport_decode_message;
+	spdm_context->transport_encode_message_in_place =
+		template_context->transport_encode_message_in_place;
+	spdm_context->transport_decode_message_in_place =
+		template_context->transport_decode_message_in_place;
+	spdm_context->transport_header_size =
+		template_context->transport_header_size;
+	spdm_context->transport_tail_size =
+		template_context->transport_tail_size;
+	spdm_context->get_response_func = template_context->get_response_func;
+	spdm_context->get_encap_response_func =
+		template_context->get_encap_response_func;
+	copy_mem(spdm_context->spdm_session_state_callback,
+		 template_context->spdm_session_state_callback,
+		 sizeof(spdm_context->spdm_session_state_callback));
+	copy_mem(spdm_context->spdm_connection_state_callback,
+		 template_context->spdm_connection_state_callback,
+		 sizeof(spdm_context->spdm_connection_state_callback));
+	spdm_context->opaque_context_data_ptr =
+		template_context->opaque_context_data_ptr;
+	spdm_context->multi_peer_context = multi_peer;
+
+	mask = multi_peer->connection_table_size - 1;
+	slot = spdm_multi_peer_hash(endpoint_id,
+				    multi_peer->connection_table_size);
+	while (multi_peer->connection_table[slot] !=
+	       SPDM_MULTI_PEER_EMPTY_SLOT) {
+		slot = (slot + 1) & mask;
+	}
+	multi_peer->connection_table[slot] = connection_index;
+	multi_peer->connection_count++;
+
+	return connection_index;
+}
+
+/**
+  Get the SPDM context of the connection with a peer.
+
+  The returned SPDM context can be used with spdm_get_data and spdm_set_data.
+  Setting local data on it changes the provisioning shared by all connections.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @return the SPDM context of the connection, or NULL if there is no connection with this peer.
+**/
+void *spdm_multi_peer_get_connection(IN void *multi_peer_context,
+				     IN uint64 endpoint_id)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	uintn slot;
+
+	multi_peer = multi_peer_context;
+	slot = spdm_multi_peer_find_connection_slot(multi_peer, endpoint_id);
+	if (slot == SPDM_MULTI_PEER_EMPTY_SLOT) {
+		return NULL;
+	}
+	return multi_peer->connection[multi_peer->connection_table[slot]]
+		.spdm_context;
+}
+
+/**
+  Get the SPDM context of the connection that owns a secured session.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  session_id                    The SPDM session ID.
+  @param  endpoint_id                   The transport endpoint of the peer that owns the session.
+
+  @return the SPDM context of the connection, or NULL if no connection owns this session.
+**/
+void *spdm_multi_peer_get_connection_via_session_id(
+	IN void *multi_peer_context, IN uint32 session_id,
+	OUT uint64 *endpoint_id OPTIONAL)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	spdm_multi_peer_connection_t *connection;
+	uintn slot;
+
+	multi_peer = multi_peer_context;
+	slot = spdm_multi_peer_find_session_slot(
+		multi_peer, (uint16)(session_id & 0xFFFF));
+	if ((slot == SPDM_MULTI_PEER_EMPTY_SLOT) ||
+	    (multi_peer->session_table[slot].session_id != session_id)) {
+		return NULL;
+	}
+	connection = &multi_peer->connection[multi_peer->session_table[slot]
+						      .connection_index];
+	if (endpoint_id != NULL) {
+		*endpoint_id = connection->endpoint_id;
+	}
+	return connection->spdm_context;
+}
+
+/**
+  Remove the connection with a peer, and release its sessions.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @retval RETURN_SUCCESS               The connection is removed.
+  @retval RETURN_NOT_FOUND             There is no connection with this peer.
+**/
+return_status spdm_multi_peer_remove_connection(IN void *multi_peer_context,
+						IN uint64 endpoint_id)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	spdm_multi_peer_connection_t *connection;
+	uintn connection_index;
+	uintn slot;
+	uintn index;
+
+	multi_peer = multi_peer_context;
+	slot = spdm_multi_peer_find_connection_slot(multi_peer, endpoint_id);
+	if (slot == SPDM_MULTI_PEER_EMPTY_SLOT) {
+		return RETURN_NOT_FOUND;
+	}
+	connection_index = multi_peer->connection_table[slot];
+	connection = &multi_peer->connection[connection_index];
+
+	for (index = 0; index < multi_peer->max_connection_session_count;
+	     index++) {
+		if (connection->session_id[index] != INVALID_SESSION_ID) {
+			spdm_multi_peer_remove_session(
+				multi_peer, connection->session_id[index]);
+			connection->session_id[index] = INVALID_SESSION_ID;
+		}
+	}
+	//
+	// Release the keys and contexts held by this connection and its sessions.
+	//
+	spdm_deinit_context(connection->spdm_context);
+
+	spdm_multi_peer_remove_connection_slot(multi_peer, slot);
+	connection->in_use = FALSE;
+	connection->next_free_index = multi_peer->first_free_index;
+	multi_peer->first_free_index = connection_index;
+	multi_peer->connection_count--;
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Release the resources held by the SPDM contexts of all connections of a multi-peer responder.
+
+  The multi-peer responder context buffer itself is owned by the caller.
+  spdm_multi_peer_init_context must be called before it is used again.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+**/
+void spdm_multi_peer_deinit_context(IN void *multi_peer_context)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	uintn index;
+
+	multi_peer = multi_peer_context;
+	for (index = 0; index < multi_peer->max_connection_count; index++) {
+		if (multi_peer->connection[index].in_use) {
+			spdm_deinit_context(
+				multi_peer->connection[index].spdm_context);
+		}
+	}
+}
+
+/**
+  Process a transport layer message from one peer of a multi-peer responder.
+
+  The message is routed to the connection of the peer. A new connection is created
+  from the template SPDM context for a peer that has no connection yet.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer that sent the request.
+  @param  request                      A pointer to the request data.
+  @param  request_size                  size in bytes of the request data.
+  @param  response                     A pointer to the response data.
+  @param  response_size                 size in bytes of the response data.
+                                       On input, it means the size in bytes of response data buffer.
+                                       On output, it means the size in bytes of copied response data buffer if RETURN_SUCCESS is returned,
+                                       and means the size in bytes of desired response data buffer if RETURN_BUFFER_TOO_SMALL is returned.
+
+  @retval RETURN_SUCCESS               The SPDM request is processed successfully.
+  @retval RETURN_OUT_OF_RESOURCES      The connection table is full, or the session table is full
+                                       and the session created by the request is freed.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the data.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status spdm_multi_peer_process_message(IN void *multi_peer_context,
+					      IN uint64 endpoint_id,
+					      IN void *request,
+					      IN uintn request_size,
+					      OUT void *response,
+					      IN OUT uintn *response_size)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	return_status status;
+	return_status sync_status;
+	uintn connection_index;
+	uintn slot;
+	uint32 *session_id;
+
+	multi_peer = multi_peer_context;
+	slot = spdm_multi_peer_find_connection_slot(multi_peer, endpoint_id);
+	if (slot != SPDM_MULTI_PEER_EMPTY_SLOT) {
+		connection_index = multi_peer->connection_table[slot];
+	} else {
+		connection_index =
+			spdm_multi_peer_add_connection(multi_peer, endpoint_id);
+		if (connection_index == SPDM_MULTI_PEER_EMPTY_SLOT) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+	}
+
+	status = spdm_process_message(
+		multi_peer->connection[connection_index].spdm_context,
+		&session_id, request, request_size, response, response_size);
+
+	//
+	// The response is not sent if a new session cannot be recorded.
+	//
+	sync_status = spdm_multi_peer_sync_sessions(multi_peer, connection_index);
+	if (RETURN_ERROR(sync_status)) {
+		return sync_status;
+	}
+
+	return status;
+}
+
+/**
+  This is the main dispatch function of a multi-peer responder.
+
+  It receives one request message from any peer, processes it in the connection of
+  that peer and sends the response message back to the same peer.
+
+  It should be called in a while loop or an timer/interrupt handler.
+
+  @param  multi_peer_context            A pointer to the multi-peer responder context.
+
+  @retval RETURN_SUCCESS               One SPDM request message is processed.
+  @retval RETURN_OUT_OF_RESOURCES      The connection table is full.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_UNSUPPORTED           One request message is not supported.
+**/
+return_status spdm_multi_peer_dispatch_message(IN void *multi_peer_context)
+{
+	spdm_multi_peer_context_t *multi_peer;
+	return_status status;
+	uint64 endpoint_id;
+	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn request_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+
+	multi_peer = multi_peer_context;
+
+	request_size = sizeof(request);
+	status = multi_peer->receive_message(multi_peer, &endpoint_id,
+					     &request_size, request, 0);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	response_size = sizeof(response);
+	status = spdm_multi_peer_process_message(multi_peer, endpoint_id,
+						 request, request_size,
+						 response, &response_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = multi_peer->send_message(multi_peer, endpoint_id,
+					  response_size, response, 0);
+
+	return status;
+}
@@ -147,7 +147,7 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 		return RETURN_SUCCESS;
 	}
 	slot_id = spdm_request->header.param2;
-	if (slot_id >= spdm_context->local_context.slot_count) {
+	if (slot_id >= spdm_context->local_context->slot_count) {
 		spdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_INVALID_REQUEST, 0,
 					     response_size, response);
@@ -213,7 +213,7 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 	spdm_response->header.param1 = 0;
 
 	req_session_id = spdm_request->req_session_id;
-	rsp_session_id = spdm_allocate_rsp_session_id(spdm_context);
+	rsp_session_id = spdm_multi_peer_allocate_rsp_session_id(spdm_context);
 	if (rsp_session_id == (INVALID_SESSION_ID & 0xFFFF)) {
 		spdm_generate_error_response(
 			spdm_context, SPDM_ERROR_CODE_SESSION_LIMIT_EXCEEDED, 0,
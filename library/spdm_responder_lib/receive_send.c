@@ -109,6 +109,7 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 	return_status status;
 	spdm_session_info_t *session_info;
 	uint32 *message_session_id;
+	uint64 stats_begin;
 
 	spdm_context = context;
 
@@ -121,14 +122,21 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 
 	DEBUG((DEBUG_INFO, "SpdmReceiveRequest[.] ...\n"));
 
+	spdm_responder_stats_begin_request(spdm_context);
 	message_session_id = NULL;
 	spdm_context->last_spdm_request_session_id_valid = FALSE;
 	spdm_context->last_spdm_request_size =
 		sizeof(spdm_context->last_spdm_request);
+	stats_begin = spdm_responder_stats_phase_begin(spdm_context);
 	status = spdm_context->transport_decode_message(
 		spdm_context, &message_session_id, is_app_message, TRUE,
 		request_size, request, &spdm_context->last_spdm_request_size,
 		spdm_context->last_spdm_request);
+	spdm_responder_stats_phase_end(
+		spdm_context,
+		(message_session_id != NULL) ? SPDM_RESPONDER_STATS_PHASE_AEAD :
+					       SPDM_RESPONDER_STATS_PHASE_DECODE,
+		stats_begin);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_decode_message : %p\n", status));
 		if (spdm_context->last_spdm_error.error_code != 0) {
@@ -140,10 +148,12 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 			*is_app_message = FALSE;
 			return RETURN_SUCCESS;
 		}
+		spdm_responder_stats_decode_failed(spdm_context);
 		return status;
 	}
 	if (spdm_context->last_spdm_request_size <
 	    sizeof(spdm_message_header_t)) {
+		spdm_responder_stats_decode_failed(spdm_context);
 		return RETURN_UNSUPPORTED;
 	}
 
@@ -153,6 +163,7 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 		session_info = spdm_get_session_info_via_session_id(
 			spdm_context, *message_session_id);
 		if (session_info == NULL) {
+			spdm_responder_stats_decode_failed(spdm_context);
 			return RETURN_UNSUPPORTED;
 		}
 		spdm_context->last_spdm_request_session_id =
@@ -163,8 +174,10 @@ return_status spdm_process_request(IN void *context, OUT uint32 **session_id,
 	DEBUG((DEBUG_INFO, "SpdmReceiveRequest[%x] (0x%x): \n",
 	       (message_session_id != NULL) ? *message_session_id : 0,
 	       spdm_context->last_spdm_request_size));
-	internal_dump_hex((uint8 *)spdm_context->last_spdm_request,
-			  spdm_context->last_spdm_request_size);
+	spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_RECEIVE,
+			   message_session_id, *is_app_message,
+			   spdm_context->last_spdm_request,
+			   spdm_context->last_spdm_request_size);
 
 	return RETURN_SUCCESS;
 }
@@ -262,6 +275,60 @@ void spdm_set_connection_state(IN spdm_context_t *spdm_context,
 	}
 }
 
+/**
+  Encode an SPDM or APP response to a transport layer message.
+
+  If an in-place transport layer function is registered, the response is encoded inside its
+  own buffer, and only the final transport message is copied to the destination buffer.
+  Otherwise the copy transport function is used.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message_size                  size in bytes of the response message.
+  @param  message                      A pointer to the response message, with spdm_context->transport_header_size
+                                       bytes of room in front of it and spdm_context->transport_tail_size bytes behind it.
+  @param  response_size                 size in bytes of the transport message data buffer.
+  @param  response                     A pointer to a destination buffer to store the transport message.
+
+  @retval RETURN_SUCCESS               The response is encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      The destination buffer is too small.
+**/
+return_status spdm_encode_response_message(IN spdm_context_t *spdm_context,
+					   IN uint32 *session_id,
+					   IN boolean is_app_message,
+					   IN uintn message_size,
+					   IN OUT void *message,
+					   IN OUT uintn *response_size,
+					   OUT void *response)
+{
+	return_status status;
+	void *transport_message;
+	uintn transport_message_size;
+
+	if (spdm_context->transport_encode_message_in_place == NULL) {
+		return spdm_context->transport_encode_message(
+			spdm_context, session_id, is_app_message, FALSE,
+			message_size, message, response_size, response);
+	}
+
+	status = spdm_context->transport_encode_message_in_place(
+		spdm_context, session_id, is_app_message, FALSE, message_size,
+		message, &transport_message_size, &transport_message);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	if (*response_size < transport_message_size) {
+		*response_size = transport_message_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	*response_size = transport_message_size;
+	copy_mem(response, transport_message, transport_message_size);
+	return RETURN_SUCCESS;
+}
+
 /**
   Build a SPDM response to a device.
 
@@ -284,23 +351,32 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 				  OUT void *response)
 {
 	spdm_context_t *spdm_context;
-	uint8 my_response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 my_response_buffer[MAX_SPDM_TRANSPORT_HEADER_SIZE +
+				 MAX_SPDM_MESSAGE_BUFFER_SIZE +
+				 MAX_SPDM_TRANSPORT_TAIL_SIZE];
+	uint8 *my_response;
 	uintn my_response_size;
 	return_status status;
 	spdm_get_spdm_response_func get_response_func;
 	spdm_session_info_t *session_info;
 	spdm_message_header_t *spdm_request;
 	spdm_message_header_t *spdm_response;
+	uint64 stats_begin;
 
 	spdm_context = context;
 	status = RETURN_UNSUPPORTED;
+	//
+	// Build the response behind the transport header room, so that the
+	// transport layer can encode it in place.
+	//
+	my_response = my_response_buffer + spdm_context->transport_header_size;
 
 	if (spdm_context->last_spdm_error.error_code != 0) {
 		//
 		// Error in spdm_process_request(), and we need send error message directly.
 		//
-		my_response_size = sizeof(my_response);
-		zero_mem(my_response, sizeof(my_response));
+		my_response_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+		zero_mem(my_response, MAX_SPDM_MESSAGE_BUFFER_SIZE);
 		switch (spdm_context->last_spdm_error.error_code) {
 		case SPDM_ERROR_CODE_DECRYPT_ERROR:
 			// session ID is valid. Use it to encrypt the error message.
@@ -324,16 +400,26 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 		DEBUG((DEBUG_INFO, "SpdmSendResponse[%x] (0x%x): \n",
 		       (session_id != NULL) ? *session_id : 0,
 		       my_response_size));
-		internal_dump_hex(my_response, my_response_size);
-
-		status = spdm_context->transport_encode_message(
-			spdm_context, session_id, FALSE, FALSE,
-			my_response_size, my_response, response_size, response);
+		spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_SEND,
+				   session_id, FALSE, my_response,
+				   my_response_size);
+
+		spdm_responder_stats_set_response(spdm_context, 0, my_response);
+		stats_begin = spdm_responder_stats_phase_begin(spdm_context);
+		status = spdm_encode_response_message(
+			spdm_context, session_id, FALSE, my_response_size,
+			my_response, response_size, response);
+		spdm_responder_stats_phase_end(
+			spdm_context,
+			(session_id != NULL) ? SPDM_RESPONDER_STATS_PHASE_AEAD :
+					       SPDM_RESPONDER_STATS_PHASE_ENCODE,
+			stats_begin);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_INFO, "transport_encode_message : %p\n",
 			       status));
 			return status;
 		}
+		spdm_responder_stats_end_request(spdm_context);
 
 		zero_mem(&spdm_context->last_spdm_error,
 			 sizeof(spdm_context->last_spdm_error));
@@ -367,9 +453,10 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 		return RETURN_NOT_READY;
 	}
 
-	my_response_size = sizeof(my_response);
-	zero_mem(my_response, sizeof(my_response));
+	my_response_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	zero_mem(my_response, MAX_SPDM_MESSAGE_BUFFER_SIZE);
 	get_response_func = NULL;
+	stats_begin = spdm_responder_stats_phase_begin(spdm_context);
 	if (!is_app_message) {
 		get_response_func =
 			spdm_get_response_func_via_last_request(spdm_context);
@@ -399,18 +486,37 @@ return_status spdm_build_response(IN void *context, IN uint32 *session_id,
 			spdm_request->request_response_code, &my_response_size,
 			my_response);
 	}
+	spdm_responder_stats_phase_end(spdm_context,
+				       SPDM_RESPONDER_STATS_PHASE_HANDLER,
+				       stats_begin);
 
 	DEBUG((DEBUG_INFO, "SpdmSendResponse[%x] (0x%x): \n",
 	       (session_id != NULL) ? *session_id : 0, my_response_size));
-	internal_dump_hex(my_response, my_response_size);
+	spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_SEND, session_id,
+			   is_app_message, my_response, my_response_size);
 
-	status = spdm_context->transport_encode_message(
-		spdm_context, session_id, is_app_message, FALSE,
-		my_response_size, my_response, response_size, response);
+	if (!is_app_message) {
+		spdm_responder_stats_set_response(
+			spdm_context, spdm_request->request_response_code,
+			my_response);
+	}
+	stats_begin = spdm_responder_stats_phase_begin(spdm_context);
+	status = spdm_encode_response_message(spdm_context, session_id,
+					      is_app_message, my_response_size,
+					      my_response, response_size,
+					      response);
+	spdm_responder_stats_phase_end(
+		spdm_context,
+		(session_id != NULL) ? SPDM_RESPONDER_STATS_PHASE_AEAD :
+				       SPDM_RESPONDER_STATS_PHASE_ENCODE,
+		stats_begin);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_encode_message : %p\n", status));
 		return status;
 	}
+	if (!is_app_message) {
+		spdm_responder_stats_end_request(spdm_context);
+	}
 
 	spdm_response = (void *)my_response;
 	if (session_id != NULL) {
@@ -655,4 +655,171 @@ void spdm_set_session_state(IN spdm_context_t *spdm_context,
 void spdm_set_connection_state(IN spdm_context_t *spdm_context,
 			       IN spdm_connection_state_t connection_state);
 
+/**
+  Encode an SPDM or APP response to a transport layer message.
+
+  If an in-place transport layer function is registered, the response is encoded inside its
+  own buffer, and only the final transport message is copied to the destination buffer.
+  Otherwise the copy transport function is used.
+
+  @param  spdm_context                  The SPDM context for the device.
+  @param  session_id                    Indicate if the response is a secured message.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  message_size                  size in bytes of the response message.
+  @param  message                      A pointer to the response message, with spdm_context->transport_header_size
+                                       bytes of room in front of it and spdm_context->transport_tail_size bytes behind it.
+  @param  response_size                 size in bytes of the transport message data buffer.
+  @param  response                     A pointer to a destination buffer to store the transport message.
+
+  @retval RETURN_SUCCESS               The response is encoded successfully.
+  @retval RETURN_BUFFER_TOO_SMALL      The destination buffer is too small.
+**/
+return_status spdm_encode_response_message(IN spdm_context_t *spdm_context,
+					   IN uint32 *session_id,
+					   IN boolean is_app_message,
+					   IN uintn message_size,
+					   IN OUT void *message,
+					   IN OUT uintn *response_size,
+					   OUT void *response);
+
+//
+// An empty slot in the multi-peer connection hash table.
+//
+#define SPDM_MULTI_PEER_EMPTY_SLOT ((uintn)-1)
+
+typedef struct {
+	boolean in_use;
+	uint64 endpoint_id;
+	//
+	// Next free connection, only valid if in_use is FALSE.
+	//
+	uintn next_free_index;
+	//
+	// Session IDs of this connection recorded in the session table,
+	// one per session_info entry of the SPDM context.
+	//
+	uint32 *session_id;
+	spdm_context_t *spdm_context;
+} spdm_multi_peer_connection_t;
+
+typedef struct {
+	uint32 session_id;
+	uintn connection_index;
+} spdm_multi_peer_session_t;
+
+typedef struct {
+	spdm_context_t *template_context;
+	spdm_multi_peer_send_message_func send_message;
+	spdm_multi_peer_receive_message_func receive_message;
+	//
+	// Connection records, and an open-addressed hash table of connection
+	// indexes keyed by endpoint ID. The table size is a power of two.
+	//
+	uintn max_connection_count;
+	uintn connection_count;
+	uintn first_free_index;
+	spdm_multi_peer_connection_t *connection;
+	uintn connection_table_size;
+	uintn *connection_table;
+	//
+	// Open-addressed hash table of secured sessions keyed by the responder
+	// half of the session ID, which is unique across all connections.
+	// The table size is a power of two.
+	//
+	uintn max_session_count;
+	uintn max_connection_session_count;
+	uintn session_count;
+	uint16 next_rsp_session_id;
+	uintn session_table_size;
+	spdm_multi_peer_session_t *session_table;
+	//
+	// SPDM contexts of all connections, spdm_context_size bytes each. They use the
+	// local provisioning and the measurement cache of the template SPDM context.
+	//
+	uintn spdm_context_size;
+	uint8 *spdm_context_buffer;
+} spdm_multi_peer_context_t;
+
+/**
+  Find the slot of a peer in the connection hash table.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  endpoint_id                   The transport endpoint of the peer.
+
+  @return the slot holding the connection of the peer, or SPDM_MULTI_PEER_EMPTY_SLOT if there is none.
+**/
+uintn spdm_multi_peer_find_connection_slot(
+	IN spdm_multi_peer_context_t *multi_peer, IN uint64 endpoint_id);
+
+/**
+  This function allocates half of session ID for a responder.
+
+  If the SPDM context is a connection of a multi-peer responder, the half session ID is
+  unique across all connections, and none is allocated once the multi-peer session table is full.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return half of session ID for a responder.
+**/
+uint16 spdm_multi_peer_allocate_rsp_session_id(IN spdm_context_t *spdm_context);
+
+/**
+  Bring the session table in line with the sessions of one connection,
+  after the connection processed a message.
+
+  A new session of the connection that cannot be recorded is freed.
+
+  @param  multi_peer                    A pointer to the multi-peer responder context.
+  @param  connection_index              The index of the connection.
+
+  @retval RETURN_SUCCESS               All sessions of the connection are recorded.
+  @retval RETURN_OUT_OF_RESOURCES      A new session cannot be recorded and is freed.
+**/
+return_status
+spdm_multi_peer_sync_sessions(IN spdm_multi_peer_context_t *multi_peer,
+			      IN uintn connection_index);
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+/**
+  Clear the timing of the request about to be processed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_begin_request(IN spdm_context_t *spdm_context);
+
+/**
+  Set the request code and the error code of the request being processed.
+
+  It should be called with the response before it is encoded, because the encoding may encrypt it in place.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The request code, 0 if the request could not be decoded.
+  @param  response                      A pointer to the SPDM response message.
+**/
+void spdm_responder_stats_set_response(IN spdm_context_t *spdm_context,
+				       IN uint8 request_code,
+				       IN void *response);
+
+/**
+  Add the request being processed to the statistics, and report it to the sampling function.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_end_request(IN spdm_context_t *spdm_context);
+
+/**
+  Add a request that cannot be decoded and gets no response to the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_decode_failed(IN spdm_context_t *spdm_context);
+#else
+#define spdm_responder_stats_begin_request(spdm_context)
+#define spdm_responder_stats_set_response(spdm_context, request_code, response)
+#define spdm_responder_stats_end_request(spdm_context)
+#define spdm_responder_stats_decode_failed(spdm_context)
+#endif
+
 #endif
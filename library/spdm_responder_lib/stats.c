@@ -0,0 +1,231 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_responder_lib_internal.h"
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+
+/**
+  Return the histogram bucket of a latency.
+
+  @param  latency_us                    The latency in microseconds.
+
+  @return The index of the bucket.
+**/
+static uintn spdm_responder_stats_get_bucket(IN uint64 latency_us)
+{
+	uintn bucket;
+
+	bucket = 0;
+	while ((latency_us != 0) &&
+	       (bucket < SPDM_RESPONDER_STATS_HISTOGRAM_BUCKETS - 1)) {
+		latency_us >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/**
+  Clear the timing of the request about to be processed.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_begin_request(IN spdm_context_t *spdm_context)
+{
+	zero_mem(&spdm_context->responder_stats_sample,
+		 sizeof(spdm_context->responder_stats_sample));
+}
+
+/**
+  Set the request code and the error code of the request being processed.
+
+  It should be called with the response before it is encoded, because the encoding may encrypt it in place.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The request code, 0 if the request could not be decoded.
+  @param  response                      A pointer to the SPDM response message.
+**/
+void spdm_responder_stats_set_response(IN spdm_context_t *spdm_context,
+				       IN uint8 request_code,
+				       IN void *response)
+{
+	spdm_message_header_t *spdm_response;
+
+	spdm_response = response;
+	spdm_context->responder_stats_sample.request_code = request_code;
+	if (spdm_response->request_response_code == SPDM_ERROR) {
+		spdm_context->responder_stats_sample.error_code =
+			spdm_response->param1;
+	}
+}
+
+/**
+  Add the request being processed to the statistics, and report it to the sampling function.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_end_request(IN spdm_context_t *spdm_context)
+{
+	spdm_responder_stats_sample_t *sample;
+	spdm_responder_request_stats_t *request_stats;
+	uintn phase;
+
+	sample = &spdm_context->responder_stats_sample;
+
+	if (sample->request_code >= 0x80) {
+		request_stats =
+			&spdm_context->responder_stats
+				 .request[sample->request_code - 0x80];
+		request_stats->received++;
+		if (sample->error_code != 0) {
+			request_stats->errored++;
+		}
+		for (phase = 0; phase < SPDM_RESPONDER_STATS_PHASE_MAX;
+		     phase++) {
+			if ((sample->phase_mask & (1 << phase)) != 0) {
+				request_stats->latency_histogram
+					[phase][spdm_responder_stats_get_bucket(
+						sample->phase_us[phase])]++;
+			}
+		}
+	}
+	if (sample->error_code != 0) {
+		spdm_context->responder_stats.error_code[sample->error_code]++;
+	}
+
+	if (spdm_context->responder_stats_sample_func == NULL) {
+		return;
+	}
+	spdm_context->responder_stats_sample_count++;
+	if (spdm_context->responder_stats_sample_count <
+	    spdm_context->responder_stats_sample_interval) {
+		return;
+	}
+	spdm_context->responder_stats_sample_count = 0;
+	spdm_context->responder_stats_sample_func(spdm_context, sample);
+}
+
+/**
+  Add a request that cannot be decoded and gets no response to the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_decode_failed(IN spdm_context_t *spdm_context)
+{
+	spdm_context->responder_stats.decode_failed++;
+	spdm_context->responder_stats_sample.request_code = 0;
+	spdm_responder_stats_end_request(spdm_context);
+}
+
+/**
+  Copy the request statistics of an SPDM responder.
+
+  The copy is not synchronized with a request being processed in the same SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  stats                         A pointer to a destination buffer to store the statistics.
+**/
+void spdm_responder_stats_snapshot(IN void *context,
+				   OUT spdm_responder_stats_t *stats)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	copy_mem(stats, &spdm_context->responder_stats,
+		 sizeof(spdm_responder_stats_t));
+}
+
+/**
+  Clear the request statistics of an SPDM responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_responder_stats_reset(IN void *context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	zero_mem(&spdm_context->responder_stats,
+		 sizeof(spdm_context->responder_stats));
+	spdm_context->responder_stats_sample_count = 0;
+}
+
+/**
+  Register a function to receive the timing of the requests processed by an SPDM responder.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sample_func                   The function to receive the timing, or NULL to stop sampling.
+  @param  sample_interval               The function is called once every sample_interval requests.
+                                       0 and 1 mean every request.
+**/
+void spdm_register_responder_stats_sample_func(
+	IN void *context,
+	IN spdm_responder_stats_sample_func sample_func OPTIONAL,
+	IN uint32 sample_interval)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->responder_stats_sample_func = sample_func;
+	spdm_context->responder_stats_sample_interval = sample_interval;
+	spdm_context->responder_stats_sample_count = 0;
+}
+
+/**
+  Return a latency percentile of one phase of one request code.
+
+  The latency is only known to the precision of the histogram, so the upper
+  bound of the histogram bucket that holds the percentile is returned.
+
+  @param  stats                         A pointer to the statistics.
+  @param  request_code                  The request code, 0x80 to 0xFF.
+  @param  phase                         The phase of the request.
+  @param  percent                       The percentile, 1 to 100.
+
+  @return The latency in microseconds, 0 if the phase was never timed for the request code.
+**/
+uint64 spdm_responder_stats_get_percentile(IN spdm_responder_stats_t *stats,
+					   IN uint8 request_code,
+					   IN spdm_responder_stats_phase_t phase,
+					   IN uint8 percent)
+{
+	uint32 *histogram;
+	uint64 total;
+	uint64 rank;
+	uint64 count;
+	uintn bucket;
+
+	if ((request_code < 0x80) || (phase >= SPDM_RESPONDER_STATS_PHASE_MAX) ||
+	    (percent == 0) || (percent > 100)) {
+		return 0;
+	}
+	histogram = stats->request[request_code - 0x80].latency_histogram[phase];
+
+	total = 0;
+	for (bucket = 0; bucket < SPDM_RESPONDER_STATS_HISTOGRAM_BUCKETS;
+	     bucket++) {
+		total += histogram[bucket];
+	}
+	if (total == 0) {
+		return 0;
+	}
+
+	//
+	// The rank of the percentile, rounded up, among all the timed phases.
+	//
+	rank = (total * percent + 99) / 100;
+	count = 0;
+	for (bucket = 0; bucket < SPDM_RESPONDER_STATS_HISTOGRAM_BUCKETS - 1;
+	     bucket++) {
+		count += histogram[bucket];
+		if (count >= rank) {
+			break;
+		}
+	}
+	return (uint64)1 << bucket;
+}
+
+#endif
@@ -98,7 +98,7 @@ return_status spdm_get_response_version(IN void *context, IN uintn request_size,
 	ASSERT(*response_size >= sizeof(spdm_version_response_mine_t));
 	*response_size =
 		sizeof(spdm_version_response) +
-		spdm_context->local_context.version.spdm_version_count *
+		spdm_context->local_context->version.spdm_version_count *
 			sizeof(spdm_version_number_t);
 	zero_mem(response, *response_size);
 	spdm_response = response;
@@ -108,12 +108,12 @@ return_status spdm_get_response_version(IN void *context, IN uintn request_size,
 	spdm_response->header.param1 = 0;
 	spdm_response->header.param2 = 0;
 	spdm_response->version_number_entry_count =
-		spdm_context->local_context.version.spdm_version_count;
+		spdm_context->local_context->version.spdm_version_count;
 	copy_mem(
 		spdm_response->version_number_entry,
-		spdm_context->local_context.version.spdm_version,
+		spdm_context->local_context->version.spdm_version,
 		sizeof(spdm_version_number_t) *
-			spdm_context->local_context.version.spdm_version_count);
+			spdm_context->local_context->version.spdm_version_count);
 
 	//
 	// Cache
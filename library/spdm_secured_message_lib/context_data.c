@@ -20,6 +20,7 @@ uintn spdm_secured_message_get_context_size(void)
   Initialize an SPDM secured message context.
 
   The size in bytes of the spdm_secured_message_context can be returned by spdm_secured_message_get_context_size.
+  The keyed AEAD contexts held by a previously initialized context are released.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
 */
@@ -28,6 +29,7 @@ void spdm_secured_message_init_context(IN void *spdm_secured_message_context)
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
+	spdm_secured_message_free_aead_context(secured_message_context);
 	zero_mem(secured_message_context,
 		 sizeof(spdm_secured_message_context_t));
 
@@ -84,6 +86,11 @@ void spdm_secured_message_set_session_state(
 	if (session_state == SPDM_SESSION_STATE_ESTABLISHED) {
 		/* session handshake key should be zeroized after handshake phase. */
 		spdm_clear_handshake_secret(secured_message_context);
+		/* switch the AEAD contexts from handshake key to data key. */
+		spdm_secured_message_reset_aead_context(secured_message_context,
+							TRUE);
+		spdm_secured_message_reset_aead_context(secured_message_context,
+							FALSE);
 	}
 }
 
@@ -138,6 +145,7 @@ void spdm_secured_message_set_algorithms(IN void *spdm_secured_message_context,
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
+	spdm_secured_message_free_aead_context(secured_message_context);
 	secured_message_context->version = version;
 	secured_message_context->secured_message_version = secured_message_version;
 	secured_message_context->base_hash_algo = base_hash_algo;
@@ -155,6 +163,7 @@ void spdm_secured_message_set_algorithms(IN void *spdm_secured_message_context,
 		secured_message_context->aead_cipher_suite);
 	secured_message_context->aead_tag_size = spdm_get_aead_tag_size(
 		secured_message_context->aead_cipher_suite);
+	spdm_secured_message_init_bin_str(secured_message_context);
 }
 
 /**
@@ -359,9 +368,109 @@ spdm_secured_message_import_session_keys(IN void *spdm_secured_message_context,
 			  .response_data_sequence_number,
 		 ptr, sizeof(uint64));
 	ptr += sizeof(uint64);
+
+	//
+	// The next keys derived ahead of time follow the replaced data secrets.
+	//
+	secure_zero_mem(&secured_message_context->application_secret_update,
+			sizeof(secured_message_context->application_secret_update));
+	secured_message_context->request_data_update_ready = FALSE;
+	secured_message_context->response_data_update_ready = FALSE;
+
+	spdm_secured_message_reset_aead_context(secured_message_context, TRUE);
+	spdm_secured_message_reset_aead_context(secured_message_context, FALSE);
 	return RETURN_SUCCESS;
 }
 
+/**
+  Set the data key update policy of an SPDM secured message context.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  policy                        The data key update policy.
+**/
+void spdm_secured_message_set_key_update_policy(
+	IN void *spdm_secured_message_context,
+	IN spdm_key_update_policy_t *policy)
+{
+	spdm_secured_message_context_t *secured_message_context;
+
+	secured_message_context = spdm_secured_message_context;
+	copy_mem(&secured_message_context->key_update_policy, policy,
+		 sizeof(spdm_key_update_policy_t));
+}
+
+/**
+  Return if the data key of one direction crossed a limit of the key update policy.
+**/
+static boolean spdm_secured_message_is_data_key_expired(
+	IN spdm_key_update_policy_t *policy, IN uint64 sequence_number,
+	IN uint64 byte_count, IN OUT uint64 *key_time_us, IN uint64 now_us)
+{
+	if ((policy->max_records != 0) &&
+	    (sequence_number >= policy->max_records)) {
+		return TRUE;
+	}
+	if ((policy->max_bytes != 0) && (byte_count >= policy->max_bytes)) {
+		return TRUE;
+	}
+	if ((policy->max_age_us != 0) && (now_us != 0)) {
+		if (*key_time_us == 0) {
+			*key_time_us = now_us;
+		} else if (now_us - *key_time_us >= policy->max_age_us) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+  Return if the data keys of a session crossed a limit of the key update policy.
+
+  The age of a data key counts from the first call after the key is activated.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  now_us                        The current time in microseconds, 0 to skip the age check.
+  @param  action                       The directions whose data key crossed a limit.
+
+  @retval TRUE  A data key crossed a limit of the key update policy.
+  @retval FALSE No data key crossed a limit of the key update policy.
+**/
+boolean spdm_secured_message_is_key_update_due(
+	IN void *spdm_secured_message_context, IN uint64 now_us,
+	OUT spdm_key_update_action_t *action)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	spdm_session_info_struct_application_secret_t *application_secret;
+	uint32 due_action;
+
+	secured_message_context = spdm_secured_message_context;
+	application_secret = &secured_message_context->application_secret;
+
+	due_action = 0;
+	if (secured_message_context->session_state ==
+	    SPDM_SESSION_STATE_ESTABLISHED) {
+		if (spdm_secured_message_is_data_key_expired(
+			    &secured_message_context->key_update_policy,
+			    application_secret->request_data_sequence_number,
+			    application_secret->request_data_byte_count,
+			    &application_secret->request_data_key_time_us,
+			    now_us)) {
+			due_action |= SPDM_KEY_UPDATE_ACTION_REQUESTER;
+		}
+		if (spdm_secured_message_is_data_key_expired(
+			    &secured_message_context->key_update_policy,
+			    application_secret->response_data_sequence_number,
+			    application_secret->response_data_byte_count,
+			    &application_secret->response_data_key_time_us,
+			    now_us)) {
+			due_action |= SPDM_KEY_UPDATE_ACTION_RESPONDER;
+		}
+	}
+
+	*action = due_action;
+	return (boolean)(due_action != 0);
+}
+
 /**
   Get the last SPDM error struct of an SPDM context.
 
@@ -395,3 +504,91 @@ void spdm_secured_message_set_last_spdm_error_struct(
 	copy_mem(&secured_message_context->last_spdm_error, last_spdm_error,
 		 sizeof(spdm_error_struct_t));
 }
+
+/**
+  Mark the keyed AEAD context of one direction as stale, because the
+  encryption key of that direction has changed.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  is_requester                  Indicates if it is the request direction.
+**/
+void spdm_secured_message_reset_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN boolean is_requester)
+{
+	if (is_requester) {
+		secured_message_context->request_aead_context_keyed = FALSE;
+	} else {
+		secured_message_context->response_aead_context_keyed = FALSE;
+	}
+}
+
+/**
+  Return the keyed AEAD context of one direction. The context is allocated on
+  first use, and rekeyed with the given key if it is stale.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  is_requester                  Indicates if it is the request direction.
+  @param  key                          The current encryption key of the direction.
+
+  @return the keyed AEAD context, or NULL if keyed AEAD is unavailable.
+**/
+void *spdm_secured_message_get_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN boolean is_requester, IN const uint8 *key)
+{
+	void **aead_context;
+	boolean *aead_context_keyed;
+
+	if (is_requester) {
+		aead_context = &secured_message_context->request_aead_context;
+		aead_context_keyed =
+			&secured_message_context->request_aead_context_keyed;
+	} else {
+		aead_context = &secured_message_context->response_aead_context;
+		aead_context_keyed =
+			&secured_message_context->response_aead_context_keyed;
+	}
+
+	if (*aead_context_keyed) {
+		return *aead_context;
+	}
+
+	if (*aead_context == NULL) {
+		*aead_context = spdm_aead_new(
+			secured_message_context->aead_cipher_suite);
+		if (*aead_context == NULL) {
+			return NULL;
+		}
+	}
+	if (!spdm_aead_set_key(secured_message_context->aead_cipher_suite,
+			       *aead_context, key,
+			       secured_message_context->aead_key_size)) {
+		return NULL;
+	}
+	*aead_context_keyed = TRUE;
+
+	return *aead_context;
+}
+
+/**
+  Release the keyed AEAD contexts of both directions.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+**/
+void spdm_secured_message_free_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context)
+{
+	if (secured_message_context->request_aead_context != NULL) {
+		spdm_aead_free(secured_message_context->aead_cipher_suite,
+			       secured_message_context->request_aead_context);
+		secured_message_context->request_aead_context = NULL;
+	}
+	if (secured_message_context->response_aead_context != NULL) {
+		spdm_aead_free(secured_message_context->aead_cipher_suite,
+			       secured_message_context->response_aead_context);
+		secured_message_context->response_aead_context = NULL;
+	}
+	secured_message_context->request_aead_context_keyed = FALSE;
+	secured_message_context->response_aead_context_keyed = FALSE;
+}
@@ -0,0 +1,478 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_secured_message_lib_internal.h"
+
+typedef enum {
+	SPDM_DHE_KEY_POOL_SLOT_EMPTY,
+	SPDM_DHE_KEY_POOL_SLOT_GENERATING,
+	SPDM_DHE_KEY_POOL_SLOT_READY,
+} spdm_dhe_key_pool_slot_state_t;
+
+typedef struct {
+	uint16 dhe_named_group;
+	spdm_dhe_key_pool_slot_state_t state;
+	void *dhe_context;
+	uintn public_key_size;
+	uint8 public_key[MAX_DHE_KEY_SIZE];
+} spdm_dhe_key_pool_slot_t;
+
+typedef struct {
+	uintn slot_count;
+	uint64 hit_count;
+	uint64 miss_count;
+	// Set by spdm_dhe_key_pool_stop, accessed under the lock
+	boolean stop;
+	spdm_dhe_key_pool_lock_func acquire_lock;
+	spdm_dhe_key_pool_lock_func release_lock;
+	void *lock_context;
+	spdm_dhe_key_pool_event_func wait_event;
+	spdm_dhe_key_pool_event_func signal_event;
+	void *event_context;
+	//spdm_dhe_key_pool_slot_t slot[slot_count];
+} spdm_dhe_key_pool_t;
+
+/**
+  Return the number of supported DHE groups in a dhe_named_group mask.
+
+  @param  dhe_named_group_mask            The SPDM dhe_named_group of each group.
+
+  @return the number of supported groups.
+**/
+static uintn spdm_dhe_key_pool_get_group_count(IN uint16 dhe_named_group_mask)
+{
+	uintn group_count;
+	uintn index;
+
+	group_count = 0;
+	for (index = 0; index < 16; index++) {
+		if ((dhe_named_group_mask & (1 << index)) != 0 &&
+		    spdm_get_dhe_pub_key_size((uint16)(1 << index)) != 0) {
+			group_count++;
+		}
+	}
+	return group_count;
+}
+
+/**
+  Return the size in bytes of a DHE key pool.
+
+  @param  dhe_named_group_mask            The SPDM dhe_named_group of each group to pre-generate key pairs for.
+  @param  key_count                     The number of key pairs kept ready per group.
+
+  @return the size in bytes of the pool.
+**/
+uintn spdm_dhe_key_pool_get_size(IN uint16 dhe_named_group_mask,
+				 IN uintn key_count)
+{
+	return sizeof(spdm_dhe_key_pool_t) +
+	       spdm_dhe_key_pool_get_group_count(dhe_named_group_mask) *
+		       key_count * sizeof(spdm_dhe_key_pool_slot_t);
+}
+
+/**
+  Initialize a DHE key pool. The pool is empty until it is refilled.
+
+  @param  dhe_key_pool                   The buffer of spdm_dhe_key_pool_get_size(dhe_named_group_mask, key_count) bytes.
+  @param  dhe_named_group_mask            The SPDM dhe_named_group of each group to pre-generate key pairs for.
+  @param  key_count                     The number of key pairs kept ready per group.
+
+  @retval RETURN_SUCCESS               The pool is initialized.
+  @retval RETURN_INVALID_PARAMETER     The key_count is 0 or no supported group is in dhe_named_group_mask.
+**/
+return_status spdm_dhe_key_pool_init(OUT void *dhe_key_pool,
+				     IN uint16 dhe_named_group_mask,
+				     IN uintn key_count)
+{
+	spdm_dhe_key_pool_t *pool;
+	spdm_dhe_key_pool_slot_t *slot;
+	uint16 dhe_named_group;
+	uintn index;
+	uintn key_index;
+
+	if (key_count == 0 ||
+	    spdm_dhe_key_pool_get_group_count(dhe_named_group_mask) == 0) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	pool = dhe_key_pool;
+	zero_mem(pool,
+		 spdm_dhe_key_pool_get_size(dhe_named_group_mask, key_count));
+
+	slot = (void *)(pool + 1);
+	for (index = 0; index < 16; index++) {
+		dhe_named_group = (uint16)(1 << index);
+		if ((dhe_named_group_mask & dhe_named_group) == 0 ||
+		    spdm_get_dhe_pub_key_size(dhe_named_group) == 0) {
+			continue;
+		}
+		for (key_index = 0; key_index < key_count; key_index++) {
+			slot[pool->slot_count].dhe_named_group = dhe_named_group;
+			slot[pool->slot_count].state =
+				SPDM_DHE_KEY_POOL_SLOT_EMPTY;
+			pool->slot_count++;
+		}
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Register the lock serializing the access to a DHE key pool.
+
+  @param  dhe_key_pool                   The DHE key pool.
+  @param  acquire_lock                  The function to acquire the lock, or NULL for a single thread.
+  @param  release_lock                  The function to release the lock, or NULL for a single thread.
+  @param  lock_context                  The lock context passed to the functions.
+**/
+void spdm_dhe_key_pool_register_lock_func(
+	IN void *dhe_key_pool,
+	IN spdm_dhe_key_pool_lock_func acquire_lock OPTIONAL,
+	IN spdm_dhe_key_pool_lock_func release_lock OPTIONAL,
+	IN void *lock_context OPTIONAL)
+{
+	spdm_dhe_key_pool_t *pool;
+
+	pool = dhe_key_pool;
+	pool->acquire_lock = acquire_lock;
+	pool->release_lock = release_lock;
+	pool->lock_context = lock_context;
+}
+
+/**
+  Register the event waking up the worker of a DHE key pool.
+
+  @param  dhe_key_pool                   The DHE key pool.
+  @param  wait_event                    The function to wait for the event.
+  @param  signal_event                  The function to signal the event.
+  @param  event_context                 The event context passed to the functions.
+**/
+void spdm_dhe_key_pool_register_event_func(
+	IN void *dhe_key_pool, IN spdm_dhe_key_pool_event_func wait_event,
+	IN spdm_dhe_key_pool_event_func signal_event,
+	IN void *event_context OPTIONAL)
+{
+	spdm_dhe_key_pool_t *pool;
+
+	pool = dhe_key_pool;
+	pool->wait_event = wait_event;
+	pool->signal_event = signal_event;
+	pool->event_context = event_context;
+}
+
+/**
+  Acquire the lock of a DHE key pool, if any.
+
+  @param  pool                          The DHE key pool.
+**/
+static void spdm_dhe_key_pool_lock(IN spdm_dhe_key_pool_t *pool)
+{
+	if (pool->acquire_lock != NULL) {
+		pool->acquire_lock(pool->lock_context);
+	}
+}
+
+/**
+  Release the lock of a DHE key pool, if any.
+
+  @param  pool                          The DHE key pool.
+**/
+static void spdm_dhe_key_pool_unlock(IN spdm_dhe_key_pool_t *pool)
+{
+	if (pool->release_lock != NULL) {
+		pool->release_lock(pool->lock_context);
+	}
+}
+
+/**
+  Signal the event of a DHE key pool, if any.
+
+  @param  pool                          The DHE key pool.
+**/
+static void spdm_dhe_key_pool_signal(IN spdm_dhe_key_pool_t *pool)
+{
+	if (pool->signal_event != NULL) {
+		pool->signal_event(pool->event_context);
+	}
+}
+
+/**
+  Allocate a DHE context and generate its key pair.
+
+  @param  dhe_named_group                SPDM dhe_named_group
+  @param  public_key                    Pointer to the buffer to receive the public key.
+  @param  public_key_size                On input, the size of public_key buffer in bytes.
+                                       On output, the size of data returned in public_key buffer in bytes.
+
+  @return Pointer to the DHE context, or NULL if the key pair cannot be generated.
+**/
+static void *spdm_dhe_key_pool_generate(IN uint16 dhe_named_group,
+					OUT uint8 *public_key,
+					IN OUT uintn *public_key_size)
+{
+	void *dhe_context;
+
+	dhe_context = spdm_secured_message_dhe_new(dhe_named_group);
+	if (dhe_context == NULL) {
+		return NULL;
+	}
+	if (!spdm_secured_message_dhe_generate_key(dhe_named_group,
+						   dhe_context, public_key,
+						   public_key_size)) {
+		spdm_secured_message_dhe_free(dhe_named_group, dhe_context);
+		return NULL;
+	}
+	return dhe_context;
+}
+
+/**
+  Generate a key pair for each empty slot of a DHE key pool.
+
+  The key pairs are generated without holding the lock, so the handshake can take
+  key pairs from the pool meanwhile.
+
+  @param  dhe_key_pool                   The DHE key pool.
+
+  @return the number of key pairs generated.
+**/
+uintn spdm_dhe_key_pool_refill(IN void *dhe_key_pool)
+{
+	spdm_dhe_key_pool_t *pool;
+	spdm_dhe_key_pool_slot_t *slot;
+	void *dhe_context;
+	uintn index;
+	uintn generated_count;
+
+	pool = dhe_key_pool;
+	slot = (void *)(pool + 1);
+	generated_count = 0;
+
+	for (index = 0; index < pool->slot_count; index++) {
+		spdm_dhe_key_pool_lock(pool);
+		if (pool->stop) {
+			spdm_dhe_key_pool_unlock(pool);
+			break;
+		}
+		if (slot[index].state != SPDM_DHE_KEY_POOL_SLOT_EMPTY) {
+			spdm_dhe_key_pool_unlock(pool);
+			continue;
+		}
+		slot[index].state = SPDM_DHE_KEY_POOL_SLOT_GENERATING;
+		spdm_dhe_key_pool_unlock(pool);
+
+		//
+		// Only this thread owns a slot in the generating state.
+		//
+		slot[index].public_key_size = sizeof(slot[index].public_key);
+		dhe_context = spdm_dhe_key_pool_generate(
+			slot[index].dhe_named_group, slot[index].public_key,
+			&slot[index].public_key_size);
+
+		spdm_dhe_key_pool_lock(pool);
+		if (dhe_context == NULL) {
+			slot[index].state = SPDM_DHE_KEY_POOL_SLOT_EMPTY;
+		} else {
+			slot[index].dhe_context = dhe_context;
+			slot[index].state = SPDM_DHE_KEY_POOL_SLOT_READY;
+			generated_count++;
+		}
+		spdm_dhe_key_pool_unlock(pool);
+	}
+	return generated_count;
+}
+
+/**
+  Return if spdm_dhe_key_pool_stop was called on a DHE key pool.
+
+  @param  pool                          The DHE key pool.
+
+  @retval TRUE                          The worker must return.
+  @retval FALSE                         The worker must keep the pool filled.
+**/
+static boolean spdm_dhe_key_pool_is_stopped(IN spdm_dhe_key_pool_t *pool)
+{
+	boolean stop;
+
+	spdm_dhe_key_pool_lock(pool);
+	stop = pool->stop;
+	spdm_dhe_key_pool_unlock(pool);
+	return stop;
+}
+
+/**
+  Run the worker of a DHE key pool until spdm_dhe_key_pool_stop is called.
+
+  The worker refills the pool, then waits for the event until a key pair is taken.
+  It is intended to be the entry point of an idle thread, and requires the lock and
+  the event to be registered.
+
+  @param  dhe_key_pool                   The DHE key pool.
+**/
+void spdm_dhe_key_pool_worker(IN void *dhe_key_pool)
+{
+	spdm_dhe_key_pool_t *pool;
+
+	pool = dhe_key_pool;
+	ASSERT(pool->wait_event != NULL);
+	ASSERT(pool->acquire_lock != NULL);
+
+	while (!spdm_dhe_key_pool_is_stopped(pool)) {
+		spdm_dhe_key_pool_refill(pool);
+		if (spdm_dhe_key_pool_is_stopped(pool)) {
+			break;
+		}
+		pool->wait_event(pool->event_context);
+	}
+}
+
+/**
+  Stop the worker of a DHE key pool. The worker returns once its current refill is done.
+
+  @param  dhe_key_pool                   The DHE key pool.
+**/
+void spdm_dhe_key_pool_stop(IN void *dhe_key_pool)
+{
+	spdm_dhe_key_pool_t *pool;
+
+	pool = dhe_key_pool;
+	spdm_dhe_key_pool_lock(pool);
+	pool->stop = TRUE;
+	spdm_dhe_key_pool_unlock(pool);
+	spdm_dhe_key_pool_signal(pool);
+}
+
+/**
+  Free the key pairs left in a DHE key pool. The worker must be stopped first.
+
+  @param  dhe_key_pool                   The DHE key pool.
+**/
+void spdm_dhe_key_pool_free(IN void *dhe_key_pool)
+{
+	spdm_dhe_key_pool_t *pool;
+	spdm_dhe_key_pool_slot_t *slot;
+	uintn index;
+
+	pool = dhe_key_pool;
+	slot = (void *)(pool + 1);
+	spdm_dhe_key_pool_lock(pool);
+	for (index = 0; index < pool->slot_count; index++) {
+		if (slot[index].state == SPDM_DHE_KEY_POOL_SLOT_READY) {
+			spdm_secured_message_dhe_free(slot[index].dhe_named_group,
+						      slot[index].dhe_context);
+			slot[index].dhe_context = NULL;
+			zero_mem(slot[index].public_key,
+				 slot[index].public_key_size);
+			slot[index].state = SPDM_DHE_KEY_POOL_SLOT_EMPTY;
+		}
+	}
+	spdm_dhe_key_pool_unlock(pool);
+}
+
+/**
+  Return the number of key pairs taken from and missed in a DHE key pool.
+
+  @param  dhe_key_pool                   The DHE key pool.
+  @param  hit_count                     The number of key pairs taken from the pool.
+  @param  miss_count                    The number of key pairs generated in the handshake because the pool was empty.
+**/
+void spdm_dhe_key_pool_get_statistics(IN void *dhe_key_pool,
+				      OUT uint64 *hit_count,
+				      OUT uint64 *miss_count)
+{
+	spdm_dhe_key_pool_t *pool;
+
+	pool = dhe_key_pool;
+	spdm_dhe_key_pool_lock(pool);
+	*hit_count = pool->hit_count;
+	*miss_count = pool->miss_count;
+	spdm_dhe_key_pool_unlock(pool);
+}
+
+/**
+  Take a ready key pair of a DHE group from a DHE key pool.
+
+  The slot is emptied, so the key pair is handed out only once.
+
+  @param  pool                          The DHE key pool.
+  @param  dhe_named_group                SPDM dhe_named_group
+  @param  public_key                    Pointer to the buffer to receive the public key.
+  @param  public_key_size                On input, the size of public_key buffer in bytes.
+                                       On output, the size of data returned in public_key buffer in bytes.
+
+  @return Pointer to the DHE context, or NULL if no key pair of the group is ready.
+**/
+static void *spdm_dhe_key_pool_take(IN spdm_dhe_key_pool_t *pool,
+				    IN uint16 dhe_named_group,
+				    OUT uint8 *public_key,
+				    IN OUT uintn *public_key_size)
+{
+	spdm_dhe_key_pool_slot_t *slot;
+	void *dhe_context;
+	uintn index;
+
+	slot = (void *)(pool + 1);
+	dhe_context = NULL;
+
+	spdm_dhe_key_pool_lock(pool);
+	for (index = 0; index < pool->slot_count; index++) {
+		if (slot[index].dhe_named_group != dhe_named_group ||
+		    slot[index].state != SPDM_DHE_KEY_POOL_SLOT_READY ||
+		    slot[index].public_key_size > *public_key_size) {
+			continue;
+		}
+		dhe_context = slot[index].dhe_context;
+		copy_mem(public_key, slot[index].public_key,
+			 slot[index].public_key_size);
+		*public_key_size = slot[index].public_key_size;
+		slot[index].dhe_context = NULL;
+		zero_mem(slot[index].public_key, slot[index].public_key_size);
+		slot[index].state = SPDM_DHE_KEY_POOL_SLOT_EMPTY;
+		break;
+	}
+	if (dhe_context != NULL) {
+		pool->hit_count++;
+	} else {
+		pool->miss_count++;
+	}
+	spdm_dhe_key_pool_unlock(pool);
+
+	if (dhe_context != NULL) {
+		spdm_dhe_key_pool_signal(pool);
+	}
+	return dhe_context;
+}
+
+/**
+  Allocates a DHE context with a generated key pair, based upon negotiated DHE algorithm.
+
+  The key pair is taken from the DHE key pool if one is ready, or generated otherwise.
+  The caller owns the DHE context and frees it with spdm_secured_message_dhe_free.
+
+  @param  dhe_key_pool                   The DHE key pool, or NULL to always generate the key pair.
+  @param  dhe_named_group                SPDM dhe_named_group
+  @param  public_key                    Pointer to the buffer to receive the public key.
+  @param  public_key_size                On input, the size of public_key buffer in bytes.
+                                       On output, the size of data returned in public_key buffer in bytes.
+
+  @return Pointer to the DHE context, or NULL if the key pair cannot be generated.
+**/
+void *spdm_secured_message_dhe_new_key(IN void *dhe_key_pool OPTIONAL,
+				       IN uint16 dhe_named_group,
+				       OUT uint8 *public_key,
+				       IN OUT uintn *public_key_size)
+{
+	void *dhe_context;
+
+	if (dhe_key_pool != NULL) {
+		dhe_context = spdm_dhe_key_pool_take(dhe_key_pool,
+						     dhe_named_group,
+						     public_key,
+						     public_key_size);
+		if (dhe_context != NULL) {
+			return dhe_context;
+		}
+	}
+	return spdm_dhe_key_pool_generate(dhe_named_group, public_key,
+					  public_key_size);
+}
@@ -7,25 +7,73 @@
 #include "spdm_secured_message_lib_internal.h"
 
 /**
-  Encode an application message to a secured message.
+  Return the room an in-place encoded secured message needs around the application message.
+
+  The head room covers the record header (session ID, sequence number, length) and,
+  for an encrypted session, the cipher header.
+  The tail room covers the random padding and the AEAD tag.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+  @param  head_room_size                 size in bytes required in front of the application message.
+  @param  tail_room_size                 size in bytes required behind the application message.
+**/
+void spdm_secured_message_get_room_size(
+	IN void *spdm_secured_message_context,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t,
+	OUT uintn *head_room_size, OUT uintn *tail_room_size)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uint64 sequence_num_in_header;
+	uint8 sequence_num_in_header_size;
+
+	secured_message_context = spdm_secured_message_context;
+
+	sequence_num_in_header = 0;
+	sequence_num_in_header_size =
+		spdm_secured_message_callbacks_t->get_sequence_number(
+			0, (uint8 *)&sequence_num_in_header);
+	ASSERT(sequence_num_in_header_size <= sizeof(sequence_num_in_header));
+
+	*head_room_size = sizeof(spdm_secured_message_a_data_header1_t) +
+			  sequence_num_in_header_size +
+			  sizeof(spdm_secured_message_a_data_header2_t);
+	*tail_room_size = secured_message_context->aead_tag_size;
+	if (secured_message_context->session_type ==
+	    SPDM_SESSION_TYPE_ENC_MAC) {
+		*head_room_size += sizeof(spdm_secured_message_cipher_header_t);
+		*tail_room_size += spdm_secured_message_callbacks_t
+					   ->get_max_random_number_count();
+	}
+}
+
+/**
+  Encode an application message to a secured message in place.
+
+  The record header (and cipher header) are written in front of the application message,
+  the random padding and the AEAD tag behind it, and the payload is encrypted in place.
+  No copy of the application message is made.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
   @param  session_id                    The session ID of the SPDM session.
   @param  is_requester                  Indicates if it is a requester message.
+  @param  head_room_size                 size in bytes of the writable room in front of app_message.
   @param  app_message_size               size in bytes of the application message data buffer.
-  @param  app_message                   A pointer to a source buffer to store the application message.
-  @param  secured_message_size           size in bytes of the secured message data buffer.
-  @param  secured_message               A pointer to a destination buffer to store the secured message.
+  @param  app_message                   A pointer to the application message inside a larger buffer.
+  @param  tail_room_size                 size in bytes of the writable room behind app_message.
+  @param  secured_message_size           size in bytes of the encoded secured message.
+  @param  secured_message               A pointer to the start of the encoded secured message, inside the same buffer.
   @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
 
   @retval RETURN_SUCCESS               The application message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_BUFFER_TOO_SMALL      The head room or tail room is too small.
 **/
-return_status spdm_encode_secured_message(
+return_status spdm_encode_secured_message_in_place(
 	IN void *spdm_secured_message_context, IN uint32 session_id,
-	IN boolean is_requester, IN uintn app_message_size,
-	IN void *app_message, IN OUT uintn *secured_message_size,
-	OUT void *secured_message,
+	IN boolean is_requester, IN uintn head_room_size,
+	IN uintn app_message_size, IN OUT void *app_message,
+	IN uintn tail_room_size, OUT uintn *secured_message_size,
+	OUT void **secured_message,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
 {
 	spdm_secured_message_context_t *secured_message_context;
@@ -45,7 +93,7 @@ return_status spdm_encode_secured_message(
 	uintn record_header_size;
 	spdm_secured_message_cipher_header_t *enc_msg_header;
 	boolean result;
-	uint8 key[MAX_AEAD_KEY_SIZE];
+	const uint8 *key;
 	uint8 salt[MAX_AEAD_IV_SIZE];
 	uint64 sequence_number;
 	uint64 sequence_num_in_header;
@@ -54,6 +102,7 @@ return_status spdm_encode_secured_message(
 	uint32 rand_count;
 	uint32 max_rand_count;
 	spdm_session_state_t session_state;
+	void *aead_context;
 
 	secured_message_context = spdm_secured_message_context;
 
@@ -71,10 +120,8 @@ return_status spdm_encode_secured_message(
 	switch (session_state) {
 	case SPDM_SESSION_STATE_HANDSHAKING:
 		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .request_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->handshake_secret
+					.request_handshake_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->handshake_secret
 					 .request_handshake_salt,
@@ -83,10 +130,8 @@ return_status spdm_encode_secured_message(
 				secured_message_context->handshake_secret
 					.request_handshake_sequence_number;
 		} else {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .response_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->handshake_secret
+					.response_handshake_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->handshake_secret
 					 .response_handshake_salt,
@@ -98,10 +143,8 @@ return_status spdm_encode_secured_message(
 		break;
 	case SPDM_SESSION_STATE_ESTABLISHED:
 		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .request_data_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->application_secret
+					.request_data_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->application_secret
 					 .request_data_salt,
@@ -110,10 +153,8 @@ return_status spdm_encode_secured_message(
 				secured_message_context->application_secret
 					.request_data_sequence_number;
 		} else {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .response_data_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->application_secret
+					.response_data_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->application_secret
 					 .response_data_salt,
@@ -141,6 +182,36 @@ return_status spdm_encode_secured_message(
 			sequence_number, (uint8 *)&sequence_num_in_header);
 	ASSERT(sequence_num_in_header_size <= sizeof(sequence_num_in_header));
 
+	//
+	// Check the room before the sequence number is consumed, so that a caller
+	// can retry with a larger buffer.
+	//
+	record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
+			     sequence_num_in_header_size +
+			     sizeof(spdm_secured_message_a_data_header2_t);
+	switch (session_type) {
+	case SPDM_SESSION_TYPE_ENC_MAC:
+		if ((head_room_size <
+		     record_header_size +
+			     sizeof(spdm_secured_message_cipher_header_t)) ||
+		    (tail_room_size <
+		     spdm_secured_message_callbacks_t
+				     ->get_max_random_number_count() +
+			     aead_tag_size)) {
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		break;
+	case SPDM_SESSION_TYPE_MAC_ONLY:
+		if ((head_room_size < record_header_size) ||
+		    (tail_room_size < aead_tag_size)) {
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		break;
+	default:
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
+	}
+
 	sequence_number++;
 	switch (session_state) {
 	case SPDM_SESSION_STATE_HANDSHAKING:
@@ -169,9 +240,8 @@ return_status spdm_encode_secured_message(
 		return RETURN_UNSUPPORTED;
 	}
 
-	record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
-			     sequence_num_in_header_size +
-			     sizeof(spdm_secured_message_a_data_header2_t);
+	aead_context = spdm_secured_message_get_aead_context(
+		secured_message_context, is_requester, key);
 
 	switch (session_type) {
 	case SPDM_SESSION_TYPE_ENC_MAC:
@@ -192,13 +262,11 @@ return_status spdm_encode_secured_message(
 		total_secured_message_size =
 			record_header_size + cipher_text_size + aead_tag_size;
 
-		ASSERT(*secured_message_size >= total_secured_message_size);
-		if (*secured_message_size < total_secured_message_size) {
-			*secured_message_size = total_secured_message_size;
-			return RETURN_BUFFER_TOO_SMALL;
-		}
-		*secured_message_size = total_secured_message_size;
-		record_header1 = (void *)secured_message;
+		enc_msg_header =
+			(void *)((uint8 *)app_message -
+				 sizeof(spdm_secured_message_cipher_header_t));
+		record_header1 =
+			(void *)((uint8 *)enc_msg_header - record_header_size);
 		record_header2 =
 			(void *)((uint8 *)record_header1 +
 				 sizeof(spdm_secured_message_a_data_header1_t) +
@@ -208,10 +276,8 @@ return_status spdm_encode_secured_message(
 			 sequence_num_in_header_size);
 		record_header2->length =
 			(uint16)(cipher_text_size + aead_tag_size);
-		enc_msg_header = (void *)(record_header2 + 1);
 		enc_msg_header->application_data_length =
 			(uint16)app_message_size;
-		copy_mem(enc_msg_header + 1, app_message, app_message_size);
 		random_bytes(
 			(uint8 *)enc_msg_header +
 				sizeof(spdm_secured_message_cipher_header_t) +
@@ -226,25 +292,31 @@ return_status spdm_encode_secured_message(
 		tag = (uint8 *)record_header1 + record_header_size +
 		      cipher_text_size;
 
-		result = spdm_aead_encryption(
-			secured_message_context->secured_message_version,
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
-			record_header_size, dec_msg, cipher_text_size, tag,
-			aead_tag_size, enc_msg, &cipher_text_size);
+		if (aead_context != NULL) {
+			result = spdm_aead_seal(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite,
+				aead_context, salt, aead_iv_size,
+				(uint8 *)a_data, record_header_size, dec_msg,
+				cipher_text_size, tag, aead_tag_size, enc_msg,
+				&cipher_text_size);
+		} else {
+			result = spdm_aead_encryption(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite, key,
+				aead_key_size, salt, aead_iv_size,
+				(uint8 *)a_data, record_header_size, dec_msg,
+				cipher_text_size, tag, aead_tag_size, enc_msg,
+				&cipher_text_size);
+		}
 		break;
 
 	case SPDM_SESSION_TYPE_MAC_ONLY:
 		total_secured_message_size =
 			record_header_size + app_message_size + aead_tag_size;
 
-		ASSERT(*secured_message_size >= total_secured_message_size);
-		if (*secured_message_size < total_secured_message_size) {
-			*secured_message_size = total_secured_message_size;
-			return RETURN_BUFFER_TOO_SMALL;
-		}
-		*secured_message_size = total_secured_message_size;
-		record_header1 = (void *)secured_message;
+		record_header1 =
+			(void *)((uint8 *)app_message - record_header_size);
 		record_header2 =
 			(void *)((uint8 *)record_header1 +
 				 sizeof(spdm_secured_message_a_data_header1_t) +
@@ -254,17 +326,27 @@ return_status spdm_encode_secured_message(
 			 sequence_num_in_header_size);
 		record_header2->length =
 			(uint16)(app_message_size + aead_tag_size);
-		copy_mem(record_header2 + 1, app_message, app_message_size);
 		a_data = (uint8 *)record_header1;
 		tag = (uint8 *)record_header1 + record_header_size +
 		      app_message_size;
 
-		result = spdm_aead_encryption(
-			secured_message_context->secured_message_version,
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
-			record_header_size + app_message_size, NULL, 0, tag,
-			aead_tag_size, NULL, NULL);
+		if (aead_context != NULL) {
+			result = spdm_aead_seal(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite,
+				aead_context, salt, aead_iv_size,
+				(uint8 *)a_data,
+				record_header_size + app_message_size, NULL, 0,
+				tag, aead_tag_size, NULL, NULL);
+		} else {
+			result = spdm_aead_encryption(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite, key,
+				aead_key_size, salt, aead_iv_size,
+				(uint8 *)a_data,
+				record_header_size + app_message_size, NULL, 0,
+				tag, aead_tag_size, NULL, NULL);
+		}
 		break;
 
 	default:
@@ -274,30 +356,110 @@ return_status spdm_encode_secured_message(
 	if (!result) {
 		return RETURN_OUT_OF_RESOURCES;
 	}
+
+	if (session_state == SPDM_SESSION_STATE_ESTABLISHED) {
+		if (is_requester) {
+			secured_message_context->application_secret
+				.request_data_byte_count += app_message_size;
+		} else {
+			secured_message_context->application_secret
+				.response_data_byte_count += app_message_size;
+		}
+	}
+
+	*secured_message_size = total_secured_message_size;
+	*secured_message = record_header1;
 	return RETURN_SUCCESS;
 }
 
 /**
-  Decode an application message from a secured message.
+  Encode an application message to a secured message.
+
+  This is the copy interface. The application message is copied once into the secured
+  message buffer, and then encoded in place by spdm_encode_secured_message_in_place.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
   @param  session_id                    The session ID of the SPDM session.
   @param  is_requester                  Indicates if it is a requester message.
-  @param  secured_message_size           size in bytes of the secured message data buffer.
-  @param  secured_message               A pointer to a source buffer to store the secured message.
   @param  app_message_size               size in bytes of the application message data buffer.
-  @param  app_message                   A pointer to a destination buffer to store the application message.
+  @param  app_message                   A pointer to a source buffer to store the application message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to a destination buffer to store the secured message.
   @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
 
-  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_SUCCESS               The application message is encoded successfully.
   @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+**/
+return_status spdm_encode_secured_message(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn app_message_size,
+	IN void *app_message, IN OUT uintn *secured_message_size,
+	OUT void *secured_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	return_status status;
+	uintn head_room_size;
+	uintn tail_room_size;
+	uintn encoded_message_size;
+	void *encoded_message;
+
+	spdm_secured_message_get_room_size(spdm_secured_message_context,
+					   spdm_secured_message_callbacks_t,
+					   &head_room_size, &tail_room_size);
+
+	ASSERT(*secured_message_size >= head_room_size + app_message_size);
+	if (*secured_message_size < head_room_size + app_message_size) {
+		*secured_message_size =
+			head_room_size + app_message_size + tail_room_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem((uint8 *)secured_message + head_room_size, app_message,
+		 app_message_size);
+
+	status = spdm_encode_secured_message_in_place(
+		spdm_secured_message_context, session_id, is_requester,
+		head_room_size, app_message_size,
+		(uint8 *)secured_message + head_room_size,
+		*secured_message_size - head_room_size - app_message_size,
+		&encoded_message_size, &encoded_message,
+		spdm_secured_message_callbacks_t);
+	if (RETURN_ERROR(status)) {
+		if (status == RETURN_BUFFER_TOO_SMALL) {
+			*secured_message_size = head_room_size +
+						app_message_size +
+						tail_room_size;
+		}
+		return status;
+	}
+	ASSERT(encoded_message == secured_message);
+	*secured_message_size = encoded_message_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode an application message from a secured message in place.
+
+  The payload is verified and decrypted inside the secured message buffer, and
+  app_message is returned as a pointer into that buffer. No copy is made.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to the secured message. It is decrypted in place.
+  @param  app_message_size               size in bytes of the decoded application message.
+  @param  app_message                   A pointer to the decoded application message inside secured_message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_SECURITY_VIOLATION    The secured_message fails verification.
   @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
 **/
-return_status spdm_decode_secured_message(
+return_status spdm_decode_secured_message_in_place(
 	IN void *spdm_secured_message_context, IN uint32 session_id,
 	IN boolean is_requester, IN uintn secured_message_size,
-	IN void *secured_message, IN OUT uintn *app_message_size,
-	OUT void *app_message,
+	IN OUT void *secured_message, OUT uintn *app_message_size,
+	OUT void **app_message,
 	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
 {
 	spdm_secured_message_context_t *secured_message_context;
@@ -315,7 +477,7 @@ return_status spdm_decode_secured_message(
 	uintn record_header_size;
 	spdm_secured_message_cipher_header_t *enc_msg_header;
 	boolean result;
-	uint8 key[MAX_AEAD_KEY_SIZE];
+	const uint8 *key;
 	uint8 salt[MAX_AEAD_IV_SIZE];
 	uint64 sequence_number;
 	uint64 sequence_num_in_header;
@@ -323,7 +485,7 @@ return_status spdm_decode_secured_message(
 	spdm_session_type_t session_type;
 	spdm_session_state_t session_state;
 	spdm_error_struct_t spdm_error;
-	uint8 dec_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *aead_context;
 
 	spdm_error.error_code = 0;
 	spdm_error.session_id = 0;
@@ -349,10 +511,8 @@ return_status spdm_decode_secured_message(
 	switch (session_state) {
 	case SPDM_SESSION_STATE_HANDSHAKING:
 		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .request_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->handshake_secret
+					.request_handshake_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->handshake_secret
 					 .request_handshake_salt,
@@ -361,10 +521,8 @@ return_status spdm_decode_secured_message(
 				secured_message_context->handshake_secret
 					.request_handshake_sequence_number;
 		} else {
-			copy_mem(key,
-				 secured_message_context->handshake_secret
-					 .response_handshake_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->handshake_secret
+					.response_handshake_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->handshake_secret
 					 .response_handshake_salt,
@@ -376,10 +534,8 @@ return_status spdm_decode_secured_message(
 		break;
 	case SPDM_SESSION_STATE_ESTABLISHED:
 		if (is_requester) {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .request_data_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->application_secret
+					.request_data_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->application_secret
 					 .request_data_salt,
@@ -388,10 +544,8 @@ return_status spdm_decode_secured_message(
 				secured_message_context->application_secret
 					.request_data_sequence_number;
 		} else {
-			copy_mem(key,
-				 secured_message_context->application_secret
-					 .response_data_encryption_key,
-				 secured_message_context->aead_key_size);
+			key = secured_message_context->application_secret
+					.response_data_encryption_key;
 			copy_mem(salt,
 				 secured_message_context->application_secret
 					 .response_data_salt,
@@ -448,6 +602,9 @@ return_status spdm_decode_secured_message(
 		return RETURN_UNSUPPORTED;
 	}
 
+	aead_context = spdm_secured_message_get_aead_context(
+		secured_message_context, is_requester, key);
+
 	record_header_size = sizeof(spdm_secured_message_a_data_header1_t) +
 			     sequence_num_in_header_size +
 			     sizeof(spdm_secured_message_a_data_header2_t);
@@ -487,42 +644,48 @@ return_status spdm_decode_secured_message(
 			return RETURN_SECURITY_VIOLATION;
 		}
 		cipher_text_size = (record_header2->length - aead_tag_size);
-		if (cipher_text_size > sizeof(dec_message)) {
-			return RETURN_OUT_OF_RESOURCES;
-		}
-		zero_mem(dec_message, sizeof(dec_message));
 		enc_msg_header = (void *)(record_header2 + 1);
 		a_data = (uint8 *)record_header1;
 		enc_msg = (uint8 *)enc_msg_header;
-		dec_msg = (uint8 *)dec_message;
-		enc_msg_header = (void *)dec_msg;
+		dec_msg = (uint8 *)enc_msg_header;
 		tag = (uint8 *)record_header1 + record_header_size +
 		      cipher_text_size;
-		result = spdm_aead_decryption(
-			secured_message_context->secured_message_version,
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
-			record_header_size, enc_msg, cipher_text_size, tag,
-			aead_tag_size, dec_msg, &cipher_text_size);
+		if (aead_context != NULL) {
+			result = spdm_aead_open(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite,
+				aead_context, salt, aead_iv_size,
+				(uint8 *)a_data, record_header_size, enc_msg,
+				cipher_text_size, tag, aead_tag_size, dec_msg,
+				&cipher_text_size);
+		} else {
+			result = spdm_aead_decryption(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite, key,
+				aead_key_size, salt, aead_iv_size,
+				(uint8 *)a_data, record_header_size, enc_msg,
+				cipher_text_size, tag, aead_tag_size, dec_msg,
+				&cipher_text_size);
+		}
 		if (!result) {
+			//
+			// Do not leave unauthenticated plain text in the caller buffer.
+			//
+			zero_mem(dec_msg, record_header2->length - aead_tag_size);
 			spdm_secured_message_set_last_spdm_error_struct(
 				spdm_secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 		plain_text_size = enc_msg_header->application_data_length;
-		if (plain_text_size > cipher_text_size) {
+		if (plain_text_size + sizeof(spdm_secured_message_cipher_header_t) >
+		    cipher_text_size) {
 			spdm_secured_message_set_last_spdm_error_struct(
 				spdm_secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		ASSERT(*app_message_size >= plain_text_size);
-		if (*app_message_size < plain_text_size) {
-			*app_message_size = plain_text_size;
-			return RETURN_BUFFER_TOO_SMALL;
-		}
 		*app_message_size = plain_text_size;
-		copy_mem(app_message, enc_msg_header + 1, plain_text_size);
+		*app_message = enc_msg_header + 1;
 		break;
 
 	case SPDM_SESSION_TYPE_MAC_ONLY:
@@ -561,27 +724,33 @@ return_status spdm_decode_secured_message(
 		a_data = (uint8 *)record_header1;
 		tag = (uint8 *)record_header1 + record_header_size +
 		      record_header2->length - aead_tag_size;
-		result = spdm_aead_decryption(
-			secured_message_context->secured_message_version,
-			secured_message_context->aead_cipher_suite, key,
-			aead_key_size, salt, aead_iv_size, (uint8 *)a_data,
-			record_header_size + record_header2->length -
-				aead_tag_size,
-			NULL, 0, tag, aead_tag_size, NULL, NULL);
+		if (aead_context != NULL) {
+			result = spdm_aead_open(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite,
+				aead_context, salt, aead_iv_size,
+				(uint8 *)a_data,
+				record_header_size + record_header2->length -
+					aead_tag_size,
+				NULL, 0, tag, aead_tag_size, NULL, NULL);
+		} else {
+			result = spdm_aead_decryption(
+				secured_message_context->secured_message_version,
+				secured_message_context->aead_cipher_suite, key,
+				aead_key_size, salt, aead_iv_size,
+				(uint8 *)a_data,
+				record_header_size + record_header2->length -
+					aead_tag_size,
+				NULL, 0, tag, aead_tag_size, NULL, NULL);
+		}
 		if (!result) {
 			spdm_secured_message_set_last_spdm_error_struct(
 				spdm_secured_message_context, &spdm_error);
 			return RETURN_SECURITY_VIOLATION;
 		}
 
-		plain_text_size = record_header2->length - aead_tag_size;
-		ASSERT(*app_message_size >= plain_text_size);
-		if (*app_message_size < plain_text_size) {
-			*app_message_size = plain_text_size;
-			return RETURN_BUFFER_TOO_SMALL;
-		}
-		*app_message_size = plain_text_size;
-		copy_mem(app_message, record_header2 + 1, plain_text_size);
+		*app_message_size = record_header2->length - aead_tag_size;
+		*app_message = record_header2 + 1;
 		break;
 
 	default:
@@ -589,5 +758,69 @@ return_status spdm_decode_secured_message(
 		return RETURN_UNSUPPORTED;
 	}
 
+	if (session_state == SPDM_SESSION_STATE_ESTABLISHED) {
+		if (is_requester) {
+			secured_message_context->application_secret
+				.request_data_byte_count += *app_message_size;
+		} else {
+			secured_message_context->application_secret
+				.response_data_byte_count += *app_message_size;
+		}
+	}
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode an application message from a secured message.
+
+  This is the copy interface. The secured message is decoded in a local buffer by
+  spdm_decode_secured_message_in_place, and the application message is copied out.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  session_id                    The session ID of the SPDM session.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  secured_message_size           size in bytes of the secured message data buffer.
+  @param  secured_message               A pointer to a source buffer to store the secured message.
+  @param  app_message_size               size in bytes of the application message data buffer.
+  @param  app_message                   A pointer to a destination buffer to store the application message.
+  @param  spdm_secured_message_callbacks_t  A pointer to a secured message callback functions structure.
+
+  @retval RETURN_SUCCESS               The application message is decoded successfully.
+  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The secured_message is unsupported.
+**/
+return_status spdm_decode_secured_message(
+	IN void *spdm_secured_message_context, IN uint32 session_id,
+	IN boolean is_requester, IN uintn secured_message_size,
+	IN void *secured_message, IN OUT uintn *app_message_size,
+	OUT void *app_message,
+	IN spdm_secured_message_callbacks_t *spdm_secured_message_callbacks_t)
+{
+	return_status status;
+	uint8 dec_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn decoded_message_size;
+	void *decoded_message;
+
+	if (secured_message_size > sizeof(dec_message)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	copy_mem(dec_message, secured_message, secured_message_size);
+
+	status = spdm_decode_secured_message_in_place(
+		spdm_secured_message_context, session_id, is_requester,
+		secured_message_size, dec_message, &decoded_message_size,
+		&decoded_message, spdm_secured_message_callbacks_t);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	ASSERT(*app_message_size >= decoded_message_size);
+	if (*app_message_size < decoded_message_size) {
+		*app_message_size = decoded_message_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	*app_message_size = decoded_message_size;
+	copy_mem(app_message, decoded_message, decoded_message_size);
 	return RETURN_SUCCESS;
 }
@@ -8,6 +8,20 @@
 
 GLOBAL_REMOVE_IF_UNREFERENCED uint8 m_zero_filled_buffer[64];
 
+GLOBAL_REMOVE_IF_UNREFERENCED spdm_bin_str_label_t
+	m_spdm_bin_str_label[SPDM_BIN_STR_COUNT] = {
+		{ BIN_STR_0_LABEL, sizeof(BIN_STR_0_LABEL) - 1 },
+		{ BIN_STR_1_LABEL, sizeof(BIN_STR_1_LABEL) - 1 },
+		{ BIN_STR_2_LABEL, sizeof(BIN_STR_2_LABEL) - 1 },
+		{ BIN_STR_3_LABEL, sizeof(BIN_STR_3_LABEL) - 1 },
+		{ BIN_STR_4_LABEL, sizeof(BIN_STR_4_LABEL) - 1 },
+		{ BIN_STR_5_LABEL, sizeof(BIN_STR_5_LABEL) - 1 },
+		{ BIN_STR_6_LABEL, sizeof(BIN_STR_6_LABEL) - 1 },
+		{ BIN_STR_7_LABEL, sizeof(BIN_STR_7_LABEL) - 1 },
+		{ BIN_STR_8_LABEL, sizeof(BIN_STR_8_LABEL) - 1 },
+		{ BIN_STR_9_LABEL, sizeof(BIN_STR_9_LABEL) - 1 },
+	};
+
 /**
   This function dump raw data.
 
@@ -78,11 +92,73 @@ return_status spdm_bin_concat(IN char8 *label, IN uintn label_size,
 	return RETURN_SUCCESS;
 }
 
+/**
+  Precompute the bin_str prefixes of an SPDM secured message context, for the
+  negotiated hash size and AEAD key and IV sizes.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+**/
+void spdm_secured_message_init_bin_str(
+	IN spdm_secured_message_context_t *secured_message_context)
+{
+	return_status status;
+	uintn index;
+	uintn length;
+
+	for (index = 0; index < SPDM_BIN_STR_COUNT; index++) {
+		if (index == 5) {
+			length = secured_message_context->aead_key_size;
+		} else if (index == 6) {
+			length = secured_message_context->aead_iv_size;
+		} else {
+			length = secured_message_context->hash_size;
+		}
+		secured_message_context->bin_str_prefix_size[index] =
+			SPDM_BIN_STR_PREFIX_MAX_SIZE;
+		status = spdm_bin_concat(
+			m_spdm_bin_str_label[index].label,
+			m_spdm_bin_str_label[index].label_size, NULL,
+			(uint16)length, 0,
+			secured_message_context->bin_str_prefix[index],
+			&secured_message_context->bin_str_prefix_size[index]);
+		ASSERT_RETURN_ERROR(status);
+	}
+}
+
+/**
+  This function builds one bin_str of the key schedule from its precomputed prefix.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  index                        The index of the bin_str.
+  @param  th_hash_data                  The TH hash appended as the context, or NULL if the bin_str has no context.
+  @param  bin_str                       The buffer to store the bin_str.
+  @param  bin_str_size                   The size in bytes of the bin_str.
+**/
+void spdm_secured_message_get_bin_str(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN uintn index, IN uint8 *th_hash_data OPTIONAL, OUT uint8 *bin_str,
+	OUT uintn *bin_str_size)
+{
+	uintn prefix_size;
+
+	prefix_size = secured_message_context->bin_str_prefix_size[index];
+	copy_mem(bin_str, secured_message_context->bin_str_prefix[index],
+		 prefix_size);
+	*bin_str_size = prefix_size;
+	if (th_hash_data != NULL) {
+		copy_mem(bin_str + prefix_size, th_hash_data,
+			 secured_message_context->hash_size);
+		*bin_str_size += secured_message_context->hash_size;
+	}
+	DEBUG((DEBUG_INFO, "bin_str%d (0x%x):\n", index, *bin_str_size));
+	internal_dump_hex(bin_str, *bin_str_size);
+}
+
 /**
   This function generates SPDM AEAD key and IV for a session.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
-  @param  major_secret                  The major secret.
+  @param  hkdf_ctx                      The HKDF context keyed with the major secret.
   @param  key                          The buffer to store the AEAD key.
   @param  iv                           The buffer to store the AEAD IV.
 
@@ -90,47 +166,34 @@ return_status spdm_bin_concat(IN char8 *label, IN uintn label_size,
 **/
 return_status spdm_generate_aead_key_and_iv(
 	IN spdm_secured_message_context_t *secured_message_context,
-	IN uint8 *major_secret, OUT uint8 *key, OUT uint8 *iv)
+	IN void *hkdf_ctx, OUT uint8 *key, OUT uint8 *iv)
 {
-	return_status status;
 	boolean ret_val;
-	uintn hash_size;
 	uintn key_length;
 	uintn iv_length;
-	uint8 bin_str5[128];
+	uint8 bin_str5[SPDM_BIN_STR_PREFIX_MAX_SIZE];
 	uintn bin_str5_size;
-	uint8 bin_str6[128];
+	uint8 bin_str6[SPDM_BIN_STR_PREFIX_MAX_SIZE];
 	uintn bin_str6_size;
 
-	hash_size = secured_message_context->hash_size;
 	key_length = secured_message_context->aead_key_size;
 	iv_length = secured_message_context->aead_iv_size;
 
-	bin_str5_size = sizeof(bin_str5);
-	status = spdm_bin_concat(BIN_STR_5_LABEL, sizeof(BIN_STR_5_LABEL) - 1,
-				 NULL, (uint16)key_length, hash_size, bin_str5,
-				 &bin_str5_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str5 (0x%x):\n", bin_str5_size));
-	internal_dump_hex(bin_str5, bin_str5_size);
-	ret_val = spdm_hkdf_expand(secured_message_context->base_hash_algo,
-				   major_secret, hash_size, bin_str5,
-				   bin_str5_size, key, key_length);
+	spdm_secured_message_get_bin_str(secured_message_context, 5, NULL,
+					 bin_str5, &bin_str5_size);
+	ret_val = spdm_hkdf_keyed_expand(secured_message_context->base_hash_algo,
+					 hkdf_ctx, bin_str5, bin_str5_size, key,
+					 key_length);
 	ASSERT(ret_val);
 	DEBUG((DEBUG_INFO, "key (0x%x) - ", key_length));
 	internal_dump_data(key, key_length);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	bin_str6_size = sizeof(bin_str6);
-	status = spdm_bin_concat(BIN_STR_6_LABEL, sizeof(BIN_STR_6_LABEL) - 1,
-				 NULL, (uint16)iv_length, hash_size, bin_str6,
-				 &bin_str6_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str6 (0x%x):\n", bin_str6_size));
-	internal_dump_hex(bin_str6, bin_str6_size);
-	ret_val = spdm_hkdf_expand(secured_message_context->base_hash_algo,
-				   major_secret, hash_size, bin_str6,
-				   bin_str6_size, iv, iv_length);
+	spdm_secured_message_get_bin_str(secured_message_context, 6, NULL,
+					 bin_str6, &bin_str6_size);
+	ret_val = spdm_hkdf_keyed_expand(secured_message_context->base_hash_algo,
+					 hkdf_ctx, bin_str6, bin_str6_size, iv,
+					 iv_length);
 	ASSERT(ret_val);
 	DEBUG((DEBUG_INFO, "iv (0x%x) - ", iv_length));
 	internal_dump_data(iv, iv_length);
@@ -143,33 +206,27 @@ return_status spdm_generate_aead_key_and_iv(
   This function generates SPDM finished_key for a session.
 
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
-  @param  handshake_secret              The handshake secret.
+  @param  hkdf_ctx                      The HKDF context keyed with the handshake secret.
   @param  finished_key                  The buffer to store the finished key.
 
   @retval RETURN_SUCCESS  SPDM finished_key for a session is generated.
 **/
 return_status spdm_generate_finished_key(
 	IN spdm_secured_message_context_t *secured_message_context,
-	IN uint8 *handshake_secret, OUT uint8 *finished_key)
+	IN void *hkdf_ctx, OUT uint8 *finished_key)
 {
-	return_status status;
 	boolean ret_val;
 	uintn hash_size;
-	uint8 bin_str7[128];
+	uint8 bin_str7[SPDM_BIN_STR_PREFIX_MAX_SIZE];
 	uintn bin_str7_size;
 
 	hash_size = secured_message_context->hash_size;
 
-	bin_str7_size = sizeof(bin_str7);
-	status = spdm_bin_concat(BIN_STR_7_LABEL, sizeof(BIN_STR_7_LABEL) - 1,
-				 NULL, (uint16)hash_size, hash_size, bin_str7,
-				 &bin_str7_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str7 (0x%x):\n", bin_str7_size));
-	internal_dump_hex(bin_str7, bin_str7_size);
-	ret_val = spdm_hkdf_expand(secured_message_context->base_hash_algo,
-				   handshake_secret, hash_size, bin_str7,
-				   bin_str7_size, finished_key, hash_size);
+	spdm_secured_message_get_bin_str(secured_message_context, 7, NULL,
+					 bin_str7, &bin_str7_size);
+	ret_val = spdm_hkdf_keyed_expand(secured_message_context->base_hash_algo,
+					 hkdf_ctx, bin_str7, bin_str7_size,
+					 finished_key, hash_size);
 	ASSERT(ret_val);
 	DEBUG((DEBUG_INFO, "finished_key (0x%x) - ", hash_size));
 	internal_dump_data(finished_key, hash_size);
@@ -178,6 +235,36 @@ return_status spdm_generate_finished_key(
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function generates the SPDM finished_key, AEAD key and IV of one direction
+  from its handshake secret or data secret.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  hkdf_ctx                      The HKDF context to be keyed with the major secret.
+  @param  major_secret                  The handshake secret or data secret of the direction.
+  @param  finished_key                  The buffer to store the finished key, or NULL for a data secret.
+  @param  key                          The buffer to store the AEAD key.
+  @param  iv                           The buffer to store the AEAD IV.
+**/
+void spdm_generate_direction_keys(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN void *hkdf_ctx, IN uint8 *major_secret,
+	OUT uint8 *finished_key OPTIONAL, OUT uint8 *key, OUT uint8 *iv)
+{
+	boolean ret_val;
+
+	ret_val = spdm_hkdf_set_prk(secured_message_context->base_hash_algo,
+				    hkdf_ctx, major_secret,
+				    secured_message_context->hash_size);
+	ASSERT(ret_val);
+	if (finished_key != NULL) {
+		spdm_generate_finished_key(secured_message_context, hkdf_ctx,
+					   finished_key);
+	}
+	spdm_generate_aead_key_and_iv(secured_message_context, hkdf_ctx, key,
+				      iv);
+}
+
 /**
   This function generates SPDM HandshakeKey for a session.
 
@@ -190,28 +277,23 @@ return_status
 spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 				    IN uint8 *th1_hash_data)
 {
-	return_status status;
 	boolean ret_val;
 	uintn hash_size;
-	uint8 bin_str0[128];
-	uintn bin_str0_size;
-	uint8 bin_str1[128];
+	uint8 bin_str1[SPDM_BIN_STR_PREFIX_MAX_SIZE + MAX_HASH_SIZE];
 	uintn bin_str1_size;
-	uint8 bin_str2[128];
+	uint8 bin_str2[SPDM_BIN_STR_PREFIX_MAX_SIZE + MAX_HASH_SIZE];
 	uintn bin_str2_size;
+	void *hkdf_ctx;
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
 
 	hash_size = secured_message_context->hash_size;
 
-	bin_str0_size = sizeof(bin_str0);
-	status = spdm_bin_concat(BIN_STR_0_LABEL, sizeof(BIN_STR_0_LABEL) - 1,
-				 NULL, (uint16)hash_size, hash_size, bin_str0,
-				 &bin_str0_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str0 (0x%x):\n", bin_str0_size));
-	internal_dump_hex(bin_str0, bin_str0_size);
+	hkdf_ctx = spdm_hkdf_new(secured_message_context->base_hash_algo);
+	if (hkdf_ctx == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
 
 	if (secured_message_context->use_psk) {
 		// No handshake_secret generation for PSK.
@@ -233,15 +315,16 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 			secured_message_context->master_secret.handshake_secret,
 			hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+		ret_val = spdm_hkdf_set_prk(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			secured_message_context->master_secret.handshake_secret,
+			hash_size);
+		ASSERT(ret_val);
 	}
 
-	bin_str1_size = sizeof(bin_str1);
-	status = spdm_bin_concat(BIN_STR_1_LABEL, sizeof(BIN_STR_1_LABEL) - 1,
-				 th1_hash_data, (uint16)hash_size, hash_size,
-				 bin_str1, &bin_str1_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str1 (0x%x):\n", bin_str1_size));
-	internal_dump_hex(bin_str1, bin_str1_size);
+	spdm_secured_message_get_bin_str(secured_message_context, 1,
+					 th1_hash_data, bin_str1,
+					 &bin_str1_size);
 	if (secured_message_context->use_psk) {
 		ret_val = spdm_psk_handshake_secret_hkdf_expand(
 			secured_message_context->version,
@@ -253,13 +336,14 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 				.request_handshake_secret,
 			hash_size);
 		if (!ret_val) {
+			spdm_hkdf_free(secured_message_context->base_hash_algo,
+				       hkdf_ctx);
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.handshake_secret,
-			hash_size, bin_str1, bin_str1_size,
+		ret_val = spdm_hkdf_keyed_expand(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			bin_str1, bin_str1_size,
 			secured_message_context->handshake_secret
 				.request_handshake_secret,
 			hash_size);
@@ -270,13 +354,9 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 				   .request_handshake_secret,
 			   hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
-	bin_str2_size = sizeof(bin_str2);
-	status = spdm_bin_concat(BIN_STR_2_LABEL, sizeof(BIN_STR_2_LABEL) - 1,
-				 th1_hash_data, (uint16)hash_size, hash_size,
-				 bin_str2, &bin_str2_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str2 (0x%x):\n", bin_str2_size));
-	internal_dump_hex(bin_str2, bin_str2_size);
+	spdm_secured_message_get_bin_str(secured_message_context, 2,
+					 th1_hash_data, bin_str2,
+					 &bin_str2_size);
 	if (secured_message_context->use_psk) {
 		ret_val = spdm_psk_handshake_secret_hkdf_expand(
 			secured_message_context->version,
@@ -288,13 +368,14 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 				.response_handshake_secret,
 			hash_size);
 		if (!ret_val) {
+			spdm_hkdf_free(secured_message_context->base_hash_algo,
+				       hkdf_ctx);
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.handshake_secret,
-			hash_size, bin_str2, bin_str2_size,
+		ret_val = spdm_hkdf_keyed_expand(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			bin_str2, bin_str2_size,
 			secured_message_context->handshake_secret
 				.response_handshake_secret,
 			hash_size);
@@ -306,32 +387,23 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 			   hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	spdm_generate_finished_key(
-		secured_message_context,
+	spdm_generate_direction_keys(
+		secured_message_context, hkdf_ctx,
 		secured_message_context->handshake_secret
 			.request_handshake_secret,
-		secured_message_context->handshake_secret.request_finished_key);
-
-	spdm_generate_finished_key(
-		secured_message_context,
+		secured_message_context->handshake_secret.request_finished_key,
 		secured_message_context->handshake_secret
-			.response_handshake_secret,
-		secured_message_context->handshake_secret.response_finished_key);
-
-	spdm_generate_aead_key_and_iv(secured_message_context,
-				      secured_message_context->handshake_secret
-					      .request_handshake_secret,
-				      secured_message_context->handshake_secret
-					      .request_handshake_encryption_key,
-				      secured_message_context->handshake_secret
-					      .request_handshake_salt);
+			.request_handshake_encryption_key,
+		secured_message_context->handshake_secret
+			.request_handshake_salt);
 	secured_message_context->handshake_secret
 		.request_handshake_sequence_number = 0;
 
-	spdm_generate_aead_key_and_iv(
-		secured_message_context,
+	spdm_generate_direction_keys(
+		secured_message_context, hkdf_ctx,
 		secured_message_context->handshake_secret
 			.response_handshake_secret,
+		secured_message_context->handshake_secret.response_finished_key,
 		secured_message_context->handshake_secret
 			.response_handshake_encryption_key,
 		secured_message_context->handshake_secret
@@ -339,8 +411,13 @@ spdm_generate_session_handshake_key(IN void *spdm_secured_message_context,
 	secured_message_context->handshake_secret
 		.response_handshake_sequence_number = 0;
 
-	zero_mem(secured_message_context->master_secret.dhe_secret,
+	spdm_hkdf_free(secured_message_context->base_hash_algo, hkdf_ctx);
+
+	secure_zero_mem(secured_message_context->master_secret.dhe_secret,
 		MAX_DHE_KEY_SIZE);
+
+	spdm_secured_message_reset_aead_context(secured_message_context, TRUE);
+	spdm_secured_message_reset_aead_context(secured_message_context, FALSE);
 	
 	secured_message_context->finished_key_ready = TRUE;
 	return RETURN_SUCCESS;
@@ -358,37 +435,42 @@ return_status
 spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 			       IN uint8 *th2_hash_data)
 {
-	return_status status;
 	boolean ret_val;
 	uintn hash_size;
 	uint8 salt1[64];
-	uint8 bin_str0[128];
+	uint8 bin_str0[SPDM_BIN_STR_PREFIX_MAX_SIZE];
 	uintn bin_str0_size;
-	uint8 bin_str3[128];
+	uint8 bin_str3[SPDM_BIN_STR_PREFIX_MAX_SIZE + MAX_HASH_SIZE];
 	uintn bin_str3_size;
-	uint8 bin_str4[128];
+	uint8 bin_str4[SPDM_BIN_STR_PREFIX_MAX_SIZE + MAX_HASH_SIZE];
 	uintn bin_str4_size;
-	uint8 bin_str8[128];
+	uint8 bin_str8[SPDM_BIN_STR_PREFIX_MAX_SIZE + MAX_HASH_SIZE];
 	uintn bin_str8_size;
+	void *hkdf_ctx;
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
 
 	hash_size = secured_message_context->hash_size;
 
+	hkdf_ctx = spdm_hkdf_new(secured_message_context->base_hash_algo);
+	if (hkdf_ctx == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+
 	if (secured_message_context->use_psk) {
 		// No master_secret generation for PSK.
 	} else {
-		bin_str0_size = sizeof(bin_str0);
-		status = spdm_bin_concat(BIN_STR_0_LABEL,
-					 sizeof(BIN_STR_0_LABEL) - 1, NULL,
-					 (uint16)hash_size, hash_size, bin_str0,
-					 &bin_str0_size);
-		ASSERT_RETURN_ERROR(status);
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
+		spdm_secured_message_get_bin_str(secured_message_context, 0,
+						 NULL, bin_str0, &bin_str0_size);
+		ret_val = spdm_hkdf_set_prk(
+			secured_message_context->base_hash_algo, hkdf_ctx,
 			secured_message_context->master_secret.handshake_secret,
-			hash_size, bin_str0, bin_str0_size, salt1, hash_size);
+			hash_size);
+		ASSERT(ret_val);
+		ret_val = spdm_hkdf_keyed_expand(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			bin_str0, bin_str0_size, salt1, hash_size);
 		ASSERT(ret_val);
 		DEBUG((DEBUG_INFO, "salt1 (0x%x) - ", hash_size));
 		internal_dump_data(salt1, hash_size);
@@ -404,15 +486,16 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 			secured_message_context->master_secret.master_secret,
 			hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+		ret_val = spdm_hkdf_set_prk(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			secured_message_context->master_secret.master_secret,
+			hash_size);
+		ASSERT(ret_val);
 	}
 
-	bin_str3_size = sizeof(bin_str3);
-	status = spdm_bin_concat(BIN_STR_3_LABEL, sizeof(BIN_STR_3_LABEL) - 1,
-				 th2_hash_data, (uint16)hash_size, hash_size,
-				 bin_str3, &bin_str3_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str3 (0x%x):\n", bin_str3_size));
-	internal_dump_hex(bin_str3, bin_str3_size);
+	spdm_secured_message_get_bin_str(secured_message_context, 3,
+					 th2_hash_data, bin_str3,
+					 &bin_str3_size);
 	if (secured_message_context->use_psk) {
 		ret_val = spdm_psk_master_secret_hkdf_expand(
 			secured_message_context->version,
@@ -424,13 +507,14 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 				.request_data_secret,
 			hash_size);
 		if (!ret_val) {
+			spdm_hkdf_free(secured_message_context->base_hash_algo,
+				       hkdf_ctx);
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.master_secret,
-			hash_size, bin_str3, bin_str3_size,
+		ret_val = spdm_hkdf_keyed_expand(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			bin_str3, bin_str3_size,
 			secured_message_context->application_secret
 				.request_data_secret,
 			hash_size);
@@ -441,13 +525,9 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 		secured_message_context->application_secret.request_data_secret,
 		hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
-	bin_str4_size = sizeof(bin_str4);
-	status = spdm_bin_concat(BIN_STR_4_LABEL, sizeof(BIN_STR_4_LABEL) - 1,
-				 th2_hash_data, (uint16)hash_size, hash_size,
-				 bin_str4, &bin_str4_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str4 (0x%x):\n", bin_str4_size));
-	internal_dump_hex(bin_str4, bin_str4_size);
+	spdm_secured_message_get_bin_str(secured_message_context, 4,
+					 th2_hash_data, bin_str4,
+					 &bin_str4_size);
 	if (secured_message_context->use_psk) {
 		ret_val = spdm_psk_master_secret_hkdf_expand(
 			secured_message_context->version,
@@ -459,13 +539,14 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 				.response_data_secret,
 			hash_size);
 		if (!ret_val) {
+			spdm_hkdf_free(secured_message_context->base_hash_algo,
+				       hkdf_ctx);
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.master_secret,
-			hash_size, bin_str4, bin_str4_size,
+		ret_val = spdm_hkdf_keyed_expand(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			bin_str4, bin_str4_size,
 			secured_message_context->application_secret
 				.response_data_secret,
 			hash_size);
@@ -477,13 +558,9 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 		hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	bin_str8_size = sizeof(bin_str8);
-	status = spdm_bin_concat(BIN_STR_8_LABEL, sizeof(BIN_STR_8_LABEL) - 1,
-				 th2_hash_data, (uint16)hash_size, hash_size,
-				 bin_str8, &bin_str8_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str8 (0x%x):\n", bin_str8_size));
-	internal_dump_hex(bin_str8, bin_str8_size);
+	spdm_secured_message_get_bin_str(secured_message_context, 8,
+					 th2_hash_data, bin_str8,
+					 &bin_str8_size);
 	if (secured_message_context->use_psk) {
 		ret_val = spdm_psk_master_secret_hkdf_expand(
 			secured_message_context->version,
@@ -495,13 +572,14 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 				.export_master_secret,
 			hash_size);
 		if (!ret_val) {
+			spdm_hkdf_free(secured_message_context->base_hash_algo,
+				       hkdf_ctx);
 			return RETURN_UNSUPPORTED;
 		}
 	} else {
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
-			secured_message_context->master_secret.master_secret,
-			hash_size, bin_str8, bin_str8_size,
+		ret_val = spdm_hkdf_keyed_expand(
+			secured_message_context->base_hash_algo, hkdf_ctx,
+			bin_str8, bin_str8_size,
 			secured_message_context->handshake_secret
 				.export_master_secret,
 			hash_size);
@@ -513,24 +591,134 @@ spdm_generate_session_data_key(IN void *spdm_secured_message_context,
 		hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
-	spdm_generate_aead_key_and_iv(
-		secured_message_context,
+	spdm_generate_direction_keys(
+		secured_message_context, hkdf_ctx,
 		secured_message_context->application_secret.request_data_secret,
+		NULL,
 		secured_message_context->application_secret
 			.request_data_encryption_key,
 		secured_message_context->application_secret.request_data_salt);
 	secured_message_context->application_secret
 		.request_data_sequence_number = 0;
 
-	spdm_generate_aead_key_and_iv(
-		secured_message_context,
+	spdm_generate_direction_keys(
+		secured_message_context, hkdf_ctx,
 		secured_message_context->application_secret.response_data_secret,
+		NULL,
 		secured_message_context->application_secret
 			.response_data_encryption_key,
 		secured_message_context->application_secret.response_data_salt);
 	secured_message_context->application_secret
 		.response_data_sequence_number = 0;
 
+	spdm_hkdf_free(secured_message_context->base_hash_algo, hkdf_ctx);
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function derives the next data secret, encryption key and salt of one direction
+  from the current data secret.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  hkdf_ctx                      The HKDF context.
+  @param  data_secret                   The current data secret.
+  @param  new_data_secret                The next data secret. It may be data_secret.
+  @param  new_key                       The next encryption key.
+  @param  new_salt                      The next salt.
+**/
+static void spdm_derive_update_data_key(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN void *hkdf_ctx, IN uint8 *data_secret, OUT uint8 *new_data_secret,
+	OUT uint8 *new_key, OUT uint8 *new_salt)
+{
+	boolean ret_val;
+	uint8 bin_str9[SPDM_BIN_STR_PREFIX_MAX_SIZE];
+	uintn bin_str9_size;
+
+	spdm_secured_message_get_bin_str(secured_message_context, 9, NULL,
+					 bin_str9, &bin_str9_size);
+
+	ret_val = spdm_hkdf_set_prk(secured_message_context->base_hash_algo,
+				    hkdf_ctx, data_secret,
+				    secured_message_context->hash_size);
+	ASSERT(ret_val);
+	ret_val = spdm_hkdf_keyed_expand(
+		secured_message_context->base_hash_algo, hkdf_ctx, bin_str9,
+		bin_str9_size, new_data_secret,
+		secured_message_context->hash_size);
+	ASSERT(ret_val);
+
+	spdm_generate_direction_keys(secured_message_context, hkdf_ctx,
+				     new_data_secret, NULL, new_key, new_salt);
+}
+
+/**
+  This function derives the next SPDM DataKey of a session ahead of the key update.
+
+  spdm_create_update_session_data_key then uses the derived keys instead of deriving them,
+  so calling this function at an idle point keeps the key derivation out of the key update.
+  The keys already derived are kept.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  action                       Indicate of the key update action.
+
+  @retval RETURN_SUCCESS  The next SPDM DataKey is derived.
+  @retval RETURN_OUT_OF_RESOURCES  The HKDF context cannot be allocated.
+**/
+return_status
+spdm_prepare_update_session_data_key(IN void *spdm_secured_message_context,
+				     IN spdm_key_update_action_t action)
+{
+	void *hkdf_ctx;
+	spdm_secured_message_context_t *secured_message_context;
+
+	secured_message_context = spdm_secured_message_context;
+
+	if (secured_message_context->request_data_update_ready) {
+		action &= ~SPDM_KEY_UPDATE_ACTION_REQUESTER;
+	}
+	if (secured_message_context->response_data_update_ready) {
+		action &= ~SPDM_KEY_UPDATE_ACTION_RESPONDER;
+	}
+	if (action == 0) {
+		return RETURN_SUCCESS;
+	}
+
+	hkdf_ctx = spdm_hkdf_new(secured_message_context->base_hash_algo);
+	if (hkdf_ctx == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+
+	if ((action & SPDM_KEY_UPDATE_ACTION_REQUESTER) != 0) {
+		spdm_derive_update_data_key(
+			secured_message_context, hkdf_ctx,
+			secured_message_context->application_secret
+				.request_data_secret,
+			secured_message_context->application_secret_update
+				.request_data_secret,
+			secured_message_context->application_secret_update
+				.request_data_encryption_key,
+			secured_message_context->application_secret_update
+				.request_data_salt);
+		secured_message_context->request_data_update_ready = TRUE;
+	}
+
+	if ((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) {
+		spdm_derive_update_data_key(
+			secured_message_context, hkdf_ctx,
+			secured_message_context->application_secret
+				.response_data_secret,
+			secured_message_context->application_secret_update
+				.response_data_secret,
+			secured_message_context->application_secret_update
+				.response_data_encryption_key,
+			secured_message_context->application_secret_update
+				.response_data_salt);
+		secured_message_context->response_data_update_ready = TRUE;
+	}
+
+	spdm_hkdf_free(secured_message_context->base_hash_algo, hkdf_ctx);
 	return RETURN_SUCCESS;
 }
 
@@ -546,24 +734,27 @@ return_status
 spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 				    IN spdm_key_update_action_t action)
 {
-	return_status status;
-	boolean ret_val;
 	uintn hash_size;
-	uint8 bin_str9[128];
-	uintn bin_str9_size;
+	void *hkdf_ctx;
 	spdm_secured_message_context_t *secured_message_context;
 
 	secured_message_context = spdm_secured_message_context;
 
 	hash_size = secured_message_context->hash_size;
 
-	bin_str9_size = sizeof(bin_str9);
-	status = spdm_bin_concat(BIN_STR_9_LABEL, sizeof(BIN_STR_9_LABEL) - 1,
-				 NULL, (uint16)hash_size, hash_size, bin_str9,
-				 &bin_str9_size);
-	ASSERT_RETURN_ERROR(status);
-	DEBUG((DEBUG_INFO, "bin_str9 (0x%x):\n", bin_str9_size));
-	internal_dump_hex(bin_str9, bin_str9_size);
+	//
+	// The HKDF context is only needed for keys not derived ahead of time.
+	//
+	hkdf_ctx = NULL;
+	if ((((action & SPDM_KEY_UPDATE_ACTION_REQUESTER) != 0) &&
+	     !secured_message_context->request_data_update_ready) ||
+	    (((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) &&
+	     !secured_message_context->response_data_update_ready)) {
+		hkdf_ctx = spdm_hkdf_new(secured_message_context->base_hash_algo);
+		if (hkdf_ctx == NULL) {
+			return RETURN_OUT_OF_RESOURCES;
+		}
+	}
 
 	if ((action & SPDM_KEY_UPDATE_ACTION_REQUESTER) != 0) {
 		copy_mem(&secured_message_context->application_secret_backup
@@ -585,16 +776,60 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 			.request_data_sequence_number =
 			secured_message_context->application_secret
 				.request_data_sequence_number;
-
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
+		secured_message_context->application_secret_backup
+			.request_data_byte_count =
 			secured_message_context->application_secret
-				.request_data_secret,
-			hash_size, bin_str9, bin_str9_size,
+				.request_data_byte_count;
+		secured_message_context->application_secret_backup
+			.request_data_key_time_us =
 			secured_message_context->application_secret
-				.request_data_secret,
-			hash_size);
-		ASSERT(ret_val);
+				.request_data_key_time_us;
+
+		if (secured_message_context->request_data_update_ready) {
+			copy_mem(&secured_message_context->application_secret
+					  .request_data_secret,
+				 &secured_message_context
+					  ->application_secret_update
+					  .request_data_secret,
+				 MAX_HASH_SIZE);
+			copy_mem(&secured_message_context->application_secret
+					  .request_data_encryption_key,
+				 &secured_message_context
+					  ->application_secret_update
+					  .request_data_encryption_key,
+				 MAX_AEAD_KEY_SIZE);
+			copy_mem(&secured_message_context->application_secret
+					  .request_data_salt,
+				 &secured_message_context
+					  ->application_secret_update
+					  .request_data_salt,
+				 MAX_AEAD_IV_SIZE);
+			secure_zero_mem(&secured_message_context
+					  ->application_secret_update
+					  .request_data_secret,
+				 MAX_HASH_SIZE);
+			secure_zero_mem(&secured_message_context
+					  ->application_secret_update
+					  .request_data_encryption_key,
+				 MAX_AEAD_KEY_SIZE);
+			secure_zero_mem(&secured_message_context
+					  ->application_secret_update
+					  .request_data_salt,
+				 MAX_AEAD_IV_SIZE);
+			secured_message_context->request_data_update_ready =
+				FALSE;
+		} else {
+			spdm_derive_update_data_key(
+				secured_message_context, hkdf_ctx,
+				secured_message_context->application_secret
+					.request_data_secret,
+				secured_message_context->application_secret
+					.request_data_secret,
+				secured_message_context->application_secret
+					.request_data_encryption_key,
+				secured_message_context->application_secret
+					.request_data_salt);
+		}
 		DEBUG((DEBUG_INFO, "RequestDataSecretUpdate (0x%x) - ",
 		       hash_size));
 		internal_dump_data(secured_message_context->application_secret
@@ -602,16 +837,14 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 				   hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
 
-		spdm_generate_aead_key_and_iv(
-			secured_message_context,
-			secured_message_context->application_secret
-				.request_data_secret,
-			secured_message_context->application_secret
-				.request_data_encryption_key,
-			secured_message_context->application_secret
-				.request_data_salt);
 		secured_message_context->application_secret
 			.request_data_sequence_number = 0;
+		secured_message_context->application_secret
+			.request_data_byte_count = 0;
+		secured_message_context->application_secret
+			.request_data_key_time_us = 0;
+		spdm_secured_message_reset_aead_context(secured_message_context,
+							TRUE);
 	}
 
 	if ((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) {
@@ -634,16 +867,60 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 			.response_data_sequence_number =
 			secured_message_context->application_secret
 				.response_data_sequence_number;
-
-		ret_val = spdm_hkdf_expand(
-			secured_message_context->base_hash_algo,
+		secured_message_context->application_secret_backup
+			.response_data_byte_count =
 			secured_message_context->application_secret
-				.response_data_secret,
-			hash_size, bin_str9, bin_str9_size,
+				.response_data_byte_count;
+		secured_message_context->application_secret_backup
+			.response_data_key_time_us =
 			secured_message_context->application_secret
-				.response_data_secret,
-			hash_size);
-		ASSERT(ret_val);
+				.response_data_key_time_us;
+
+		if (secured_message_context->response_data_update_ready) {
+			copy_mem(&secured_message_context->application_secret
+					  .response_data_secret,
+				 &secured_message_context
+					  ->application_secret_update
+					  .response_data_secret,
+				 MAX_HASH_SIZE);
+			copy_mem(&secured_message_context->application_secret
+					  .response_data_encryption_key,
+				 &secured_message_context
+					  ->application_secret_update
+					  .response_data_encryption_key,
+				 MAX_AEAD_KEY_SIZE);
+			copy_mem(&secured_message_context->application_secret
+					  .response_data_salt,
+				 &secured_message_context
+					  ->application_secret_update
+					  .response_data_salt,
+				 MAX_AEAD_IV_SIZE);
+			secure_zero_mem(&secured_message_context
+					  ->application_secret_update
+					  .response_data_secret,
+				 MAX_HASH_SIZE);
+			secure_zero_mem(&secured_message_context
+					  ->application_secret_update
+					  .response_data_encryption_key,
+				 MAX_AEAD_KEY_SIZE);
+			secure_zero_mem(&secured_message_context
+					  ->application_secret_update
+					  .response_data_salt,
+				 MAX_AEAD_IV_SIZE);
+			secured_message_context->response_data_update_ready =
+				FALSE;
+		} else {
+			spdm_derive_update_data_key(
+				secured_message_context, hkdf_ctx,
+				secured_message_context->application_secret
+					.response_data_secret,
+				secured_message_context->application_secret
+					.response_data_secret,
+				secured_message_context->application_secret
+					.response_data_encryption_key,
+				secured_message_context->application_secret
+					.response_data_salt);
+		}
 		DEBUG((DEBUG_INFO, "ResponseDataSecretUpdate (0x%x) - ",
 		       hash_size));
 		internal_dump_data(secured_message_context->application_secret
@@ -651,16 +928,19 @@ spdm_create_update_session_data_key(IN void *spdm_secured_message_context,
 				   hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
 
-		spdm_generate_aead_key_and_iv(
-			secured_message_context,
-			secured_message_context->application_secret
-				.response_data_secret,
-			secured_message_context->application_secret
-				.response_data_encryption_key,
-			secured_message_context->application_secret
-				.response_data_salt);
 		secured_message_context->application_secret
 			.response_data_sequence_number = 0;
+		secured_message_context->application_secret
+			.response_data_byte_count = 0;
+		secured_message_context->application_secret
+			.response_data_key_time_us = 0;
+		spdm_secured_message_reset_aead_context(secured_message_context,
+							FALSE);
+	}
+
+	if (hkdf_ctx != NULL) {
+		spdm_hkdf_free(secured_message_context->base_hash_algo,
+			       hkdf_ctx);
 	}
 	return RETURN_SUCCESS;
 }
@@ -676,9 +956,9 @@ void spdm_clear_handshake_secret(IN void *spdm_secured_message_context)
 
 	secured_message_context = spdm_secured_message_context;
 
-	zero_mem(secured_message_context->master_secret.handshake_secret,
+	secure_zero_mem(secured_message_context->master_secret.handshake_secret,
 			MAX_HASH_SIZE);
-	zero_mem(&(secured_message_context->handshake_secret),
+	secure_zero_mem(&(secured_message_context->handshake_secret),
 			sizeof(spdm_session_info_struct_handshake_secret_t));
 }
 
@@ -702,6 +982,34 @@ spdm_activate_update_session_data_key(IN void *spdm_secured_message_context,
 
 	if (!use_new_key) {
 		if ((action & SPDM_KEY_UPDATE_ACTION_REQUESTER) != 0) {
+			//
+			// The rejected keys are the next keys of the restored ones.
+			//
+			if (!secured_message_context->request_data_update_ready) {
+				copy_mem(&secured_message_context
+						  ->application_secret_update
+						  .request_data_secret,
+					 &secured_message_context
+						  ->application_secret
+						  .request_data_secret,
+					 MAX_HASH_SIZE);
+				copy_mem(&secured_message_context
+						  ->application_secret_update
+						  .request_data_encryption_key,
+					 &secured_message_context
+						  ->application_secret
+						  .request_data_encryption_key,
+					 MAX_AEAD_KEY_SIZE);
+				copy_mem(&secured_message_context
+						  ->application_secret_update
+						  .request_data_salt,
+					 &secured_message_context
+						  ->application_secret
+						  .request_data_salt,
+					 MAX_AEAD_IV_SIZE);
+				secured_message_context->request_data_update_ready =
+					TRUE;
+			}
 			copy_mem(&secured_message_context->application_secret
 					  .request_data_secret,
 				 &secured_message_context
@@ -725,8 +1033,48 @@ spdm_activate_update_session_data_key(IN void *spdm_secured_message_context,
 				secured_message_context
 					->application_secret_backup
 					.request_data_sequence_number;
+			secured_message_context->application_secret
+				.request_data_byte_count =
+				secured_message_context
+					->application_secret_backup
+					.request_data_byte_count;
+			secured_message_context->application_secret
+				.request_data_key_time_us =
+				secured_message_context
+					->application_secret_backup
+					.request_data_key_time_us;
+			spdm_secured_message_reset_aead_context(
+				secured_message_context, TRUE);
 		}
 		if ((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) {
+			//
+			// The rejected keys are the next keys of the restored ones.
+			//
+			if (!secured_message_context->response_data_update_ready) {
+				copy_mem(&secured_message_context
+						  ->application_secret_update
+						  .response_data_secret,
+					 &secured_message_context
+						  ->application_secret
+						  .response_data_secret,
+					 MAX_HASH_SIZE);
+				copy_mem(&secured_message_context
+						  ->application_secret_update
+						  .response_data_encryption_key,
+					 &secured_message_context
+						  ->application_secret
+						  .response_data_encryption_key,
+					 MAX_AEAD_KEY_SIZE);
+				copy_mem(&secured_message_context
+						  ->application_secret_update
+						  .response_data_salt,
+					 &secured_message_context
+						  ->application_secret
+						  .response_data_salt,
+					 MAX_AEAD_IV_SIZE);
+				secured_message_context->response_data_update_ready =
+					TRUE;
+			}
 			copy_mem(&secured_message_context->application_secret
 					  .response_data_secret,
 				 &secured_message_context
@@ -750,30 +1098,42 @@ spdm_activate_update_session_data_key(IN void *spdm_secured_message_context,
 				secured_message_context
 					->application_secret_backup
 					.response_data_sequence_number;
+			secured_message_context->application_secret
+				.response_data_byte_count =
+				secured_message_context
+					->application_secret_backup
+					.response_data_byte_count;
+			secured_message_context->application_secret
+				.response_data_key_time_us =
+				secured_message_context
+					->application_secret_backup
+					.response_data_key_time_us;
+			spdm_secured_message_reset_aead_context(
+				secured_message_context, FALSE);
 		}
 	}
 
 	if ((action & SPDM_KEY_UPDATE_ACTION_REQUESTER) != 0) {
-		zero_mem(&secured_message_context->application_secret_backup
+		secure_zero_mem(&secured_message_context->application_secret_backup
 				  .request_data_secret,
 			 MAX_HASH_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
+		secure_zero_mem(&secured_message_context->application_secret_backup
 				  .request_data_encryption_key,
 			 MAX_AEAD_KEY_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
+		secure_zero_mem(&secured_message_context->application_secret_backup
 				  .request_data_salt,
 			 MAX_AEAD_IV_SIZE);
 		secured_message_context->application_secret_backup
 			.request_data_sequence_number = 0;
 	}
 	if ((action & SPDM_KEY_UPDATE_ACTION_RESPONDER) != 0) {
-		zero_mem(&secured_message_context->application_secret_backup
+		secure_zero_mem(&secured_message_context->application_secret_backup
 				  .response_data_secret,
 			 MAX_HASH_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
+		secure_zero_mem(&secured_message_context->application_secret_backup
 				  .response_data_encryption_key,
 			 MAX_AEAD_KEY_SIZE);
-		zero_mem(&secured_message_context->application_secret_backup
+		secure_zero_mem(&secured_message_context->application_secret_backup
 				  .response_data_salt,
 			 MAX_AEAD_IV_SIZE);
 		secured_message_context->application_secret_backup
@@ -9,6 +9,18 @@
 
 #include <library/spdm_secured_message_lib.h>
 
+//
+// bin_str0 ~ bin_str9 of the key schedule. The prefix is the 16 bits length,
+// BIN_CONCAT_LABEL and the label, without the optional TH hash context.
+//
+#define SPDM_BIN_STR_COUNT 10
+#define SPDM_BIN_STR_PREFIX_MAX_SIZE 32
+
+typedef struct {
+	char8 *label;
+	uintn label_size;
+} spdm_bin_str_label_t;
+
 typedef struct {
 	uint8 dhe_secret[MAX_DHE_KEY_SIZE];
 	uint8 handshake_secret[MAX_HASH_SIZE];
@@ -38,6 +50,14 @@ typedef struct {
 	uint8 response_data_encryption_key[MAX_AEAD_KEY_SIZE];
 	uint8 response_data_salt[MAX_AEAD_IV_SIZE];
 	uint64 response_data_sequence_number;
+	//
+	// Application message bytes protected by the data keys, and the time the
+	// key update policy first saw the data keys, 0 until then.
+	//
+	uint64 request_data_byte_count;
+	uint64 response_data_byte_count;
+	uint64 request_data_key_time_us;
+	uint64 response_data_key_time_us;
 } spdm_session_info_struct_application_secret_t;
 
 typedef struct {
@@ -60,12 +80,107 @@ typedef struct {
 	spdm_session_info_struct_handshake_secret_t handshake_secret;
 	spdm_session_info_struct_application_secret_t application_secret;
 	spdm_session_info_struct_application_secret_t application_secret_backup;
+	//
+	// Data key update policy, and the next data keys derived ahead of time by
+	// spdm_prepare_update_session_data_key, so that the key update only copies them.
+	//
+	spdm_key_update_policy_t key_update_policy;
+	spdm_session_info_struct_application_secret_t application_secret_update;
+	boolean request_data_update_ready;
+	boolean response_data_update_ready;
 	uintn psk_hint_size;
 	void *psk_hint;
 	//
+	// bin_str prefixes for the negotiated hash and AEAD sizes, precomputed by
+	// spdm_secured_message_set_algorithms.
+	//
+	uint8 bin_str_prefix[SPDM_BIN_STR_COUNT][SPDM_BIN_STR_PREFIX_MAX_SIZE];
+	uintn bin_str_prefix_size[SPDM_BIN_STR_COUNT];
+	//
+	// Keyed AEAD contexts for the request and response direction. They are
+	// marked stale whenever the session keys change, and are rekeyed on the
+	// first message that uses the new keys.
+	//
+	void *request_aead_context;
+	void *response_aead_context;
+	boolean request_aead_context_keyed;
+	boolean response_aead_context_keyed;
+	//
 	// Cache the error in spdm_decode_secured_message. It is handled in spdm_build_response.
 	//
 	spdm_error_struct_t last_spdm_error;
 } spdm_secured_message_context_t;
 
+/**
+  Mark the keyed AEAD context of one direction as stale, because the
+  encryption key of that direction has changed.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  is_requester                  Indicates if it is the request direction.
+**/
+void spdm_secured_message_reset_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN boolean is_requester);
+
+/**
+  Return the keyed AEAD context of one direction. The context is allocated on
+  first use, and rekeyed with the given key if it is stale.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  is_requester                  Indicates if it is the request direction.
+  @param  key                          The current encryption key of the direction.
+
+  @return the keyed AEAD context, or NULL if keyed AEAD is unavailable.
+**/
+void *spdm_secured_message_get_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN boolean is_requester, IN const uint8 *key);
+
+/**
+  Release the keyed AEAD contexts of both directions.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+**/
+void spdm_secured_message_free_aead_context(
+	IN spdm_secured_message_context_t *secured_message_context);
+
+/**
+  Precompute the bin_str prefixes of an SPDM secured message context, for the
+  negotiated hash size and AEAD key and IV sizes.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+**/
+void spdm_secured_message_init_bin_str(
+	IN spdm_secured_message_context_t *secured_message_context);
+
+/**
+  This function builds one bin_str of the key schedule from its precomputed prefix.
+
+  @param  secured_message_context         A pointer to the SPDM secured message context.
+  @param  index                        The index of the bin_str.
+  @param  th_hash_data                  The TH hash appended as the context, or NULL if the bin_str has no context.
+  @param  bin_str                       The buffer to store the bin_str.
+  @param  bin_str_size                   The size in bytes of the bin_str.
+**/
+void spdm_secured_message_get_bin_str(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN uintn index, IN uint8 *th_hash_data OPTIONAL, OUT uint8 *bin_str,
+	OUT uintn *bin_str_size);
+
+/**
+  This function generates the SPDM finished_key, AEAD key and IV of one direction
+  from its handshake secret or data secret.
+
+  @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+  @param  hkdf_ctx                      The HKDF context to be keyed with the major secret.
+  @param  major_secret                  The handshake secret or data secret of the direction.
+  @param  finished_key                  The buffer to store the finished key, or NULL for a data secret.
+  @param  key                          The buffer to store the AEAD key.
+  @param  iv                           The buffer to store the AEAD IV.
+**/
+void spdm_generate_direction_keys(
+	IN spdm_secured_message_context_t *secured_message_context,
+	IN void *hkdf_ctx, IN uint8 *major_secret,
+	OUT uint8 *finished_key OPTIONAL, OUT uint8 *key, OUT uint8 *iv);
+
 #endif
\ No newline at end of file
@@ -8,89 +8,92 @@
 #include <library/spdm_secured_message_lib.h>
 
 /**
-  Encode a normal message or secured message to a transport message.
+  Encode a normal message or secured message to a transport message in place.
+
+  The MCTP header is written in front of the message and the alignment padding behind it.
 
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If session_id is NULL, it is a normal message.
                                        If session_id is NOT NULL, it is a secured message.
   @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a source buffer to store the message.
-  @param  transport_message_size         size in bytes of the transport message data buffer.
-  @param  transport_message             A pointer to a destination buffer to store the transport message.
+  @param  message                      A pointer to the message, with room for the MCTP header in front of it.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the start of the transport message, in front of message.
 
   @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The secured message does not belong to session_id.
 **/
-return_status mctp_encode_message(IN uint32 *session_id, IN uintn message_size,
-				  IN void *message,
-				  IN OUT uintn *transport_message_size,
-				  OUT void *transport_message);
+return_status mctp_encode_message_in_place(IN uint32 *session_id,
+					   IN uintn message_size,
+					   IN OUT void *message,
+					   OUT uintn *transport_message_size,
+					   OUT void **transport_message);
 
 /**
-  Decode a transport message to a normal message or secured message.
+  Decode a transport message to a normal message or secured message in place.
 
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If *session_id is NULL, it is a normal message.
                                        If *session_id is NOT NULL, it is a secured message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
   @param  transport_message             A pointer to a source buffer to store the transport message.
-  @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a destination buffer to store the message.
-  @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @param  message_size                  size in bytes of the message, including alignment padding.
+  @param  message                      A pointer to the message inside transport_message.
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
 **/
-return_status mctp_decode_message(OUT uint32 **session_id,
-				  IN uintn transport_message_size,
-				  IN void *transport_message,
-				  IN OUT uintn *message_size,
-				  OUT void *message);
+return_status mctp_decode_message_in_place(OUT uint32 **session_id,
+					   IN uintn transport_message_size,
+					   IN OUT void *transport_message,
+					   OUT uintn *message_size,
+					   OUT void **message);
 
 /**
-  Encode a normal message or secured message to a transport message.
+  Encode a normal message or secured message to a transport message in place.
 
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If session_id is NULL, it is a normal message.
                                        If session_id is NOT NULL, it is a secured message.
   @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a source buffer to store the message.
-  @param  transport_message_size         size in bytes of the transport message data buffer.
-  @param  transport_message             A pointer to a destination buffer to store the transport message.
+  @param  message                      A pointer to the message, with room for the transport header in front of it.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the start of the transport message, in front of message.
 
   @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The secured message does not belong to session_id.
 **/
-typedef return_status (*transport_encode_message_func)(
-	IN uint32 *session_id, IN uintn message_size, IN void *message,
-	IN OUT uintn *transport_message_size, OUT void *transport_message);
+typedef return_status (*transport_encode_message_in_place_func)(
+	IN uint32 *session_id, IN uintn message_size, IN OUT void *message,
+	OUT uintn *transport_message_size, OUT void **transport_message);
 
 /**
-  Decode a transport message to a normal message or secured message.
+  Decode a transport message to a normal message or secured message in place.
 
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If *session_id is NULL, it is a normal message.
                                        If *session_id is NOT NULL, it is a secured message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
   @param  transport_message             A pointer to a source buffer to store the transport message.
-  @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a destination buffer to store the message.
-  @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @param  message_size                  size in bytes of the message, including alignment padding.
+  @param  message                      A pointer to the message inside transport_message.
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
 **/
-typedef return_status (*transport_decode_message_func)(
+typedef return_status (*transport_decode_message_in_place_func)(
 	OUT uint32 **session_id, IN uintn transport_message_size,
-	IN void *transport_message, IN OUT uintn *message_size,
-	OUT void *message);
+	IN OUT void *transport_message, OUT uintn *message_size,
+	OUT void **message);
 
 /**
-  Encode an SPDM or APP message to a transport layer message.
+  Encode an SPDM or APP message to a transport layer message in place.
 
   For normal SPDM message, it adds the transport layer wrapper.
   For secured SPDM message, it encrypts a secured message then adds the transport layer wrapper.
   For secured APP message, it encrypts a secured message then adds the transport layer wrapper.
 
-  The APP message is encoded to a secured message directly in SPDM session.
-  The APP message format is defined by the transport layer.
-  Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
+  The message shall have SPDM_MCTP_TRANSPORT_HEADER_SIZE bytes of writable room in front of it
+  and SPDM_MCTP_TRANSPORT_TAIL_SIZE bytes of writable room behind it.
+  All headers, padding and the AEAD tag are written into that room. No copy is made.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
@@ -99,25 +102,26 @@ typedef return_status (*transport_decode_message_func)(
   @param  is_app_message                 Indicates if it is an APP message or SPDM message.
   @param  is_requester                  Indicates if it is a requester message.
   @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a source buffer to store the message.
-  @param  transport_message_size         size in bytes of the transport message data buffer.
-  @param  transport_message             A pointer to a destination buffer to store the transport message.
+  @param  message                      A pointer to the message, with head room and tail room around it.
+  @param  transport_message_size         size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to the start of the encoded transport message, inside the same buffer.
 
   @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The message cannot be encoded.
 **/
-return_status spdm_transport_mctp_encode_message(
+return_status spdm_transport_mctp_encode_message_in_place(
 	IN void *spdm_context, IN uint32 *session_id, IN boolean is_app_message,
-	IN boolean is_requester, IN uintn message_size, IN void *message,
-	IN OUT uintn *transport_message_size, OUT void *transport_message)
+	IN boolean is_requester, IN uintn message_size, IN OUT void *message,
+	OUT uintn *transport_message_size, OUT void **transport_message)
 {
 	return_status status;
-	transport_encode_message_func transport_encode_message;
-	uint8 app_message_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	transport_encode_message_in_place_func transport_encode_message;
 	void *app_message;
 	uintn app_message_size;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *secured_message;
 	uintn secured_message_size;
+	uintn head_room_size;
+	uintn tail_room_size;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
 
@@ -132,7 +136,7 @@ return_status spdm_transport_mctp_encode_message(
 		return RETURN_UNSUPPORTED;
 	}
 
-	transport_encode_message = mctp_encode_message;
+	transport_encode_message = mctp_encode_message_in_place;
 	if (session_id != NULL) {
 		secured_message_context =
 			spdm_get_secured_message_context_via_session_id(
@@ -143,12 +147,10 @@ return_status spdm_transport_mctp_encode_message(
 
 		if (!is_app_message) {
 			// SPDM message to APP message
-			app_message = app_message_buffer;
-			app_message_size = sizeof(app_message_buffer);
 			status = transport_encode_message(NULL, message_size,
 							  message,
 							  &app_message_size,
-							  app_message_buffer);
+							  &app_message);
 			if (RETURN_ERROR(status)) {
 				DEBUG((DEBUG_ERROR,
 				       "transport_encode_message - %p\n",
@@ -159,15 +161,23 @@ return_status spdm_transport_mctp_encode_message(
 			app_message = message;
 			app_message_size = message_size;
 		}
-		// APP message to secured message
-		secured_message_size = sizeof(secured_message);
-		status = spdm_encode_secured_message(
+		// APP message to secured message, leaving room for the outer MCTP header and padding
+		head_room_size = SPDM_MCTP_TRANSPORT_HEADER_SIZE -
+				 ((uint8 *)message - (uint8 *)app_message) -
+				 sizeof(mctp_message_header_t);
+		tail_room_size = SPDM_MCTP_TRANSPORT_TAIL_SIZE -
+				 (((uint8 *)app_message + app_message_size) -
+				  ((uint8 *)message + message_size)) -
+				 (SPDM_MCTP_ALIGNMENT - 1);
+		status = spdm_encode_secured_message_in_place(
 			secured_message_context, *session_id, is_requester,
-			app_message_size, app_message, &secured_message_size,
-			secured_message, &spdm_secured_message_callbacks_t);
+			head_room_size, app_message_size, app_message,
+			tail_room_size, &secured_message_size, &secured_message,
+			&spdm_secured_message_callbacks_t);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
-			       "spdm_encode_secured_message - %p\n", status));
+			       "spdm_encode_secured_message_in_place - %p\n",
+			       status));
 			return status;
 		}
 
@@ -196,15 +206,77 @@ return_status spdm_transport_mctp_encode_message(
 }
 
 /**
-  Decode an SPDM or APP message from a transport layer message.
+  Encode an SPDM or APP message to a transport layer message.
+
+  For normal SPDM message, it adds the transport layer wrapper.
+  For secured SPDM message, it encrypts a secured message then adds the transport layer wrapper.
+  For secured APP message, it encrypts a secured message then adds the transport layer wrapper.
+
+  The APP message is encoded to a secured message directly in SPDM session.
+  The APP message format is defined by the transport layer.
+  Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
+
+  This is the copy interface. The message is copied once into a local buffer with head room
+  and tail room, encoded by spdm_transport_mctp_encode_message_in_place, and copied out.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to a source buffer to store the message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a destination buffer to store the transport message.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+**/
+return_status spdm_transport_mctp_encode_message(
+	IN void *spdm_context, IN uint32 *session_id, IN boolean is_app_message,
+	IN boolean is_requester, IN uintn message_size, IN void *message,
+	IN OUT uintn *transport_message_size, OUT void *transport_message)
+{
+	return_status status;
+	uint8 message_buffer[SPDM_MCTP_TRANSPORT_HEADER_SIZE +
+			     MAX_SPDM_MESSAGE_BUFFER_SIZE +
+			     SPDM_MCTP_TRANSPORT_TAIL_SIZE];
+	void *encoded_message;
+	uintn encoded_message_size;
+
+	if (message_size > MAX_SPDM_MESSAGE_BUFFER_SIZE) {
+		return RETURN_UNSUPPORTED;
+	}
+	copy_mem(message_buffer + SPDM_MCTP_TRANSPORT_HEADER_SIZE, message,
+		 message_size);
+
+	status = spdm_transport_mctp_encode_message_in_place(
+		spdm_context, session_id, is_app_message, is_requester,
+		message_size, message_buffer + SPDM_MCTP_TRANSPORT_HEADER_SIZE,
+		&encoded_message_size, &encoded_message);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	ASSERT(*transport_message_size >= encoded_message_size);
+	if (*transport_message_size < encoded_message_size) {
+		*transport_message_size = encoded_message_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	*transport_message_size = encoded_message_size;
+	copy_mem(transport_message, encoded_message, encoded_message_size);
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode an SPDM or APP message from a transport layer message in place.
 
   For normal SPDM message, it removes the transport layer wrapper,
   For secured SPDM message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
   For secured APP message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
 
-  The APP message is decoded from a secured message directly in SPDM session.
-  The APP message format is defined by the transport layer.
-  Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
+  The transport message is decrypted inside its own buffer and message points into it. No copy is made.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
@@ -213,26 +285,25 @@ return_status spdm_transport_mctp_encode_message(
   @param  is_app_message                 Indicates if it is an APP message or SPDM message.
   @param  is_requester                  Indicates if it is a requester message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
-  @param  transport_message             A pointer to a source buffer to store the transport message.
-  @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a destination buffer to store the message.
+  @param  transport_message             A pointer to the transport message. It is decrypted in place.
+  @param  message_size                  size in bytes of the decoded message.
+  @param  message                      A pointer to the decoded message inside transport_message.
 
   @retval RETURN_SUCCESS               The message is decoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
   @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
 **/
-return_status spdm_transport_mctp_decode_message(
+return_status spdm_transport_mctp_decode_message_in_place(
 	IN void *spdm_context, OUT uint32 **session_id,
 	OUT boolean *is_app_message, IN boolean is_requester,
-	IN uintn transport_message_size, IN void *transport_message,
-	IN OUT uintn *message_size, OUT void *message)
+	IN uintn transport_message_size, IN OUT void *transport_message,
+	OUT uintn *message_size, OUT void **message)
 {
 	return_status status;
-	transport_decode_message_func transport_decode_message;
+	transport_decode_message_in_place_func transport_decode_message;
 	uint32 *SecuredMessageSessionId;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *secured_message;
 	uintn secured_message_size;
-	uint8 app_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	void *app_message;
 	uintn app_message_size;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
@@ -253,14 +324,13 @@ return_status spdm_transport_mctp_decode_message(
 		return RETURN_UNSUPPORTED;
 	}
 
-	transport_decode_message = mctp_decode_message;
+	transport_decode_message = mctp_decode_message_in_place;
 
 	SecuredMessageSessionId = NULL;
 	// Detect received message
-	secured_message_size = sizeof(secured_message);
 	status = transport_decode_message(
 		&SecuredMessageSessionId, transport_message_size,
-		transport_message, &secured_message_size, secured_message);
+		transport_message, &secured_message_size, &secured_message);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_ERROR, "transport_decode_message - %p\n", status));
 		return RETURN_UNSUPPORTED;
@@ -281,15 +351,15 @@ return_status spdm_transport_mctp_decode_message(
 		}
 
 		// Secured message to APP message
-		app_message_size = sizeof(app_message);
-		status = spdm_decode_secured_message(
+		status = spdm_decode_secured_message_in_place(
 			secured_message_context, *SecuredMessageSessionId,
 			is_requester, secured_message_size, secured_message,
-			&app_message_size, app_message,
+			&app_message_size, &app_message,
 			&spdm_secured_message_callbacks_t);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
-			       "spdm_decode_secured_message - %p\n", status));
+			       "spdm_decode_secured_message_in_place - %p\n",
+			       status));
 			spdm_secured_message_get_last_spdm_error_struct(
 				secured_message_context, &spdm_error);
 			spdm_set_last_spdm_error_struct(spdm_context,
@@ -304,12 +374,8 @@ return_status spdm_transport_mctp_decode_message(
 		if (RETURN_ERROR(status)) {
 			*is_app_message = TRUE;
 			// just return APP message.
-			if (*message_size < app_message_size) {
-				*message_size = app_message_size;
-				return RETURN_BUFFER_TOO_SMALL;
-			}
 			*message_size = app_message_size;
-			copy_mem(message, app_message, *message_size);
+			*message = app_message;
 			return RETURN_SUCCESS;
 		} else {
 			*is_app_message = FALSE;
@@ -325,18 +391,88 @@ return_status spdm_transport_mctp_decode_message(
 		}
 	} else {
 		// get non-secured message
-		status = transport_decode_message(&SecuredMessageSessionId,
-						  transport_message_size,
-						  transport_message,
-						  message_size, message);
-		if (RETURN_ERROR(status)) {
-			DEBUG((DEBUG_ERROR, "transport_decode_message - %p\n",
-			       status));
-			return RETURN_UNSUPPORTED;
-		}
-		ASSERT(SecuredMessageSessionId == NULL);
 		*session_id = NULL;
 		*is_app_message = FALSE;
+		*message_size = secured_message_size;
+		*message = secured_message;
 		return RETURN_SUCCESS;
 	}
 }
+
+/**
+  Decode an SPDM or APP message from a transport layer message.
+
+  For normal SPDM message, it removes the transport layer wrapper,
+  For secured SPDM message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+  For secured APP message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+
+  The APP message is decoded from a secured message directly in SPDM session.
+  The APP message format is defined by the transport layer.
+  Take MCTP as example: APP message == MCTP header (MCTP_MESSAGE_TYPE_SPDM) + SPDM message
+
+  This is the copy interface. The transport message is copied once into a local buffer,
+  decoded by spdm_transport_mctp_decode_message_in_place, and the message is copied out.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to a destination buffer to store the message.
+
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+return_status spdm_transport_mctp_decode_message(
+	IN void *spdm_context, OUT uint32 **session_id,
+	OUT boolean *is_app_message, IN boolean is_requester,
+	IN uintn transport_message_size, IN void *transport_message,
+	IN OUT uintn *message_size, OUT void *message)
+{
+	return_status status;
+	uint8 transport_message_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint32 *message_session_id;
+	void *decoded_message;
+	uintn decoded_message_size;
+
+	if ((session_id == NULL) || (is_app_message == NULL)) {
+		return RETURN_UNSUPPORTED;
+	}
+	if (transport_message_size > sizeof(transport_message_buffer)) {
+		return RETURN_UNSUPPORTED;
+	}
+	copy_mem(transport_message_buffer, transport_message,
+		 transport_message_size);
+
+	message_session_id = NULL;
+	status = spdm_transport_mctp_decode_message_in_place(
+		spdm_context, &message_session_id, is_app_message,
+		is_requester, transport_message_size, transport_message_buffer,
+		&decoded_message_size, &decoded_message);
+	//
+	// The session ID is returned from the caller buffer, not from the local copy.
+	//
+	if (message_session_id != NULL) {
+		*session_id = (uint32 *)((uint8 *)transport_message +
+					 ((uint8 *)message_session_id -
+					  transport_message_buffer));
+	} else {
+		*session_id = NULL;
+	}
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	if (*message_size < decoded_message_size) {
+		*message_size = decoded_message_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	*message_size = decoded_message_size;
+	copy_mem(message, decoded_message, decoded_message_size);
+	return RETURN_SUCCESS;
+}
@@ -7,10 +7,6 @@
 #include <library/spdm_transport_pcidoe_lib.h>
 #include <industry_standard/pcidoe.h>
 
-#define PCI_DOE_ALIGNMENT 4
-#define PCI_DOE_SEQUENCE_NUMBER_COUNT 0
-#define PCI_DOE_MAX_RANDOM_NUMBER_COUNT 0
-
 /**
   Get sequence number in an SPDM secure message.
 
@@ -28,8 +24,8 @@ uint8 spdm_pci_doe_get_sequence_number(IN uint64 sequence_number,
 				       IN OUT uint8 *sequence_number_buffer)
 {
 	copy_mem(sequence_number_buffer, &sequence_number,
-		 PCI_DOE_SEQUENCE_NUMBER_COUNT);
-	return PCI_DOE_SEQUENCE_NUMBER_COUNT;
+		 SPDM_PCI_DOE_SEQUENCE_NUMBER_COUNT);
+	return SPDM_PCI_DOE_SEQUENCE_NUMBER_COUNT;
 }
 
 /**
@@ -42,103 +38,101 @@ uint8 spdm_pci_doe_get_sequence_number(IN uint64 sequence_number,
 **/
 uint32 spdm_pci_doe_get_max_random_number_count(void)
 {
-	return PCI_DOE_MAX_RANDOM_NUMBER_COUNT;
+	return SPDM_PCI_DOE_MAX_RANDOM_NUMBER_COUNT;
 }
 
 /**
-  Encode a normal message or secured message to a transport message.
+  Encode a normal message or secured message to a transport message in place.
+
+  The PCI DOE header is written in front of the message and the alignment padding behind it.
 
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If session_id is NULL, it is a normal message.
                                        If session_id is NOT NULL, it is a secured message.
   @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a source buffer to store the message.
-  @param  transport_message_size         size in bytes of the transport message data buffer.
-  @param  transport_message             A pointer to a destination buffer to store the transport message.
+  @param  message                      A pointer to the message, with room for the PCI DOE header in front of it.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the start of the transport message, in front of message.
 
   @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @retval RETURN_UNSUPPORTED           The secured message does not belong to session_id.
+  @retval RETURN_OUT_OF_RESOURCES      The message is too large for a PCI DOE data object.
 **/
-return_status pci_doe_encode_message(IN uint32 *session_id,
-				     IN uintn message_size, IN void *message,
-				     IN OUT uintn *transport_message_size,
-				     OUT void *transport_message)
+return_status pci_doe_encode_message_in_place(IN uint32 *session_id,
+					      IN uintn message_size,
+					      IN OUT void *message,
+					      OUT uintn *transport_message_size,
+					      OUT void **transport_message)
 {
 	uintn aligned_message_size;
 	uintn alignment;
+	uintn total_message_size;
 	pci_doe_data_object_header_t *pci_doe_header;
 
-	alignment = PCI_DOE_ALIGNMENT;
+	alignment = SPDM_PCI_DOE_ALIGNMENT;
 	aligned_message_size =
 		(message_size + (alignment - 1)) & ~(alignment - 1);
-
-	ASSERT(*transport_message_size >=
-	       aligned_message_size + sizeof(pci_doe_data_object_header_t));
-	if (*transport_message_size <
-	    aligned_message_size + sizeof(pci_doe_data_object_header_t)) {
-		*transport_message_size = aligned_message_size +
-					  sizeof(pci_doe_data_object_header_t);
-		return RETURN_BUFFER_TOO_SMALL;
-	}
-	*transport_message_size =
+	total_message_size =
 		aligned_message_size + sizeof(pci_doe_data_object_header_t);
-	pci_doe_header = transport_message;
-	pci_doe_header->vendor_id = PCI_DOE_VENDOR_ID_PCISIG;
+	if (total_message_size > PCI_DOE_MAX_SIZE_IN_BYTE) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
 	if (session_id != NULL) {
-		pci_doe_header->data_object_type =
-			PCI_DOE_DATA_OBJECT_TYPE_SECURED_SPDM;
 		ASSERT(*session_id == *(uint32 *)(message));
 		if (*session_id != *(uint32 *)(message)) {
 			return RETURN_UNSUPPORTED;
 		}
+	}
+
+	pci_doe_header = (void *)((uint8 *)message -
+				  sizeof(pci_doe_data_object_header_t));
+	pci_doe_header->vendor_id = PCI_DOE_VENDOR_ID_PCISIG;
+	if (session_id != NULL) {
+		pci_doe_header->data_object_type =
+			PCI_DOE_DATA_OBJECT_TYPE_SECURED_SPDM;
 	} else {
 		pci_doe_header->data_object_type =
 			PCI_DOE_DATA_OBJECT_TYPE_SPDM;
 	}
 	pci_doe_header->reserved = 0;
-	if (*transport_message_size > PCI_DOE_MAX_SIZE_IN_BYTE) {
-		return RETURN_OUT_OF_RESOURCES;
-	} else if (*transport_message_size == PCI_DOE_MAX_SIZE_IN_BYTE) {
+	if (total_message_size == PCI_DOE_MAX_SIZE_IN_BYTE) {
 		pci_doe_header->length = 0;
 	} else {
 		pci_doe_header->length =
-			(uint32)*transport_message_size / sizeof(uint32);
+			(uint32)total_message_size / sizeof(uint32);
 	}
 
-	copy_mem((uint8 *)transport_message +
-			 sizeof(pci_doe_data_object_header_t),
-		 message, message_size);
-	zero_mem((uint8 *)transport_message +
-			 sizeof(pci_doe_data_object_header_t) + message_size,
-		 *transport_message_size -
-			 sizeof(pci_doe_data_object_header_t) - message_size);
+	zero_mem((uint8 *)message + message_size,
+		 aligned_message_size - message_size);
+	*transport_message_size = total_message_size;
+	*transport_message = pci_doe_header;
 	return RETURN_SUCCESS;
 }
 
 /**
-  Decode a transport message to a normal message or secured message.
+  Decode a transport message to a normal message or secured message in place.
 
   @param  session_id                    Indicates if it is a secured message protected via SPDM session.
                                        If *session_id is NULL, it is a normal message.
                                        If *session_id is NOT NULL, it is a secured message.
   @param  transport_message_size         size in bytes of the transport message data buffer.
   @param  transport_message             A pointer to a source buffer to store the transport message.
-  @param  message_size                  size in bytes of the message data buffer.
-  @param  message                      A pointer to a destination buffer to store the message.
-  @retval RETURN_SUCCESS               The message is encoded successfully.
-  @retval RETURN_INVALID_PARAMETER     The message is NULL or the message_size is zero.
+  @param  message_size                  size in bytes of the message, including alignment padding.
+  @param  message                      A pointer to the message inside transport_message.
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
 **/
-return_status pci_doe_decode_message(OUT uint32 **session_id,
-				     IN uintn transport_message_size,
-				     IN void *transport_message,
-				     IN OUT uintn *message_size,
-				     OUT void *message)
+return_status pci_doe_decode_message_in_place(OUT uint32 **session_id,
+					      IN uintn transport_message_size,
+					      IN OUT void *transport_message,
+					      OUT uintn *message_size,
+					      OUT void **message)
 {
 	uintn alignment;
 	pci_doe_data_object_header_t *pci_doe_header;
 	uint32 length;
 
-	alignment = PCI_DOE_ALIGNMENT;
+	alignment = SPDM_PCI_DOE_ALIGNMENT;
 
 	ASSERT(transport_message_size > sizeof(pci_doe_data_object_header_t));
 	if (transport_message_size <= sizeof(pci_doe_data_object_header_t)) {
@@ -189,34 +183,9 @@ return_status pci_doe_decode_message(OUT uint32 **session_id,
 	ASSERT(((transport_message_size - sizeof(pci_doe_data_object_header_t)) &
 		(alignment - 1)) == 0);
 
-	if (*message_size <
-	    transport_message_size - sizeof(pci_doe_data_object_header_t)) {
-		//
-		// Handle special case for the side effect of alignment
-		// Caller may allocate a good enough buffer without considering alignment.
-		// Here we will not copy all the message and ignore the the last padding bytes.
-		//
-		if (*message_size + alignment - 1 >=
-		    transport_message_size -
-			    sizeof(pci_doe_data_object_header_t)) {
-			copy_mem(message,
-				 (uint8 *)transport_message +
-					 sizeof(pci_doe_data_object_header_t),
-				 *message_size);
-			return RETURN_SUCCESS;
-		}
-		ASSERT(*message_size >=
-		       transport_message_size -
-			       sizeof(pci_doe_data_object_header_t));
-		*message_size = transport_message_size -
-				sizeof(pci_doe_data_object_header_t);
-		return RETURN_BUFFER_TOO_SMALL;
-	}
 	*message_size =
 		transport_message_size - sizeof(pci_doe_data_object_header_t);
-	copy_mem(message,
-		 (uint8 *)transport_message +
-			 sizeof(pci_doe_data_object_header_t),
-		 *message_size);
+	*message = (uint8 *)transport_message +
+		   sizeof(pci_doe_data_object_header_t);
 	return RETURN_SUCCESS;
 }
@@ -43,6 +43,19 @@ void sha256_free(IN void *sha256_ctx)
 	free_pool (sha256_ctx);
 }
 
+/**
+  Retrieves the size, in bytes, of a SHA-256 context that sha256_init() can initialize
+  in caller memory, instead of one allocated by sha256_new().
+
+  @return  The size, in bytes, of the SHA-256 context,
+           or 0 if the context can only be allocated by sha256_new().
+
+**/
+uintn sha256_get_context_size(void)
+{
+	return sizeof(mbedtls_sha256_context);
+}
+
 /**
   Initializes user-supplied memory pointed by sha256_context as SHA-256 hash context for
   subsequent use.
@@ -245,6 +258,19 @@ void sha384_free(IN void *sha384_ctx)
 	free_pool (sha384_ctx);
 }
 
+/**
+  Retrieves the size, in bytes, of a SHA-384 context that sha384_init() can initialize
+  in caller memory, instead of one allocated by sha384_new().
+
+  @return  The size, in bytes, of the SHA-384 context,
+           or 0 if the context can only be allocated by sha384_new().
+
+**/
+uintn sha384_get_context_size(void)
+{
+	return sizeof(mbedtls_sha512_context);
+}
+
 /**
   Initializes user-supplied memory pointed by sha384_context as SHA-384 hash context for
   subsequent use.
@@ -449,6 +475,19 @@ void sha512_free(IN void *sha512_ctx)
 	free_pool (sha512_ctx);
 }
 
+/**
+  Retrieves the size, in bytes, of a SHA-512 context that sha512_init() can initialize
+  in caller memory, instead of one allocated by sha512_new().
+
+  @return  The size, in bytes, of the SHA-512 context,
+           or 0 if the context can only be allocated by sha512_new().
+
+**/
+uintn sha512_get_context_size(void)
+{
+	return sizeof(mbedtls_sha512_context);
+}
+
 /**
   Initializes user-supplied memory pointed by sha512_context as SHA-512 hash context for
   subsequent use.
@@ -42,6 +42,39 @@ void hmac_md_free(IN void *hmac_md_ctx)
 	free_pool (hmac_md_ctx);
 }
 
+/**
+  Sets up an HMAC-MD context for a message digest type.
+
+  A context that is already set up for md_type is kept as is, so that
+  setting a new key or duplicating into a reused context does not
+  allocate again. Otherwise the previous setup is released first.
+
+  @param[in]       md_type        message digest Type.
+  @param[in, out]  hmac_md_ctx    Pointer to HMAC-MD context.
+
+  @retval TRUE   The context is set up.
+  @retval FALSE  The context cannot be set up.
+
+**/
+static boolean hmac_md_setup(IN mbedtls_md_type_t md_type, IN OUT void *hmac_md_ctx)
+{
+	const mbedtls_md_info_t *md_info;
+	mbedtls_md_context_t *md_ctx;
+
+	md_info = mbedtls_md_info_from_type(md_type);
+	ASSERT(md_info != NULL);
+
+	md_ctx = hmac_md_ctx;
+	if (md_ctx->md_info == md_info && md_ctx->md_ctx != NULL &&
+	    md_ctx->hmac_ctx != NULL) {
+		return TRUE;
+	}
+
+	mbedtls_md_free(md_ctx);
+	mbedtls_md_init(md_ctx);
+	return mbedtls_md_setup(md_ctx, md_info, 1) == 0;
+}
+
 /**
   Set user-supplied key for subsequent use. It must be done before any
   calling to hmac_md_update().
@@ -60,21 +93,13 @@ void hmac_md_free(IN void *hmac_md_ctx)
 boolean hmac_md_set_key(IN mbedtls_md_type_t md_type, OUT void *hmac_md_ctx,
 			IN const uint8 *key, IN uintn key_size)
 {
-	const mbedtls_md_info_t *md_info;
 	int32 ret;
 
 	if (hmac_md_ctx == NULL || key_size > INT_MAX) {
 		return FALSE;
 	}
 
-	zero_mem(hmac_md_ctx, sizeof(mbedtls_md_context_t));
-	mbedtls_md_init(hmac_md_ctx);
-
-	md_info = mbedtls_md_info_from_type(md_type);
-	ASSERT(md_info != NULL);
-
-	ret = mbedtls_md_setup(hmac_md_ctx, md_info, 1);
-	if (ret != 0) {
+	if (!hmac_md_setup(md_type, hmac_md_ctx)) {
 		return FALSE;
 	}
 
@@ -126,20 +151,12 @@ int hmac_md_get_blocksize( mbedtls_md_type_t md_type )
 boolean hmac_md_duplicate(IN mbedtls_md_type_t md_type, IN const void *hmac_md_ctx, OUT void *new_hmac_md_ctx)
 {
 	int32 ret;
-	const mbedtls_md_info_t *md_info;
 
 	if (hmac_md_ctx == NULL || new_hmac_md_ctx == NULL) {
 		return FALSE;
 	}
 
-	zero_mem(new_hmac_md_ctx, sizeof(mbedtls_md_context_t));
-	mbedtls_md_init(new_hmac_md_ctx);
-
-	md_info = mbedtls_md_info_from_type(md_type);
-	ASSERT(md_info != NULL);
-
-	ret = mbedtls_md_setup(new_hmac_md_ctx, md_info, 1);
-	if (ret != 0) {
+	if (!hmac_md_setup(md_type, new_hmac_md_ctx)) {
 		return FALSE;
 	}
 	ret = mbedtls_md_clone(new_hmac_md_ctx, hmac_md_ctx);
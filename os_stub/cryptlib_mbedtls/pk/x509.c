@@ -208,37 +208,79 @@ boolean x509_get_subject_name(IN const uint8 *cert, IN uintn cert_size,
 			      OUT uint8 *cert_subject,
 			      IN OUT uintn *subject_size)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
-	boolean status;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL) {
 		return FALSE;
 	}
 
-	status = FALSE;
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
+		goto done;
+	}
 
-	mbedtls_x509_crt_init(&crt);
+	res = x509_object_get_subject_name(x509_cert, cert_subject,
+					   subject_size);
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
 
-	if (ret == 0) {
-		if (*subject_size < crt.subject_raw.len) {
-			*subject_size = crt.subject_raw.len;
-			status = FALSE;
-			goto cleanup;
-		}
-		if (cert_subject != NULL) {
-			copy_mem(cert_subject, crt.subject_raw.p, crt.subject_raw.len);
-		}
-		*subject_size = crt.subject_raw.len;
-		status = TRUE;
+	return res;
+}
+
+/**
+  Retrieve the subject bytes from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     cert_subject  Pointer to the retrieved certificate subject bytes.
+  @param[in, out] subject_size  The size in bytes of the cert_subject buffer on input,
+                               and the size of buffer returned cert_subject on output.
+
+  If x509_cert is NULL, then return FALSE.
+  If subject_size is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @retval  TRUE   The certificate subject retrieved successfully.
+  @retval  FALSE  Invalid certificate, or the subject_size is too small for the result.
+                  The subject_size will be updated with the required size.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_get_subject_name(IN void *x509_cert,
+				     OUT uint8 *cert_subject,
+				     IN OUT uintn *subject_size)
+{
+	mbedtls_x509_crt *crt;
+
+	if (x509_cert == NULL || subject_size == NULL) {
+		return FALSE;
 	}
 
-cleanup:
-	mbedtls_x509_crt_free(&crt);
+	crt = x509_cert;
+	if (*subject_size < crt->subject_raw.len) {
+		*subject_size = crt->subject_raw.len;
+		return FALSE;
+	}
+	if (cert_subject != NULL) {
+		copy_mem(cert_subject, crt->subject_raw.p, crt->subject_raw.len);
+	}
+	*subject_size = crt->subject_raw.len;
 
-	return status;
+	return TRUE;
 }
 
 return_status
@@ -419,33 +461,77 @@ x509_get_organization_name(IN const uint8 *cert, IN uintn cert_size,
 boolean rsa_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 				     OUT void **rsa_context)
 {
-	mbedtls_x509_crt crt;
+	boolean res;
+	void *x509_cert;
+
+	//
+	// Check input parameters.
+	//
+	if (cert == NULL || rsa_context == NULL) {
+		return FALSE;
+	}
+
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
+		goto done;
+	}
+
+	res = rsa_get_public_key_from_x509_object(x509_cert, rsa_context);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the RSA public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] rsa_context   Pointer to new-generated RSA context which contain the retrieved
+                           RSA public key component. Use rsa_free() function to free the
+                           resource.
+
+  @retval  TRUE   RSA public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve RSA public key from X509 object.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean rsa_get_public_key_from_x509_object(IN void *x509_cert,
+					    OUT void **rsa_context)
+{
+	mbedtls_x509_crt *crt;
 	mbedtls_rsa_context *rsa;
 	int32 ret;
 
-	mbedtls_x509_crt_init(&crt);
-
-	if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) != 0) {
+	if (x509_cert == NULL || rsa_context == NULL) {
 		return FALSE;
 	}
 
-	if (mbedtls_pk_get_type(&crt.pk) != MBEDTLS_PK_RSA) {
-		mbedtls_x509_crt_free(&crt);
+	crt = x509_cert;
+	if (mbedtls_pk_get_type(&crt->pk) != MBEDTLS_PK_RSA) {
 		return FALSE;
 	}
 
 	rsa = rsa_new();
 	if (rsa == NULL) {
-		mbedtls_x509_crt_free(&crt);
 		return FALSE;
 	}
-	ret = mbedtls_rsa_copy(rsa, mbedtls_pk_rsa(crt.pk));
+	ret = mbedtls_rsa_copy(rsa, mbedtls_pk_rsa(crt->pk));
 	if (ret != 0) {
 		rsa_free(rsa);
-		mbedtls_x509_crt_free(&crt);
 		return FALSE;
 	}
-	mbedtls_x509_crt_free(&crt);
 
 	*rsa_context = rsa;
 	return TRUE;
@@ -470,37 +556,80 @@ boolean rsa_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 boolean ec_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 				    OUT void **ec_context)
 {
-	mbedtls_x509_crt crt;
+	boolean res;
+	void *x509_cert;
+
+	//
+	// Check input parameters.
+	//
+	if (cert == NULL || ec_context == NULL) {
+		return FALSE;
+	}
+
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
+		goto done;
+	}
+
+	res = ec_get_public_key_from_x509_object(x509_cert, ec_context);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the EC public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] ec_context    Pointer to new-generated EC DSA context which contain the retrieved
+                           EC public key component. Use ec_free() function to free the
+                           resource.
+
+  @retval  TRUE   EC public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve EC public key from X509 object.
+
+**/
+boolean ec_get_public_key_from_x509_object(IN void *x509_cert,
+					   OUT void **ec_context)
+{
+	mbedtls_x509_crt *crt;
 	mbedtls_ecdh_context *ecdh;
 	int32 ret;
 
-	mbedtls_x509_crt_init(&crt);
-
-	if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) != 0) {
+	if (x509_cert == NULL || ec_context == NULL) {
 		return FALSE;
 	}
 
-	if (mbedtls_pk_get_type(&crt.pk) != MBEDTLS_PK_ECKEY) {
-		mbedtls_x509_crt_free(&crt);
+	crt = x509_cert;
+	if (mbedtls_pk_get_type(&crt->pk) != MBEDTLS_PK_ECKEY) {
 		return FALSE;
 	}
 
 	ecdh = allocate_zero_pool(sizeof(mbedtls_ecdh_context));
 	if (ecdh == NULL) {
-		mbedtls_x509_crt_free(&crt);
 		return FALSE;
 	}
 	mbedtls_ecdh_init(ecdh);
 
-	ret = mbedtls_ecdh_get_params(ecdh, mbedtls_pk_ec(crt.pk),
+	ret = mbedtls_ecdh_get_params(ecdh, mbedtls_pk_ec(crt->pk),
 				      MBEDTLS_ECDH_OURS);
 	if (ret != 0) {
 		mbedtls_ecdh_free(ecdh);
 		free_pool(ecdh);
-		mbedtls_x509_crt_free(&crt);
 		return FALSE;
 	}
-	mbedtls_x509_crt_free(&crt);
 
 	*ec_context = ecdh;
 	return TRUE;
@@ -528,6 +657,24 @@ boolean ecd_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 	return FALSE;
 }
 
+/**
+  Retrieve the Ed public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] ecd_context    Pointer to new-generated Ed DSA context which contain the retrieved
+                           Ed public key component. Use ecd_free() function to free the
+                           resource.
+
+  @retval  TRUE   Ed public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve Ed public key from X509 object.
+
+**/
+boolean ecd_get_public_key_from_x509_object(IN void *x509_cert,
+					    OUT void **ecd_context)
+{
+	return FALSE;
+}
+
 /**
   Retrieve the sm2 public key from one DER-encoded X509 certificate.
 
@@ -550,6 +697,24 @@ boolean sm2_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 	return FALSE;
 }
 
+/**
+  Retrieve the sm2 public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] sm2_context   Pointer to new-generated sm2 context which contain the retrieved
+                           sm2 public key component. Use sm2_free() function to free the
+                           resource.
+
+  @retval  TRUE   sm2 public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve sm2 public key from X509 object.
+
+**/
+boolean sm2_get_public_key_from_x509_object(IN void *x509_cert,
+					     OUT void **sm2_context)
+{
+	return FALSE;
+}
+
 /**
   Verify one X509 certificate was issued by the trusted CA.
 
@@ -569,34 +734,62 @@ boolean sm2_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 boolean x509_verify_cert(IN const uint8 *cert, IN uintn cert_size,
 			 IN const uint8 *ca_cert, IN uintn ca_cert_size)
 {
-	int32 ret;
-	mbedtls_x509_crt ca, end;
-	uint32 v_flag = 0;
-	mbedtls_x509_crt_profile profile = { 0 };
+	boolean res;
+	void *x509_cert;
+	void *x509_ca_cert;
 
 	if (cert == NULL || ca_cert == NULL) {
 		return FALSE;
 	}
 
-	copy_mem(&profile, &mbedtls_x509_crt_profile_default,
-		 sizeof(mbedtls_x509_crt_profile));
-
-	mbedtls_x509_crt_init(&ca);
-	mbedtls_x509_crt_init(&end);
+	x509_cert = NULL;
+	x509_ca_cert = NULL;
 
-	ret = mbedtls_x509_crt_parse_der(&ca, ca_cert, ca_cert_size);
+	res = x509_construct_certificate(ca_cert, ca_cert_size,
+					 (uint8 **)&x509_ca_cert);
+	if (res) {
+		res = x509_construct_certificate(cert, cert_size,
+						 (uint8 **)&x509_cert);
+	}
 
-	if (ret == 0) {
-		ret = mbedtls_x509_crt_parse_der(&end, cert, cert_size);
+	if (res) {
+		res = x509_object_verify_cert(x509_cert, x509_ca_cert);
 	}
 
-	if (ret == 0) {
-		ret = mbedtls_x509_crt_verify_with_profile(
-			&end, &ca, NULL, &profile, NULL, &v_flag, NULL, NULL);
+	x509_free(x509_ca_cert);
+	x509_free(x509_cert);
+
+	return res;
+}
+
+/**
+  Verify one X509 object was issued by the trusted CA X509 object.
+
+  @param[in]      x509_cert     The X509 object of the certificate to be verified.
+  @param[in]      ca_x509_cert  The X509 object of the trusted CA certificate.
+
+  @retval  TRUE   The certificate was issued by the trusted CA.
+  @retval  FALSE  Invalid certificate or the certificate was not issued by the given
+                  trusted CA.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_verify_cert(IN void *x509_cert, IN void *ca_x509_cert)
+{
+	int32 ret;
+	uint32 v_flag = 0;
+	mbedtls_x509_crt_profile profile = { 0 };
+
+	if (x509_cert == NULL || ca_x509_cert == NULL) {
+		return FALSE;
 	}
 
-	mbedtls_x509_crt_free(&ca);
-	mbedtls_x509_crt_free(&end);
+	copy_mem(&profile, &mbedtls_x509_crt_profile_default,
+		 sizeof(mbedtls_x509_crt_profile));
+
+	ret = mbedtls_x509_crt_verify_with_profile(x509_cert, ca_x509_cert,
+						   NULL, &profile, NULL,
+						   &v_flag, NULL, NULL);
 
 	return ret == 0;
 }
@@ -623,8 +816,8 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 			       IN uint8 *cert_chain, IN uintn cert_chain_length)
 {
 	uintn asn1_len;
-	uintn preceding_cert_len;
-	uint8 *preceding_cert;
+	void *preceding_x509_cert;
+	void *current_x509_cert;
 	uintn current_cert_len;
 	uint8 *current_cert;
 	uint8 *tmp_ptr;
@@ -632,8 +825,17 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 	boolean verify_flag;
 
 	verify_flag = FALSE;
-	preceding_cert = root_cert;
-	preceding_cert_len = root_cert_length;
+
+	//
+	// Each certificate is decoded once and kept as the preceding X509 object
+	// for the verification of the next one.
+	//
+	preceding_x509_cert = NULL;
+	if (!x509_construct_certificate(root_cert, root_cert_length,
+					(uint8 **)&preceding_x509_cert)) {
+		x509_free(preceding_x509_cert);
+		return FALSE;
+	}
 
 	current_cert = cert_chain;
 
@@ -651,20 +853,23 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 
 		current_cert_len = asn1_len + (tmp_ptr - current_cert);
 
-		if (x509_verify_cert(current_cert, current_cert_len,
-				     preceding_cert,
-				     preceding_cert_len) == FALSE) {
-			verify_flag = FALSE;
-			break;
-		} else {
-			verify_flag = TRUE;
+		current_x509_cert = NULL;
+		verify_flag = x509_construct_certificate(
+			current_cert, current_cert_len,
+			(uint8 **)&current_x509_cert);
+		if (verify_flag) {
+			verify_flag = x509_object_verify_cert(
+				current_x509_cert, preceding_x509_cert);
 		}
 
 		//
 		// Save preceding certificate
 		//
-		preceding_cert = current_cert;
-		preceding_cert_len = current_cert_len;
+		x509_free(preceding_x509_cert);
+		preceding_x509_cert = current_x509_cert;
+		if (verify_flag == FALSE) {
+			break;
+		}
 
 		//
 		// Move current certificate to next;
@@ -672,6 +877,8 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 		current_cert = current_cert + current_cert_len;
 	} while (TRUE);
 
+	x509_free(preceding_x509_cert);
+
 	return verify_flag;
 }
 
@@ -799,28 +1006,63 @@ boolean x509_get_tbs_cert(IN const uint8 *cert, IN uintn cert_size,
 return_status x509_get_version(IN const uint8 *cert, IN uintn cert_size,
 			       OUT uintn *version)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
 	return_status status;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	status = RETURN_INVALID_PARAMETER;
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		status = RETURN_INVALID_PARAMETER;
+		goto done;
+	}
 
-	mbedtls_x509_crt_init(&crt);
+	status = x509_object_get_version(x509_cert, version);
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
 
-	if (ret == 0) {
-		*version = crt.version - 1;
-		status = RETURN_SUCCESS;
+	return status;
+}
+
+/**
+  Retrieve the version from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     version      Pointer to the retrieved version integer.
+
+  @retval RETURN_SUCCESS           The certificate version retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert or version is NULL.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+
+**/
+return_status x509_object_get_version(IN void *x509_cert, OUT uintn *version)
+{
+	mbedtls_x509_crt *crt;
+
+	if (x509_cert == NULL || version == NULL) {
+		return RETURN_INVALID_PARAMETER;
 	}
 
-	mbedtls_x509_crt_free(&crt);
+	crt = x509_cert;
+	*version = crt->version - 1;
 
-	return status;
+	return RETURN_SUCCESS;
 }
 
 /**
@@ -850,39 +1092,82 @@ return_status x509_get_serial_number(IN const uint8 *cert, IN uintn cert_size,
 				     OUT uint8 *serial_number,
 				     OPTIONAL IN OUT uintn *serial_number_size)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
 	return_status status;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	status = RETURN_INVALID_PARAMETER;
-
-	mbedtls_x509_crt_init(&crt);
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		status = RETURN_INVALID_PARAMETER;
+		goto done;
+	}
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+	status = x509_object_get_serial_number(x509_cert, serial_number,
+					       serial_number_size);
 
-	if (ret == 0) {
-		if (*serial_number_size <= crt.serial.len) {
-			*serial_number_size = crt.serial.len + 1;
-			status = RETURN_BUFFER_TOO_SMALL;
-			goto cleanup;
-		}
-		if (serial_number != NULL) {
-			copy_mem(serial_number, crt.serial.p, crt.serial.len);
-			serial_number[crt.serial.len] = '\0';
-		}
-		*serial_number_size = crt.serial.len + 1;
-		status = RETURN_SUCCESS;
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
 	}
-cleanup:
-	mbedtls_x509_crt_free(&crt);
 
 	return status;
 }
 
+/**
+  Retrieve the serialNumber from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     serial_number  Pointer to the retrieved certificate serial_number bytes.
+  @param[in, out] serial_number_size  The size in bytes of the serial_number buffer on input,
+                               and the size of buffer returned serial_number on output.
+
+  @retval RETURN_SUCCESS           The certificate serialNumber retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If serial_number_size is NULL.
+  @retval RETURN_NOT_FOUND         If no serial_number exists.
+  @retval RETURN_BUFFER_TOO_SMALL  If the serial_number is NULL. The required buffer size
+                                   (including the final null) is returned in the
+                                   serial_number_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status
+x509_object_get_serial_number(IN void *x509_cert, OUT uint8 *serial_number,
+			      OPTIONAL IN OUT uintn *serial_number_size)
+{
+	mbedtls_x509_crt *crt;
+
+	if (x509_cert == NULL || serial_number_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	crt = x509_cert;
+	if (*serial_number_size <= crt->serial.len) {
+		*serial_number_size = crt->serial.len + 1;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	if (serial_number != NULL) {
+		copy_mem(serial_number, crt->serial.p, crt->serial.len);
+		serial_number[crt->serial.len] = '\0';
+	}
+	*serial_number_size = crt->serial.len + 1;
+
+	return RETURN_SUCCESS;
+}
+
 /**
   Retrieve the issuer bytes from one X.509 certificate.
 
@@ -906,37 +1191,79 @@ boolean x509_get_issuer_name(IN const uint8 *cert, IN uintn cert_size,
 			     OUT uint8 *cert_issuer,
 			     IN OUT uintn *issuer_size)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
-	boolean status;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL) {
 		return FALSE;
 	}
 
-	status = FALSE;
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
+		goto done;
+	}
 
-	mbedtls_x509_crt_init(&crt);
+	res = x509_object_get_issuer_name(x509_cert, cert_issuer,
+					  issuer_size);
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
 
-	if (ret == 0) {
-		if (*issuer_size < crt.issuer_raw.len) {
-			*issuer_size = crt.issuer_raw.len;
-			status = FALSE;
-			goto cleanup;
-		}
-		if (cert_issuer != NULL) {
-			copy_mem(cert_issuer, crt.issuer_raw.p, crt.issuer_raw.len);
-		}
-		*issuer_size = crt.issuer_raw.len;
-		status = TRUE;
+	return res;
+}
+
+/**
+  Retrieve the issuer bytes from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     cert_issuer  Pointer to the retrieved certificate issuer bytes.
+  @param[in, out] issuer_size  The size in bytes of the cert_issuer buffer on input,
+                               and the size of buffer returned cert_issuer on output.
+
+  If x509_cert is NULL, then return FALSE.
+  If issuer_size is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @retval  TRUE   The certificate issuer retrieved successfully.
+  @retval  FALSE  Invalid certificate, or the issuer_size is too small for the result.
+                  The issuer_size will be updated with the required size.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_get_issuer_name(IN void *x509_cert,
+				    OUT uint8 *cert_issuer,
+				    IN OUT uintn *issuer_size)
+{
+	mbedtls_x509_crt *crt;
+
+	if (x509_cert == NULL || issuer_size == NULL) {
+		return FALSE;
 	}
 
-cleanup:
-	mbedtls_x509_crt_free(&crt);
+	crt = x509_cert;
+	if (*issuer_size < crt->issuer_raw.len) {
+		*issuer_size = crt->issuer_raw.len;
+		return FALSE;
+	}
+	if (cert_issuer != NULL) {
+		copy_mem(cert_issuer, crt->issuer_raw.p, crt->issuer_raw.len);
+	}
+	*issuer_size = crt->issuer_raw.len;
 
-	return status;
+	return TRUE;
 }
 
 /**
@@ -1034,37 +1361,76 @@ return_status x509_get_signature_algorithm(IN const uint8 *cert,
 					   IN uintn cert_size, OUT uint8 *oid,
 					   OPTIONAL IN OUT uintn *oid_size)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
 	return_status status;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL || cert_size == 0 || oid_size == NULL) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	status = RETURN_INVALID_PARAMETER;
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		status = RETURN_INVALID_PARAMETER;
+		goto done;
+	}
 
-	mbedtls_x509_crt_init(&crt);
+	status = x509_object_get_signature_algorithm(x509_cert, oid, oid_size);
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
 
-	if (ret == 0) {
-		if (*oid_size < crt.sig_oid.len) {
-			*oid_size = crt.serial.len;
-			status = RETURN_BUFFER_TOO_SMALL;
-			goto cleanup;
-		}
-		if (oid != NULL) {
-			copy_mem(oid, crt.sig_oid.p, crt.sig_oid.len);
-		}
-		*oid_size = crt.sig_oid.len;
-		status = RETURN_SUCCESS;
+	return status;
+}
+
+/**
+  Retrieve the signature algorithm from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     oid              signature algorithm Object identifier buffer.
+  @param[in,out]  oid_size          signature algorithm Object identifier buffer size
+
+  @retval RETURN_SUCCESS           The certificate signature algorithm retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If oid_size is NULL.
+  @retval RETURN_NOT_FOUND         If no SignatureType.
+  @retval RETURN_BUFFER_TOO_SMALL  If the oid is NULL. The required buffer size
+                                   is returned in the oid_size.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_signature_algorithm(IN void *x509_cert,
+						  OUT uint8 *oid,
+						  OPTIONAL IN OUT uintn *oid_size)
+{
+	mbedtls_x509_crt *crt;
+
+	if (x509_cert == NULL || oid_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
 	}
 
-cleanup:
-	mbedtls_x509_crt_free(&crt);
+	crt = x509_cert;
+	if (*oid_size < crt->sig_oid.len) {
+		*oid_size = crt->sig_oid.len;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	if (oid != NULL) {
+		copy_mem(oid, crt->sig_oid.p, crt->sig_oid.len);
+	}
+	*oid_size = crt->sig_oid.len;
 
-	return status;
+	return RETURN_SUCCESS;
 }
 
 /**
@@ -1172,31 +1538,85 @@ return_status x509_get_extension_data(IN const uint8 *cert, IN uintn cert_size,
 				      OUT uint8 *extension_data,
 				      IN OUT uintn *extension_data_size)
 {
-	mbedtls_x509_crt crt;
+	return_status status;
+	boolean res;
+	void *x509_cert;
+
+	//
+	// Check input parameters.
+	//
+	if (cert == NULL || cert_size == 0 || oid == NULL || oid_size == 0 ||
+	    extension_data_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		status = RETURN_INVALID_PARAMETER;
+		goto done;
+	}
+
+	status = x509_object_get_extension_data(x509_cert, oid, oid_size,
+						extension_data,
+						extension_data_size);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return status;
+}
+
+/**
+  Retrieve Extension data from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[in]      oid              Object identifier buffer
+  @param[in]      oid_size          Object identifier buffer size
+  @param[out]     extension_data    Extension bytes.
+  @param[in, out] extension_data_size Extension bytes size.
+
+  @retval RETURN_SUCCESS           The certificate Extension data retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If extension_data_size is NULL.
+  @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+  @retval RETURN_BUFFER_TOO_SMALL  If the extension_data is NULL. The required buffer size
+                                   is returned in the extension_data_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_extension_data(IN void *x509_cert,
+					     IN uint8 *oid, IN uintn oid_size,
+					     OUT uint8 *extension_data,
+					     IN OUT uintn *extension_data_size)
+{
+	mbedtls_x509_crt *crt;
 	int32 ret;
 	return_status status;
 	uint8 *ptr;
 	uint8 *end;
 	size_t obj_len;
 
-	if (cert == NULL || cert_size == 0 || oid == NULL || oid_size == 0 ||
+	if (x509_cert == NULL || oid == NULL || oid_size == 0 ||
 	    extension_data_size == NULL) {
 		return RETURN_INVALID_PARAMETER;
 	}
 
+	crt = x509_cert;
 	status = RETURN_INVALID_PARAMETER;
 
-	mbedtls_x509_crt_init(&crt);
-
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-	if (ret == 0) {
-		ptr = crt.v3_ext.p;
-		end = crt.v3_ext.p + crt.v3_ext.len;
-		ret = mbedtls_asn1_get_tag(&ptr, end, &obj_len,
-					   MBEDTLS_ASN1_CONSTRUCTED |
-						   MBEDTLS_ASN1_SEQUENCE);
-	}
+	ptr = crt->v3_ext.p;
+	end = crt->v3_ext.p + crt->v3_ext.len;
+	ret = mbedtls_asn1_get_tag(&ptr, end, &obj_len,
+				   MBEDTLS_ASN1_CONSTRUCTED |
+					   MBEDTLS_ASN1_SEQUENCE);
 
 	if (ret == 0) {
 		status = internal_x509_find_extension_data(
@@ -1206,19 +1626,14 @@ return_status x509_get_extension_data(IN const uint8 *cert, IN uintn cert_size,
 	if (status == RETURN_SUCCESS) {
 		if (*extension_data_size < obj_len) {
 			*extension_data_size = obj_len;
-			status = RETURN_BUFFER_TOO_SMALL;
-			goto cleanup;
+			return RETURN_BUFFER_TOO_SMALL;
 		}
-		if (oid != NULL) {
+		if (extension_data != NULL) {
 			copy_mem(extension_data, ptr, obj_len);
 		}
 		*extension_data_size = obj_len;
-		status = RETURN_SUCCESS;
 	}
 
-cleanup:
-	mbedtls_x509_crt_free(&crt);
-
 	return status;
 }
 
@@ -1247,50 +1662,87 @@ boolean x509_get_validity(IN const uint8 *cert, IN uintn cert_size,
 			  IN uint8 *from, IN OUT uintn *from_size, IN uint8 *to,
 			  IN OUT uintn *to_size)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
-	boolean status;
-	uintn t_size;
-	uintn f_size;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL) {
 		return FALSE;
 	}
 
-	status = FALSE;
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
+		goto done;
+	}
 
-	mbedtls_x509_crt_init(&crt);
+	res = x509_object_get_validity(x509_cert, from, from_size, to,
+				       to_size);
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
 
-	if (ret == 0) {
-		f_size = sizeof(mbedtls_x509_time);
-		if (*from_size < f_size) {
-			*from_size = f_size;
-			goto done;
-		}
+	return res;
+}
+
+/**
+  Retrieve the Validity from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     from         notBefore Pointer to date_time object.
+  @param[in,out]  from_size     notBefore date_time object size.
+  @param[out]     to           notAfter Pointer to date_time object.
+  @param[in,out]  to_size       notAfter date_time object size.
+
+  @retval  TRUE   The certificate Validity retrieved successfully.
+  @retval  FALSE  Invalid certificate, or Validity retrieve failed.
+  @retval  FALSE  This interface is not supported.
+**/
+boolean x509_object_get_validity(IN void *x509_cert, IN uint8 *from,
+				 IN OUT uintn *from_size, IN uint8 *to,
+				 IN OUT uintn *to_size)
+{
+	mbedtls_x509_crt *crt;
+	uintn t_size;
+	uintn f_size;
+
+	if (x509_cert == NULL || from_size == NULL || to_size == NULL) {
+		return FALSE;
+	}
+
+	crt = x509_cert;
+	f_size = sizeof(mbedtls_x509_time);
+	if (*from_size < f_size) {
 		*from_size = f_size;
-		if (from != NULL) {
-			copy_mem(from, &(crt.valid_from), f_size);
-		}
+		return FALSE;
+	}
+	*from_size = f_size;
+	if (from != NULL) {
+		copy_mem(from, &(crt->valid_from), f_size);
+	}
 
-		t_size = sizeof(mbedtls_x509_time);
-		if (*to_size < t_size) {
-			*to_size = t_size;
-			goto done;
-		}
+	t_size = sizeof(mbedtls_x509_time);
+	if (*to_size < t_size) {
 		*to_size = t_size;
-		if (to != NULL) {
-			copy_mem(to, &(crt.valid_to),
-				 sizeof(mbedtls_x509_time));
-		}
-		status = TRUE;
+		return FALSE;
+	}
+	*to_size = t_size;
+	if (to != NULL) {
+		copy_mem(to, &(crt->valid_to), sizeof(mbedtls_x509_time));
 	}
 
-done:
-	mbedtls_x509_crt_free(&crt);
-
-	return status;
+	return TRUE;
 }
 
 /**
@@ -1307,27 +1759,61 @@ done:
 boolean x509_get_key_usage(IN const uint8 *cert, IN uintn cert_size,
 			   OUT uintn *usage)
 {
-	mbedtls_x509_crt crt;
-	int32 ret;
-	boolean status;
+	boolean res;
+	void *x509_cert;
 
+	//
+	// Check input parameters.
+	//
 	if (cert == NULL) {
 		return FALSE;
 	}
 
-	status = FALSE;
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
+	x509_cert = NULL;
+	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
+	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
+		goto done;
+	}
 
-	mbedtls_x509_crt_init(&crt);
+	res = x509_object_get_key_usage(x509_cert, usage);
 
-	ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
 
-	if (ret == 0) {
-		*usage = crt.key_usage;
-		status = TRUE;
+	return res;
+}
+
+/**
+  Retrieve the key usage from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     usage            key usage (CRYPTO_X509_KU_*)
+
+  @retval  TRUE   The certificate key usage retrieved successfully.
+  @retval  FALSE  Invalid certificate, or usage is NULL
+  @retval  FALSE  This interface is not supported.
+**/
+boolean x509_object_get_key_usage(IN void *x509_cert, OUT uintn *usage)
+{
+	mbedtls_x509_crt *crt;
+
+	if (x509_cert == NULL || usage == NULL) {
+		return FALSE;
 	}
-	mbedtls_x509_crt_free(&crt);
 
-	return status;
+	crt = x509_cert;
+	*usage = crt->key_usage;
+
+	return TRUE;
 }
 
 /**
@@ -1365,6 +1851,34 @@ return_status x509_get_extended_key_usage(IN const uint8 *cert,
 	return status;
 }
 
+/**
+  Retrieve the Extended key usage from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     usage            key usage bytes.
+  @param[in, out] usage_size        key usage buffer sizs in bytes.
+
+  @retval RETURN_SUCCESS           The usage bytes retrieve successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If usage_size is NULL.
+  @retval RETURN_BUFFER_TOO_SMALL  If the usage is NULL. The required buffer size
+                                   is returned in the usage_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_extended_key_usage(IN void *x509_cert,
+						 OUT uint8 *usage,
+						 IN OUT uintn *usage_size)
+{
+	if (x509_cert == NULL || usage_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	return x509_object_get_extension_data(x509_cert,
+					      (uint8 *)m_oid_ext_key_usage,
+					      sizeof(m_oid_ext_key_usage), usage,
+					      usage_size);
+}
+
 /**
   Return 0 if before <= after, 1 otherwise
 **/
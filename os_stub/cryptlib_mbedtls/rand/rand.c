@@ -47,29 +47,12 @@ boolean random_seed(IN const uint8 *seed OPTIONAL, IN uintn seed_size)
 **/
 boolean random_bytes(OUT uint8 *output, IN uintn size)
 {
-	boolean ret;
-	uint64 temp_rand;
-
-	ret = FALSE;
-
-	while (size > 0) {
-		// Use rnglib to get random number
-		ret = get_random_number_64(&temp_rand);
-
-		if (!ret) {
-			return ret;
-		}
-		if (size >= sizeof(temp_rand)) {
-			*((uint64 *)output) = temp_rand;
-			output += sizeof(uint64);
-			size -= sizeof(temp_rand);
-		} else {
-			copy_mem(output, &temp_rand, size);
-			size = 0;
-		}
+	if (output == NULL) {
+		return FALSE;
 	}
 
-	return ret;
+	// Use rnglib to get random bytes
+	return get_random_bytes(output, size);
 }
 
 int myrand(void *rng_state, unsigned char *output, size_t len)
@@ -79,3 +79,107 @@ boolean aead_sm4_gcm_decrypt(IN const uint8 *key, IN uintn key_size,
 {
 	return FALSE;
 }
+
+/**
+  Allocates and initializes one AEAD SM4-GCM context for subsequent keyed use.
+
+  @return  Pointer to the AEAD SM4-GCM context that has been initialized.
+           If the allocations fails, aead_sm4_gcm_new() returns NULL.
+
+**/
+void *aead_sm4_gcm_new(void)
+{
+	return NULL;
+}
+
+/**
+  Release the specified AEAD SM4-GCM context.
+
+  @param[in]  aead_ctx  Pointer to the AEAD SM4-GCM context to be released.
+
+**/
+void aead_sm4_gcm_free(IN void *aead_ctx)
+{
+}
+
+/**
+  Set the encryption key of an AEAD SM4-GCM context. The key schedule is expanded
+  once here and reused by every subsequent aead_sm4_gcm_seal() and aead_sm4_gcm_open()
+  call, until the next aead_sm4_gcm_set_key().
+
+  key_size must be 16, otherwise FALSE is returned.
+
+  @param[in, out]  aead_ctx   Pointer to the AEAD SM4-GCM context.
+  @param[in]       key        Pointer to the encryption key.
+  @param[in]       key_size    size of the encryption key in bytes.
+
+  @retval TRUE   The key is set successfully.
+  @retval FALSE  The key is set unsuccessfully.
+
+**/
+boolean aead_sm4_gcm_set_key(IN OUT void *aead_ctx, IN const uint8 *key,
+			     IN uintn key_size)
+{
+	return FALSE;
+}
+
+/**
+  Performs AEAD SM4-GCM authenticated encryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD SM4-GCM context keyed by aead_sm4_gcm_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be encrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[out]  tag_out      Pointer to a buffer that receives the authentication tag output.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the encryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD SM4-GCM authenticated encryption succeeded.
+  @retval FALSE  AEAD SM4-GCM authenticated encryption failed.
+
+**/
+boolean aead_sm4_gcm_seal(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	return FALSE;
+}
+
+/**
+  Performs AEAD SM4-GCM authenticated decryption with a keyed context.
+
+  iv_size must be 12, otherwise FALSE is returned.
+  tag_size must be 16, otherwise FALSE is returned.
+  If additional authenticated data verification fails, FALSE is returned.
+
+  @param[in]   aead_ctx     Pointer to the AEAD SM4-GCM context keyed by aead_sm4_gcm_set_key().
+  @param[in]   iv          Pointer to the IV value.
+  @param[in]   iv_size      size of the IV value in bytes.
+  @param[in]   a_data       Pointer to the additional authenticated data (AAD).
+  @param[in]   a_data_size   size of the additional authenticated data (AAD) in bytes.
+  @param[in]   data_in      Pointer to the input data buffer to be decrypted.
+  @param[in]   data_in_size  size of the input data buffer in bytes.
+  @param[in]   tag         Pointer to a buffer that contains the authentication tag.
+  @param[in]   tag_size     size of the authentication tag in bytes.
+  @param[out]  data_out     Pointer to a buffer that receives the decryption output.
+  @param[out]  data_out_size size of the output data buffer in bytes.
+
+  @retval TRUE   AEAD SM4-GCM authenticated decryption succeeded.
+  @retval FALSE  AEAD SM4-GCM authenticated decryption failed.
+
+**/
+boolean aead_sm4_gcm_open(IN void *aead_ctx, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size)
+{
+	return FALSE;
+}
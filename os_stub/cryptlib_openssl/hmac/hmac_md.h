@@ -0,0 +1,28 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Internal HMAC-MD helpers shared by the HMAC and HKDF wrappers.
+**/
+
+#ifndef __HMAC_MD_H__
+#define __HMAC_MD_H__
+
+#include <openssl/evp.h>
+
+void *hmac_md_new(void);
+void hmac_md_free(IN void *hmac_md_ctx);
+boolean hmac_md_set_key(IN const EVP_MD *md, OUT void *hmac_md_ctx,
+			IN const uint8 *key, IN uintn key_size);
+boolean hmac_md_duplicate(IN const void *hmac_md_ctx, OUT void *new_hmac_md_ctx);
+boolean hmac_md_update(IN OUT void *hmac_md_ctx, IN const void *data,
+		       IN uintn data_size);
+boolean hmac_md_final(IN OUT void *hmac_md_ctx, OUT uint8 *hmac_value);
+boolean hmac_md_all(IN const EVP_MD *md, IN const void *data,
+		    IN uintn data_size, IN const uint8 *key, IN uintn key_size,
+		    OUT uint8 *hmac_value);
+
+#endif
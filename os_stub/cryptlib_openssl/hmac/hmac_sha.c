@@ -10,6 +10,7 @@
 
 #include "internal_crypt_lib.h"
 #include <openssl/hmac.h>
+#include "hmac/hmac_md.h"
 
 /**
   Allocates and initializes one HMAC_CTX context for subsequent HMAC-MD use.
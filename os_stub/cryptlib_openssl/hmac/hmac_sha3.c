@@ -10,18 +10,7 @@
 
 #include "internal_crypt_lib.h"
 #include <openssl/hmac.h>
-
-void *hmac_md_new(void);
-void hmac_md_free(IN void *hmac_md_ctx);
-boolean hmac_md_set_key(IN const EVP_MD *md, OUT void *hmac_md_ctx,
-			IN const uint8 *key, IN uintn key_size);
-boolean hmac_md_duplicate(IN const void *hmac_md_ctx, OUT void *new_hmac_md_ctx);
-boolean hmac_md_update(IN OUT void *hmac_md_ctx, IN const void *data,
-		       IN uintn data_size);
-boolean hmac_md_final(IN OUT void *hmac_md_ctx, OUT uint8 *hmac_value);
-boolean hmac_md_all(IN const EVP_MD *md, IN const void *data,
-		    IN uintn data_size, IN const uint8 *key, IN uintn key_size,
-		    OUT uint8 *hmac_value);
+#include "hmac/hmac_md.h"
 
 /**
   Allocates and initializes one HMAC_CTX context for subsequent HMAC-SHA3_256 use.
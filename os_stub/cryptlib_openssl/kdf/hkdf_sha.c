@@ -13,6 +13,8 @@
 #include "internal_crypt_lib.h"
 #include <openssl/evp.h>
 #include <openssl/kdf.h>
+#include <openssl/hmac.h>
+#include "hmac/hmac_md.h"
 
 /**
   Derive HMAC-based Extract-and-Expand key Derivation Function (HKDF).
@@ -193,6 +195,83 @@ boolean hkdf_md_expand(IN const EVP_MD *md, IN const uint8 *prk,
 	return result;
 }
 
+/**
+  Derive HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF context.
+
+  The HKDF context is an HMAC context keyed with the PRK. Each output block
+  T(N) = HMAC(PRK, T(N-1) | info | N) starts from a copy of it, so the HMAC key
+  setup is only done once per PRK.
+
+  @param[in]   md               message digest the HKDF context is keyed with.
+  @param[in]   hkdf_md_ctx       Pointer to the HKDF context keyed with the PRK.
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_md_keyed_expand(IN const EVP_MD *md, IN const void *hkdf_md_ctx,
+			     IN const uint8 *info, IN uintn info_size,
+			     OUT uint8 *out, IN uintn out_size)
+{
+	void *hmac_md_ctx;
+	uint8 block[EVP_MAX_MD_SIZE];
+	uintn md_size;
+	uintn offset;
+	uintn copy_size;
+	uint8 counter;
+	boolean result;
+
+	if (hkdf_md_ctx == NULL || info == NULL || out == NULL ||
+	    info_size > INT_MAX || out_size > INT_MAX) {
+		return FALSE;
+	}
+
+	if (md == NULL || EVP_MD_size(md) <= 0) {
+		return FALSE;
+	}
+	md_size = EVP_MD_size(md);
+	if (out_size > md_size * 255) {
+		return FALSE;
+	}
+
+	hmac_md_ctx = hmac_md_new();
+	if (hmac_md_ctx == NULL) {
+		return FALSE;
+	}
+
+	result = TRUE;
+	counter = 0;
+	for (offset = 0; result && (offset < out_size); offset += copy_size) {
+		counter++;
+		result = hmac_md_duplicate(hkdf_md_ctx, hmac_md_ctx);
+		if (result && (counter > 1)) {
+			result = hmac_md_update(hmac_md_ctx, block, md_size);
+		}
+		if (result) {
+			result = hmac_md_update(hmac_md_ctx, info, info_size);
+		}
+		if (result) {
+			result = hmac_md_update(hmac_md_ctx, &counter,
+						sizeof(counter));
+		}
+		if (result) {
+			result = hmac_md_final(hmac_md_ctx, block);
+		}
+		copy_size = MIN(out_size - offset, md_size);
+		if (result) {
+			copy_mem(out + offset, block, copy_size);
+		}
+	}
+
+	hmac_md_free(hmac_md_ctx);
+	zero_mem(block, sizeof(block));
+	return result;
+}
+
 /**
   Derive SHA256 HMAC-based Extract-and-Expand key Derivation Function (HKDF).
 
@@ -263,6 +342,80 @@ boolean hkdf_sha256_expand(IN const uint8 *prk, IN uintn prk_size,
 			      out_size);
 }
 
+/**
+  Allocates one HKDF-SHA256 context for subsequent keyed expansion.
+
+  The context is keyed with a PRK by hkdf_sha256_set_prk(), and can then be used by
+  hkdf_sha256_keyed_expand() for any number of expansions from the same PRK.
+
+  @return  Pointer to the HKDF-SHA256 context that has been allocated.
+           If the allocations fails, hkdf_sha256_new() returns NULL.
+
+**/
+void *hkdf_sha256_new(void)
+{
+	return hmac_md_new();
+}
+
+/**
+  Release the specified HKDF-SHA256 context.
+
+  @param[in]  hkdf_sha256_ctx  Pointer to the HKDF-SHA256 context to be released.
+
+**/
+void hkdf_sha256_free(IN void *hkdf_sha256_ctx)
+{
+	hmac_md_free(hkdf_sha256_ctx);
+}
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF-SHA256 context for subsequent keyed expansion.
+  A context can be keyed again with another PRK.
+
+  If hkdf_sha256_ctx is NULL, then return FALSE.
+
+  @param[out]  hkdf_sha256_ctx  Pointer to the HKDF-SHA256 context.
+  @param[in]   prk              Pointer to the pseudorandom key.
+  @param[in]   prk_size          prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+
+**/
+boolean hkdf_sha256_set_prk(OUT void *hkdf_sha256_ctx, IN const uint8 *prk,
+			    IN uintn prk_size)
+{
+	if (hkdf_sha256_ctx == NULL || prk == NULL) {
+		return FALSE;
+	}
+
+	return hmac_md_set_key(EVP_sha256(), hkdf_sha256_ctx, prk, prk_size);
+}
+
+/**
+  Derive SHA256 HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF-SHA256 context.
+
+  The result is the same as hkdf_sha256_expand() with the PRK of the context, but the
+  HMAC key setup is not repeated. The context is not modified.
+
+  @param[in]   hkdf_sha256_ctx  Pointer to the HKDF-SHA256 context keyed by hkdf_sha256_set_prk().
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_sha256_keyed_expand(IN const void *hkdf_sha256_ctx,
+				 IN const uint8 *info, IN uintn info_size,
+				 OUT uint8 *out, IN uintn out_size)
+{
+	return hkdf_md_keyed_expand(EVP_sha256(), hkdf_sha256_ctx, info,
+				    info_size, out, out_size);
+}
+
 /**
   Derive SHA384 HMAC-based Extract-and-Expand key Derivation Function (HKDF).
 
@@ -333,6 +486,80 @@ boolean hkdf_sha384_expand(IN const uint8 *prk, IN uintn prk_size,
 			      out_size);
 }
 
+/**
+  Allocates one HKDF-SHA384 context for subsequent keyed expansion.
+
+  The context is keyed with a PRK by hkdf_sha384_set_prk(), and can then be used by
+  hkdf_sha384_keyed_expand() for any number of expansions from the same PRK.
+
+  @return  Pointer to the HKDF-SHA384 context that has been allocated.
+           If the allocations fails, hkdf_sha384_new() returns NULL.
+
+**/
+void *hkdf_sha384_new(void)
+{
+	return hmac_md_new();
+}
+
+/**
+  Release the specified HKDF-SHA384 context.
+
+  @param[in]  hkdf_sha384_ctx  Pointer to the HKDF-SHA384 context to be released.
+
+**/
+void hkdf_sha384_free(IN void *hkdf_sha384_ctx)
+{
+	hmac_md_free(hkdf_sha384_ctx);
+}
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF-SHA384 context for subsequent keyed expansion.
+  A context can be keyed again with another PRK.
+
+  If hkdf_sha384_ctx is NULL, then return FALSE.
+
+  @param[out]  hkdf_sha384_ctx  Pointer to the HKDF-SHA384 context.
+  @param[in]   prk              Pointer to the pseudorandom key.
+  @param[in]   prk_size          prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+
+**/
+boolean hkdf_sha384_set_prk(OUT void *hkdf_sha384_ctx, IN const uint8 *prk,
+			    IN uintn prk_size)
+{
+	if (hkdf_sha384_ctx == NULL || prk == NULL) {
+		return FALSE;
+	}
+
+	return hmac_md_set_key(EVP_sha384(), hkdf_sha384_ctx, prk, prk_size);
+}
+
+/**
+  Derive SHA384 HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF-SHA384 context.
+
+  The result is the same as hkdf_sha384_expand() with the PRK of the context, but the
+  HMAC key setup is not repeated. The context is not modified.
+
+  @param[in]   hkdf_sha384_ctx  Pointer to the HKDF-SHA384 context keyed by hkdf_sha384_set_prk().
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_sha384_keyed_expand(IN const void *hkdf_sha384_ctx,
+				 IN const uint8 *info, IN uintn info_size,
+				 OUT uint8 *out, IN uintn out_size)
+{
+	return hkdf_md_keyed_expand(EVP_sha384(), hkdf_sha384_ctx, info,
+				    info_size, out, out_size);
+}
+
 /**
   Derive SHA512 HMAC-based Extract-and-Expand key Derivation Function (HKDF).
 
@@ -402,3 +629,77 @@ boolean hkdf_sha512_expand(IN const uint8 *prk, IN uintn prk_size,
 	return hkdf_md_expand(EVP_sha512(), prk, prk_size, info, info_size, out,
 			      out_size);
 }
+
+/**
+  Allocates one HKDF-SHA512 context for subsequent keyed expansion.
+
+  The context is keyed with a PRK by hkdf_sha512_set_prk(), and can then be used by
+  hkdf_sha512_keyed_expand() for any number of expansions from the same PRK.
+
+  @return  Pointer to the HKDF-SHA512 context that has been allocated.
+           If the allocations fails, hkdf_sha512_new() returns NULL.
+
+**/
+void *hkdf_sha512_new(void)
+{
+	return hmac_md_new();
+}
+
+/**
+  Release the specified HKDF-SHA512 context.
+
+  @param[in]  hkdf_sha512_ctx  Pointer to the HKDF-SHA512 context to be released.
+
+**/
+void hkdf_sha512_free(IN void *hkdf_sha512_ctx)
+{
+	hmac_md_free(hkdf_sha512_ctx);
+}
+
+/**
+  Set the pseudorandom key (PRK) of a HKDF-SHA512 context for subsequent keyed expansion.
+  A context can be keyed again with another PRK.
+
+  If hkdf_sha512_ctx is NULL, then return FALSE.
+
+  @param[out]  hkdf_sha512_ctx  Pointer to the HKDF-SHA512 context.
+  @param[in]   prk              Pointer to the pseudorandom key.
+  @param[in]   prk_size          prk size in bytes.
+
+  @retval TRUE   The PRK is set successfully.
+  @retval FALSE  The PRK is set unsuccessfully.
+
+**/
+boolean hkdf_sha512_set_prk(OUT void *hkdf_sha512_ctx, IN const uint8 *prk,
+			    IN uintn prk_size)
+{
+	if (hkdf_sha512_ctx == NULL || prk == NULL) {
+		return FALSE;
+	}
+
+	return hmac_md_set_key(EVP_sha512(), hkdf_sha512_ctx, prk, prk_size);
+}
+
+/**
+  Derive SHA512 HMAC-based Expand key Derivation Function (HKDF) from a keyed HKDF-SHA512 context.
+
+  The result is the same as hkdf_sha512_expand() with the PRK of the context, but the
+  HMAC key setup is not repeated. The context is not modified.
+
+  @param[in]   hkdf_sha512_ctx  Pointer to the HKDF-SHA512 context keyed by hkdf_sha512_set_prk().
+  @param[in]   info             Pointer to the application specific info.
+  @param[in]   info_size         info size in bytes.
+  @param[out]  out              Pointer to buffer to receive hkdf value.
+  @param[in]   out_size          size of hkdf bytes to generate.
+
+  @retval TRUE   Hkdf generated successfully.
+  @retval FALSE  Hkdf generation failed.
+
+**/
+boolean hkdf_sha512_keyed_expand(IN const void *hkdf_sha512_ctx,
+				 IN const uint8 *info, IN uintn info_size,
+				 OUT uint8 *out, IN uintn out_size)
+{
+	return hkdf_md_keyed_expand(EVP_sha512(), hkdf_sha512_ctx, info,
+				    info_size, out, out_size);
+}
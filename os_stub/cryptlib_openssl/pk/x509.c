@@ -285,9 +285,7 @@ boolean x509_get_subject_name(IN const uint8 *cert, IN uintn cert_size,
 			      IN OUT uintn *subject_size)
 {
 	boolean res;
-	X509 *x509_cert;
-	X509_NAME *x509_name;
-	uintn x509_name_size;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -296,47 +294,82 @@ boolean x509_get_subject_name(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		res = FALSE;
 		goto done;
 	}
 
-	res = FALSE;
+	res = x509_object_get_subject_name(x509_cert, cert_subject,
+					   subject_size);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the subject bytes from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     cert_subject  Pointer to the retrieved certificate subject bytes.
+  @param[in, out] subject_size  The size in bytes of the cert_subject buffer on input,
+                               and the size of buffer returned cert_subject on output.
+
+  If x509_cert is NULL, then return FALSE.
+  If subject_size is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @retval  TRUE   The certificate subject retrieved successfully.
+  @retval  FALSE  Invalid certificate, or the subject_size is too small for the result.
+                  The subject_size will be updated with the required size.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_get_subject_name(IN void *x509_cert,
+				     OUT uint8 *cert_subject,
+				     IN OUT uintn *subject_size)
+{
+	X509_NAME *x509_name;
+	uintn x509_name_size;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || subject_size == NULL) {
+		return FALSE;
+	}
 
 	//
 	// Retrieve subject name from certificate object.
 	//
-	x509_name = X509_get_subject_name(x509_cert);
+	x509_name = X509_get_subject_name((X509 *)x509_cert);
 	if (x509_name == NULL) {
-		goto done;
+		return FALSE;
 	}
 
 	x509_name_size = i2d_X509_NAME(x509_name, NULL);
 	if (*subject_size < x509_name_size) {
 		*subject_size = x509_name_size;
-		goto done;
+		return FALSE;
 	}
 	*subject_size = x509_name_size;
-	if (cert_subject != NULL) {
-		i2d_X509_NAME(x509_name, &cert_subject);
-		res = TRUE;
-	}
-
-done:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
+	if (cert_subject == NULL) {
+		return FALSE;
 	}
+	i2d_X509_NAME(x509_name, &cert_subject);
 
-	return res;
+	return TRUE;
 }
 
 /**
@@ -699,28 +732,63 @@ return_status x509_get_version(IN const uint8 *cert, IN uintn cert_size,
 {
 	return_status status;
 	boolean res;
-	X509 *x509_cert;
+	void *x509_cert;
+
+	//
+	// Check input parameters.
+	//
+	if (cert == NULL || version == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
 
+	//
+	// Read DER-encoded X509 Certificate and Construct X509 object.
+	//
 	x509_cert = NULL;
-	status = RETURN_SUCCESS;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
-		//
-		// Invalid X.509 Certificate
-		//
 		status = RETURN_INVALID_PARAMETER;
+		goto done;
 	}
 
-	if (!RETURN_ERROR(status)) {
-		*version = X509_get_version(x509_cert);
-	}
+	status = x509_object_get_version(x509_cert, version);
 
+done:
+	//
+	// Release Resources.
+	//
 	if (x509_cert != NULL) {
-		X509_free(x509_cert);
+		x509_free(x509_cert);
 	}
+
 	return status;
 }
 
+/**
+  Retrieve the version from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     version      Pointer to the retrieved version integer.
+
+  @retval RETURN_SUCCESS           The certificate version retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert or version is NULL.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+
+**/
+return_status x509_object_get_version(IN void *x509_cert, OUT uintn *version)
+{
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || version == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	*version = X509_get_version((X509 *)x509_cert);
+
+	return RETURN_SUCCESS;
+}
+
 /**
   Retrieve the serialNumber from one X.509 certificate.
 
@@ -748,60 +816,90 @@ return_status x509_get_serial_number(IN const uint8 *cert, IN uintn cert_size,
 				     OUT uint8 *serial_number,
 				     OPTIONAL IN OUT uintn *serial_number_size)
 {
-	boolean res;
-	X509 *x509_cert;
-	ASN1_INTEGER *asn1_integer;
 	return_status status;
-
-	status = RETURN_INVALID_PARAMETER;
+	boolean res;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
 	//
 	if (cert == NULL || serial_number_size == NULL) {
-		return status;
+		return RETURN_INVALID_PARAMETER;
 	}
 
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
+		status = RETURN_INVALID_PARAMETER;
 		goto done;
 	}
 
+	status = x509_object_get_serial_number(x509_cert, serial_number,
+					       serial_number_size);
+
+done:
 	//
-	// Retrieve subject name from certificate object.
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return status;
+}
+
+/**
+  Retrieve the serialNumber from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     serial_number  Pointer to the retrieved certificate serial_number bytes.
+  @param[in, out] serial_number_size  The size in bytes of the serial_number buffer on input,
+                               and the size of buffer returned serial_number on output.
+
+  @retval RETURN_SUCCESS           The certificate serialNumber retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If serial_number_size is NULL.
+  @retval RETURN_NOT_FOUND         If no serial_number exists.
+  @retval RETURN_BUFFER_TOO_SMALL  If the serial_number is NULL. The required buffer size
+                                   (including the final null) is returned in the
+                                   serial_number_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status
+x509_object_get_serial_number(IN void *x509_cert, OUT uint8 *serial_number,
+			      OPTIONAL IN OUT uintn *serial_number_size)
+{
+	ASN1_INTEGER *asn1_integer;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || serial_number_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	//
+	// Retrieve serial number from certificate object.
 	//
-	asn1_integer = X509_get_serialNumber(x509_cert);
+	asn1_integer = X509_get_serialNumber((X509 *)x509_cert);
 	if (asn1_integer == NULL) {
-		status = RETURN_NOT_FOUND;
-		goto done;
+		return RETURN_NOT_FOUND;
 	}
 
 	if (*serial_number_size < (uintn)asn1_integer->length) {
 		*serial_number_size = (uintn)asn1_integer->length;
-		status = RETURN_BUFFER_TOO_SMALL;
-		goto done;
+		return RETURN_BUFFER_TOO_SMALL;
 	}
 	*serial_number_size = (uintn)asn1_integer->length;
-	if (serial_number != NULL) {
-		copy_mem(serial_number, asn1_integer->data,
-			 *serial_number_size);
-		status = RETURN_SUCCESS;
-	}
-
-done:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
+	if (serial_number == NULL) {
+		return RETURN_INVALID_PARAMETER;
 	}
+	copy_mem(serial_number, asn1_integer->data, *serial_number_size);
 
-	return status;
+	return RETURN_SUCCESS;
 }
 
 /**
@@ -828,9 +926,7 @@ boolean x509_get_issuer_name(IN const uint8 *cert, IN uintn cert_size,
 			     IN OUT uintn *issuer_size)
 {
 	boolean res;
-	X509 *x509_cert;
-	X509_NAME *x509_name;
-	uintn x509_name_size;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -839,47 +935,82 @@ boolean x509_get_issuer_name(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		res = FALSE;
 		goto done;
 	}
 
-	res = FALSE;
+	res = x509_object_get_issuer_name(x509_cert, cert_issuer,
+					  issuer_size);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the issuer bytes from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     cert_issuer  Pointer to the retrieved certificate issuer bytes.
+  @param[in, out] issuer_size  The size in bytes of the cert_issuer buffer on input,
+                               and the size of buffer returned cert_issuer on output.
+
+  If x509_cert is NULL, then return FALSE.
+  If issuer_size is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @retval  TRUE   The certificate issuer retrieved successfully.
+  @retval  FALSE  Invalid certificate, or the issuer_size is too small for the result.
+                  The issuer_size will be updated with the required size.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_get_issuer_name(IN void *x509_cert,
+				    OUT uint8 *cert_issuer,
+				    IN OUT uintn *issuer_size)
+{
+	X509_NAME *x509_name;
+	uintn x509_name_size;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || issuer_size == NULL) {
+		return FALSE;
+	}
 
 	//
 	// Retrieve issuer name from certificate object.
 	//
-	x509_name = X509_get_issuer_name(x509_cert);
+	x509_name = X509_get_issuer_name((X509 *)x509_cert);
 	if (x509_name == NULL) {
-		goto done;
+		return FALSE;
 	}
 
 	x509_name_size = i2d_X509_NAME(x509_name, NULL);
 	if (*issuer_size < x509_name_size) {
 		*issuer_size = x509_name_size;
-		goto done;
+		return FALSE;
 	}
 	*issuer_size = x509_name_size;
-	if (cert_issuer != NULL) {
-		i2d_X509_NAME(x509_name, &cert_issuer);
-		res = TRUE;
-	}
-
-done:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
+	if (cert_issuer == NULL) {
+		return FALSE;
 	}
+	i2d_X509_NAME(x509_name, &cert_issuer);
 
-	return res;
+	return TRUE;
 }
 
 /**
@@ -975,12 +1106,9 @@ return_status x509_get_signature_algorithm(IN const uint8 *cert,
 					   IN uintn cert_size, OUT uint8 *oid,
 					   OPTIONAL IN OUT uintn *oid_size)
 {
-	boolean res;
 	return_status status;
-	X509 *x509_cert;
-	int nid;
-	ASN1_OBJECT *asn1_obj;
-	uintn obj_length;
+	boolean res;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -989,55 +1117,84 @@ return_status x509_get_signature_algorithm(IN const uint8 *cert,
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	x509_cert = NULL;
-	status = RETURN_INVALID_PARAMETER;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		status = RETURN_INVALID_PARAMETER;
 		goto done;
 	}
 
-	//
-	// Retrieve subject name from certificate object.
-	//
-	nid = X509_get_signature_nid(x509_cert);
-	if (nid == NID_undef) {
-		status = RETURN_NOT_FOUND;
-		goto done;
-	}
-	asn1_obj = OBJ_nid2obj(nid);
-	if (asn1_obj == NULL) {
-		status = RETURN_NOT_FOUND;
-		goto done;
-	}
-
-	obj_length = OBJ_length(asn1_obj);
-	if (*oid_size < obj_length) {
-		*oid_size = obj_length;
-		status = RETURN_BUFFER_TOO_SMALL;
-		goto done;
-	}
-	if (oid != NULL) {
-		copy_mem(oid, OBJ_get0_data(asn1_obj), obj_length);
-	}
-	*oid_size = obj_length;
-	status = RETURN_SUCCESS;
+	status = x509_object_get_signature_algorithm(x509_cert, oid, oid_size);
 
 done:
 	//
 	// Release Resources.
 	//
 	if (x509_cert != NULL) {
-		X509_free(x509_cert);
+		x509_free(x509_cert);
 	}
 
 	return status;
 }
 
+/**
+  Retrieve the signature algorithm from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     oid              signature algorithm Object identifier buffer.
+  @param[in,out]  oid_size          signature algorithm Object identifier buffer size
+
+  @retval RETURN_SUCCESS           The certificate signature algorithm retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If oid_size is NULL.
+  @retval RETURN_NOT_FOUND         If no SignatureType.
+  @retval RETURN_BUFFER_TOO_SMALL  If the oid is NULL. The required buffer size
+                                   is returned in the oid_size.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_signature_algorithm(IN void *x509_cert,
+						  OUT uint8 *oid,
+						  OPTIONAL IN OUT uintn *oid_size)
+{
+	int nid;
+	ASN1_OBJECT *asn1_obj;
+	uintn obj_length;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || oid_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	//
+	// Retrieve signature algorithm from certificate object.
+	//
+	nid = X509_get_signature_nid((X509 *)x509_cert);
+	if (nid == NID_undef) {
+		return RETURN_NOT_FOUND;
+	}
+	asn1_obj = OBJ_nid2obj(nid);
+	if (asn1_obj == NULL) {
+		return RETURN_NOT_FOUND;
+	}
+
+	obj_length = OBJ_length(asn1_obj);
+	if (*oid_size < obj_length) {
+		*oid_size = obj_length;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	if (oid != NULL) {
+		copy_mem(oid, OBJ_get0_data(asn1_obj), obj_length);
+	}
+	*oid_size = obj_length;
+
+	return RETURN_SUCCESS;
+}
+
 /**
   Retrieve the Validity from one X.509 certificate
 
@@ -1064,11 +1221,7 @@ boolean x509_get_validity(IN const uint8 *cert, IN uintn cert_size,
 			  IN OUT uintn *to_size)
 {
 	boolean res;
-	X509 *x509_cert;
-	const ASN1_TIME *f_time;
-	const ASN1_TIME *t_time;
-	uintn t_size;
-	uintn f_size;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -1078,31 +1231,73 @@ boolean x509_get_validity(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	x509_cert = NULL;
-	res = FALSE;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
 		goto done;
 	}
 
+	res = x509_object_get_validity(x509_cert, from, from_size, to,
+				       to_size);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the Validity from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     from         notBefore Pointer to date_time object.
+  @param[in,out]  from_size     notBefore date_time object size.
+  @param[out]     to           notAfter Pointer to date_time object.
+  @param[in,out]  to_size       notAfter date_time object size.
+
+  @retval  TRUE   The certificate Validity retrieved successfully.
+  @retval  FALSE  Invalid certificate, or Validity retrieve failed.
+  @retval  FALSE  This interface is not supported.
+**/
+boolean x509_object_get_validity(IN void *x509_cert, IN uint8 *from,
+				 IN OUT uintn *from_size, IN uint8 *to,
+				 IN OUT uintn *to_size)
+{
+	const ASN1_TIME *f_time;
+	const ASN1_TIME *t_time;
+	uintn t_size;
+	uintn f_size;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || from_size == NULL || to_size == NULL) {
+		return FALSE;
+	}
+
 	//
 	// Retrieve Validity from/to from certificate object.
 	//
-	f_time = X509_get0_notBefore(x509_cert);
-	t_time = X509_get0_notAfter(x509_cert);
+	f_time = X509_get0_notBefore((X509 *)x509_cert);
+	t_time = X509_get0_notAfter((X509 *)x509_cert);
 
 	if (f_time == NULL || t_time == NULL) {
-		goto done;
+		return FALSE;
 	}
 
 	f_size = sizeof(ASN1_TIME) + f_time->length;
 	if (*from_size < f_size) {
 		*from_size = f_size;
-		goto done;
+		return FALSE;
 	}
 	*from_size = f_size;
 	if (from != NULL) {
@@ -1115,7 +1310,7 @@ boolean x509_get_validity(IN const uint8 *cert, IN uintn cert_size,
 	t_size = sizeof(ASN1_TIME) + t_time->length;
 	if (*to_size < t_size) {
 		*to_size = t_size;
-		goto done;
+		return FALSE;
 	}
 	*to_size = t_size;
 	if (to != NULL) {
@@ -1124,17 +1319,7 @@ boolean x509_get_validity(IN const uint8 *cert, IN uintn cert_size,
 		copy_mem(to + sizeof(ASN1_TIME), t_time->data, t_time->length);
 	}
 
-	res = TRUE;
-
-done:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
-	}
-
-	return res;
+	return TRUE;
 }
 
 /**
@@ -1242,7 +1427,7 @@ boolean x509_get_key_usage(IN const uint8 *cert, IN uintn cert_size,
 			   OUT uintn *usage)
 {
 	boolean res;
-	X509 *x509_cert;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -1251,37 +1436,59 @@ boolean x509_get_key_usage(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	x509_cert = NULL;
-	res = FALSE;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
+		res = FALSE;
 		goto done;
 	}
 
-	//
-	// Retrieve subject name from certificate object.
-	//
-	*usage = X509_get_key_usage(x509_cert);
-	if (*usage == NID_undef) {
-		goto done;
-	}
-	res = TRUE;
+	res = x509_object_get_key_usage(x509_cert, usage);
 
 done:
 	//
 	// Release Resources.
 	//
 	if (x509_cert != NULL) {
-		X509_free(x509_cert);
+		x509_free(x509_cert);
 	}
 
 	return res;
 }
 
+/**
+  Retrieve the key usage from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     usage            key usage (CRYPTO_X509_KU_*)
+
+  @retval  TRUE   The certificate key usage retrieved successfully.
+  @retval  FALSE  Invalid certificate, or usage is NULL
+  @retval  FALSE  This interface is not supported.
+**/
+boolean x509_object_get_key_usage(IN void *x509_cert, OUT uintn *usage)
+{
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || usage == NULL) {
+		return FALSE;
+	}
+
+	//
+	// Retrieve key usage from certificate object.
+	//
+	*usage = X509_get_key_usage((X509 *)x509_cert);
+	if (*usage == NID_undef) {
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
 /**
   Retrieve Extension data from one X.509 certificate.
 
@@ -1308,44 +1515,88 @@ return_status x509_get_extension_data(IN const uint8 *cert, IN uintn cert_size,
 				      IN OUT uintn *extension_data_size)
 {
 	return_status status;
-	intn i;
 	boolean res;
-	X509 *x509_cert;
-	const STACK_OF(X509_EXTENSION) * extensions;
-	ASN1_OBJECT *asn1_obj;
-	ASN1_OCTET_STRING *asn1_oct;
-	X509_EXTENSION *ext;
-	uintn obj_length;
-	uintn oct_length;
-
-	status = RETURN_INVALID_PARAMETER;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
 	//
 	if (cert == NULL || cert_size == 0 || oid == NULL || oid_size == 0 ||
 	    extension_data_size == NULL) {
-		return status;
+		return RETURN_INVALID_PARAMETER;
 	}
 
-	x509_cert = NULL;
-	res = FALSE;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
-		goto cleanup;
+		status = RETURN_INVALID_PARAMETER;
+		goto done;
+	}
+
+	status = x509_object_get_extension_data(x509_cert, oid, oid_size,
+						extension_data,
+						extension_data_size);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return status;
+}
+
+/**
+  Retrieve Extension data from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[in]      oid              Object identifier buffer
+  @param[in]      oid_size          Object identifier buffer size
+  @param[out]     extension_data    Extension bytes.
+  @param[in, out] extension_data_size Extension bytes size.
+
+  @retval RETURN_SUCCESS           The certificate Extension data retrieved successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If extension_data_size is NULL.
+  @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+  @retval RETURN_BUFFER_TOO_SMALL  If the extension_data is NULL. The required buffer size
+                                   is returned in the extension_data_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_extension_data(IN void *x509_cert,
+					     IN uint8 *oid, IN uintn oid_size,
+					     OUT uint8 *extension_data,
+					     IN OUT uintn *extension_data_size)
+{
+	return_status status;
+	intn i;
+	const STACK_OF(X509_EXTENSION) * extensions;
+	ASN1_OBJECT *asn1_obj;
+	ASN1_OCTET_STRING *asn1_oct;
+	X509_EXTENSION *ext;
+	uintn obj_length;
+	uintn oct_length;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || oid == NULL || oid_size == 0 ||
+	    extension_data_size == NULL) {
+		return RETURN_INVALID_PARAMETER;
 	}
 
 	//
 	// Retrieve extensions from certificate object.
 	//
 	status = RETURN_NOT_FOUND;
-	extensions = X509_get0_extensions(x509_cert);
+	extensions = X509_get0_extensions((X509 *)x509_cert);
 	if (sk_X509_EXTENSION_num(extensions) <= 0) {
-		goto cleanup;
+		return status;
 	}
 
 	//
@@ -1380,23 +1631,13 @@ return_status x509_get_extension_data(IN const uint8 *cert, IN uintn cert_size,
 	if (status == RETURN_SUCCESS) {
 		if (*extension_data_size < oct_length) {
 			*extension_data_size = oct_length;
-			status = RETURN_BUFFER_TOO_SMALL;
-			goto cleanup;
+			return RETURN_BUFFER_TOO_SMALL;
 		}
-		if (oid != NULL) {
+		if (extension_data != NULL) {
 			copy_mem(extension_data, ASN1_STRING_get0_data(asn1_oct),
 				 asn1_oct->length);
 		}
 		*extension_data_size = oct_length;
-		status = RETURN_SUCCESS;
-	}
-
-cleanup:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
 	}
 
 	return status;
@@ -1431,6 +1672,30 @@ return_status x509_get_extended_key_usage(IN const uint8 *cert,
 	return status;
 }
 
+/**
+  Retrieve the Extended key usage from one X509 object.
+
+  @param[in]      x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out]     usage            key usage bytes.
+  @param[in, out] usage_size        key usage buffer sizs in bytes.
+
+  @retval RETURN_SUCCESS           The usage bytes retrieve successfully.
+  @retval RETURN_INVALID_PARAMETER If x509_cert is NULL.
+                                   If usage_size is NULL.
+  @retval RETURN_BUFFER_TOO_SMALL  If the usage is NULL. The required buffer size
+                                   is returned in the usage_size parameter.
+  @retval RETURN_UNSUPPORTED       The operation is not supported.
+**/
+return_status x509_object_get_extended_key_usage(IN void *x509_cert,
+						 OUT uint8 *usage,
+						 IN OUT uintn *usage_size)
+{
+	return x509_object_get_extension_data(x509_cert,
+					      (uint8 *)m_oid_ext_key_usage,
+					      sizeof(m_oid_ext_key_usage), usage,
+					      usage_size);
+}
+
 /**
   Retrieve the RSA public key from one DER-encoded X509 certificate.
 
@@ -1451,8 +1716,7 @@ boolean rsa_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 				     OUT void **rsa_context)
 {
 	boolean res;
-	EVP_PKEY *pkey;
-	X509 *x509_cert;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -1461,24 +1725,61 @@ boolean rsa_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	pkey = NULL;
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		res = FALSE;
 		goto done;
 	}
 
+	res = rsa_get_public_key_from_x509_object(x509_cert, rsa_context);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the RSA public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] rsa_context   Pointer to new-generated RSA context which contain the retrieved
+                           RSA public key component. Use rsa_free() function to free the
+                           resource.
+
+  @retval  TRUE   RSA public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve RSA public key from X509 object.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean rsa_get_public_key_from_x509_object(IN void *x509_cert,
+					    OUT void **rsa_context)
+{
+	boolean res;
+	EVP_PKEY *pkey;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || rsa_context == NULL) {
+		return FALSE;
+	}
+
 	res = FALSE;
 
 	//
 	// Retrieve and check EVP_PKEY data from X509 Certificate.
 	//
-	pkey = X509_get_pubkey(x509_cert);
+	pkey = X509_get_pubkey((X509 *)x509_cert);
 	if ((pkey == NULL) || (EVP_PKEY_id(pkey) != EVP_PKEY_RSA)) {
 		goto done;
 	}
@@ -1495,10 +1796,6 @@ done:
 	//
 	// Release Resources.
 	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
-	}
-
 	if (pkey != NULL) {
 		EVP_PKEY_free(pkey);
 	}
@@ -1526,8 +1823,7 @@ boolean ec_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 				    OUT void **ec_context)
 {
 	boolean res;
-	EVP_PKEY *pkey;
-	X509 *x509_cert;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -1536,24 +1832,60 @@ boolean ec_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	pkey = NULL;
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		res = FALSE;
 		goto done;
 	}
 
+	res = ec_get_public_key_from_x509_object(x509_cert, ec_context);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the EC public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] ec_context    Pointer to new-generated EC DSA context which contain the retrieved
+                           EC public key component. Use ec_free() function to free the
+                           resource.
+
+  @retval  TRUE   EC public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve EC public key from X509 object.
+
+**/
+boolean ec_get_public_key_from_x509_object(IN void *x509_cert,
+					   OUT void **ec_context)
+{
+	boolean res;
+	EVP_PKEY *pkey;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || ec_context == NULL) {
+		return FALSE;
+	}
+
 	res = FALSE;
 
 	//
 	// Retrieve and check EVP_PKEY data from X509 Certificate.
 	//
-	pkey = X509_get_pubkey(x509_cert);
+	pkey = X509_get_pubkey((X509 *)x509_cert);
 	if ((pkey == NULL) || (EVP_PKEY_id(pkey) != EVP_PKEY_EC)) {
 		goto done;
 	}
@@ -1569,10 +1901,6 @@ done:
 	//
 	// Release Resources.
 	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
-	}
-
 	if (pkey != NULL) {
 		EVP_PKEY_free(pkey);
 	}
@@ -1600,9 +1928,7 @@ boolean ecd_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 				    OUT void **ecd_context)
 {
 	boolean res;
-	EVP_PKEY *pkey;
-	X509 *x509_cert;
-	int32 type;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -1611,44 +1937,70 @@ boolean ecd_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	pkey = NULL;
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		res = FALSE;
 		goto done;
 	}
 
-	res = FALSE;
+	res = ecd_get_public_key_from_x509_object(x509_cert, ecd_context);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the Ed public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] ecd_context    Pointer to new-generated Ed DSA context which contain the retrieved
+                           Ed public key component. Use ecd_free() function to free the
+                           resource.
+
+  @retval  TRUE   Ed public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve Ed public key from X509 object.
+
+**/
+boolean ecd_get_public_key_from_x509_object(IN void *x509_cert,
+					    OUT void **ecd_context)
+{
+	EVP_PKEY *pkey;
+	int32 type;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || ecd_context == NULL) {
+		return FALSE;
+	}
 
 	//
 	// Retrieve and check EVP_PKEY data from X509 Certificate.
 	//
-	pkey = X509_get_pubkey(x509_cert);
+	pkey = X509_get_pubkey((X509 *)x509_cert);
 	if (pkey == NULL) {
-		goto done;
+		return FALSE;
 	}
 	type = EVP_PKEY_id(pkey);
 	if ((type != EVP_PKEY_ED25519) && (type != EVP_PKEY_ED448)) {
-		goto done;
+		EVP_PKEY_free(pkey);
+		return FALSE;
 	}
 
 	*ecd_context = pkey;
-	res = TRUE;
-
-done:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
-	}
 
-	return res;
+	return TRUE;
 }
 
 /**
@@ -1671,11 +2023,7 @@ boolean sm2_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 				     OUT void **sm2_context)
 {
 	boolean res;
-	EVP_PKEY *pkey;
-	X509 *x509_cert;
-	int32 result;
-	EC_KEY *ec_key;
-	int32 openssl_nid;
+	void *x509_cert;
 
 	//
 	// Check input parameters.
@@ -1684,49 +2032,78 @@ boolean sm2_get_public_key_from_x509(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	pkey = NULL;
-	x509_cert = NULL;
-
 	//
 	// Read DER-encoded X509 Certificate and Construct X509 object.
 	//
+	x509_cert = NULL;
 	res = x509_construct_certificate(cert, cert_size, (uint8 **)&x509_cert);
 	if ((x509_cert == NULL) || (!res)) {
 		res = FALSE;
 		goto done;
 	}
 
-	res = FALSE;
+	res = sm2_get_public_key_from_x509_object(x509_cert, sm2_context);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	return res;
+}
+
+/**
+  Retrieve the sm2 public key from one X509 object.
+
+  @param[in]  x509_cert     The X509 object generated by x509_construct_certificate().
+  @param[out] sm2_context   Pointer to new-generated sm2 context which contain the retrieved
+                           sm2 public key component. Use sm2_free() function to free the
+                           resource.
+
+  @retval  TRUE   sm2 public key was retrieved successfully.
+  @retval  FALSE  Fail to retrieve sm2 public key from X509 object.
+
+**/
+boolean sm2_get_public_key_from_x509_object(IN void *x509_cert,
+					     OUT void **sm2_context)
+{
+	EVP_PKEY *pkey;
+	int32 result;
+	EC_KEY *ec_key;
+	int32 openssl_nid;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || sm2_context == NULL) {
+		return FALSE;
+	}
 
 	//
 	// Retrieve and check EVP_PKEY data from X509 Certificate.
 	//
-	pkey = X509_get_pubkey(x509_cert);
+	pkey = X509_get_pubkey((X509 *)x509_cert);
 	if (pkey == NULL) {
-		goto done;
+		return FALSE;
 	}
 	ec_key = EVP_PKEY_get0_EC_KEY(pkey);
 	openssl_nid = EC_GROUP_get_curve_name(EC_KEY_get0_group(ec_key));
 	if (openssl_nid != NID_sm2) {
-		goto done;
+		EVP_PKEY_free(pkey);
+		return FALSE;
 	}
 	result = EVP_PKEY_set_alias_type(pkey, EVP_PKEY_SM2);
 	if (result == 0) {
-		goto done;
+		EVP_PKEY_free(pkey);
+		return FALSE;
 	}
 
 	*sm2_context = pkey;
-	res = TRUE;
-
-done:
-	//
-	// Release Resources.
-	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
-	}
 
-	return res;
+	return TRUE;
 }
 
 /**
@@ -1749,10 +2126,8 @@ boolean x509_verify_cert(IN const uint8 *cert, IN uintn cert_size,
 			 IN const uint8 *ca_cert, IN uintn ca_cert_size)
 {
 	boolean res;
-	X509 *x509_cert;
-	X509 *x509_ca_cert;
-	X509_STORE *cert_store;
-	X509_STORE_CTX *cert_ctx;
+	void *x509_cert;
+	void *x509_ca_cert;
 
 	//
 	// Check input parameters.
@@ -1761,24 +2136,8 @@ boolean x509_verify_cert(IN const uint8 *cert, IN uintn cert_size,
 		return FALSE;
 	}
 
-	res = FALSE;
 	x509_cert = NULL;
 	x509_ca_cert = NULL;
-	cert_store = NULL;
-	cert_ctx = NULL;
-
-	//
-	// Register & Initialize necessary digest algorithms for certificate verification.
-	//
-	if (EVP_add_digest(EVP_sha256()) == 0) {
-		goto done;
-	}
-	if (EVP_add_digest(EVP_sha384()) == 0) {
-		goto done;
-	}
-	if (EVP_add_digest(EVP_sha512()) == 0) {
-		goto done;
-	}
 
 	//
 	// Read DER-encoded certificate to be verified and Construct X509 object.
@@ -1799,7 +2158,64 @@ boolean x509_verify_cert(IN const uint8 *cert, IN uintn cert_size,
 		goto done;
 	}
 
+	res = x509_object_verify_cert(x509_cert, x509_ca_cert);
+
+done:
+	//
+	// Release Resources.
+	//
+	if (x509_cert != NULL) {
+		x509_free(x509_cert);
+	}
+
+	if (x509_ca_cert != NULL) {
+		x509_free(x509_ca_cert);
+	}
+
+	return res;
+}
+
+/**
+  Verify one X509 object was issued by the trusted CA X509 object.
+
+  @param[in]      x509_cert     The X509 object of the certificate to be verified.
+  @param[in]      ca_x509_cert  The X509 object of the trusted CA certificate.
+
+  @retval  TRUE   The certificate was issued by the trusted CA.
+  @retval  FALSE  Invalid certificate or the certificate was not issued by the given
+                  trusted CA.
+  @retval  FALSE  This interface is not supported.
+
+**/
+boolean x509_object_verify_cert(IN void *x509_cert, IN void *ca_x509_cert)
+{
+	boolean res;
+	X509_STORE *cert_store;
+	X509_STORE_CTX *cert_ctx;
+
+	//
+	// Check input parameters.
+	//
+	if (x509_cert == NULL || ca_x509_cert == NULL) {
+		return FALSE;
+	}
+
 	res = FALSE;
+	cert_store = NULL;
+	cert_ctx = NULL;
+
+	//
+	// Register & Initialize necessary digest algorithms for certificate verification.
+	//
+	if (EVP_add_digest(EVP_sha256()) == 0) {
+		goto done;
+	}
+	if (EVP_add_digest(EVP_sha384()) == 0) {
+		goto done;
+	}
+	if (EVP_add_digest(EVP_sha512()) == 0) {
+		goto done;
+	}
 
 	//
 	// Set up X509 Store for trusted certificate.
@@ -1808,7 +2224,7 @@ boolean x509_verify_cert(IN const uint8 *cert, IN uintn cert_size,
 	if (cert_store == NULL) {
 		goto done;
 	}
-	if (!(X509_STORE_add_cert(cert_store, x509_ca_cert))) {
+	if (!(X509_STORE_add_cert(cert_store, (X509 *)ca_x509_cert))) {
 		goto done;
 	}
 
@@ -1826,7 +2242,8 @@ boolean x509_verify_cert(IN const uint8 *cert, IN uintn cert_size,
 	if (cert_ctx == NULL) {
 		goto done;
 	}
-	if (!X509_STORE_CTX_init(cert_ctx, cert_store, x509_cert, NULL)) {
+	if (!X509_STORE_CTX_init(cert_ctx, cert_store, (X509 *)x509_cert,
+				 NULL)) {
 		goto done;
 	}
 
@@ -1840,14 +2257,6 @@ done:
 	//
 	// Release Resources.
 	//
-	if (x509_cert != NULL) {
-		X509_free(x509_cert);
-	}
-
-	if (x509_ca_cert != NULL) {
-		X509_free(x509_ca_cert);
-	}
-
 	if (cert_store != NULL) {
 		X509_STORE_free(cert_store);
 	}
@@ -1958,13 +2367,21 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 	uint32 obj_class;
 	uint8 *current_cert;
 	uintn current_cert_len;
-	uint8 *preceding_cert;
-	uintn preceding_cert_len;
+	void *preceding_x509_cert;
+	void *current_x509_cert;
 	boolean verify_flag;
 	int32 ret;
 
-	preceding_cert = root_cert;
-	preceding_cert_len = root_cert_length;
+	//
+	// Each certificate is decoded once and kept as the preceding X509 object
+	// for the verification of the next one.
+	//
+	preceding_x509_cert = NULL;
+	if (!x509_construct_certificate(root_cert, root_cert_length,
+					(uint8 **)&preceding_x509_cert)) {
+		x509_free(preceding_x509_cert);
+		return FALSE;
+	}
 
 	current_cert = cert_chain;
 	length = 0;
@@ -1989,18 +2406,23 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 		//
 		// Verify current_cert with preceding cert;
 		//
-		verify_flag =
-			x509_verify_cert(current_cert, current_cert_len,
-					 preceding_cert, preceding_cert_len);
-		if (verify_flag == FALSE) {
-			break;
+		current_x509_cert = NULL;
+		verify_flag = x509_construct_certificate(
+			current_cert, current_cert_len,
+			(uint8 **)&current_x509_cert);
+		if (verify_flag) {
+			verify_flag = x509_object_verify_cert(
+				current_x509_cert, preceding_x509_cert);
 		}
 
 		//
 		// move Current cert to Preceding cert
 		//
-		preceding_cert_len = current_cert_len;
-		preceding_cert = current_cert;
+		x509_free(preceding_x509_cert);
+		preceding_x509_cert = current_x509_cert;
+		if (verify_flag == FALSE) {
+			break;
+		}
 
 		//
 		// Move to next
@@ -2008,6 +2430,8 @@ boolean x509_verify_cert_chain(IN uint8 *root_cert, IN uintn root_cert_length,
 		current_cert = current_cert + current_cert_len;
 	}
 
+	x509_free(preceding_x509_cert);
+
 	return verify_flag;
 }
 
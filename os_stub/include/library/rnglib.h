@@ -24,4 +24,21 @@
 **/
 boolean get_random_number_64(OUT uint64 *rand_data);
 
+/**
+  Fills a buffer with random bytes.
+
+  This lets callers take a nonce or a seed in one call instead of
+  one get_random_number_64() call per 8 bytes.
+
+  if buffer is NULL and size is not 0, then ASSERT().
+
+  @param[out] buffer   buffer to fill with random bytes.
+  @param[in]  size     Number of bytes to fill.
+
+  @retval TRUE         Random bytes generated successfully.
+  @retval FALSE        Failed to generate the random bytes.
+
+**/
+boolean get_random_bytes(OUT uint8 *buffer, IN uintn size);
+
 #endif // __RNG_LIB_H__
@@ -35,8 +35,17 @@ void *copy_mem(OUT void *destination_buffer, IN const void *source_buffer,
 
 	pointer_dst = (uint8 *)destination_buffer;
 	pointer_src = (uint8 *)source_buffer;
-	while (length-- != 0) {
-		*(pointer_dst++) = *(pointer_src++);
+	if ((uintn)pointer_dst - (uintn)pointer_src < length) {
+		// destination overlaps the tail of source, copy backward
+		pointer_dst += length;
+		pointer_src += length;
+		while (length-- != 0) {
+			*(--pointer_dst) = *(--pointer_src);
+		}
+	} else {
+		while (length-- != 0) {
+			*(pointer_dst++) = *(pointer_src++);
+		}
 	}
 
 	return destination_buffer;
@@ -0,0 +1,39 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  secure_zero_mem() implementation.
+**/
+
+#include "base.h"
+
+/**
+  Fills a target buffer with zeros in a way that is not optimized away, and returns the
+  target buffer.
+
+  This function shall be used to clear secrets, such as keys, before the memory is released
+  or reused. Unlike zero_mem(), every byte is written through a volatile pointer.
+
+  If length > 0 and buffer is NULL, then ASSERT().
+  If length is greater than (MAX_ADDRESS - buffer + 1), then ASSERT().
+
+  @param  buffer      The pointer to the target buffer to fill with zeros.
+  @param  length      The number of bytes in buffer to fill with zeros.
+
+  @return buffer.
+
+**/
+void *secure_zero_mem(OUT void *buffer, IN uintn length)
+{
+	volatile uint8 *pointer;
+
+	pointer = (uint8 *)buffer;
+	while (length-- != 0) {
+		*(pointer++) = 0;
+	}
+
+	return buffer;
+}
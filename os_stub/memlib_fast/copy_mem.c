@@ -0,0 +1,154 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  copy_mem() implementation with word-size and vector loops.
+**/
+
+#include "memlib_fast_internal.h"
+
+/**
+  Copies one vector from source to destination. Both may be unaligned.
+
+  @param  pointer_dst   The destination of the vector.
+  @param  pointer_src   The source of the vector.
+**/
+#if MEMLIB_FAST_VECTOR_SIZE != 0
+static void internal_copy_vector(OUT uint8 *pointer_dst,
+				 IN const uint8 *pointer_src)
+{
+#if defined(MEMLIB_FAST_AVX2)
+	_mm256_storeu_si256((__m256i *)pointer_dst,
+			    _mm256_loadu_si256((const __m256i *)pointer_src));
+#elif defined(MEMLIB_FAST_SSE2)
+	_mm_storeu_si128((__m128i *)pointer_dst,
+			 _mm_loadu_si128((const __m128i *)pointer_src));
+#elif defined(MEMLIB_FAST_NEON)
+	vst1q_u8(pointer_dst, vld1q_u8(pointer_src));
+#endif
+}
+#endif
+
+/**
+  Copies a buffer from the lowest address up.
+
+  A vector or word is always loaded before it is stored, so this is safe if destination
+  is below source.
+
+  @param  pointer_dst   The pointer to the destination buffer.
+  @param  pointer_src   The pointer to the source buffer.
+  @param  length        The number of bytes to copy.
+**/
+static void internal_copy_mem_forward(OUT uint8 *pointer_dst,
+				      IN const uint8 *pointer_src,
+				      IN uintn length)
+{
+#if MEMLIB_FAST_VECTOR_SIZE != 0
+	while (length >= MEMLIB_FAST_VECTOR_SIZE) {
+		internal_copy_vector(pointer_dst, pointer_src);
+		pointer_dst += MEMLIB_FAST_VECTOR_SIZE;
+		pointer_src += MEMLIB_FAST_VECTOR_SIZE;
+		length -= MEMLIB_FAST_VECTOR_SIZE;
+	}
+#else
+	if ((((uintn)pointer_dst ^ (uintn)pointer_src) &
+	     MEMLIB_FAST_WORD_MASK) == 0) {
+		while ((length != 0) &&
+		       (((uintn)pointer_dst & MEMLIB_FAST_WORD_MASK) != 0)) {
+			*(pointer_dst++) = *(pointer_src++);
+			length--;
+		}
+		while (length >= sizeof(uintn)) {
+			*(uintn *)pointer_dst = *(const uintn *)pointer_src;
+			pointer_dst += sizeof(uintn);
+			pointer_src += sizeof(uintn);
+			length -= sizeof(uintn);
+		}
+	}
+#endif
+	while (length-- != 0) {
+		*(pointer_dst++) = *(pointer_src++);
+	}
+}
+
+/**
+  Copies a buffer from the highest address down.
+
+  This is used if destination overlaps the tail of source.
+
+  @param  pointer_dst   The pointer to the destination buffer.
+  @param  pointer_src   The pointer to the source buffer.
+  @param  length        The number of bytes to copy.
+**/
+static void internal_copy_mem_backward(OUT uint8 *pointer_dst,
+				       IN const uint8 *pointer_src,
+				       IN uintn length)
+{
+	pointer_dst += length;
+	pointer_src += length;
+#if MEMLIB_FAST_VECTOR_SIZE != 0
+	while (length >= MEMLIB_FAST_VECTOR_SIZE) {
+		pointer_dst -= MEMLIB_FAST_VECTOR_SIZE;
+		pointer_src -= MEMLIB_FAST_VECTOR_SIZE;
+		internal_copy_vector(pointer_dst, pointer_src);
+		length -= MEMLIB_FAST_VECTOR_SIZE;
+	}
+#else
+	if ((((uintn)pointer_dst ^ (uintn)pointer_src) &
+	     MEMLIB_FAST_WORD_MASK) == 0) {
+		while ((length != 0) &&
+		       (((uintn)pointer_dst & MEMLIB_FAST_WORD_MASK) != 0)) {
+			*(--pointer_dst) = *(--pointer_src);
+			length--;
+		}
+		while (length >= sizeof(uintn)) {
+			pointer_dst -= sizeof(uintn);
+			pointer_src -= sizeof(uintn);
+			*(uintn *)pointer_dst = *(const uintn *)pointer_src;
+			length -= sizeof(uintn);
+		}
+	}
+#endif
+	while (length-- != 0) {
+		*(--pointer_dst) = *(--pointer_src);
+	}
+}
+
+/**
+  Copies a source buffer to a destination buffer, and returns the destination buffer.
+
+  This function copies length bytes from source_buffer to destination_buffer, and returns
+  destination_buffer.  The implementation must be reentrant, and it must handle the case
+  where source_buffer overlaps destination_buffer.
+
+  If length is greater than (MAX_ADDRESS - destination_buffer + 1), then ASSERT().
+  If length is greater than (MAX_ADDRESS - source_buffer + 1), then ASSERT().
+
+  @param  destination_buffer   A pointer to the destination buffer of the memory copy.
+  @param  source_buffer        A pointer to the source buffer of the memory copy.
+  @param  length              The number of bytes to copy from source_buffer to destination_buffer.
+
+  @return destination_buffer.
+
+**/
+void *copy_mem(OUT void *destination_buffer, IN const void *source_buffer,
+	       IN uintn length)
+{
+	if ((length == 0) || (destination_buffer == source_buffer)) {
+		return destination_buffer;
+	}
+
+	if ((uintn)destination_buffer - (uintn)source_buffer < length) {
+		// destination overlaps the tail of source, copy backward
+		internal_copy_mem_backward(destination_buffer, source_buffer,
+					   length);
+	} else {
+		internal_copy_mem_forward(destination_buffer, source_buffer,
+					  length);
+	}
+
+	return destination_buffer;
+}
@@ -0,0 +1,35 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __MEMLIB_FAST_INTERNAL_H__
+#define __MEMLIB_FAST_INTERNAL_H__
+
+#include "base.h"
+
+//
+// Select the widest vector unit the compiler targets.
+// MEMLIB_FAST_VECTOR_SIZE is 0 if only the word-size loops are available.
+//
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MEMLIB_FAST_AVX2 1
+#define MEMLIB_FAST_VECTOR_SIZE 32
+#elif defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MEMLIB_FAST_SSE2 1
+#define MEMLIB_FAST_VECTOR_SIZE 16
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MEMLIB_FAST_NEON 1
+#define MEMLIB_FAST_VECTOR_SIZE 16
+#else
+#define MEMLIB_FAST_VECTOR_SIZE 0
+#endif
+
+#define MEMLIB_FAST_WORD_MASK (sizeof(uintn) - 1)
+
+#endif
@@ -0,0 +1,78 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  set_mem() implementation with word-size and vector loops.
+**/
+
+#include "memlib_fast_internal.h"
+
+/**
+  Fills a target buffer with a byte value, and returns the target buffer.
+
+  This function fills length bytes of buffer with value, and returns buffer.
+
+  If length is greater than (MAX_ADDRESS - buffer + 1), then ASSERT().
+
+  @param  buffer    The memory to set.
+  @param  length    The number of bytes to set.
+  @param  value     The value with which to fill length bytes of buffer.
+
+  @return buffer.
+
+**/
+void *set_mem(OUT void *buffer, IN uintn length, IN uint8 value)
+{
+	uint8 *pointer;
+	uintn value_word;
+#if defined(MEMLIB_FAST_AVX2)
+	__m256i value_vector;
+#elif defined(MEMLIB_FAST_SSE2)
+	__m128i value_vector;
+#elif defined(MEMLIB_FAST_NEON)
+	uint8x16_t value_vector;
+#endif
+
+	pointer = (uint8 *)buffer;
+
+#if MEMLIB_FAST_VECTOR_SIZE != 0
+#if defined(MEMLIB_FAST_AVX2)
+	value_vector = _mm256_set1_epi8((char)value);
+#elif defined(MEMLIB_FAST_SSE2)
+	value_vector = _mm_set1_epi8((char)value);
+#elif defined(MEMLIB_FAST_NEON)
+	value_vector = vdupq_n_u8(value);
+#endif
+	while (length >= MEMLIB_FAST_VECTOR_SIZE) {
+#if defined(MEMLIB_FAST_AVX2)
+		_mm256_storeu_si256((__m256i *)pointer, value_vector);
+#elif defined(MEMLIB_FAST_SSE2)
+		_mm_storeu_si128((__m128i *)pointer, value_vector);
+#elif defined(MEMLIB_FAST_NEON)
+		vst1q_u8(pointer, value_vector);
+#endif
+		pointer += MEMLIB_FAST_VECTOR_SIZE;
+		length -= MEMLIB_FAST_VECTOR_SIZE;
+	}
+#endif
+
+	// replicate value into every byte of a word
+	value_word = ((uintn)-1 / 0xFF) * value;
+	while ((length != 0) && (((uintn)pointer & MEMLIB_FAST_WORD_MASK) != 0)) {
+		*(pointer++) = value;
+		length--;
+	}
+	while (length >= sizeof(uintn)) {
+		*(uintn *)pointer = value_word;
+		pointer += sizeof(uintn);
+		length -= sizeof(uintn);
+	}
+	while (length-- != 0) {
+		*(pointer++) = value;
+	}
+
+	return buffer;
+}
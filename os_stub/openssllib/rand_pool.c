@@ -11,7 +11,7 @@
 #include <library/rnglib.h>
 
 /**
-  Calls RandomNumber64 to fill
+  Calls get_random_bytes to fill
   a buffer of arbitrary size with random bytes.
   This is a shim layer to rnglib.
 
@@ -24,37 +24,16 @@
 **/
 static boolean rand_get_bytes(IN uintn length, OUT uint8 *RandBuffer)
 {
-	boolean ret;
-	uint64 temp_rand;
-
-	ret = FALSE;
-
 	if (RandBuffer == NULL) {
 		DEBUG((DEBUG_ERROR,
 		       "[OPENSSL_RAND_POOL] NULL RandBuffer. No random numbers are generated and your system is not secure\n"));
 		ASSERT(RandBuffer !=
 		       NULL); // Since we can't generate random numbers, we should assert. Otherwise we will just blow up later.
-		return ret;
-	}
-
-	while (length > 0) {
-		// Use rnglib to get random number
-		ret = get_random_number_64(&temp_rand);
-
-		if (!ret) {
-			return ret;
-		}
-		if (length >= sizeof(temp_rand)) {
-			*((uint64 *)RandBuffer) = temp_rand;
-			RandBuffer += sizeof(uint64);
-			length -= sizeof(temp_rand);
-		} else {
-			copy_mem(RandBuffer, &temp_rand, length);
-			length = 0;
-		}
+		return FALSE;
 	}
 
-	return ret;
+	// Use rnglib to get random bytes
+	return get_random_bytes(RandBuffer, length);
 }
 
 /*
@@ -5,6 +5,7 @@
 **/
 
 #include <base.h>
+#include <library/memlib.h>
 #include <stdlib.h>
 
 /**
@@ -34,3 +35,36 @@ boolean get_random_number_64(OUT uint64 *rand_data)
 
 	return TRUE;
 }
+
+/**
+  Fills a buffer with random bytes.
+
+  if buffer is NULL and size is not 0, then ASSERT().
+
+  @param[out] buffer   buffer to fill with random bytes.
+  @param[in]  size     Number of bytes to fill.
+
+  @retval TRUE         Random bytes generated successfully.
+  @retval FALSE        Failed to generate the random bytes.
+
+**/
+boolean get_random_bytes(OUT uint8 *buffer, IN uintn size)
+{
+	uint64 temp_rand;
+
+	while (size > 0) {
+		if (!get_random_number_64(&temp_rand)) {
+			return FALSE;
+		}
+		if (size >= sizeof(temp_rand)) {
+			copy_mem(buffer, &temp_rand, sizeof(temp_rand));
+			buffer += sizeof(temp_rand);
+			size -= sizeof(temp_rand);
+		} else {
+			copy_mem(buffer, &temp_rand, size);
+			size = 0;
+		}
+	}
+
+	return TRUE;
+}
@@ -0,0 +1,293 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  HMAC_DRBG with SHA-256, as specified in NIST SP 800-90A.
+
+  SHA-256 is implemented here so that rnglib does not depend on cryptlib,
+  which itself takes its entropy from rnglib.
+**/
+
+#include "rnglib_drbg_internal.h"
+
+static const uint32 m_rng_drbg_sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+	0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+	0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+	0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+	0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+	0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define RNG_DRBG_ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void rng_drbg_sha256_transform(IN OUT rng_drbg_sha256_context_t *ctx,
+				      IN const uint8 *block)
+{
+	uint32 w[64];
+	uint32 a, b, c, d, e, f, g, h;
+	uint32 t1, t2;
+	uintn index;
+
+	for (index = 0; index < 16; index++) {
+		w[index] = ((uint32)block[index * 4] << 24) |
+			   ((uint32)block[index * 4 + 1] << 16) |
+			   ((uint32)block[index * 4 + 2] << 8) |
+			   (uint32)block[index * 4 + 3];
+	}
+	for (index = 16; index < 64; index++) {
+		t1 = RNG_DRBG_ROTR32(w[index - 2], 17) ^
+		     RNG_DRBG_ROTR32(w[index - 2], 19) ^ (w[index - 2] >> 10);
+		t2 = RNG_DRBG_ROTR32(w[index - 15], 7) ^
+		     RNG_DRBG_ROTR32(w[index - 15], 18) ^ (w[index - 15] >> 3);
+		w[index] = t1 + w[index - 7] + t2 + w[index - 16];
+	}
+
+	a = ctx->state[0];
+	b = ctx->state[1];
+	c = ctx->state[2];
+	d = ctx->state[3];
+	e = ctx->state[4];
+	f = ctx->state[5];
+	g = ctx->state[6];
+	h = ctx->state[7];
+	for (index = 0; index < 64; index++) {
+		t1 = h +
+		     (RNG_DRBG_ROTR32(e, 6) ^ RNG_DRBG_ROTR32(e, 11) ^
+		      RNG_DRBG_ROTR32(e, 25)) +
+		     ((e & f) ^ (~e & g)) + m_rng_drbg_sha256_k[index] + w[index];
+		t2 = (RNG_DRBG_ROTR32(a, 2) ^ RNG_DRBG_ROTR32(a, 13) ^
+		      RNG_DRBG_ROTR32(a, 22)) +
+		     ((a & b) ^ (a & c) ^ (b & c));
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+	ctx->state[0] += a;
+	ctx->state[1] += b;
+	ctx->state[2] += c;
+	ctx->state[3] += d;
+	ctx->state[4] += e;
+	ctx->state[5] += f;
+	ctx->state[6] += g;
+	ctx->state[7] += h;
+
+	secure_zero_mem(w, sizeof(w));
+}
+
+static void rng_drbg_sha256_init(OUT rng_drbg_sha256_context_t *ctx)
+{
+	ctx->state[0] = 0x6a09e667;
+	ctx->state[1] = 0xbb67ae85;
+	ctx->state[2] = 0x3c6ef372;
+	ctx->state[3] = 0xa54ff53a;
+	ctx->state[4] = 0x510e527f;
+	ctx->state[5] = 0x9b05688c;
+	ctx->state[6] = 0x1f83d9ab;
+	ctx->state[7] = 0x5be0cd19;
+	ctx->length = 0;
+	ctx->block_size = 0;
+}
+
+static void rng_drbg_sha256_update(IN OUT rng_drbg_sha256_context_t *ctx,
+				   IN const uint8 *data, IN uintn data_size)
+{
+	uintn copy_size;
+
+	ctx->length += data_size;
+	while (data_size > 0) {
+		if (ctx->block_size == 0 &&
+		    data_size >= RNG_DRBG_SHA256_BLOCK_SIZE) {
+			rng_drbg_sha256_transform(ctx, data);
+			data += RNG_DRBG_SHA256_BLOCK_SIZE;
+			data_size -= RNG_DRBG_SHA256_BLOCK_SIZE;
+			continue;
+		}
+		copy_size = RNG_DRBG_SHA256_BLOCK_SIZE - ctx->block_size;
+		if (copy_size > data_size) {
+			copy_size = data_size;
+		}
+		copy_mem(ctx->block + ctx->block_size, data, copy_size);
+		ctx->block_size += copy_size;
+		data += copy_size;
+		data_size -= copy_size;
+		if (ctx->block_size == RNG_DRBG_SHA256_BLOCK_SIZE) {
+			rng_drbg_sha256_transform(ctx, ctx->block);
+			ctx->block_size = 0;
+		}
+	}
+}
+
+static void rng_drbg_sha256_final(IN OUT rng_drbg_sha256_context_t *ctx,
+				  OUT uint8 *hash_value)
+{
+	uint64 bit_length;
+	uintn index;
+
+	bit_length = ctx->length * 8;
+	ctx->block[ctx->block_size++] = 0x80;
+	if (ctx->block_size > RNG_DRBG_SHA256_BLOCK_SIZE - 8) {
+		zero_mem(ctx->block + ctx->block_size,
+			 RNG_DRBG_SHA256_BLOCK_SIZE - ctx->block_size);
+		rng_drbg_sha256_transform(ctx, ctx->block);
+		ctx->block_size = 0;
+	}
+	zero_mem(ctx->block + ctx->block_size,
+		 RNG_DRBG_SHA256_BLOCK_SIZE - 8 - ctx->block_size);
+	for (index = 0; index < 8; index++) {
+		ctx->block[RNG_DRBG_SHA256_BLOCK_SIZE - 1 - index] =
+			(uint8)(bit_length >> (index * 8));
+	}
+	rng_drbg_sha256_transform(ctx, ctx->block);
+
+	for (index = 0; index < 8; index++) {
+		hash_value[index * 4] = (uint8)(ctx->state[index] >> 24);
+		hash_value[index * 4 + 1] = (uint8)(ctx->state[index] >> 16);
+		hash_value[index * 4 + 2] = (uint8)(ctx->state[index] >> 8);
+		hash_value[index * 4 + 3] = (uint8)ctx->state[index];
+	}
+	secure_zero_mem(ctx, sizeof(*ctx));
+}
+
+/**
+  Computes HMAC-SHA256 over the concatenation of up to three buffers.
+
+  @param  key         HMAC key, RNG_DRBG_SHA256_DIGEST_SIZE bytes.
+  @param  data1       First buffer. May be NULL if data1_size is 0.
+  @param  data1_size  size of data1 in bytes.
+  @param  data2       Second buffer. May be NULL if data2_size is 0.
+  @param  data2_size  size of data2 in bytes.
+  @param  data3       Third buffer. May be NULL if data3_size is 0.
+  @param  data3_size  size of data3 in bytes.
+  @param  hmac_value  Receives the RNG_DRBG_SHA256_DIGEST_SIZE byte HMAC value.
+**/
+void rng_drbg_hmac_sha256(IN const uint8 *key, IN const uint8 *data1,
+			  IN uintn data1_size, IN const uint8 *data2,
+			  IN uintn data2_size, IN const uint8 *data3,
+			  IN uintn data3_size, OUT uint8 *hmac_value)
+{
+	rng_drbg_sha256_context_t ctx;
+	uint8 pad[RNG_DRBG_SHA256_BLOCK_SIZE];
+	uint8 inner_hash[RNG_DRBG_SHA256_DIGEST_SIZE];
+	uintn index;
+
+	set_mem(pad, sizeof(pad), 0x36);
+	for (index = 0; index < RNG_DRBG_SHA256_DIGEST_SIZE; index++) {
+		pad[index] ^= key[index];
+	}
+	rng_drbg_sha256_init(&ctx);
+	rng_drbg_sha256_update(&ctx, pad, sizeof(pad));
+	rng_drbg_sha256_update(&ctx, data1, data1_size);
+	rng_drbg_sha256_update(&ctx, data2, data2_size);
+	rng_drbg_sha256_update(&ctx, data3, data3_size);
+	rng_drbg_sha256_final(&ctx, inner_hash);
+
+	for (index = 0; index < sizeof(pad); index++) {
+		pad[index] ^= 0x36 ^ 0x5c;
+	}
+	rng_drbg_sha256_init(&ctx);
+	rng_drbg_sha256_update(&ctx, pad, sizeof(pad));
+	rng_drbg_sha256_update(&ctx, inner_hash, sizeof(inner_hash));
+	rng_drbg_sha256_final(&ctx, hmac_value);
+
+	secure_zero_mem(pad, sizeof(pad));
+	secure_zero_mem(inner_hash, sizeof(inner_hash));
+}
+
+/**
+  HMAC_DRBG_Update: K = HMAC(K, V || 0x00 || provided_data), V = HMAC(K, V),
+  and once more with 0x01 if provided_data is not empty.
+**/
+static void rng_drbg_hmac_drbg_update(IN OUT rng_drbg_hmac_drbg_t *drbg,
+				      IN const uint8 *provided_data,
+				      IN uintn provided_data_size)
+{
+	uint8 separator;
+
+	for (separator = 0; separator < 2; separator++) {
+		rng_drbg_hmac_sha256(drbg->key, drbg->value,
+				     sizeof(drbg->value), &separator,
+				     sizeof(separator), provided_data,
+				     provided_data_size, drbg->key);
+		rng_drbg_hmac_sha256(drbg->key, drbg->value,
+				     sizeof(drbg->value), NULL, 0, NULL, 0,
+				     drbg->value);
+		if (provided_data_size == 0) {
+			break;
+		}
+	}
+}
+
+/**
+  Instantiates an HMAC_DRBG (SP 800-90A 10.1.2.3).
+
+  @param  drbg                  The DRBG state.
+  @param  seed_material         entropy_input || nonce || personalization_string.
+  @param  seed_material_size    size of seed_material in bytes.
+**/
+void rng_drbg_hmac_drbg_instantiate(OUT rng_drbg_hmac_drbg_t *drbg,
+				    IN const uint8 *seed_material,
+				    IN uintn seed_material_size)
+{
+	zero_mem(drbg->key, sizeof(drbg->key));
+	set_mem(drbg->value, sizeof(drbg->value), 0x01);
+	rng_drbg_hmac_drbg_update(drbg, seed_material, seed_material_size);
+	drbg->reseed_counter = 1;
+}
+
+/**
+  Reseeds an HMAC_DRBG (SP 800-90A 10.1.2.4).
+
+  @param  drbg          The DRBG state.
+  @param  entropy       The new entropy input.
+  @param  entropy_size  size of entropy in bytes.
+**/
+void rng_drbg_hmac_drbg_reseed(IN OUT rng_drbg_hmac_drbg_t *drbg,
+			       IN const uint8 *entropy, IN uintn entropy_size)
+{
+	rng_drbg_hmac_drbg_update(drbg, entropy, entropy_size);
+	drbg->reseed_counter = 1;
+}
+
+/**
+  Generates random bytes from an HMAC_DRBG (SP 800-90A 10.1.2.5).
+
+  The caller reseeds the DRBG when the reseed counter reaches its interval.
+
+  @param  drbg     The DRBG state.
+  @param  output   Receives the random bytes.
+  @param  size     Number of bytes to generate.
+**/
+void rng_drbg_hmac_drbg_generate(IN OUT rng_drbg_hmac_drbg_t *drbg,
+				 OUT uint8 *output, IN uintn size)
+{
+	uintn copy_size;
+
+	while (size > 0) {
+		rng_drbg_hmac_sha256(drbg->key, drbg->value,
+				     sizeof(drbg->value), NULL, 0, NULL, 0,
+				     drbg->value);
+		copy_size = size;
+		if (copy_size > sizeof(drbg->value)) {
+			copy_size = sizeof(drbg->value);
+		}
+		copy_mem(output, drbg->value, copy_size);
+		output += copy_size;
+		size -= copy_size;
+	}
+	rng_drbg_hmac_drbg_update(drbg, NULL, 0);
+	drbg->reseed_counter++;
+}
@@ -0,0 +1,245 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  rnglib backed by a per-thread HMAC_DRBG seeded from the operating system.
+**/
+
+//
+// System headers go first, base.h may change the default symbol visibility.
+//
+#ifdef _WIN32
+#include <windows.h>
+#include <bcrypt.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "bcrypt.lib")
+#endif
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+#endif
+
+#include "rnglib_drbg_internal.h"
+
+typedef struct {
+	boolean instantiated;
+#ifndef _WIN32
+	uint32 fork_generation;
+#endif
+	rng_drbg_hmac_drbg_t drbg;
+	uintn buffer_offset;
+	uint8 buffer[RNG_DRBG_BUFFER_SIZE];
+} rng_drbg_thread_state_t;
+
+static RNG_DRBG_THREAD_LOCAL rng_drbg_thread_state_t m_rng_drbg_state;
+
+#ifndef _WIN32
+//
+// Bumped in a forked child, so that the child does not replay the output
+// of the parent that was buffered or derived from the copied DRBG state.
+//
+static volatile uint32 m_rng_drbg_fork_generation;
+static pthread_once_t m_rng_drbg_atfork_once = PTHREAD_ONCE_INIT;
+
+static void rng_drbg_atfork_child(void)
+{
+	m_rng_drbg_fork_generation++;
+}
+
+static void rng_drbg_register_atfork(void)
+{
+	pthread_atfork(NULL, NULL, rng_drbg_atfork_child);
+}
+#endif
+
+/**
+  Reads seed bytes from the operating system entropy source.
+
+  @param  buffer   Receives the seed bytes.
+  @param  size     Number of bytes to read.
+
+  @retval TRUE     The buffer is filled.
+  @retval FALSE    The entropy source failed.
+**/
+boolean rng_drbg_get_entropy(OUT uint8 *buffer, IN uintn size)
+{
+#ifdef _WIN32
+	return BCRYPT_SUCCESS(BCryptGenRandom(NULL, buffer, (ULONG)size,
+					      BCRYPT_USE_SYSTEM_PREFERRED_RNG));
+#elif defined(__linux__)
+	ssize_t result;
+
+	while (size > 0) {
+		result = getrandom(buffer, size, 0);
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return FALSE;
+		}
+		buffer += result;
+		size -= (uintn)result;
+	}
+	return TRUE;
+#else
+	uintn chunk_size;
+
+	// getentropy() returns at most 256 bytes per call.
+	while (size > 0) {
+		chunk_size = size > 256 ? 256 : size;
+		if (getentropy(buffer, chunk_size) != 0) {
+			return FALSE;
+		}
+		buffer += chunk_size;
+		size -= chunk_size;
+	}
+	return TRUE;
+#endif
+}
+
+/**
+  Instantiates the DRBG of the calling thread on first use, and reseeds it
+  once RNG_DRBG_RESEED_INTERVAL generate calls have been made.
+
+  @retval TRUE     The DRBG is ready.
+  @retval FALSE    The entropy source failed.
+**/
+static boolean rng_drbg_prepare(IN OUT rng_drbg_thread_state_t *state)
+{
+	uint8 seed_material[RNG_DRBG_ENTROPY_SIZE + RNG_DRBG_NONCE_SIZE +
+			    sizeof(void *)];
+	void *personalization;
+
+	if (!state->instantiated) {
+		if (!rng_drbg_get_entropy(seed_material,
+					  RNG_DRBG_ENTROPY_SIZE +
+						  RNG_DRBG_NONCE_SIZE)) {
+			DEBUG((DEBUG_ERROR,
+			       "[RNGLIB_DRBG] OS entropy source failed\n"));
+			return FALSE;
+		}
+		// The address of the thread state tells threads apart.
+		personalization = state;
+		copy_mem(seed_material + RNG_DRBG_ENTROPY_SIZE +
+				 RNG_DRBG_NONCE_SIZE,
+			 &personalization, sizeof(personalization));
+		rng_drbg_hmac_drbg_instantiate(&state->drbg, seed_material,
+					       sizeof(seed_material));
+		secure_zero_mem(seed_material, sizeof(seed_material));
+#ifndef _WIN32
+		pthread_once(&m_rng_drbg_atfork_once, rng_drbg_register_atfork);
+		state->fork_generation = m_rng_drbg_fork_generation;
+#endif
+		state->buffer_offset = sizeof(state->buffer);
+		state->instantiated = TRUE;
+		return TRUE;
+	}
+
+	if (state->drbg.reseed_counter > RNG_DRBG_RESEED_INTERVAL) {
+		if (!rng_drbg_get_entropy(seed_material,
+					  RNG_DRBG_ENTROPY_SIZE)) {
+			DEBUG((DEBUG_ERROR,
+			       "[RNGLIB_DRBG] OS entropy source failed\n"));
+			return FALSE;
+		}
+		rng_drbg_hmac_drbg_reseed(&state->drbg, seed_material,
+					  RNG_DRBG_ENTROPY_SIZE);
+		secure_zero_mem(seed_material, RNG_DRBG_ENTROPY_SIZE);
+	}
+	return TRUE;
+}
+
+/**
+  Fills a buffer with random bytes.
+
+  Small requests are served from the per-thread output buffer, so one DRBG
+  generate call covers several nonces. Requests of at least the buffer size
+  are generated directly into the caller's buffer.
+
+  if buffer is NULL and size is not 0, then ASSERT().
+
+  @param[out] buffer   buffer to fill with random bytes.
+  @param[in]  size     Number of bytes to fill.
+
+  @retval TRUE         Random bytes generated successfully.
+  @retval FALSE        Failed to generate the random bytes.
+
+**/
+boolean get_random_bytes(OUT uint8 *buffer, IN uintn size)
+{
+	rng_drbg_thread_state_t *state;
+	uintn copy_size;
+
+	ASSERT(buffer != NULL || size == 0);
+
+	state = &m_rng_drbg_state;
+#ifndef _WIN32
+	if (state->fork_generation != m_rng_drbg_fork_generation) {
+		state->instantiated = FALSE;
+	}
+#endif
+	while (size > 0) {
+		if (state->buffer_offset == sizeof(state->buffer) ||
+		    !state->instantiated) {
+			if (!rng_drbg_prepare(state)) {
+				return FALSE;
+			}
+			if (size >= sizeof(state->buffer)) {
+				// Stay within the 2^19 bits SP 800-90A allows per request.
+				copy_size = size - size % sizeof(state->buffer);
+				if (copy_size > sizeof(state->buffer) * 64) {
+					copy_size = sizeof(state->buffer) * 64;
+				}
+				rng_drbg_hmac_drbg_generate(&state->drbg,
+							    buffer, copy_size);
+				buffer += copy_size;
+				size -= copy_size;
+				continue;
+			}
+			rng_drbg_hmac_drbg_generate(&state->drbg,
+						    state->buffer,
+						    sizeof(state->buffer));
+			state->buffer_offset = 0;
+		}
+
+		copy_size = sizeof(state->buffer) - state->buffer_offset;
+		if (copy_size > size) {
+			copy_size = size;
+		}
+		copy_mem(buffer, state->buffer + state->buffer_offset,
+			 copy_size);
+		// Bytes handed out are not kept around.
+		secure_zero_mem(state->buffer + state->buffer_offset,
+				copy_size);
+		state->buffer_offset += copy_size;
+		buffer += copy_size;
+		size -= copy_size;
+	}
+
+	return TRUE;
+}
+
+/**
+  Generates a 64-bit random number.
+
+  if rand is NULL, then ASSERT().
+
+  @param[out] rand_data     buffer pointer to store the 64-bit random value.
+
+  @retval TRUE         Random number generated successfully.
+  @retval FALSE        Failed to generate the random number.
+
+**/
+boolean get_random_number_64(OUT uint64 *rand_data)
+{
+	ASSERT(rand_data != NULL);
+
+	return get_random_bytes((uint8 *)rand_data, sizeof(*rand_data));
+}
@@ -0,0 +1,121 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __RNGLIB_DRBG_INTERNAL_H__
+#define __RNGLIB_DRBG_INTERNAL_H__
+
+#include "base.h"
+#include <library/memlib.h>
+#include <library/debuglib.h>
+#include <library/rnglib.h>
+
+//
+// Number of DRBG generate calls between two reseeds from the OS entropy source.
+// SP 800-90A allows up to 2^48 for HMAC_DRBG.
+//
+#ifndef RNG_DRBG_RESEED_INTERVAL
+#define RNG_DRBG_RESEED_INTERVAL 1024
+#endif
+
+//
+// Size of the per-thread output buffer refilled by one generate call.
+// Must not exceed the 2^19 bits SP 800-90A allows per request.
+//
+#ifndef RNG_DRBG_BUFFER_SIZE
+#define RNG_DRBG_BUFFER_SIZE 256
+#endif
+
+#if defined(_MSC_VER)
+#define RNG_DRBG_THREAD_LOCAL __declspec(thread)
+#else
+#define RNG_DRBG_THREAD_LOCAL __thread
+#endif
+
+#define RNG_DRBG_SHA256_DIGEST_SIZE 32
+#define RNG_DRBG_SHA256_BLOCK_SIZE 64
+
+//
+// Entropy input and nonce for instantiate, entropy input for reseed.
+// The security strength of HMAC_DRBG with SHA-256 is 256 bits.
+//
+#define RNG_DRBG_ENTROPY_SIZE 32
+#define RNG_DRBG_NONCE_SIZE 16
+
+typedef struct {
+	uint32 state[8];
+	uint64 length;
+	uint8 block[RNG_DRBG_SHA256_BLOCK_SIZE];
+	uintn block_size;
+} rng_drbg_sha256_context_t;
+
+typedef struct {
+	uint8 key[RNG_DRBG_SHA256_DIGEST_SIZE];
+	uint8 value[RNG_DRBG_SHA256_DIGEST_SIZE];
+	uint64 reseed_counter;
+} rng_drbg_hmac_drbg_t;
+
+/**
+  Computes HMAC-SHA256 over the concatenation of up to three buffers.
+
+  @param  key         HMAC key, RNG_DRBG_SHA256_DIGEST_SIZE bytes.
+  @param  data1       First buffer. May be NULL if data1_size is 0.
+  @param  data1_size  size of data1 in bytes.
+  @param  data2       Second buffer. May be NULL if data2_size is 0.
+  @param  data2_size  size of data2 in bytes.
+  @param  data3       Third buffer. May be NULL if data3_size is 0.
+  @param  data3_size  size of data3 in bytes.
+  @param  hmac_value  Receives the RNG_DRBG_SHA256_DIGEST_SIZE byte HMAC value.
+**/
+void rng_drbg_hmac_sha256(IN const uint8 *key, IN const uint8 *data1,
+			  IN uintn data1_size, IN const uint8 *data2,
+			  IN uintn data2_size, IN const uint8 *data3,
+			  IN uintn data3_size, OUT uint8 *hmac_value);
+
+/**
+  Instantiates an HMAC_DRBG (SP 800-90A 10.1.2.3).
+
+  @param  drbg                  The DRBG state.
+  @param  seed_material         entropy_input || nonce || personalization_string.
+  @param  seed_material_size    size of seed_material in bytes.
+**/
+void rng_drbg_hmac_drbg_instantiate(OUT rng_drbg_hmac_drbg_t *drbg,
+				    IN const uint8 *seed_material,
+				    IN uintn seed_material_size);
+
+/**
+  Reseeds an HMAC_DRBG (SP 800-90A 10.1.2.4).
+
+  @param  drbg          The DRBG state.
+  @param  entropy       The new entropy input.
+  @param  entropy_size  size of entropy in bytes.
+**/
+void rng_drbg_hmac_drbg_reseed(IN OUT rng_drbg_hmac_drbg_t *drbg,
+			       IN const uint8 *entropy, IN uintn entropy_size);
+
+/**
+  Generates random bytes from an HMAC_DRBG (SP 800-90A 10.1.2.5).
+
+  The caller reseeds the DRBG when the reseed counter reaches its interval.
+
+  @param  drbg     The DRBG state.
+  @param  output   Receives the random bytes.
+  @param  size     Number of bytes to generate.
+**/
+void rng_drbg_hmac_drbg_generate(IN OUT rng_drbg_hmac_drbg_t *drbg,
+				 OUT uint8 *output, IN uintn size);
+
+/**
+  Reads seed bytes from the operating system entropy source.
+
+  @param  buffer   Receives the seed bytes.
+  @param  size     Number of bytes to read.
+
+  @retval TRUE     The buffer is filled.
+  @retval FALSE    The entropy source failed.
+**/
+boolean rng_drbg_get_entropy(OUT uint8 *buffer, IN uintn size);
+
+#endif
@@ -95,6 +95,363 @@ boolean read_requester_private_certificate(IN uint16 req_base_asym_alg,
 	return res;
 }
 
+//
+// Parsed private keys, keyed by (role, asym algo, slot).
+// The signing interface carries no slot ID, so signing uses the key of
+// PRIVATE_KEY_CACHE_DEFAULT_SLOT_ID. The sample keys are the same for all slots.
+// The cache is shared by all the SPDM contexts of the process, so every access
+// is done with the registered lock held.
+//
+spdm_private_key_cache_entry_t m_private_key_cache[MAX_PRIVATE_KEY_CACHE_COUNT];
+uint64 m_private_key_cache_use_count;
+uintn m_private_key_cache_hit_count;
+uintn m_private_key_cache_miss_count;
+spdm_private_key_cache_lock_func m_private_key_cache_acquire_lock;
+spdm_private_key_cache_lock_func m_private_key_cache_release_lock;
+void *m_private_key_cache_lock_context;
+
+/**
+  Register the lock serializing the access to the private key cache.
+
+  The lock must be registered before the SPDM contexts of several threads sign
+  with the cached keys, and must not be changed while a key is in use.
+
+  @param  acquire_lock                  The function to acquire the lock, or NULL for a single thread.
+  @param  release_lock                  The function to release the lock, or NULL for a single thread.
+  @param  lock_context                  The lock context passed to the functions.
+**/
+void spdm_private_key_cache_register_lock_func(
+	IN spdm_private_key_cache_lock_func acquire_lock OPTIONAL,
+	IN spdm_private_key_cache_lock_func release_lock OPTIONAL,
+	IN void *lock_context OPTIONAL)
+{
+	m_private_key_cache_acquire_lock = acquire_lock;
+	m_private_key_cache_release_lock = release_lock;
+	m_private_key_cache_lock_context = lock_context;
+}
+
+/**
+  Acquire the lock of the private key cache, if any.
+**/
+static void spdm_private_key_cache_lock(void)
+{
+	if (m_private_key_cache_acquire_lock != NULL) {
+		m_private_key_cache_acquire_lock(
+			m_private_key_cache_lock_context);
+	}
+}
+
+/**
+  Release the lock of the private key cache, if any.
+**/
+static void spdm_private_key_cache_unlock(void)
+{
+	if (m_private_key_cache_release_lock != NULL) {
+		m_private_key_cache_release_lock(
+			m_private_key_cache_lock_context);
+	}
+}
+
+/**
+  Find the cache entry of a private key.
+
+  The caller must hold the lock of the private key cache.
+
+  @param  is_requester                  Indicates if it is a requester key.
+  @param  asym_algo                     Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the key.
+
+  @return the cache entry, or NULL if the key is not cached.
+**/
+spdm_private_key_cache_entry_t *
+spdm_private_key_cache_find(IN boolean is_requester, IN uint32 asym_algo,
+			    IN uint8 slot_id)
+{
+	uintn index;
+
+	for (index = 0; index < MAX_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if (m_private_key_cache[index].context != NULL &&
+		    m_private_key_cache[index].is_requester == is_requester &&
+		    m_private_key_cache[index].asym_algo == asym_algo &&
+		    m_private_key_cache[index].slot_id == slot_id) {
+			return &m_private_key_cache[index];
+		}
+	}
+	return NULL;
+}
+
+/**
+  Release the private key held by a cache entry.
+
+  The caller must hold the lock of the private key cache.
+
+  @param  entry                         The cache entry.
+**/
+void spdm_private_key_cache_release(IN spdm_private_key_cache_entry_t *entry)
+{
+	if (entry->is_requester) {
+		spdm_req_asym_free((uint16)entry->asym_algo, entry->context);
+	} else {
+		spdm_asym_free(entry->asym_algo, entry->context);
+	}
+	zero_mem(entry, sizeof(spdm_private_key_cache_entry_t));
+}
+
+/**
+  Return the parsed private key of (role, asym algo, slot), loading it into
+  the cache on a miss. If the cache is full, the least recently used key is released.
+
+  The caller must hold the lock of the private key cache until it is done with the key,
+  because another thread may release it once the lock is released.
+
+  @param  is_requester                  Indicates if it is a requester key.
+  @param  asym_algo                     Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the key.
+
+  @return the parsed private key context, or NULL if it cannot be loaded.
+**/
+void *spdm_private_key_cache_get(IN boolean is_requester, IN uint32 asym_algo,
+				 IN uint8 slot_id)
+{
+	spdm_private_key_cache_entry_t *entry;
+	void *context;
+	void *private_pem;
+	uintn private_pem_size;
+	uintn index;
+	boolean result;
+
+	m_private_key_cache_use_count++;
+
+	entry = spdm_private_key_cache_find(is_requester, asym_algo, slot_id);
+	if (entry != NULL) {
+		m_private_key_cache_hit_count++;
+		entry->last_use = m_private_key_cache_use_count;
+		return entry->context;
+	}
+	m_private_key_cache_miss_count++;
+
+	if (is_requester) {
+		result = read_requester_private_certificate(
+			(uint16)asym_algo, &private_pem, &private_pem_size);
+	} else {
+		result = read_responder_private_certificate(
+			asym_algo, &private_pem, &private_pem_size);
+	}
+	if (!result) {
+		return NULL;
+	}
+
+	if (is_requester) {
+		result = spdm_req_asym_get_private_key_from_pem(
+			(uint16)asym_algo, private_pem, private_pem_size, NULL,
+			&context);
+	} else {
+		result = spdm_asym_get_private_key_from_pem(
+			asym_algo, private_pem, private_pem_size, NULL,
+			&context);
+	}
+	secure_zero_mem(private_pem, private_pem_size);
+	free(private_pem);
+	if (!result) {
+		return NULL;
+	}
+
+	for (index = 0; index < MAX_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if (m_private_key_cache[index].context == NULL) {
+			entry = &m_private_key_cache[index];
+			break;
+		}
+		if ((entry == NULL) ||
+		    (m_private_key_cache[index].last_use < entry->last_use)) {
+			entry = &m_private_key_cache[index];
+		}
+	}
+	if (entry->context != NULL) {
+		spdm_private_key_cache_release(entry);
+	}
+
+	entry->is_requester = is_requester;
+	entry->asym_algo = asym_algo;
+	entry->slot_id = slot_id;
+	entry->last_use = m_private_key_cache_use_count;
+	entry->context = context;
+	return context;
+}
+
+/**
+  Load the responder private key of a slot into the private key cache.
+
+  The key is read and parsed once, and reused by every subsequent
+  spdm_responder_data_sign() until it is unloaded, evicted or invalidated.
+  Loading a key that is already cached is a no-op.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+
+  @retval TRUE  the private key is loaded.
+  @retval FALSE the private key cannot be loaded.
+**/
+boolean spdm_responder_private_key_load(IN uint32 base_asym_algo,
+					IN uint8 slot_id)
+{
+	boolean result;
+
+	spdm_private_key_cache_lock();
+	result = spdm_private_key_cache_get(FALSE, base_asym_algo, slot_id) !=
+		 NULL;
+	spdm_private_key_cache_unlock();
+	return result;
+}
+
+/**
+  Unload the responder private key of a slot from the private key cache.
+
+  @param  base_asym_algo                 Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+**/
+void spdm_responder_private_key_unload(IN uint32 base_asym_algo,
+				       IN uint8 slot_id)
+{
+	spdm_private_key_cache_entry_t *entry;
+
+	spdm_private_key_cache_lock();
+	entry = spdm_private_key_cache_find(FALSE, base_asym_algo, slot_id);
+	if (entry != NULL) {
+		spdm_private_key_cache_release(entry);
+	}
+	spdm_private_key_cache_unlock();
+}
+
+/**
+  Load the requester private key of a slot into the private key cache.
+
+  The key is read and parsed once, and reused by every subsequent
+  spdm_requester_data_sign() until it is unloaded, evicted or invalidated.
+  Loading a key that is already cached is a no-op.
+
+  @param  req_base_asym_alg               Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+
+  @retval TRUE  the private key is loaded.
+  @retval FALSE the private key cannot be loaded.
+**/
+boolean spdm_requester_private_key_load(IN uint16 req_base_asym_alg,
+					IN uint8 slot_id)
+{
+	boolean result;
+
+	spdm_private_key_cache_lock();
+	result = spdm_private_key_cache_get(TRUE, req_base_asym_alg, slot_id) !=
+		 NULL;
+	spdm_private_key_cache_unlock();
+	return result;
+}
+
+/**
+  Unload the requester private key of a slot from the private key cache.
+
+  @param  req_base_asym_alg               Indicates the signing algorithm.
+  @param  slot_id                       The slot ID of the certificate chain that the key belongs to.
+**/
+void spdm_requester_private_key_unload(IN uint16 req_base_asym_alg,
+				       IN uint8 slot_id)
+{
+	spdm_private_key_cache_entry_t *entry;
+
+	spdm_private_key_cache_lock();
+	entry = spdm_private_key_cache_find(TRUE, req_base_asym_alg, slot_id);
+	if (entry != NULL) {
+		spdm_private_key_cache_release(entry);
+	}
+	spdm_private_key_cache_unlock();
+}
+
+/**
+  Release all the cached private keys.
+
+  It must be called when the provisioned private keys change, so that the next
+  signing operation reloads them.
+**/
+void spdm_private_key_cache_invalidate(void)
+{
+	uintn index;
+
+	spdm_private_key_cache_lock();
+	for (index = 0; index < MAX_PRIVATE_KEY_CACHE_COUNT; index++) {
+		if (m_private_key_cache[index].context != NULL) {
+			spdm_private_key_cache_release(
+				&m_private_key_cache[index]);
+		}
+	}
+	spdm_private_key_cache_unlock();
+}
+
+/**
+  Return the number of private key lookups answered and missed by the private key cache.
+
+  @param  hit_count                     The number of keys found in the cache.
+  @param  miss_count                    The number of keys read and parsed.
+**/
+void spdm_private_key_cache_get_stats(OUT uintn *hit_count,
+				      OUT uintn *miss_count)
+{
+	spdm_private_key_cache_lock();
+	*hit_count = m_private_key_cache_hit_count;
+	*miss_count = m_private_key_cache_miss_count;
+	spdm_private_key_cache_unlock();
+}
+
+/**
+  Fill one sample device measurement block.
+
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+  @param  index                        The zero-based index of the measurement block.
+  @param  MeasurementBlock             A pointer to a destination buffer to store the measurement block.
+
+  @return the size in bytes of the measurement block.
+**/
+uintn spdm_measurement_fill_block(IN uint32 measurement_hash_algo,
+				  IN uint8 index,
+				  OUT spdm_measurement_block_dmtf_t *MeasurementBlock)
+{
+	uintn hash_size;
+	uint8 data[MEASUREMENT_MANIFEST_SIZE];
+
+	hash_size = spdm_get_measurement_hash_size(measurement_hash_algo);
+
+	MeasurementBlock->Measurement_block_common_header.index = index + 1;
+	MeasurementBlock->Measurement_block_common_header
+		.measurement_specification =
+		SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+	if ((index < 4) && (hash_size != 0xFFFFFFFF)) {
+		MeasurementBlock->Measurement_block_dmtf_header
+			.dmtf_spec_measurement_value_type = index;
+		MeasurementBlock->Measurement_block_dmtf_header
+			.dmtf_spec_measurement_value_size = (uint16)hash_size;
+	} else {
+		MeasurementBlock->Measurement_block_dmtf_header
+			.dmtf_spec_measurement_value_type =
+			index |
+			SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
+		MeasurementBlock->Measurement_block_dmtf_header
+			.dmtf_spec_measurement_value_size = (uint16)sizeof(data);
+	}
+	MeasurementBlock->Measurement_block_common_header.measurement_size =
+		(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
+			 MeasurementBlock->Measurement_block_dmtf_header
+				 .dmtf_spec_measurement_value_size);
+	set_mem(data, sizeof(data), (uint8)(index + 1));
+	if ((index < 4) && (hash_size != 0xFFFFFFFF)) {
+		spdm_measurement_hash_all(measurement_hash_algo, data,
+					  sizeof(data),
+					  (void *)(MeasurementBlock + 1));
+		return sizeof(spdm_measurement_block_dmtf_t) + hash_size;
+	} else {
+		copy_mem((void *)(MeasurementBlock + 1), data, sizeof(data));
+		return sizeof(spdm_measurement_block_dmtf_t) + sizeof(data);
+	}
+}
+
 /**
   Collect the device measurement.
 
@@ -118,10 +475,9 @@ boolean spdm_measurement_collection(
 				    OUT void *device_measurement,
 				    IN OUT uintn *device_measurement_size)
 {
-	spdm_measurement_block_dmtf_t *MeasurementBlock;
+	uint8 *MeasurementBlock;
 	uintn hash_size;
 	uint8 index;
-	uint8 data[MEASUREMENT_MANIFEST_SIZE];
 	uintn total_size;
 
 	ASSERT(measurement_specification ==
@@ -140,66 +496,116 @@ boolean spdm_measurement_collection(
 			(MEASUREMENT_BLOCK_NUMBER - 1) *
 				(sizeof(spdm_measurement_block_dmtf_t) +
 				 hash_size) +
-			(sizeof(spdm_measurement_block_dmtf_t) + sizeof(data));
+			(sizeof(spdm_measurement_block_dmtf_t) +
+			 MEASUREMENT_MANIFEST_SIZE);
 	} else {
 		total_size =
 			(MEASUREMENT_BLOCK_NUMBER - 1) *
 				(sizeof(spdm_measurement_block_dmtf_t) +
-				 sizeof(data)) +
-			(sizeof(spdm_measurement_block_dmtf_t) + sizeof(data));
+				 MEASUREMENT_MANIFEST_SIZE) +
+			(sizeof(spdm_measurement_block_dmtf_t) +
+			 MEASUREMENT_MANIFEST_SIZE);
 	}
 	ASSERT(*device_measurement_size >= total_size);
 	*device_measurement_size = total_size;
 
 	MeasurementBlock = device_measurement;
 	for (index = 0; index < MEASUREMENT_BLOCK_NUMBER; index++) {
-		MeasurementBlock->Measurement_block_common_header.index =
-			index + 1;
-		MeasurementBlock->Measurement_block_common_header
-			.measurement_specification =
-			SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
-		if ((index < 4) && (hash_size != 0xFFFFFFFF)) {
-			MeasurementBlock->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_type = index;
-			MeasurementBlock->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_size =
-				(uint16)hash_size;
-		} else {
-			MeasurementBlock->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_type =
-				index |
-				SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
-			MeasurementBlock->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_size =
-				(uint16)sizeof(data);
-		}
-		MeasurementBlock->Measurement_block_common_header
-			.measurement_size =
-			(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
-				 MeasurementBlock->Measurement_block_dmtf_header
-					 .dmtf_spec_measurement_value_size);
-		set_mem(data, sizeof(data), (uint8)(index + 1));
-		if ((index < 4) && (hash_size != 0xFFFFFFFF)) {
-			spdm_measurement_hash_all(
-				measurement_hash_algo, data, sizeof(data),
-				(void *)(MeasurementBlock + 1));
-			MeasurementBlock =
-				(void *)((uint8 *)MeasurementBlock +
-					 sizeof(spdm_measurement_block_dmtf_t) +
-					 hash_size);
-		} else {
-			copy_mem((void *)(MeasurementBlock + 1), data,
-				 sizeof(data));
-			MeasurementBlock =
-				(void *)((uint8 *)MeasurementBlock +
-					 sizeof(spdm_measurement_block_dmtf_t) +
-					 sizeof(data));
-		}
+		MeasurementBlock += spdm_measurement_fill_block(
+			measurement_hash_algo, index, (void *)MeasurementBlock);
 	}
 
 	return TRUE;
 }
 
+/**
+  Query the count of the device measurement blocks.
+
+  @param  measurement_specification     Indicates the measurement specification.
+                                       It must align with measurement_specification (SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_*)
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+                                       It must align with measurement_hash_algo (SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_*)
+  @param  device_measurement_count       The count of the device measurement block.
+
+  @retval RETURN_SUCCESS               The count of the device measurement block is returned.
+  @retval RETURN_UNSUPPORTED           The count query is not provided. The caller shall use spdm_measurement_collection.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+return_status spdm_measurement_collection_count(
+	IN spdm_version_number_t spdm_version,
+	IN uint8 measurement_specification, IN uint32 measurement_hash_algo,
+	OUT uint8 *device_measurement_count)
+{
+	ASSERT(measurement_specification ==
+	       SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF);
+	if (measurement_specification !=
+	    SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	*device_measurement_count = MEASUREMENT_BLOCK_NUMBER;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Collect one device measurement block.
+
+  @param  measurement_specification     Indicates the measurement specification.
+                                       It must align with measurement_specification (SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_*)
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+                                       It must align with measurement_hash_algo (SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_*)
+  @param  measurement_index             The index of the measurement block (1 ~ 0xFE).
+  @param  device_measurement            A pointer to a destination buffer to store the device measurement block.
+  @param  device_measurement_size        On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the device measurement block in the buffer.
+
+  @retval RETURN_SUCCESS               The device measurement block is returned.
+  @retval RETURN_NOT_FOUND             The device has no measurement block with this index.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the device measurement block.
+  @retval RETURN_UNSUPPORTED           Per-index collection is not provided. The caller shall use spdm_measurement_collection.
+  @retval RETURN_DEVICE_ERROR          The device measurement collection fail.
+**/
+return_status spdm_measurement_collection_by_index(
+	IN spdm_version_number_t spdm_version,
+	IN uint8 measurement_specification, IN uint32 measurement_hash_algo,
+	IN uint8 measurement_index, OUT void *device_measurement,
+	IN OUT uintn *device_measurement_size)
+{
+	uintn hash_size;
+	uintn block_size;
+
+	ASSERT(measurement_specification ==
+	       SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF);
+	if (measurement_specification !=
+	    SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	if ((measurement_index == 0) ||
+	    (measurement_index > MEASUREMENT_BLOCK_NUMBER)) {
+		return RETURN_NOT_FOUND;
+	}
+
+	hash_size = spdm_get_measurement_hash_size(measurement_hash_algo);
+	ASSERT(hash_size != 0);
+
+	if ((measurement_index <= 4) && (hash_size != 0xFFFFFFFF)) {
+		block_size = sizeof(spdm_measurement_block_dmtf_t) + hash_size;
+	} else {
+		block_size = sizeof(spdm_measurement_block_dmtf_t) +
+			     MEASUREMENT_MANIFEST_SIZE;
+	}
+	if (*device_measurement_size < block_size) {
+		*device_measurement_size = block_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+	*device_measurement_size = spdm_measurement_fill_block(
+		measurement_hash_algo, measurement_index - 1,
+		device_measurement);
+	return RETURN_SUCCESS;
+}
+
 /**
   Sign an SPDM message data.
 
@@ -222,21 +628,17 @@ boolean spdm_requester_data_sign(
 				 OUT uint8 *signature, IN OUT uintn *sig_size)
 {
 	void *context;
-	void *private_pem;
-	uintn private_pem_size;
 	boolean result;
 
-	result = read_requester_private_certificate(
-		req_base_asym_alg, &private_pem, &private_pem_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_req_asym_get_private_key_from_pem(req_base_asym_alg,
-							private_pem,
-							private_pem_size, NULL,
-							&context);
-	if (!result) {
+	//
+	// The key is used with the lock held, so that it is not released by
+	// another thread, and the key context is not shared while signing.
+	//
+	spdm_private_key_cache_lock();
+	context = spdm_private_key_cache_get(TRUE, req_base_asym_alg,
+					     PRIVATE_KEY_CACHE_DEFAULT_SLOT_ID);
+	if (context == NULL) {
+		spdm_private_key_cache_unlock();
 		return FALSE;
 	}
 	if (is_data_hash) {
@@ -246,8 +648,7 @@ boolean spdm_requester_data_sign(
 		result = spdm_req_asym_sign(spdm_version, op_code, req_base_asym_alg, base_hash_algo, context,
 						message, message_size, signature, sig_size);
 	}
-	spdm_req_asym_free(req_base_asym_alg, context);
-	free(private_pem);
+	spdm_private_key_cache_unlock();
 
 	return result;
 }
@@ -274,19 +675,17 @@ boolean spdm_responder_data_sign(
 				 OUT uint8 *signature, IN OUT uintn *sig_size)
 {
 	void *context;
-	void *private_pem;
-	uintn private_pem_size;
 	boolean result;
 
-	result = read_responder_private_certificate(
-		base_asym_algo, &private_pem, &private_pem_size);
-	if (!result) {
-		return FALSE;
-	}
-
-	result = spdm_asym_get_private_key_from_pem(
-		base_asym_algo, private_pem, private_pem_size, NULL, &context);
-	if (!result) {
+	//
+	// The key is used with the lock held, so that it is not released by
+	// another thread, and the key context is not shared while signing.
+	//
+	spdm_private_key_cache_lock();
+	context = spdm_private_key_cache_get(FALSE, base_asym_algo,
+					     PRIVATE_KEY_CACHE_DEFAULT_SLOT_ID);
+	if (context == NULL) {
+		spdm_private_key_cache_unlock();
 		return FALSE;
 	}
 	if (is_data_hash) {
@@ -296,8 +695,7 @@ boolean spdm_responder_data_sign(
 		result = spdm_asym_sign(spdm_version, op_code, base_asym_algo, base_hash_algo, context,
 					message, message_size, signature, sig_size);
 	}
-	spdm_asym_free(base_asym_algo, context);
-	free(private_pem);
+	spdm_private_key_cache_unlock();
 
 	return result;
 }
@@ -364,7 +762,7 @@ boolean spdm_psk_handshake_secret_hkdf_expand(
 
 	result = spdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
 				  info, info_size, out, out_size);
-	zero_mem(handshake_secret, hash_size);
+	secure_zero_mem(handshake_secret, hash_size);
 
 	return result;
 }
@@ -425,21 +823,21 @@ boolean spdm_psk_master_secret_hkdf_expand(
 	result = spdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
 				  m_bin_str0, sizeof(m_bin_str0), salt1,
 				  hash_size);
-	zero_mem(handshake_secret, hash_size);
+	secure_zero_mem(handshake_secret, hash_size);
 	if (!result) {
 		return result;
 	}
 
 	result = spdm_hmac_all(base_hash_algo, m_my_zero_filled_buffer,
 			       hash_size, salt1, hash_size, master_secret);
-	zero_mem(salt1, hash_size);
+	secure_zero_mem(salt1, hash_size);
 	if (!result) {
 		return result;
 	}
 
 	result = spdm_hkdf_expand(base_hash_algo, master_secret, hash_size,
 				  info, info_size, out, out_size);
-	zero_mem(master_secret, hash_size);
+	secure_zero_mem(master_secret, hash_size);
 
 	return result;
 }
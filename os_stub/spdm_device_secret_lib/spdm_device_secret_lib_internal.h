@@ -25,6 +25,20 @@
 #define TEST_CERT_MAXUINT16_LARGER 3
 #define TEST_CERT_SMALL 4
 
+//
+// private key cache
+//
+#define MAX_PRIVATE_KEY_CACHE_COUNT 16
+#define PRIVATE_KEY_CACHE_DEFAULT_SLOT_ID 0
+
+typedef struct {
+	boolean is_requester;
+	uint32 asym_algo;
+	uint8 slot_id;
+	uint64 last_use;
+	void *context;
+} spdm_private_key_cache_entry_t;
+
 //
 // public cert
 //
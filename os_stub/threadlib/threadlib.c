@@ -0,0 +1,322 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <base.h>
+#include <library/threadlib.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+typedef struct {
+	thread_start_func start_func;
+	void *context;
+#ifdef _WIN32
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+} thread_info_t;
+
+#ifndef _WIN32
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	boolean signaled;
+} event_info_t;
+#endif
+
+#ifdef _WIN32
+DWORD WINAPI thread_entry(IN LPVOID parameter)
+{
+	thread_info_t *thread_info;
+
+	thread_info = parameter;
+	thread_info->start_func(thread_info->context);
+	return 0;
+}
+#else
+void *thread_entry(IN void *parameter)
+{
+	thread_info_t *thread_info;
+
+	thread_info = parameter;
+	thread_info->start_func(thread_info->context);
+	return NULL;
+}
+#endif
+
+/**
+  Creates a thread and starts it.
+
+  @param  start_func                    The entry point of the thread.
+  @param  context                      The context passed to the entry point.
+
+  @return A handle of the thread, or NULL if the thread cannot be created.
+**/
+void *thread_create(IN thread_start_func start_func, IN void *context)
+{
+	thread_info_t *thread_info;
+
+	thread_info = malloc(sizeof(thread_info_t));
+	if (thread_info == NULL) {
+		return NULL;
+	}
+	thread_info->start_func = start_func;
+	thread_info->context = context;
+#ifdef _WIN32
+	thread_info->handle =
+		CreateThread(NULL, 0, thread_entry, thread_info, 0, NULL);
+	if (thread_info->handle == NULL) {
+		free(thread_info);
+		return NULL;
+	}
+#else
+	if (pthread_create(&thread_info->handle, NULL, thread_entry,
+			   thread_info) != 0) {
+		free(thread_info);
+		return NULL;
+	}
+#endif
+	return thread_info;
+}
+
+/**
+  Waits for a thread to exit, and frees the handle of the thread.
+
+  @param  thread                       The handle of the thread.
+**/
+void thread_join(IN void *thread)
+{
+	thread_info_t *thread_info;
+
+	thread_info = thread;
+#ifdef _WIN32
+	WaitForSingleObject(thread_info->handle, INFINITE);
+	CloseHandle(thread_info->handle);
+#else
+	pthread_join(thread_info->handle, NULL);
+#endif
+	free(thread_info);
+}
+
+/**
+  Creates a mutex.
+
+  @return A handle of the mutex, or NULL if the mutex cannot be created.
+**/
+void *mutex_create(void)
+{
+#ifdef _WIN32
+	CRITICAL_SECTION *mutex;
+
+	mutex = malloc(sizeof(CRITICAL_SECTION));
+	if (mutex == NULL) {
+		return NULL;
+	}
+	InitializeCriticalSection(mutex);
+#else
+	pthread_mutex_t *mutex;
+
+	mutex = malloc(sizeof(pthread_mutex_t));
+	if (mutex == NULL) {
+		return NULL;
+	}
+	if (pthread_mutex_init(mutex, NULL) != 0) {
+		free(mutex);
+		return NULL;
+	}
+#endif
+	return mutex;
+}
+
+/**
+  Frees a mutex. The mutex must not be owned.
+
+  @param  mutex                        The handle of the mutex.
+**/
+void mutex_free(IN void *mutex)
+{
+#ifdef _WIN32
+	DeleteCriticalSection(mutex);
+#else
+	pthread_mutex_destroy(mutex);
+#endif
+	free(mutex);
+}
+
+/**
+  Waits until a mutex is owned by the calling thread.
+
+  @param  mutex                        The handle of the mutex.
+**/
+void mutex_acquire(IN void *mutex)
+{
+#ifdef _WIN32
+	EnterCriticalSection(mutex);
+#else
+	pthread_mutex_lock(mutex);
+#endif
+}
+
+/**
+  Releases a mutex owned by the calling thread.
+
+  @param  mutex                        The handle of the mutex.
+**/
+void mutex_release(IN void *mutex)
+{
+#ifdef _WIN32
+	LeaveCriticalSection(mutex);
+#else
+	pthread_mutex_unlock(mutex);
+#endif
+}
+
+/**
+  Creates an auto-reset event, initially not signaled.
+
+  @return A handle of the event, or NULL if the event cannot be created.
+**/
+void *event_create(void)
+{
+#ifdef _WIN32
+	return CreateEvent(NULL, FALSE, FALSE, NULL);
+#else
+	event_info_t *event_info;
+
+	event_info = malloc(sizeof(event_info_t));
+	if (event_info == NULL) {
+		return NULL;
+	}
+	if (pthread_mutex_init(&event_info->mutex, NULL) != 0) {
+		free(event_info);
+		return NULL;
+	}
+	if (pthread_cond_init(&event_info->cond, NULL) != 0) {
+		pthread_mutex_destroy(&event_info->mutex);
+		free(event_info);
+		return NULL;
+	}
+	event_info->signaled = FALSE;
+	return event_info;
+#endif
+}
+
+/**
+  Frees an event. No thread may wait for the event.
+
+  @param  event                        The handle of the event.
+**/
+void event_free(IN void *event)
+{
+#ifdef _WIN32
+	CloseHandle(event);
+#else
+	event_info_t *event_info;
+
+	event_info = event;
+	pthread_cond_destroy(&event_info->cond);
+	pthread_mutex_destroy(&event_info->mutex);
+	free(event_info);
+#endif
+}
+
+/**
+  Waits until an event is signaled, and resets it.
+
+  @param  event                        The handle of the event.
+**/
+void event_wait(IN void *event)
+{
+#ifdef _WIN32
+	WaitForSingleObject(event, INFINITE);
+#else
+	event_info_t *event_info;
+
+	event_info = event;
+	pthread_mutex_lock(&event_info->mutex);
+	while (!event_info->signaled) {
+		pthread_cond_wait(&event_info->cond, &event_info->mutex);
+	}
+	event_info->signaled = FALSE;
+	pthread_mutex_unlock(&event_info->mutex);
+#endif
+}
+
+/**
+  Signals an event. The signal is kept until a thread waits for the event.
+
+  @param  event                        The handle of the event.
+**/
+void event_signal(IN void *event)
+{
+#ifdef _WIN32
+	SetEvent(event);
+#else
+	event_info_t *event_info;
+
+	event_info = event;
+	pthread_mutex_lock(&event_info->mutex);
+	event_info->signaled = TRUE;
+	pthread_cond_signal(&event_info->cond);
+	pthread_mutex_unlock(&event_info->mutex);
+#endif
+}
+
+/**
+  Returns the number of processors available to the process.
+
+  @return the number of processors, at least 1.
+**/
+uintn thread_get_processor_count(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO system_info;
+
+	GetSystemInfo(&system_info);
+	return (system_info.dwNumberOfProcessors == 0) ?
+			     1 :
+			     system_info.dwNumberOfProcessors;
+#else
+	long count;
+
+	count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count <= 0) ? 1 : (uintn)count;
+#endif
+}
+
+/**
+  Returns a monotonic time stamp in microseconds.
+
+  Only the difference of two time stamps is meaningful.
+
+  @return the time stamp in microseconds.
+**/
+uint64 get_time_stamp_us(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (uint64)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+	       (uint64)(counter.QuadPart % frequency.QuadPart) * 1000000 /
+		       frequency.QuadPart;
+#else
+	struct timespec time_spec;
+
+	clock_gettime(CLOCK_MONOTONIC, &time_spec);
+	return (uint64)time_spec.tv_sec * 1000000 +
+	       (uint64)time_spec.tv_nsec / 1000;
+#endif
+}
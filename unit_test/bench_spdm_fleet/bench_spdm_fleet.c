@@ -0,0 +1,311 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Loopback benchmark of the fleet attestation driver.
+
+  Each device of the fleet is paired with an in-process responder. A request sent by
+  the requester context is processed by the responder context of the same device
+  on the same worker thread, so the benchmark measures the SPDM processing cost of
+  both sides without any transport latency.
+
+  The responders of all devices sign with the private key cache of the device secret library,
+  which is process-global, so the cache is locked by a mutex.
+
+  usage: bench_spdm_fleet [device_count] [worker_count] [run_count]
+  It must run in the directory of the sample keys.
+**/
+
+#include "bench_spdm_fleet.h"
+
+#define BENCH_SPDM_FLEET_DEFAULT_DEVICE_COUNT 64
+#define BENCH_SPDM_FLEET_DEFAULT_RUN_COUNT 3
+
+uint32 m_bench_hash_algo = SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+uint32 m_bench_asym_algo =
+	SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
+uint32 m_bench_measurement_hash_algo =
+	SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256;
+uint8 m_bench_measurement_spec =
+	SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+
+typedef struct {
+	void *responder_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+} bench_spdm_fleet_peer_t;
+
+void *m_bench_fleet_context;
+bench_spdm_fleet_peer_t *m_bench_peer;
+void *m_bench_private_key_cache_mutex;
+
+/**
+  Find the in-process responder paired with a requester context.
+**/
+bench_spdm_fleet_peer_t *bench_spdm_fleet_get_peer(IN void *spdm_context)
+{
+	uintn device_index;
+
+	device_index = spdm_fleet_get_device_index(m_bench_fleet_context,
+						   spdm_context);
+	ASSERT(device_index != (uintn)-1);
+	return &m_bench_peer[device_index];
+}
+
+/**
+  Deliver a request to the paired responder, and keep its response.
+**/
+return_status bench_spdm_fleet_send_message(IN void *spdm_context,
+					    IN uintn request_size,
+					    IN void *request, IN uint64 timeout)
+{
+	bench_spdm_fleet_peer_t *peer;
+	uint32 *session_id;
+
+	peer = bench_spdm_fleet_get_peer(spdm_context);
+	session_id = NULL;
+	peer->response_size = sizeof(peer->response);
+	return spdm_process_message(peer->responder_context, &session_id,
+				    request, request_size, peer->response,
+				    &peer->response_size);
+}
+
+/**
+  Return the response kept by the last send_message.
+**/
+return_status bench_spdm_fleet_receive_message(IN void *spdm_context,
+					       IN OUT uintn *response_size,
+					       IN OUT void *response,
+					       IN uint64 timeout)
+{
+	bench_spdm_fleet_peer_t *peer;
+
+	peer = bench_spdm_fleet_get_peer(spdm_context);
+	if (*response_size < peer->response_size) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem(response, peer->response, peer->response_size);
+	*response_size = peer->response_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Set the algorithms shared by the requester and the responder.
+**/
+void bench_spdm_fleet_set_algorithms(IN void *spdm_context)
+{
+	spdm_data_parameter_t parameter;
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC, &parameter,
+		      &m_bench_measurement_spec,
+		      sizeof(m_bench_measurement_spec));
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_HASH_ALGO, &parameter,
+		      &m_bench_measurement_hash_algo,
+		      sizeof(m_bench_measurement_hash_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO, &parameter,
+		      &m_bench_asym_algo, sizeof(m_bench_asym_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO, &parameter,
+		      &m_bench_hash_algo, sizeof(m_bench_hash_algo));
+}
+
+/**
+  Create the fleet and the paired responders.
+**/
+boolean bench_spdm_fleet_setup(IN uintn device_count, IN uintn worker_count)
+{
+	void *cert_chain;
+	uintn cert_chain_size;
+	void *root_cert_chain;
+	uintn root_cert_chain_size;
+	void *root_cert;
+	uintn root_cert_size;
+	spdm_data_parameter_t parameter;
+	void *spdm_context;
+	uint32 data32;
+	uint8 data8;
+	uintn index;
+
+	if (!read_responder_public_certificate_chain(m_bench_hash_algo,
+						     m_bench_asym_algo,
+						     &cert_chain,
+						     &cert_chain_size, NULL,
+						     NULL)) {
+		return FALSE;
+	}
+	if (!read_responder_root_public_certificate(m_bench_hash_algo,
+						    m_bench_asym_algo,
+						    &root_cert_chain,
+						    &root_cert_chain_size,
+						    NULL, NULL)) {
+		return FALSE;
+	}
+	root_cert = (uint8 *)root_cert_chain + sizeof(spdm_cert_chain_t) +
+		    spdm_get_hash_size(m_bench_hash_algo);
+	root_cert_size = root_cert_chain_size - sizeof(spdm_cert_chain_t) -
+			 spdm_get_hash_size(m_bench_hash_algo);
+
+	m_bench_private_key_cache_mutex = mutex_create();
+	if (m_bench_private_key_cache_mutex == NULL) {
+		return FALSE;
+	}
+	spdm_private_key_cache_register_lock_func(
+		mutex_acquire, mutex_release, m_bench_private_key_cache_mutex);
+
+	m_bench_fleet_context = malloc(spdm_fleet_get_context_size(device_count));
+	m_bench_peer = malloc(sizeof(bench_spdm_fleet_peer_t) * device_count);
+	if ((m_bench_fleet_context == NULL) || (m_bench_peer == NULL)) {
+		return FALSE;
+	}
+	spdm_fleet_init_context(m_bench_fleet_context, device_count,
+				worker_count);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	for (index = 0; index < device_count; index++) {
+		spdm_context = spdm_fleet_get_spdm_context(m_bench_fleet_context,
+							   index);
+		spdm_register_device_io_func(spdm_context,
+					     bench_spdm_fleet_send_message,
+					     bench_spdm_fleet_receive_message);
+		spdm_register_transport_layer_func(
+			spdm_context, spdm_transport_test_encode_message,
+			spdm_transport_test_decode_message);
+		bench_spdm_fleet_set_algorithms(spdm_context);
+		spdm_set_data(spdm_context, SPDM_DATA_PEER_PUBLIC_ROOT_CERT,
+			      &parameter, root_cert, root_cert_size);
+
+		m_bench_peer[index].responder_context =
+			malloc(spdm_get_context_size());
+		if (m_bench_peer[index].responder_context == NULL) {
+			return FALSE;
+		}
+		spdm_context = m_bench_peer[index].responder_context;
+		spdm_init_context(spdm_context);
+		spdm_register_transport_layer_func(
+			spdm_context, spdm_transport_test_encode_message,
+			spdm_transport_test_decode_message);
+		bench_spdm_fleet_set_algorithms(spdm_context);
+		data32 = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+			 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+			 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+		spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS,
+			      &parameter, &data32, sizeof(data32));
+		data8 = 1;
+		spdm_set_data(spdm_context, SPDM_DATA_LOCAL_SLOT_COUNT,
+			      &parameter, &data8, sizeof(data8));
+		parameter.additional_data[0] = 0;
+		spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			      &parameter, cert_chain, cert_chain_size);
+	}
+	return TRUE;
+}
+
+/**
+  Release the fleet and the in-process responders.
+**/
+void bench_spdm_fleet_teardown(IN uintn device_count)
+{
+	uintn index;
+
+	spdm_fleet_deinit_context(m_bench_fleet_context);
+	for (index = 0; index < device_count; index++) {
+		spdm_deinit_context(m_bench_peer[index].responder_context);
+		free(m_bench_peer[index].responder_context);
+	}
+	free(m_bench_peer);
+	free(m_bench_fleet_context);
+	spdm_private_key_cache_register_lock_func(NULL, NULL, NULL);
+	mutex_free(m_bench_private_key_cache_mutex);
+}
+
+/**
+  Print the report of one run.
+**/
+void bench_spdm_fleet_print_report(IN uintn run_index,
+				   IN spdm_fleet_report_t *report)
+{
+	char8 *phase_name[SPDM_FLEET_PHASE_MAX] = {
+		"init_connection", "get_digest", "get_certificate",
+		"challenge",	   "get_measurement",
+	};
+	uintn phase;
+	uintn index;
+	double rate;
+
+	rate = (double)report->success_count * 1000000.0 /
+	       (double)(report->elapsed_time_us == 0 ? 1 :
+							report->elapsed_time_us);
+	printf("run %u: %u/%u devices attested by %u workers in %llu us - %.1f attestations/s, %.1f per worker\n",
+	       (uint32)run_index, (uint32)report->success_count,
+	       (uint32)report->device_count, (uint32)report->worker_count,
+	       (unsigned long long)report->elapsed_time_us, rate,
+	       rate / (double)report->worker_count);
+	for (phase = 0; phase < SPDM_FLEET_PHASE_MAX; phase++) {
+		printf("    %-16s %10.1f us/device\n", phase_name[phase],
+		       (double)report->phase_time_us[phase] /
+			       (double)report->device_count);
+	}
+	printf("    cert link cache  %llu hit, %llu miss\n",
+	       (unsigned long long)report->cert_link_cache_hit_count,
+	       (unsigned long long)report->cert_link_cache_miss_count);
+	for (index = 0; index < report->device_count; index++) {
+		if (RETURN_ERROR(report->device_report[index].status)) {
+			printf("    device %u failed in %s - 0x%llx\n",
+			       (uint32)index,
+			       phase_name[report->device_report[index]
+						  .failed_phase],
+			       (unsigned long long)report->device_report[index]
+				       .status);
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	uintn device_count;
+	uintn worker_count;
+	uintn run_count;
+	uintn run_index;
+	spdm_fleet_report_t report;
+	return_status status;
+	int return_value;
+
+	device_count = BENCH_SPDM_FLEET_DEFAULT_DEVICE_COUNT;
+	worker_count = 0;
+	run_count = BENCH_SPDM_FLEET_DEFAULT_RUN_COUNT;
+	if (argc > 1) {
+		device_count = (uintn)strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		worker_count = (uintn)strtoul(argv[2], NULL, 0);
+	}
+	if (argc > 3) {
+		run_count = (uintn)strtoul(argv[3], NULL, 0);
+	}
+	if (device_count == 0) {
+		printf("usage: bench_spdm_fleet [device_count] [worker_count] [run_count]\n");
+		return 1;
+	}
+
+	if (!bench_spdm_fleet_setup(device_count, worker_count)) {
+		printf("bench_spdm_fleet - setup failed\n");
+		return 1;
+	}
+
+	return_value = 0;
+	for (run_index = 0; run_index < run_count; run_index++) {
+		status = spdm_fleet_run(m_bench_fleet_context, &report);
+		bench_spdm_fleet_print_report(run_index, &report);
+		if (RETURN_ERROR(status)) {
+			return_value = 1;
+		}
+	}
+
+	bench_spdm_fleet_teardown(device_count);
+	return return_value;
+}
@@ -0,0 +1,33 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __BENCH_SPDM_FLEET_H__
+#define __BENCH_SPDM_FLEET_H__
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#undef NULL
+
+#include <hal/base.h>
+
+#include <library/memlib.h>
+#include <library/threadlib.h>
+#include <library/spdm_fleet_lib.h>
+#include <library/spdm_responder_lib.h>
+#include <library/spdm_transport_test_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+void dump_hex_str(IN uint8 *buffer, IN uintn buffer_size);
+
+boolean read_input_file(IN char8 *file_name, OUT void **file_data,
+			OUT uintn *file_size);
+
+#endif
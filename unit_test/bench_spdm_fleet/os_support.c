@@ -0,0 +1,54 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_spdm_fleet.h"
+
+#include <stdio.h>
+
+void dump_hex_str(IN uint8 *buffer, IN uintn buffer_size)
+{
+	uintn index;
+
+	for (index = 0; index < buffer_size; index++) {
+		printf("%02x", buffer[index]);
+	}
+}
+
+boolean read_input_file(IN char8 *file_name, OUT void **file_data,
+			OUT uintn *file_size)
+{
+	FILE *fp_in;
+	uintn temp_result;
+
+	if ((fp_in = fopen(file_name, "rb")) == NULL) {
+		printf("Unable to open file %s\n", file_name);
+		*file_data = NULL;
+		return FALSE;
+	}
+
+	fseek(fp_in, 0, SEEK_END);
+	*file_size = ftell(fp_in);
+
+	*file_data = (void *)malloc(*file_size);
+	if (NULL == *file_data) {
+		printf("No sufficient memory to allocate %s\n", file_name);
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	fseek(fp_in, 0, SEEK_SET);
+	temp_result = fread(*file_data, 1, *file_size, fp_in);
+	if (temp_result != *file_size) {
+		printf("Read input file error %s", file_name);
+		free((void *)*file_data);
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	fclose(fp_in);
+
+	return TRUE;
+}
@@ -49,9 +49,6 @@ return_status spdm_device_receive_message(IN void *spdm_context,
   return RETURN_SUCCESS;
 }
 
-#define SPDM_CONTEXT_SIZE (sizeof(spdm_context_t) + (sizeof(spdm_secured_message_context_t) * MAX_SPDM_SESSION_COUNT))
-unsigned char m_spdm_context_payload[SPDM_CONTEXT_SIZE];
-
 
 boolean esmbc_random_seed(const uint8 *seed OPTIONAL, uintn seed_size) {}
 
@@ -105,7 +102,7 @@ int main()
 {
   test_spdm_version_number_sort();
   test_spdm_negotiate_connection_version();
-/*   void *spdm_context = (void *)m_spdm_context_payload;
+/*   void *spdm_context = malloc(spdm_get_context_size());
   spdm_init_context(spdm_context);
   spdm_register_device_io_func(spdm_context, spdm_device_send_message, spdm_device_receive_message);
   spdm_register_transport_layer_func(spdm_context, spdm_transport_test_encode_message, spdm_transport_test_decode_message);
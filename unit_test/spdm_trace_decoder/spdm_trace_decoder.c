@@ -0,0 +1,232 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Offline decoder of the binary message trace, see spdm_register_trace_buffer.
+
+  The trace file is the trace buffer saved as is. The events are printed
+  from the oldest to the newest, one line per message.
+
+  usage: spdm_trace_decoder <trace_file>
+**/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#undef NULL
+
+#include <hal/base.h>
+
+#include <library/spdm_common_lib.h>
+
+typedef struct {
+	uint8 code;
+	char8 *name;
+} spdm_trace_decoder_code_name_t;
+
+spdm_trace_decoder_code_name_t m_spdm_trace_decoder_code_name[] = {
+	{ SPDM_DIGESTS, "DIGESTS" },
+	{ SPDM_CERTIFICATE, "CERTIFICATE" },
+	{ SPDM_CHALLENGE_AUTH, "CHALLENGE_AUTH" },
+	{ SPDM_VERSION, "VERSION" },
+	{ SPDM_MEASUREMENTS, "MEASUREMENTS" },
+	{ SPDM_CAPABILITIES, "CAPABILITIES" },
+	{ SPDM_ALGORITHMS, "ALGORITHMS" },
+	{ SPDM_VENDOR_DEFINED_RESPONSE, "VENDOR_DEFINED_RESPONSE" },
+	{ SPDM_ERROR, "ERROR" },
+	{ SPDM_KEY_EXCHANGE_RSP, "KEY_EXCHANGE_RSP" },
+	{ SPDM_FINISH_RSP, "FINISH_RSP" },
+	{ SPDM_PSK_EXCHANGE_RSP, "PSK_EXCHANGE_RSP" },
+	{ SPDM_PSK_FINISH_RSP, "PSK_FINISH_RSP" },
+	{ SPDM_HEARTBEAT_ACK, "HEARTBEAT_ACK" },
+	{ SPDM_KEY_UPDATE_ACK, "KEY_UPDATE_ACK" },
+	{ SPDM_ENCAPSULATED_REQUEST, "ENCAPSULATED_REQUEST" },
+	{ SPDM_ENCAPSULATED_RESPONSE_ACK, "ENCAPSULATED_RESPONSE_ACK" },
+	{ SPDM_END_SESSION_ACK, "END_SESSION_ACK" },
+	{ SPDM_GET_DIGESTS, "GET_DIGESTS" },
+	{ SPDM_GET_CERTIFICATE, "GET_CERTIFICATE" },
+	{ SPDM_CHALLENGE, "CHALLENGE" },
+	{ SPDM_GET_VERSION, "GET_VERSION" },
+	{ SPDM_GET_MEASUREMENTS, "GET_MEASUREMENTS" },
+	{ SPDM_GET_CAPABILITIES, "GET_CAPABILITIES" },
+	{ SPDM_NEGOTIATE_ALGORITHMS, "NEGOTIATE_ALGORITHMS" },
+	{ SPDM_VENDOR_DEFINED_REQUEST, "VENDOR_DEFINED_REQUEST" },
+	{ SPDM_RESPOND_IF_READY, "RESPOND_IF_READY" },
+	{ SPDM_KEY_EXCHANGE, "KEY_EXCHANGE" },
+	{ SPDM_FINISH, "FINISH" },
+	{ SPDM_PSK_EXCHANGE, "PSK_EXCHANGE" },
+	{ SPDM_PSK_FINISH, "PSK_FINISH" },
+	{ SPDM_HEARTBEAT, "HEARTBEAT" },
+	{ SPDM_KEY_UPDATE, "KEY_UPDATE" },
+	{ SPDM_GET_ENCAPSULATED_REQUEST, "GET_ENCAPSULATED_REQUEST" },
+	{ SPDM_DELIVER_ENCAPSULATED_RESPONSE, "DELIVER_ENCAPSULATED_RESPONSE" },
+	{ SPDM_END_SESSION, "END_SESSION" },
+};
+
+/**
+  Return the name of an SPDM request or response code.
+**/
+char8 *spdm_trace_decoder_get_code_name(IN uint8 code)
+{
+	uintn index;
+
+	for (index = 0; index < ARRAY_SIZE(m_spdm_trace_decoder_code_name);
+	     index++) {
+		if (m_spdm_trace_decoder_code_name[index].code == code) {
+			return m_spdm_trace_decoder_code_name[index].name;
+		}
+	}
+	return "UNKNOWN";
+}
+
+/**
+  Print one event of the trace.
+**/
+void spdm_trace_decoder_print_event(IN spdm_trace_event_t *event,
+				    IN uintn payload_size)
+{
+	uint8 *payload;
+	uintn index;
+
+	printf("#%llu %lluus %s ", (unsigned long long)event->sequence,
+	       (unsigned long long)event->timestamp_us,
+	       (event->direction == SPDM_TRACE_DIRECTION_SEND) ? "SEND" :
+								  "RECV");
+	if (event->session_id != 0) {
+		printf("[%08x] ", event->session_id);
+	} else {
+		printf("[--------] ");
+	}
+	if ((event->flags & SPDM_TRACE_EVENT_FLAG_APP_MESSAGE) != 0) {
+		printf("APP_MESSAGE");
+	} else {
+		printf("%s (0x%02x) v%x.%x param1=0x%02x param2=0x%02x",
+		       spdm_trace_decoder_get_code_name(
+			       event->request_response_code),
+		       event->request_response_code, event->spdm_version >> 4,
+		       event->spdm_version & 0xF, event->param1, event->param2);
+	}
+	printf(" size=0x%x :", event->message_size);
+
+	if (payload_size > event->payload_size) {
+		payload_size = event->payload_size;
+	}
+	// The payload of the writer may be larger than SPDM_TRACE_PAYLOAD_SIZE of the decoder.
+	payload = (uint8 *)event + OFFSET_OF(spdm_trace_event_t, payload);
+	for (index = 0; index < payload_size; index++) {
+		printf(" %02x", payload[index]);
+	}
+	if (payload_size < event->message_size) {
+		printf(" ...");
+	}
+	printf("\n");
+}
+
+/**
+  Print the events of a trace buffer from the oldest to the newest.
+
+  @return the number of events printed, or -1 if the trace buffer is not valid.
+**/
+intn spdm_trace_decoder_decode(IN uint8 *trace, IN uintn trace_size)
+{
+	spdm_trace_buffer_header_t *header;
+	spdm_trace_event_t *event;
+	uint64 sequence;
+	uint64 first_sequence;
+	intn event_printed;
+
+	if (trace_size < sizeof(spdm_trace_buffer_header_t)) {
+		return -1;
+	}
+	header = (spdm_trace_buffer_header_t *)trace;
+	if ((header->signature != SPDM_TRACE_BUFFER_SIGNATURE) ||
+	    (header->event_count == 0) ||
+	    ((header->event_count & (header->event_count - 1)) != 0) ||
+	    (header->event_size <
+	     OFFSET_OF(spdm_trace_event_t, payload) + header->payload_size) ||
+	    ((header->event_size & (sizeof(uint64) - 1)) != 0) ||
+	    (trace_size < sizeof(spdm_trace_buffer_header_t) +
+				  (uintn)header->event_count *
+					  header->event_size)) {
+		return -1;
+	}
+
+	first_sequence = 0;
+	if (header->next_sequence > header->event_count) {
+		first_sequence = header->next_sequence - header->event_count;
+		printf("(%llu older events were overwritten)\n",
+		       (unsigned long long)first_sequence);
+	}
+
+	event_printed = 0;
+	for (sequence = first_sequence; sequence < header->next_sequence;
+	     sequence++) {
+		event = (spdm_trace_event_t *)(trace +
+					       sizeof(spdm_trace_buffer_header_t) +
+					       (uintn)(sequence &
+						       (header->event_count - 1)) *
+						       header->event_size);
+		// The event was being written when the trace was saved.
+		if (event->sequence != sequence) {
+			printf("#%llu (incomplete)\n",
+			       (unsigned long long)sequence);
+			continue;
+		}
+		spdm_trace_decoder_print_event(event, header->payload_size);
+		event_printed++;
+	}
+	return event_printed;
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *file;
+	uint8 *trace;
+	long trace_size;
+	intn event_printed;
+
+	if (argc != 2) {
+		printf("usage: spdm_trace_decoder <trace_file>\n");
+		return 1;
+	}
+
+	file = fopen(argv[1], "rb");
+	if (file == NULL) {
+		printf("spdm_trace_decoder - cannot open %s\n", argv[1]);
+		return 1;
+	}
+	fseek(file, 0, SEEK_END);
+	trace_size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if (trace_size <= 0) {
+		fclose(file);
+		printf("spdm_trace_decoder - %s is empty\n", argv[1]);
+		return 1;
+	}
+	trace = malloc(trace_size);
+	if (trace == NULL ||
+	    fread(trace, 1, trace_size, file) != (size_t)trace_size) {
+		fclose(file);
+		free(trace);
+		printf("spdm_trace_decoder - cannot read %s\n", argv[1]);
+		return 1;
+	}
+	fclose(file);
+
+	event_printed = spdm_trace_decoder_decode(trace, (uintn)trace_size);
+	free(trace);
+	if (event_printed < 0) {
+		printf("spdm_trace_decoder - %s is not an SPDM trace\n",
+		       argv[1]);
+		return 1;
+	}
+	return 0;
+}
@@ -81,6 +81,83 @@ typedef return_status (*transport_decode_message_func)(
 	IN void *transport_message, IN OUT uintn *message_size,
 	OUT void *message);
 
+/**
+  Encode a normal message or secured message to a transport message in place.
+
+  The test header is written in front of the message and the alignment padding behind it.
+
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message, with room for the test header in front of it.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the start of the transport message, in front of message.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_UNSUPPORTED           The secured message does not belong to session_id.
+**/
+return_status test_encode_message_in_place(IN uint32 *session_id,
+					   IN uintn message_size,
+					   IN OUT void *message,
+					   OUT uintn *transport_message_size,
+					   OUT void **transport_message);
+
+/**
+  Decode a transport message to a normal message or secured message in place.
+
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
+  @param  message_size                  size in bytes of the message, including alignment padding.
+  @param  message                      A pointer to the message inside transport_message.
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+return_status test_decode_message_in_place(OUT uint32 **session_id,
+					   IN uintn transport_message_size,
+					   IN OUT void *transport_message,
+					   OUT uintn *message_size,
+					   OUT void **message);
+
+/**
+  Encode a normal message or secured message to a transport message in place.
+
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message, with room for the transport header in front of it.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the start of the transport message, in front of message.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_UNSUPPORTED           The secured message does not belong to session_id.
+**/
+typedef return_status (*transport_encode_message_in_place_func)(
+	IN uint32 *session_id, IN uintn message_size, IN OUT void *message,
+	OUT uintn *transport_message_size, OUT void **transport_message);
+
+/**
+  Decode a transport message to a normal message or secured message in place.
+
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
+  @param  message_size                  size in bytes of the message, including alignment padding.
+  @param  message                      A pointer to the message inside transport_message.
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+typedef return_status (*transport_decode_message_in_place_func)(
+	OUT uint32 **session_id, IN uintn transport_message_size,
+	IN OUT void *transport_message, OUT uintn *message_size,
+	OUT void **message);
+
 /**
   Encode an SPDM or APP message to a transport layer message.
 
@@ -340,3 +417,254 @@ return_status spdm_transport_test_decode_message(
 		return RETURN_SUCCESS;
 	}
 }
+
+/**
+  Encode an SPDM or APP message to a transport layer message in place.
+
+  For normal SPDM message, it adds the transport layer wrapper.
+  For secured SPDM message, it encrypts a secured message then adds the transport layer wrapper.
+  For secured APP message, it encrypts a secured message then adds the transport layer wrapper.
+
+  The message shall have SPDM_TEST_TRANSPORT_HEADER_SIZE bytes of writable room in front of it
+  and SPDM_TEST_TRANSPORT_TAIL_SIZE bytes of writable room behind it.
+  All headers, padding and the AEAD tag are written into that room. No copy is made.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message, with head room and tail room around it.
+  @param  transport_message_size         size in bytes of the encoded transport message.
+  @param  transport_message             A pointer to the start of the encoded transport message, inside the same buffer.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_UNSUPPORTED           The message cannot be encoded.
+**/
+return_status spdm_transport_test_encode_message_in_place(
+	IN void *spdm_context, IN uint32 *session_id, IN boolean is_app_message,
+	IN boolean is_requester, IN uintn message_size, IN OUT void *message,
+	OUT uintn *transport_message_size, OUT void **transport_message)
+{
+	return_status status;
+	transport_encode_message_in_place_func transport_encode_message;
+	void *app_message;
+	uintn app_message_size;
+	void *secured_message;
+	uintn secured_message_size;
+	uintn head_room_size;
+	uintn tail_room_size;
+	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
+	void *secured_message_context;
+
+	spdm_secured_message_callbacks_t.version =
+		SPDM_SECURED_MESSAGE_CALLBACKS_VERSION;
+	spdm_secured_message_callbacks_t.get_sequence_number =
+		test_get_sequence_number;
+	spdm_secured_message_callbacks_t.get_max_random_number_count =
+		test_get_max_random_number_count;
+
+	if (is_app_message && (session_id == NULL)) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	transport_encode_message = test_encode_message_in_place;
+	if (session_id != NULL) {
+		secured_message_context =
+			spdm_get_secured_message_context_via_session_id(
+				spdm_context, *session_id);
+		if (secured_message_context == NULL) {
+			return RETURN_UNSUPPORTED;
+		}
+
+		if (!is_app_message) {
+			// SPDM message to APP message
+			status = transport_encode_message(NULL, message_size,
+							  message,
+							  &app_message_size,
+							  &app_message);
+			if (RETURN_ERROR(status)) {
+				DEBUG((DEBUG_ERROR,
+				       "transport_encode_message - %p\n",
+				       status));
+				return RETURN_UNSUPPORTED;
+			}
+		} else {
+			app_message = message;
+			app_message_size = message_size;
+		}
+		// APP message to secured message, leaving room for the outer test header and padding
+		head_room_size = SPDM_TEST_TRANSPORT_HEADER_SIZE -
+				 ((uint8 *)message - (uint8 *)app_message) -
+				 sizeof(test_message_header_t);
+		tail_room_size = SPDM_TEST_TRANSPORT_TAIL_SIZE -
+				 (((uint8 *)app_message + app_message_size) -
+				  ((uint8 *)message + message_size)) -
+				 (TEST_ALIGNMENT - 1);
+		status = spdm_encode_secured_message_in_place(
+			secured_message_context, *session_id, is_requester,
+			head_room_size, app_message_size, app_message,
+			tail_room_size, &secured_message_size, &secured_message,
+			&spdm_secured_message_callbacks_t);
+		if (RETURN_ERROR(status)) {
+			DEBUG((DEBUG_ERROR,
+			       "spdm_encode_secured_message_in_place - %p\n",
+			       status));
+			return status;
+		}
+
+		// secured message to secured test message
+		status = transport_encode_message(
+			session_id, secured_message_size, secured_message,
+			transport_message_size, transport_message);
+		if (RETURN_ERROR(status)) {
+			DEBUG((DEBUG_ERROR, "transport_encode_message - %p\n",
+			       status));
+			return RETURN_UNSUPPORTED;
+		}
+	} else {
+		// SPDM message to normal test message
+		status = transport_encode_message(NULL, message_size, message,
+						  transport_message_size,
+						  transport_message);
+		if (RETURN_ERROR(status)) {
+			DEBUG((DEBUG_ERROR, "transport_encode_message - %p\n",
+			       status));
+			return RETURN_UNSUPPORTED;
+		}
+	}
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode an SPDM or APP message from a transport layer message in place.
+
+  For normal SPDM message, it removes the transport layer wrapper,
+  For secured SPDM message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+  For secured APP message, it removes the transport layer wrapper, then decrypts and verifies a secured message.
+
+  The transport message is decrypted inside its own buffer and message points into it. No copy is made.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  is_app_message                 Indicates if it is an APP message or SPDM message.
+  @param  is_requester                  Indicates if it is a requester message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to the transport message. It is decrypted in place.
+  @param  message_size                  size in bytes of the decoded message.
+  @param  message                      A pointer to the decoded message inside transport_message.
+
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+return_status spdm_transport_test_decode_message_in_place(
+	IN void *spdm_context, OUT uint32 **session_id,
+	OUT boolean *is_app_message, IN boolean is_requester,
+	IN uintn transport_message_size, IN OUT void *transport_message,
+	OUT uintn *message_size, OUT void **message)
+{
+	return_status status;
+	transport_decode_message_in_place_func transport_decode_message;
+	uint32 *SecuredMessageSessionId;
+	void *secured_message;
+	uintn secured_message_size;
+	void *app_message;
+	uintn app_message_size;
+	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
+	void *secured_message_context;
+	spdm_error_struct_t spdm_error;
+
+	spdm_error.error_code = 0;
+	spdm_error.session_id = 0;
+	spdm_set_last_spdm_error_struct(spdm_context, &spdm_error);
+
+	spdm_secured_message_callbacks_t.version =
+		SPDM_SECURED_MESSAGE_CALLBACKS_VERSION;
+	spdm_secured_message_callbacks_t.get_sequence_number =
+		test_get_sequence_number;
+	spdm_secured_message_callbacks_t.get_max_random_number_count =
+		test_get_max_random_number_count;
+
+	if ((session_id == NULL) || (is_app_message == NULL)) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	transport_decode_message = test_decode_message_in_place;
+
+	SecuredMessageSessionId = NULL;
+	// Detect received message
+	status = transport_decode_message(
+		&SecuredMessageSessionId, transport_message_size,
+		transport_message, &secured_message_size, &secured_message);
+	if (RETURN_ERROR(status)) {
+		DEBUG((DEBUG_ERROR, "transport_decode_message - %p\n", status));
+		return RETURN_UNSUPPORTED;
+	}
+
+	if (SecuredMessageSessionId != NULL) {
+		*session_id = SecuredMessageSessionId;
+
+		secured_message_context =
+			spdm_get_secured_message_context_via_session_id(
+				spdm_context, *SecuredMessageSessionId);
+		if (secured_message_context == NULL) {
+			spdm_error.error_code = SPDM_ERROR_CODE_INVALID_SESSION;
+			spdm_error.session_id = *SecuredMessageSessionId;
+			spdm_set_last_spdm_error_struct(spdm_context,
+							&spdm_error);
+			return RETURN_UNSUPPORTED;
+		}
+
+		// Secured message to APP message
+		status = spdm_decode_secured_message_in_place(
+			secured_message_context, *SecuredMessageSessionId,
+			is_requester, secured_message_size, secured_message,
+			&app_message_size, &app_message,
+			&spdm_secured_message_callbacks_t);
+		if (RETURN_ERROR(status)) {
+			DEBUG((DEBUG_ERROR,
+			       "spdm_decode_secured_message_in_place - %p\n",
+			       status));
+			spdm_secured_message_get_last_spdm_error_struct(
+				secured_message_context, &spdm_error);
+			spdm_set_last_spdm_error_struct(spdm_context,
+							&spdm_error);
+			return RETURN_UNSUPPORTED;
+		}
+
+		// APP message to SPDM message.
+		status = transport_decode_message(&SecuredMessageSessionId,
+						  app_message_size, app_message,
+						  message_size, message);
+		if (RETURN_ERROR(status)) {
+			*is_app_message = TRUE;
+			// just return APP message.
+			*message_size = app_message_size;
+			*message = app_message;
+			return RETURN_SUCCESS;
+		} else {
+			*is_app_message = FALSE;
+			if (SecuredMessageSessionId == NULL) {
+				return RETURN_SUCCESS;
+			} else {
+				// get encapsulated secured message - cannot handle it.
+				DEBUG((DEBUG_ERROR,
+				       "transport_decode_message - expect encapsulated normal but got session (%08x)\n",
+				       *SecuredMessageSessionId));
+				return RETURN_UNSUPPORTED;
+			}
+		}
+	} else {
+		// get non-secured message
+		*session_id = NULL;
+		*is_app_message = FALSE;
+		*message_size = secured_message_size;
+		*message = secured_message;
+		return RETURN_SUCCESS;
+	}
+}
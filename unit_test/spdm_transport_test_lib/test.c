@@ -6,10 +6,6 @@
 
 #include <library/spdm_transport_test_lib.h>
 
-#define TEST_ALIGNMENT 4
-#define TEST_SEQUENCE_NUMBER_COUNT 2
-#define TEST_MAX_RANDOM_NUMBER_COUNT 32
-
 /**
   Get sequence number in an SPDM secure message.
 
@@ -183,3 +179,114 @@ return_status test_decode_message(OUT uint32 **session_id,
 		 *message_size);
 	return RETURN_SUCCESS;
 }
+
+/**
+  Encode a normal message or secured message to a transport message in place.
+
+  The test header is written in front of the message and the alignment padding behind it.
+
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message, with room for the test header in front of it.
+  @param  transport_message_size         size in bytes of the transport message.
+  @param  transport_message             A pointer to the start of the transport message, in front of message.
+
+  @retval RETURN_SUCCESS               The message is encoded successfully.
+  @retval RETURN_UNSUPPORTED           The secured message does not belong to session_id.
+**/
+return_status test_encode_message_in_place(IN uint32 *session_id,
+					   IN uintn message_size,
+					   IN OUT void *message,
+					   OUT uintn *transport_message_size,
+					   OUT void **transport_message)
+{
+	uintn aligned_message_size;
+	uintn alignment;
+	test_message_header_t *test_message_header;
+
+	alignment = TEST_ALIGNMENT;
+	aligned_message_size =
+		(message_size + (alignment - 1)) & ~(alignment - 1);
+
+	test_message_header = (void *)((uint8 *)message -
+				       sizeof(test_message_header_t));
+	if (session_id != NULL) {
+		ASSERT(*session_id == *(uint32 *)(message));
+		if (*session_id != *(uint32 *)(message)) {
+			return RETURN_UNSUPPORTED;
+		}
+		test_message_header->message_type =
+			TEST_MESSAGE_TYPE_SECURED_TEST;
+	} else {
+		test_message_header->message_type = TEST_MESSAGE_TYPE_SPDM;
+	}
+	zero_mem((uint8 *)message + message_size,
+		 aligned_message_size - message_size);
+	*transport_message_size =
+		aligned_message_size + sizeof(test_message_header_t);
+	*transport_message = test_message_header;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Decode a transport message to a normal message or secured message in place.
+
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If *session_id is NULL, it is a normal message.
+                                       If *session_id is NOT NULL, it is a secured message.
+  @param  transport_message_size         size in bytes of the transport message data buffer.
+  @param  transport_message             A pointer to a source buffer to store the transport message.
+  @param  message_size                  size in bytes of the message, including alignment padding.
+  @param  message                      A pointer to the message inside transport_message.
+  @retval RETURN_SUCCESS               The message is decoded successfully.
+  @retval RETURN_UNSUPPORTED           The transport_message is unsupported.
+**/
+return_status test_decode_message_in_place(OUT uint32 **session_id,
+					   IN uintn transport_message_size,
+					   IN OUT void *transport_message,
+					   OUT uintn *message_size,
+					   OUT void **message)
+{
+	uintn alignment;
+	test_message_header_t *test_message_header;
+
+	alignment = TEST_ALIGNMENT;
+
+	ASSERT(transport_message_size > sizeof(test_message_header_t));
+	if (transport_message_size <= sizeof(test_message_header_t)) {
+		return RETURN_UNSUPPORTED;
+	}
+
+	test_message_header = transport_message;
+
+	switch (test_message_header->message_type) {
+	case TEST_MESSAGE_TYPE_SECURED_TEST:
+		ASSERT(session_id != NULL);
+		if (session_id == NULL) {
+			return RETURN_UNSUPPORTED;
+		}
+		if (transport_message_size <=
+		    sizeof(test_message_header_t) + sizeof(uint32)) {
+			return RETURN_UNSUPPORTED;
+		}
+		*session_id = (uint32 *)((uint8 *)transport_message +
+					 sizeof(test_message_header_t));
+		break;
+	case TEST_MESSAGE_TYPE_SPDM:
+		if (session_id != NULL) {
+			*session_id = NULL;
+		}
+		break;
+	default:
+		return RETURN_UNSUPPORTED;
+	}
+
+	ASSERT(((transport_message_size - sizeof(test_message_header_t)) &
+		(alignment - 1)) == 0);
+
+	*message_size = transport_message_size - sizeof(test_message_header_t);
+	*message = (uint8 *)transport_message + sizeof(test_message_header_t);
+	return RETURN_SUCCESS;
+}
@@ -39,6 +39,11 @@ int spdm_unit_test_group_setup(void **state)
 	spdm_register_transport_layer_func(spdm_context,
 					   spdm_transport_test_encode_message,
 					   spdm_transport_test_decode_message);
+	spdm_register_transport_layer_in_place_func(
+		spdm_context, SPDM_TEST_TRANSPORT_HEADER_SIZE,
+		SPDM_TEST_TRANSPORT_TAIL_SIZE,
+		spdm_transport_test_encode_message_in_place,
+		spdm_transport_test_decode_message_in_place);
 
 	*state = spdm_test_context;
 	return 0;
@@ -49,6 +54,7 @@ int spdm_unit_test_group_teardown(void **state)
 	spdm_test_context_t *spdm_test_context;
 
 	spdm_test_context = *state;
+	spdm_deinit_context(spdm_test_context->spdm_context);
 	free(spdm_test_context->spdm_context);
 	spdm_test_context->spdm_context = NULL;
 	spdm_test_context->case_id = 0xFFFFFFFF;
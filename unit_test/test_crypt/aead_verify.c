@@ -140,6 +140,7 @@ return_status validate_crypt_aead_cipher(void)
 	uintn OutBufferSize;
 	uint8 OutTag[1024];
 	uintn OutTagSize;
+	void *aead_ctx;
 
 	my_print("\nCrypto AEAD Testing: ");
 
@@ -242,6 +243,97 @@ return_status validate_crypt_aead_cipher(void)
 
 	my_print("[Pass]");
 
+	my_print("\n- AES-GCM Keyed Seal: ");
+	aead_ctx = aead_aes_gcm_new();
+	if (aead_ctx == NULL) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+	status = aead_aes_gcm_set_key(aead_ctx, m_gcm_key, sizeof(m_gcm_key));
+	if (!status) {
+		my_print("[Fail]");
+		aead_aes_gcm_free(aead_ctx);
+		return RETURN_ABORTED;
+	}
+	OutBufferSize = sizeof(OutBuffer);
+	OutTagSize = sizeof(m_gcm_tag);
+	status = aead_aes_gcm_seal(aead_ctx, m_gcm_iv, sizeof(m_gcm_iv),
+				   m_gcm_aad, sizeof(m_gcm_aad), m_gcm_pt,
+				   sizeof(m_gcm_pt), OutTag, OutTagSize,
+				   OutBuffer, &OutBufferSize);
+	if (!status || (OutBufferSize != sizeof(m_gcm_ct)) ||
+	    (const_compare_mem(OutBuffer, m_gcm_ct, sizeof(m_gcm_ct)) != 0) ||
+	    (const_compare_mem(OutTag, m_gcm_tag, sizeof(m_gcm_tag)) != 0)) {
+		my_print("[Fail]");
+		aead_aes_gcm_free(aead_ctx);
+		return RETURN_ABORTED;
+	}
+	my_print("[Pass]");
+
+	my_print("\n- AES-GCM Keyed Open: ");
+	status = aead_aes_gcm_open(aead_ctx, m_gcm_iv, sizeof(m_gcm_iv),
+				   m_gcm_aad, sizeof(m_gcm_aad), m_gcm_ct,
+				   sizeof(m_gcm_ct), m_gcm_tag,
+				   sizeof(m_gcm_tag), OutBuffer, &OutBufferSize);
+	if (!status || (OutBufferSize != sizeof(m_gcm_pt)) ||
+	    (const_compare_mem(OutBuffer, m_gcm_pt, sizeof(m_gcm_pt)) != 0)) {
+		my_print("[Fail]");
+		aead_aes_gcm_free(aead_ctx);
+		return RETURN_ABORTED;
+	}
+	aead_aes_gcm_free(aead_ctx);
+	my_print("[Pass]");
+
+	my_print("\n- ChaCha20Poly1305 Keyed Seal: ");
+	aead_ctx = aead_chacha20_poly1305_new();
+	if (aead_ctx == NULL) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+	status = aead_chacha20_poly1305_set_key(
+		aead_ctx, m_chacha20_poly1305_key,
+		sizeof(m_chacha20_poly1305_key));
+	if (!status) {
+		my_print("[Fail]");
+		aead_chacha20_poly1305_free(aead_ctx);
+		return RETURN_ABORTED;
+	}
+	OutBufferSize = sizeof(OutBuffer);
+	OutTagSize = sizeof(m_chacha20_poly1305_tag);
+	status = aead_chacha20_poly1305_seal(
+		aead_ctx, m_chacha20_poly1305_iv,
+		sizeof(m_chacha20_poly1305_iv), m_chacha20_poly1305_aad,
+		sizeof(m_chacha20_poly1305_aad), m_chacha20_poly1305_pt,
+		sizeof(m_chacha20_poly1305_pt), OutTag, OutTagSize, OutBuffer,
+		&OutBufferSize);
+	if (!status || (OutBufferSize != sizeof(m_chacha20_poly1305_ct)) ||
+	    (const_compare_mem(OutBuffer, m_chacha20_poly1305_ct,
+			       sizeof(m_chacha20_poly1305_ct)) != 0) ||
+	    (const_compare_mem(OutTag, m_chacha20_poly1305_tag,
+			       sizeof(m_chacha20_poly1305_tag)) != 0)) {
+		my_print("[Fail]");
+		aead_chacha20_poly1305_free(aead_ctx);
+		return RETURN_ABORTED;
+	}
+	my_print("[Pass]");
+
+	my_print("\n- ChaCha20Poly1305 Keyed Open: ");
+	status = aead_chacha20_poly1305_open(
+		aead_ctx, m_chacha20_poly1305_iv,
+		sizeof(m_chacha20_poly1305_iv), m_chacha20_poly1305_aad,
+		sizeof(m_chacha20_poly1305_aad), m_chacha20_poly1305_ct,
+		sizeof(m_chacha20_poly1305_ct), m_chacha20_poly1305_tag,
+		sizeof(m_chacha20_poly1305_tag), OutBuffer, &OutBufferSize);
+	if (!status || (OutBufferSize != sizeof(m_chacha20_poly1305_pt)) ||
+	    (const_compare_mem(OutBuffer, m_chacha20_poly1305_pt,
+			       sizeof(m_chacha20_poly1305_pt)) != 0)) {
+		my_print("[Fail]");
+		aead_chacha20_poly1305_free(aead_ctx);
+		return RETURN_ABORTED;
+	}
+	aead_chacha20_poly1305_free(aead_ctx);
+	my_print("[Pass]");
+
 	my_print("\n- SM4-GCM Encryption: ");
 	OutBufferSize = sizeof(OutBuffer);
 	OutTagSize = sizeof(m_sm4_gcm_tag);
@@ -101,6 +101,7 @@ GLOBAL_REMOVE_IF_UNREFERENCED const uint8
 return_status validate_crypt_digest(void)
 {
 	void *hash_ctx;
+	uint64 hash_ctx_storage[64];
 	uintn data_size;
 	uint8 digest[MAX_DIGEST_SIZE];
 	boolean status;
@@ -164,6 +165,30 @@ return_status validate_crypt_digest(void)
 		return RETURN_ABORTED;
 	}
 
+	//
+	// A context initialized in caller memory, if the crypto library can.
+	//
+	if (sha256_get_context_size() != 0) {
+		my_print("Init in caller memory... ");
+		if (sha256_get_context_size() > sizeof(hash_ctx_storage)) {
+			my_print("[Fail]");
+			return RETURN_ABORTED;
+		}
+		zero_mem(digest, MAX_DIGEST_SIZE);
+		status = sha256_init(hash_ctx_storage) &&
+			 sha256_update(hash_ctx_storage, m_hash_data, data_size) &&
+			 sha256_final(hash_ctx_storage, digest);
+		if (!status) {
+			my_print("[Fail]");
+			return RETURN_ABORTED;
+		}
+		if (const_compare_mem(digest, m_sha256_digest, SHA256_DIGEST_SIZE) !=
+		    0) {
+			my_print("[Fail]");
+			return RETURN_ABORTED;
+		}
+	}
+
 	my_print("[Pass]\n");
 
 	my_print("- SHA384: ");
@@ -222,6 +247,30 @@ return_status validate_crypt_digest(void)
 		return RETURN_ABORTED;
 	}
 
+	//
+	// A context initialized in caller memory, if the crypto library can.
+	//
+	if (sha384_get_context_size() != 0) {
+		my_print("Init in caller memory... ");
+		if (sha384_get_context_size() > sizeof(hash_ctx_storage)) {
+			my_print("[Fail]");
+			return RETURN_ABORTED;
+		}
+		zero_mem(digest, MAX_DIGEST_SIZE);
+		status = sha384_init(hash_ctx_storage) &&
+			 sha384_update(hash_ctx_storage, m_hash_data, data_size) &&
+			 sha384_final(hash_ctx_storage, digest);
+		if (!status) {
+			my_print("[Fail]");
+			return RETURN_ABORTED;
+		}
+		if (const_compare_mem(digest, m_sha384_digest, SHA384_DIGEST_SIZE) !=
+		    0) {
+			my_print("[Fail]");
+			return RETURN_ABORTED;
+		}
+	}
+
 	my_print("[Pass]\n");
 
 	my_print("- SHA512: ");
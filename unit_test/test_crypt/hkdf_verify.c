@@ -47,6 +47,7 @@ return_status validate_crypt_hkdf(void)
 {
 	uint8 prk_out[32];
 	uint8 out[42];
+	void *hkdf_ctx;
 	boolean status;
 
 	my_print(" \nCrypto HKDF Engine Testing:\n");
@@ -93,6 +94,71 @@ return_status validate_crypt_hkdf(void)
 		return RETURN_ABORTED;
 	}
 
+	zero_mem(out, sizeof(out));
+	my_print("keyed expand... ");
+	hkdf_ctx = hkdf_sha256_new();
+	if (hkdf_ctx == NULL) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+	//
+	// The context is keyed with another PRK first, so that the expand
+	// below runs on a context that is keyed again.
+	//
+	status = hkdf_sha256_set_prk (
+				hkdf_ctx,
+				m_hkdf_sha256_okm, sizeof(m_hkdf_sha256_prk)
+				);
+	if (status) {
+		status = hkdf_sha256_set_prk (
+				hkdf_ctx,
+				m_hkdf_sha256_prk, sizeof(m_hkdf_sha256_prk)
+				);
+	}
+	if (status) {
+		status = hkdf_sha256_keyed_expand (
+				hkdf_ctx,
+				m_hkdf_sha256_info, sizeof(m_hkdf_sha256_info),
+				out, sizeof(out)
+				);
+	}
+	if (!status) {
+		my_print("[Fail]");
+		hkdf_sha256_free(hkdf_ctx);
+		return RETURN_ABORTED;
+	}
+
+	my_print("Check value... ");
+	if (const_compare_mem(out, m_hkdf_sha256_okm, sizeof(m_hkdf_sha256_okm)) !=
+	    0) {
+		my_print("[Fail]");
+		hkdf_sha256_free(hkdf_ctx);
+		return RETURN_ABORTED;
+	}
+
+	//
+	// An expand does not consume the PRK of the context.
+	//
+	zero_mem(out, sizeof(out));
+	my_print("keyed expand again... ");
+	status = hkdf_sha256_keyed_expand (
+			hkdf_ctx,
+			m_hkdf_sha256_info, sizeof(m_hkdf_sha256_info),
+			out, sizeof(out)
+			);
+	hkdf_sha256_free(hkdf_ctx);
+	if (!status) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+
+	my_print("Check value... ");
+	if (const_compare_mem(out, m_hkdf_sha256_okm, sizeof(m_hkdf_sha256_okm)) !=
+	    0) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+
 	zero_mem(out, sizeof(out));
 	my_print("extract_and_expand... ");
 	status = hkdf_sha256_extract_and_expand (
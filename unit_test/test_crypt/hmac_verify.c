@@ -43,6 +43,7 @@ GLOBAL_REMOVE_IF_UNREFERENCED const uint8 m_hmac_sha256_digest[] = {
 return_status validate_crypt_hmac(void)
 {
 	void *hmac_ctx;
+	void *new_hmac_ctx;
 	uint8 digest[MAX_DIGEST_SIZE];
 	boolean status;
 
@@ -93,6 +94,58 @@ return_status validate_crypt_hmac(void)
 
 	my_print("[Pass]\n");
 
+	my_print("- HMAC-SHA256 context reuse: ");
+	//
+	// A used context is keyed again, then duplicated into a context that
+	// is already keyed, as the session HMAC contexts are reused.
+	//
+	zero_mem(digest, MAX_DIGEST_SIZE);
+	hmac_ctx = hmac_sha256_new();
+	if (hmac_ctx == NULL) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+	new_hmac_ctx = hmac_sha256_new();
+	if (new_hmac_ctx == NULL) {
+		my_print("[Fail]");
+		hmac_sha256_free(hmac_ctx);
+		return RETURN_ABORTED;
+	}
+
+	status = hmac_sha256_set_key(hmac_ctx, (const uint8 *)m_hmac_data, 8) &&
+		 hmac_sha256_update(hmac_ctx, m_hmac_data, 8);
+	if (status) {
+		my_print("Re-key... ");
+		status = hmac_sha256_set_key(hmac_ctx, m_hmac_sha256_key, 20) &&
+			 hmac_sha256_update(hmac_ctx, m_hmac_data, 4);
+	}
+	if (status) {
+		my_print("Duplicate... ");
+		status = hmac_sha256_set_key(new_hmac_ctx,
+					     (const uint8 *)m_hmac_data, 8) &&
+			 hmac_sha256_duplicate(hmac_ctx, new_hmac_ctx);
+	}
+	if (status) {
+		my_print("Finalize... ");
+		status = hmac_sha256_update(new_hmac_ctx, m_hmac_data + 4, 4) &&
+			 hmac_sha256_final(new_hmac_ctx, digest);
+	}
+	hmac_sha256_free(new_hmac_ctx);
+	hmac_sha256_free(hmac_ctx);
+	if (!status) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+
+	my_print("Check value... ");
+	if (const_compare_mem(digest, m_hmac_sha256_digest, SHA256_DIGEST_SIZE) !=
+	    0) {
+		my_print("[Fail]");
+		return RETURN_ABORTED;
+	}
+
+	my_print("[Pass]\n");
+
 	my_print("- HMAC-SHA3_256: ");
 	//
 	// HMAC-SHA3-256 digest Validation
@@ -43,12 +43,16 @@ return_status validate_crypt_x509(char8 *Path, uintn len)
 	uint8 date_time2[64];
 	return_status ret_status;
 	char8 file_name_buffer[1024];
+	uint8 *test_x509_cert;
+	uint8 *test_ca_x509_cert;
 
 	ret_status = RETURN_ABORTED;
 	test_cert = NULL;
 	test_ca_cert = NULL;
 	test_bundle_cert = NULL;
 	test_end_cert = NULL;
+	test_x509_cert = NULL;
+	test_ca_x509_cert = NULL;
 
 	zero_mem(file_name_buffer, 1024);
 	copy_mem(file_name_buffer, Path, len);
@@ -315,6 +319,41 @@ return_status validate_crypt_x509(char8 *Path, uintn len)
 		my_print("\n  - Retrieving Issuer Oraganization name - [Pass]");
 	}
 
+	//
+	// X509 Certificate object Retrieving.
+	//
+	my_print("\n  - Retrieving from X509 object ... ");
+	status = x509_construct_certificate(test_cert, test_cert_len,
+					    &test_x509_cert);
+	if (status) {
+		status = x509_construct_certificate(
+			test_ca_cert, test_ca_cert_len, &test_ca_x509_cert);
+	}
+	if (!status) {
+		my_print("[Fail]");
+		goto cleanup;
+	}
+	cert_version = 0;
+	ret = x509_object_get_version(test_x509_cert, &cert_version);
+	if (RETURN_ERROR(ret)) {
+		my_print("[Fail]");
+		goto cleanup;
+	}
+	subject_size = 0;
+	x509_object_get_issuer_name(test_x509_cert, NULL, &subject_size);
+	asn1_buffer_len = 0;
+	x509_get_issuer_name(test_cert, test_cert_len, NULL, &asn1_buffer_len);
+	if ((subject_size == 0) || (subject_size != asn1_buffer_len)) {
+		my_print("[Fail]");
+		goto cleanup;
+	}
+	if (!x509_object_verify_cert(test_x509_cert, test_ca_x509_cert)) {
+		my_print("[Fail]");
+		goto cleanup;
+	} else {
+		my_print("[Pass]");
+	}
+
 	//
 	// Get X509GetSubjectAltName
 	//
@@ -392,5 +431,11 @@ cleanup:
 	if (test_end_cert != NULL) {
 		free(test_end_cert);
 	}
+	if (test_x509_cert != NULL) {
+		x509_free(test_x509_cert);
+	}
+	if (test_ca_x509_cert != NULL) {
+		x509_free(test_ca_x509_cert);
+	}
 	return ret_status;
 }
@@ -0,0 +1,18 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  The byte loops of os_stub/memlib, renamed so that they can be linked next to
+  memlib_fast and used as the reference of the tests.
+**/
+
+#define copy_mem baseline_copy_mem
+#define set_mem baseline_set_mem
+#define zero_mem baseline_zero_mem
+
+#include "../../os_stub/memlib/copy_mem.c"
+#include "../../os_stub/memlib/set_mem.c"
+#include "../../os_stub/memlib/zero_mem.c"
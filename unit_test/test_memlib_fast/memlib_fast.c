@@ -0,0 +1,204 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "memlib_fast_internal.h"
+#include <library/memlib.h>
+
+//
+// The widest unit of the loops under test. The sizes go from 0 to two units and a byte,
+// so that every size takes the head, body and tail loops, at every alignment.
+//
+#if MEMLIB_FAST_VECTOR_SIZE != 0
+#define TEST_MEMLIB_FAST_BLOCK_SIZE MEMLIB_FAST_VECTOR_SIZE
+#else
+#define TEST_MEMLIB_FAST_BLOCK_SIZE sizeof(uintn)
+#endif
+#define TEST_MEMLIB_FAST_MAX_LENGTH (TEST_MEMLIB_FAST_BLOCK_SIZE * 2 + 1)
+#define TEST_MEMLIB_FAST_BUFFER_SIZE                                           \
+	(TEST_MEMLIB_FAST_BLOCK_SIZE * 4 + TEST_MEMLIB_FAST_MAX_LENGTH)
+
+void *baseline_copy_mem(OUT void *destination_buffer,
+			IN const void *source_buffer, IN uintn length);
+void *baseline_set_mem(OUT void *buffer, IN uintn length, IN uint8 value);
+void *baseline_zero_mem(OUT void *buffer, IN uintn length);
+
+//
+// The buffers are word aligned, so an offset of 0 to TEST_MEMLIB_FAST_BLOCK_SIZE - 1
+// gives every alignment. They are filled with byte loops, so that the setup does not
+// depend on the functions under test.
+//
+static uintn m_fast_buffer[TEST_MEMLIB_FAST_BUFFER_SIZE / sizeof(uintn) + 1];
+static uintn m_baseline_buffer[TEST_MEMLIB_FAST_BUFFER_SIZE / sizeof(uintn) + 1];
+static uintn m_source_buffer[TEST_MEMLIB_FAST_BUFFER_SIZE / sizeof(uintn) + 1];
+
+/**
+  Fill the fast and baseline buffers with the same pattern, and the source buffer
+  with another one.
+**/
+static void test_memlib_fast_fill_buffers(void)
+{
+	uint8 *fast;
+	uint8 *baseline;
+	uint8 *source;
+	uintn index;
+
+	fast = (uint8 *)m_fast_buffer;
+	baseline = (uint8 *)m_baseline_buffer;
+	source = (uint8 *)m_source_buffer;
+	for (index = 0; index < TEST_MEMLIB_FAST_BUFFER_SIZE; index++) {
+		fast[index] = (uint8)(index * 7 + 1);
+		baseline[index] = (uint8)(index * 7 + 1);
+		source[index] = (uint8)(index * 13 + 0x80);
+	}
+}
+
+/**
+  Test 1: copy_mem() between two buffers, for every source and destination alignment and
+  every size from 0 to two units and a byte.
+  Expected behavior: the destination buffer matches the baseline copy_mem() byte for byte,
+  including the bytes around the copy, and the destination is returned.
+**/
+static void test_memlib_fast_case1(void **state)
+{
+	uintn source_offset;
+	uintn destination_offset;
+	uintn length;
+	void *result;
+
+	for (source_offset = 0; source_offset < TEST_MEMLIB_FAST_BLOCK_SIZE;
+	     source_offset++) {
+		for (destination_offset = 0;
+		     destination_offset < TEST_MEMLIB_FAST_BLOCK_SIZE;
+		     destination_offset++) {
+			for (length = 0; length <= TEST_MEMLIB_FAST_MAX_LENGTH;
+			     length++) {
+				test_memlib_fast_fill_buffers();
+				result = copy_mem((uint8 *)m_fast_buffer +
+							  destination_offset,
+						  (uint8 *)m_source_buffer +
+							  source_offset,
+						  length);
+				assert_ptr_equal(result,
+						 (uint8 *)m_fast_buffer +
+							 destination_offset);
+				baseline_copy_mem((uint8 *)m_baseline_buffer +
+							  destination_offset,
+						  (uint8 *)m_source_buffer +
+							  source_offset,
+						  length);
+				assert_memory_equal(m_fast_buffer,
+						    m_baseline_buffer,
+						    TEST_MEMLIB_FAST_BUFFER_SIZE);
+			}
+		}
+	}
+}
+
+/**
+  Test 2: copy_mem() within one buffer, for every source and destination offset up to
+  two units and every size from 0 to two units and a byte. This covers the destination
+  below, equal to and above the source, overlapping or not.
+  Expected behavior: the buffer matches the baseline copy_mem() byte for byte, and the
+  destination is returned.
+**/
+static void test_memlib_fast_case2(void **state)
+{
+	uintn source_offset;
+	uintn destination_offset;
+	uintn length;
+	void *result;
+
+	for (source_offset = 0;
+	     source_offset <= TEST_MEMLIB_FAST_BLOCK_SIZE * 2; source_offset++) {
+		for (destination_offset = 0;
+		     destination_offset <= TEST_MEMLIB_FAST_BLOCK_SIZE * 2;
+		     destination_offset++) {
+			for (length = 0; length <= TEST_MEMLIB_FAST_MAX_LENGTH;
+			     length++) {
+				test_memlib_fast_fill_buffers();
+				result = copy_mem((uint8 *)m_fast_buffer +
+							  destination_offset,
+						  (uint8 *)m_fast_buffer +
+							  source_offset,
+						  length);
+				assert_ptr_equal(result,
+						 (uint8 *)m_fast_buffer +
+							 destination_offset);
+				baseline_copy_mem((uint8 *)m_baseline_buffer +
+							  destination_offset,
+						  (uint8 *)m_baseline_buffer +
+							  source_offset,
+						  length);
+				assert_memory_equal(m_fast_buffer,
+						    m_baseline_buffer,
+						    TEST_MEMLIB_FAST_BUFFER_SIZE);
+			}
+		}
+	}
+}
+
+/**
+  Test 3: set_mem() and zero_mem(), for every alignment and every size from 0 to two
+  units and a byte.
+  Expected behavior: the buffer matches the baseline set_mem() and zero_mem() byte for
+  byte, including the bytes around the fill, and the buffer is returned.
+**/
+static void test_memlib_fast_case3(void **state)
+{
+	static const uint8 value[] = { 0x00, 0x5A, 0xA5, 0xFF };
+	uintn offset;
+	uintn length;
+	uintn index;
+	void *result;
+
+	for (offset = 0; offset < TEST_MEMLIB_FAST_BLOCK_SIZE; offset++) {
+		for (length = 0; length <= TEST_MEMLIB_FAST_MAX_LENGTH;
+		     length++) {
+			for (index = 0; index < ARRAY_SIZE(value); index++) {
+				test_memlib_fast_fill_buffers();
+				result = set_mem((uint8 *)m_fast_buffer + offset,
+						 length, value[index]);
+				assert_ptr_equal(result,
+						 (uint8 *)m_fast_buffer + offset);
+				baseline_set_mem((uint8 *)m_baseline_buffer +
+							 offset,
+						 length, value[index]);
+				assert_memory_equal(m_fast_buffer,
+						    m_baseline_buffer,
+						    TEST_MEMLIB_FAST_BUFFER_SIZE);
+			}
+
+			test_memlib_fast_fill_buffers();
+			result = zero_mem((uint8 *)m_fast_buffer + offset,
+					  length);
+			assert_ptr_equal(result, (uint8 *)m_fast_buffer + offset);
+			baseline_zero_mem((uint8 *)m_baseline_buffer + offset,
+					  length);
+			assert_memory_equal(m_fast_buffer, m_baseline_buffer,
+					    TEST_MEMLIB_FAST_BUFFER_SIZE);
+		}
+	}
+}
+
+int memlib_fast_test_main(void)
+{
+	const struct CMUnitTest memlib_fast_tests[] = {
+		// copy_mem between two buffers
+		cmocka_unit_test(test_memlib_fast_case1),
+		// copy_mem within one buffer, in both directions
+		cmocka_unit_test(test_memlib_fast_case2),
+		// set_mem and zero_mem
+		cmocka_unit_test(test_memlib_fast_case3),
+	};
+
+	return cmocka_run_group_tests(memlib_fast_tests, NULL, NULL);
+}
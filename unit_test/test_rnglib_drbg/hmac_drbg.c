@@ -0,0 +1,192 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+
+#include "rnglib_drbg_internal.h"
+
+#define TEST_HMAC_DRBG_RETURNED_BITS_SIZE 128
+
+//
+// NIST CAVP DRBG test vectors (drbgtestvectors.zip), HMAC_DRBG.rsp,
+// [SHA-256] [PredictionResistance = False] [EntropyInputLen = 256] [NonceLen = 128]
+// [PersonalizationStringLen = 0] [AdditionalInputLen = 0] [ReturnedBitsLen = 1024]
+//
+
+//
+// drbgvectors_no_reseed, COUNT = 0
+//
+static const uint8 m_hmac_drbg_no_reseed_entropy_input[] = {
+	0xca, 0x85, 0x19, 0x11, 0x34, 0x93, 0x84, 0xbf, 0xfe, 0x89, 0xde,
+	0x1c, 0xbd, 0xc4, 0x6e, 0x68, 0x31, 0xe4, 0x4d, 0x34, 0xa4, 0xfb,
+	0x93, 0x5e, 0xe2, 0x85, 0xdd, 0x14, 0xb7, 0x1a, 0x74, 0x88,
+};
+static const uint8 m_hmac_drbg_no_reseed_nonce[] = {
+	0x65, 0x9b, 0xa9, 0x6c, 0x60, 0x1d, 0xc6, 0x9f,
+	0xc9, 0x02, 0x94, 0x08, 0x05, 0xec, 0x0c, 0xa8,
+};
+static const uint8 m_hmac_drbg_no_reseed_returned_bits[] = {
+	0xe5, 0x28, 0xe9, 0xab, 0xf2, 0xde, 0xce, 0x54,
+	0xd4, 0x7c, 0x7e, 0x75, 0xe5, 0xfe, 0x30, 0x21,
+	0x49, 0xf8, 0x17, 0xea, 0x9f, 0xb4, 0xbe, 0xe6,
+	0xf4, 0x19, 0x96, 0x97, 0xd0, 0x4d, 0x5b, 0x89,
+	0xd5, 0x4f, 0xbb, 0x97, 0x8a, 0x15, 0xb5, 0xc4,
+	0x43, 0xc9, 0xec, 0x21, 0x03, 0x6d, 0x24, 0x60,
+	0xb6, 0xf7, 0x3e, 0xba, 0xd0, 0xdc, 0x2a, 0xba,
+	0x6e, 0x62, 0x4a, 0xbf, 0x07, 0x74, 0x5b, 0xc1,
+	0x07, 0x69, 0x4b, 0xb7, 0x54, 0x7b, 0xb0, 0x99,
+	0x5f, 0x70, 0xde, 0x25, 0xd6, 0xb2, 0x9e, 0x2d,
+	0x30, 0x11, 0xbb, 0x19, 0xd2, 0x76, 0x76, 0xc0,
+	0x71, 0x62, 0xc8, 0xb5, 0xcc, 0xde, 0x06, 0x68,
+	0x96, 0x1d, 0xf8, 0x68, 0x03, 0x48, 0x2c, 0xb3,
+	0x7e, 0xd6, 0xd5, 0xc0, 0xbb, 0x8d, 0x50, 0xcf,
+	0x1f, 0x50, 0xd4, 0x76, 0xaa, 0x04, 0x58, 0xbd,
+	0xab, 0xa8, 0x06, 0xf4, 0x8b, 0xe9, 0xdc, 0xb8,
+};
+
+//
+// drbgvectors_pr_false, COUNT = 0
+//
+static const uint8 m_hmac_drbg_reseed_entropy_input[] = {
+	0x06, 0x03, 0x2c, 0xd5, 0xee, 0xd3, 0x3f, 0x39,
+	0x26, 0x5f, 0x49, 0xec, 0xb1, 0x42, 0xc5, 0x11,
+	0xda, 0x9a, 0xff, 0x2a, 0xf7, 0x12, 0x03, 0xbf,
+	0xfa, 0xf3, 0x4a, 0x9c, 0xa5, 0xbd, 0x9c, 0x0d,
+};
+static const uint8 m_hmac_drbg_reseed_nonce[] = {
+	0x0e, 0x66, 0xf7, 0x1e, 0xdc, 0x43, 0xe4, 0x2a,
+	0x45, 0xad, 0x3c, 0x6f, 0xc6, 0xcd, 0xc4, 0xdf,
+};
+static const uint8 m_hmac_drbg_reseed_entropy_input_reseed[] = {
+	0x01, 0x92, 0x0a, 0x4e, 0x66, 0x9e, 0xd3, 0xa8,
+	0x5a, 0xe8, 0xa3, 0x3b, 0x35, 0xa7, 0x4a, 0xd7,
+	0xfb, 0x2a, 0x6b, 0xb4, 0xcf, 0x39, 0x5c, 0xe0,
+	0x03, 0x34, 0xa9, 0xc9, 0xa5, 0xa5, 0xd5, 0x52,
+};
+static const uint8 m_hmac_drbg_reseed_returned_bits[] = {
+	0x76, 0xfc, 0x79, 0xfe, 0x9b, 0x50, 0xbe, 0xcc,
+	0xc9, 0x91, 0xa1, 0x1b, 0x56, 0x35, 0x78, 0x3a,
+	0x83, 0x53, 0x6a, 0xdd, 0x03, 0xc1, 0x57, 0xfb,
+	0x30, 0x64, 0x5e, 0x61, 0x1c, 0x28, 0x98, 0xbb,
+	0x2b, 0x1b, 0xc2, 0x15, 0x00, 0x02, 0x09, 0x20,
+	0x8c, 0xd5, 0x06, 0xcb, 0x28, 0xda, 0x2a, 0x51,
+	0xbd, 0xb0, 0x38, 0x26, 0xaa, 0xf2, 0xbd, 0x23,
+	0x35, 0xd5, 0x76, 0xd5, 0x19, 0x16, 0x08, 0x42,
+	0xe7, 0x15, 0x8a, 0xd0, 0x94, 0x9d, 0x1a, 0x9e,
+	0xc3, 0xe6, 0x6e, 0xa1, 0xb1, 0xa0, 0x64, 0xb0,
+	0x05, 0xde, 0x91, 0x4e, 0xac, 0x2e, 0x9d, 0x4f,
+	0x2d, 0x72, 0xa8, 0x61, 0x6a, 0x80, 0x22, 0x54,
+	0x22, 0x91, 0x82, 0x50, 0xff, 0x66, 0xa4, 0x1b,
+	0xd2, 0xf8, 0x64, 0xa6, 0xa3, 0x8c, 0xc5, 0xb6,
+	0x49, 0x9d, 0xc4, 0x3f, 0x7f, 0x2b, 0xd0, 0x9e,
+	0x1e, 0x0f, 0x8f, 0x58, 0x85, 0x93, 0x51, 0x24,
+};
+
+/**
+  Test 1: Instantiate with the CAVP no-reseed entropy input and nonce and generate twice.
+  Expected behavior: the second generate returns the CAVP returned bits.
+**/
+static void test_rnglib_drbg_hmac_drbg_case1(void **state)
+{
+	rng_drbg_hmac_drbg_t drbg;
+	uint8 seed_material[RNG_DRBG_ENTROPY_SIZE + RNG_DRBG_NONCE_SIZE];
+	uint8 returned_bits[TEST_HMAC_DRBG_RETURNED_BITS_SIZE];
+
+	copy_mem(seed_material, m_hmac_drbg_no_reseed_entropy_input,
+		 sizeof(m_hmac_drbg_no_reseed_entropy_input));
+	copy_mem(seed_material + sizeof(m_hmac_drbg_no_reseed_entropy_input),
+		 m_hmac_drbg_no_reseed_nonce,
+		 sizeof(m_hmac_drbg_no_reseed_nonce));
+	rng_drbg_hmac_drbg_instantiate(&drbg, seed_material,
+				       sizeof(seed_material));
+
+	rng_drbg_hmac_drbg_generate(&drbg, returned_bits,
+				    sizeof(returned_bits));
+	rng_drbg_hmac_drbg_generate(&drbg, returned_bits,
+				    sizeof(returned_bits));
+	assert_memory_equal(returned_bits, m_hmac_drbg_no_reseed_returned_bits,
+			    sizeof(returned_bits));
+	assert_int_equal(drbg.reseed_counter, 3);
+}
+
+/**
+  Test 2: Instantiate with the CAVP entropy input and nonce, reseed with the CAVP reseed
+  entropy input and generate twice.
+  Expected behavior: the second generate returns the CAVP returned bits.
+**/
+static void test_rnglib_drbg_hmac_drbg_case2(void **state)
+{
+	rng_drbg_hmac_drbg_t drbg;
+	uint8 seed_material[RNG_DRBG_ENTROPY_SIZE + RNG_DRBG_NONCE_SIZE];
+	uint8 returned_bits[TEST_HMAC_DRBG_RETURNED_BITS_SIZE];
+
+	copy_mem(seed_material, m_hmac_drbg_reseed_entropy_input,
+		 sizeof(m_hmac_drbg_reseed_entropy_input));
+	copy_mem(seed_material + sizeof(m_hmac_drbg_reseed_entropy_input),
+		 m_hmac_drbg_reseed_nonce, sizeof(m_hmac_drbg_reseed_nonce));
+	rng_drbg_hmac_drbg_instantiate(&drbg, seed_material,
+				       sizeof(seed_material));
+	rng_drbg_hmac_drbg_reseed(
+		&drbg, m_hmac_drbg_reseed_entropy_input_reseed,
+		sizeof(m_hmac_drbg_reseed_entropy_input_reseed));
+	assert_int_equal(drbg.reseed_counter, 1);
+
+	rng_drbg_hmac_drbg_generate(&drbg, returned_bits,
+				    sizeof(returned_bits));
+	rng_drbg_hmac_drbg_generate(&drbg, returned_bits,
+				    sizeof(returned_bits));
+	assert_memory_equal(returned_bits, m_hmac_drbg_reseed_returned_bits,
+			    sizeof(returned_bits));
+}
+
+/**
+  Test 3: Draw random bytes smaller than, equal to and larger than the per-thread buffer.
+  Expected behavior: every call succeeds and two draws of the same size differ.
+**/
+static void test_rnglib_drbg_hmac_drbg_case3(void **state)
+{
+	static const uintn random_size[] = { 1, 8, 48, RNG_DRBG_BUFFER_SIZE,
+					     RNG_DRBG_BUFFER_SIZE * 3 + 5 };
+	uint8 random1[RNG_DRBG_BUFFER_SIZE * 3 + 5];
+	uint8 random2[RNG_DRBG_BUFFER_SIZE * 3 + 5];
+	uint64 random_number1;
+	uint64 random_number2;
+	uintn index;
+
+	for (index = 0; index < ARRAY_SIZE(random_size); index++) {
+		zero_mem(random1, sizeof(random1));
+		zero_mem(random2, sizeof(random2));
+		assert_true(get_random_bytes(random1, random_size[index]));
+		assert_true(get_random_bytes(random2, random_size[index]));
+		if (random_size[index] >= sizeof(uint64)) {
+			assert_true(const_compare_mem(random1, random2,
+						      random_size[index]) != 0);
+		}
+	}
+
+	assert_true(get_random_number_64(&random_number1));
+	assert_true(get_random_number_64(&random_number2));
+	assert_int_not_equal(random_number1, random_number2);
+}
+
+int rnglib_drbg_hmac_drbg_test_main(void)
+{
+	const struct CMUnitTest rnglib_drbg_hmac_drbg_tests[] = {
+		// CAVP HMAC_DRBG SHA-256 without reseed
+		cmocka_unit_test(test_rnglib_drbg_hmac_drbg_case1),
+		// CAVP HMAC_DRBG SHA-256 with reseed
+		cmocka_unit_test(test_rnglib_drbg_hmac_drbg_case2),
+		// get_random_bytes through the per-thread buffer
+		cmocka_unit_test(test_rnglib_drbg_hmac_drbg_case3),
+	};
+
+	return cmocka_run_group_tests(rnglib_drbg_hmac_drbg_tests, NULL, NULL);
+}
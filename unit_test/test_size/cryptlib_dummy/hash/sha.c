@@ -34,6 +34,19 @@ void sha256_free(IN void *sha256_ctx)
 	ASSERT(FALSE);
 }
 
+/**
+  Retrieves the size, in bytes, of a SHA-256 context that sha256_init() can initialize
+  in caller memory, instead of one allocated by sha256_new().
+
+  @return  The size, in bytes, of the SHA-256 context,
+           or 0 if the context can only be allocated by sha256_new().
+
+**/
+uintn sha256_get_context_size(void)
+{
+	return 0;
+}
+
 /**
   Initializes user-supplied memory pointed by sha256_context as SHA-256 hash context for
   subsequent use.
@@ -172,6 +185,19 @@ void sha384_free(IN void *sha384_ctx)
 	ASSERT(FALSE);
 }
 
+/**
+  Retrieves the size, in bytes, of a SHA-384 context that sha384_init() can initialize
+  in caller memory, instead of one allocated by sha384_new().
+
+  @return  The size, in bytes, of the SHA-384 context,
+           or 0 if the context can only be allocated by sha384_new().
+
+**/
+uintn sha384_get_context_size(void)
+{
+	return 0;
+}
+
 /**
   Initializes user-supplied memory pointed by sha384_context as SHA-384 hash context for
   subsequent use.
@@ -312,6 +338,19 @@ void sha512_free(IN void *sha512_ctx)
 	ASSERT(FALSE);
 }
 
+/**
+  Retrieves the size, in bytes, of a SHA-512 context that sha512_init() can initialize
+  in caller memory, instead of one allocated by sha512_new().
+
+  @return  The size, in bytes, of the SHA-512 context,
+           or 0 if the context can only be allocated by sha512_new().
+
+**/
+uintn sha512_get_context_size(void)
+{
+	return 0;
+}
+
 /**
   Initializes user-supplied memory pointed by sha512_context as SHA-512 hash context for
   subsequent use.
@@ -22,3 +22,18 @@ boolean get_random_number_64(OUT uint64 *rand)
 	rand = 0;
 	return TRUE;
 }
+
+/**
+  Fills a buffer with random bytes.
+
+  @param[out] buffer   buffer to fill with random bytes.
+  @param[in]  size     Number of bytes to fill.
+
+  @retval TRUE         Random bytes generated successfully.
+  @retval FALSE        Failed to generate the random bytes.
+
+**/
+boolean get_random_bytes(OUT uint8 *buffer, IN uintn size)
+{
+	return TRUE;
+}
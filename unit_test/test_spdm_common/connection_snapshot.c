@@ -0,0 +1,507 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <library/spdm_requester_lib.h>
+#include <library/spdm_responder_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+#define TEST_SNAPSHOT_REQUESTER_CAPABILITY_FLAGS                               \
+	(SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CERT_CAP |                        \
+	 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP |                        \
+	 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |                     \
+	 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |                         \
+	 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP)
+#define TEST_SNAPSHOT_RESPONDER_CAPABILITY_FLAGS                               \
+	(SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |                       \
+	 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |                       \
+	 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |                    \
+	 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |                        \
+	 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP)
+
+//
+// In-process responder every requester of the test talks to, and its last response
+//
+static void *m_snapshot_responder_context;
+static uintn m_snapshot_response_size;
+static uint8 m_snapshot_response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+/**
+  Deliver a request to the in-process responder, and keep its response.
+**/
+static return_status spdm_connection_snapshot_test_send_message(
+	IN void *spdm_context, IN uintn request_size, IN void *request,
+	IN uint64 timeout)
+{
+	uint32 *session_id;
+
+	session_id = NULL;
+	m_snapshot_response_size = sizeof(m_snapshot_response);
+	return spdm_process_message(m_snapshot_responder_context, &session_id,
+				    request, request_size, m_snapshot_response,
+				    &m_snapshot_response_size);
+}
+
+/**
+  Return the response kept by the last send_message.
+**/
+static return_status spdm_connection_snapshot_test_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	if (*response_size < m_snapshot_response_size) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem(response, m_snapshot_response, m_snapshot_response_size);
+	*response_size = m_snapshot_response_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Create an SPDM context with the algorithms shared by the requester and the responder.
+**/
+static void *spdm_connection_snapshot_test_new_context(
+	IN uint32 capability_flags)
+{
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+
+	spdm_context = malloc(spdm_get_context_size());
+	assert_non_null(spdm_context);
+	spdm_init_context(spdm_context);
+	spdm_register_transport_layer_func(spdm_context,
+					   spdm_transport_test_encode_message,
+					   spdm_transport_test_decode_message);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	spdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS, &parameter,
+		      &capability_flags, sizeof(capability_flags));
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC, &parameter,
+		      &m_use_measurement_spec, sizeof(m_use_measurement_spec));
+	spdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_HASH_ALGO, &parameter,
+		      &m_use_measurement_hash_algo,
+		      sizeof(m_use_measurement_hash_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO, &parameter,
+		      &m_use_asym_algo, sizeof(m_use_asym_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO, &parameter,
+		      &m_use_hash_algo, sizeof(m_use_hash_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_DHE_NAME_GROUP, &parameter,
+		      &m_use_dhe_algo, sizeof(m_use_dhe_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+		      &m_use_aead_algo, sizeof(m_use_aead_algo));
+	spdm_set_data(spdm_context, SPDM_DATA_KEY_SCHEDULE, &parameter,
+		      &m_use_key_schedule_algo,
+		      sizeof(m_use_key_schedule_algo));
+	return spdm_context;
+}
+
+/**
+  Create a requester trusting the root of a certificate chain.
+**/
+static void *spdm_connection_snapshot_test_new_requester(IN void *cert_chain,
+							 IN uintn cert_chain_size)
+{
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	uintn hash_size;
+	uint8 *root_cert;
+	uintn root_cert_size;
+
+	spdm_context = spdm_connection_snapshot_test_new_context(
+		TEST_SNAPSHOT_REQUESTER_CAPABILITY_FLAGS);
+	spdm_register_device_io_func(
+		spdm_context, spdm_connection_snapshot_test_send_message,
+		spdm_connection_snapshot_test_receive_message);
+
+	hash_size = spdm_get_hash_size(m_use_hash_algo);
+	assert_true(x509_get_cert_from_cert_chain(
+		(uint8 *)cert_chain + sizeof(spdm_cert_chain_t) + hash_size,
+		cert_chain_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
+		&root_cert, &root_cert_size));
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	spdm_set_data(spdm_context, SPDM_DATA_PEER_PUBLIC_ROOT_CERT,
+		      &parameter, root_cert, root_cert_size);
+	return spdm_context;
+}
+
+/**
+  Create the in-process responder with a certificate chain in slot 0.
+**/
+static void spdm_connection_snapshot_test_new_responder(IN void *cert_chain,
+							IN uintn cert_chain_size)
+{
+	spdm_data_parameter_t parameter;
+	uint8 slot_count;
+
+	m_snapshot_responder_context =
+		spdm_connection_snapshot_test_new_context(
+			TEST_SNAPSHOT_RESPONDER_CAPABILITY_FLAGS);
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	slot_count = 1;
+	spdm_set_data(m_snapshot_responder_context, SPDM_DATA_LOCAL_SLOT_COUNT,
+		      &parameter, &slot_count, sizeof(slot_count));
+	parameter.additional_data[0] = 0;
+	spdm_set_data(m_snapshot_responder_context,
+		      SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN, &parameter, cert_chain,
+		      cert_chain_size);
+}
+
+static void spdm_connection_snapshot_test_free_context(IN void *spdm_context)
+{
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+static spdm_connection_state_t
+spdm_connection_snapshot_test_get_state(IN void *spdm_context)
+{
+	return ((spdm_context_t *)spdm_context)
+		->connection_info.connection_state;
+}
+
+/**
+  Authenticate the responder with a new requester, and export the connection.
+
+  @return The snapshot, to be freed by the caller.
+**/
+static uint8 *spdm_connection_snapshot_test_export(IN void *cert_chain,
+						   IN uintn cert_chain_size,
+						   OUT uintn *snapshot_size)
+{
+	return_status status;
+	void *spdm_context;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+	uint8 peer_cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+	uintn peer_cert_chain_size;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint8 *snapshot;
+
+	spdm_context = spdm_connection_snapshot_test_new_requester(
+		cert_chain, cert_chain_size);
+	status = spdm_init_connection(spdm_context, FALSE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_get_digest(spdm_context, &slot_mask, total_digest_buffer);
+	assert_int_equal(status, RETURN_SUCCESS);
+	peer_cert_chain_size = sizeof(peer_cert_chain);
+	status = spdm_get_certificate(spdm_context, 0, &peer_cert_chain_size,
+				      peer_cert_chain);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_challenge(
+		spdm_context, 0,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(
+				 m_snapshot_responder_context),
+			 SPDM_CONNECTION_STATE_AUTHENTICATED);
+	assert_int_equal(((spdm_context_t *)spdm_context)
+				 ->connection_info.algorithm.dhe_named_group,
+			 m_use_dhe_algo);
+
+	*snapshot_size = 0;
+	status = spdm_export_connection_snapshot(spdm_context, NULL,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	snapshot = malloc(*snapshot_size);
+	assert_non_null(snapshot);
+	status = spdm_export_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	spdm_connection_snapshot_test_free_context(spdm_context);
+	return snapshot;
+}
+
+/**
+  Test 1: a requester authenticates the responder and exports the connection. A new
+  requester imports it, resumes it with GET_DIGESTS and sends CHALLENGE.
+  Expected behavior: the responder accepts GET_DIGESTS although it is AUTHENTICATED and
+  goes back to AFTER_DIGESTS. The connection is resumed in slot 0 without GET_CERTIFICATE,
+  and CHALLENGE_AUTH is signed over the restarted transcript, so it is verified.
+**/
+static void test_spdm_common_connection_snapshot_case1(void **state)
+{
+	return_status status;
+	void *cert_chain;
+	uintn cert_chain_size;
+	void *spdm_context;
+	uint8 *snapshot;
+	uintn snapshot_size;
+	uint8 slot_id;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+
+	assert_true(read_responder_public_certificate_chain(
+		m_use_hash_algo, m_use_asym_algo, &cert_chain,
+		&cert_chain_size, NULL, NULL));
+	spdm_connection_snapshot_test_new_responder(cert_chain,
+						    cert_chain_size);
+	snapshot = spdm_connection_snapshot_test_export(
+		cert_chain, cert_chain_size, &snapshot_size);
+
+	spdm_context = spdm_connection_snapshot_test_new_requester(
+		cert_chain, cert_chain_size);
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	slot_id = 0xFF;
+	status = spdm_resume_connection(spdm_context, &slot_id);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(slot_id, 0);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(spdm_context),
+			 SPDM_CONNECTION_STATE_AFTER_CERTIFICATE);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(
+				 m_snapshot_responder_context),
+			 SPDM_CONNECTION_STATE_AFTER_DIGESTS);
+
+	status = spdm_challenge(
+		spdm_context, 0,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(spdm_context),
+			 SPDM_CONNECTION_STATE_AUTHENTICATED);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(
+				 m_snapshot_responder_context),
+			 SPDM_CONNECTION_STATE_AUTHENTICATED);
+
+	spdm_connection_snapshot_test_free_context(spdm_context);
+	spdm_connection_snapshot_test_free_context(
+		m_snapshot_responder_context);
+	free(snapshot);
+	free(cert_chain);
+}
+
+/**
+  Test 2: the responder certificate chain changes after the connection is exported.
+  Expected behavior: spdm_resume_connection returns RETURN_NOT_FOUND, and the responder,
+  which was AUTHENTICATED, accepts the GET_CERTIFICATE that fetches the new chain.
+**/
+static void test_spdm_common_connection_snapshot_case2(void **state)
+{
+	return_status status;
+	void *cert_chain;
+	uintn cert_chain_size;
+	void *new_cert_chain;
+	uintn new_cert_chain_size;
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint8 *snapshot;
+	uintn snapshot_size;
+	uint8 slot_id;
+	uint8 peer_cert_chain[MAX_SPDM_CERT_CHAIN_SIZE];
+	uintn peer_cert_chain_size;
+
+	assert_true(read_responder_public_certificate_chain(
+		m_use_hash_algo, m_use_asym_algo, &cert_chain,
+		&cert_chain_size, NULL, NULL));
+	assert_true(read_responder_public_certificate_chain_by_size(
+		m_use_hash_algo, m_use_asym_algo, TEST_CERT_SMALL,
+		&new_cert_chain, &new_cert_chain_size, NULL, NULL));
+	spdm_connection_snapshot_test_new_responder(cert_chain,
+						    cert_chain_size);
+	snapshot = spdm_connection_snapshot_test_export(
+		cert_chain, cert_chain_size, &snapshot_size);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	parameter.additional_data[0] = 0;
+	spdm_set_data(m_snapshot_responder_context,
+		      SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN, &parameter,
+		      new_cert_chain, new_cert_chain_size);
+
+	spdm_context = spdm_connection_snapshot_test_new_requester(
+		new_cert_chain, new_cert_chain_size);
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_resume_connection(spdm_context, &slot_id);
+	assert_int_equal(status, RETURN_NOT_FOUND);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(spdm_context),
+			 SPDM_CONNECTION_STATE_AFTER_DIGESTS);
+
+	peer_cert_chain_size = sizeof(peer_cert_chain);
+	status = spdm_get_certificate(spdm_context, 0, &peer_cert_chain_size,
+				      peer_cert_chain);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(peer_cert_chain_size, new_cert_chain_size);
+	assert_memory_equal(peer_cert_chain, new_cert_chain,
+			    new_cert_chain_size);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(
+				 m_snapshot_responder_context),
+			 SPDM_CONNECTION_STATE_AFTER_CERTIFICATE);
+
+	spdm_connection_snapshot_test_free_context(spdm_context);
+	spdm_connection_snapshot_test_free_context(
+		m_snapshot_responder_context);
+	free(snapshot);
+	free(new_cert_chain);
+	free(cert_chain);
+}
+
+/**
+  Test 3: the responder lost the negotiated state of the connection.
+  Expected behavior: the responder rejects GET_DIGESTS and spdm_resume_connection returns
+  RETURN_DEVICE_ERROR. A new connection can still be initialized.
+**/
+static void test_spdm_common_connection_snapshot_case3(void **state)
+{
+	return_status status;
+	void *cert_chain;
+	uintn cert_chain_size;
+	void *spdm_context;
+	uint8 *snapshot;
+	uintn snapshot_size;
+	uint8 slot_id;
+
+	assert_true(read_responder_public_certificate_chain(
+		m_use_hash_algo, m_use_asym_algo, &cert_chain,
+		&cert_chain_size, NULL, NULL));
+	spdm_connection_snapshot_test_new_responder(cert_chain,
+						    cert_chain_size);
+	snapshot = spdm_connection_snapshot_test_export(
+		cert_chain, cert_chain_size, &snapshot_size);
+	spdm_connection_snapshot_test_free_context(
+		m_snapshot_responder_context);
+	spdm_connection_snapshot_test_new_responder(cert_chain,
+						    cert_chain_size);
+
+	spdm_context = spdm_connection_snapshot_test_new_requester(
+		cert_chain, cert_chain_size);
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_resume_connection(spdm_context, &slot_id);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	assert_int_equal(spdm_connection_snapshot_test_get_state(
+				 m_snapshot_responder_context),
+			 SPDM_CONNECTION_STATE_NOT_STARTED);
+	spdm_connection_snapshot_test_free_context(spdm_context);
+
+	spdm_context = spdm_connection_snapshot_test_new_requester(
+		cert_chain, cert_chain_size);
+	status = spdm_init_connection(spdm_context, FALSE);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	spdm_connection_snapshot_test_free_context(spdm_context);
+	spdm_connection_snapshot_test_free_context(
+		m_snapshot_responder_context);
+	free(snapshot);
+	free(cert_chain);
+}
+
+/**
+  Test 4: a snapshot is imported by requesters whose local configuration no longer offers
+  its version, DHE group, AEAD cipher suite or key schedule, and a malformed snapshot is
+  imported.
+  Expected behavior: the snapshot is rejected with RETURN_UNSUPPORTED, or with
+  RETURN_INVALID_PARAMETER if it is malformed, and the connection is not started.
+**/
+static void test_spdm_common_connection_snapshot_case4(void **state)
+{
+	return_status status;
+	void *cert_chain;
+	uintn cert_chain_size;
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint8 *snapshot;
+	uintn snapshot_size;
+	spdm_version_number_t version;
+	uint16 data16;
+	uintn index;
+
+	assert_true(read_responder_public_certificate_chain(
+		m_use_hash_algo, m_use_asym_algo, &cert_chain,
+		&cert_chain_size, NULL, NULL));
+	spdm_connection_snapshot_test_new_responder(cert_chain,
+						    cert_chain_size);
+	snapshot = spdm_connection_snapshot_test_export(
+		cert_chain, cert_chain_size, &snapshot_size);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	for (index = 0; index < 4; index++) {
+		spdm_context = spdm_connection_snapshot_test_new_requester(
+			cert_chain, cert_chain_size);
+		switch (index) {
+		case 0:
+			zero_mem(&version, sizeof(version));
+			version.major_version = 1;
+			version.minor_version = 0;
+			spdm_set_data(spdm_context, SPDM_DATA_SPDM_VERSION,
+				      &parameter, &version, sizeof(version));
+			break;
+		case 1:
+			data16 = SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1;
+			spdm_set_data(spdm_context, SPDM_DATA_DHE_NAME_GROUP,
+				      &parameter, &data16, sizeof(data16));
+			break;
+		case 2:
+			data16 = SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305;
+			spdm_set_data(spdm_context, SPDM_DATA_AEAD_CIPHER_SUITE,
+				      &parameter, &data16, sizeof(data16));
+			break;
+		default:
+			data16 = 0;
+			spdm_set_data(spdm_context, SPDM_DATA_KEY_SCHEDULE,
+				      &parameter, &data16, sizeof(data16));
+			break;
+		}
+		status = spdm_import_connection_snapshot(spdm_context, snapshot,
+							 snapshot_size);
+		assert_int_equal(status, RETURN_UNSUPPORTED);
+		assert_int_equal(
+			spdm_connection_snapshot_test_get_state(spdm_context),
+			SPDM_CONNECTION_STATE_NOT_STARTED);
+		spdm_connection_snapshot_test_free_context(spdm_context);
+	}
+
+	spdm_context = spdm_connection_snapshot_test_new_requester(
+		cert_chain, cert_chain_size);
+	status = spdm_import_connection_snapshot(
+		spdm_context, snapshot, SPDM_CONNECTION_SNAPSHOT_HEADER_SIZE - 1);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size - 1);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+	//
+	// The snapshot version follows the little endian signature.
+	//
+	snapshot[4] ^= 0xFF;
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+	snapshot[4] ^= 0xFF;
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	spdm_connection_snapshot_test_free_context(spdm_context);
+	spdm_connection_snapshot_test_free_context(
+		m_snapshot_responder_context);
+	free(snapshot);
+	free(cert_chain);
+}
+
+int spdm_common_connection_snapshot_test_main(void)
+{
+	const struct CMUnitTest spdm_common_connection_snapshot_tests[] = {
+		// Resume and CHALLENGE an AUTHENTICATED responder
+		cmocka_unit_test(test_spdm_common_connection_snapshot_case1),
+		// Certificate chain changed, GET_CERTIFICATE fallback
+		cmocka_unit_test(test_spdm_common_connection_snapshot_case2),
+		// Responder lost its state
+		cmocka_unit_test(test_spdm_common_connection_snapshot_case3),
+		// Local configuration mismatch, malformed snapshot
+		cmocka_unit_test(test_spdm_common_connection_snapshot_case4),
+	};
+
+	return cmocka_run_group_tests(spdm_common_connection_snapshot_tests,
+				      NULL, NULL);
+}
@@ -6,6 +6,7 @@
 
 #include "spdm_unit_test.h"
 #include <spdm_requester_lib_internal.h>
+#include <spdm_secured_message_lib_internal.h>
 
 static const uint32_t opaque_data = 0xDEADBEEF;
 
@@ -184,6 +185,356 @@ static void test_spdm_common_context_data_case4(void **state)
 	assert_int_equal(opaque_data, 0xDEADBEEF);
 }
 
+/**
+  Test 5: Initialize a context with a large session capacity and assign, look up and
+  free sessions. Session lookups must find every live session and none of the freed
+  ones, the capacity must be enforced, and the allocated half session ID must encode
+  the pool entry of the most recently freed session.
+**/
+static void test_spdm_common_context_data_case5(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 session_id;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_test_context->case_id = 0x5;
+
+	assert_true(spdm_get_context_size_ex(300) > spdm_get_context_size());
+	spdm_context = malloc(spdm_get_context_size_ex(300));
+	status = spdm_init_context_ex(spdm_context, 300);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context->max_session_count, 300);
+
+	for (index = 0; index < 300; index++) {
+		session_id = ((uint32)spdm_allocate_req_session_id(spdm_context)
+			      << 16) |
+			     (uint32)(index + 1);
+		session_info =
+			spdm_assign_session_id(spdm_context, session_id, FALSE);
+		assert_non_null(session_info);
+		assert_ptr_equal(&spdm_context->session_info[index],
+				 session_info);
+	}
+	assert_int_equal(spdm_allocate_req_session_id(spdm_context),
+			 (INVALID_SESSION_ID & 0xFFFF0000) >> 16);
+
+	for (index = 0; index < 300; index += 3) {
+		session_id = ((uint32)(0xFFFF - index) << 16) |
+			     (uint32)(index + 1);
+		assert_non_null(spdm_free_session_id(spdm_context, session_id));
+	}
+	for (index = 0; index < 300; index++) {
+		session_id = ((uint32)(0xFFFF - index) << 16) |
+			     (uint32)(index + 1);
+		session_info = spdm_get_session_info_via_session_id(
+			spdm_context, session_id);
+		if ((index % 3) == 0) {
+			assert_null(session_info);
+		} else {
+			assert_ptr_equal(&spdm_context->session_info[index],
+					 session_info);
+		}
+	}
+
+	assert_int_equal(spdm_allocate_req_session_id(spdm_context),
+			 0xFFFF - 297);
+	session_id = ((uint32)spdm_allocate_req_session_id(spdm_context)
+		      << 16) |
+		     0x1000;
+	session_info = spdm_assign_session_id(spdm_context, session_id, TRUE);
+	assert_ptr_equal(&spdm_context->session_info[297], session_info);
+	assert_ptr_equal(spdm_get_session_info_via_session_id(spdm_context,
+							      session_id),
+			 session_info);
+
+	spdm_reset_context(spdm_context);
+	assert_int_equal(spdm_allocate_req_session_id(spdm_context), 0xFFFF);
+
+	status = spdm_init_context_ex(spdm_context, 0x10000);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+	free(spdm_context);
+}
+
+/**
+  Test 6: Set the local certificate chain of a slot and read its hash. The digest must be
+  cached for the negotiated hash algorithm and refreshed when the chain is replaced or
+  another hash algorithm is negotiated.
+**/
+static void test_spdm_common_context_data_case6(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	spdm_cert_chain_digest_t *digest_entry;
+	void *data;
+	uintn data_size;
+	void *data2;
+	uintn data2_size;
+	uint8 slot_count;
+	uint8 hash[MAX_HASH_SIZE];
+	uint8 expected_hash[MAX_HASH_SIZE];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x6;
+
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+	read_responder_public_certificate_chain(
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+		&data, &data_size, NULL, NULL);
+	read_responder_public_certificate_chain(
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+		&data2, &data2_size, NULL, NULL);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	slot_count = 1;
+	status = spdm_set_data(spdm_context, SPDM_DATA_LOCAL_SLOT_COUNT,
+			       &parameter, &slot_count, sizeof(slot_count));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			       &parameter, data, data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	digest_entry = spdm_get_cert_chain_digest_entry(spdm_context, data,
+							data_size);
+	assert_ptr_equal(digest_entry,
+			 &spdm_context->local_context->local_cert_chain_digest[0]);
+	assert_true(digest_entry->digest_valid);
+	assert_int_equal(digest_entry->base_hash_algo,
+			 SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256);
+
+	spdm_hash_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, data,
+		      data_size, expected_hash);
+	assert_true(spdm_generate_cert_chain_hash(spdm_context, 0, hash));
+	assert_memory_equal(hash, expected_hash,
+			    spdm_get_hash_size(
+				    SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256));
+
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+	spdm_hash_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, data,
+		      data_size, expected_hash);
+	assert_true(spdm_generate_cert_chain_hash(spdm_context, 0, hash));
+	assert_memory_equal(hash, expected_hash,
+			    spdm_get_hash_size(
+				    SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384));
+	assert_int_equal(digest_entry->base_hash_algo,
+			 SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384);
+
+	status = spdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			       &parameter, data2, data2_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_null(spdm_get_cert_chain_digest_entry(spdm_context, data,
+						     data_size));
+	spdm_hash_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, data2,
+		      data2_size, expected_hash);
+	assert_true(spdm_generate_cert_chain_hash(spdm_context, 0, hash));
+	assert_memory_equal(hash, expected_hash,
+			    spdm_get_hash_size(
+				    SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384));
+
+	spdm_context->local_context->local_cert_chain_provision[0] = NULL;
+	spdm_context->local_context->local_cert_chain_provision_size[0] = 0;
+	zero_mem(&spdm_context->local_context->local_cert_chain_digest[0],
+		 sizeof(spdm_cert_chain_digest_t));
+	spdm_context->local_context->slot_count = 0;
+	spdm_context->connection_info.algorithm.base_hash_algo = 0;
+	free(data);
+	free(data2);
+}
+
+/**
+  Test 7: Set the peer used certificate chain and retrieve the peer public key twice. The key
+  must be imported once and reused, and released when the chain is replaced or the context
+  is reset.
+**/
+static void test_spdm_common_context_data_case7(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	void *data;
+	uintn data_size;
+	void *context;
+	void *context2;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x7;
+
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
+	read_responder_public_certificate_chain(
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+		&data, &data_size, NULL, NULL);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_CONNECTION;
+	status = spdm_set_data(spdm_context,
+			       SPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER, &parameter,
+			       data, data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_true(spdm_get_peer_public_key(spdm_context, TRUE, &context));
+	assert_non_null(context);
+	assert_true(spdm_get_peer_public_key(spdm_context, TRUE, &context2));
+	assert_ptr_equal(context, context2);
+	assert_ptr_equal(
+		spdm_context->connection_info.peer_public_key_cache
+			.cert_chain_buffer,
+		spdm_context->connection_info.peer_used_cert_chain_buffer);
+
+	status = spdm_set_data(spdm_context,
+			       SPDM_DATA_PEER_USED_CERT_CHAIN_BUFFER, &parameter,
+			       data, data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_null(spdm_context->connection_info.peer_public_key_cache.context);
+	assert_true(spdm_get_peer_public_key(spdm_context, TRUE, &context));
+	assert_non_null(
+		spdm_context->connection_info.peer_public_key_cache.context);
+
+	spdm_reset_context(spdm_context);
+	assert_null(spdm_context->connection_info.peer_public_key_cache.context);
+
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size = 0;
+	zero_mem(&spdm_context->connection_info.peer_used_cert_chain_digest,
+		 sizeof(spdm_cert_chain_digest_t));
+	free(data);
+}
+
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+  Test 8: Run two sessions one after the other in the same session slot. The second session
+  must reuse the transcript hash contexts of the first one, and the L1L2 hash must still be
+  correct. The contexts are released when the arena is freed.
+**/
+static void test_spdm_common_context_data_case8(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint8 message[] = { 0x11, 0x22, 0x33, 0x44 };
+	void *digest_context_th;
+	void *digest_context_l1l2;
+	uint8 l1l2_hash[MAX_HASH_SIZE];
+	uint8 expected_hash[MAX_HASH_SIZE];
+	uintn l1l2_hash_size;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x8;
+
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+	session_info = &spdm_context->session_info[0];
+	digest_context_th = NULL;
+	digest_context_l1l2 = NULL;
+
+	for (index = 0; index < 2; index++) {
+		spdm_session_info_init(spdm_context, session_info,
+				       0xFFFFFFFF - (uint32)index, TRUE);
+		status = spdm_append_message_k(spdm_context, session_info, TRUE,
+					       message, sizeof(message));
+		assert_int_equal(status, RETURN_SUCCESS);
+		status = spdm_append_message_m(spdm_context, session_info,
+					       message, sizeof(message));
+		assert_int_equal(status, RETURN_SUCCESS);
+		assert_non_null(session_info->session_transcript.digest_context_th);
+		assert_non_null(session_info->session_transcript.digest_context_l1l2);
+		if (index == 0) {
+			digest_context_th =
+				session_info->session_transcript.digest_context_th;
+			digest_context_l1l2 =
+				session_info->session_transcript.digest_context_l1l2;
+		} else {
+			assert_ptr_equal(session_info->session_transcript.digest_context_th,
+					 digest_context_th);
+			assert_ptr_equal(session_info->session_transcript.digest_context_l1l2,
+					 digest_context_l1l2);
+		}
+
+		l1l2_hash_size = sizeof(l1l2_hash);
+		assert_true(spdm_calculate_l1l2_hash(spdm_context, session_info,
+						     &l1l2_hash_size, l1l2_hash));
+		spdm_hash_all(SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+			      message, sizeof(message), expected_hash);
+		assert_int_equal(l1l2_hash_size, SHA256_DIGEST_SIZE);
+		assert_memory_equal(l1l2_hash, expected_hash, SHA256_DIGEST_SIZE);
+	}
+
+	spdm_session_info_init(spdm_context, session_info, INVALID_SESSION_ID,
+			       FALSE);
+	assert_int_equal(session_info->context_arena.hash_context_in_use, 0);
+	spdm_free_session_context_arena(session_info);
+	assert_null(session_info->context_arena.hash_context[0]);
+	spdm_context->connection_info.algorithm.base_hash_algo = 0;
+}
+#endif
+
+/**
+  Test 9: Key the AEAD contexts of two live sessions and deinit the context. The keyed
+  AEAD contexts of every session must be released.
+**/
+static void test_spdm_common_context_data_case9(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	spdm_secured_message_context_t *secured_message_context;
+	uint8 key[MAX_AEAD_KEY_SIZE];
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_test_context->case_id = 0x9;
+
+	spdm_context = malloc(spdm_get_context_size_ex(2));
+	spdm_init_context_ex(spdm_context, 2);
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM;
+	zero_mem(key, sizeof(key));
+
+	for (index = 0; index < 2; index++) {
+		session_info = spdm_assign_session_id(
+			spdm_context, 0xFFFF0000 | (uint32)(index + 1), FALSE);
+		assert_non_null(session_info);
+		secured_message_context = session_info->secured_message_context;
+		assert_non_null(spdm_secured_message_get_aead_context(
+			secured_message_context, TRUE, key));
+		assert_non_null(spdm_secured_message_get_aead_context(
+			secured_message_context, FALSE, key));
+	}
+
+	spdm_deinit_context(spdm_context);
+	for (index = 0; index < 2; index++) {
+		secured_message_context =
+			spdm_context->session_info[index].secured_message_context;
+		assert_null(secured_message_context->request_aead_context);
+		assert_null(secured_message_context->response_aead_context);
+		assert_int_equal(spdm_context->session_info[index].session_id,
+				 INVALID_SESSION_ID);
+	}
+
+	free(spdm_context);
+}
+
 static spdm_test_context_t m_spdm_common_context_data_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -198,6 +549,15 @@ int spdm_common_context_data_test_main(void)
 		cmocka_unit_test(test_spdm_common_context_data_case2),
 		cmocka_unit_test(test_spdm_common_context_data_case3),
 		cmocka_unit_test(test_spdm_common_context_data_case4),
+		cmocka_unit_test(test_spdm_common_context_data_case5),
+		cmocka_unit_test(test_spdm_common_context_data_case6),
+		cmocka_unit_test(test_spdm_common_context_data_case7),
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+		// Transcript hash contexts are reused by the next session
+		cmocka_unit_test(test_spdm_common_context_data_case8),
+#endif
+		// Keyed AEAD contexts are released by spdm_deinit_context
+		cmocka_unit_test(test_spdm_common_context_data_case9),
 	};
 
 	setup_spdm_test_context(&m_spdm_common_context_data_test_context);
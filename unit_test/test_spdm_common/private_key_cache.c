@@ -0,0 +1,238 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_device_secret_lib_internal.h>
+
+#define TEST_PRIVATE_KEY_ASYM_ALGO \
+	SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256
+
+static uintn m_private_key_cache_lock_depth;
+static uintn m_private_key_cache_acquire_count;
+static uintn m_private_key_cache_release_count;
+
+static void test_private_key_cache_acquire_lock(IN void *lock_context)
+{
+	assert_ptr_equal(lock_context, &m_private_key_cache_lock_depth);
+	assert_int_equal(m_private_key_cache_lock_depth, 0);
+	m_private_key_cache_lock_depth++;
+	m_private_key_cache_acquire_count++;
+}
+
+static void test_private_key_cache_release_lock(IN void *lock_context)
+{
+	assert_ptr_equal(lock_context, &m_private_key_cache_lock_depth);
+	assert_int_equal(m_private_key_cache_lock_depth, 1);
+	m_private_key_cache_lock_depth--;
+	m_private_key_cache_release_count++;
+}
+
+/**
+  Test 1: Load the same responder key twice.
+  Expected behavior: the first load misses and parses the key, the second load hits.
+**/
+static void test_spdm_common_private_key_cache_case1(void **state)
+{
+	uintn hit_count;
+	uintn miss_count;
+	uintn base_hit_count;
+	uintn base_miss_count;
+
+	spdm_private_key_cache_invalidate();
+	spdm_private_key_cache_get_stats(&base_hit_count, &base_miss_count);
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 0);
+	assert_int_equal(miss_count - base_miss_count, 1);
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 1);
+	assert_int_equal(miss_count - base_miss_count, 1);
+
+	//
+	// The requester key of the same algorithm and slot is a different entry.
+	//
+	assert_true(spdm_requester_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 1);
+	assert_int_equal(miss_count - base_miss_count, 2);
+
+	spdm_private_key_cache_invalidate();
+}
+
+/**
+  Test 2: Load one key more than the cache holds.
+  Expected behavior: the least recently used key is evicted and reloaded on the next use,
+  while the recently used keys are still cached.
+**/
+static void test_spdm_common_private_key_cache_case2(void **state)
+{
+	uintn hit_count;
+	uintn miss_count;
+	uintn base_hit_count;
+	uintn base_miss_count;
+	uint8 slot_id;
+
+	spdm_private_key_cache_invalidate();
+	spdm_private_key_cache_get_stats(&base_hit_count, &base_miss_count);
+
+	for (slot_id = 0; slot_id < MAX_PRIVATE_KEY_CACHE_COUNT; slot_id++) {
+		assert_true(spdm_responder_private_key_load(
+			TEST_PRIVATE_KEY_ASYM_ALGO, slot_id));
+	}
+	//
+	// Slot 0 becomes the most recently used key, so slot 1 is evicted.
+	//
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, MAX_PRIVATE_KEY_CACHE_COUNT));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 1);
+	assert_int_equal(miss_count - base_miss_count,
+			 MAX_PRIVATE_KEY_CACHE_COUNT + 1);
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 2));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 3);
+	assert_int_equal(miss_count - base_miss_count,
+			 MAX_PRIVATE_KEY_CACHE_COUNT + 1);
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 1));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 3);
+	assert_int_equal(miss_count - base_miss_count,
+			 MAX_PRIVATE_KEY_CACHE_COUNT + 2);
+
+	spdm_private_key_cache_invalidate();
+}
+
+/**
+  Test 3: Unload one key and invalidate the cache.
+  Expected behavior: the unloaded key and, after the invalidation, every key are parsed again.
+**/
+static void test_spdm_common_private_key_cache_case3(void **state)
+{
+	uintn hit_count;
+	uintn miss_count;
+	uintn base_hit_count;
+	uintn base_miss_count;
+
+	spdm_private_key_cache_invalidate();
+	spdm_private_key_cache_get_stats(&base_hit_count, &base_miss_count);
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	assert_true(spdm_requester_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	spdm_requester_private_key_unload(TEST_PRIVATE_KEY_ASYM_ALGO, 0);
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	assert_true(spdm_requester_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 1);
+	assert_int_equal(miss_count - base_miss_count, 3);
+
+	spdm_private_key_cache_invalidate();
+
+	assert_true(spdm_responder_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	assert_true(spdm_requester_private_key_load(
+		TEST_PRIVATE_KEY_ASYM_ALGO, 0));
+	spdm_private_key_cache_get_stats(&hit_count, &miss_count);
+	assert_int_equal(hit_count - base_hit_count, 1);
+	assert_int_equal(miss_count - base_miss_count, 5);
+
+	spdm_private_key_cache_invalidate();
+}
+
+/**
+  Test 4: Sign with the cached key while a lock is registered.
+  Expected behavior: the lock is held once per cache access, including while signing,
+  and the signature verifies with the public key of the certificate chain.
+**/
+static void test_spdm_common_private_key_cache_case4(void **state)
+{
+	uint8 message[32];
+	uint8 signature[MAX_ASYM_KEY_SIZE];
+	uintn sig_size;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	uint8 *cert;
+	uintn cert_size;
+	void *public_key;
+	spdm_version_number_t spdm_version = {0, 0, 1, 1};
+
+	spdm_private_key_cache_invalidate();
+	m_private_key_cache_acquire_count = 0;
+	m_private_key_cache_release_count = 0;
+	spdm_private_key_cache_register_lock_func(
+		test_private_key_cache_acquire_lock,
+		test_private_key_cache_release_lock,
+		&m_private_key_cache_lock_depth);
+
+	set_mem(message, sizeof(message), 0x5A);
+	sig_size = sizeof(signature);
+	assert_true(spdm_responder_data_sign(
+		spdm_version, SPDM_CHALLENGE_AUTH, TEST_PRIVATE_KEY_ASYM_ALGO,
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, FALSE, message,
+		sizeof(message), signature, &sig_size));
+	assert_int_equal(m_private_key_cache_acquire_count, 1);
+	assert_int_equal(m_private_key_cache_release_count, 1);
+	assert_int_equal(m_private_key_cache_lock_depth, 0);
+
+	spdm_private_key_cache_invalidate();
+	assert_int_equal(m_private_key_cache_acquire_count, 2);
+	assert_int_equal(m_private_key_cache_release_count, 2);
+	spdm_private_key_cache_register_lock_func(NULL, NULL, NULL);
+
+	assert_true(read_responder_public_certificate_chain(
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		TEST_PRIVATE_KEY_ASYM_ALGO, &data, &data_size, &hash,
+		&hash_size));
+	assert_true(x509_get_cert_from_cert_chain(
+		(uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
+		data_size - sizeof(spdm_cert_chain_t) - hash_size, -1, &cert,
+		&cert_size));
+	assert_true(spdm_asym_get_public_key_from_x509(
+		TEST_PRIVATE_KEY_ASYM_ALGO, cert, cert_size, &public_key));
+	assert_true(spdm_asym_verify(
+		spdm_version, SPDM_CHALLENGE_AUTH, TEST_PRIVATE_KEY_ASYM_ALGO,
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, public_key,
+		message, sizeof(message), signature, sig_size));
+	spdm_asym_free(TEST_PRIVATE_KEY_ASYM_ALGO, public_key);
+	free(data);
+}
+
+int spdm_common_private_key_cache_test_main(void)
+{
+	const struct CMUnitTest spdm_common_private_key_cache_tests[] = {
+		// Hit and miss
+		cmocka_unit_test(test_spdm_common_private_key_cache_case1),
+		// Eviction of the least recently used key
+		cmocka_unit_test(test_spdm_common_private_key_cache_case2),
+		// Unload and invalidation
+		cmocka_unit_test(test_spdm_common_private_key_cache_case3),
+		// Lock held while signing
+		cmocka_unit_test(test_spdm_common_private_key_cache_case4),
+	};
+
+	return cmocka_run_group_tests(spdm_common_private_key_cache_tests,
+				      NULL, NULL);
+}
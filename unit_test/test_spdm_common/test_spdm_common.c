@@ -6,6 +6,9 @@
 
 
 extern int spdm_common_context_data_test_main(void);
+extern int spdm_common_private_key_cache_test_main(void);
+extern int spdm_common_transport_in_place_test_main(void);
+extern int spdm_common_connection_snapshot_test_main(void);
 
 int main(void)
 {
@@ -15,5 +18,17 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_common_private_key_cache_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_common_transport_in_place_test_main() != 0) {
+		return_value = 1;
+	}
+
+	if (spdm_common_connection_snapshot_test_main() != 0) {
+		return_value = 1;
+	}
+
 	return return_value;
 }
@@ -0,0 +1,352 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <library/spdm_transport_mctp_lib.h>
+#include <library/spdm_transport_pcidoe_lib.h>
+#include <spdm_secured_message_lib_internal.h>
+
+#define TEST_IN_PLACE_SESSION_ID 0xFFFEFFFE
+#define TEST_IN_PLACE_MAX_MESSAGE_SIZE 0x100
+#define TEST_IN_PLACE_GUARD 0xA5
+
+//
+// Message sizes covering every remainder of the PCI DOE alignment.
+//
+static uintn m_in_place_message_size[] = { 4, 5, 6, 7, 0x41 };
+
+/**
+  Create an SPDM context with an established session, keyed with fixed test secrets.
+  The requester and the responder contexts of a test get the same keys.
+**/
+static spdm_context_t *spdm_transport_in_place_test_new_context(
+	IN uint32 capability_flags)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	spdm_secured_message_context_t *secured_message_context;
+
+	spdm_context = malloc(spdm_get_context_size());
+	assert_non_null(spdm_context);
+	spdm_init_context(spdm_context);
+	spdm_context->connection_info.capability.flags = capability_flags;
+	spdm_context->local_context->capability.flags = capability_flags;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM;
+
+	session_info = spdm_assign_session_id(spdm_context,
+					      TEST_IN_PLACE_SESSION_ID, FALSE);
+	assert_non_null(session_info);
+	secured_message_context = session_info->secured_message_context;
+	spdm_secured_message_set_session_state(secured_message_context,
+					       SPDM_SESSION_STATE_ESTABLISHED);
+	set_mem(secured_message_context->application_secret
+			.request_data_encryption_key,
+		secured_message_context->aead_key_size, 0xEE);
+	set_mem(secured_message_context->application_secret.request_data_salt,
+		secured_message_context->aead_iv_size, 0xEE);
+	set_mem(secured_message_context->application_secret
+			.response_data_encryption_key,
+		secured_message_context->aead_key_size, 0xFF);
+	set_mem(secured_message_context->application_secret.response_data_salt,
+		secured_message_context->aead_iv_size, 0xFF);
+	return spdm_context;
+}
+
+static void spdm_transport_in_place_test_free_context(
+	IN spdm_context_t *spdm_context)
+{
+	spdm_deinit_context(spdm_context);
+	free(spdm_context);
+}
+
+/**
+  Encode a request in place at offset bytes into a buffer, decode it in place on the
+  responder, and check that the message survives and no byte outside the room is written.
+**/
+static void spdm_transport_in_place_test_round_trip(
+	IN spdm_context_t *requester_context,
+	IN spdm_context_t *responder_context,
+	IN spdm_transport_encode_message_in_place_func encode_message,
+	IN spdm_transport_decode_message_in_place_func decode_message,
+	IN uintn header_size, IN uintn tail_size, IN uintn alignment,
+	IN uint32 *session_id, IN uintn offset, IN uintn message_size)
+{
+	return_status status;
+	uint8 buffer[MAX_SPDM_TRANSPORT_HEADER_SIZE +
+		     TEST_IN_PLACE_MAX_MESSAGE_SIZE +
+		     MAX_SPDM_TRANSPORT_TAIL_SIZE + sizeof(uint32)];
+	uint8 expected_message[TEST_IN_PLACE_MAX_MESSAGE_SIZE];
+	uint8 *message;
+	uint8 *transport_message;
+	uintn transport_message_size;
+	uint8 *decoded_message;
+	uintn decoded_message_size;
+	uint32 *decoded_session_id;
+	boolean is_app_message;
+	uintn index;
+
+	assert_true(header_size <= MAX_SPDM_TRANSPORT_HEADER_SIZE);
+	assert_true(tail_size <= MAX_SPDM_TRANSPORT_TAIL_SIZE);
+	assert_true(offset < sizeof(uint32));
+	assert_true(message_size <= TEST_IN_PLACE_MAX_MESSAGE_SIZE);
+
+	set_mem(buffer, sizeof(buffer), TEST_IN_PLACE_GUARD);
+	message = buffer + offset + header_size;
+	for (index = 0; index < message_size; index++) {
+		expected_message[index] = (uint8)(index + offset);
+	}
+	copy_mem(message, expected_message, message_size);
+
+	status = encode_message(requester_context, session_id, FALSE, TRUE,
+				message_size, message, &transport_message_size,
+				(void **)&transport_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_true(transport_message >= message - header_size);
+	assert_true(transport_message + transport_message_size <=
+		    message + message_size + tail_size);
+	assert_int_equal(transport_message_size & (alignment - 1), 0);
+	for (index = 0; index < offset; index++) {
+		assert_int_equal(buffer[index], TEST_IN_PLACE_GUARD);
+	}
+	for (index = (message + message_size + tail_size) - buffer;
+	     index < sizeof(buffer); index++) {
+		assert_int_equal(buffer[index], TEST_IN_PLACE_GUARD);
+	}
+
+	decoded_session_id = NULL;
+	status = decode_message(responder_context, &decoded_session_id,
+				&is_app_message, TRUE, transport_message_size,
+				transport_message, &decoded_message_size,
+				(void **)&decoded_message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_false(is_app_message);
+	if (session_id == NULL) {
+		assert_null(decoded_session_id);
+	} else {
+		assert_non_null(decoded_session_id);
+		assert_int_equal(*decoded_session_id, *session_id);
+	}
+	assert_true(decoded_message >= transport_message);
+	assert_true(decoded_message + decoded_message_size <=
+		    transport_message + transport_message_size);
+	assert_true(decoded_message_size >= message_size);
+	assert_true(decoded_message_size < message_size + alignment);
+	assert_memory_equal(decoded_message, expected_message, message_size);
+}
+
+static void spdm_transport_in_place_test_round_trips(
+	IN spdm_transport_encode_message_in_place_func encode_message,
+	IN spdm_transport_decode_message_in_place_func decode_message,
+	IN uintn header_size, IN uintn tail_size, IN uintn alignment,
+	IN boolean is_secured)
+{
+	spdm_context_t *requester_context;
+	spdm_context_t *responder_context;
+	uint32 session_id;
+	uintn offset;
+	uintn index;
+
+	requester_context = spdm_transport_in_place_test_new_context(
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	responder_context = spdm_transport_in_place_test_new_context(
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	session_id = TEST_IN_PLACE_SESSION_ID;
+
+	for (offset = 0; offset < sizeof(uint32); offset++) {
+		for (index = 0; index < ARRAY_SIZE(m_in_place_message_size);
+		     index++) {
+			spdm_transport_in_place_test_round_trip(
+				requester_context, responder_context,
+				encode_message, decode_message, header_size,
+				tail_size, alignment,
+				is_secured ? &session_id : NULL, offset,
+				m_in_place_message_size[index]);
+		}
+	}
+
+	spdm_transport_in_place_test_free_context(requester_context);
+	spdm_transport_in_place_test_free_context(responder_context);
+}
+
+/**
+  Test 1: Encode and decode normal MCTP messages in place, at every offset of a 4-byte word
+  and with message sizes that are not a multiple of 4.
+  Expected behavior: the decoded message matches and no byte outside the room is written.
+**/
+static void test_spdm_common_transport_in_place_case1(void **state)
+{
+	spdm_transport_in_place_test_round_trips(
+		spdm_transport_mctp_encode_message_in_place,
+		spdm_transport_mctp_decode_message_in_place,
+		SPDM_MCTP_TRANSPORT_HEADER_SIZE, SPDM_MCTP_TRANSPORT_TAIL_SIZE,
+		SPDM_MCTP_ALIGNMENT, FALSE);
+}
+
+/**
+  Test 2: Encode and decode secured MCTP messages in place, at every offset of a 4-byte word
+  and with message sizes that are not a multiple of 4.
+  Expected behavior: the decoded message matches and no byte outside the room is written.
+**/
+static void test_spdm_common_transport_in_place_case2(void **state)
+{
+	spdm_transport_in_place_test_round_trips(
+		spdm_transport_mctp_encode_message_in_place,
+		spdm_transport_mctp_decode_message_in_place,
+		SPDM_MCTP_TRANSPORT_HEADER_SIZE, SPDM_MCTP_TRANSPORT_TAIL_SIZE,
+		SPDM_MCTP_ALIGNMENT, TRUE);
+}
+
+/**
+  Test 3: Encode and decode normal PCI DOE messages in place, at every offset of a 4-byte word
+  and with message sizes that are not a multiple of 4.
+  Expected behavior: the decoded message matches, followed by at most 3 bytes of padding,
+  and no byte outside the room is written.
+**/
+static void test_spdm_common_transport_in_place_case3(void **state)
+{
+	spdm_transport_in_place_test_round_trips(
+		spdm_transport_pci_doe_encode_message_in_place,
+		spdm_transport_pci_doe_decode_message_in_place,
+		SPDM_PCI_DOE_TRANSPORT_HEADER_SIZE,
+		SPDM_PCI_DOE_TRANSPORT_TAIL_SIZE, SPDM_PCI_DOE_ALIGNMENT,
+		FALSE);
+}
+
+/**
+  Test 4: Encode and decode secured PCI DOE messages in place, at every offset of a 4-byte word
+  and with message sizes that are not a multiple of 4.
+  Expected behavior: the decoded message matches and no byte outside the room is written.
+**/
+static void test_spdm_common_transport_in_place_case4(void **state)
+{
+	spdm_transport_in_place_test_round_trips(
+		spdm_transport_pci_doe_encode_message_in_place,
+		spdm_transport_pci_doe_decode_message_in_place,
+		SPDM_PCI_DOE_TRANSPORT_HEADER_SIZE,
+		SPDM_PCI_DOE_TRANSPORT_TAIL_SIZE, SPDM_PCI_DOE_ALIGNMENT,
+		TRUE);
+}
+
+/**
+  Test 5: Encode a secured message in place with one byte less head room, then with one
+  byte less tail room, than spdm_secured_message_get_room_size reports.
+  Expected behavior: both return RETURN_BUFFER_TOO_SMALL without writing the buffer or
+  consuming a sequence number, and the exact room then round-trips.
+**/
+static void test_spdm_common_transport_in_place_case5(void **state)
+{
+	return_status status;
+	spdm_context_t *requester_context;
+	spdm_context_t *responder_context;
+	void *requester_secured_context;
+	void *responder_secured_context;
+	spdm_secured_message_callbacks_t callbacks;
+	uint8 buffer[MAX_SPDM_TRANSPORT_HEADER_SIZE +
+		     TEST_IN_PLACE_MAX_MESSAGE_SIZE +
+		     MAX_SPDM_TRANSPORT_TAIL_SIZE];
+	uint8 expected_buffer[sizeof(buffer)];
+	uint8 *message;
+	uintn message_size;
+	uintn head_room_size;
+	uintn tail_room_size;
+	uint8 *secured_message;
+	uintn secured_message_size;
+	uint8 *decoded_message;
+	uintn decoded_message_size;
+
+	requester_context = spdm_transport_in_place_test_new_context(
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	responder_context = spdm_transport_in_place_test_new_context(
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP);
+	requester_secured_context =
+		spdm_get_secured_message_context_via_session_id(
+			requester_context, TEST_IN_PLACE_SESSION_ID);
+	responder_secured_context =
+		spdm_get_secured_message_context_via_session_id(
+			responder_context, TEST_IN_PLACE_SESSION_ID);
+
+	callbacks.version = SPDM_SECURED_MESSAGE_CALLBACKS_VERSION;
+	callbacks.get_sequence_number = spdm_mctp_get_sequence_number;
+	callbacks.get_max_random_number_count =
+		spdm_mctp_get_max_random_number_count;
+	spdm_secured_message_get_room_size(requester_secured_context,
+					   &callbacks, &head_room_size,
+					   &tail_room_size);
+	assert_true(head_room_size <= MAX_SPDM_TRANSPORT_HEADER_SIZE);
+	assert_true(tail_room_size <= MAX_SPDM_TRANSPORT_TAIL_SIZE);
+
+	message_size = 0x21;
+	message = buffer + head_room_size;
+	set_mem(buffer, sizeof(buffer), TEST_IN_PLACE_GUARD);
+	set_mem(message, message_size, 0x5A);
+	copy_mem(expected_buffer, buffer, sizeof(buffer));
+
+	status = spdm_encode_secured_message_in_place(
+		requester_secured_context, TEST_IN_PLACE_SESSION_ID, TRUE,
+		head_room_size - 1, message_size, message, tail_room_size,
+		&secured_message_size, (void **)&secured_message, &callbacks);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_memory_equal(buffer, expected_buffer, sizeof(buffer));
+
+	status = spdm_encode_secured_message_in_place(
+		requester_secured_context, TEST_IN_PLACE_SESSION_ID, TRUE,
+		head_room_size, message_size, message, tail_room_size - 1,
+		&secured_message_size, (void **)&secured_message, &callbacks);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_memory_equal(buffer, expected_buffer, sizeof(buffer));
+	assert_int_equal(((spdm_secured_message_context_t *)
+				  requester_secured_context)
+				 ->application_secret
+				 .request_data_sequence_number,
+			 0);
+
+	status = spdm_encode_secured_message_in_place(
+		requester_secured_context, TEST_IN_PLACE_SESSION_ID, TRUE,
+		head_room_size, message_size, message, tail_room_size,
+		&secured_message_size, (void **)&secured_message, &callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_ptr_equal(secured_message, buffer);
+	assert_true(secured_message_size <=
+		    head_room_size + message_size + tail_room_size);
+
+	status = spdm_decode_secured_message_in_place(
+		responder_secured_context, TEST_IN_PLACE_SESSION_ID, TRUE,
+		secured_message_size, secured_message, &decoded_message_size,
+		(void **)&decoded_message, &callbacks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(decoded_message_size, message_size);
+	assert_memory_equal(decoded_message, expected_buffer + head_room_size,
+			    message_size);
+
+	spdm_transport_in_place_test_free_context(requester_context);
+	spdm_transport_in_place_test_free_context(responder_context);
+}
+
+int spdm_common_transport_in_place_test_main(void)
+{
+	const struct CMUnitTest spdm_common_transport_in_place_tests[] = {
+		// Normal MCTP message
+		cmocka_unit_test(test_spdm_common_transport_in_place_case1),
+		// Secured MCTP message
+		cmocka_unit_test(test_spdm_common_transport_in_place_case2),
+		// Normal PCI DOE message
+		cmocka_unit_test(test_spdm_common_transport_in_place_case3),
+		// Secured PCI DOE message
+		cmocka_unit_test(test_spdm_common_transport_in_place_case4),
+		// Head room and tail room too small
+		cmocka_unit_test(test_spdm_common_transport_in_place_case5),
+	};
+
+	return cmocka_run_group_tests(spdm_common_transport_in_place_tests,
+				      NULL, NULL);
+}
@@ -214,6 +214,75 @@ void test_spdm_crypt_spdm_x509_certificate_check(void **state)
 	free(file_buffer);
 }
 
+void test_spdm_crypt_spdm_x509_verify_cert_chain_with_cache(void **state)
+{
+	boolean status;
+	uint8 *root_cert;
+	uintn root_cert_size;
+	uint8 *cert_chain;
+	uintn cert_chain_size;
+	void *cert_link_cache;
+	uint64 hit_count;
+	uint64 miss_count;
+	uint64 last_hit_count;
+	return_status ret;
+
+	status = read_input_file("rsa2048/ca.cert.der", (void **)&root_cert,
+				 &root_cert_size);
+	assert_true(status);
+	status = read_input_file("rsa2048/bundle_responder.certchain.der",
+				 (void **)&cert_chain, &cert_chain_size);
+	assert_true(status);
+
+	cert_link_cache = malloc(spdm_cert_link_cache_get_size(4));
+	ret = spdm_cert_link_cache_init(cert_link_cache, 0);
+	assert_int_equal(ret, RETURN_INVALID_PARAMETER);
+	ret = spdm_cert_link_cache_init(cert_link_cache, 4);
+	assert_int_equal((int)ret, RETURN_SUCCESS);
+
+	// The first verification fills the cache, the second one hits every link.
+	status = spdm_x509_verify_cert_chain_with_cache(
+		cert_link_cache, SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		root_cert, root_cert_size, cert_chain, cert_chain_size);
+	assert_true(status);
+	spdm_cert_link_cache_get_statistics(cert_link_cache, &hit_count,
+					    &miss_count);
+	assert_int_equal(hit_count, 0);
+	assert_int_not_equal(miss_count, 0);
+
+	status = spdm_x509_verify_cert_chain_with_cache(
+		cert_link_cache, SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		root_cert, root_cert_size, cert_chain, cert_chain_size);
+	assert_true(status);
+	spdm_cert_link_cache_get_statistics(cert_link_cache, &hit_count,
+					    &miss_count);
+	assert_int_equal(hit_count, miss_count);
+
+	// A tampered leaf certificate is not found in the cache and fails.
+	cert_chain[cert_chain_size - 1] ^= 0xFF;
+	status = spdm_x509_verify_cert_chain_with_cache(
+		cert_link_cache, SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		root_cert, root_cert_size, cert_chain, cert_chain_size);
+	assert_false(status);
+	cert_chain[cert_chain_size - 1] ^= 0xFF;
+
+	// After a flush every link is verified again.
+	spdm_cert_link_cache_get_statistics(cert_link_cache, &last_hit_count,
+					    &miss_count);
+	spdm_cert_link_cache_flush(cert_link_cache);
+	status = spdm_x509_verify_cert_chain_with_cache(
+		cert_link_cache, SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+		root_cert, root_cert_size, cert_chain, cert_chain_size);
+	assert_true(status);
+	spdm_cert_link_cache_get_statistics(cert_link_cache, &hit_count,
+					    &miss_count);
+	assert_int_equal(hit_count, last_hit_count);
+
+	free(cert_link_cache);
+	free(cert_chain);
+	free(root_cert);
+}
+
 int spdm_crypt_lib_setup(void **state)
 {
 	return 0;
@@ -231,7 +300,9 @@ int spdm_crypt_lib_test_main(void)
 			test_spdm_crypt_spdm_get_dmtf_subject_alt_name_from_bytes),
 		cmocka_unit_test(
 			test_spdm_crypt_spdm_get_dmtf_subject_alt_name),
-		cmocka_unit_test(test_spdm_crypt_spdm_x509_certificate_check)
+		cmocka_unit_test(test_spdm_crypt_spdm_x509_certificate_check),
+		cmocka_unit_test(
+			test_spdm_crypt_spdm_x509_verify_cert_chain_with_cache)
 	};
 
 	return cmocka_run_group_tests(spdm_crypt_lib_tests,
@@ -0,0 +1,446 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_requester_lib_internal.h>
+
+#pragma pack(1)
+typedef struct {
+	spdm_message_header_t header;
+	uint8 reserved;
+	uint8 version_number_entry_count;
+	spdm_version_number_t version_number_entry[2];
+} spdm_async_op_version_response_t;
+#pragma pack()
+
+static uint8 m_spdm_async_op_last_request_code;
+static uintn m_spdm_async_op_request_count;
+static uint64 m_spdm_async_op_time_us;
+
+uint64 spdm_requester_async_op_test_get_time_us(IN void *spdm_context)
+{
+	return m_spdm_async_op_time_us;
+}
+
+return_status spdm_requester_async_op_test_send_message(IN void *spdm_context,
+							IN uintn request_size,
+							IN void *request,
+							IN uint64 timeout)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_message_header_t *spdm_request;
+
+	spdm_test_context = get_spdm_test_context();
+	if (spdm_test_context->case_id == 0x1) {
+		return RETURN_DEVICE_ERROR;
+	}
+	spdm_request = (void *)((uint8 *)request + 1);
+	m_spdm_async_op_last_request_code = spdm_request->request_response_code;
+	m_spdm_async_op_request_count++;
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_requester_async_op_test_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	//
+	// The operations never receive by themselves.
+	//
+	assert_true(FALSE);
+	return RETURN_DEVICE_ERROR;
+}
+
+/**
+  Encode a VERSION response as a transport message.
+**/
+void spdm_requester_async_op_test_encode_version(IN void *spdm_context,
+						 IN OUT uintn *message_size,
+						 OUT void *message)
+{
+	spdm_async_op_version_response_t spdm_response;
+
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_response.header.request_response_code = SPDM_VERSION;
+	spdm_response.version_number_entry_count = 2;
+	spdm_response.version_number_entry[0].major_version = 1;
+	spdm_response.version_number_entry[0].minor_version = 0;
+	spdm_response.version_number_entry[1].major_version = 1;
+	spdm_response.version_number_entry[1].minor_version = 1;
+	spdm_transport_test_encode_message(spdm_context, NULL, FALSE, FALSE,
+					   sizeof(spdm_response), &spdm_response,
+					   message_size, message);
+}
+
+/**
+  Encode an ERROR response as a transport message.
+**/
+void spdm_requester_async_op_test_encode_error(IN void *spdm_context,
+					       IN uint8 error_code,
+					       IN OUT uintn *message_size,
+					       OUT void *message)
+{
+	spdm_error_response_data_response_not_ready_t spdm_response;
+	uintn spdm_response_size;
+
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_response.header.request_response_code = SPDM_ERROR;
+	spdm_response.header.param1 = error_code;
+	if (error_code == SPDM_ERROR_CODE_RESPONSE_NOT_READY) {
+		spdm_response.extend_error_data.rd_exponent = 1;
+		spdm_response.extend_error_data.rd_tm = 1;
+		spdm_response.extend_error_data.request_code = SPDM_GET_VERSION;
+		spdm_response.extend_error_data.token = 1;
+		spdm_response_size = sizeof(spdm_response);
+	} else {
+		spdm_response_size = sizeof(spdm_error_response_t);
+	}
+	spdm_transport_test_encode_message(spdm_context, NULL, FALSE, FALSE,
+					   spdm_response_size, &spdm_response,
+					   message_size, message);
+}
+
+/**
+  Test 1: the first request of an operation cannot be sent.
+  Expected behavior: spdm_op_start completes the operation with RETURN_DEVICE_ERROR.
+**/
+void test_spdm_requester_async_op_case1(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_connection(op, spdm_context, TRUE);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, NULL), SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	free(op);
+}
+
+/**
+  Test 2: GET_VERSION is driven by an event loop with a successful response.
+  Expected behavior: the operation waits until the VERSION is delivered, then completes
+  with RETURN_SUCCESS and the connection state is AFTER_VERSION. Later messages are ignored.
+**/
+void test_spdm_requester_async_op_case2(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+	m_spdm_async_op_request_count = 0;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_connection(op, spdm_context, TRUE);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_WOULD_BLOCK);
+	assert_int_equal(m_spdm_async_op_last_request_code, SPDM_GET_VERSION);
+	assert_int_equal(spdm_op_poll(op, NULL, NULL), SPDM_OP_STATUS_WOULD_BLOCK);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_version(spdm_context, &message_size,
+						    message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, NULL), SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_VERSION);
+	assert_int_equal(spdm_context->connection_info.version.minor_version,
+			 1);
+
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(m_spdm_async_op_request_count, 1);
+	free(op);
+}
+
+/**
+  Test 3: GET_VERSION gets RESPONSE_NOT_READY, then the VERSION.
+  Expected behavior: the operation waits the RDT reported by spdm_op_poll, then sends
+  RESPOND_IF_READY and completes with RETURN_SUCCESS.
+**/
+void test_spdm_requester_async_op_case3(void **state)
+{
+	return_status status;
+	uint64 wait_us;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_connection(op, spdm_context, TRUE);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_WOULD_BLOCK);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_error(
+		spdm_context, SPDM_ERROR_CODE_RESPONSE_NOT_READY, &message_size,
+		message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_WAIT);
+	assert_int_equal(m_spdm_async_op_last_request_code, SPDM_GET_VERSION);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us), SPDM_OP_STATUS_WAIT);
+	assert_int_equal(wait_us, 2);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us),
+			 SPDM_OP_STATUS_WOULD_BLOCK);
+	assert_int_equal(wait_us, 0);
+	assert_int_equal(m_spdm_async_op_last_request_code,
+			 SPDM_RESPOND_IF_READY);
+	assert_int_equal(spdm_context->error_data.token, 1);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_version(spdm_context, &message_size,
+						    message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, NULL), SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	free(op);
+}
+
+/**
+  Test 4: GET_VERSION gets BUSY.
+  Expected behavior: the operation resends GET_VERSION after the backoff while retry_times
+  allows it, then completes with RETURN_NO_RESPONSE.
+**/
+void test_spdm_requester_async_op_case4(void **state)
+{
+	return_status status;
+	uint64 wait_us;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x4;
+	spdm_context->retry_policy.retry_times = 1;
+	m_spdm_async_op_request_count = 0;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_connection(op, spdm_context, TRUE);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_WOULD_BLOCK);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_error(
+		spdm_context, SPDM_ERROR_CODE_BUSY, &message_size, message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_WAIT);
+	assert_int_equal(m_spdm_async_op_request_count, 1);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us), SPDM_OP_STATUS_WAIT);
+	assert_int_not_equal(wait_us, 0);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us),
+			 SPDM_OP_STATUS_WOULD_BLOCK);
+	assert_int_equal(m_spdm_async_op_last_request_code, SPDM_GET_VERSION);
+	assert_int_equal(m_spdm_async_op_request_count, 2);
+
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, NULL), SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_NO_RESPONSE);
+	assert_int_equal(m_spdm_async_op_request_count, 2);
+	free(op);
+}
+
+/**
+  Test 5: GET_DIGEST is started before the connection is negotiated.
+  Expected behavior: the request is not built, and the operation completes with RETURN_UNSUPPORTED.
+**/
+void test_spdm_requester_async_op_case5(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x5;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+	m_spdm_async_op_request_count = 0;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_get_digest(op, spdm_context, &slot_mask,
+				total_digest_buffer);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, NULL), SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_UNSUPPORTED);
+	assert_int_equal(m_spdm_async_op_request_count, 0);
+	free(op);
+}
+
+/**
+  Test 6: GET_VERSION gets BUSY twice with a clock registered, then the VERSION.
+  Expected behavior: spdm_op_poll reports the time left of the backoff, which doubles after
+  each retry, and GET_VERSION is only resent once the backoff is over.
+**/
+void test_spdm_requester_async_op_case6(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	uint64 wait_us;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x6;
+	spdm_context->retry_policy.retry_times = 2;
+	spdm_context->retry_policy.initial_backoff_us = 100;
+	spdm_context->retry_policy.max_backoff_us = 1000;
+	spdm_context->retry_policy.deadline_us = 0;
+	spdm_register_timer_func(spdm_context, NULL,
+				 spdm_requester_async_op_test_get_time_us);
+	m_spdm_async_op_time_us = 1000;
+	m_spdm_async_op_request_count = 0;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_connection(op, spdm_context, TRUE);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_WOULD_BLOCK);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_error(
+		spdm_context, SPDM_ERROR_CODE_BUSY, &message_size, message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_WAIT);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us), SPDM_OP_STATUS_WAIT);
+	assert_int_equal(wait_us, 100);
+	m_spdm_async_op_time_us += 60;
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us), SPDM_OP_STATUS_WAIT);
+	assert_int_equal(wait_us, 40);
+	assert_int_equal(m_spdm_async_op_request_count, 1);
+	m_spdm_async_op_time_us += 40;
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us),
+			 SPDM_OP_STATUS_WOULD_BLOCK);
+	assert_int_equal(wait_us, 0);
+	assert_int_equal(m_spdm_async_op_last_request_code, SPDM_GET_VERSION);
+	assert_int_equal(m_spdm_async_op_request_count, 2);
+
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_WAIT);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us), SPDM_OP_STATUS_WAIT);
+	assert_int_equal(wait_us, 200);
+	m_spdm_async_op_time_us += 200;
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us),
+			 SPDM_OP_STATUS_WOULD_BLOCK);
+	assert_int_equal(m_spdm_async_op_request_count, 3);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_version(spdm_context, &message_size,
+						    message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, &wait_us),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(wait_us, 0);
+
+	spdm_register_timer_func(spdm_context, NULL, NULL);
+	free(op);
+}
+
+/**
+  Test 7: GET_VERSION gets RESPONSE_NOT_READY, and RESPOND_IF_READY gets RESPONSE_NOT_READY again.
+  Expected behavior: after RDTM RESPOND_IF_READY, the operation completes with RETURN_DEVICE_ERROR.
+**/
+void test_spdm_requester_async_op_case7(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *op;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	uint64 wait_us;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x7;
+	m_spdm_async_op_request_count = 0;
+
+	op = malloc(spdm_op_get_size());
+	spdm_op_init_connection(op, spdm_context, TRUE);
+	assert_int_equal(spdm_op_start(op), SPDM_OP_STATUS_WOULD_BLOCK);
+
+	message_size = sizeof(message);
+	spdm_requester_async_op_test_encode_error(
+		spdm_context, SPDM_ERROR_CODE_RESPONSE_NOT_READY, &message_size,
+		message);
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_WAIT);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us), SPDM_OP_STATUS_WAIT);
+	assert_int_equal(wait_us, 2);
+	assert_int_equal(spdm_op_poll(op, NULL, &wait_us),
+			 SPDM_OP_STATUS_WOULD_BLOCK);
+	assert_int_equal(m_spdm_async_op_last_request_code,
+			 SPDM_RESPOND_IF_READY);
+
+	assert_int_equal(spdm_op_on_message_received(op, message_size, message),
+			 SPDM_OP_STATUS_DONE);
+	assert_int_equal(spdm_op_poll(op, &status, NULL), SPDM_OP_STATUS_DONE);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	assert_int_equal(m_spdm_async_op_request_count, 2);
+	free(op);
+}
+
+spdm_test_context_t m_spdm_requester_async_op_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_requester_async_op_test_send_message,
+	spdm_requester_async_op_test_receive_message,
+};
+
+int spdm_requester_async_op_test_main(void)
+{
+	const struct CMUnitTest spdm_requester_async_op_tests[] = {
+		// Send failure
+		cmocka_unit_test(test_spdm_requester_async_op_case1),
+		// Successful response
+		cmocka_unit_test(test_spdm_requester_async_op_case2),
+		// SPDM_ERROR_CODE_RESPONSE_NOT_READY + Successful response
+		cmocka_unit_test(test_spdm_requester_async_op_case3),
+		// Always SPDM_ERROR_CODE_BUSY
+		cmocka_unit_test(test_spdm_requester_async_op_case4),
+		// Request not allowed in the connection state
+		cmocka_unit_test(test_spdm_requester_async_op_case5),
+		// SPDM_ERROR_CODE_BUSY twice with a clock + Successful response
+		cmocka_unit_test(test_spdm_requester_async_op_case6),
+		// Always SPDM_ERROR_CODE_RESPONSE_NOT_READY
+		cmocka_unit_test(test_spdm_requester_async_op_case7),
+	};
+
+	setup_spdm_test_context(&m_spdm_requester_async_op_test_context);
+
+	return cmocka_run_group_tests(spdm_requester_async_op_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
@@ -116,10 +116,10 @@ return_status spdm_requester_challenge_test_receive_message(
 							m_use_asym_algo, &data,
 							&data_size, NULL, NULL);
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision_size[0] =
+			->local_context->local_cert_chain_provision_size[0] =
 			data_size;
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision[0] = data;
+			->local_context->local_cert_chain_provision[0] = data;
 		((spdm_context_t *)spdm_context)
 			->connection_info.algorithm.base_asym_algo =
 			m_use_asym_algo;
@@ -141,10 +141,10 @@ return_status spdm_requester_challenge_test_receive_message(
 		spdm_hash_all(
 			m_use_hash_algo,
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0],
+				->local_context->local_cert_chain_provision[0],
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0],
+				->local_cert_chain_provision_size[0],
 			ptr);
 		free(data);
 		ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -193,10 +193,10 @@ return_status spdm_requester_challenge_test_receive_message(
 							m_use_asym_algo, &data,
 							&data_size, NULL, NULL);
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision_size[0] =
+			->local_context->local_cert_chain_provision_size[0] =
 			data_size;
 		((spdm_context_t *)spdm_context)
-			->local_context.local_cert_chain_provision[0] = data;
+			->local_context->local_cert_chain_provision[0] = data;
 		((spdm_context_t *)spdm_context)
 			->connection_info.algorithm.base_asym_algo =
 			m_use_asym_algo;
@@ -218,10 +218,10 @@ return_status spdm_requester_challenge_test_receive_message(
 		spdm_hash_all(
 			m_use_hash_algo,
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0],
+				->local_context->local_cert_chain_provision[0],
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0],
+				->local_cert_chain_provision_size[0],
 			ptr);
 		free(data);
 		ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -311,9 +311,9 @@ return_status spdm_requester_challenge_test_receive_message(
 				&data_size, NULL, NULL);
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0] = data_size;
+				->local_cert_chain_provision_size[0] = data_size;
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0] =
+				->local_context->local_cert_chain_provision[0] =
 				data;
 			((spdm_context_t *)spdm_context)
 				->connection_info.algorithm.base_asym_algo =
@@ -339,10 +339,10 @@ return_status spdm_requester_challenge_test_receive_message(
 				m_use_hash_algo,
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision[0],
+					->local_cert_chain_provision[0],
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision_size[0],
+					->local_cert_chain_provision_size[0],
 				ptr);
 			free(data);
 			ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -449,9 +449,9 @@ return_status spdm_requester_challenge_test_receive_message(
 				&data_size, NULL, NULL);
 			((spdm_context_t *)spdm_context)
 				->local_context
-				.local_cert_chain_provision_size[0] = data_size;
+				->local_cert_chain_provision_size[0] = data_size;
 			((spdm_context_t *)spdm_context)
-				->local_context.local_cert_chain_provision[0] =
+				->local_context->local_cert_chain_provision[0] =
 				data;
 			((spdm_context_t *)spdm_context)
 				->connection_info.algorithm.base_asym_algo =
@@ -477,10 +477,10 @@ return_status spdm_requester_challenge_test_receive_message(
 				m_use_hash_algo,
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision[0],
+					->local_cert_chain_provision[0],
 				((spdm_context_t *)spdm_context)
 					->local_context
-					.local_cert_chain_provision_size[0],
+					->local_cert_chain_provision_size[0],
 				ptr);
 			free(data);
 			ptr += spdm_get_hash_size(m_use_hash_algo);
@@ -526,8 +526,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -543,7 +543,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -593,8 +593,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -610,7 +610,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -643,8 +643,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -660,7 +660,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -693,8 +693,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -710,7 +710,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 1;
     spdm_response->header.param2 = (1 << 1); //wrong slot number
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -743,8 +743,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -760,7 +760,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 8; //slot number overflow
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -793,8 +793,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -810,7 +810,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -845,8 +845,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -862,7 +862,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -897,8 +897,8 @@ return_status spdm_requester_challenge_test_receive_message(
     uintn                         temp_buf_size;
 
     read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0] = data_size;
-    ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0] = data;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0] = data_size;
+    ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0] = data;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
     ((spdm_context_t*)spdm_context)->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
     temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
@@ -913,7 +913,7 @@ return_status spdm_requester_challenge_test_receive_message(
     spdm_response->header.param1 = 0;
     spdm_response->header.param2 = (1 << 0);
     Ptr = (void *)(spdm_response + 1);
-    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context.local_cert_chain_provision_size[0], Ptr);
+    spdm_hash_all (m_use_hash_algo, ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision[0], ((spdm_context_t*)spdm_context)->local_context->local_cert_chain_provision_size[0], Ptr);
     free(data);
     Ptr += spdm_get_hash_size (m_use_hash_algo);
     spdm_get_random_number (SPDM_NONCE_SIZE, Ptr);
@@ -1970,6 +1970,79 @@ void test_spdm_requester_challenge_case20(void **state) {
   free(data);
 }
 
+/**
+  Test 21: the requester is setup as in test 2 and receives the same correct
+  CHALLENGE_AUTH message, with the requester metrics cleared beforehand.
+  Expected behavior: client returns a status of RETURN_SUCCESS, and the requester
+  metrics count the CHALLENGE phase, one message sent and one received, and the
+  verification of the CHALLENGE_AUTH signature.
+**/
+void test_spdm_requester_challenge_case21(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	spdm_requester_metrics_t metrics;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags = 0;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 1;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+
+	zero_mem(&metrics, sizeof(metrics));
+	status = spdm_set_data(spdm_context, SPDM_DATA_REQUESTER_METRICS, NULL,
+			       &metrics, sizeof(metrics));
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	zero_mem(measurement_hash, sizeof(measurement_hash));
+	status = spdm_challenge(
+		spdm_context, 0,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+		measurement_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	data_size = sizeof(metrics);
+	status = spdm_get_data(spdm_context, SPDM_DATA_REQUESTER_METRICS, NULL,
+			       &metrics, &data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	for (index = 0; index < SPDM_REQUESTER_PHASE_MAX; index++) {
+		assert_int_equal(metrics.phase[index].count,
+				 (index == SPDM_REQUESTER_PHASE_CHALLENGE) ? 1 : 0);
+	}
+	assert_int_equal(metrics.send.count, 1);
+	assert_int_equal(metrics.receive.count, 1);
+	assert_int_equal(metrics.crypto[SPDM_CRYPTO_OP_ASYM_VERIFY].count, 1);
+	assert_int_equal(metrics.crypto[SPDM_CRYPTO_OP_ASYM_SIGN].count, 0);
+	free(data);
+}
+
 spdm_test_context_t m_spdm_requester_challenge_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -2016,6 +2089,8 @@ int spdm_requester_challenge_test_main(void)
 		cmocka_unit_test(test_spdm_requester_challenge_case19),
 		// Unexpected errors
 		cmocka_unit_test(test_spdm_requester_challenge_case20),
+		// Successful response, requester metrics
+		cmocka_unit_test(test_spdm_requester_challenge_case21),
 	};
 
 	setup_spdm_test_context(&m_spdm_requester_challenge_test_context);
@@ -755,8 +755,8 @@ void test_spdm_requester_get_capabilities_case1(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -777,8 +777,8 @@ void test_spdm_requester_get_capabilities_case2(void **state)
 						spdm_context->transcript.message_m.max_buffer_size;
 #endif
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -802,8 +802,8 @@ void test_spdm_requester_get_capabilities_case3(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_UNSUPPORTED);
 }
@@ -820,8 +820,8 @@ void test_spdm_requester_get_capabilities_case4(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -838,8 +838,8 @@ void test_spdm_requester_get_capabilities_case5(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_NO_RESPONSE);
 }
@@ -856,8 +856,8 @@ void test_spdm_requester_get_capabilities_case6(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -878,8 +878,8 @@ void test_spdm_requester_get_capabilities_case7(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	assert_int_equal(spdm_context->connection_info.connection_state,
@@ -898,8 +898,8 @@ void test_spdm_requester_get_capabilities_case8(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -916,8 +916,8 @@ void test_spdm_requester_get_capabilities_case9(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 	//  assert_int_equal (spdm_context->connection_info.capability.ct_exponent, 0);
@@ -936,8 +936,8 @@ void test_spdm_requester_get_capabilities_case10(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -962,8 +962,8 @@ void test_spdm_requester_get_capabilities_case11(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -989,8 +989,8 @@ void test_spdm_requester_get_capabilities_case12(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(spdm_context->connection_info.capability.ct_exponent,
@@ -1011,8 +1011,8 @@ void test_spdm_requester_get_capabilities_case13(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -1029,8 +1029,8 @@ void test_spdm_requester_get_capabilities_case14(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -1047,8 +1047,8 @@ void test_spdm_requester_get_capabilities_case15(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG;
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
 }
@@ -1067,8 +1067,8 @@ void test_spdm_requester_get_capabilities_case16(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
@@ -1092,8 +1092,8 @@ void test_spdm_requester_get_capabilities_case17(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1115,8 +1115,8 @@ void test_spdm_requester_get_capabilities_case18(void **state)
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1139,8 +1139,8 @@ void test_spdm_requester_get_capabilities_case19(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1163,8 +1163,8 @@ void test_spdm_requester_get_capabilities_case20(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1187,8 +1187,8 @@ void test_spdm_requester_get_capabilities_case21(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1211,8 +1211,8 @@ void test_spdm_requester_get_capabilities_case22(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1235,8 +1235,8 @@ void test_spdm_requester_get_capabilities_case23(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1259,8 +1259,8 @@ void test_spdm_requester_get_capabilities_case24(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1283,8 +1283,8 @@ void test_spdm_requester_get_capabilities_case25(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1307,8 +1307,8 @@ void test_spdm_requester_get_capabilities_case26(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1331,8 +1331,8 @@ void test_spdm_requester_get_capabilities_case27(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1353,8 +1353,8 @@ void test_spdm_requester_get_capabilities_case28(void **state)
 		SPDM_CONNECTION_STATE_AFTER_VERSION;
 	spdm_reset_message_a(spdm_context);
 
-	spdm_context->local_context.capability.ct_exponent = 0;
-	spdm_context->local_context.capability.flags =
+	spdm_context->local_context->capability.ct_exponent = 0;
+	spdm_context->local_context->capability.flags =
 		DEFAULT_CAPABILITY_FLAG_VERSION_11;
 	status = spdm_get_capabilities(spdm_context);
 	assert_int_equal(status, RETURN_DEVICE_ERROR);
@@ -1371,8 +1371,8 @@ void test_spdm_requester_get_capabilities_case29(void **state) {
   spdm_test_context->case_id = 0x1d;
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
-  spdm_context->local_context.capability.ct_exponent = 0;
-  spdm_context->local_context.capability.flags = DEFAULT_CAPABILITY_FLAG_VERSION_11;
+  spdm_context->local_context->capability.ct_exponent = 0;
+  spdm_context->local_context->capability.flags = DEFAULT_CAPABILITY_FLAG_VERSION_11;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
   while(error_code <= 0xff) {
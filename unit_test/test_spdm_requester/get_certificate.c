@@ -1135,11 +1135,11 @@ void test_spdm_requester_get_certificate_case1(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1193,11 +1193,11 @@ void test_spdm_requester_get_certificate_case2(void **state)
 			root_cert_size);
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1252,11 +1252,11 @@ void test_spdm_requester_get_certificate_case3(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1303,11 +1303,11 @@ void test_spdm_requester_get_certificate_case4(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1354,11 +1354,11 @@ void test_spdm_requester_get_certificate_case5(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1408,11 +1408,11 @@ void test_spdm_requester_get_certificate_case6(void **state)
 						&root_cert, &root_cert_size);
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1462,11 +1462,11 @@ void test_spdm_requester_get_certificate_case7(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1515,11 +1515,11 @@ void test_spdm_requester_get_certificate_case8(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1566,11 +1566,11 @@ void test_spdm_requester_get_certificate_case9(void **state)
 						&root_cert, &root_cert_size);
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1623,10 +1623,10 @@ void test_spdm_requester_get_certificate_case10(void **state)
 						&root_cert, &root_cert_size);
 	count = (data_size + MAX_SPDM_CERT_CHAIN_BLOCK_LEN - 1) /
 		MAX_SPDM_CERT_CHAIN_BLOCK_LEN;
-	spdm_context->local_context.peer_root_cert_provision_size = 0;
-	spdm_context->local_context.peer_root_cert_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision = data;
-	spdm_context->local_context.peer_cert_chain_provision_size = data_size;
+	spdm_context->local_context->peer_root_cert_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision = data;
+	spdm_context->local_context->peer_cert_chain_provision_size = data_size;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1679,11 +1679,11 @@ void test_spdm_requester_get_certificate_case11(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
@@ -1743,11 +1743,11 @@ void test_spdm_requester_get_certificate_case12(void **state)
 	if (root_cert != NULL) {
 		((uint8 *)root_cert)[0]++;
 	}
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
@@ -1804,11 +1804,11 @@ void test_spdm_requester_get_certificate_case13(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
@@ -1869,11 +1869,11 @@ void test_spdm_requester_get_certificate_case14(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
@@ -1933,11 +1933,11 @@ void test_spdm_requester_get_certificate_case15(void **state)
 	x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
-	spdm_context->local_context.peer_root_cert_provision_size =
+	spdm_context->local_context->peer_root_cert_provision_size =
 		root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	// Reseting message buffer
@@ -1994,10 +1994,10 @@ void test_spdm_requester_get_certificate_case16(void **state) {
   x509_get_cert_from_cert_chain((uint8 *)data + sizeof(spdm_cert_chain_t) + hash_size,
 					data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 					&root_cert, &root_cert_size);
-  spdm_context->local_context.peer_root_cert_provision_size = root_cert_size;
-  spdm_context->local_context.peer_root_cert_provision = root_cert;
-  spdm_context->local_context.peer_cert_chain_provision = NULL;
-  spdm_context->local_context.peer_cert_chain_provision_size = 0;
+  spdm_context->local_context->peer_root_cert_provision_size = root_cert_size;
+  spdm_context->local_context->peer_root_cert_provision = root_cert;
+  spdm_context->local_context->peer_cert_chain_provision = NULL;
+  spdm_context->local_context->peer_cert_chain_provision_size = 0;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
@@ -2062,10 +2062,10 @@ void test_spdm_requester_get_certificate_case17(void **state)
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
 
-	spdm_context->local_context.peer_root_cert_provision_size = root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision_size = root_cert_size;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -2110,10 +2110,10 @@ void test_spdm_requester_get_certificate_case18(void **state)
 						data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
 						&root_cert, &root_cert_size);
 
-	spdm_context->local_context.peer_root_cert_provision_size = root_cert_size;
-	spdm_context->local_context.peer_root_cert_provision = root_cert;
-	spdm_context->local_context.peer_cert_chain_provision = NULL;
-	spdm_context->local_context.peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->peer_root_cert_provision_size = root_cert_size;
+	spdm_context->local_context->peer_root_cert_provision = root_cert;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
 	spdm_reset_message_b(spdm_context);
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
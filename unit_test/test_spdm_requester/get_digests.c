@@ -11,6 +11,31 @@
 
 static uint8 m_local_certificate_chain[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 
+// Fake clock advanced by the sleep function, and the waits of the requester
+static uint64 m_get_digests_time_us;
+static uint64 m_get_digests_sleep_us[8];
+static uintn m_get_digests_sleep_count;
+static uintn m_get_digests_not_ready_count;
+
+// Certificate chain reported in slot 1 by case 0x19
+static void *m_get_digests_resume_cert_chain;
+static uintn m_get_digests_resume_cert_chain_size;
+
+void spdm_requester_get_digests_test_sleep(IN void *spdm_context,
+					   IN uint64 duration_us)
+{
+	if (m_get_digests_sleep_count < ARRAY_SIZE(m_get_digests_sleep_us)) {
+		m_get_digests_sleep_us[m_get_digests_sleep_count] = duration_us;
+	}
+	m_get_digests_sleep_count++;
+	m_get_digests_time_us += duration_us;
+}
+
+uint64 spdm_requester_get_digests_test_get_time_us(IN void *spdm_context)
+{
+	return m_get_digests_time_us;
+}
+
 return_status spdm_requester_get_digests_test_send_message(
 	IN void *spdm_context, IN uintn request_size, IN void *request,
 	IN uint64 timeout)
@@ -63,6 +88,12 @@ return_status spdm_requester_get_digests_test_send_message(
 		return RETURN_SUCCESS;
 	case 0x16:
 		return RETURN_SUCCESS;
+	case 0x17:
+		return RETURN_SUCCESS;
+	case 0x18:
+		return RETURN_SUCCESS;
+	case 0x19:
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -632,6 +663,98 @@ return_status spdm_requester_get_digests_test_receive_message(
   }
     return RETURN_SUCCESS;
 
+	case 0x17: {
+		spdm_error_response_t spdm_response;
+
+		spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_response.header.request_response_code = SPDM_ERROR;
+		spdm_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+		spdm_response.header.param2 = 0;
+
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE, sizeof(spdm_response),
+						   &spdm_response,
+						   response_size, response);
+	}
+		return RETURN_SUCCESS;
+
+	case 0x18:
+		if (m_get_digests_not_ready_count != 0) {
+			spdm_error_response_data_response_not_ready_t
+				spdm_response;
+
+			m_get_digests_not_ready_count--;
+			spdm_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response.header.request_response_code = SPDM_ERROR;
+			spdm_response.header.param1 =
+				SPDM_ERROR_CODE_RESPONSE_NOT_READY;
+			spdm_response.header.param2 = 0;
+			spdm_response.extend_error_data.rd_exponent = 4;
+			spdm_response.extend_error_data.rd_tm = 3;
+			spdm_response.extend_error_data.request_code =
+				SPDM_GET_DIGESTS;
+			spdm_response.extend_error_data.token = 1;
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(spdm_response), &spdm_response,
+				response_size, response);
+		} else {
+			spdm_digest_response_t *spdm_response;
+			uint8 *digest;
+			uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+			uintn temp_buf_size;
+
+			temp_buf_size = sizeof(spdm_digest_response_t) +
+					spdm_get_hash_size(m_use_hash_algo);
+			spdm_response = (void *)temp_buf;
+
+			spdm_response->header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response->header.request_response_code =
+				SPDM_DIGESTS;
+			spdm_response->header.param1 = 0;
+			spdm_response->header.param2 = (1 << 0);
+			digest = (void *)(spdm_response + 1);
+			spdm_hash_all(m_use_hash_algo,
+				      m_local_certificate_chain,
+				      MAX_SPDM_MESSAGE_BUFFER_SIZE, &digest[0]);
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE, temp_buf_size,
+				temp_buf, response_size, response);
+		}
+		return RETURN_SUCCESS;
+
+	case 0x19: {
+		spdm_digest_response_t *spdm_response;
+		uint8 *digest;
+		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+		uintn temp_buf_size;
+		uintn hash_size;
+
+		hash_size = spdm_get_hash_size(m_use_hash_algo);
+		temp_buf_size = sizeof(spdm_digest_response_t) + hash_size * 2;
+		spdm_response = (void *)temp_buf;
+
+		spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_response->header.request_response_code = SPDM_DIGESTS;
+		spdm_response->header.param1 = 0;
+		spdm_response->header.param2 = (1 << 0) | (1 << 1);
+		digest = (void *)(spdm_response + 1);
+		set_mem(digest, hash_size, (uint8)(0xFF));
+		spdm_hash_all(m_use_hash_algo, m_get_digests_resume_cert_chain,
+			      m_get_digests_resume_cert_chain_size,
+			      &digest[hash_size]);
+
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE, temp_buf_size,
+						   temp_buf, response_size,
+						   response);
+	}
+		return RETURN_SUCCESS;
+
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -658,9 +781,9 @@ void test_spdm_requester_get_digests_case1(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -696,9 +819,9 @@ void test_spdm_requester_get_digests_case2(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -745,9 +868,9 @@ void test_spdm_requester_get_digests_case3(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -783,9 +906,9 @@ void test_spdm_requester_get_digests_case4(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -821,9 +944,9 @@ void test_spdm_requester_get_digests_case5(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -860,9 +983,9 @@ void test_spdm_requester_get_digests_case6(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -904,9 +1027,9 @@ void test_spdm_requester_get_digests_case7(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -945,9 +1068,9 @@ void test_spdm_requester_get_digests_case8(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -981,9 +1104,9 @@ void test_spdm_requester_get_digests_case9(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1024,9 +1147,9 @@ void test_spdm_requester_get_digests_case10(void **state)
 	spdm_context->connection_info.capability.flags = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1062,9 +1185,9 @@ void test_spdm_requester_get_digests_case11(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1102,9 +1225,9 @@ void test_spdm_requester_get_digests_case12(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1141,9 +1264,9 @@ void test_spdm_requester_get_digests_case13(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1180,9 +1303,9 @@ void test_spdm_requester_get_digests_case14(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1220,9 +1343,9 @@ void test_spdm_requester_get_digests_case15(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1258,9 +1381,9 @@ void test_spdm_requester_get_digests_case16(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1299,9 +1422,9 @@ void test_spdm_requester_get_digests_case17(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1337,9 +1460,9 @@ void test_spdm_requester_get_digests_case18(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1376,9 +1499,9 @@ void test_spdm_requester_get_digests_case19(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1414,9 +1537,9 @@ void test_spdm_requester_get_digests_case20(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1454,9 +1577,9 @@ void test_spdm_requester_get_digests_case21(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.peer_cert_chain_provision =
+	spdm_context->local_context->peer_cert_chain_provision =
 		m_local_certificate_chain;
-	spdm_context->local_context.peer_cert_chain_provision_size =
+	spdm_context->local_context->peer_cert_chain_provision_size =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
@@ -1493,8 +1616,8 @@ void test_spdm_requester_get_digests_case22(void **state) {
   spdm_test_context->case_id = 0x16;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.peer_cert_chain_provision = m_local_certificate_chain;
-  spdm_context->local_context.peer_cert_chain_provision_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->peer_cert_chain_provision = m_local_certificate_chain;
+  spdm_context->local_context->peer_cert_chain_provision_size = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
 
   error_code = SPDM_ERROR_CODE_RESERVED_00;
@@ -1524,6 +1647,337 @@ void test_spdm_requester_get_digests_case22(void **state) {
   }
 }
 
+/**
+  Test 23: ERROR response messages with error code = Busy are received in all attempts,
+  with a retry policy and timer functions registered
+  Expected Behavior: requester returns the status RETURN_NO_RESPONSE, after waiting an exponential
+  backoff with jitter between the attempts, and stops retrying before the deadline is passed
+**/
+void test_spdm_requester_get_digests_case23(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	spdm_retry_policy_t default_retry_policy;
+	spdm_retry_policy_t retry_policy;
+	uintn data_size;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x17;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context->peer_cert_chain_provision =
+		m_local_certificate_chain;
+	spdm_context->local_context->peer_cert_chain_provision_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	spdm_register_timer_func(spdm_context,
+				 spdm_requester_get_digests_test_sleep,
+				 spdm_requester_get_digests_test_get_time_us);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	data_size = sizeof(default_retry_policy);
+	status = spdm_get_data(spdm_context, SPDM_DATA_RETRY_POLICY, &parameter,
+			       &default_retry_policy, &data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(default_retry_policy.retry_times,
+			 MAX_SPDM_REQUEST_RETRY_TIMES);
+
+	//
+	// backoff 100, 200, 300, 300 (max)
+	//
+	retry_policy.retry_times = 4;
+	retry_policy.jitter_percent = 0;
+	retry_policy.initial_backoff_us = 100;
+	retry_policy.max_backoff_us = 300;
+	retry_policy.deadline_us = 0;
+	status = spdm_set_data(spdm_context, SPDM_DATA_RETRY_POLICY, &parameter,
+			       &retry_policy, sizeof(retry_policy));
+	assert_int_equal(status, RETURN_SUCCESS);
+	m_get_digests_sleep_count = 0;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_reset_message_b(spdm_context);
+	status =
+		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	assert_int_equal(status, RETURN_NO_RESPONSE);
+	assert_int_equal(m_get_digests_sleep_count, 4);
+	assert_int_equal(m_get_digests_sleep_us[0], 100);
+	assert_int_equal(m_get_digests_sleep_us[1], 200);
+	assert_int_equal(m_get_digests_sleep_us[2], 300);
+	assert_int_equal(m_get_digests_sleep_us[3], 300);
+
+	//
+	// The third wait would end after the deadline
+	//
+	retry_policy.deadline_us = 450;
+	spdm_set_data(spdm_context, SPDM_DATA_RETRY_POLICY, &parameter,
+		      &retry_policy, sizeof(retry_policy));
+	m_get_digests_sleep_count = 0;
+	status =
+		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	assert_int_equal(status, RETURN_NO_RESPONSE);
+	assert_int_equal(m_get_digests_sleep_count, 2);
+
+	//
+	// Each wait is the backoff plus up to 50% of jitter
+	//
+	retry_policy.jitter_percent = 50;
+	retry_policy.deadline_us = 0;
+	spdm_set_data(spdm_context, SPDM_DATA_RETRY_POLICY, &parameter,
+		      &retry_policy, sizeof(retry_policy));
+	m_get_digests_sleep_count = 0;
+	status =
+		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	assert_int_equal(status, RETURN_NO_RESPONSE);
+	assert_int_equal(m_get_digests_sleep_count, 4);
+	for (index = 0; index < 4; index++) {
+		assert_true(m_get_digests_sleep_us[index] >=
+			    MIN(100 << index, 300));
+		assert_true(m_get_digests_sleep_us[index] <=
+			    MIN(100 << index, 300) * 3 / 2);
+	}
+
+	retry_policy.jitter_percent = 101;
+	status = spdm_set_data(spdm_context, SPDM_DATA_RETRY_POLICY, &parameter,
+			       &retry_policy, sizeof(retry_policy));
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+	spdm_set_data(spdm_context, SPDM_DATA_RETRY_POLICY, &parameter,
+		      &default_retry_policy, sizeof(default_retry_policy));
+	spdm_register_timer_func(spdm_context, NULL, NULL);
+}
+
+/**
+  Test 24: ERROR response messages with error code = ResponseNotReady are received to GET_DIGESTS
+  and to RESPOND_IF_READY, with timer functions registered
+  Expected Behavior: requester waits RDT before each RESPOND_IF_READY. It returns the status
+  RETURN_SUCCESS if the DIGESTS message is received within RDTM polls, and RETURN_DEVICE_ERROR otherwise
+**/
+void test_spdm_requester_get_digests_case24(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x18;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context->peer_cert_chain_provision =
+		m_local_certificate_chain;
+	spdm_context->local_context->peer_cert_chain_provision_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+	spdm_register_timer_func(spdm_context,
+				 spdm_requester_get_digests_test_sleep,
+				 spdm_requester_get_digests_test_get_time_us);
+
+	//
+	// The responder is ready at the third RESPOND_IF_READY (RDTM = 3)
+	//
+	m_get_digests_not_ready_count = 3;
+	m_get_digests_sleep_count = 0;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_reset_message_b(spdm_context);
+	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
+	status =
+		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_get_digests_sleep_count, 3);
+	assert_int_equal(m_get_digests_sleep_us[0], 16);
+	assert_int_equal(m_get_digests_sleep_us[2], 16);
+
+	//
+	// The responder is still not ready after RDTM polls
+	//
+	m_get_digests_not_ready_count = 4;
+	m_get_digests_sleep_count = 0;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_reset_message_b(spdm_context);
+	status =
+		spdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	assert_int_equal(m_get_digests_sleep_count, 3);
+
+	spdm_register_timer_func(spdm_context, NULL, NULL);
+}
+
+/**
+  Test 25: the negotiated state and the certificate chain of a connection are exported, and
+  imported into a new connection that is resumed with one GET_DIGESTS
+  Expected Behavior: the imported state matches the exported one. spdm_resume_connection
+  returns RETURN_SUCCESS with the slot reporting the digest of the cached certificate chain,
+  and the connection state is AFTER_CERTIFICATE. A tampered certificate chain is not imported,
+  and a changed certificate chain makes spdm_resume_connection return RETURN_NOT_FOUND
+**/
+void test_spdm_requester_get_digests_case25(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *data;
+	uintn data_size;
+	uint8 message_a[] = { 0x10, 0x84, 0x00, 0x00 };
+	uint8 *snapshot;
+	uintn snapshot_size;
+	uintn snapshot_buffer_size;
+	uint8 slot_id;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x19;
+	spdm_context->local_context->peer_cert_chain_provision = NULL;
+	spdm_context->local_context->peer_cert_chain_provision_size = 0;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, NULL, NULL);
+	m_get_digests_resume_cert_chain = data;
+	m_get_digests_resume_cert_chain_size = data_size;
+
+	//
+	// Export a connection after GET_CERTIFICATE
+	//
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 1;
+	spdm_context->connection_info.capability.flags =
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_reset_message_a(spdm_context);
+	spdm_append_message_a(spdm_context, message_a, sizeof(message_a));
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+
+	snapshot_size = 0;
+	status = spdm_export_connection_snapshot(spdm_context, NULL,
+						 &snapshot_size);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(snapshot_size,
+			 SPDM_CONNECTION_SNAPSHOT_HEADER_SIZE +
+				 spdm_get_hash_size(m_use_hash_algo) +
+				 sizeof(message_a) + data_size);
+	snapshot_buffer_size = snapshot_size;
+	snapshot = malloc(snapshot_buffer_size);
+	status = spdm_export_connection_snapshot(spdm_context, snapshot,
+						 &snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	//
+	// Import it into a new connection
+	//
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_ACCESS_DENIED);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+	zero_mem(&spdm_context->connection_info.version,
+		 sizeof(spdm_context->connection_info.version));
+	zero_mem(&spdm_context->connection_info.capability,
+		 sizeof(spdm_context->connection_info.capability));
+	zero_mem(&spdm_context->connection_info.algorithm,
+		 sizeof(spdm_context->connection_info.algorithm));
+	spdm_reset_message_a(spdm_context);
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size = 0;
+	zero_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data_size);
+
+	snapshot[snapshot_size - 1] ^= 0xFF;
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SECURITY_VIOLATION);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_NOT_STARTED);
+	snapshot[snapshot_size - 1] ^= 0xFF;
+
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size - 1);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_NEGOTIATED);
+	assert_int_equal(spdm_context->connection_info.version.minor_version,
+			 1);
+	assert_int_equal(spdm_context->connection_info.capability.flags,
+			 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP);
+	assert_int_equal(
+		spdm_context->connection_info.algorithm.base_hash_algo,
+		m_use_hash_algo);
+	assert_int_equal(
+		spdm_context->connection_info.algorithm.base_asym_algo,
+		m_use_asym_algo);
+	assert_int_equal(
+		get_managed_buffer_size(&spdm_context->transcript.message_a),
+		sizeof(message_a));
+	assert_memory_equal(
+		get_managed_buffer(&spdm_context->transcript.message_a),
+		message_a, sizeof(message_a));
+	assert_int_equal(
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		data_size);
+	assert_memory_equal(
+		spdm_context->connection_info.peer_used_cert_chain_buffer, data,
+		data_size);
+
+	//
+	// The responder reports the cached certificate chain in slot 1
+	//
+	slot_id = 0xFF;
+	status = spdm_resume_connection(spdm_context, &slot_id);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(slot_id, 1);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_CERTIFICATE);
+
+	//
+	// The certificate chain of the responder changed
+	//
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+	status = spdm_import_connection_snapshot(spdm_context, snapshot,
+						 snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	m_get_digests_resume_cert_chain_size = data_size - 1;
+	status = spdm_resume_connection(spdm_context, &slot_id);
+	assert_int_equal(status, RETURN_NOT_FOUND);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_DIGESTS);
+	assert_int_equal(
+		spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+		0);
+
+	free(snapshot);
+	free(data);
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+}
+
 spdm_test_context_t m_spdm_requester_get_digests_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -1580,6 +2034,12 @@ int spdm_requester_get_digests_test_main(void)
 		//cmocka_unit_test(test_spdm_requester_get_digests_case21),
 		// Unexpected errors
 		cmocka_unit_test(test_spdm_requester_get_digests_case22),
+		// Always SPDM_ERROR_CODE_BUSY, with backoff, jitter and deadline
+		cmocka_unit_test(test_spdm_requester_get_digests_case23),
+		// SPDM_ERROR_CODE_RESPONSE_NOT_READY until RESPOND_IF_READY polls succeed or run out
+		cmocka_unit_test(test_spdm_requester_get_digests_case24),
+		// Connection snapshot export/import, resumed with GET_DIGESTS
+		cmocka_unit_test(test_spdm_requester_get_digests_case25),
 	};
 
 	setup_spdm_test_context(&m_spdm_requester_get_digests_test_context);
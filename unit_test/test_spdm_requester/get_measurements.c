@@ -17,6 +17,16 @@ static uintn m_local_buffer_size;
 static uint8 m_local_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 static uint8 m_local_psk_hint[32];
 
+// GET_MEASUREMENTS requests sent by spdm_get_measurement_batch but not yet answered
+static uint8 m_batch_request[MAX_SPDM_REQUEST_PIPELINE_DEPTH]
+			    [sizeof(spdm_get_measurements_request_t)];
+static uintn m_batch_request_size[MAX_SPDM_REQUEST_PIPELINE_DEPTH];
+static uintn m_batch_request_head;
+static uintn m_batch_request_count;
+static uintn m_batch_request_max_count;
+// Number of blocks returned for the index 0xFF by the batch responder
+#define M_BATCH_ALL_MEASUREMENTS_BLOCK_COUNT 3
+
 uintn spdm_test_get_measurement_request_size(IN void *spdm_context,
 					     IN void *buffer,
 					     IN uintn buffer_size)
@@ -403,6 +413,26 @@ return_status spdm_requester_get_measurements_test_send_message(
 			 app_message_size - 3);
 		m_local_buffer_size += app_message_size - 3;
 		return RETURN_SUCCESS;
+	case 0x23: {
+		uintn slot;
+
+		if (m_batch_request_count == MAX_SPDM_REQUEST_PIPELINE_DEPTH) {
+			return RETURN_DEVICE_ERROR;
+		}
+		message_size = spdm_test_get_measurement_request_size(
+			spdm_context, (uint8 *)request + header_size,
+			request_size - header_size);
+		slot = (m_batch_request_head + m_batch_request_count) %
+		       MAX_SPDM_REQUEST_PIPELINE_DEPTH;
+		copy_mem(m_batch_request[slot], (uint8 *)request + header_size,
+			 message_size);
+		m_batch_request_size[slot] = message_size;
+		m_batch_request_count++;
+		if (m_batch_request_count > m_batch_request_max_count) {
+			m_batch_request_max_count = m_batch_request_count;
+		}
+	}
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -2529,6 +2559,104 @@ return_status spdm_requester_get_measurements_test_receive_message(
 			->application_secret.response_data_sequence_number--;
 	}
 		return RETURN_SUCCESS;
+
+	case 0x23: {
+		spdm_get_measurements_request_t *spdm_request;
+		spdm_measurements_response_t *spdm_response;
+		uint8 *ptr;
+		uintn sig_size;
+		uintn measurment_sig_size;
+		spdm_measurement_block_dmtf_t *measurment_block;
+		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+		uintn temp_buf_size;
+		uint8 block_count;
+		uint8 block_index;
+		uintn block_size;
+		uintn index;
+
+		if (m_batch_request_count == 0) {
+			return RETURN_DEVICE_ERROR;
+		}
+		spdm_request = (void *)m_batch_request[m_batch_request_head];
+		copy_mem(&m_local_buffer[m_local_buffer_size], spdm_request,
+			 m_batch_request_size[m_batch_request_head]);
+		m_local_buffer_size +=
+			m_batch_request_size[m_batch_request_head];
+		m_batch_request_head = (m_batch_request_head + 1) %
+				       MAX_SPDM_REQUEST_PIPELINE_DEPTH;
+		m_batch_request_count--;
+
+		if (spdm_request->header.param1 ==
+		    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
+			sig_size = spdm_get_asym_signature_size(m_use_asym_algo);
+		} else {
+			sig_size = 0;
+		}
+		measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + sig_size;
+		if (spdm_request->header.param2 ==
+		    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
+			block_count = M_BATCH_ALL_MEASUREMENTS_BLOCK_COUNT;
+		} else {
+			block_count = 1;
+		}
+		block_size = sizeof(spdm_measurement_block_dmtf_t) +
+			     spdm_get_measurement_hash_size(
+				     m_use_measurement_hash_algo);
+		temp_buf_size = sizeof(spdm_measurements_response_t) +
+				block_count * block_size + measurment_sig_size;
+		spdm_response = (void *)temp_buf;
+
+		spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+		spdm_response->header.param1 = 0;
+		spdm_response->header.param2 = 0;
+		spdm_response->number_of_blocks = block_count;
+		spdm_write_uint24(spdm_response->measurement_record_length,
+				  (uint32)(block_count * block_size));
+		measurment_block = (void *)(spdm_response + 1);
+		for (index = 0; index < block_count; index++) {
+			block_index = (block_count == 1) ?
+					      spdm_request->header.param2 :
+					      (uint8)(index + 1);
+			set_mem(measurment_block, block_size, block_index);
+			measurment_block->Measurement_block_common_header.index =
+				block_index;
+			measurment_block->Measurement_block_common_header
+				.measurement_specification =
+				SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+			measurment_block->Measurement_block_common_header
+				.measurement_size = (uint16)(
+				sizeof(spdm_measurement_block_dmtf_header_t) +
+				spdm_get_measurement_hash_size(
+					m_use_measurement_hash_algo));
+			measurment_block = (void *)((uint8 *)measurment_block +
+						    block_size);
+		}
+		ptr = (void *)((uint8 *)spdm_response + temp_buf_size -
+			       measurment_sig_size);
+		spdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+		ptr += SPDM_NONCE_SIZE;
+		*(uint16 *)ptr = 0;
+		ptr += sizeof(uint16);
+		copy_mem(&m_local_buffer[m_local_buffer_size], spdm_response,
+			 (uintn)ptr - (uintn)spdm_response);
+		m_local_buffer_size += ((uintn)ptr - (uintn)spdm_response);
+		if (sig_size != 0) {
+			spdm_responder_data_sign(spdm_version, SPDM_MEASUREMENTS,
+						 m_use_asym_algo,
+						 m_use_hash_algo, FALSE,
+						 m_local_buffer,
+						 m_local_buffer_size, ptr,
+						 &sig_size);
+			m_local_buffer_size = 0;
+		}
+
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE, temp_buf_size,
+						   temp_buf, response_size,
+						   response);
+	}
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -4563,11 +4691,11 @@ void test_spdm_requester_get_measurements_case34(void **state)
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 	spdm_context->connection_info.algorithm.dhe_named_group =
 		m_use_dhe_algo;
@@ -4576,9 +4704,9 @@ void test_spdm_requester_get_measurements_case34(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 	session_id = 0xFFFFFFFF;
 	session_info = &spdm_context->session_info[0];
 	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
@@ -4613,6 +4741,208 @@ void test_spdm_requester_get_measurements_case34(void **state)
 	free(data);
 }
 
+/**
+  Test 35: get a batch of measurements, sending several requests before receiving the responses
+  Expected Behavior: get a RETURN_SUCCESS return code, with the blocks in request order,
+  at most request_pipeline_depth outstanding requests, and an empty transcript.message_m
+**/
+void test_spdm_requester_get_measurements_case35(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint8 pipeline_depth;
+	uint8 number_of_block;
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 index_list[5] = { 1, 3, 5, 2, 4 };
+	uint8 invalid_index_list[2] = { 1, 0 };
+	uint8 request_attribute;
+	uintn block_size;
+	uintn index;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x23;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_reset_message_m(spdm_context, NULL);
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+	request_attribute =
+		SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+	block_size = sizeof(spdm_measurement_block_dmtf_t) +
+		     spdm_get_measurement_hash_size(m_use_measurement_hash_algo);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	pipeline_depth = 0;
+	status = spdm_set_data(spdm_context, SPDM_DATA_REQUEST_PIPELINE_DEPTH,
+			       &parameter, &pipeline_depth,
+			       sizeof(pipeline_depth));
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+	for (pipeline_depth = 1; pipeline_depth <= 4; pipeline_depth++) {
+		status = spdm_set_data(spdm_context,
+				       SPDM_DATA_REQUEST_PIPELINE_DEPTH,
+				       &parameter, &pipeline_depth,
+				       sizeof(pipeline_depth));
+		assert_int_equal(status, RETURN_SUCCESS);
+		m_local_buffer_size = 0;
+		m_batch_request_head = 0;
+		m_batch_request_count = 0;
+		m_batch_request_max_count = 0;
+
+		measurement_record_length = sizeof(measurement_record);
+		status = spdm_get_measurement_batch(
+			spdm_context, NULL, request_attribute, 0,
+			ARRAY_SIZE(index_list), index_list, &number_of_block,
+			&measurement_record_length, measurement_record);
+		assert_int_equal(status, RETURN_SUCCESS);
+		assert_int_equal(number_of_block, ARRAY_SIZE(index_list));
+		assert_int_equal(measurement_record_length,
+				 ARRAY_SIZE(index_list) * block_size);
+		for (index = 0; index < ARRAY_SIZE(index_list); index++) {
+			assert_int_equal(((spdm_measurement_block_common_header_t
+						   *)(measurement_record +
+						      index * block_size))
+						 ->index,
+					 index_list[index]);
+		}
+		assert_int_equal(m_batch_request_count, 0);
+		assert_int_equal(m_batch_request_max_count, pipeline_depth);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+		assert_int_equal(spdm_context->transcript.message_m.buffer_size,
+				 0);
+#endif
+	}
+
+	measurement_record_length = sizeof(measurement_record);
+	status = spdm_get_measurement_batch(
+		spdm_context, NULL, request_attribute, 0,
+		ARRAY_SIZE(invalid_index_list), invalid_index_list,
+		&number_of_block, &measurement_record_length,
+		measurement_record);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+	pipeline_depth = 1;
+	spdm_set_data(spdm_context, SPDM_DATA_REQUEST_PIPELINE_DEPTH,
+		      &parameter, &pipeline_depth, sizeof(pipeline_depth));
+	free(data);
+}
+
+/**
+  Test 36: get a batch of measurements where the index 0xFF returns several blocks in one response
+  Expected Behavior: get a RETURN_SUCCESS return code, with number_of_blocks the sum of the blocks
+  of all the responses, the blocks in request order, and an empty transcript.message_m
+**/
+void test_spdm_requester_get_measurements_case36(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint8 pipeline_depth;
+	uint8 number_of_block;
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 index_list[3] = { 2, 0xFF, 4 };
+	uint8 block_index_list[M_BATCH_ALL_MEASUREMENTS_BLOCK_COUNT + 2] = {
+		2, 1, 2, 3, 4
+	};
+	uintn block_size;
+	uintn index;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x23;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	spdm_reset_message_m(spdm_context, NULL);
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+	block_size = sizeof(spdm_measurement_block_dmtf_t) +
+		     spdm_get_measurement_hash_size(m_use_measurement_hash_algo);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	pipeline_depth = 2;
+	status = spdm_set_data(spdm_context, SPDM_DATA_REQUEST_PIPELINE_DEPTH,
+			       &parameter, &pipeline_depth,
+			       sizeof(pipeline_depth));
+	assert_int_equal(status, RETURN_SUCCESS);
+	m_local_buffer_size = 0;
+	m_batch_request_head = 0;
+	m_batch_request_count = 0;
+	m_batch_request_max_count = 0;
+
+	measurement_record_length = sizeof(measurement_record);
+	status = spdm_get_measurement_batch(
+		spdm_context, NULL,
+		SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 0,
+		ARRAY_SIZE(index_list), index_list, &number_of_block,
+		&measurement_record_length, measurement_record);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(number_of_block, ARRAY_SIZE(block_index_list));
+	assert_int_equal(measurement_record_length,
+			 ARRAY_SIZE(block_index_list) * block_size);
+	for (index = 0; index < ARRAY_SIZE(block_index_list); index++) {
+		assert_int_equal(
+			((spdm_measurement_block_common_header_t
+				  *)(measurement_record + index * block_size))
+				->index,
+			block_index_list[index]);
+	}
+	assert_int_equal(m_batch_request_count, 0);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+
+	pipeline_depth = 1;
+	spdm_set_data(spdm_context, SPDM_DATA_REQUEST_PIPELINE_DEPTH,
+		      &parameter, &pipeline_depth, sizeof(pipeline_depth));
+	free(data);
+}
+
 spdm_test_context_t m_spdm_requester_get_measurements_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -4691,6 +5021,10 @@ int spdm_requester_get_measurements_test_main(void)
 		cmocka_unit_test(test_spdm_requester_get_measurements_case33),
 		// Successful response to get a session based measurement with signature
 		cmocka_unit_test(test_spdm_requester_get_measurements_case34),
+		// Successful response to get a batch of measurements through a request pipeline
+		cmocka_unit_test(test_spdm_requester_get_measurements_case35),
+		// Successful response to get a batch of measurements with several blocks in one response
+		cmocka_unit_test(test_spdm_requester_get_measurements_case36),
 	};
 
 	setup_spdm_test_context(
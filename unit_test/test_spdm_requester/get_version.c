@@ -16,6 +16,19 @@ typedef struct {
 } spdm_version_response_mine_t;
 #pragma pack()
 
+static uint64 m_spdm_get_version_time_us;
+static uintn m_spdm_get_version_request_size;
+static uintn m_spdm_get_version_response_size;
+
+/**
+  Fake clock, advancing 5us on every read.
+**/
+uint64 spdm_requester_get_version_test_get_time_us(IN void *spdm_context)
+{
+	m_spdm_get_version_time_us += 5;
+	return m_spdm_get_version_time_us;
+}
+
 return_status spdm_requester_get_version_test_send_message(
 	IN void *spdm_context, IN uintn request_size, IN void *request,
 	IN uint64 timeout)
@@ -54,6 +67,11 @@ return_status spdm_requester_get_version_test_send_message(
 		return RETURN_SUCCESS;
 	case 0xF:
 		return RETURN_SUCCESS;
+	case 0x10:
+		m_spdm_get_version_request_size = request_size;
+		return RETURN_SUCCESS;
+	case 0x11:
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -407,6 +425,27 @@ return_status spdm_requester_get_version_test_receive_message(
 						   response_size, response);
 	}
 		return RETURN_SUCCESS;
+
+	case 0x10:
+	case 0x11: {
+		spdm_version_response_mine_t spdm_response;
+
+		zero_mem(&spdm_response, sizeof(spdm_response));
+		spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_response.header.request_response_code = SPDM_VERSION;
+		spdm_response.header.param1 = 0;
+		spdm_response.header.param2 = 0;
+		spdm_response.version_number_entry_count = 1;
+		spdm_response.version_number_entry[0].major_version = 1;
+		spdm_response.version_number_entry[0].minor_version = 0;
+
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE, sizeof(spdm_response),
+						   &spdm_response,
+						   response_size, response);
+		m_spdm_get_version_response_size = *response_size;
+	}
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -716,17 +755,17 @@ void test_spdm_requester_get_version_case15(void **state)
 	spdm_test_context = *state;
 	spdm_context = spdm_test_context->spdm_context;
 	spdm_test_context->case_id = 0xF;
-	spdm_context->local_context.version.spdm_version_count = 5;
-	spdm_context->local_context.version.spdm_version[0].major_version = 5;
-	spdm_context->local_context.version.spdm_version[0].minor_version = 5;
-	spdm_context->local_context.version.spdm_version[1].major_version = 4;
-	spdm_context->local_context.version.spdm_version[1].minor_version = 5;
-	spdm_context->local_context.version.spdm_version[2].major_version = 0;
-	spdm_context->local_context.version.spdm_version[2].minor_version = 9;
-	spdm_context->local_context.version.spdm_version[3].major_version = 1;
-	spdm_context->local_context.version.spdm_version[3].minor_version = 0;
-	spdm_context->local_context.version.spdm_version[4].major_version = 1;
-	spdm_context->local_context.version.spdm_version[4].minor_version = 1;
+	spdm_context->local_context->version.spdm_version_count = 5;
+	spdm_context->local_context->version.spdm_version[0].major_version = 5;
+	spdm_context->local_context->version.spdm_version[0].minor_version = 5;
+	spdm_context->local_context->version.spdm_version[1].major_version = 4;
+	spdm_context->local_context->version.spdm_version[1].minor_version = 5;
+	spdm_context->local_context->version.spdm_version[2].major_version = 0;
+	spdm_context->local_context->version.spdm_version[2].minor_version = 9;
+	spdm_context->local_context->version.spdm_version[3].major_version = 1;
+	spdm_context->local_context->version.spdm_version[3].minor_version = 0;
+	spdm_context->local_context->version.spdm_version[4].major_version = 1;
+	spdm_context->local_context->version.spdm_version[4].minor_version = 1;
 	status = spdm_get_version(spdm_context);
 	assert_int_equal(status, RETURN_SUCCESS);
 	assert_int_equal(
@@ -735,6 +774,195 @@ void test_spdm_requester_get_version_case15(void **state)
 		spdm_context->connection_info.version.minor_version, 1);
 }
 
+/**
+  Test 16: receiving a correct VERSION message with a clock registered.
+  Expected behavior: the requester metrics count the VCA phase, one message sent and
+  one received with their sizes and transport time, and no crypto operation.
+**/
+void test_spdm_requester_get_version_case16(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_requester_metrics_t metrics;
+	uintn data_size;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x10;
+	spdm_register_timer_func(spdm_context, NULL,
+				 spdm_requester_get_version_test_get_time_us);
+	zero_mem(&metrics, sizeof(metrics));
+	status = spdm_set_data(spdm_context, SPDM_DATA_REQUESTER_METRICS, NULL,
+			       &metrics, sizeof(metrics));
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	status = spdm_get_version(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	data_size = sizeof(metrics);
+	status = spdm_get_data(spdm_context, SPDM_DATA_REQUESTER_METRICS, NULL,
+			       &metrics, &data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(data_size, sizeof(metrics));
+	assert_int_equal(metrics.phase[SPDM_REQUESTER_PHASE_VCA].count, 1);
+	assert_true(metrics.phase[SPDM_REQUESTER_PHASE_VCA].time_us >= 20);
+	assert_int_equal(metrics.phase[SPDM_REQUESTER_PHASE_DIGESTS].count, 0);
+	assert_int_equal(metrics.send.count, 1);
+	assert_int_equal(metrics.send.time_us, 5);
+	assert_int_equal(metrics.receive.count, 1);
+	assert_int_equal(metrics.receive.time_us, 5);
+	assert_int_equal(metrics.bytes_sent, m_spdm_get_version_request_size);
+	assert_int_equal(metrics.bytes_received,
+			 m_spdm_get_version_response_size);
+	for (index = 0; index < SPDM_CRYPTO_OP_MAX; index++) {
+		assert_int_equal(metrics.crypto[index].count, 0);
+	}
+
+	status = spdm_set_data(spdm_context, SPDM_DATA_REQUESTER_METRICS, NULL,
+			       &metrics, sizeof(metrics) - 1);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+	spdm_register_timer_func(spdm_context, NULL, NULL);
+}
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+  Test 17: receiving a correct VERSION message three times with a trace buffer of four events.
+  Expected behavior: the trace buffer keeps the last four of the six messages, each with
+  its direction, code, size, time stamp and leading bytes.
+**/
+void test_spdm_requester_get_version_case17(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint64 trace_buffer[(sizeof(spdm_trace_buffer_header_t) +
+			     5 * sizeof(spdm_trace_event_t)) /
+			    sizeof(uint64)];
+	spdm_trace_buffer_header_t *header;
+	spdm_trace_event_t *event;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x11;
+	spdm_register_timer_func(spdm_context, NULL,
+				 spdm_requester_get_version_test_get_time_us);
+
+	status = spdm_register_trace_buffer(spdm_context, trace_buffer,
+					    spdm_get_trace_buffer_size(1) - 1,
+					    SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	status = spdm_register_trace_buffer(spdm_context, trace_buffer,
+					    sizeof(trace_buffer),
+					    SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD);
+	assert_int_equal(status, RETURN_SUCCESS);
+	header = (spdm_trace_buffer_header_t *)trace_buffer;
+	assert_int_equal(header->signature, SPDM_TRACE_BUFFER_SIGNATURE);
+	assert_int_equal(header->event_count, 4);
+	assert_int_equal(header->event_size, sizeof(spdm_trace_event_t));
+
+	for (index = 0; index < 3; index++) {
+		status = spdm_get_version(spdm_context);
+		assert_int_equal(status, RETURN_SUCCESS);
+	}
+	spdm_register_trace_buffer(spdm_context, NULL, 0, 0);
+	spdm_register_timer_func(spdm_context, NULL, NULL);
+
+	assert_int_equal(header->next_sequence, 6);
+	event = (spdm_trace_event_t *)(header + 1);
+	for (index = 2; index < 6; index++) {
+		assert_int_equal(event[index % 4].sequence, index);
+		assert_int_equal(event[index % 4].session_id, 0);
+		assert_int_equal(event[index % 4].flags, 0);
+		assert_int_not_equal(event[index % 4].timestamp_us, 0);
+	}
+	assert_true(event[3].timestamp_us > event[2].timestamp_us);
+
+	assert_int_equal(event[0].direction, SPDM_TRACE_DIRECTION_SEND);
+	assert_int_equal(event[0].request_response_code, SPDM_GET_VERSION);
+	assert_int_equal(event[0].spdm_version, SPDM_MESSAGE_VERSION_10);
+	assert_int_equal(event[0].message_size,
+			 sizeof(spdm_get_version_request_t));
+	assert_int_equal(event[0].payload_size,
+			 sizeof(spdm_get_version_request_t));
+
+	assert_int_equal(event[1].direction, SPDM_TRACE_DIRECTION_RECEIVE);
+	assert_int_equal(event[1].request_response_code, SPDM_VERSION);
+	assert_int_equal(event[1].message_size,
+			 sizeof(spdm_version_response_mine_t));
+	assert_int_equal(event[1].payload_size,
+			 MIN(sizeof(spdm_version_response_mine_t),
+			     SPDM_TRACE_PAYLOAD_SIZE));
+	assert_int_equal(event[1].payload[1], SPDM_VERSION);
+}
+
+/**
+  Test 18: receiving a correct VERSION message with a trace buffer registered without
+  SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD, then tracing a session message and an application
+  message with the flag.
+  Expected behavior: the SPDM header fields are recorded, but no message byte is copied.
+**/
+void test_spdm_requester_get_version_case18(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint64 trace_buffer[(sizeof(spdm_trace_buffer_header_t) +
+			     4 * sizeof(spdm_trace_event_t)) /
+			    sizeof(uint64)];
+	spdm_trace_buffer_header_t *header;
+	spdm_trace_event_t *event;
+	spdm_get_version_request_t message;
+	uint32 session_id;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x11;
+
+	status = spdm_register_trace_buffer(spdm_context, trace_buffer,
+					    sizeof(trace_buffer), 0);
+	assert_int_equal(status, RETURN_SUCCESS);
+	header = (spdm_trace_buffer_header_t *)trace_buffer;
+	status = spdm_get_version(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_int_equal(header->next_sequence, 2);
+	event = (spdm_trace_event_t *)(header + 1);
+	assert_int_equal(event[0].request_response_code, SPDM_GET_VERSION);
+	assert_int_equal(event[1].request_response_code, SPDM_VERSION);
+	for (index = 0; index < 2; index++) {
+		assert_int_equal(event[index].payload_size, 0);
+	}
+
+	status = spdm_register_trace_buffer(spdm_context, trace_buffer,
+					    sizeof(trace_buffer),
+					    SPDM_TRACE_BUFFER_FLAG_COPY_PAYLOAD);
+	assert_int_equal(status, RETURN_SUCCESS);
+	message.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+	message.header.request_response_code = SPDM_HEARTBEAT;
+	message.header.param1 = 0;
+	message.header.param2 = 0;
+	session_id = 0xFFFFFFFF;
+	spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_SEND,
+			   &session_id, FALSE, &message, sizeof(message));
+	spdm_trace_message(spdm_context, SPDM_TRACE_DIRECTION_SEND,
+			   &session_id, TRUE, &message, sizeof(message));
+	spdm_register_trace_buffer(spdm_context, NULL, 0, 0);
+
+	assert_int_equal(header->next_sequence, 2);
+	assert_int_equal(event[0].session_id, session_id);
+	assert_int_equal(event[0].request_response_code, SPDM_HEARTBEAT);
+	assert_int_equal(event[1].flags, SPDM_TRACE_EVENT_FLAG_APP_MESSAGE);
+	for (index = 0; index < 2; index++) {
+		assert_int_equal(event[index].sequence, index);
+		assert_int_equal(event[index].payload_size, 0);
+	}
+}
+#endif
+
 spdm_test_context_t mSpdmRequesterGetVersionTestContext = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -770,6 +998,14 @@ int spdm_requester_get_version_test_main(void)
 		cmocka_unit_test(test_spdm_requester_get_version_case14),
 		// Successful response for unordered version set
 		cmocka_unit_test(test_spdm_requester_get_version_case15),
+		// Requester metrics of a successful response
+		cmocka_unit_test(test_spdm_requester_get_version_case16),
+#if LIBSPDM_TRACE_SUPPORT
+		// Trace buffer of the messages
+		cmocka_unit_test(test_spdm_requester_get_version_case17),
+		// Trace buffer without message bytes
+		cmocka_unit_test(test_spdm_requester_get_version_case18),
+#endif
 	};
 
 	setup_spdm_test_context(&mSpdmRequesterGetVersionTestContext);
@@ -960,10 +960,10 @@ void test_spdm_requester_negotiate_algorithms_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -984,10 +984,10 @@ void test_spdm_requester_negotiate_algorithms_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1010,10 +1010,10 @@ void test_spdm_requester_negotiate_algorithms_case3(void **state)
 	spdm_test_context->case_id = 0x3;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1034,10 +1034,10 @@ void test_spdm_requester_negotiate_algorithms_case4(void **state)
 	spdm_test_context->case_id = 0x4;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1058,10 +1058,10 @@ void test_spdm_requester_negotiate_algorithms_case5(void **state)
 	spdm_test_context->case_id = 0x5;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1082,10 +1082,10 @@ void test_spdm_requester_negotiate_algorithms_case6(void **state)
 	spdm_test_context->case_id = 0x6;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1108,10 +1108,10 @@ void test_spdm_requester_negotiate_algorithms_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1134,10 +1134,10 @@ void test_spdm_requester_negotiate_algorithms_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1155,10 +1155,10 @@ void test_spdm_requester_negotiate_algorithms_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_reset_message_a(spdm_context);
 
 	status = spdm_negotiate_algorithms(spdm_context);
@@ -1179,10 +1179,10 @@ void test_spdm_requester_negotiate_algorithms_case10(void **state)
 	spdm_test_context->case_id = 0xA;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->connection_info.algorithm.measurement_hash_algo = 0;
 	spdm_context->connection_info.algorithm.base_asym_algo = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo = 0;
@@ -1208,16 +1208,16 @@ void test_spdm_requester_negotiate_algorithms_case11(void **state)
 	spdm_test_context->case_id = 0xB;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->connection_info.algorithm.measurement_hash_algo = 0;
 	spdm_context->connection_info.algorithm.base_asym_algo = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo = 0;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP;
 	spdm_reset_message_a(spdm_context);
 
@@ -1238,10 +1238,10 @@ void test_spdm_requester_negotiate_algorithms_case12(void **state)
 	spdm_test_context->case_id = 0xC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-	spdm_context->local_context.algorithm.measurement_hash_algo =
+	spdm_context->local_context->algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
-	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 	spdm_context->connection_info.algorithm.measurement_hash_algo = 0;
 	spdm_context->connection_info.algorithm.base_asym_algo = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo = 0;
@@ -1262,9 +1262,9 @@ void test_spdm_requester_negotiate_algorithms_case13(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xD;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1280,9 +1280,9 @@ void test_spdm_requester_negotiate_algorithms_case14(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xE;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1298,9 +1298,9 @@ void test_spdm_requester_negotiate_algorithms_case15(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xF;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1316,9 +1316,9 @@ void test_spdm_requester_negotiate_algorithms_case16(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x10;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1334,9 +1334,9 @@ void test_spdm_requester_negotiate_algorithms_case16(void **state) {
 //   spdm_context = spdm_test_context->spdm_context;
 //   spdm_test_context->case_id = 0x11;
 //   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-//   spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-//   spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-//   spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+//   spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+//   spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+//   spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
 //   spdm_reset_message_a(spdm_context);
 //
 //   status = spdm_negotiate_algorithms (spdm_context);
@@ -1352,9 +1352,9 @@ void test_spdm_requester_negotiate_algorithms_case17(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x11;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1370,9 +1370,9 @@ void test_spdm_requester_negotiate_algorithms_case18(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x12;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1388,9 +1388,9 @@ void test_spdm_requester_negotiate_algorithms_case19(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x13;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1406,9 +1406,9 @@ void test_spdm_requester_negotiate_algorithms_case20(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x14;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1424,9 +1424,9 @@ void test_spdm_requester_negotiate_algorithms_case21(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x15;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1442,9 +1442,9 @@ void test_spdm_requester_negotiate_algorithms_case22(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x16;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1463,28 +1463,28 @@ void test_spdm_requester_negotiate_algorithms_case23(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1506,28 +1506,28 @@ void test_spdm_requester_negotiate_algorithms_case24(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1546,28 +1546,28 @@ void test_spdm_requester_negotiate_algorithms_case25(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1586,28 +1586,28 @@ void test_spdm_requester_negotiate_algorithms_case26(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1626,28 +1626,28 @@ void test_spdm_requester_negotiate_algorithms_case27(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1666,28 +1666,28 @@ void test_spdm_requester_negotiate_algorithms_case28(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1706,28 +1706,28 @@ void test_spdm_requester_negotiate_algorithms_case29(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1746,28 +1746,28 @@ void test_spdm_requester_negotiate_algorithms_case30(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
@@ -1786,28 +1786,28 @@ void test_spdm_requester_negotiate_algorithms_case31(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
-  spdm_context->local_context.algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
-  spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
-  spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->local_context->algorithm.measurement_hash_algo = m_use_measurement_hash_algo;
+  spdm_context->local_context->algorithm.base_asym_algo = m_use_asym_algo;
+  spdm_context->local_context->algorithm.base_hash_algo = m_use_hash_algo;
   spdm_reset_message_a(spdm_context);
-  spdm_context->local_context.algorithm.dhe_named_group = m_use_dhe_algo;
-  spdm_context->local_context.algorithm.aead_cipher_suite = m_use_aead_algo;
-  spdm_context->local_context.algorithm.req_base_asym_alg = m_use_req_asym_algo;
-  spdm_context->local_context.algorithm.key_schedule = m_use_key_schedule_algo;
+  spdm_context->local_context->algorithm.dhe_named_group = m_use_dhe_algo;
+  spdm_context->local_context->algorithm.aead_cipher_suite = m_use_aead_algo;
+  spdm_context->local_context->algorithm.req_base_asym_alg = m_use_req_asym_algo;
+  spdm_context->local_context->algorithm.key_schedule = m_use_key_schedule_algo;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP;
 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 
   status = spdm_negotiate_algorithms (spdm_context);
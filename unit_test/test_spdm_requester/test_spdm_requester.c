@@ -31,6 +31,7 @@ int spdm_requester_psk_finish_test_main(void);
 int spdm_requester_heartbeat_test_main(void);
 int spdm_requester_key_update_test_main(void);
 int spdm_requester_end_session_test_main(void);
+int spdm_requester_async_op_test_main(void);
 
 int main(void)
 {
@@ -98,5 +99,9 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_requester_async_op_test_main() != 0) {
+		return_value = 1;
+	}
+
 	return return_value;
 }
@@ -59,17 +59,17 @@ void test_spdm_responder_certificate_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
@@ -117,17 +117,17 @@ void test_spdm_responder_certificate_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -165,17 +165,17 @@ void test_spdm_responder_certificate_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -214,17 +214,17 @@ void test_spdm_responder_certificate_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -265,17 +265,17 @@ void test_spdm_responder_certificate_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -320,17 +320,17 @@ void test_spdm_responder_certificate_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_certificate(
@@ -376,17 +376,17 @@ void test_spdm_responder_certificate_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// This tests considers only offset = 0, other tests vary offset value
 	m_spdm_get_certificate_request3.offset = 0;
@@ -456,17 +456,17 @@ void test_spdm_responder_certificate_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// This tests considers only length = 0, other tests vary length value
 	m_spdm_get_certificate_request3.length = 0;
@@ -561,17 +561,17 @@ void test_spdm_responder_certificate_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// Setting up offset values at the boundary of certificate length
 	test_sizes[0] += (uint16)(test_sizes[0] + data_size);
@@ -674,7 +674,7 @@ void test_spdm_responder_certificate_case10(void **state)
 	spdm_test_context->case_id = 0xA;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -686,11 +686,11 @@ void test_spdm_responder_certificate_case10(void **state)
 			m_use_hash_algo, m_use_asym_algo, test_cases[i], &data,
 			&data_size, NULL, NULL);
 
-		spdm_context->local_context.local_cert_chain_provision[0] =
+		spdm_context->local_context->local_cert_chain_provision[0] =
 			data;
-		spdm_context->local_context.local_cert_chain_provision_size[0] =
+		spdm_context->local_context->local_cert_chain_provision_size[0] =
 			data_size;
-		spdm_context->local_context.slot_count = 1;
+		spdm_context->local_context->slot_count = 1;
 
 		m_spdm_get_certificate_request3.offset =
 			(uint16)(MIN(data_size - 1, MAX_UINT16));
@@ -752,9 +752,9 @@ void test_spdm_responder_certificate_case10(void **state)
 
 		TEST_DEBUG_PRINT("\n");
 
-		spdm_context->local_context.local_cert_chain_provision[0] =
+		spdm_context->local_context->local_cert_chain_provision[0] =
 			NULL;
-		spdm_context->local_context.local_cert_chain_provision_size[0] =
+		spdm_context->local_context->local_cert_chain_provision_size[0] =
 			0;
 		free(data);
 	}
@@ -787,7 +787,7 @@ void test_spdm_responder_certificate_case11(void **state)
 	spdm_test_context->case_id = 0xB;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -799,11 +799,11 @@ void test_spdm_responder_certificate_case11(void **state)
 		read_responder_public_certificate_chain_by_size(
 			m_use_hash_algo, m_use_asym_algo, test_cases[i], &data,
 			&data_size, NULL, NULL);
-		spdm_context->local_context.local_cert_chain_provision[0] =
+		spdm_context->local_context->local_cert_chain_provision[0] =
 			data;
-		spdm_context->local_context.local_cert_chain_provision_size[0] =
+		spdm_context->local_context->local_cert_chain_provision_size[0] =
 			data_size;
-		spdm_context->local_context.slot_count = 1;
+		spdm_context->local_context->slot_count = 1;
 
 		TEST_DEBUG_PRINT("data_size: %u\n", data_size);
 		TEST_DEBUG_PRINT("m_spdm_get_certificate_request3.offset: %u\n",
@@ -891,17 +891,17 @@ void test_spdm_responder_certificate_case12(void **state)
 	spdm_test_context->case_id = 0xC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	// This tests considers only length = 1
 	m_spdm_get_certificate_request3.length = 1;
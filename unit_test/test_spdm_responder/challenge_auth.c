@@ -69,8 +69,8 @@ void test_spdm_responder_challenge_auth_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -86,11 +86,11 @@ void test_spdm_responder_challenge_auth_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 	spdm_reset_message_c(spdm_context);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	spdm_context->transcript.message_m.buffer_size =
@@ -142,8 +142,8 @@ void test_spdm_responder_challenge_auth_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -159,11 +159,11 @@ void test_spdm_responder_challenge_auth_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 	spdm_reset_message_c(spdm_context);
 
 	response_size = sizeof(response);
@@ -206,8 +206,8 @@ void test_spdm_responder_challenge_auth_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -223,11 +223,11 @@ void test_spdm_responder_challenge_auth_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 	spdm_reset_message_c(spdm_context);
 
 	response_size = sizeof(response);
@@ -271,8 +271,8 @@ void test_spdm_responder_challenge_auth_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -288,11 +288,11 @@ void test_spdm_responder_challenge_auth_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 	spdm_reset_message_c(spdm_context);
 
 	response_size = sizeof(response);
@@ -338,8 +338,8 @@ void test_spdm_responder_challenge_auth_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -355,11 +355,11 @@ void test_spdm_responder_challenge_auth_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 	spdm_reset_message_c(spdm_context);
 
 	response_size = sizeof(response);
@@ -410,8 +410,8 @@ void test_spdm_responder_challenge_auth_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -427,11 +427,11 @@ void test_spdm_responder_challenge_auth_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
-	spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+	spdm_context->local_context->slot_count = 1;
+	spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 	spdm_reset_message_c(spdm_context);
 
 	response_size = sizeof(response);
@@ -471,8 +471,8 @@ void test_spdm_responder_challenge_auth_case7(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x7;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  // spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  // spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -481,10 +481,10 @@ void test_spdm_responder_challenge_auth_case7(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -519,8 +519,8 @@ void test_spdm_responder_challenge_auth_case8(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x8;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -529,10 +529,10 @@ void test_spdm_responder_challenge_auth_case8(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -567,8 +567,8 @@ void test_spdm_responder_challenge_auth_case9(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0x9;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -577,10 +577,10 @@ void test_spdm_responder_challenge_auth_case9(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[1] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[1] = data_size1;
-  spdm_context->local_context.slot_count = 2;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[1] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[1] = data_size1;
+  spdm_context->local_context->slot_count = 2;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -615,8 +615,8 @@ void test_spdm_responder_challenge_auth_case10(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xA;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -625,10 +625,10 @@ void test_spdm_responder_challenge_auth_case10(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -663,8 +663,8 @@ void test_spdm_responder_challenge_auth_case11(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xB;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -673,11 +673,11 @@ void test_spdm_responder_challenge_auth_case11(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 8;
-  spdm_context->local_context.opaque_challenge_auth_rsp = m_opaque_challenge_auth_rsp;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 8;
+  spdm_context->local_context->opaque_challenge_auth_rsp = m_opaque_challenge_auth_rsp;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -712,9 +712,9 @@ void test_spdm_responder_challenge_auth_case12(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xC;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -723,10 +723,10 @@ void test_spdm_responder_challenge_auth_case12(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -761,9 +761,9 @@ void test_spdm_responder_challenge_auth_case13(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xD;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //additional measurement capability
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -772,10 +772,10 @@ void test_spdm_responder_challenge_auth_case13(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
@@ -811,9 +811,9 @@ void test_spdm_responder_challenge_auth_case14(void **state) {
   spdm_context = spdm_test_context->spdm_context;
   spdm_test_context->case_id = 0xE;
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
-  // spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //no measurement capability
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  // spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP; //no measurement capability
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -822,10 +822,10 @@ void test_spdm_responder_challenge_auth_case14(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data1, &data_size1, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data1;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size1;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data1;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size1;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
   spdm_reset_message_c(spdm_context);
 
   response_size = sizeof(response);
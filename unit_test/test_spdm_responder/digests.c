@@ -45,17 +45,17 @@ void test_spdm_responder_digests_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	spdm_context->transcript.message_m.buffer_size =
 		spdm_context->transcript.message_m.max_buffer_size;
@@ -99,17 +99,17 @@ void test_spdm_responder_digests_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -146,17 +146,17 @@ void test_spdm_responder_digests_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -193,17 +193,17 @@ void test_spdm_responder_digests_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -242,17 +242,17 @@ void test_spdm_responder_digests_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -296,17 +296,17 @@ void test_spdm_responder_digests_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 	status = spdm_get_response_digests(spdm_context,
@@ -341,17 +341,17 @@ void test_spdm_responder_digests_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
@@ -394,17 +394,17 @@ void test_spdm_responder_digests_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
-	spdm_context->local_context.local_cert_chain_provision[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] =
 		m_local_certificate_chain;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		MAX_SPDM_MESSAGE_BUFFER_SIZE;
 	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
 		(uint8)(0xFF));
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 
 	response_size = sizeof(response);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
@@ -449,18 +449,18 @@ void test_spdm_responder_digests_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NEGOTIATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 
 	for (index = 0; index < MAX_SPDM_SLOT_COUNT; index++) {
-		spdm_context->local_context.local_cert_chain_provision[index] =
+		spdm_context->local_context->local_cert_chain_provision[index] =
 			NULL;
 		spdm_context->local_context
-			.local_cert_chain_provision_size[index] = 0;
+			->local_cert_chain_provision_size[index] = 0;
 	}
-	spdm_context->local_context.slot_count = 0;
+	spdm_context->local_context->slot_count = 0;
 
 	response_size = sizeof(response);
 	spdm_reset_message_b(spdm_context);
@@ -478,6 +478,149 @@ void test_spdm_responder_digests_case9(void **state)
 	assert_int_equal(spdm_response->header.param2, SPDM_GET_DIGESTS);
 }
 
+/**
+  Send a valid GET_DIGESTS to a responder in a connection state after DIGESTS, with stale
+  messages in B, C, mut B and mut C.
+  Expected Behavior: produces a valid DIGESTS response message, the connection state goes back
+  to SPDM_CONNECTION_STATE_AFTER_DIGESTS, and M1M2 restarts from message A with only
+  GET_DIGESTS and DIGESTS, while mut M1M2 is empty.
+**/
+static void
+test_spdm_responder_digests_after_digests(IN spdm_context_t *spdm_context,
+					  IN spdm_connection_state_t state)
+{
+	return_status status;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_digest_response_t *spdm_response;
+	uint8 stale_message[0x10];
+	uint8 message_a[0x10];
+	uint8 m1m2[sizeof(message_a) + sizeof(spdm_get_digest_request_t) +
+		   MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn m1m2_size;
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	uint8 expected_hash[MAX_HASH_SIZE];
+	uint8 m1m2_hash[MAX_HASH_SIZE];
+	uintn m1m2_hash_size;
+#endif
+
+	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
+	spdm_context->connection_info.connection_state = state;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context->local_cert_chain_provision[0] =
+		m_local_certificate_chain;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+	spdm_context->local_context->slot_count = 1;
+
+	set_mem(message_a, sizeof(message_a), 0xA5);
+	spdm_reset_message_a(spdm_context);
+	spdm_append_message_a(spdm_context, message_a, sizeof(message_a));
+	set_mem(stale_message, sizeof(stale_message), 0x5A);
+	spdm_reset_message_b(spdm_context);
+	spdm_reset_message_c(spdm_context);
+	spdm_reset_message_mut_b(spdm_context);
+	spdm_reset_message_mut_c(spdm_context);
+	spdm_append_message_b(spdm_context, stale_message, sizeof(stale_message));
+	spdm_append_message_c(spdm_context, stale_message, sizeof(stale_message));
+	spdm_append_message_mut_b(spdm_context, stale_message,
+				  sizeof(stale_message));
+	spdm_append_message_mut_c(spdm_context, stale_message,
+				  sizeof(stale_message));
+
+	response_size = sizeof(response);
+	status = spdm_get_response_digests(spdm_context,
+					   m_spdm_get_digests_request1_size,
+					   &m_spdm_get_digests_request1,
+					   &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_DIGESTS);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_DIGESTS);
+
+	m1m2_size = 0;
+	copy_mem(m1m2, message_a, sizeof(message_a));
+	m1m2_size += sizeof(message_a);
+	copy_mem(m1m2 + m1m2_size, &m_spdm_get_digests_request1,
+		 m_spdm_get_digests_request1_size);
+	m1m2_size += m_spdm_get_digests_request1_size;
+	copy_mem(m1m2 + m1m2_size, response, response_size);
+	m1m2_size += response_size;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	assert_int_equal(spdm_context->transcript.message_b.buffer_size,
+			 m1m2_size - sizeof(message_a));
+	assert_memory_equal(spdm_context->transcript.message_b.buffer,
+			    m1m2 + sizeof(message_a),
+			    m1m2_size - sizeof(message_a));
+	assert_int_equal(spdm_context->transcript.message_c.buffer_size, 0);
+	assert_int_equal(spdm_context->transcript.message_mut_b.buffer_size, 0);
+	assert_int_equal(spdm_context->transcript.message_mut_c.buffer_size, 0);
+#else
+	assert_null(spdm_context->transcript.digest_context_mut_m1m2);
+	spdm_hash_all(m_use_hash_algo, m1m2, m1m2_size, expected_hash);
+	m1m2_hash_size = sizeof(m1m2_hash);
+	assert_true(spdm_calculate_m1m2_hash(spdm_context, FALSE,
+					     &m1m2_hash_size, m1m2_hash));
+	assert_memory_equal(m1m2_hash, expected_hash, m1m2_hash_size);
+#endif
+
+	spdm_reset_message_a(spdm_context);
+	spdm_reset_message_b(spdm_context);
+}
+
+/**
+  Test 10: receives a valid GET_DIGESTS request message from Requester after DIGESTS
+  Expected Behavior: see test_spdm_responder_digests_after_digests
+**/
+void test_spdm_responder_digests_case10(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+
+	spdm_test_context = *state;
+	spdm_test_context->case_id = 0xA;
+	test_spdm_responder_digests_after_digests(
+		spdm_test_context->spdm_context,
+		SPDM_CONNECTION_STATE_AFTER_DIGESTS);
+}
+
+/**
+  Test 11: receives a valid GET_DIGESTS request message from Requester after CERTIFICATE
+  Expected Behavior: see test_spdm_responder_digests_after_digests
+**/
+void test_spdm_responder_digests_case11(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+
+	spdm_test_context = *state;
+	spdm_test_context->case_id = 0xB;
+	test_spdm_responder_digests_after_digests(
+		spdm_test_context->spdm_context,
+		SPDM_CONNECTION_STATE_AFTER_CERTIFICATE);
+}
+
+/**
+  Test 12: receives a valid GET_DIGESTS request message from Requester after CHALLENGE_AUTH
+  Expected Behavior: see test_spdm_responder_digests_after_digests, the responder is no
+  longer authenticated
+**/
+void test_spdm_responder_digests_case12(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+
+	spdm_test_context = *state;
+	spdm_test_context->case_id = 0xC;
+	test_spdm_responder_digests_after_digests(
+		spdm_test_context->spdm_context,
+		SPDM_CONNECTION_STATE_AUTHENTICATED);
+}
+
 spdm_test_context_t m_spdm_responder_digests_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
@@ -504,6 +647,12 @@ int spdm_responder_digests_test_main(void)
 		cmocka_unit_test(test_spdm_responder_digests_case8),
 		// No digest to send
 		cmocka_unit_test(test_spdm_responder_digests_case9),
+		// GET_DIGESTS after DIGESTS
+		cmocka_unit_test(test_spdm_responder_digests_case10),
+		// GET_DIGESTS after CERTIFICATE
+		cmocka_unit_test(test_spdm_responder_digests_case11),
+		// GET_DIGESTS after CHALLENGE_AUTH
+		cmocka_unit_test(test_spdm_responder_digests_case12),
 	};
 
 	setup_spdm_test_context(&m_spdm_responder_digests_test_context);
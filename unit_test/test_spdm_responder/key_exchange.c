@@ -55,7 +55,7 @@ void test_spdm_responder_key_exchange_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -72,12 +72,12 @@ void test_spdm_responder_key_exchange_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -134,7 +134,7 @@ void test_spdm_responder_key_exchange_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -151,12 +151,12 @@ void test_spdm_responder_key_exchange_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request2.random_data);
@@ -213,7 +213,7 @@ void test_spdm_responder_key_exchange_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -230,12 +230,12 @@ void test_spdm_responder_key_exchange_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -293,7 +293,7 @@ void test_spdm_responder_key_exchange_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -310,12 +310,12 @@ void test_spdm_responder_key_exchange_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -375,7 +375,7 @@ void test_spdm_responder_key_exchange_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -392,12 +392,12 @@ void test_spdm_responder_key_exchange_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -461,7 +461,7 @@ void test_spdm_responder_key_exchange_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -478,12 +478,12 @@ void test_spdm_responder_key_exchange_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 
 	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
 			       m_spdm_key_exchange_request1.random_data);
@@ -539,7 +539,7 @@ void test_spdm_responder_key_exchange_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -556,12 +556,12 @@ void test_spdm_responder_key_exchange_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
-	spdm_context->local_context.mut_auth_requested = 0;
+	spdm_context->local_context->mut_auth_requested = 0;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	spdm_context->transcript.message_m.buffer_size =
 							spdm_context->transcript.message_m.max_buffer_size;
@@ -615,6 +615,102 @@ void test_spdm_responder_key_exchange_case7(void **state)
 	free(data1);
 }
 
+void test_spdm_responder_key_exchange_case8(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_key_exchange_response_t *spdm_response;
+	void *data1;
+	uintn data_size1;
+	uint8 *ptr;
+	uintn dhe_key_size;
+	void *dhe_context;
+	uintn opaque_key_exchange_req_size;
+	void *dhe_key_pool;
+	uint64 hit_count;
+	uint64 miss_count;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x8;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.dhe_named_group =
+		m_use_dhe_algo;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		m_use_aead_algo;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data1,
+						&data_size1, NULL, NULL);
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
+		data_size1;
+	spdm_context->local_context->slot_count = 1;
+	spdm_reset_message_a(spdm_context);
+	spdm_context->local_context->mut_auth_requested = 0;
+
+	dhe_key_pool = malloc(spdm_dhe_key_pool_get_size(m_use_dhe_algo, 2));
+	status = spdm_dhe_key_pool_init(dhe_key_pool, m_use_dhe_algo, 2);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_dhe_key_pool_refill(dhe_key_pool), 2);
+	spdm_context->local_context->dhe_key_pool = dhe_key_pool;
+
+	spdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
+			       m_spdm_key_exchange_request1.random_data);
+	m_spdm_key_exchange_request1.req_session_id = 0xFFFF;
+	m_spdm_key_exchange_request1.reserved = 0;
+	ptr = m_spdm_key_exchange_request1.exchange_data;
+	dhe_key_size = spdm_get_dhe_pub_key_size(m_use_dhe_algo);
+	dhe_context = spdm_dhe_new(m_use_dhe_algo);
+	spdm_dhe_generate_key(m_use_dhe_algo, dhe_context, ptr, &dhe_key_size);
+	ptr += dhe_key_size;
+	spdm_dhe_free(m_use_dhe_algo, dhe_context);
+	opaque_key_exchange_req_size =
+		spdm_get_opaque_data_supported_version_data_size(spdm_context);
+	*(uint16 *)ptr = (uint16)opaque_key_exchange_req_size;
+	ptr += sizeof(uint16);
+	spdm_build_opaque_data_supported_version_data(
+		spdm_context, &opaque_key_exchange_req_size, ptr);
+	ptr += opaque_key_exchange_req_size;
+	response_size = sizeof(response);
+	status = spdm_get_response_key_exchange(
+		spdm_context, m_spdm_key_exchange_request1_size,
+		&m_spdm_key_exchange_request1, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(
+		spdm_secured_message_get_session_state(
+			spdm_context->session_info[0].secured_message_context),
+		SPDM_SESSION_STATE_HANDSHAKING);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_KEY_EXCHANGE_RSP);
+
+	spdm_dhe_key_pool_get_statistics(dhe_key_pool, &hit_count, &miss_count);
+	assert_int_equal(hit_count, 1);
+	assert_int_equal(miss_count, 0);
+	assert_int_equal(spdm_dhe_key_pool_refill(dhe_key_pool), 1);
+
+	spdm_context->local_context->dhe_key_pool = NULL;
+	spdm_dhe_key_pool_free(dhe_key_pool);
+	free(dhe_key_pool);
+	free(data1);
+}
+
 spdm_test_context_t m_spdm_responder_key_exchange_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
@@ -637,6 +733,8 @@ int spdm_responder_key_exchange_test_main(void)
 		cmocka_unit_test(test_spdm_responder_key_exchange_case6),
 		// Buffer reset
 		cmocka_unit_test(test_spdm_responder_key_exchange_case7),
+		// Key pair taken from the DHE key pool
+		cmocka_unit_test(test_spdm_responder_key_exchange_case8),
 	};
 
 	setup_spdm_test_context(&m_spdm_responder_key_exchange_test_context);
@@ -81,11 +81,11 @@ static void spdm_set_standard_key_update_test_state(
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
 
 	spdm_context->transcript.message_a.buffer_size = 0;
@@ -684,7 +684,7 @@ void test_spdm_responder_key_update_case8(void **state)
 	//no capabilities
 	spdm_context->connection_info.capability.flags &=
 		!SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP;
-	spdm_context->local_context.capability.flags &=
+	spdm_context->local_context->capability.flags &=
 		!SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP;
 
 	session_info = &spdm_context->session_info[0];
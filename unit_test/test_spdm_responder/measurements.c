@@ -116,7 +116,7 @@ void test_spdm_responder_measurements_case1(void **state)
 	spdm_test_context->case_id = 0x1;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -127,8 +127,8 @@ void test_spdm_responder_measurements_case1(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -171,7 +171,7 @@ void test_spdm_responder_measurements_case2(void **state)
 	spdm_test_context->case_id = 0x2;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -182,8 +182,8 @@ void test_spdm_responder_measurements_case2(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -223,7 +223,7 @@ void test_spdm_responder_measurements_case3(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_BUSY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -234,8 +234,8 @@ void test_spdm_responder_measurements_case3(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -276,7 +276,7 @@ void test_spdm_responder_measurements_case4(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NEED_RESYNC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -287,8 +287,8 @@ void test_spdm_responder_measurements_case4(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -331,7 +331,7 @@ void test_spdm_responder_measurements_case5(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NOT_READY;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -342,8 +342,8 @@ void test_spdm_responder_measurements_case5(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -391,7 +391,7 @@ void test_spdm_responder_measurements_case6(void **state)
 	spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -402,8 +402,8 @@ void test_spdm_responder_measurements_case6(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -443,7 +443,7 @@ void test_spdm_responder_measurements_case7(void **state)
 	spdm_test_context->case_id = 0x7;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -454,8 +454,8 @@ void test_spdm_responder_measurements_case7(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 
@@ -497,7 +497,7 @@ void test_spdm_responder_measurements_case8(void **state)
 	spdm_test_context->case_id = 0x8;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -508,8 +508,8 @@ void test_spdm_responder_measurements_case8(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 	response_size = sizeof(response);
@@ -551,7 +551,7 @@ void test_spdm_responder_measurements_case9(void **state)
 	spdm_test_context->case_id = 0x9;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -562,8 +562,8 @@ void test_spdm_responder_measurements_case9(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -602,7 +602,7 @@ void test_spdm_responder_measurements_case10(void **state)
 	spdm_test_context->case_id = 0xA;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -613,8 +613,8 @@ void test_spdm_responder_measurements_case10(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -662,7 +662,7 @@ void test_spdm_responder_measurements_case11(void **state)
 	spdm_test_context->case_id = 0xB;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -673,8 +673,8 @@ void test_spdm_responder_measurements_case11(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 
@@ -722,7 +722,7 @@ void test_spdm_responder_measurements_case12(void **state)
 	spdm_test_context->case_id = 0xC;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -733,8 +733,8 @@ void test_spdm_responder_measurements_case12(void **state)
 	spdm_context->connection_info.algorithm.measurement_hash_algo =
 		m_use_measurement_hash_algo;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -801,8 +801,8 @@ void test_spdm_responder_measurements_case13(void **state)
 	spdm_test_context->case_id = 0xD;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_NO_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -814,8 +814,8 @@ void test_spdm_responder_measurements_case13(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	spdm_get_random_number(SPDM_NONCE_SIZE,
 			       m_spdm_get_measurements_request9.nonce);
@@ -871,8 +871,8 @@ void test_spdm_responder_measurements_case14(void **state)
 	spdm_test_context->case_id = 0xE;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -884,8 +884,8 @@ void test_spdm_responder_measurements_case14(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	spdm_get_random_number(SPDM_NONCE_SIZE,
 			       m_spdm_get_measurements_request10.nonce);
@@ -930,8 +930,8 @@ void test_spdm_responder_measurements_case15(void **state)
 	spdm_test_context->case_id = 0xF;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_NO_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -943,8 +943,8 @@ void test_spdm_responder_measurements_case15(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -985,8 +985,8 @@ void test_spdm_responder_measurements_case16(void **state)
 	spdm_test_context->case_id = 0x10;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags = 0;
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_NO_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -998,8 +998,8 @@ void test_spdm_responder_measurements_case16(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -1038,7 +1038,7 @@ void test_spdm_responder_measurements_case17(void **state)
 	spdm_test_context->case_id = 0x11;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags = 0;
+	spdm_context->local_context->capability.flags = 0;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
 	spdm_context->connection_info.algorithm.base_asym_algo =
@@ -1049,8 +1049,8 @@ void test_spdm_responder_measurements_case17(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
@@ -1096,7 +1096,7 @@ void test_spdm_responder_measurements_case18(void **state)
 	spdm_test_context->case_id = 0x12;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1108,18 +1108,18 @@ void test_spdm_responder_measurements_case18(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data,
 						&data_size, NULL, NULL);
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
-	spdm_context->local_context.slot_count = MAX_SPDM_SLOT_COUNT;
-	for (int i = 1; i < spdm_context->local_context.slot_count; i++) {
-		spdm_context->local_context.local_cert_chain_provision_size[i] =
+	spdm_context->local_context->slot_count = MAX_SPDM_SLOT_COUNT;
+	for (int i = 1; i < spdm_context->local_context->slot_count; i++) {
+		spdm_context->local_context->local_cert_chain_provision_size[i] =
 			data_size;
-		spdm_context->local_context.local_cert_chain_provision[i] =
+		spdm_context->local_context->local_cert_chain_provision[i] =
 			data;
 	}
 
@@ -1145,7 +1145,7 @@ void test_spdm_responder_measurements_case18(void **state)
 	assert_int_equal(m_spdm_get_measurements_request11.SlotIDParam,
 			 spdm_response->header.param2);
 
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	free(data);
 }
 
@@ -1168,7 +1168,7 @@ void test_spdm_responder_measurements_case19(void **state)
 	spdm_test_context->case_id = 0x13;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1180,8 +1180,8 @@ void test_spdm_responder_measurements_case19(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -1222,7 +1222,7 @@ void test_spdm_responder_measurements_case20(void **state)
 	spdm_test_context->case_id = 0x14;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1234,8 +1234,8 @@ void test_spdm_responder_measurements_case20(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	// measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 + spdm_get_asym_signature_size (m_use_asym_algo);
 
 	response_size = sizeof(response);
@@ -1275,7 +1275,7 @@ void test_spdm_responder_measurements_case21(void **state)
 	spdm_test_context->case_id = 0x15;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1287,8 +1287,8 @@ void test_spdm_responder_measurements_case21(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	response_size = sizeof(response);
 	spdm_get_random_number(SPDM_NONCE_SIZE,
@@ -1330,7 +1330,7 @@ void test_spdm_responder_measurements_case22(void **state)
 	spdm_test_context->case_id = 0x16;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1342,8 +1342,8 @@ void test_spdm_responder_measurements_case22(void **state)
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 1;
 	spdm_reset_message_m(spdm_context, NULL);
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 
 	for (NumberOfMessages = 1; NumberOfMessages <= TOTAL_MESSAGES;
 	     NumberOfMessages++) {
@@ -1414,7 +1414,7 @@ void test_spdm_responder_measurements_case23(void **state)
 	spdm_test_context->case_id = 0x17;
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_AUTHENTICATED;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -1426,8 +1426,8 @@ void test_spdm_responder_measurements_case23(void **state)
 		m_use_measurement_hash_algo;
 	spdm_context->connection_info.version.major_version = 1;
 	spdm_context->connection_info.version.minor_version = 0;
-	spdm_context->local_context.opaque_measurement_rsp_size = 0;
-	spdm_context->local_context.opaque_measurement_rsp = NULL;
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
 	measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16) + 0 +
 			      spdm_get_asym_signature_size(m_use_asym_algo);
 
@@ -1438,9 +1438,9 @@ void test_spdm_responder_measurements_case23(void **state)
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	session_id = 0xFFFFFFFF;
 	spdm_context->latest_session_id = session_id;
@@ -1467,6 +1467,174 @@ void test_spdm_responder_measurements_case23(void **state)
 #endif
 }
 
+void test_spdm_responder_measurements_case24(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_measurements_response_t *spdm_response;
+	uint8 measurement_summary_hash[MAX_HASH_SIZE];
+	uint8 cached_measurement_summary_hash[MAX_HASH_SIZE];
+	boolean result;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x18;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->last_spdm_request_session_id_valid = FALSE;
+	spdm_reset_message_m(spdm_context, NULL);
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
+
+	spdm_set_measurement_dirty(
+		spdm_context,
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS);
+	assert_int_equal(spdm_context->measurement_cache->record_valid, FALSE);
+
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request7_size,
+		&m_spdm_get_measurements_request7, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_MEASUREMENTS);
+	assert_int_equal(spdm_response->number_of_blocks,
+			 MEASUREMENT_BLOCK_NUMBER);
+	assert_int_equal(spdm_context->measurement_cache->record_valid, TRUE);
+	assert_int_equal(
+		spdm_context->measurement_cache->device_measurement_count,
+		MEASUREMENT_BLOCK_NUMBER);
+
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+		measurement_summary_hash);
+	assert_int_equal(result, TRUE);
+	assert_int_equal(spdm_context->measurement_cache->summary_hash_valid
+				 [SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_ALL],
+			 TRUE);
+
+	// An unchanged block marked dirty keeps the precomputed summary hash.
+	spdm_set_measurement_dirty(spdm_context, 1);
+	assert_int_not_equal(spdm_context->measurement_cache->dirty_bitmap[0], 0);
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+		cached_measurement_summary_hash);
+	assert_int_equal(result, TRUE);
+	assert_int_equal(spdm_context->measurement_cache->dirty_bitmap[0], 0);
+	assert_int_equal(spdm_context->measurement_cache->summary_hash_valid
+				 [SPDM_MEASUREMENT_CACHE_SUMMARY_HASH_ALL],
+			 TRUE);
+	assert_memory_equal(cached_measurement_summary_hash,
+			    measurement_summary_hash,
+			    spdm_get_hash_size(m_use_hash_algo));
+}
+
+void test_spdm_responder_measurements_case25(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_measurements_response_t *spdm_response;
+	spdm_measurement_block_dmtf_t *measurement_block;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x19;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->local_context->capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->last_spdm_request_session_id_valid = FALSE;
+	spdm_reset_message_m(spdm_context, NULL);
+	spdm_context->local_context->opaque_measurement_rsp_size = 0;
+	spdm_context->local_context->opaque_measurement_rsp = NULL;
+
+	// A single index is collected on its own when the record is not cached.
+	spdm_set_measurement_dirty(
+		spdm_context,
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request6_size,
+		&m_spdm_get_measurements_request6, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(response_size,
+			 sizeof(spdm_measurements_response_t) +
+				 sizeof(spdm_measurement_block_dmtf_t) +
+				 spdm_get_measurement_hash_size(
+					 m_use_measurement_hash_algo) +
+				 SPDM_NONCE_SIZE + sizeof(uint16));
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_MEASUREMENTS);
+	assert_int_equal(spdm_response->number_of_blocks, 1);
+	measurement_block = (void *)(spdm_response + 1);
+	assert_int_equal(measurement_block->Measurement_block_common_header.index,
+			 1);
+	assert_int_equal(spdm_context->measurement_cache->record_valid, FALSE);
+
+	// The count is queried without collecting the record.
+	spdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request1_size,
+		&m_spdm_get_measurements_request1, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.param1,
+			 MEASUREMENT_BLOCK_NUMBER);
+	assert_int_equal(spdm_context->measurement_cache->record_valid, FALSE);
+
+	// A dirty block of a cached record is collected again per index.
+	spdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request7_size,
+		&m_spdm_get_measurements_request7, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context->measurement_cache->record_valid, TRUE);
+	spdm_set_measurement_dirty(spdm_context, MEASUREMENT_BLOCK_NUMBER);
+	spdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request6_size,
+		&m_spdm_get_measurements_request6, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context->measurement_cache->record_valid, TRUE);
+	assert_int_equal(spdm_context->measurement_cache
+				 ->dirty_bitmap[MEASUREMENT_BLOCK_NUMBER / 8],
+			 0);
+	assert_int_equal(
+		spdm_context->measurement_cache->device_measurement_count,
+		MEASUREMENT_BLOCK_NUMBER);
+}
+
 spdm_test_context_t m_spdm_responder_measurements_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
@@ -1524,6 +1692,10 @@ int spdm_responder_measurements_test_main(void)
 		cmocka_unit_test(test_spdm_responder_measurements_case22),
 		// Successful response to get a session based measurement with signature
 		cmocka_unit_test(test_spdm_responder_measurements_case23),
+		// Measurement cache keeps the summary hash across an unchanged dirty block
+		cmocka_unit_test(test_spdm_responder_measurements_case24),
+		// Single index and count requests use the per-index collection
+		cmocka_unit_test(test_spdm_responder_measurements_case25),
 	};
 
 	setup_spdm_test_context(&m_spdm_responder_measurements_test_context);
@@ -0,0 +1,314 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_responder_lib_internal.h>
+
+spdm_get_version_request_t m_spdm_multi_peer_get_version_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_VERSION,
+	},
+};
+
+/**
+  Send GET_VERSION from one endpoint to a multi-peer responder.
+
+  @return the SPDM response code, or 0 if the request is not processed.
+**/
+uint8 spdm_multi_peer_test_get_version(IN void *multi_peer_context,
+				       IN void *template_context,
+				       IN uint64 endpoint_id)
+{
+	return_status status;
+	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn request_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+
+	request_size = sizeof(request);
+	status = spdm_transport_test_encode_message(
+		template_context, NULL, FALSE, FALSE,
+		sizeof(m_spdm_multi_peer_get_version_request),
+		&m_spdm_multi_peer_get_version_request, &request_size,
+		request);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	response_size = sizeof(response);
+	status = spdm_multi_peer_process_message(multi_peer_context,
+						 endpoint_id, request,
+						 request_size, response,
+						 &response_size);
+	if (RETURN_ERROR(status)) {
+		return 0;
+	}
+	assert_int_equal(response[0], TEST_MESSAGE_TYPE_SPDM);
+	return ((spdm_message_header_t *)(response + 1))->request_response_code;
+}
+
+/**
+  Test 1: two endpoints send GET_VERSION to a multi-peer responder.
+  Expected behavior: one connection is created per endpoint, which uses the provisioning
+  of the template context in place, and each endpoint gets a VERSION response.
+**/
+void test_spdm_responder_multi_peer_case1(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_multi_peer_context_t *multi_peer;
+	spdm_context_t *connection1;
+	spdm_context_t *connection2;
+	return_status status;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+	spdm_context->local_context->capability.flags =
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+
+	multi_peer = malloc(spdm_multi_peer_get_context_size(4, 4, 2));
+	status = spdm_multi_peer_init_context(multi_peer, 4, 4, 2, spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_int_equal(spdm_multi_peer_test_get_version(multi_peer,
+							  spdm_context, 0x10),
+			 SPDM_VERSION);
+	assert_int_equal(spdm_multi_peer_test_get_version(multi_peer,
+							  spdm_context, 0x20),
+			 SPDM_VERSION);
+	assert_int_equal(spdm_multi_peer_test_get_version(multi_peer,
+							  spdm_context, 0x10),
+			 SPDM_VERSION);
+	assert_int_equal(multi_peer->connection_count, 2);
+
+	connection1 = spdm_multi_peer_get_connection(multi_peer, 0x10);
+	connection2 = spdm_multi_peer_get_connection(multi_peer, 0x20);
+	assert_non_null(connection1);
+	assert_non_null(connection2);
+	assert_ptr_not_equal(connection1, connection2);
+	assert_null(spdm_multi_peer_get_connection(multi_peer, 0x30));
+	assert_ptr_equal(connection1->local_context,
+			 spdm_context->local_context);
+	assert_int_equal(connection1->local_context->capability.flags,
+			 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP);
+	assert_int_equal(connection1->max_session_count, 2);
+	assert_int_equal(connection1->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_VERSION);
+	assert_ptr_equal(spdm_get_measurement_cache(connection2),
+			 spdm_context->measurement_cache);
+
+	spdm_multi_peer_deinit_context(multi_peer);
+	free(multi_peer);
+}
+
+/**
+  Test 2: more endpoints than connections send GET_VERSION to a multi-peer responder.
+  Expected behavior: the request is refused until a connection is removed, and the
+  remaining connections are still found after removals.
+**/
+void test_spdm_responder_multi_peer_case2(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_multi_peer_context_t *multi_peer;
+	return_status status;
+	uint64 endpoint_id;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+
+	multi_peer = malloc(spdm_multi_peer_get_context_size(16, 4, 1));
+	status = spdm_multi_peer_init_context(multi_peer, 16, 4, 1, spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	for (endpoint_id = 0; endpoint_id < 16; endpoint_id++) {
+		assert_int_equal(spdm_multi_peer_test_get_version(
+					 multi_peer, spdm_context, endpoint_id),
+				 SPDM_VERSION);
+	}
+	assert_int_equal(spdm_multi_peer_test_get_version(multi_peer,
+							  spdm_context, 16),
+			 0);
+
+	for (endpoint_id = 1; endpoint_id < 16; endpoint_id += 2) {
+		status = spdm_multi_peer_remove_connection(multi_peer,
+							   endpoint_id);
+		assert_int_equal(status, RETURN_SUCCESS);
+	}
+	status = spdm_multi_peer_remove_connection(multi_peer, 1);
+	assert_int_equal(status, RETURN_NOT_FOUND);
+	assert_int_equal(multi_peer->connection_count, 8);
+
+	for (endpoint_id = 0; endpoint_id < 16; endpoint_id++) {
+		if ((endpoint_id & 1) == 0) {
+			assert_non_null(spdm_multi_peer_get_connection(
+				multi_peer, endpoint_id));
+		} else {
+			assert_null(spdm_multi_peer_get_connection(
+				multi_peer, endpoint_id));
+		}
+	}
+	assert_int_equal(spdm_multi_peer_test_get_version(multi_peer,
+							  spdm_context, 16),
+			 SPDM_VERSION);
+
+	spdm_multi_peer_deinit_context(multi_peer);
+	free(multi_peer);
+}
+
+/**
+  Test 3: connections of a multi-peer responder allocate responder session IDs.
+  Expected behavior: the IDs are unique across connections, the session table routes
+  each session to its connection, and no ID is allocated once the table is full.
+**/
+void test_spdm_responder_multi_peer_case3(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_multi_peer_context_t *multi_peer;
+	spdm_context_t *connection[3];
+	uint16 rsp_session_id[2];
+	uint32 session_id;
+	uint64 endpoint_id;
+	return_status status;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+
+	multi_peer = malloc(spdm_multi_peer_get_context_size(4, 2, 1));
+	status = spdm_multi_peer_init_context(multi_peer, 4, 2, 1, spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	for (index = 0; index < 3; index++) {
+		spdm_multi_peer_test_get_version(multi_peer, spdm_context,
+						 0x100 + index);
+		connection[index] =
+			spdm_multi_peer_get_connection(multi_peer, 0x100 + index);
+		assert_non_null(connection[index]);
+	}
+
+	for (index = 0; index < 2; index++) {
+		rsp_session_id[index] =
+			spdm_multi_peer_allocate_rsp_session_id(connection[index]);
+		assert_int_not_equal(rsp_session_id[index],
+				     INVALID_SESSION_ID & 0xFFFF);
+		session_id = (0xFFFF << 16) | rsp_session_id[index];
+		assert_non_null(spdm_assign_session_id(connection[index],
+						       session_id, FALSE));
+		status = spdm_multi_peer_sync_sessions(
+			multi_peer,
+			multi_peer->connection_table
+				[spdm_multi_peer_find_connection_slot(
+					multi_peer, 0x100 + index)]);
+		assert_int_equal(status, RETURN_SUCCESS);
+	}
+	assert_int_not_equal(rsp_session_id[0], rsp_session_id[1]);
+	assert_int_equal(multi_peer->session_count, 2);
+	assert_int_equal(spdm_multi_peer_allocate_rsp_session_id(connection[2]),
+			 INVALID_SESSION_ID & 0xFFFF);
+
+	session_id = (0xFFFF << 16) | rsp_session_id[1];
+	assert_ptr_equal(spdm_multi_peer_get_connection_via_session_id(
+				 multi_peer, session_id, &endpoint_id),
+			 connection[1]);
+	assert_int_equal(endpoint_id, 0x101);
+
+	status = spdm_multi_peer_remove_connection(multi_peer, 0x100);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(multi_peer->session_count, 1);
+	assert_null(spdm_multi_peer_get_connection_via_session_id(
+		multi_peer, (0xFFFF << 16) | rsp_session_id[0], NULL));
+	assert_int_not_equal(spdm_multi_peer_allocate_rsp_session_id(
+				     connection[2]),
+			     INVALID_SESSION_ID & 0xFFFF);
+
+	spdm_multi_peer_deinit_context(multi_peer);
+	free(multi_peer);
+}
+
+/**
+  Test 4: a connection of a multi-peer responder creates a session when the session table is full.
+  Expected behavior: the session is not recorded, spdm_multi_peer_sync_sessions returns
+  RETURN_OUT_OF_RESOURCES and the session is freed in the connection.
+**/
+void test_spdm_responder_multi_peer_case4(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_multi_peer_context_t *multi_peer;
+	spdm_context_t *connection[2];
+	uintn connection_index[2];
+	uint32 session_id[2];
+	return_status status;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x4;
+
+	multi_peer = malloc(spdm_multi_peer_get_context_size(2, 1, 1));
+	status = spdm_multi_peer_init_context(multi_peer, 2, 1, 1, spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	for (index = 0; index < 2; index++) {
+		spdm_multi_peer_test_get_version(multi_peer, spdm_context,
+						 0x200 + index);
+		connection[index] =
+			spdm_multi_peer_get_connection(multi_peer, 0x200 + index);
+		assert_non_null(connection[index]);
+		connection_index[index] = multi_peer->connection_table
+			[spdm_multi_peer_find_connection_slot(multi_peer,
+							      0x200 + index)];
+		session_id[index] = (0xFFFF << 16) | (0x10 + index);
+		assert_non_null(spdm_assign_session_id(connection[index],
+						       session_id[index], FALSE));
+	}
+
+	status = spdm_multi_peer_sync_sessions(multi_peer, connection_index[0]);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = spdm_multi_peer_sync_sessions(multi_peer, connection_index[1]);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+
+	assert_int_equal(multi_peer->session_count, 1);
+	assert_null(spdm_get_session_info_via_session_id(connection[1],
+							  session_id[1]));
+	assert_null(spdm_multi_peer_get_connection_via_session_id(
+		multi_peer, session_id[1], NULL));
+	assert_ptr_equal(spdm_multi_peer_get_connection_via_session_id(
+				 multi_peer, session_id[0], NULL),
+			 connection[0]);
+
+	spdm_multi_peer_deinit_context(multi_peer);
+	free(multi_peer);
+}
+
+spdm_test_context_t m_spdm_responder_multi_peer_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	FALSE,
+};
+
+int spdm_responder_multi_peer_test_main(void)
+{
+	const struct CMUnitTest spdm_responder_multi_peer_tests[] = {
+		// Connections created per endpoint
+		cmocka_unit_test(test_spdm_responder_multi_peer_case1),
+		// Connection table full, connection removal
+		cmocka_unit_test(test_spdm_responder_multi_peer_case2),
+		// Session IDs unique across connections
+		cmocka_unit_test(test_spdm_responder_multi_peer_case3),
+		// Session table full
+		cmocka_unit_test(test_spdm_responder_multi_peer_case4),
+	};
+
+	setup_spdm_test_context(&m_spdm_responder_multi_peer_test_context);
+
+	return cmocka_run_group_tests(spdm_responder_multi_peer_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
@@ -56,7 +56,7 @@ void test_spdm_responder_psk_exchange_case1(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -73,23 +73,23 @@ void test_spdm_responder_psk_exchange_case1(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -97,8 +97,8 @@ void test_spdm_responder_psk_exchange_case1(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -149,7 +149,7 @@ void test_spdm_responder_psk_exchange_case2(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -166,23 +166,23 @@ void test_spdm_responder_psk_exchange_case2(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request2.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request2.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -190,8 +190,8 @@ void test_spdm_responder_psk_exchange_case2(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request2.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request2.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request2.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request2.context_length;
@@ -234,7 +234,7 @@ void test_spdm_responder_psk_exchange_case3(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -251,23 +251,23 @@ void test_spdm_responder_psk_exchange_case3(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -275,8 +275,8 @@ void test_spdm_responder_psk_exchange_case3(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -320,7 +320,7 @@ void test_spdm_responder_psk_exchange_case4(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -337,23 +337,23 @@ void test_spdm_responder_psk_exchange_case4(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -361,8 +361,8 @@ void test_spdm_responder_psk_exchange_case4(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -408,7 +408,7 @@ void test_spdm_responder_psk_exchange_case5(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -425,23 +425,23 @@ void test_spdm_responder_psk_exchange_case5(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -449,8 +449,8 @@ void test_spdm_responder_psk_exchange_case5(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -500,7 +500,7 @@ void test_spdm_responder_psk_exchange_case6(void **state)
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -517,23 +517,23 @@ void test_spdm_responder_psk_exchange_case6(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -541,8 +541,8 @@ void test_spdm_responder_psk_exchange_case6(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
@@ -584,7 +584,7 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 		SPDM_CONNECTION_STATE_NEGOTIATED;
 	spdm_context->connection_info.capability.flags |=
 		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-	spdm_context->local_context.capability.flags |=
+	spdm_context->local_context->capability.flags |=
 		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
 	spdm_context->connection_info.algorithm.base_hash_algo =
 		m_use_hash_algo;
@@ -601,23 +601,23 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 	read_responder_public_certificate_chain(m_use_hash_algo,
 						m_use_asym_algo, &data1,
 						&data_size1, NULL, NULL);
-	spdm_context->local_context.local_cert_chain_provision[0] = data1;
-	spdm_context->local_context.local_cert_chain_provision_size[0] =
+	spdm_context->local_context->local_cert_chain_provision[0] = data1;
+	spdm_context->local_context->local_cert_chain_provision_size[0] =
 		data_size1;
 	spdm_context->connection_info.local_used_cert_chain_buffer = data1;
 	spdm_context->connection_info.local_used_cert_chain_buffer_size =
 		data_size1;
-	spdm_context->local_context.slot_count = 1;
+	spdm_context->local_context->slot_count = 1;
 	spdm_reset_message_a(spdm_context);
 	zero_mem(m_local_psk_hint, 32);
 	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
 		 sizeof(TEST_PSK_HINT_STRING));
-	spdm_context->local_context.psk_hint_size =
+	spdm_context->local_context->psk_hint_size =
 		sizeof(TEST_PSK_HINT_STRING);
-	spdm_context->local_context.psk_hint = m_local_psk_hint;
+	spdm_context->local_context->psk_hint = m_local_psk_hint;
 
 	m_spdm_psk_exchange_request1.psk_hint_length =
-		(uint16)spdm_context->local_context.psk_hint_size;
+		(uint16)spdm_context->local_context->psk_hint_size;
 	m_spdm_psk_exchange_request1.context_length = DEFAULT_CONTEXT_LENGTH;
 	opaque_psk_exchange_req_size =
 		spdm_get_opaque_data_supported_version_data_size(spdm_context);
@@ -625,8 +625,8 @@ void test_spdm_responder_psk_exchange_case7(void **state)
 		(uint16)opaque_psk_exchange_req_size;
 	m_spdm_psk_exchange_request1.req_session_id = 0xFFFF;
 	ptr = m_spdm_psk_exchange_request1.psk_hint;
-	copy_mem(ptr, spdm_context->local_context.psk_hint,
-		 spdm_context->local_context.psk_hint_size);
+	copy_mem(ptr, spdm_context->local_context->psk_hint,
+		 spdm_context->local_context->psk_hint_size);
 	ptr += m_spdm_psk_exchange_request1.psk_hint_length;
 	spdm_get_random_number(DEFAULT_CONTEXT_LENGTH, ptr);
 	ptr += m_spdm_psk_exchange_request1.context_length;
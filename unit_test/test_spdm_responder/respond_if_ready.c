@@ -297,16 +297,16 @@ void test_spdm_responder_respond_if_ready_case1(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
 
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
@@ -356,17 +356,17 @@ void test_spdm_responder_respond_if_ready_case2(void **state) {
 
   //state for the the original request (GET_CERTIFICATE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AFTER_DIGESTS;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->slot_count = 1;
 
   spdm_context->last_spdm_request_size = m_spdm_get_certificate_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_certificate_request, m_spdm_get_certificate_request_size);
@@ -418,9 +418,9 @@ void test_spdm_responder_respond_if_ready_case3(void **state) {
 
   //state for the the original request (CHALLENGE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -429,10 +429,10 @@ void test_spdm_responder_respond_if_ready_case3(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->opaque_challenge_auth_rsp_size = 0;
 
   spdm_context->last_spdm_request_size = m_spdm_challenge_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_challenge_request, m_spdm_challenge_request_size);
@@ -483,8 +483,8 @@ void test_spdm_responder_respond_if_ready_case4(void **state) {
 
   //state for the the original request (GET_MEASUREMENTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+  spdm_context->local_context->capability.flags = 0;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -492,8 +492,8 @@ void test_spdm_responder_respond_if_ready_case4(void **state) {
   
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
-  spdm_context->local_context.opaque_measurement_rsp_size = 0;
-  spdm_context->local_context.opaque_measurement_rsp = NULL;
+  spdm_context->local_context->opaque_measurement_rsp_size = 0;
+  spdm_context->local_context->opaque_measurement_rsp = NULL;
 
   spdm_context->last_spdm_request_size = m_spdm_get_measurements_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_measurements_request, m_spdm_get_measurements_request_size);
@@ -546,9 +546,9 @@ void test_spdm_responder_respond_if_ready_case5(void **state) {
 
   //state for the the original request (KEY_EXCHANGE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -559,10 +559,10 @@ void test_spdm_responder_respond_if_ready_case5(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.mut_auth_requested = 0;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->mut_auth_requested = 0;
 
   m_spdm_key_exchange_request.req_session_id = 0xFFFF;
   m_spdm_key_exchange_request.reserved = 0;
@@ -638,11 +638,11 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
 
   //state for the the original request (FINISH)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -653,12 +653,12 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
   spdm_context->connection_info.local_used_cert_chain_buffer = data;
   spdm_context->connection_info.local_used_cert_chain_buffer_size = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.mut_auth_requested = 0;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->mut_auth_requested = 0;
 
   session_id = 0xFFFFFFFF;
   spdm_context->latest_session_id = session_id;
@@ -732,9 +732,9 @@ void test_spdm_responder_respond_if_ready_case7(void **state) {
 
   //state for the the original request (PSK_EXCHANGE)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -746,23 +746,23 @@ void test_spdm_responder_respond_if_ready_case7(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
   spdm_context->connection_info.local_used_cert_chain_buffer = data;
   spdm_context->connection_info.local_used_cert_chain_buffer_size = data_size;
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   zero_mem (local_psk_hint, 32);
   copy_mem (&local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = local_psk_hint;
 
-  m_spdm_psk_exchange_request.psk_hint_length = (uint16)spdm_context->local_context.psk_hint_size;
+  m_spdm_psk_exchange_request.psk_hint_length = (uint16)spdm_context->local_context->psk_hint_size;
   m_spdm_psk_exchange_request.requester_context_length = DEFAULT_CONTEXT_LENGTH;
   OpaquePskExchangeReqSize = spdm_get_opaque_data_supported_version_data_size (spdm_context);
   m_spdm_psk_exchange_request.opaque_length = (uint16)OpaquePskExchangeReqSize;
   m_spdm_psk_exchange_request.req_session_id = 0xFFFF;
   ptr = m_spdm_psk_exchange_request.psk_hint;
-  copy_mem (ptr, spdm_context->local_context.psk_hint, spdm_context->local_context.psk_hint_size);
+  copy_mem (ptr, spdm_context->local_context->psk_hint, spdm_context->local_context->psk_hint_size);
   ptr += m_spdm_psk_exchange_request.psk_hint_length;
   spdm_get_random_number (DEFAULT_CONTEXT_LENGTH, ptr);
   ptr += m_spdm_psk_exchange_request.requester_context_length;
@@ -825,11 +825,11 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
 
   //state for the the original request (FINISH)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_AUTHENTICATED;
-  spdm_context->local_context.capability.flags = 0;
+  spdm_context->local_context->capability.flags = 0;
   spdm_context->connection_info.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HANDSHAKE_IN_THE_CLEAR_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
   spdm_context->connection_info.algorithm.base_asym_algo = m_use_asym_algo;
   spdm_context->connection_info.algorithm.measurement_spec = m_use_measurement_spec;
@@ -840,16 +840,16 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
   spdm_context->connection_info.version.major_version = 1;
   spdm_context->connection_info.version.minor_version = 1;
   read_responder_public_certificate_chain (m_use_hash_algo, m_use_asym_algo, &data, &data_size, NULL, NULL);
-  spdm_context->local_context.local_cert_chain_provision[0] = data;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = data_size;
+  spdm_context->local_context->local_cert_chain_provision[0] = data;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = data_size;
   spdm_context->connection_info.local_used_cert_chain_buffer = data;
   spdm_context->connection_info.local_used_cert_chain_buffer_size = data_size;
-  spdm_context->local_context.slot_count = 1;
-  spdm_context->local_context.mut_auth_requested = 0;
+  spdm_context->local_context->slot_count = 1;
+  spdm_context->local_context->mut_auth_requested = 0;
   zero_mem (local_psk_hint, 32);
   copy_mem (&local_psk_hint[0], TEST_PSK_HINT_STRING, sizeof(TEST_PSK_HINT_STRING));
-  spdm_context->local_context.psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
-  spdm_context->local_context.psk_hint = local_psk_hint;
+  spdm_context->local_context->psk_hint_size = sizeof(TEST_PSK_HINT_STRING);
+  spdm_context->local_context->psk_hint = local_psk_hint;
 
   session_id = 0xFFFFFFFF;
   spdm_context->latest_session_id = session_id;
@@ -917,12 +917,12 @@ void test_spdm_responder_respond_if_ready_case9(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -969,12 +969,12 @@ void test_spdm_responder_respond_if_ready_case10(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1022,12 +1022,12 @@ void test_spdm_responder_respond_if_ready_case11(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1077,12 +1077,12 @@ void test_spdm_responder_respond_if_ready_case12(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1134,12 +1134,12 @@ void test_spdm_responder_respond_if_ready_case13(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -1185,12 +1185,12 @@ void test_spdm_responder_respond_if_ready_case14(void **state) {
 
   //state for the the original request (GET_DIGESTS)
   spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
-  spdm_context->local_context.capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+  spdm_context->local_context->capability.flags |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
   spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
-  spdm_context->local_context.local_cert_chain_provision[0] = m_local_certificate_chain;
-  spdm_context->local_context.local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
+  spdm_context->local_context->local_cert_chain_provision[0] = m_local_certificate_chain;
+  spdm_context->local_context->local_cert_chain_provision_size[0] = MAX_SPDM_MESSAGE_BUFFER_SIZE;
   set_mem (m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE, (uint8)(0xFF));
-  spdm_context->local_context.slot_count = 1;
+  spdm_context->local_context->slot_count = 1;
   spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
 
@@ -0,0 +1,243 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <spdm_responder_lib_internal.h>
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+
+spdm_get_version_request_t m_spdm_stats_get_version_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_VERSION,
+	},
+};
+
+spdm_get_digest_request_t m_spdm_stats_get_digests_request = {
+	{
+		SPDM_MESSAGE_VERSION_11,
+		SPDM_GET_DIGESTS,
+	},
+};
+
+static uint64 m_spdm_stats_time_us;
+static uintn m_spdm_stats_sample_count;
+static spdm_responder_stats_sample_t m_spdm_stats_last_sample;
+
+/**
+  Fake clock, advancing 3us on every read.
+**/
+uint64 spdm_stats_test_get_time_us(IN void *spdm_context)
+{
+	m_spdm_stats_time_us += 3;
+	return m_spdm_stats_time_us;
+}
+
+void spdm_stats_test_sample(IN void *spdm_context,
+			    IN spdm_responder_stats_sample_t *sample)
+{
+	m_spdm_stats_sample_count++;
+	copy_mem(&m_spdm_stats_last_sample, sample, sizeof(*sample));
+}
+
+/**
+  Send one request to the responder.
+
+  @return the SPDM response code.
+**/
+uint8 spdm_stats_test_send(IN void *spdm_context, IN uintn request_size,
+			   IN void *request)
+{
+	return_status status;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+	uint32 *session_id;
+
+	message_size = sizeof(message);
+	status = spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						    FALSE, request_size,
+						    request, &message_size,
+						    message);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	response_size = sizeof(response);
+	status = spdm_process_message(spdm_context, &session_id, message,
+				      message_size, response, &response_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(response[0], TEST_MESSAGE_TYPE_SPDM);
+	return ((spdm_message_header_t *)(response + 1))->request_response_code;
+}
+
+/**
+  Test 1: GET_VERSION is processed twice with a clock registered.
+  Expected behavior: the requests are counted, and the decode, handler and encode
+  phases are added to the histograms of GET_VERSION.
+**/
+void test_spdm_responder_stats_case1(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_responder_stats_t *stats;
+	spdm_responder_request_stats_t *request_stats;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x1;
+	spdm_responder_stats_reset(spdm_context);
+	spdm_register_timer_func(spdm_context, NULL,
+				 spdm_stats_test_get_time_us);
+
+	assert_int_equal(spdm_stats_test_send(
+				 spdm_context,
+				 sizeof(m_spdm_stats_get_version_request),
+				 &m_spdm_stats_get_version_request),
+			 SPDM_VERSION);
+	assert_int_equal(spdm_stats_test_send(
+				 spdm_context,
+				 sizeof(m_spdm_stats_get_version_request),
+				 &m_spdm_stats_get_version_request),
+			 SPDM_VERSION);
+
+	stats = malloc(sizeof(spdm_responder_stats_t));
+	spdm_responder_stats_snapshot(spdm_context, stats);
+	request_stats = &stats->request[SPDM_GET_VERSION - 0x80];
+	assert_int_equal(request_stats->received, 2);
+	assert_int_equal(request_stats->errored, 0);
+	assert_int_equal(request_stats->latency_histogram
+				 [SPDM_RESPONDER_STATS_PHASE_DECODE][2],
+			 2);
+	assert_int_equal(request_stats->latency_histogram
+				 [SPDM_RESPONDER_STATS_PHASE_HANDLER][2],
+			 2);
+	assert_int_equal(request_stats->latency_histogram
+				 [SPDM_RESPONDER_STATS_PHASE_ENCODE][2],
+			 2);
+	assert_int_equal(request_stats->latency_histogram
+				 [SPDM_RESPONDER_STATS_PHASE_SIGN][0],
+			 0);
+	assert_int_equal(spdm_responder_stats_get_percentile(
+				 stats, SPDM_GET_VERSION,
+				 SPDM_RESPONDER_STATS_PHASE_HANDLER, 99),
+			 4);
+	assert_int_equal(spdm_responder_stats_get_percentile(
+				 stats, SPDM_GET_DIGESTS,
+				 SPDM_RESPONDER_STATS_PHASE_HANDLER, 50),
+			 0);
+	assert_int_equal(stats->decode_failed, 0);
+
+	spdm_register_timer_func(spdm_context, NULL, NULL);
+	free(stats);
+}
+
+/**
+  Test 2: GET_DIGESTS is processed before the capabilities are negotiated, with a
+  sampling function called every second request.
+  Expected behavior: the ERROR responses are counted per request code and per error code,
+  and the sampling function gets every second request.
+**/
+void test_spdm_responder_stats_case2(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_responder_stats_t *stats;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x2;
+	spdm_responder_stats_reset(spdm_context);
+	spdm_register_responder_stats_sample_func(
+		spdm_context, spdm_stats_test_sample, 2);
+	m_spdm_stats_sample_count = 0;
+
+	assert_int_equal(spdm_stats_test_send(
+				 spdm_context,
+				 sizeof(m_spdm_stats_get_version_request),
+				 &m_spdm_stats_get_version_request),
+			 SPDM_VERSION);
+	for (index = 0; index < 3; index++) {
+		assert_int_equal(spdm_stats_test_send(
+					 spdm_context,
+					 sizeof(m_spdm_stats_get_digests_request),
+					 &m_spdm_stats_get_digests_request),
+				 SPDM_ERROR);
+	}
+
+	stats = malloc(sizeof(spdm_responder_stats_t));
+	spdm_responder_stats_snapshot(spdm_context, stats);
+	assert_int_equal(stats->request[SPDM_GET_DIGESTS - 0x80].received, 3);
+	assert_int_equal(stats->request[SPDM_GET_DIGESTS - 0x80].errored, 3);
+	assert_int_equal(
+		stats->error_code[SPDM_ERROR_CODE_UNSUPPORTED_REQUEST], 3);
+	assert_int_equal(m_spdm_stats_sample_count, 2);
+	assert_int_equal(m_spdm_stats_last_sample.request_code,
+			 SPDM_GET_DIGESTS);
+	assert_int_equal(m_spdm_stats_last_sample.error_code,
+			 SPDM_ERROR_CODE_UNSUPPORTED_REQUEST);
+	assert_int_equal(m_spdm_stats_last_sample.phase_mask, 0);
+
+	spdm_register_responder_stats_sample_func(spdm_context, NULL, 0);
+	free(stats);
+}
+
+/**
+  Test 3: the statistics are reset.
+  Expected behavior: all counters and histograms are cleared.
+**/
+void test_spdm_responder_stats_case3(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_responder_stats_t *stats;
+	spdm_responder_stats_t *zero_stats;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x3;
+
+	assert_int_equal(spdm_stats_test_send(
+				 spdm_context,
+				 sizeof(m_spdm_stats_get_version_request),
+				 &m_spdm_stats_get_version_request),
+			 SPDM_VERSION);
+	spdm_responder_stats_reset(spdm_context);
+
+	stats = malloc(sizeof(spdm_responder_stats_t));
+	zero_stats = malloc(sizeof(spdm_responder_stats_t));
+	zero_mem(zero_stats, sizeof(spdm_responder_stats_t));
+	spdm_responder_stats_snapshot(spdm_context, stats);
+	assert_memory_equal(stats, zero_stats, sizeof(spdm_responder_stats_t));
+
+	free(zero_stats);
+	free(stats);
+}
+
+spdm_test_context_t m_spdm_responder_stats_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	FALSE,
+};
+
+int spdm_responder_stats_test_main(void)
+{
+	const struct CMUnitTest spdm_responder_stats_tests[] = {
+		// Requests counted and timed
+		cmocka_unit_test(test_spdm_responder_stats_case1),
+		// ERROR responses counted, sampling function
+		cmocka_unit_test(test_spdm_responder_stats_case2),
+		// Statistics reset
+		cmocka_unit_test(test_spdm_responder_stats_case3),
+	};
+
+	setup_spdm_test_context(&m_spdm_responder_stats_test_context);
+
+	return cmocka_run_group_tests(spdm_responder_stats_tests,
+				      spdm_unit_test_group_setup,
+				      spdm_unit_test_group_teardown);
+}
+
+#endif // LIBSPDM_RESPONDER_STATS_SUPPORT
@@ -32,6 +32,11 @@ int spdm_responder_psk_finish_test_main(void);
 int spdm_responder_heartbeat_test_main(void);
 int spdm_responder_key_update_test_main(void);
 int spdm_responder_end_session_test_main(void);
+int spdm_responder_multi_peer_test_main(void);
+
+#if LIBSPDM_RESPONDER_STATS_SUPPORT
+int spdm_responder_stats_test_main(void);
+#endif // LIBSPDM_RESPONDER_STATS_SUPPORT
 
 int main(void)
 {
@@ -103,5 +108,15 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_responder_multi_peer_test_main() != 0) {
+		return_value = 1;
+	}
+
+	#if LIBSPDM_RESPONDER_STATS_SUPPORT
+	if (spdm_responder_stats_test_main() != 0) {
+		return_value = 1;
+	}
+	#endif // LIBSPDM_RESPONDER_STATS_SUPPORT
+
 	return return_value;
 }